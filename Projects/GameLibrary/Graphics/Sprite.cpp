@@ -3,8 +3,9 @@
 #include "GameLibrary/Graphics/Sprite.h"
 #include "Reflect/TranslatorDeduction.h"
 #include "Framework/ComponentQuery.h"
-#include "Graphics/BufferedDrawer.h"
+#include "Graphics/SpriteBatcher.h"
 #include "Graphics/GraphicsManagerComponent.h"
+#include "Graphics/TextureStreamingManager.h"
 #include "Framework/World.h"
 
 using namespace Helium;
@@ -22,6 +23,7 @@ void SpriteComponent::PopulateMetaType( Reflect::MetaStruct& comp )
 
 GameLibrary::SpriteComponent::SpriteComponent()
 	: m_Frame( 0 )
+	, m_Layer( 0 )
 	, m_FlipHorizontal( false )
 	, m_FlipVertical( false )
 	, m_Dirty( false )
@@ -40,16 +42,23 @@ void SpriteComponent::Initialize( const SpriteComponentDefinition &definition )
 	m_TextureSize = Simd::Vector3( static_cast<float>(m_Texture->GetWidth()), static_cast<float>(m_Texture->GetHeight()), 1.0f );
 	m_Scale = Simd::Vector3( definition.GetScale().GetX(), definition.GetScale().GetY(), 1.0f );
 	m_Rotation = definition.GetRotation();
+	m_Layer = definition.GetLayer();
 	m_Dirty = true;
 }
 
-void GameLibrary::SpriteComponent::Render( Helium::BufferedDrawer &rBufferedDrawer, Helium::TransformComponent &rTransform )
+void GameLibrary::SpriteComponent::Render( Helium::SpriteBatcher &rSpriteBatcher, Helium::TransformComponent &rTransform )
 {
 	if ( !m_Texture )
 	{
 		return;
 	}
 
+	RTexture2d *pRenderTexture = m_Texture->GetRenderResource2d();
+	if ( !pRenderTexture )
+	{
+		return;
+	}
+
 	if ( m_Dirty )
 	{
 		m_Definition->GetUVCoordinates( m_Frame, m_UvTopLeft, m_UvBottomRight );
@@ -82,11 +91,19 @@ void GameLibrary::SpriteComponent::Render( Helium::BufferedDrawer &rBufferedDraw
 	Helium::Simd::Matrix44 composite =
 		scaling * matrix;
 
-	rBufferedDrawer.DrawTexturedQuad(
-		m_Texture->GetRenderResource2d(),
+	// Sprites are drawn at their native texel size, so always keep the full sprite sheet resident while in use.
+	Helium::TextureStreamingManager* pTextureStreamingManager = Helium::TextureStreamingManager::GetInstance();
+	if ( pTextureStreamingManager )
+	{
+		pTextureStreamingManager->RequestMipLevel( m_Texture, 0 );
+	}
+
+	rSpriteBatcher.DrawSprite(
+		pRenderTexture,
 		composite,
 		m_UvTopLeft,
-		m_UvBottomRight);
+		m_UvBottomRight,
+		m_Layer);
 }
 
 HELIUM_DEFINE_CLASS(GameLibrary::SpriteComponentDefinition);
@@ -100,6 +117,7 @@ void GameLibrary::SpriteComponentDefinition::PopulateMetaType( Helium::Reflect::
 	comp.AddField( &SpriteComponentDefinition::m_FramesPerColumn, "m_FramesPerColumn" );
 	comp.AddField( &SpriteComponentDefinition::m_FrameCount, "m_FrameCount" );
 	comp.AddField( &SpriteComponentDefinition::m_Texture, "m_Texture" );
+	comp.AddField( &SpriteComponentDefinition::m_Layer, "m_Layer" );
 }
 
 Helium::Point GameLibrary::SpriteComponentDefinition::GetPixelCoordinates( uint32_t frame ) const
@@ -130,17 +148,18 @@ void GameLibrary::SpriteComponentDefinition::GetUVCoordinates( uint32_t frame, S
 		return;
 	}
 
-	Helium::Point bottomRightPixel  = topLeftPixel + m_FrameSize;
-
 	Texture2d *t2d = Reflect::AssertCast<Texture2d>( m_Texture );
 
-	float textureWidth = static_cast<float>( t2d->GetWidth() );
-	float textureHeight = static_cast<float>( t2d->GetHeight() );
-
-	topLeft.SetX( static_cast<float>( topLeftPixel.x ) / textureWidth );
-	topLeft.SetY( static_cast<float>( topLeftPixel.y ) / textureHeight );
-	bottomRight.SetX( static_cast<float>( bottomRightPixel.x ) / textureWidth );
-	bottomRight.SetY( static_cast<float>( bottomRightPixel.y ) / textureHeight );
+	// Frames are packed next to each other in the sprite sheet, so keep the UVs inside each frame's texels.
+	SpriteBatcher::GetAtlasUvCoordinates(
+		t2d->GetWidth(),
+		t2d->GetHeight(),
+		topLeftPixel.x,
+		topLeftPixel.y,
+		m_FrameSize.x,
+		m_FrameSize.y,
+		topLeft,
+		bottomRight );
 }
 
 GameLibrary::SpriteComponentDefinition::SpriteComponentDefinition()
@@ -148,32 +167,27 @@ GameLibrary::SpriteComponentDefinition::SpriteComponentDefinition()
 	, m_TopLeftPixel(Point::Zero)
 	, m_FrameSize(Point::Zero)
 	, m_Rotation(0.0f)
+	, m_Layer(0)
 	, m_FramesPerColumn(1)
 	, m_FrameCount(1)
 {
 
 }
 
-static BufferedDrawer *g_pBufferedDrawer;
+static SpriteBatcher *g_pSpriteBatcher;
 
 void DrawSprite( SpriteComponent *pShaderComponent, Helium::TransformComponent *pTransformComponent )
 {
-	// TODO: Make this not use buffered drawer
-	pShaderComponent->Render( *g_pBufferedDrawer, *pTransformComponent );
+	pShaderComponent->Render( *g_pSpriteBatcher, *pTransformComponent );
 };
 
 void DrawSprites( World *pWorld )
 {
-#if !GRAPHICS_SCENE_BUFFERED_DRAWER
-	HELIUM_ASSERT( 0 );
-#else // GRAPHICS_SCENE_BUFFERED_DRAWER
-
 	GraphicsManagerComponent *pGraphicsManager = pWorld->GetComponents().GetFirst<GraphicsManagerComponent>();
 	HELIUM_ASSERT( pGraphicsManager );
 
-	g_pBufferedDrawer = &pGraphicsManager->GetBufferedDrawer();
+	g_pSpriteBatcher = &pGraphicsManager->GetSpriteBatcher();
 	QueryComponents< SpriteComponent, TransformComponent, DrawSprite >( pWorld );
-#endif
 }
 
 
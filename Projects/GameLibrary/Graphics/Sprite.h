@@ -10,7 +10,7 @@
 
 #include "Components/TransformComponent.h"
 #include "Graphics/Texture2d.h"
-#include "Graphics/BufferedDrawer.h"
+#include "Graphics/SpriteBatcher.h"
 
 namespace GameLibrary
 {
@@ -33,11 +33,12 @@ namespace GameLibrary
 		
 		void Initialize( const SpriteComponentDefinition &definition);
 
-		void Render( Helium::BufferedDrawer &rBufferedDrawer, Helium::TransformComponent &rTransform );
+		void Render( Helium::SpriteBatcher &rSpriteBatcher, Helium::TransformComponent &rTransform );
 
 		void SetFrame(uint32_t frame) { m_Frame = frame; m_Dirty = true;}
 		void SetFlipHorizontal( bool shouldFlip ) { m_FlipHorizontal = shouldFlip; m_Dirty = true; }
 		void SetFlipVertical( bool shouldFlip ) { m_FlipVertical = shouldFlip; m_Dirty = true; }
+		void SetLayer( int32_t layer ) { m_Layer = layer; }
 		
 	private:
 		Helium::Simd::Vector2 m_UvTopLeft;
@@ -48,6 +49,7 @@ namespace GameLibrary
 		Helium::Texture2dPtr m_Texture;
 		float m_Rotation;
 		uint32_t m_Frame;
+		int32_t m_Layer;
 		bool m_FlipHorizontal;
 		bool m_FlipVertical;
 		bool m_Dirty;
@@ -66,6 +68,7 @@ namespace GameLibrary
 		uint32_t GetFrameCount() const { return m_FrameCount; }
 		float GetRotation() const { return m_Rotation; }
 		const Helium::Simd::Vector2 &GetScale() const { return m_Scale; }
+		int32_t GetLayer() const { return m_Layer; }
 
 		Helium::Point GetPixelCoordinates( uint32_t frame ) const;
 		void GetUVCoordinates(uint32_t frame, Helium::Simd::Vector2 &topLeft, Helium::Simd::Vector2 &bottomRight) const;
@@ -76,6 +79,7 @@ namespace GameLibrary
 		Helium::Point m_TopLeftPixel;
 		Helium::Point m_FrameSize;
 		float m_Rotation;
+		int32_t m_Layer;
 		uint32_t m_FramesPerColumn;
 		uint32_t m_FrameCount;
 	};
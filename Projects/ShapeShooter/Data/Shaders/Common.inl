@@ -64,6 +64,16 @@ struct InstanceVertexConstantGlobalData
 #endif
 };
 
+/// Per-instance vertex shader input data for hardware instanced rendering (must match InstanceVertex and
+/// INSTANCE_TRANSFORM_TEXCOORD_INDEX in Dev/Engine/Include/GraphicsTypes/VertexTypes.h).
+struct InstanceVertexInput
+{
+    /// World transform matrix rows.
+    float4 transformRow0 : TEXCOORD4;
+    float4 transformRow1 : TEXCOORD5;
+    float4 transformRow2 : TEXCOORD6;
+};
+
 /// Default sampler state slot.  This will be set by the engine to a sampler state using linear filtering (bilinear,
 /// trilinear, or anisotropic based on the graphics configuration settings) and wrapping texture coordinates.
 ///
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------------------------------------------------
 
 //! @sysselect_v SKINNING NONE SKINNING_SMOOTH SKINNING_RIGID
+//! @systoggle_v INSTANCING
 
 #include "Common.inl"
 
@@ -20,6 +21,9 @@ struct VertexInput
 #endif
 	float4 blendIndices : BLENDINDICES;
 #endif
+#if INSTANCING
+	InstanceVertexInput instance;
+#endif
 };
 
 cbuffer ViewGlobalData
@@ -46,6 +50,9 @@ float4 main( VertexInput vIn ) : POSITION
 #endif
 
 	matrix worldMatrix = matrix( partialSkinningMatrix, float4( 0, 0, 0, 1 ) );
+#elif INSTANCING
+	matrix worldMatrix = matrix(
+		vIn.instance.transformRow0, vIn.instance.transformRow1, vIn.instance.transformRow2, float4( 0, 0, 0, 1 ) );
 #else
     matrix worldMatrix = matrix( InstanceGlobalData.transform, float4( 0, 0, 0, 1 ) );
 #endif
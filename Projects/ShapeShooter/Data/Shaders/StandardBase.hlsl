@@ -9,6 +9,7 @@
 //! @toggle_p NORMAL_MAP
 //! @select SPECULAR NONE SPECULAR_DIFFUSE_ALPHA SPECULAR_MAP
 //! @sysselect_v SKINNING NONE SKINNING_SMOOTH SKINNING_RIGID
+//! @systoggle_v INSTANCING
 //! @sysselect SHADOWS NONE SHADOWS_SIMPLE SHADOWS_PCF_DITHERED
 
 #include "Common.inl"
@@ -50,6 +51,9 @@ struct VertexInput
     float4 color        : COLOR;
 #endif
     float4 texCoord0    : TEXCOORD0;
+#if INSTANCING
+    InstanceVertexInput instance;
+#endif
 };
 
 cbuffer ViewGlobalData
@@ -92,6 +96,9 @@ float4 main( VertexInput vIn, out VertexOutput vOut ) : POSITION
 #endif
 
 	matrix worldMatrix = matrix( partialSkinningMatrix, float4( 0, 0, 0, 1 ) );
+#elif INSTANCING
+    matrix worldMatrix = matrix(
+        vIn.instance.transformRow0, vIn.instance.transformRow1, vIn.instance.transformRow2, float4( 0, 0, 0, 1 ) );
 #else
     matrix worldMatrix = matrix( InstanceGlobalData.transform, float4( 0, 0, 0, 1 ) );
 #endif
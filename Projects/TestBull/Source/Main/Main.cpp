@@ -13,6 +13,11 @@
 #include "Rendering/Renderer.h"
 #include "Windowing/Window.h"
 
+#include "Framework/NullWindowManagerInitialization.h"
+#include "FrameworkImpl/HeadlessRendererInitializationImpl.h"
+#include "RenderingNull/NullImmediateCommandProxy.h"
+#include "RenderingNull/NullRenderer.h"
+
 #include "GameLibrary/Graphics/Sprite.h"
 
 #include "Bullet/BulletEngine.h"
@@ -32,6 +37,9 @@
 
 using namespace Helium;
 
+/// Number of frames to run with the headless renderer if no frame count is specified on the command line.
+static const uint32_t HEADLESS_DEFAULT_FRAME_COUNT = 300;
+
 /// Windows application entry point.
 ///
 /// @param[in] hInstance      Handle to the current instance of the application.
@@ -40,6 +48,9 @@ using namespace Helium;
 /// @param[in] nCmdShow       Flags specifying how the application window should be shown.
 ///
 /// @return  Result code of the application.
+///
+/// Passing "-headless" runs the scene using the headless renderer without creating a window, for "-frames <count>"
+/// frames (or HEADLESS_DEFAULT_FRAME_COUNT frames by default), and fails if nothing was rendered.
 #if HELIUM_OS_WIN
 #include "Platform/SystemWin.h"
 int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPSTR /*lpCmdLine*/, int nCmdShow )
@@ -52,6 +63,30 @@ int main( int argc, const char* argv[] )
 	Log::EnableChannel( Log::Channels::Debug, true );
 #endif
 
+#if HELIUM_OS_WIN
+	int argc = __argc;
+	const char** argv = const_cast< const char** >( __argv );
+#endif
+
+	bool bHeadless = false;
+	uint32_t frameLimit = 0;
+	for( int argIndex = 1; argIndex < argc; ++argIndex )
+	{
+		if( !strcmp( argv[ argIndex ], "-headless" ) )
+		{
+			bHeadless = true;
+		}
+		else if( !strcmp( argv[ argIndex ], "-frames" ) && argIndex + 1 < argc )
+		{
+			frameLimit = static_cast< uint32_t >( strtoul( argv[ ++argIndex ], NULL, 10 ) );
+		}
+	}
+
+	if( bHeadless && frameLimit == 0 )
+	{
+		frameLimit = HEADLESS_DEFAULT_FRAME_COUNT;
+	}
+
 	int32_t result = 0;
 
 	{
@@ -65,6 +100,8 @@ int main( int argc, const char* argv[] )
 		WindowManagerInitializationImpl windowManagerInitialization;
 #endif
 		RendererInitializationImpl rendererInitialization;
+		NullWindowManagerInitialization nullWindowManagerInitialization;
+		HeadlessRendererInitializationImpl headlessRendererInitialization;
 		AssetPath systemDefinitionPath( "/System:System" );
 
 		FilePath base ( __FILE__ );
@@ -81,8 +118,12 @@ int main( int argc, const char* argv[] )
 			memoryHeapPreInitialization,
 			assetLoaderInitialization,
 			configInitialization,
-			windowManagerInitialization,
-			rendererInitialization,
+			bHeadless
+				? static_cast< WindowManagerInitialization& >( nullWindowManagerInitialization )
+				: static_cast< WindowManagerInitialization& >( windowManagerInitialization ),
+			bHeadless
+				? static_cast< RendererInitialization& >( headlessRendererInitialization )
+				: static_cast< RendererInitialization& >( rendererInitialization ),
 			systemDefinitionPath);
 		
 		if( bSystemInitSuccess )
@@ -103,7 +144,33 @@ int main( int argc, const char* argv[] )
 
 			HELIUM_ASSERT( pWorld );
 
-			if ( pWorld )
+			if ( pWorld && bHeadless )
+			{
+				pGameSystem->SetFrameLimit( frameLimit );
+				result = pGameSystem->Run();
+
+				NullRenderer* pRenderer = static_cast< NullRenderer* >( Renderer::GetInstance() );
+				HELIUM_ASSERT( pRenderer );
+				const NullImmediateCommandProxy::Statistics& rStatistics =
+					pRenderer->GetNullImmediateCommandProxy()->GetStatistics();
+
+				HELIUM_TRACE(
+					TraceLevels::Info,
+					( "Headless run: %" PRIu32 " frames, %" PRIu32 " scenes, %" PRIu32 " draw calls, %" PRIu64 " primitives, "
+					  "%" PRIu32 " state changes.\n" ),
+					frameLimit,
+					rStatistics.sceneCount,
+					rStatistics.drawCallCount,
+					rStatistics.primitiveCount,
+					rStatistics.stateChangeCount );
+
+				if( rStatistics.sceneCount == 0 || rStatistics.drawCallCount == 0 )
+				{
+					HELIUM_TRACE( TraceLevels::Error, "Headless run did not render anything.\n" );
+					result = 1;
+				}
+			}
+			else if ( pWorld )
 			{
 				Window::NativeHandle windowHandle = rendererInitialization.GetMainWindow()->GetNativeHandle();
 				Input::Initialize(windowHandle, false);
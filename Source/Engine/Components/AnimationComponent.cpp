@@ -0,0 +1,268 @@
+#include "Precompile.h"
+#include "Components/AnimationComponent.h"
+
+#include "Components/MeshComponent.h"
+#include "Framework/World.h"
+#include "Framework/WorldManager.h"
+#include "Graphics/GraphicsManagerComponent.h"
+#include "Graphics/GraphicsScene.h"
+#include "GraphicsJobs/GraphicsJobsInterface.h"
+#include "Reflect/TranslatorDeduction.h"
+
+using namespace Helium;
+
+HELIUM_DEFINE_COMPONENT(Helium::AnimationComponent, 32);
+
+void AnimationComponent::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+}
+
+/// Constructor.
+AnimationComponent::AnimationComponent()
+: m_PlaybackRate( 1.0f )
+{
+}
+
+/// Destructor.
+AnimationComponent::~AnimationComponent()
+{
+}
+
+void AnimationComponent::Initialize( const AnimationComponentDefinition& definition )
+{
+	m_Animation = definition.m_Animation;
+	m_PlaybackRate = definition.m_PlaybackRate;
+	m_instance.bLoop = definition.m_Loop;
+}
+
+HELIUM_DEFINE_CLASS(Helium::AnimationComponentDefinition);
+
+void AnimationComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField(&AnimationComponentDefinition::m_Animation, "m_Animation");
+	comp.AddField(&AnimationComponentDefinition::m_PlaybackRate, "m_PlaybackRate");
+	comp.AddField(&AnimationComponentDefinition::m_Loop, "m_Loop");
+}
+
+AnimationComponentDefinition::AnimationComponentDefinition()
+	: m_PlaybackRate( 1.0f )
+	, m_Loop( true )
+{
+}
+
+/// Set the animation to play.
+///
+/// Playback restarts from the beginning of the new animation during the next update.
+///
+/// @param[in] pAnimation  Animation to assign (null to hold the reference pose).
+///
+/// @see GetAnimation()
+void AnimationComponent::SetAnimation( Animation* pAnimation )
+{
+	if( m_Animation.Get() != pAnimation )
+	{
+		m_Animation = pAnimation;
+
+		// Rebuild the bone track map for the new animation during the next update.
+		m_spBoundMesh.Release();
+	}
+}
+
+/// Prepare this component's animation instance for pose sampling.
+///
+/// The animation data is (re)bound to the mesh of the given mesh component if either has changed, and the playback
+/// time is advanced.
+///
+/// @param[in] pMeshComponent  Sibling mesh component.
+/// @param[in] deltaSeconds    Time elapsed since the last update, in seconds.
+///
+/// @return  Animation instance to update, or null if the mesh is not a skinned mesh.
+///
+/// @see EndUpdate()
+AnimationInstance* AnimationComponent::BeginUpdate( MeshComponent* pMeshComponent, float32_t deltaSeconds )
+{
+	HELIUM_ASSERT( pMeshComponent );
+
+	Mesh* pMesh = pMeshComponent->GetMesh();
+	if( !m_spBoundMesh || m_spBoundMesh.Get() != pMesh )
+	{
+		BindMesh( pMesh );
+	}
+
+	if( !m_instance.pReferencePose )
+	{
+		return NULL;
+	}
+
+	m_instance.Advance( deltaSeconds * m_PlaybackRate );
+
+	return &m_instance;
+}
+
+/// Assign the updated bone palette to the graphics scene object of the given mesh component.
+///
+/// @param[in] pGraphicsScene  Graphics scene to which the mesh is attached.
+/// @param[in] pMeshComponent  Sibling mesh component.
+///
+/// @see BeginUpdate()
+void AnimationComponent::EndUpdate( GraphicsScene* pGraphicsScene, MeshComponent* pMeshComponent )
+{
+	HELIUM_ASSERT( pGraphicsScene );
+	HELIUM_ASSERT( pMeshComponent );
+
+	size_t sceneObjectId = pMeshComponent->GetGraphicsSceneObjectId();
+	if( IsInvalid( sceneObjectId ) )
+	{
+		return;
+	}
+
+	GraphicsSceneObject* pSceneObject = pGraphicsScene->GetSceneObject( sceneObjectId );
+	HELIUM_ASSERT( pSceneObject );
+
+	if( !m_instance.pReferencePose )
+	{
+		pSceneObject->SetBoneData( NULL, 0 );
+		pSceneObject->SetBonePalette( NULL );
+
+		return;
+	}
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+	pSceneObject->SetBoneData( m_inverseReferencePose.GetData(), m_referencePose.GetBoneCount() );
+#endif
+	pSceneObject->SetBonePalette( m_bonePalette.GetData() );
+}
+
+/// Build the skeleton data needed to play the current animation on the given mesh.
+///
+/// @param[in] pMesh  Mesh to which to bind.
+///
+/// @return  True if the mesh is a skinned mesh that can be animated, false if not.
+bool AnimationComponent::BindMesh( Mesh* pMesh )
+{
+	m_spBoundMesh = pMesh;
+
+	m_instance.pReferencePose = NULL;
+	m_instance.pParentBoneIndices = NULL;
+	m_instance.pBonePalette = NULL;
+	m_instance.pClips[ 0 ] = NULL;
+	m_instance.pBoneTrackIndices[ 0 ] = NULL;
+	m_instance.times[ 0 ] = 0.0f;
+
+#if HELIUM_USE_GRANNY_ANIMATION
+	return false;
+#else
+	if( !pMesh || !pMesh->IsSkinned() )
+	{
+		return false;
+	}
+
+	uint8_t boneCount = pMesh->GetBoneCount();
+	const uint8_t* pParentBoneIndices = pMesh->GetParentBoneIndices();
+	const Simd::Matrix44* pReferenceTransforms = pMesh->GetReferencePose();
+	if( !pParentBoneIndices || !pReferenceTransforms )
+	{
+		return false;
+	}
+
+	m_referencePose.SetReferencePose( pReferenceTransforms, boneCount );
+
+	// Skinning transforms vertices from the model-space reference pose into the animated pose.
+	m_inverseReferencePose.Reserve( boneCount );
+	m_inverseReferencePose.Resize( boneCount );
+	m_referencePose.ComputeModelTransforms( pParentBoneIndices, m_inverseReferencePose.GetData() );
+	for( uint8_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+	{
+		m_inverseReferencePose[ boneIndex ].Invert();
+	}
+
+	m_bonePalette.Reserve( boneCount );
+	m_bonePalette.Resize( boneCount );
+
+	m_instance.pReferencePose = &m_referencePose;
+	m_instance.pParentBoneIndices = pParentBoneIndices;
+	m_instance.pBonePalette = m_bonePalette.GetData();
+
+	Animation* pAnimation = m_Animation;
+	if( pAnimation )
+	{
+		pAnimation->GetClipData( m_clipData );
+
+		m_boneTrackIndices.Reserve( boneCount );
+		m_boneTrackIndices.Resize( boneCount );
+		pAnimation->BuildBoneTrackMap( pMesh->GetBoneNames(), boneCount, m_boneTrackIndices.GetData() );
+
+		m_instance.pClips[ 0 ] = &m_clipData;
+		m_instance.pBoneTrackIndices[ 0 ] = m_boneTrackIndices.GetData();
+	}
+
+	return true;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void UpdateAnimationComponents( World *pWorld )
+{
+	ComponentManager *pComponentManager = pWorld->GetComponentManager();
+	HELIUM_ASSERT( pComponentManager );
+
+	size_t componentCount = pComponentManager->CountAllocatedComponents< AnimationComponent >();
+	if( componentCount == 0 )
+	{
+		return;
+	}
+
+	GraphicsManagerComponent *pGraphicsManager = pWorld->GetComponents().GetFirst<GraphicsManagerComponent>();
+	HELIUM_ASSERT( pGraphicsManager );
+
+	GraphicsScene *pGraphicsScene = pGraphicsManager->GetGraphicsScene();
+	HELIUM_ASSERT( pGraphicsScene );
+
+	WorldManager* pWorldManager = WorldManager::GetInstance();
+	HELIUM_ASSERT( pWorldManager );
+
+	float32_t deltaSeconds = pWorldManager->GetFrameDeltaSeconds();
+
+	// Advance playback and gather the instances of all animated skinned meshes.
+	DynamicArray< AnimationInstance* > instances;
+	instances.Reserve( componentCount );
+
+	for( ComponentIteratorT< AnimationComponent > iter( *pComponentManager ); iter.GetBaseComponent(); iter.Advance() )
+	{
+		MeshComponent *pMeshComponent = iter->GetComponentCollection()->GetFirst<MeshComponent>();
+		if( pMeshComponent )
+		{
+			AnimationInstance* pInstance = iter->BeginUpdate( pMeshComponent, deltaSeconds );
+			if( pInstance )
+			{
+				instances.Push( pInstance );
+			}
+		}
+	}
+
+	// Sample the poses of all instances in parallel.
+	UpdateAnimationPosesJobSpawner poseSpawner;
+	UpdateAnimationPosesJobSpawner::Parameters& rPoseParameters = poseSpawner.GetParameters();
+	rPoseParameters.instanceCount = static_cast< uint32_t >( instances.GetSize() );
+	rPoseParameters.ppInstances = instances.GetData();
+	poseSpawner.Run();
+
+	// Hand the new bone palettes to the graphics scene.
+	for( ComponentIteratorT< AnimationComponent > iter( *pComponentManager ); iter.GetBaseComponent(); iter.Advance() )
+	{
+		MeshComponent *pMeshComponent = iter->GetComponentCollection()->GetFirst<MeshComponent>();
+		if( pMeshComponent )
+		{
+			iter->EndUpdate( pGraphicsScene, pMeshComponent );
+		}
+	}
+}
+
+void Helium::UpdateAnimationComponentsTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteBefore<StandardDependencies::Render>();
+	rContract.ExecuteAfter<UpdateMeshComponentsTask>();
+}
+
+HELIUM_DEFINE_TASK( UpdateAnimationComponentsTask, (ForEachWorld< UpdateAnimationComponents >), TickTypes::Render );
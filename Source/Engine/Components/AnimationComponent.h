@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Components/Components.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Framework/ComponentDefinition.h"
+#include "Framework/TaskScheduler.h"
+#include "Graphics/Animation.h"
+#include "Graphics/Mesh.h"
+#include "GraphicsTypes/AnimationInstance.h"
+
+namespace Helium
+{
+	struct AnimationComponentDefinition;
+
+	class GraphicsScene;
+	class MeshComponent;
+
+	/// Plays an animation on the skinned mesh of a sibling MeshComponent.
+	///
+	/// Each frame, UpdateAnimationComponentsTask advances the playback time of every animation component, samples the
+	/// poses of all of them in parallel with UpdateAnimationPosesJobSpawner, and hands the resulting bone palettes to
+	/// the graphics scene objects of their meshes (the graphics scene copies the palettes into each render snapshot, so
+	/// they can be updated again while a previous frame is being rendered).
+	class HELIUM_COMPONENTS_API AnimationComponent : public Component
+	{
+	public:
+		HELIUM_DECLARE_COMPONENT( Helium::AnimationComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		AnimationComponent();
+		virtual ~AnimationComponent();
+
+		void Initialize( const Helium::AnimationComponentDefinition& definition );
+
+		/// @name Animation Playback
+		//@{
+		void SetAnimation( Animation* pAnimation );
+		inline Animation* GetAnimation() const;
+
+		inline void SetPlaybackRate( float32_t playbackRate );
+		inline float32_t GetPlaybackRate() const;
+		//@}
+
+		/// @name Updating
+		//@{
+		AnimationInstance* BeginUpdate( MeshComponent* pMeshComponent, float32_t deltaSeconds );
+		void EndUpdate( GraphicsScene* pGraphicsScene, MeshComponent* pMeshComponent );
+		//@}
+
+	private:
+		/// Animation to play.
+		StrongPtr< Animation > m_Animation;
+		/// Playback speed multiplier.
+		float32_t m_PlaybackRate;
+
+		/// Mesh to which the animation data is currently bound.
+		StrongPtr< Mesh > m_spBoundMesh;
+
+		/// Clip data view of the animation.
+		AnimationClipData m_clipData;
+		/// Track index of each mesh bone.
+		DynamicArray< uint16_t > m_boneTrackIndices;
+		/// Local-space reference pose of the mesh skeleton.
+		AnimationPose m_referencePose;
+		/// Inverse model-space reference transform of each bone.
+		DynamicArray< Simd::Matrix44 > m_inverseReferencePose;
+		/// Model-space bone transforms of the current pose.
+		DynamicArray< Simd::Matrix44 > m_bonePalette;
+
+		/// Playback state.
+		AnimationInstance m_instance;
+
+		/// @name Private Utility Functions
+		//@{
+		bool BindMesh( Mesh* pMesh );
+		//@}
+	};
+	typedef Helium::ComponentPtr< AnimationComponent > AnimationComponentPtr;
+
+	struct HELIUM_COMPONENTS_API AnimationComponentDefinition : public Helium::ComponentDefinitionHelper< AnimationComponent, AnimationComponentDefinition >
+	{
+	public:
+		HELIUM_DECLARE_CLASS( Helium::AnimationComponentDefinition, Helium::ComponentDefinition );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		AnimationComponentDefinition();
+
+		StrongPtr< Animation > m_Animation;
+		float32_t m_PlaybackRate;
+		bool m_Loop;
+	};
+	typedef StrongPtr< AnimationComponentDefinition > AnimationComponentDefinitionPtr;
+
+	struct HELIUM_COMPONENTS_API UpdateAnimationComponentsTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(UpdateAnimationComponentsTask);
+		virtual void DefineContract(TaskContract &rContract);
+	};
+}
+
+#include "AnimationComponent.inl"
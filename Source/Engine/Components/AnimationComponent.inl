@@ -0,0 +1,29 @@
+/// Get the animation played by this component.
+///
+/// @return  Assigned animation.
+///
+/// @see SetAnimation()
+Helium::Animation* Helium::AnimationComponent::GetAnimation() const
+{
+    return m_Animation;
+}
+
+/// Set the playback speed multiplier.
+///
+/// @param[in] playbackRate  Playback rate (1 for normal speed).
+///
+/// @see GetPlaybackRate()
+void Helium::AnimationComponent::SetPlaybackRate( float32_t playbackRate )
+{
+    m_PlaybackRate = playbackRate;
+}
+
+/// Get the playback speed multiplier.
+///
+/// @return  Playback rate.
+///
+/// @see SetPlaybackRate()
+float32_t Helium::AnimationComponent::GetPlaybackRate() const
+{
+    return m_PlaybackRate;
+}
@@ -54,6 +54,8 @@ void MeshComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 /// Constructor.
 MeshComponent::MeshComponent()
 : m_graphicsSceneObjectId( Invalid< size_t >() )
+, m_graphicsSceneOccluderId( Invalid< size_t >() )
+, m_NeedsReattach( false )
 {
 }
 
@@ -73,6 +75,7 @@ void MeshComponent::Attach(GraphicsScene *pGrahpicsScene, TransformComponent *pT
 
 	HELIUM_ASSERT( pGrahpicsScene );
 	HELIUM_ASSERT( IsInvalid( m_graphicsSceneObjectId ) );
+	HELIUM_ASSERT( IsInvalid( m_graphicsSceneOccluderId ) );
 
 	Mesh* pMesh = m_Mesh;
 	if( pMesh && pMesh->GetVertexBuffer() && pMesh->GetIndexBuffer() )
@@ -92,11 +95,28 @@ void MeshComponent::Attach(GraphicsScene *pGrahpicsScene, TransformComponent *pT
 			for( size_t meshSectionIndex = 0; meshSectionIndex < meshSectionCount; ++meshSectionIndex )
 			{
 				size_t subMeshId = pGraphicsScene->AllocateSceneObjectSubMeshData( m_graphicsSceneObjectId );
-				HELIUM_ASSERT( IsValid( subMeshId ) );
+				if( IsInvalid( subMeshId ) )
+				{
+					// Scene sub-mesh limit reached; sections without sub-mesh data are not drawn.
+					m_graphicsSceneObjectSubMeshDataIds.Resize( meshSectionIndex );
+					break;
+				}
+
 				m_graphicsSceneObjectSubMeshDataIds[ meshSectionIndex ] = subMeshId;
 			}
-			
-			SetNeedsGraphicsSceneObjectUpdate(pTransformComponent);
+
+			if( pMesh->HasOccluderData() )
+			{
+				m_graphicsSceneOccluderId = pGraphicsScene->AllocateOccluder(
+					pMesh->GetOccluderVertices(),
+					pMesh->GetOccluderVertexCount(),
+					pMesh->GetOccluderIndices(),
+					pMesh->GetOccluderTriangleCount() );
+				HELIUM_ASSERT( IsValid( m_graphicsSceneOccluderId ) );
+			}
+
+			SetGraphicsSceneObjectData( pGraphicsScene );
+			QueueGraphicsSceneObjectTransform( pGraphicsScene, pTransformComponent );
 		}
 	}
 }
@@ -118,6 +138,12 @@ void MeshComponent::Detach(GraphicsScene *pGraphicsScene)
 
 	m_graphicsSceneObjectSubMeshDataIds.Resize( 0 );
 
+	if( IsValid( m_graphicsSceneOccluderId ) )
+	{
+		pGraphicsScene->ReleaseOccluder( m_graphicsSceneOccluderId );
+		SetInvalid( m_graphicsSceneOccluderId );
+	}
+
 	if( IsValid( m_graphicsSceneObjectId ) )
 	{
 		pGraphicsScene->ReleaseSceneObject( m_graphicsSceneObjectId );
@@ -139,70 +165,49 @@ void MeshComponent::SetMesh( Mesh* pMesh )
 	}
 }
 
-/// Flag the graphics scene object as requiring an update if one exists.
-///
-/// This is safe to call by an entity during its pre-update.  It should only ever be called by the entity itself.
+/// Reattach this component to the graphics scene during the next update.
 ///
-/// @param[in] updateMode  Scene object update mode.
-void MeshComponent::SetNeedsGraphicsSceneObjectUpdate(
-	TransformComponent *pTransform,
-	GraphicsSceneObject::EUpdate updateMode )
+/// Mesh components are only updated along with changed transforms, so the transform of the entity is flagged as
+/// changed as well.
+void MeshComponent::DeferredReattach()
 {
-	if( IsValid( m_graphicsSceneObjectId ) )
+	m_NeedsReattach = true;
+
+	TransformComponent *pTransform = GetComponentCollection()->GetFirst<TransformComponent>();
+	if( pTransform )
 	{
-		if (m_MeshSceneObjectTransformComponent.IsGood())
-		{
-			m_MeshSceneObjectTransformComponent->Update( updateMode );
-		}
-		else
-		{
-			m_MeshSceneObjectTransformComponent = AllocateSiblingComponent<MeshSceneObjectTransform>();
-			m_MeshSceneObjectTransformComponent->Setup(pTransform, this, updateMode, m_graphicsSceneObjectId);
-		}
+		pTransform->MarkDirty();
 	}
 }
 
-/// Callback used to update graphics scene object information prior to the graphics scene update.
+/// Set the mesh data (bounds, vertex data and sub-mesh data) of the graphics scene object.
 ///
-/// @param[in] pData         Callback data (pointer to the MeshEntity).
-/// @param[in] pScene        Graphics scene to which the object is attached.
-/// @param[in] pSceneObject  Graphics scene object to update.
-void MeshComponent::GraphicsSceneObjectUpdate(
-	MeshComponent* pThis,
-	GraphicsScene* pScene,
-	TransformComponent *pTransform,
-	GraphicsSceneObject::EUpdate,
-	size_t graphicsSceneObjectId)
+/// This only needs to be done when the object is attached.  Transform changes are queued separately using
+/// QueueGraphicsSceneObjectTransform().
+///
+/// @param[in] pGraphicsScene  Graphics scene to which the object is attached.
+void MeshComponent::SetGraphicsSceneObjectData( GraphicsScene *pGraphicsScene )
 {
-	GraphicsSceneObject* pSceneObject = pScene->GetSceneObject( graphicsSceneObjectId );
+	HELIUM_ASSERT( pGraphicsScene );
+	HELIUM_ASSERT( IsValid( m_graphicsSceneObjectId ) );
 
-	HELIUM_ASSERT( pScene );
+	GraphicsSceneObject* pSceneObject = pGraphicsScene->GetSceneObject( m_graphicsSceneObjectId );
 	HELIUM_ASSERT( pSceneObject );
-	
-	const Simd::Vector3& rPosition = pTransform->GetPosition();
-	Simd::Matrix44 transform(
-		Simd::Matrix44::INIT_ROTATION_TRANSLATION,
-		pTransform->GetRotation(),
-		rPosition);
-	transform.ScaleLocal( pTransform->GetScale() );
-	pSceneObject->SetTransform( transform );
 
-	Mesh* pMesh = pThis->m_Mesh;
-
-	Simd::AaBox worldBounds( rPosition, rPosition );
-
-	// Only thing remaining if this is a transform-only update is the world bounds, so update it and return.
-	if( pSceneObject->GetUpdateMode() == GraphicsSceneObject::UPDATE_TRANSFORM_ONLY )
+	Mesh* pMesh = m_Mesh;
+	if( pMesh )
 	{
-		if( pMesh )
+		const Simd::AaBox& rBounds = pMesh->GetBounds();
+		pGraphicsScene->SetSceneObjectLocalBounds( m_graphicsSceneObjectId, rBounds );
+
+		// Fold the dequantization of quantized vertex positions into the rendering transform.
+		if( pMesh->HasQuantizedPositions() )
 		{
-			worldBounds = pMesh->GetBounds();
-			worldBounds.TransformBy( transform );
+			Simd::Vector3 positionOffset;
+			float32_t positionScale;
+			Mesh::GetPositionQuantization( rBounds, positionOffset, positionScale );
+			pGraphicsScene->SetSceneObjectPositionQuantization( m_graphicsSceneObjectId, positionOffset, positionScale );
 		}
-
-		pSceneObject->SetWorldBounds( worldBounds );
-
-		return;
 	}
 
 	RVertexBuffer* pVertexBuffer = NULL;
@@ -211,14 +216,9 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 	{
 		pVertexBuffer = pMesh->GetVertexBuffer();
 		pIndexBuffer = pMesh->GetIndexBuffer();
-
-		worldBounds = pMesh->GetBounds();
-		worldBounds.TransformBy( transform );
 	}
 
-	pSceneObject->SetWorldBounds( worldBounds );
-
-	const DynamicArray< size_t >& rSubMeshDataIds = pThis->m_graphicsSceneObjectSubMeshDataIds;
+	const DynamicArray< size_t >& rSubMeshDataIds = m_graphicsSceneObjectSubMeshDataIds;
 	size_t subMeshCount = rSubMeshDataIds.GetSize();
 	size_t meshSectionCount = 0;
 
@@ -232,13 +232,20 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
 		HELIUM_ASSERT( pRenderResourceManager );
 
+		bool bSkinned = pMesh->IsSkinned();
+
 		RVertexDescription* pVertexDescription;
 		uint32_t vertexStride;
-		if( pMesh->IsSkinned() )
+		if( bSkinned )
 		{
 			pVertexDescription = pRenderResourceManager->GetSkinnedMeshVertexDescription();
 			vertexStride = static_cast< uint32_t >( sizeof( SkinnedMeshVertex ) );
 		}
+		else if( pMesh->HasQuantizedPositions() )
+		{
+			pVertexDescription = pRenderResourceManager->GetQuantizedStaticMeshVertexDescription( 1 );
+			vertexStride = static_cast< uint32_t >( sizeof( QuantizedStaticMeshVertex< 1 > ) );
+		}
 		else
 		{
 			pVertexDescription = pRenderResourceManager->GetStaticMeshVertexDescription( 1 );
@@ -258,19 +265,21 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		uint32_t sectionIndexOffset = 0;
 		for( size_t meshSectionIndex = 0; meshSectionIndex < meshSectionCount; ++meshSectionIndex )
 		{
-			GraphicsSceneObject::SubMeshData* pSubMeshData = pScene->GetSceneObjectSubMeshData(
+			GraphicsSceneObject::SubMeshData* pSubMeshData = pGraphicsScene->GetSceneObjectSubMeshData(
 				rSubMeshDataIds[ meshSectionIndex ] );
 			HELIUM_ASSERT( pSubMeshData );
 
 			uint32_t vertexCount = pMesh->GetSectionVertexCount( meshSectionIndex );
 			uint32_t triangleCount = pMesh->GetSectionTriangleCount( meshSectionIndex );
 
-			pSubMeshData->SetMaterial( pThis->GetMaterial( meshSectionIndex ) );
+			pSubMeshData->SetMaterial( GetMaterial( meshSectionIndex ) );
 			pSubMeshData->SetPrimitiveType( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST );
 			pSubMeshData->SetPrimitiveCount( triangleCount );
 			pSubMeshData->SetStartVertex( sectionVertexOffset );
 			pSubMeshData->SetVertexRange( vertexCount );
 			pSubMeshData->SetStartIndex( sectionIndexOffset );
+			pSubMeshData->SetSkinningPaletteMap(
+				bSkinned ? pMesh->GetSectionSkinningPaletteMap( meshSectionIndex ) : NULL );
 
 			sectionVertexOffset += vertexCount;
 			sectionIndexOffset += triangleCount * 3;
@@ -279,7 +288,7 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 
 	for( size_t unusedSubMeshIndex = meshSectionCount; unusedSubMeshIndex < subMeshCount; ++unusedSubMeshIndex )
 	{
-		GraphicsSceneObject::SubMeshData* pSubMeshData = pScene->GetSceneObjectSubMeshData(
+		GraphicsSceneObject::SubMeshData* pSubMeshData = pGraphicsScene->GetSceneObjectSubMeshData(
 			rSubMeshDataIds[ unusedSubMeshIndex ] );
 		HELIUM_ASSERT( pSubMeshData );
 
@@ -289,80 +298,81 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		pSubMeshData->SetStartVertex( 0 );
 		pSubMeshData->SetVertexRange( 0 );
 		pSubMeshData->SetStartIndex( 0 );
+		pSubMeshData->SetSkinningPaletteMap( NULL );
 	}
 }
 
-void Helium::MeshComponent::Update( GraphicsScene *pGraphicsScene, TransformComponent *pTransform )
+/// Queue the current placement of the graphics scene object for the next graphics scene update, and update the
+/// placement of its occluder (if any).
+///
+/// @param[in] pGraphicsScene  Graphics scene to which the object is attached.
+/// @param[in] pTransform      Transform from which to take the object placement.
+void MeshComponent::QueueGraphicsSceneObjectTransform( GraphicsScene *pGraphicsScene, TransformComponent *pTransform )
 {
-	if (m_NeedsReattach)
+	HELIUM_ASSERT( pGraphicsScene );
+	HELIUM_ASSERT( pTransform );
+
+	if( IsValid( m_graphicsSceneObjectId ) )
 	{
-		Detach(pGraphicsScene);
-		Attach(pGraphicsScene, pTransform);
+		pGraphicsScene->QueueSceneObjectTransform(
+			m_graphicsSceneObjectId,
+			pTransform->GetPosition(),
+			pTransform->GetRotation(),
+			pTransform->GetScale() );
 	}
 
-	if (pTransform->IsDirty())
+	if( IsValid( m_graphicsSceneOccluderId ) )
 	{
-	   SetNeedsGraphicsSceneObjectUpdate( pTransform, GraphicsSceneObject::UPDATE_TRANSFORM_ONLY );
+		Simd::Matrix44 occluderTransform;
+		occluderTransform.SetRotationTranslationScaling(
+			pTransform->GetRotation(),
+			pTransform->GetPosition(),
+			pTransform->GetScale() );
+		pGraphicsScene->SetOccluderTransform( m_graphicsSceneOccluderId, occluderTransform );
 	}
 }
 
-
-HELIUM_DEFINE_COMPONENT(Helium::MeshSceneObjectTransform, 128);
-
-Helium::MeshSceneObjectTransform::MeshSceneObjectTransform()
-{
-
-}
-
-Helium::MeshSceneObjectTransform::MeshSceneObjectTransform( const MeshSceneObjectTransform &rRhs )
-{
-	m_TransformComponent = rRhs.m_TransformComponent;
-	m_MeshComponent = rRhs.m_MeshComponent;
-	m_UpdateMode = rRhs.m_UpdateMode;
-	m_graphicsSceneObjectId = rRhs.m_graphicsSceneObjectId;
-}
-
-void Helium::MeshSceneObjectTransform::Setup( class TransformComponent *pTransform, class MeshComponent *pMesh, GraphicsSceneObject::EUpdate updateMode, size_t graphicsSceneObjectId )
-{
-	m_TransformComponent = pTransform;
-	m_MeshComponent = pMesh;
-	m_UpdateMode = updateMode;
-	m_graphicsSceneObjectId = graphicsSceneObjectId;
-}
-
-void Helium::MeshSceneObjectTransform::Update(GraphicsSceneObject::EUpdate updateMode)
+void Helium::MeshComponent::Update( GraphicsScene *pGraphicsScene, TransformComponent *pTransform )
 {
-	m_UpdateMode = Helium::Max(updateMode, m_UpdateMode);
-}
+	if (m_NeedsReattach)
+	{
+		m_NeedsReattach = false;
 
-void Helium::MeshSceneObjectTransform::GraphicsSceneObjectUpdate( GraphicsScene *pScene )
-{
-	if (m_MeshComponent.Get() && m_TransformComponent.Get())
+		// Attaching queues the current transform, so there is no need to check whether it is dirty.
+		Detach(pGraphicsScene);
+		Attach(pGraphicsScene, pTransform);
+	}
+	else
 	{
-		MeshComponent::GraphicsSceneObjectUpdate(m_MeshComponent.Get(), pScene, m_TransformComponent.Get(), m_UpdateMode, m_graphicsSceneObjectId);
+		QueueGraphicsSceneObjectTransform( pGraphicsScene, pTransform );
 	}
-
-	FreeComponentDeferred();
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-static GraphicsScene *pGraphicsScene = NULL;
-
-void UpdateMeshComponent(TransformComponent *pTransform, MeshComponent *pMeshComponent)
-{
-	pMeshComponent->Update( pGraphicsScene, pTransform );
-}
-
 void UpdateMeshComponents( World *pWorld )
 {
 	GraphicsManagerComponent *pGraphicsManager = pWorld->GetComponents().GetFirst<GraphicsManagerComponent>();
 	HELIUM_ASSERT( pGraphicsManager );
 
-	pGraphicsScene = pGraphicsManager->GetGraphicsScene();
+	GraphicsScene *pGraphicsScene = pGraphicsManager->GetGraphicsScene();
 	HELIUM_ASSERT( pGraphicsScene );
 
-	QueryComponents< TransformComponent, MeshComponent, UpdateMeshComponent >( pWorld );
+	// Only mesh components whose transforms changed this frame need updating (mesh components needing to be
+	// reattached flag their transform as changed as well).
+	const DynamicArray< Component* >& rChangedTransforms = pWorld->GetChangedTransforms();
+	size_t transformCount = rChangedTransforms.GetSize();
+	for( size_t transformIndex = 0; transformIndex < transformCount; ++transformIndex )
+	{
+		TransformComponent *pTransform = static_cast< TransformComponent* >( rChangedTransforms[ transformIndex ] );
+		HELIUM_ASSERT( pTransform );
+
+		MeshComponent *pMeshComponent = pTransform->GetComponentCollection()->GetFirst<MeshComponent>();
+		if( pMeshComponent )
+		{
+			pMeshComponent->Update( pGraphicsScene, pTransform );
+		}
+	}
 }
 
 void Helium::UpdateMeshComponentsTask::DefineContract( TaskContract &rContract )
@@ -14,7 +14,6 @@ namespace Helium
 {
 	struct MeshComponentDefinition;
 
-	class MeshSceneObjectTransform;
 	class GraphicsManagerComponent;
 
 	class HELIUM_COMPONENTS_API MeshComponent : public Component
@@ -44,19 +43,11 @@ namespace Helium
 		inline Material* GetOverrideMaterial( size_t index ) const;
 
 		inline Material* GetMaterial( size_t index ) const;
+
+		inline size_t GetGraphicsSceneObjectId() const;
 		//@}
 
 		void Update( class GraphicsScene *pGraphicsScene, class TransformComponent *pTransform );
-		
-		/// @name Scene GameObject Synchronization Callback
-		//@{
-		static void GraphicsSceneObjectUpdate( 
-			MeshComponent* pMesh, 
-			GraphicsScene* pScene, 
-			TransformComponent *pTransform, 
-			GraphicsSceneObject::EUpdate,
-			size_t graphicsSceneObjectId);
-		//@}
 
 	private:
 		/// The mesh
@@ -68,19 +59,18 @@ namespace Helium
 		size_t m_graphicsSceneObjectId;
 		/// IDs of scene object sub-mesh data for each sub-mesh of this entity's mesh.
 		DynamicArray< size_t > m_graphicsSceneObjectSubMeshDataIds;
-
-		ComponentPtr<MeshSceneObjectTransform> m_MeshSceneObjectTransformComponent;
+		/// ID of the occluder for this entity's mesh in the graphics scene (invalid if the mesh is not an occluder).
+		size_t m_graphicsSceneOccluderId;
 
 		bool m_NeedsReattach;
 
 		/// @name Graphics Scene GameObject Updating
 		//@{
-		void SetNeedsGraphicsSceneObjectUpdate(
-			TransformComponent *pTransform,
-			GraphicsSceneObject::EUpdate updateMode = GraphicsSceneObject::UPDATE_FULL );
+		void SetGraphicsSceneObjectData( GraphicsScene *pGraphicsScene );
+		void QueueGraphicsSceneObjectTransform( GraphicsScene *pGraphicsScene, TransformComponent *pTransform );
 		//@}
 
-		void DeferredReattach() { m_NeedsReattach = true; }
+		void DeferredReattach();
 	};
 	typedef Helium::ComponentPtr<MeshComponent> MeshComponentPtr;
 	
@@ -95,27 +85,6 @@ namespace Helium
 	};
 	typedef StrongPtr<MeshComponentDefinition> MeshComponentDefinitionPtr;
 	
-	class HELIUM_COMPONENTS_API MeshSceneObjectTransform : public SceneObjectTransform
-	{
-	public:
-		MeshSceneObjectTransform();
-		MeshSceneObjectTransform(const MeshSceneObjectTransform &rRhs);
-
-		HELIUM_DECLARE_COMPONENT( Helium::MeshSceneObjectTransform, SceneObjectTransform );
-
-		void Setup(TransformComponent *pTransform, MeshComponent *pMesh, GraphicsSceneObject::EUpdate updateMode, size_t graphicsSceneObjectId);
-		void Update(GraphicsSceneObject::EUpdate updateMode);
-
-		virtual void GraphicsSceneObjectUpdate(GraphicsScene *pScene);
-
-		const MeshComponent *GetMeshComponent() const { return m_MeshComponent.Get(); }
-
-		TransformComponentPtr m_TransformComponent;
-		MeshComponentPtr m_MeshComponent;
-		GraphicsSceneObject::EUpdate m_UpdateMode;
-		size_t m_graphicsSceneObjectId;
-	};
-
 	struct HELIUM_COMPONENTS_API UpdateMeshComponentsTask : public TaskDefinition
 	{
 		HELIUM_DECLARE_TASK(UpdateMeshComponentsTask);
@@ -48,3 +48,11 @@ Helium::Material* Helium::MeshComponent::GetMaterial( size_t index ) const
 
     return ( m_Mesh ? m_Mesh->GetMaterial( index ) : NULL );
 }
+
+/// Get the ID of the graphics scene object representing this entity's mesh.
+///
+/// @return  Scene object ID, or an invalid index if the mesh is not attached to a graphics scene.
+size_t Helium::MeshComponent::GetGraphicsSceneObjectId() const
+{
+    return m_graphicsSceneObjectId;
+}
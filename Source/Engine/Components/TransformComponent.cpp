@@ -12,12 +12,50 @@ void Helium::TransformComponent::PopulateMetaType( Reflect::MetaStruct& comp )
 {
 }
 
+Helium::TransformComponent::TransformComponent()
+: m_Scale( 1.0f )
+, m_bDirty( false )
+{
+}
+
+Helium::TransformComponent::~TransformComponent()
+{
+	if( m_bDirty )
+	{
+		World* pWorld = GetWorld();
+		if( pWorld )
+		{
+			pWorld->RemoveChangedTransform( this );
+		}
+	}
+}
+
 void Helium::TransformComponent::Initialize( const TransformComponentDefinition &definition )
 {
 	m_Position = definition.m_Position;
 	m_Rotation = definition.m_Rotation;
 	m_Scale = definition.m_Scale;
+	MarkDirty();
+}
+
+/// Flag this transform as changed, adding it to the world's changed transform list if it is not already there.
+///
+/// The flag and list are cleared by ClearTransformComponentDirtyFlagsTask once rendering for the frame has been
+/// updated.
+void Helium::TransformComponent::MarkDirty()
+{
+	if( m_bDirty )
+	{
+		return;
+	}
+
 	m_bDirty = true;
+
+	World* pWorld = GetWorld();
+	if( pWorld )
+	{
+		pWorld->AddChangedTransform( this );
+	}
 }
 
 HELIUM_DEFINE_CLASS(Helium::TransformComponentDefinition);
@@ -39,19 +77,16 @@ void Helium::TransformComponentDefinition::PopulateMetaType( Reflect::MetaStruct
 
 //////////////////////////////////////////////////////////////////////////
 
-//void ClearTransformComponentDirtyFlags( World *pWorld )
-//{
-//    Components::ComponentListT<TransformComponent> list = pWorld->GetComponentManager()->GetAllocatedComponents<TransformComponent>();
-// 
-//    for (int i = 0; i < list.m_Count; ++i)
-//    {
-//        list.m_pComponents[i]->ClearDirtyFlag();
-//    }
-//}
-
-void ClearTransformComponentDirtyFlags( TransformComponent *pComponent )
+void ClearTransformComponentDirtyFlags( World *pWorld )
 {
-	pComponent->ClearDirtyFlag();
+	const DynamicArray< Component* >& rChangedTransforms = pWorld->GetChangedTransforms();
+	size_t transformCount = rChangedTransforms.GetSize();
+	for( size_t transformIndex = 0; transformIndex < transformCount; ++transformIndex )
+	{
+		static_cast< TransformComponent* >( rChangedTransforms[ transformIndex ] )->ClearDirtyFlag();
+	}
+
+	pWorld->ClearChangedTransforms();
 }
 
 void Helium::ClearTransformComponentDirtyFlagsTask::DefineContract( TaskContract &rContract )
@@ -59,5 +94,4 @@ void Helium::ClearTransformComponentDirtyFlagsTask::DefineContract( TaskContract
 	rContract.ExecuteAfter<StandardDependencies::Render>();
 }
 
-//HELIUM_DEFINE_TASK(ClearTransformComponentDirtyFlagsTask, ForEachWorld<ClearTransformComponentDirtyFlags> )
-HELIUM_DEFINE_TASK( ClearTransformComponentDirtyFlagsTask, (ForEachWorld< QueryComponents< TransformComponent, ClearTransformComponentDirtyFlags > >), TickTypes::Render )
+HELIUM_DEFINE_TASK( ClearTransformComponentDirtyFlagsTask, (ForEachWorld< ClearTransformComponentDirtyFlags >), TickTypes::Render )
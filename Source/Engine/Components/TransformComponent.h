@@ -16,18 +16,22 @@ namespace Helium
 		HELIUM_DECLARE_COMPONENT( Helium::TransformComponent, Helium::Component );
 		static void PopulateMetaType( Reflect::MetaStruct& comp );
 
+		TransformComponent();
+		~TransformComponent();
+
 		void Initialize( const TransformComponentDefinition &definition );
 				
 		inline const Simd::Vector3& GetPosition() const { return m_Position; }
-		virtual void SetPosition( const Simd::Vector3& rPosition ) { m_Position = rPosition; m_bDirty = true; }
+		virtual void SetPosition( const Simd::Vector3& rPosition ) { m_Position = rPosition; MarkDirty(); }
 
 		inline const Simd::Quat& GetRotation() const { return m_Rotation; }
-		virtual void SetRotation( const Simd::Quat& rRotation ) { m_Rotation = rRotation; m_bDirty = true; }
+		virtual void SetRotation( const Simd::Quat& rRotation ) { m_Rotation = rRotation; MarkDirty(); }
 
 		inline float32_t GetScale() const { return m_Scale; }
-		virtual void SetScale( float32_t scale ) { m_Scale = scale; }
+		virtual void SetScale( float32_t scale ) { m_Scale = scale; MarkDirty(); }
 
 		bool IsDirty() const { return m_bDirty; }
+		void MarkDirty();
 		void ClearDirtyFlag() { m_bDirty = false; }
 
 		Simd::Vector3 m_Position;
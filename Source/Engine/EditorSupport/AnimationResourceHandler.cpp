@@ -6,6 +6,7 @@
 
 #include "Foundation/StringConverter.h"
 #include "Graphics/Animation.h"
+#include "GraphicsTypes/AnimationClipData.h"
 #include "PcSupport/AssetPreprocessor.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "EditorSupport/FbxSupport.h"
@@ -19,6 +20,166 @@ HELIUM_IMPLEMENT_ASSET( Helium::AnimationResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+/// Maximum rotation error allowed when dropping keys (one minus the absolute dot product of the interpolated and source
+/// rotations, roughly 0.5 degrees).
+static const float32_t ROTATION_KEY_TOLERANCE = 1.0e-5f;
+/// Maximum translation error allowed when dropping keys, in world units.
+static const float32_t TRANSLATION_KEY_TOLERANCE = 1.0e-3f;
+/// Maximum scale error allowed when dropping keys.
+static const float32_t SCALE_KEY_TOLERANCE = 1.0e-3f;
+
+/// Check whether a source key can be reconstructed within tolerance by interpolating between two other keys.
+///
+/// @param[in] rKey0   First key.
+/// @param[in] rKey1   Second key.
+/// @param[in] weight  Interpolation weight of the second key.
+/// @param[in] rKey    Source key to test.
+///
+/// @return  True if the interpolated key is within tolerance of the source key, false if not.
+static bool IsKeyReconstructible(
+    const FbxSupport::Key& rKey0,
+    const FbxSupport::Key& rKey1,
+    float32_t weight,
+    const FbxSupport::Key& rKey )
+{
+    // Interpolate the rotation the same way AnimationPose::InterpolateBlock() does at runtime.
+    float32_t dot = 0.0f;
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        dot += rKey0.rotation.GetElement( componentIndex ) * rKey1.rotation.GetElement( componentIndex );
+    }
+
+    float32_t rotationWeight1 = ( dot < 0.0f ? -weight : weight );
+    Simd::Quat rotation;
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        rotation.SetElement(
+            componentIndex,
+            rKey0.rotation.GetElement( componentIndex ) * ( 1.0f - weight ) +
+            rKey1.rotation.GetElement( componentIndex ) * rotationWeight1 );
+    }
+    rotation.Normalize();
+
+    float32_t rotationDot = 0.0f;
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        rotationDot += rotation.GetElement( componentIndex ) * rKey.rotation.GetElement( componentIndex );
+    }
+
+    if( 1.0f - Abs( rotationDot ) > ROTATION_KEY_TOLERANCE )
+    {
+        return false;
+    }
+
+    for( size_t componentIndex = 0; componentIndex < 3; ++componentIndex )
+    {
+        float32_t translation =
+            rKey0.translation.GetElement( componentIndex ) * ( 1.0f - weight ) +
+            rKey1.translation.GetElement( componentIndex ) * weight;
+        if( Abs( translation - rKey.translation.GetElement( componentIndex ) ) > TRANSLATION_KEY_TOLERANCE )
+        {
+            return false;
+        }
+
+        float32_t scale =
+            rKey0.scale.GetElement( componentIndex ) * ( 1.0f - weight ) +
+            rKey1.scale.GetElement( componentIndex ) * weight;
+        if( Abs( scale - rKey.scale.GetElement( componentIndex ) ) > SCALE_KEY_TOLERANCE )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Select the keys to keep from a uniformly sampled track.
+///
+/// Keys are greedily dropped for as long as every sample between the last kept key and the next candidate key can be
+/// reconstructed by linear interpolation within tolerance.  The first and last samples are always kept.
+///
+/// @param[in]  rKeys        Uniformly sampled track keys.
+/// @param[out] rKeySamples  Indices of the samples to keep.
+static void ReduceTrackKeys( const DynamicArray< FbxSupport::Key >& rKeys, DynamicArray< uint16_t >& rKeySamples )
+{
+    rKeySamples.Resize( 0 );
+
+    size_t sampleCount = rKeys.GetSize();
+    if( sampleCount == 0 )
+    {
+        return;
+    }
+
+    size_t startIndex = 0;
+    rKeySamples.Push( 0 );
+
+    while( startIndex + 1 < sampleCount )
+    {
+        // Extend the span for as long as all intermediate samples are reconstructible.
+        size_t endIndex = startIndex + 1;
+        while( endIndex + 1 < sampleCount )
+        {
+            size_t candidateIndex = endIndex + 1;
+            float32_t inverseSpan = 1.0f / static_cast< float32_t >( candidateIndex - startIndex );
+
+            bool bReconstructible = true;
+            for( size_t sampleIndex = startIndex + 1; sampleIndex < candidateIndex; ++sampleIndex )
+            {
+                float32_t weight = static_cast< float32_t >( sampleIndex - startIndex ) * inverseSpan;
+                if( !IsKeyReconstructible( rKeys[ startIndex ], rKeys[ candidateIndex ], weight, rKeys[ sampleIndex ] ) )
+                {
+                    bReconstructible = false;
+
+                    break;
+                }
+            }
+
+            if( !bReconstructible )
+            {
+                break;
+            }
+
+            endIndex = candidateIndex;
+        }
+
+        rKeySamples.Push( static_cast< uint16_t >( endIndex ) );
+        startIndex = endIndex;
+    }
+}
+
+/// Compute the quantization range of a track channel.
+///
+/// @param[in]  rKeys   Uniformly sampled track keys.
+/// @param[in]  bScale  True to compute the range of the scale channel, false to compute the range of the translation
+///                     channel.
+/// @param[out] pRange  Quantization range (minimum x, y, z followed by extent x, y, z).
+static void ComputeChannelRange( const DynamicArray< FbxSupport::Key >& rKeys, bool bScale, float32_t* pRange )
+{
+    HELIUM_ASSERT( pRange );
+    HELIUM_ASSERT( !rKeys.IsEmpty() );
+
+    for( size_t componentIndex = 0; componentIndex < 3; ++componentIndex )
+    {
+        const FbxSupport::Key& rFirstKey = rKeys[ 0 ];
+        float32_t minValue = ( bScale ? rFirstKey.scale : rFirstKey.translation ).GetElement( componentIndex );
+        float32_t maxValue = minValue;
+
+        size_t keyCount = rKeys.GetSize();
+        for( size_t keyIndex = 1; keyIndex < keyCount; ++keyIndex )
+        {
+            const FbxSupport::Key& rKey = rKeys[ keyIndex ];
+            float32_t value = ( bScale ? rKey.scale : rKey.translation ).GetElement( componentIndex );
+            minValue = Min( minValue, value );
+            maxValue = Max( maxValue, value );
+        }
+
+        pRange[ componentIndex ] = minValue;
+        pRange[ 3 + componentIndex ] = maxValue - minValue;
+    }
+}
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
+
 /// Constructor.
 AnimationResourceHandler::AnimationResourceHandler()
 : m_rFbxSupport( FbxSupport::StaticAcquire() )
@@ -68,14 +229,113 @@ bool AnimationResourceHandler::CacheResource(
 
     return bCacheResult;
 #else
-    HELIUM_UNREF( pAssetPreprocessor );
-    HELIUM_UNREF( rSourceFilePath );
+    DynamicArray< FbxSupport::AnimTrackData > tracks;
+    uint_fast32_t samplesPerSecond;
+    bool bLoadSuccess = m_rFbxSupport.LoadAnimation( rSourceFilePath, 1, tracks, samplesPerSecond );
+    if( !bLoadSuccess )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            "AnimationResourceHandler::CacheResource(): Failed to load animation from source file \"%s\".\n",
+            *rSourceFilePath );
+
+        return false;
+    }
+
+    size_t trackCount = tracks.GetSize();
+    size_t sampleCount = ( trackCount != 0 ? tracks[ 0 ].keys.GetSize() : 0 );
+    if( sampleCount > static_cast< size_t >( UINT16_MAX ) + 1 || trackCount >= UINT16_MAX )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            ( "AnimationResourceHandler::CacheResource(): Animation \"%s\" has too many samples (%" PRIuSZ ") or "
+              "tracks (%" PRIuSZ ").\n" ),
+            *rSourceFilePath,
+            sampleCount,
+            trackCount );
+
+        return false;
+    }
+
+    StrongPtr< Animation::PersistentResourceData > persistentResourceData( new Animation::PersistentResourceData() );
+    persistentResourceData->m_sampleRate = static_cast< float32_t >( samplesPerSecond );
+    persistentResourceData->m_sampleCount = static_cast< uint32_t >( sampleCount );
+    persistentResourceData->m_trackNames.Reserve( trackCount );
+    persistentResourceData->m_keyOffsets.Reserve( trackCount + 1 );
+    persistentResourceData->m_translationRanges.Resize( trackCount * AnimationClipData::RANGE_FLOAT_COUNT );
+    persistentResourceData->m_scaleRanges.Resize( trackCount * AnimationClipData::RANGE_FLOAT_COUNT );
 
+    // Drop keys that can be reconstructed by interpolation, then quantize the remaining keys.
+    DynamicArray< uint16_t > keySamples;
+    size_t sourceKeyCount = 0;
+    for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+    {
+        const FbxSupport::AnimTrackData& rTrack = tracks[ trackIndex ];
+        HELIUM_ASSERT( rTrack.keys.GetSize() == sampleCount );
+
+        persistentResourceData->m_trackNames.Push( rTrack.name );
+        persistentResourceData->m_keyOffsets.Push(
+            static_cast< uint32_t >( persistentResourceData->m_keySamples.GetSize() ) );
+
+        if( sampleCount == 0 )
+        {
+            continue;
+        }
+
+        sourceKeyCount += sampleCount;
+
+        float32_t* pTranslationRange =
+            persistentResourceData->m_translationRanges.GetData() + trackIndex * AnimationClipData::RANGE_FLOAT_COUNT;
+        float32_t* pScaleRange =
+            persistentResourceData->m_scaleRanges.GetData() + trackIndex * AnimationClipData::RANGE_FLOAT_COUNT;
+        ComputeChannelRange( rTrack.keys, false, pTranslationRange );
+        ComputeChannelRange( rTrack.keys, true, pScaleRange );
+
+        ReduceTrackKeys( rTrack.keys, keySamples );
+
+        size_t keyCount = keySamples.GetSize();
+        for( size_t keyIndex = 0; keyIndex < keyCount; ++keyIndex )
+        {
+            uint16_t sampleIndex = keySamples[ keyIndex ];
+            const FbxSupport::Key& rKey = rTrack.keys[ sampleIndex ];
+
+            persistentResourceData->m_keySamples.Push( sampleIndex );
+
+            uint16_t packed[ AnimationClipData::KEY_CHANNEL_WORD_COUNT ];
+            AnimationClipData::PackRotation( rKey.rotation.GetNormalized(), packed );
+            persistentResourceData->m_rotationKeys.AddArray( packed, AnimationClipData::KEY_CHANNEL_WORD_COUNT );
+
+            AnimationClipData::QuantizeVector( rKey.translation, pTranslationRange, packed );
+            persistentResourceData->m_translationKeys.AddArray( packed, AnimationClipData::KEY_CHANNEL_WORD_COUNT );
+
+            AnimationClipData::QuantizeVector( rKey.scale, pScaleRange, packed );
+            persistentResourceData->m_scaleKeys.AddArray( packed, AnimationClipData::KEY_CHANNEL_WORD_COUNT );
+        }
+    }
+
+    persistentResourceData->m_keyOffsets.Push(
+        static_cast< uint32_t >( persistentResourceData->m_keySamples.GetSize() ) );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        "AnimationResourceHandler::CacheResource(): Reduced \"%s\" from %" PRIuSZ " to %" PRIuSZ " keys.\n",
+        *rSourceFilePath,
+        sourceKeyCount,
+        persistentResourceData->m_keySamples.GetSize() );
+
+    // Cache the data for each supported platform.
     for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
     {
+        PlatformPreprocessor* pPreprocessor = pAssetPreprocessor->GetPlatformPreprocessor(
+            static_cast< Cache::EPlatform >( platformIndex ) );
+        if( !pPreprocessor )
+        {
+            continue;
+        }
+
         Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
             static_cast< Cache::EPlatform >( platformIndex ) );
-        rPreprocessedData.persistentDataBuffer.Clear();
+        Cache::WriteCacheObjectToBuffer( persistentResourceData.Get(), rPreprocessedData.persistentDataBuffer );
         rPreprocessedData.subDataBuffers.Clear();
         rPreprocessedData.bLoaded = true;
     }
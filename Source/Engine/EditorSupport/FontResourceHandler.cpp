@@ -22,6 +22,33 @@ using namespace Helium;
 /// Maximum Unicode code point value.
 static const uint_fast32_t UNICODE_CODE_POINT_MAX = 0x10ffff;
 
+/// Maximum width and height of an individual character image, in pixels.
+static const uint16_t GLYPH_IMAGE_SIZE_MAX = 2048;
+
+/// Get the texture sheet size to use along one axis for a font.
+///
+/// @param[in] requestedSize  Texture sheet size requested by the font.
+/// @param[in] requiredSize   Minimum size needed to fit the largest character, including padding.
+///
+/// @return  Requested size, or the smallest power of two fitting the largest character if the requested size is too
+///          small.
+static uint16_t GetTextureSheetSize( uint16_t requestedSize, uint_fast32_t requiredSize )
+{
+    uint_fast32_t size = Max< uint_fast32_t >( requestedSize, 1 );
+    if( size < requiredSize )
+    {
+        size = 1;
+        while( size < requiredSize )
+        {
+            size <<= 1;
+        }
+    }
+
+    HELIUM_ASSERT( size <= UINT16_MAX );
+
+    return static_cast< uint16_t >( size );
+}
+
 /// Allocate a block of memory for FreeType.
 ///
 /// @param[in] pMemory  Handle to the source memory manager.
@@ -271,73 +298,13 @@ bool FontResourceHandler::CacheResource(
     int32_t height = pSize->metrics.height;
     int32_t maxAdvance = pSize->metrics.max_advance;
 
-    // Make sure that all characters in the font will fit on a single texture sheet (note that we also need at least a
-    // pixel on each side in order to pad each glyph).
-    uint16_t textureSheetWidth = Max< uint16_t >( pFont->GetTextureSheetWidth(), 1 );
-    uint16_t textureSheetHeight = Max< uint16_t >( pFont->GetTextureSheetHeight(), 1 );
-
-    int32_t integerHeight = ( height + ( 1 << 6 ) - 1 ) >> 6;
-    if( integerHeight + 2 > textureSheetHeight )
-    {
-        HELIUM_TRACE(
-            TraceLevels::Error,
-            "FontResourceHandler: Font height (%" PRId32 ") exceeds the texture sheet height (%" PRIu16 ") for font resource \"%s\".\n",
-            integerHeight,
-            textureSheetHeight,
-            *pResource->GetPath().ToString() );
-
-        FT_Done_Face( pFace );
-        delete [] pFileData;
-
-        return false;
-    }
-
-    int32_t integerMaxAdvance = ( maxAdvance + ( 1 << 6 ) - 1 ) >> 6;
-    if( integerMaxAdvance + 2 > textureSheetWidth )
-    {
-        HELIUM_TRACE(
-            TraceLevels::Error,
-            "FontResourceHandler: Maximum character advance (%" PRId32 ") exceeds the texture sheet width (%" PRIu16 ") for font resource \"%s\".\n",
-            integerMaxAdvance,
-            textureSheetWidth,
-            *pResource->GetPath().ToString() );
-
-        FT_Done_Face( pFace );
-        delete [] pFileData;
-
-        return false;
-    }
-
-    // Allocate a buffer for building our texture sheets.
-    uint_fast32_t texturePixelCount =
-        static_cast< uint_fast32_t >( textureSheetWidth ) * static_cast< uint_fast32_t >( textureSheetHeight );
-    uint8_t* pTextureBuffer = new uint8_t [ texturePixelCount ];
-    HELIUM_ASSERT( pTextureBuffer );
-    if( !pTextureBuffer )
-    {
-        HELIUM_TRACE(
-            TraceLevels::Error,
-            "FontResourceHandler: Failed to allocate %" PRIuFAST32 " bytes for texture resource buffer data while caching font resource \"%s\".\n",
-            texturePixelCount,
-            *pResource->GetPath().ToString() );
-
-        FT_Done_Face( pFace );
-        delete [] pFileData;
-
-        return false;
-    }
-
-    MemoryZero( pTextureBuffer, texturePixelCount );
-
-    // Build the texture sheets for our glyphs.
+    // Render each character in the font to an individual 8-bit grayscale image.
     Font::ECompression textureCompression = pFont->GetTextureCompression();
     bool bAntialiased = pFont->GetAntialiased();
 
-    DynamicArray< DynamicArray< uint8_t > > textureSheets;
-
-    uint16_t penX = 1;
-    uint16_t penY = 1;
-    uint16_t lineHeight = 0;
+    DynamicArray< uint8_t > glyphImages;
+    uint16_t glyphImageWidthMax = 0;
+    uint16_t glyphImageHeightMax = 0;
 
     FT_Int32 glyphLoadFlags = FT_LOAD_RENDER;
     if( !bAntialiased )
@@ -360,54 +327,58 @@ bool FontResourceHandler::CacheResource(
         FT_GlyphSlot pGlyph = pFace->glyph;
         HELIUM_ASSERT( pGlyph );
 
-        // Proceed to the next line in the texture sheet or the next sheet itself if we don't have enough room in the
-        // current line/sheet.
         HELIUM_ASSERT( pGlyph->bitmap.rows >= 0 );
         HELIUM_ASSERT( pGlyph->bitmap.width >= 0 );
         uint_fast32_t glyphRowCount = static_cast< uint32_t >( pGlyph->bitmap.rows );
         uint_fast32_t glyphWidth = static_cast< uint32_t >( pGlyph->bitmap.width );
 
-        if( penX + glyphWidth + 1 >= textureSheetWidth )
+        if( glyphRowCount > GLYPH_IMAGE_SIZE_MAX || glyphWidth > GLYPH_IMAGE_SIZE_MAX )
         {
-            penX = 1;
+            HELIUM_TRACE(
+                TraceLevels::Warning,
+                "FontResourceHandler: Image for character %" PRIxFAST32 " (%" PRIuFAST32 "x%" PRIuFAST32 ") exceeds the maximum character image size (%" PRIu16 ") for font resource \"%s\" and will not be drawn.\n",
+                codePoint,
+                glyphWidth,
+                glyphRowCount,
+                GLYPH_IMAGE_SIZE_MAX,
+                *pResource->GetPath().ToString() );
+
+            glyphRowCount = 0;
+            glyphWidth = 0;
+        }
 
-            if( penY + glyphRowCount + 1 >= textureSheetHeight )
-            {
-                CompressTexture(
-                    pTextureBuffer,
-                    textureSheetWidth,
-                    textureSheetHeight,
-                    textureCompression,
-                    textureSheets );
-                MemoryZero( pTextureBuffer, texturePixelCount );
-
-                penY = 1;
-            }
-            else
-            {
-                penY += lineHeight + 1;
-            }
+        size_t imageOffset = glyphImages.GetSize();
+        if( imageOffset + glyphWidth * glyphRowCount > UINT32_MAX )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                "FontResourceHandler: Character image data exceeds the maximum supported size for font resource \"%s\".\n",
+                *pResource->GetPath().ToString() );
 
-            lineHeight = 0;
+            FT_Done_Face( pFace );
+            delete [] pFileData;
+
+            return false;
         }
 
-        // Copy the character data from the glyph bitmap to the texture sheet.
+        glyphImages.Resize( imageOffset + glyphWidth * glyphRowCount );
+
+        // Copy the character data from the glyph bitmap to the character image.
         int_fast32_t glyphPitch = pGlyph->bitmap.pitch;
 
         const uint8_t* pGlyphBuffer = pGlyph->bitmap.buffer;
         HELIUM_ASSERT( pGlyphBuffer || glyphRowCount == 0 );
 
-        uint8_t* pTexturePixel =
-            pTextureBuffer + static_cast< size_t >( penY ) * static_cast< size_t >( textureSheetWidth ) + penX;
+        uint8_t* pImagePixel = glyphImages.GetData() + imageOffset;
 
         if( bAntialiased )
         {
             // Anti-aliased fonts are rendered as 8-bit grayscale images, so just copy the data as-is.
             for( uint_fast32_t rowIndex = 0; rowIndex < glyphRowCount; ++rowIndex )
             {
-                MemoryCopy( pTexturePixel, pGlyphBuffer, glyphWidth );
+                MemoryCopy( pImagePixel, pGlyphBuffer, glyphWidth );
                 pGlyphBuffer += glyphPitch;
-                pTexturePixel += textureSheetWidth;
+                pImagePixel += glyphWidth;
             }
         }
         else
@@ -419,8 +390,8 @@ bool FontResourceHandler::CacheResource(
                 const uint8_t* pGlyphPixelBlock = pGlyphBuffer;
                 pGlyphBuffer += glyphPitch;
 
-                uint8_t* pCurrentTexturePixel = pTexturePixel;
-                pTexturePixel += textureSheetWidth;
+                uint8_t* pCurrentImagePixel = pImagePixel;
+                pImagePixel += glyphWidth;
 
                 uint_fast32_t remainingPixelCount = glyphWidth;
                 while( remainingPixelCount >= 8 )
@@ -430,21 +401,21 @@ bool FontResourceHandler::CacheResource(
                     uint8_t pixelBlock = *pGlyphPixelBlock;
                     ++pGlyphPixelBlock;
 
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 7 ) ) ? 255 : 0 );
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 6 ) ) ? 255 : 0 );
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 5 ) ) ? 255 : 0 );
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 4 ) ) ? 255 : 0 );
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 3 ) ) ? 255 : 0 );
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 2 ) ) ? 255 : 0 );
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 1 ) ) ? 255 : 0 );
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & ( 1 << 0 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 7 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 6 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 5 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 4 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 3 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 2 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 1 ) ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & ( 1 << 0 ) ) ? 255 : 0 );
                 }
 
                 uint8_t pixelBlock = *pGlyphPixelBlock;
                 uint8_t mask = ( 1 << 7 );
                 while( remainingPixelCount != 0 )
                 {
-                    *( pCurrentTexturePixel++ ) = ( ( pixelBlock & mask ) ? 255 : 0 );
+                    *( pCurrentImagePixel++ ) = ( ( pixelBlock & mask ) ? 255 : 0 );
                     mask >>= 1;
                     --remainingPixelCount;
                 }
@@ -457,8 +428,8 @@ bool FontResourceHandler::CacheResource(
     
         pCharacter->codePoint = static_cast< uint32_t >( codePoint );
          
-        pCharacter->imageX = penX;
-        pCharacter->imageY = penY;
+        pCharacter->imageX = 0;
+        pCharacter->imageY = 0;
         pCharacter->imageWidth = static_cast< uint16_t >( glyphWidth );
         pCharacter->imageHeight = static_cast< uint16_t >( glyphRowCount );
     
@@ -467,43 +438,96 @@ bool FontResourceHandler::CacheResource(
         pCharacter->bearingX = pGlyph->metrics.horiBearingX;
         pCharacter->bearingY = pGlyph->metrics.horiBearingY;
         pCharacter->advance = pGlyph->metrics.horiAdvance;
-    
-        HELIUM_ASSERT( textureSheets.GetSize() < UINT8_MAX );
-        pCharacter->texture = static_cast< uint8_t >( static_cast< uint8_t >( textureSheets.GetSize() ) );
-    
-        // Update the pen location as well as the maximum line height as appropriate based on the current line height.
-        penX += static_cast< uint16_t >( glyphWidth ) + 1;
-    
-        HELIUM_ASSERT( glyphRowCount <= UINT16_MAX );
-        lineHeight = Max< uint16_t >( lineHeight, static_cast< uint16_t >( glyphRowCount ) );
-    }
 
-    // Compress and store the last texture in the sheet.
-    if( !resource_data->m_characters.IsEmpty() )
-    {
-        CompressTexture( pTextureBuffer, textureSheetWidth, textureSheetHeight, textureCompression, textureSheets );
+        pCharacter->imageOffset = static_cast< uint32_t >( imageOffset );
+        pCharacter->texture = 0;
+
+        glyphImageWidthMax = Max( glyphImageWidthMax, pCharacter->imageWidth );
+        glyphImageHeightMax = Max( glyphImageHeightMax, pCharacter->imageHeight );
     }
 
     // Done processing the font itself, so free some resources.
-    delete [] pTextureBuffer;
-
     FT_Done_Face( pFace );
     delete [] pFileData;
 
+    // Pack the character images into texture sheets unless the font should be rendered through the glyph cache.  The
+    // texture sheets are enlarged if necessary to fit the largest character (note that we also need at least a pixel
+    // on each side in order to pad each glyph), and fonts with too many characters to fit in the maximum number of
+    // texture sheets fall back to using the glyph cache.
+    DynamicArray< DynamicArray< uint8_t > > subDataBuffers;
+    bool bDynamicGlyphs = pFont->GetDynamicGlyphs();
+
+    uint16_t textureSheetWidth = GetTextureSheetSize( pFont->GetTextureSheetWidth(), glyphImageWidthMax + 2 );
+    uint16_t textureSheetHeight = GetTextureSheetSize( pFont->GetTextureSheetHeight(), glyphImageHeightMax + 2 );
+
+    if( !bDynamicGlyphs )
+    {
+        if( textureSheetWidth != pFont->GetTextureSheetWidth() || textureSheetHeight != pFont->GetTextureSheetHeight() )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Warning,
+                "FontResourceHandler: Texture sheets for font resource \"%s\" enlarged to %" PRIu16 "x%" PRIu16 " to fit the largest character.\n",
+                *pResource->GetPath().ToString(),
+                textureSheetWidth,
+                textureSheetHeight );
+        }
+
+        if( !BuildTextureSheets(
+            glyphImages,
+            resource_data->m_characters,
+            textureSheetWidth,
+            textureSheetHeight,
+            textureCompression,
+            subDataBuffers ) )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Warning,
+                "FontResourceHandler: Characters in font resource \"%s\" exceed the maximum number of texture sheets, so the font will be rendered using the glyph cache.\n",
+                *pResource->GetPath().ToString() );
+
+            bDynamicGlyphs = true;
+        }
+    }
+
+    uint8_t textureCount = 0;
+    if( bDynamicGlyphs )
+    {
+        // Store the character images themselves for uploading to the glyph cache at runtime.
+        subDataBuffers.Resize( 1 );
+        subDataBuffers[ 0 ] = glyphImages;
+
+        size_t characterCount = resource_data->m_characters.GetSize();
+        for( size_t characterIndex = 0; characterIndex < characterCount; ++characterIndex )
+        {
+            Font::Character& rCharacter = resource_data->m_characters[ characterIndex ];
+            rCharacter.imageX = 0;
+            rCharacter.imageY = 0;
+            rCharacter.texture = 0;
+        }
+
+        textureSheetWidth = 0;
+        textureSheetHeight = 0;
+    }
+    else
+    {
+        size_t textureCountActual = subDataBuffers.GetSize();
+        HELIUM_ASSERT( textureCountActual < UINT8_MAX );
+        textureCount = static_cast< uint8_t >( textureCountActual );
+    }
+
     // Cache the font data.
     size_t characterCountActual = resource_data->m_characters.GetSize();
     HELIUM_ASSERT( characterCountActual <= UINT32_MAX );
-    uint32_t characterCount = static_cast< uint32_t >( characterCountActual );
-
-    size_t textureCountActual = textureSheets.GetSize();
-    HELIUM_ASSERT( textureCountActual < UINT8_MAX );
-    uint8_t textureCount = static_cast< uint8_t >( textureCountActual );
+    HELIUM_UNREF( characterCountActual );
 
     resource_data->m_ascender = ascender;
     resource_data->m_descender = descender;
     resource_data->m_height = height;
     resource_data->m_maxAdvance = maxAdvance;
     resource_data->m_textureCount = textureCount;
+    resource_data->m_textureWidth = textureSheetWidth;
+    resource_data->m_textureHeight = textureSheetHeight;
+    resource_data->m_bDynamicGlyphs = bDynamicGlyphs;
     // m_characters is populated above
 
     for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
@@ -520,7 +544,7 @@ bool FontResourceHandler::CacheResource(
             static_cast< Cache::EPlatform >( platformIndex ) );
         //rPreprocessedData.persistentDataBuffer = ;
         SaveObjectToPersistentDataBuffer(resource_data.Get(), rPreprocessedData.persistentDataBuffer);
-        rPreprocessedData.subDataBuffers = textureSheets;
+        rPreprocessedData.subDataBuffers = subDataBuffers;
         rPreprocessedData.bLoaded = true;
 
     }
@@ -571,6 +595,109 @@ FT_Library FontResourceHandler::GetStaticLibrary()
     return sm_pLibrary;
 }
 
+/// Pack character images into texture sheets.
+///
+/// @param[in]  rGlyphImages    Character image data (indexed using Character::imageOffset).
+/// @param[in]  rCharacters     Characters to pack.  The texture sheet index and image location of each character are
+///                             updated with the location of the character in the texture sheets.
+/// @param[in]  textureWidth    Width of each texture sheet (must be large enough to fit the widest character image
+///                             with a pixel of padding on each side).
+/// @param[in]  textureHeight   Height of each texture sheet (must be large enough to fit the tallest character image
+///                             with a pixel of padding on each side).
+/// @param[in]  compression     Font texture sheet compression method to use.
+/// @param[out] rTextureSheets  Array of texture sheets to which the texture data should be appended.
+///
+/// @return  True if all characters were packed, false if the characters exceed the maximum number of texture sheets.
+bool FontResourceHandler::BuildTextureSheets(
+    const DynamicArray< uint8_t >& rGlyphImages,
+    DynamicArray< Font::Character >& rCharacters,
+    uint16_t textureWidth,
+    uint16_t textureHeight,
+    Font::ECompression compression,
+    DynamicArray< DynamicArray< uint8_t > >& rTextureSheets )
+{
+    rTextureSheets.Resize( 0 );
+
+    size_t characterCount = rCharacters.GetSize();
+    if( characterCount == 0 )
+    {
+        return true;
+    }
+
+    // Allocate a buffer for building our texture sheets.
+    size_t texturePixelCount = static_cast< size_t >( textureWidth ) * static_cast< size_t >( textureHeight );
+    uint8_t* pTextureBuffer = new uint8_t [ texturePixelCount ];
+    HELIUM_ASSERT( pTextureBuffer );
+    MemoryZero( pTextureBuffer, texturePixelCount );
+
+    uint_fast32_t penX = 1;
+    uint_fast32_t penY = 1;
+    uint_fast32_t lineHeight = 0;
+
+    for( size_t characterIndex = 0; characterIndex < characterCount; ++characterIndex )
+    {
+        Font::Character& rCharacter = rCharacters[ characterIndex ];
+
+        uint_fast32_t glyphWidth = rCharacter.imageWidth;
+        uint_fast32_t glyphRowCount = rCharacter.imageHeight;
+        HELIUM_ASSERT( glyphWidth + 2 <= textureWidth );
+        HELIUM_ASSERT( glyphRowCount + 2 <= textureHeight );
+
+        // Proceed to the next line in the texture sheet or the next sheet itself if we don't have enough room in the
+        // current line/sheet.
+        if( penX + glyphWidth + 1 > textureWidth )
+        {
+            penX = 1;
+            penY += lineHeight + 1;
+            lineHeight = 0;
+        }
+
+        if( penY + glyphRowCount + 1 > textureHeight )
+        {
+            // Sheet indices need to fit in a byte, with the last index reserved.
+            if( rTextureSheets.GetSize() + 1 >= UINT8_MAX )
+            {
+                delete [] pTextureBuffer;
+                rTextureSheets.Resize( 0 );
+
+                return false;
+            }
+
+            CompressTexture( pTextureBuffer, textureWidth, textureHeight, compression, rTextureSheets );
+            MemoryZero( pTextureBuffer, texturePixelCount );
+
+            penX = 1;
+            penY = 1;
+            lineHeight = 0;
+        }
+
+        // Copy the character image to the texture sheet.
+        const uint8_t* pGlyphPixel = rGlyphImages.GetData() + rCharacter.imageOffset;
+        uint8_t* pTexturePixel = pTextureBuffer + penY * static_cast< size_t >( textureWidth ) + penX;
+        for( uint_fast32_t rowIndex = 0; rowIndex < glyphRowCount; ++rowIndex )
+        {
+            MemoryCopy( pTexturePixel, pGlyphPixel, glyphWidth );
+            pGlyphPixel += glyphWidth;
+            pTexturePixel += textureWidth;
+        }
+
+        rCharacter.imageX = static_cast< uint16_t >( penX );
+        rCharacter.imageY = static_cast< uint16_t >( penY );
+        rCharacter.texture = static_cast< uint8_t >( rTextureSheets.GetSize() );
+
+        // Update the pen location as well as the maximum line height as appropriate based on the current line height.
+        penX += glyphWidth + 1;
+        lineHeight = Max( lineHeight, glyphRowCount );
+    }
+
+    // Compress and store the last texture in the sheet.
+    CompressTexture( pTextureBuffer, textureWidth, textureHeight, compression, rTextureSheets );
+
+    delete [] pTextureBuffer;
+
+    return true;
+}
+
 /// Compress a font texture sheet and add the texture data to the given texture sheet array.
 ///
 /// @param[in] pGrayscaleData  Texture sheet data, stored as a contiguous array of 8-bit grayscale values.
@@ -46,8 +46,12 @@ namespace Helium
         static FT_Library sm_pLibrary;
 		static int32_t sm_InitCount;
 
-        /// @name Texture Sheet Compression
+        /// @name Texture Sheet Building
         //@{
+        static bool BuildTextureSheets(
+            const DynamicArray< uint8_t >& rGlyphImages, DynamicArray< Font::Character >& rCharacters,
+            uint16_t textureWidth, uint16_t textureHeight, Font::ECompression compression,
+            DynamicArray< DynamicArray< uint8_t > >& rTextureSheets );
         static void CompressTexture(
             const uint8_t* pGrayscaleData, uint16_t textureWidth, uint16_t textureHeight,
             Font::ECompression compression, DynamicArray< DynamicArray< uint8_t > >& rTextureSheets );
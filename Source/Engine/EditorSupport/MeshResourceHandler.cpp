@@ -12,10 +12,524 @@
 #include "PcSupport/PlatformPreprocessor.h"
 #include "EditorSupport/FbxSupport.h"
 
+#include <algorithm>
+
 HELIUM_IMPLEMENT_ASSET( Helium::MeshResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
 
+/// Size of the simulated post-transform vertex cache used when optimizing triangle order.
+static const size_t VERTEX_CACHE_SIZE = 32;
+/// Score given to vertices used by the most recently added triangle.
+static const float32_t VERTEX_CACHE_LAST_TRIANGLE_SCORE = 0.75f;
+/// Exponent controlling how quickly vertex scores decay with their position in the cache.
+static const float32_t VERTEX_CACHE_DECAY_POWER = 1.5f;
+/// Scale of the score bonus given to vertices with few remaining triangles.
+static const float32_t VERTEX_VALENCE_BOOST_SCALE = 2.0f;
+/// Exponent controlling the score bonus given to vertices with few remaining triangles.
+static const float32_t VERTEX_VALENCE_BOOST_POWER = 0.5f;
+
+/// Maximum number of triangles in a simplified occluder mesh.
+static const size_t OCCLUDER_TRIANGLE_COUNT_MAX = 256;
+/// Number of grid cells along each axis of the bounding box used when welding occluder vertices.
+static const uint32_t OCCLUDER_GRID_RESOLUTION_MAX = 1024;
+
+/// Compute the score of a vertex for vertex cache optimization.
+///
+/// @param[in] cachePosition           Position of the vertex in the simulated cache, or an invalid index if the
+///                                    vertex is not in the cache.
+/// @param[in] remainingTriangleCount  Number of triangles using the vertex that have not yet been added.
+///
+/// @return  Vertex score.
+static float32_t GetVertexCacheScore( size_t cachePosition, size_t remainingTriangleCount )
+{
+	if( remainingTriangleCount == 0 )
+	{
+		return -1.0f;
+	}
+
+	float32_t score = 0.0f;
+	if( cachePosition < 3 )
+	{
+		score = VERTEX_CACHE_LAST_TRIANGLE_SCORE;
+	}
+	else if( cachePosition < VERTEX_CACHE_SIZE )
+	{
+		float32_t scaledPosition =
+			static_cast< float32_t >( cachePosition - 3 ) / static_cast< float32_t >( VERTEX_CACHE_SIZE - 3 );
+		score = powf( 1.0f - scaledPosition, VERTEX_CACHE_DECAY_POWER );
+	}
+
+	score += VERTEX_VALENCE_BOOST_SCALE *
+		powf( static_cast< float32_t >( remainingTriangleCount ), -VERTEX_VALENCE_BOOST_POWER );
+
+	return score;
+}
+
+/// Reorder the triangles of a mesh section to improve post-transform vertex cache efficiency.
+///
+/// Triangles are reordered using Tom Forsyth's linear-speed vertex cache optimization algorithm, which greedily adds
+/// the triangle with the highest score based on the position of its vertices in a simulated LRU cache and the number
+/// of triangles remaining for each vertex.  The algorithm does not depend on the exact size of the hardware cache.
+///
+/// @param[in,out] pIndices       Section vertex indices (relative to the first vertex in the section).
+/// @param[in]     triangleCount  Number of triangles in the section.
+/// @param[in]     vertexCount    Number of vertices in the section.
+static void OptimizeVertexCache( uint16_t* pIndices, size_t triangleCount, size_t vertexCount )
+{
+	HELIUM_ASSERT( pIndices || triangleCount == 0 );
+
+	if( triangleCount < 2 )
+	{
+		return;
+	}
+
+	size_t indexCount = triangleCount * 3;
+
+	// Build the list of triangles using each vertex.
+	DynamicArray< size_t > vertexTriangleOffsets;
+	vertexTriangleOffsets.Resize( vertexCount + 1 );
+	MemoryZero( vertexTriangleOffsets.GetData(), vertexTriangleOffsets.GetSize() * sizeof( size_t ) );
+
+	for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+	{
+		HELIUM_ASSERT( pIndices[ indexIndex ] < vertexCount );
+		++vertexTriangleOffsets[ pIndices[ indexIndex ] + 1 ];
+	}
+
+	DynamicArray< size_t > remainingTriangleCounts;
+	remainingTriangleCounts.Resize( vertexCount );
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		remainingTriangleCounts[ vertexIndex ] = vertexTriangleOffsets[ vertexIndex + 1 ];
+		vertexTriangleOffsets[ vertexIndex + 1 ] += vertexTriangleOffsets[ vertexIndex ];
+	}
+
+	DynamicArray< size_t > vertexTriangles;
+	vertexTriangles.Resize( indexCount );
+
+	DynamicArray< size_t > vertexTriangleFill;
+	vertexTriangleFill.Resize( vertexCount );
+	MemoryCopy( vertexTriangleFill.GetData(), vertexTriangleOffsets.GetData(), vertexCount * sizeof( size_t ) );
+
+	for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+	{
+		vertexTriangles[ vertexTriangleFill[ pIndices[ indexIndex ] ]++ ] = indexIndex / 3;
+	}
+
+	// Compute the initial vertex and triangle scores.
+	DynamicArray< size_t > cachePositions;
+	DynamicArray< float32_t > vertexScores;
+	cachePositions.Resize( vertexCount );
+	vertexScores.Resize( vertexCount );
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		SetInvalid( cachePositions[ vertexIndex ] );
+		vertexScores[ vertexIndex ] = GetVertexCacheScore(
+			cachePositions[ vertexIndex ],
+			remainingTriangleCounts[ vertexIndex ] );
+	}
+
+	DynamicArray< float32_t > triangleScores;
+	DynamicArray< bool > triangleAdded;
+	triangleScores.Resize( triangleCount );
+	triangleAdded.Resize( triangleCount );
+
+	size_t bestTriangle = 0;
+	for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+	{
+		const uint16_t* pTriangle = pIndices + triangleIndex * 3;
+		triangleScores[ triangleIndex ] =
+			vertexScores[ pTriangle[ 0 ] ] + vertexScores[ pTriangle[ 1 ] ] + vertexScores[ pTriangle[ 2 ] ];
+		triangleAdded[ triangleIndex ] = false;
+
+		if( triangleScores[ triangleIndex ] > triangleScores[ bestTriangle ] )
+		{
+			bestTriangle = triangleIndex;
+		}
+	}
+
+	// Add triangles in order of their scores, updating the simulated cache as we go.
+	DynamicArray< uint16_t > sortedIndices;
+	sortedIndices.Reserve( indexCount );
+
+	size_t cache[ VERTEX_CACHE_SIZE + 3 ];
+	size_t cacheCount = 0;
+
+	size_t newCache[ VERTEX_CACHE_SIZE + 3 ];
+
+	for( size_t addedCount = 0; addedCount < triangleCount; ++addedCount )
+	{
+		if( IsInvalid( bestTriangle ) )
+		{
+			// No triangles using vertices in the cache remain, so fall back to searching all remaining triangles.
+			float32_t bestScore = -1.0f;
+			for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+			{
+				if( !triangleAdded[ triangleIndex ] && triangleScores[ triangleIndex ] > bestScore )
+				{
+					bestTriangle = triangleIndex;
+					bestScore = triangleScores[ triangleIndex ];
+				}
+			}
+
+			HELIUM_ASSERT( IsValid( bestTriangle ) );
+		}
+
+		const uint16_t* pTriangle = pIndices + bestTriangle * 3;
+		triangleAdded[ bestTriangle ] = true;
+
+		size_t newCacheCount = 0;
+		for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+		{
+			size_t vertexIndex = pTriangle[ cornerIndex ];
+			sortedIndices.Push( static_cast< uint16_t >( vertexIndex ) );
+
+			// Remove the triangle from the list of triangles remaining for the vertex.
+			size_t* pVertexTriangles = vertexTriangles.GetData() + vertexTriangleOffsets[ vertexIndex ];
+			size_t& rRemainingCount = remainingTriangleCounts[ vertexIndex ];
+			for( size_t triangleIndex = 0; triangleIndex < rRemainingCount; ++triangleIndex )
+			{
+				if( pVertexTriangles[ triangleIndex ] == bestTriangle )
+				{
+					pVertexTriangles[ triangleIndex ] = pVertexTriangles[ rRemainingCount - 1 ];
+					--rRemainingCount;
+
+					break;
+				}
+			}
+
+			newCache[ newCacheCount++ ] = vertexIndex;
+		}
+
+		// Move the triangle vertices to the front of the cache.
+		for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+		{
+			size_t vertexIndex = cache[ cacheIndex ];
+			if( vertexIndex != pTriangle[ 0 ] && vertexIndex != pTriangle[ 1 ] && vertexIndex != pTriangle[ 2 ] )
+			{
+				newCache[ newCacheCount++ ] = vertexIndex;
+			}
+		}
+
+		for( size_t cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+		{
+			size_t vertexIndex = newCache[ cacheIndex ];
+			cache[ cacheIndex ] = vertexIndex;
+
+			if( cacheIndex < VERTEX_CACHE_SIZE )
+			{
+				cachePositions[ vertexIndex ] = cacheIndex;
+			}
+			else
+			{
+				SetInvalid( cachePositions[ vertexIndex ] );
+			}
+
+			vertexScores[ vertexIndex ] = GetVertexCacheScore(
+				cachePositions[ vertexIndex ],
+				remainingTriangleCounts[ vertexIndex ] );
+		}
+
+		cacheCount = Min( newCacheCount, VERTEX_CACHE_SIZE );
+
+		// Update the scores of the remaining triangles using the affected vertices, and pick the next best triangle.
+		SetInvalid( bestTriangle );
+		float32_t bestScore = -1.0f;
+		for( size_t cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+		{
+			size_t vertexIndex = cache[ cacheIndex ];
+			const size_t* pVertexTriangles = vertexTriangles.GetData() + vertexTriangleOffsets[ vertexIndex ];
+			size_t remainingCount = remainingTriangleCounts[ vertexIndex ];
+			for( size_t triangleIndex = 0; triangleIndex < remainingCount; ++triangleIndex )
+			{
+				size_t adjacentTriangle = pVertexTriangles[ triangleIndex ];
+				const uint16_t* pAdjacentTriangle = pIndices + adjacentTriangle * 3;
+				float32_t score =
+					vertexScores[ pAdjacentTriangle[ 0 ] ] +
+					vertexScores[ pAdjacentTriangle[ 1 ] ] +
+					vertexScores[ pAdjacentTriangle[ 2 ] ];
+				triangleScores[ adjacentTriangle ] = score;
+
+				if( score > bestScore )
+				{
+					bestTriangle = adjacentTriangle;
+					bestScore = score;
+				}
+			}
+		}
+	}
+
+	HELIUM_ASSERT( sortedIndices.GetSize() == indexCount );
+	MemoryCopy( pIndices, sortedIndices.GetData(), indexCount * sizeof( uint16_t ) );
+}
+
+/// Compute a vertex order for a mesh section that matches the order in which vertices are first referenced.
+///
+/// Reordering vertices to match the order of use in the index buffer improves pre-transform (vertex fetch) cache
+/// efficiency.  Vertex indices are updated to reference the new vertex order.  Any vertices not referenced by the
+/// section indices are moved to the end of the section.
+///
+/// @param[in,out] pIndices       Section vertex indices (relative to the first vertex in the section).
+/// @param[in]     indexCount     Number of indices in the section.
+/// @param[in]     vertexCount    Number of vertices in the section.
+/// @param[out]    rVertexOrder   Index of the original vertex to store at each position in the new vertex order.
+static void OptimizeVertexFetch(
+	uint16_t* pIndices,
+	size_t indexCount,
+	size_t vertexCount,
+	DynamicArray< uint16_t >& rVertexOrder )
+{
+	HELIUM_ASSERT( pIndices || indexCount == 0 );
+
+	DynamicArray< uint16_t > vertexRemap;
+	vertexRemap.Resize( vertexCount );
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		SetInvalid( vertexRemap[ vertexIndex ] );
+	}
+
+	rVertexOrder.Resize( 0 );
+	rVertexOrder.Reserve( vertexCount );
+
+	for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+	{
+		uint16_t vertexIndex = pIndices[ indexIndex ];
+		HELIUM_ASSERT( vertexIndex < vertexCount );
+
+		uint16_t& rRemappedIndex = vertexRemap[ vertexIndex ];
+		if( IsInvalid( rRemappedIndex ) )
+		{
+			rRemappedIndex = static_cast< uint16_t >( rVertexOrder.GetSize() );
+			rVertexOrder.Push( vertexIndex );
+		}
+
+		pIndices[ indexIndex ] = rRemappedIndex;
+	}
+
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		if( IsInvalid( vertexRemap[ vertexIndex ] ) )
+		{
+			rVertexOrder.Push( static_cast< uint16_t >( vertexIndex ) );
+		}
+	}
+
+	HELIUM_ASSERT( rVertexOrder.GetSize() == vertexCount );
+}
+
+/// Reorder a range of per-vertex data.
+///
+/// @param[in,out] pData         Per-vertex data to reorder.
+/// @param[in]     rVertexOrder  Index of the original vertex to store at each position in the new vertex order.
+/// @param[in,out] rScratch      Scratch buffer to use for reordering.
+template< typename T >
+static void ApplyVertexOrder( T* pData, const DynamicArray< uint16_t >& rVertexOrder, DynamicArray< T >& rScratch )
+{
+	size_t vertexCount = rVertexOrder.GetSize();
+	rScratch.Resize( 0 );
+	rScratch.AddArray( pData, vertexCount );
+
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		pData[ vertexIndex ] = rScratch[ rVertexOrder[ vertexIndex ] ];
+	}
+}
+
+/// Simplify a mesh into an occluder mesh using vertex clustering.
+///
+/// Vertices are snapped to a uniform grid spanning the mesh bounds, with each grid cell collapsed to the average
+/// position of the vertices it contains.  Triangles that collapse to a line or point are dropped, as are duplicate
+/// triangles (regardless of winding).  The grid starts out fine enough to only weld coincident vertices and is made
+/// coarser until the result fits within OCCLUDER_TRIANGLE_COUNT_MAX triangles.
+///
+/// @param[in]  rVertices               Mesh vertices.
+/// @param[in]  rIndices                Mesh indices (relative to the first vertex in each section).
+/// @param[in]  rSectionVertexCounts    Number of vertices in each mesh section.
+/// @param[in]  rSectionTriangleCounts  Number of triangles in each mesh section.
+/// @param[in]  rBounds                 Mesh bounds.
+/// @param[out] rOccluderVertices       Occluder vertex positions (three floats per vertex).
+/// @param[out] rOccluderIndices        Occluder triangle list indices.
+///
+/// @return  True if an occluder mesh within the triangle budget was built, false if not.
+static bool BuildOccluderMesh(
+	const DynamicArray< StaticMeshVertex< 1 > >& rVertices,
+	const DynamicArray< uint16_t >& rIndices,
+	const DynamicArray< uint16_t >& rSectionVertexCounts,
+	const DynamicArray< uint32_t >& rSectionTriangleCounts,
+	const Simd::AaBox& rBounds,
+	DynamicArray< float32_t >& rOccluderVertices,
+	DynamicArray< uint16_t >& rOccluderIndices )
+{
+	rOccluderVertices.Resize( 0 );
+	rOccluderIndices.Resize( 0 );
+
+	// Convert the section-relative indices to mesh vertex indices.
+	DynamicArray< uint32_t > meshIndices;
+	meshIndices.Reserve( rIndices.GetSize() );
+
+	size_t sectionCount = rSectionTriangleCounts.GetSize();
+	size_t sectionVertexOffset = 0;
+	size_t sectionIndexOffset = 0;
+	for( size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex )
+	{
+		size_t sectionIndexCount = static_cast< size_t >( rSectionTriangleCounts[ sectionIndex ] ) * 3;
+		HELIUM_ASSERT( sectionIndexOffset + sectionIndexCount <= rIndices.GetSize() );
+		for( size_t indexIndex = 0; indexIndex < sectionIndexCount; ++indexIndex )
+		{
+			meshIndices.Push( static_cast< uint32_t >( sectionVertexOffset + rIndices[ sectionIndexOffset + indexIndex ] ) );
+		}
+
+		sectionVertexOffset += rSectionVertexCounts[ sectionIndex ];
+		sectionIndexOffset += sectionIndexCount;
+	}
+
+	size_t vertexCount = rVertices.GetSize();
+	size_t triangleCount = meshIndices.GetSize() / 3;
+	if( vertexCount == 0 || triangleCount == 0 )
+	{
+		return false;
+	}
+
+	const Simd::Vector3& rMinimum = rBounds.GetMinimum();
+	const Simd::Vector3& rMaximum = rBounds.GetMaximum();
+
+	DynamicArray< uint64_t > vertexCellKeys;
+	DynamicArray< uint16_t > vertexClusters;
+	DynamicArray< float32_t > clusterWeights;
+	DynamicArray< uint64_t > triangleKeys;
+	vertexCellKeys.Resize( vertexCount );
+	vertexClusters.Resize( vertexCount );
+
+	for( uint32_t resolution = OCCLUDER_GRID_RESOLUTION_MAX; resolution != 0; resolution /= 2 )
+	{
+		// Sort the vertices by grid cell, storing the vertex index in the low bits of each key.
+		float32_t cellScale[ 3 ];
+		for( size_t axis = 0; axis < 3; ++axis )
+		{
+			float32_t extent = rMaximum.GetElement( axis ) - rMinimum.GetElement( axis );
+			cellScale[ axis ] = ( extent > 0.0f ? static_cast< float32_t >( resolution ) / extent : 0.0f );
+		}
+
+		for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+		{
+			const float32_t* pPosition = rVertices[ vertexIndex ].position;
+
+			uint64_t cellKey = 0;
+			for( size_t axis = 0; axis < 3; ++axis )
+			{
+				float32_t cell = ( pPosition[ axis ] - rMinimum.GetElement( axis ) ) * cellScale[ axis ];
+				uint32_t cellIndex = static_cast< uint32_t >( Clamp( cell, 0.0f, static_cast< float32_t >( resolution - 1 ) ) );
+				cellKey = cellKey * resolution + cellIndex;
+			}
+
+			vertexCellKeys[ vertexIndex ] = ( cellKey << 32 ) | vertexIndex;
+		}
+
+		std::sort( vertexCellKeys.GetData(), vertexCellKeys.GetData() + vertexCount );
+
+		// Assign a cluster to each occupied cell, placing it at the average position of its vertices.
+		rOccluderVertices.Resize( 0 );
+		clusterWeights.Resize( 0 );
+
+		bool bTooManyClusters = false;
+		uint64_t previousCellKey = Invalid< uint64_t >();
+		for( size_t sortedIndex = 0; sortedIndex < vertexCount; ++sortedIndex )
+		{
+			uint64_t cellKey = vertexCellKeys[ sortedIndex ] >> 32;
+			size_t vertexIndex = static_cast< size_t >( vertexCellKeys[ sortedIndex ] & 0xffffffff );
+			if( cellKey != previousCellKey )
+			{
+				if( clusterWeights.GetSize() >= UINT16_MAX )
+				{
+					bTooManyClusters = true;
+					break;
+				}
+
+				previousCellKey = cellKey;
+				rOccluderVertices.Push( 0.0f );
+				rOccluderVertices.Push( 0.0f );
+				rOccluderVertices.Push( 0.0f );
+				clusterWeights.Push( 0.0f );
+			}
+
+			size_t clusterIndex = clusterWeights.GetSize() - 1;
+			vertexClusters[ vertexIndex ] = static_cast< uint16_t >( clusterIndex );
+
+			const float32_t* pPosition = rVertices[ vertexIndex ].position;
+			float32_t* pClusterPosition = rOccluderVertices.GetData() + clusterIndex * 3;
+			pClusterPosition[ 0 ] += pPosition[ 0 ];
+			pClusterPosition[ 1 ] += pPosition[ 1 ];
+			pClusterPosition[ 2 ] += pPosition[ 2 ];
+			clusterWeights[ clusterIndex ] += 1.0f;
+		}
+
+		if( bTooManyClusters )
+		{
+			continue;
+		}
+
+		size_t clusterCount = clusterWeights.GetSize();
+		for( size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex )
+		{
+			float32_t inverseWeight = 1.0f / clusterWeights[ clusterIndex ];
+			float32_t* pClusterPosition = rOccluderVertices.GetData() + clusterIndex * 3;
+			pClusterPosition[ 0 ] *= inverseWeight;
+			pClusterPosition[ 1 ] *= inverseWeight;
+			pClusterPosition[ 2 ] *= inverseWeight;
+		}
+
+		// Remap the triangles, dropping those that collapsed.  Occluders are rasterized regardless of winding, so
+		// each triangle is keyed by its sorted cluster indices to detect duplicates.
+		triangleKeys.Resize( 0 );
+		for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+		{
+			uint64_t cluster0 = vertexClusters[ meshIndices[ triangleIndex * 3 ] ];
+			uint64_t cluster1 = vertexClusters[ meshIndices[ triangleIndex * 3 + 1 ] ];
+			uint64_t cluster2 = vertexClusters[ meshIndices[ triangleIndex * 3 + 2 ] ];
+			if( cluster0 == cluster1 || cluster1 == cluster2 || cluster2 == cluster0 )
+			{
+				continue;
+			}
+
+			uint64_t clusterMin = Min( Min( cluster0, cluster1 ), cluster2 );
+			uint64_t clusterMax = Max( Max( cluster0, cluster1 ), cluster2 );
+			uint64_t clusterMid = cluster0 + cluster1 + cluster2 - clusterMin - clusterMax;
+			triangleKeys.Push( ( clusterMin << 32 ) | ( clusterMid << 16 ) | clusterMax );
+		}
+
+		std::sort( triangleKeys.GetData(), triangleKeys.GetData() + triangleKeys.GetSize() );
+		size_t uniqueTriangleCount = static_cast< size_t >(
+			std::unique( triangleKeys.GetData(), triangleKeys.GetData() + triangleKeys.GetSize() ) -
+			triangleKeys.GetData() );
+		if( uniqueTriangleCount > OCCLUDER_TRIANGLE_COUNT_MAX )
+		{
+			continue;
+		}
+
+		if( uniqueTriangleCount == 0 )
+		{
+			break;
+		}
+
+		rOccluderIndices.Reserve( uniqueTriangleCount * 3 );
+		for( size_t triangleIndex = 0; triangleIndex < uniqueTriangleCount; ++triangleIndex )
+		{
+			uint64_t triangleKey = triangleKeys[ triangleIndex ];
+			rOccluderIndices.Push( static_cast< uint16_t >( triangleKey >> 32 ) );
+			rOccluderIndices.Push( static_cast< uint16_t >( triangleKey >> 16 ) );
+			rOccluderIndices.Push( static_cast< uint16_t >( triangleKey ) );
+		}
+
+		return true;
+	}
+
+	rOccluderVertices.Resize( 0 );
+	rOccluderIndices.Resize( 0 );
+
+	return false;
+}
+
 /// Constructor.
 MeshResourceHandler::MeshResourceHandler()
 : m_rFbxSupport( FbxSupport::StaticAcquire() )
@@ -98,6 +612,40 @@ bool MeshResourceHandler::CacheResource(
 	HELIUM_ASSERT( boneCountActual <= UINT8_MAX );
 	persistentResourceData->m_boneCount = static_cast< uint8_t >( boneCountActual );
 
+	// Reorder the triangles in each mesh section for post-transform cache efficiency, then reorder the section
+	// vertices to match the order in which they are first referenced.
+	DynamicArray< uint16_t > vertexOrder;
+	DynamicArray< StaticMeshVertex< 1 > > vertexScratch;
+	DynamicArray< FbxSupport::BlendData > blendDataScratch;
+
+	size_t sectionCount = persistentResourceData->m_sectionTriangleCounts.GetSize();
+	HELIUM_ASSERT( persistentResourceData->m_sectionVertexCounts.GetSize() == sectionCount );
+
+	size_t sectionVertexOffset = 0;
+	size_t sectionIndexOffset = 0;
+	for( size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex )
+	{
+		size_t sectionVertexCount = persistentResourceData->m_sectionVertexCounts[ sectionIndex ];
+		size_t sectionTriangleCount = persistentResourceData->m_sectionTriangleCounts[ sectionIndex ];
+		size_t sectionIndexCount = sectionTriangleCount * 3;
+		HELIUM_ASSERT( sectionVertexOffset + sectionVertexCount <= vertexCountActual );
+		HELIUM_ASSERT( sectionIndexOffset + sectionIndexCount <= indexCount );
+
+		uint16_t* pSectionIndices = indices.GetData() + sectionIndexOffset;
+		OptimizeVertexCache( pSectionIndices, sectionTriangleCount, sectionVertexCount );
+		OptimizeVertexFetch( pSectionIndices, sectionIndexCount, sectionVertexCount, vertexOrder );
+
+		ApplyVertexOrder( vertices.GetData() + sectionVertexOffset, vertexOrder, vertexScratch );
+		if( boneCountActual != 0 )
+		{
+			HELIUM_ASSERT( vertexBlendData.GetSize() == vertexCountActual );
+			ApplyVertexOrder( vertexBlendData.GetData() + sectionVertexOffset, vertexOrder, blendDataScratch );
+		}
+
+		sectionVertexOffset += sectionVertexCount;
+		sectionIndexOffset += sectionIndexCount;
+	}
+
 	// Compute the mesh bounding box.
 	//Simd::AaBox bounds;
 	if( vertexCountActual != 0 )
@@ -112,6 +660,56 @@ bool MeshResourceHandler::CacheResource(
 		}
 	}
 	
+	// Quantized vertex formats are only supported for static meshes, as the position dequantization is applied as
+	// part of the mesh world transform.
+	Mesh* pMesh = Reflect::AssertCast< Mesh >( pResource );
+	bool bQuantizePositions = ( pMesh->GetQuantizeVertices() && boneCountActual == 0 );
+	persistentResourceData->m_bQuantizedPositions = bQuantizePositions;
+
+	Simd::Vector3 positionOffset( 0.0f, 0.0f, 0.0f );
+	float32_t positionScale = 1.0f;
+	if( bQuantizePositions )
+	{
+		Mesh::GetPositionQuantization( persistentResourceData->m_bounds, positionOffset, positionScale );
+	}
+
+	// Build a simplified occluder mesh for occlusion culling.  Skinned meshes deform at runtime, so they are never
+	// used as occluders.
+	if( pMesh->GetOccluder() )
+	{
+		if( boneCountActual != 0 )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"MeshResourceHandler::CacheResource(): Skinned mesh \"%s\" cannot be used as an occluder.\n",
+				*rSourceFilePath );
+		}
+		else if( BuildOccluderMesh(
+			vertices,
+			indices,
+			persistentResourceData->m_sectionVertexCounts,
+			persistentResourceData->m_sectionTriangleCounts,
+			persistentResourceData->m_bounds,
+			persistentResourceData->m_occluderVertices,
+			persistentResourceData->m_occluderIndices ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Info,
+				"MeshResourceHandler::CacheResource(): Built occluder for \"%s\" (%" PRIuSZ " triangles reduced to %" PRIuSZ ").\n",
+				*rSourceFilePath,
+				triangleCountActual,
+				persistentResourceData->m_occluderIndices.GetSize() / 3 );
+		}
+		else
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"MeshResourceHandler::CacheResource(): Failed to build an occluder within %" PRIuSZ " triangles for \"%s\".\n",
+				OCCLUDER_TRIANGLE_COUNT_MAX,
+				*rSourceFilePath );
+		}
+	}
+
 	persistentResourceData->m_pBoneNames.Resize(persistentResourceData->m_boneCount);
 	persistentResourceData->m_pParentBoneIndices.Resize(persistentResourceData->m_boneCount);
 	persistentResourceData->m_pReferencePose.Resize(persistentResourceData->m_boneCount);
@@ -145,7 +743,39 @@ bool MeshResourceHandler::CacheResource(
 
 		// Serialize the vertex buffer.  If the mesh is a skinned mesh, the vertices will need to be converted to
 		// and serialized as an array of SkinnedMeshVertex structs.
-		if( boneCountActual == 0 )
+		if( bQuantizePositions )
+		{
+			size_t vertexDataSizeInBytes = vertexCountActual * sizeof( QuantizedStaticMeshVertex< 1 > );
+			rSubDataBuffers[0].Resize( vertexDataSizeInBytes );
+			QuantizedStaticMeshVertex< 1 >* pVertices =
+				reinterpret_cast< QuantizedStaticMeshVertex< 1 >* >( rSubDataBuffers[0].GetData() );
+
+			float32_t inversePositionScale = 1.0f / positionScale;
+			for( size_t vertexIndex = 0; vertexIndex < vertexCountActual; ++vertexIndex )
+			{
+				QuantizedStaticMeshVertex< 1 >& rVertex = pVertices[ vertexIndex ];
+				const StaticMeshVertex< 1 >& rStaticVertex = vertices[ vertexIndex ];
+
+				for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+				{
+					float32_t position = Clamp(
+						( rStaticVertex.position[ axisIndex ] - positionOffset.GetElement( axisIndex ) ) *
+						inversePositionScale,
+						-1.0f,
+						1.0f );
+					rVertex.position[ axisIndex ] = static_cast< int16_t >(
+						position * 32767.0f + ( position < 0.0f ? -0.5f : 0.5f ) );
+				}
+
+				rVertex.position[ 3 ] = 32767;
+
+				MemoryCopy( rVertex.normal, rStaticVertex.normal, sizeof( rVertex.normal ) );
+				MemoryCopy( rVertex.tangent, rStaticVertex.tangent, sizeof( rVertex.tangent ) );
+				MemoryCopy( rVertex.color, rStaticVertex.color, sizeof( rVertex.color ) );
+				MemoryCopy( rVertex.texCoords, rStaticVertex.texCoords, sizeof( rVertex.texCoords ) );
+			}
+		}
+		else if( boneCountActual == 0 )
 		{
 			HELIUM_ASSERT(vertexCountActual == vertices.GetSize());
 			size_t vertexDataSizeInBytes = vertexCountActual * sizeof(StaticMeshVertex< 1 >);
@@ -14,14 +14,572 @@
 #include "EditorSupport/MemoryTextureOutputHandler.h"
 #include "EditorSupport/PngImageLoader.h"
 #include "EditorSupport/TgaImageLoader.h"
+#include "EngineJobs/JobManager.h"
 #include "Rendering/RendererTypes.h"
 
+#include <math.h>
 #include <nvtt/nvtt.h>
 
 HELIUM_IMPLEMENT_ASSET( Helium::Texture2dResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
 
+/// Maximum number of texel rows filtered by each mip generation job.
+static const uint32_t MIP_FILTER_JOB_ROW_COUNT_MAX = 32;
+/// Maximum number of texel rows compressed by each compression job (must be a multiple of the 4x4 block height).
+static const uint32_t COMPRESSION_JOB_ROW_COUNT_MAX = 64;
+
+/// Gamma applied to sRGB textures when converting between color space and linear space for mip filtering.
+static const float32_t SRGB_GAMMA = 2.2f;
+
+namespace
+{
+    /// Floating-point, four-channel image used as the working format for mip generation.  Channels are stored in the
+    /// same order as the 32-bit BGRA source image.
+    struct FloatImage
+    {
+        /// Image width, in texels.
+        uint32_t width;
+        /// Image height, in texels.
+        uint32_t height;
+        /// Texel data (four values per texel).
+        DynamicArray< float32_t > texels;
+
+        /// Allocate space for an image of the given size.
+        void Allocate( uint32_t imageWidth, uint32_t imageHeight )
+        {
+            width = imageWidth;
+            height = imageHeight;
+
+            size_t valueCount = static_cast< size_t >( imageWidth ) * imageHeight * 4;
+            texels.Reserve( valueCount );
+            texels.Resize( valueCount );
+        }
+    };
+
+    /// Separable resampling weights for reducing an image along one axis.
+    struct FilterTable
+    {
+        /// Number of source taps per destination texel.
+        uint32_t tapCount;
+        /// Index of the first (unwrapped) source texel sampled for each destination texel.
+        DynamicArray< int32_t > firstSourceIndices;
+        /// Filter weights, @c tapCount for each destination texel.
+        DynamicArray< float32_t > weights;
+    };
+
+    /// Zeroth-order modified Bessel function of the first kind, used for computing Kaiser window weights.
+    static float32_t BesselI0( float32_t x )
+    {
+        float32_t sum = 1.0f;
+        float32_t term = 1.0f;
+        float32_t halfX = x * 0.5f;
+        for( uint32_t k = 1; k < 32; ++k )
+        {
+            float32_t factor = halfX / static_cast< float32_t >( k );
+            term *= factor * factor;
+            sum += term;
+            if( term < sum * 1.0e-8f )
+            {
+                break;
+            }
+        }
+
+        return sum;
+    }
+
+    /// Get the support radius of a mip filter, in destination texels.
+    static float32_t GetFilterRadius( Texture::EMipFilter filter )
+    {
+        switch( filter )
+        {
+        case Texture::EMipFilter::TRIANGLE:
+            return 1.0f;
+
+        case Texture::EMipFilter::KAISER:
+            return 3.0f;
+
+        default:
+            return 0.5f;
+        }
+    }
+
+    /// Evaluate a mip filter kernel.
+    ///
+    /// @param[in] filter  Filter type.
+    /// @param[in] x       Distance from the filter center, in destination texels.
+    static float32_t EvaluateFilter( Texture::EMipFilter filter, float32_t x )
+    {
+        x = Abs( x );
+
+        switch( filter )
+        {
+        case Texture::EMipFilter::TRIANGLE:
+            return Max( 1.0f - x, 0.0f );
+
+        case Texture::EMipFilter::KAISER:
+            {
+                const float32_t pi = 3.14159265358979f;
+                const float32_t alpha = 4.0f;
+
+                float32_t radius = GetFilterRadius( filter );
+                if( x >= radius )
+                {
+                    return 0.0f;
+                }
+
+                float32_t sinc = ( x < 1.0e-5f ? 1.0f : sinf( pi * x ) / ( pi * x ) );
+                float32_t t = x / radius;
+                float32_t window = BesselI0( alpha * sqrtf( 1.0f - t * t ) ) / BesselI0( alpha );
+
+                return sinc * window;
+            }
+
+        default:
+            return ( x < 0.5f ? 1.0f : 0.0f );
+        }
+    }
+
+    /// Build the resampling weights for reducing an axis of the given source size to the given destination size.
+    static void BuildFilterTable(
+        FilterTable& rTable, Texture::EMipFilter filter, uint32_t sourceSize, uint32_t destinationSize )
+    {
+        HELIUM_ASSERT( sourceSize != 0 );
+        HELIUM_ASSERT( destinationSize != 0 );
+
+        float32_t scale = static_cast< float32_t >( sourceSize ) / static_cast< float32_t >( destinationSize );
+        float32_t sourceRadius = GetFilterRadius( filter ) * scale;
+
+        uint32_t tapCount = static_cast< uint32_t >( sourceRadius * 2.0f ) + 2;
+        rTable.tapCount = tapCount;
+
+        rTable.firstSourceIndices.Reserve( destinationSize );
+        rTable.firstSourceIndices.Resize( destinationSize );
+        rTable.weights.Reserve( static_cast< size_t >( destinationSize ) * tapCount );
+        rTable.weights.Resize( static_cast< size_t >( destinationSize ) * tapCount );
+
+        for( uint32_t destinationIndex = 0; destinationIndex < destinationSize; ++destinationIndex )
+        {
+            float32_t center = ( static_cast< float32_t >( destinationIndex ) + 0.5f ) * scale;
+            int32_t firstSourceIndex = static_cast< int32_t >( Floor( center - sourceRadius ) );
+            rTable.firstSourceIndices[ destinationIndex ] = firstSourceIndex;
+
+            float32_t* pWeights = &rTable.weights[ static_cast< size_t >( destinationIndex ) * tapCount ];
+            float32_t weightSum = 0.0f;
+            for( uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex )
+            {
+                float32_t sourceCenter = static_cast< float32_t >( firstSourceIndex + static_cast< int32_t >( tapIndex ) ) + 0.5f;
+                float32_t weight = EvaluateFilter( filter, ( sourceCenter - center ) / scale );
+                pWeights[ tapIndex ] = weight;
+                weightSum += weight;
+            }
+
+            HELIUM_ASSERT( weightSum > 0.0f );
+            float32_t weightScale = 1.0f / weightSum;
+            for( uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex )
+            {
+                pWeights[ tapIndex ] *= weightScale;
+            }
+        }
+    }
+
+    /// Wrap a texel coordinate into the range of an image axis (textures are filtered using repeat addressing).
+    static inline uint32_t WrapIndex( int32_t index, uint32_t size )
+    {
+        int32_t wrapped = index % static_cast< int32_t >( size );
+
+        return static_cast< uint32_t >( wrapped < 0 ? wrapped + static_cast< int32_t >( size ) : wrapped );
+    }
+
+    /// Job for converting a range of rows of the 32-bit BGRA source image into the floating-point working format.
+    class ConvertSourceImageJob
+    {
+    public:
+        /// [in] Source image data.
+        const uint8_t* pSource;
+        /// [out] Destination image.
+        FloatImage* pDestination;
+        /// [in] First row to convert.
+        uint32_t startRow;
+        /// [in] Number of rows to convert.
+        uint32_t rowCount;
+        /// [in] Table for converting color channel values to linear space.
+        const float32_t* pDecodeTable;
+
+        /// Convert the rows assigned to this job.
+        void Run()
+        {
+            uint32_t width = pDestination->width;
+            size_t startValue = static_cast< size_t >( startRow ) * width * 4;
+            size_t valueCount = static_cast< size_t >( rowCount ) * width * 4;
+
+            const uint8_t* pSourceValue = pSource + startValue;
+            float32_t* pDestinationValue = pDestination->texels.GetData() + startValue;
+            for( size_t valueIndex = 0; valueIndex < valueCount; valueIndex += 4 )
+            {
+                pDestinationValue[ valueIndex ] = pDecodeTable[ pSourceValue[ valueIndex ] ];
+                pDestinationValue[ valueIndex + 1 ] = pDecodeTable[ pSourceValue[ valueIndex + 1 ] ];
+                pDestinationValue[ valueIndex + 2 ] = pDecodeTable[ pSourceValue[ valueIndex + 2 ] ];
+                pDestinationValue[ valueIndex + 3 ] = static_cast< float32_t >( pSourceValue[ valueIndex + 3 ] ) * ( 1.0f / 255.0f );
+            }
+        }
+
+        /// Callback executed to run the job.
+        static void RunCallback( void* pJob )
+        {
+            HELIUM_ASSERT( pJob );
+            static_cast< ConvertSourceImageJob* >( pJob )->Run();
+        }
+    };
+
+    /// Job for filtering a range of rows of one mip level horizontally into an intermediate image.
+    class HorizontalMipFilterJob
+    {
+    public:
+        /// [in] Source mip level.
+        const FloatImage* pSource;
+        /// [out] Intermediate image (destination width, source height).
+        FloatImage* pDestination;
+        /// [in] Horizontal filter weights.
+        const FilterTable* pFilter;
+        /// [in] First row to filter.
+        uint32_t startRow;
+        /// [in] Number of rows to filter.
+        uint32_t rowCount;
+
+        /// Filter the rows assigned to this job.
+        void Run()
+        {
+            const FilterTable& rFilter = *pFilter;
+            uint32_t tapCount = rFilter.tapCount;
+            uint32_t sourceWidth = pSource->width;
+            uint32_t destinationWidth = pDestination->width;
+
+            for( uint32_t row = startRow; row < startRow + rowCount; ++row )
+            {
+                const float32_t* pSourceRow = pSource->texels.GetData() + static_cast< size_t >( row ) * sourceWidth * 4;
+                float32_t* pDestinationTexel =
+                    pDestination->texels.GetData() + static_cast< size_t >( row ) * destinationWidth * 4;
+
+                for( uint32_t x = 0; x < destinationWidth; ++x, pDestinationTexel += 4 )
+                {
+                    int32_t firstSourceIndex = rFilter.firstSourceIndices[ x ];
+                    const float32_t* pWeights = &rFilter.weights[ static_cast< size_t >( x ) * tapCount ];
+
+                    float32_t sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+                    for( uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex )
+                    {
+                        float32_t weight = pWeights[ tapIndex ];
+                        const float32_t* pSourceTexel = pSourceRow +
+                            WrapIndex( firstSourceIndex + static_cast< int32_t >( tapIndex ), sourceWidth ) * 4;
+                        sum0 += pSourceTexel[ 0 ] * weight;
+                        sum1 += pSourceTexel[ 1 ] * weight;
+                        sum2 += pSourceTexel[ 2 ] * weight;
+                        sum3 += pSourceTexel[ 3 ] * weight;
+                    }
+
+                    pDestinationTexel[ 0 ] = sum0;
+                    pDestinationTexel[ 1 ] = sum1;
+                    pDestinationTexel[ 2 ] = sum2;
+                    pDestinationTexel[ 3 ] = sum3;
+                }
+            }
+        }
+
+        /// Callback executed to run the job.
+        static void RunCallback( void* pJob )
+        {
+            HELIUM_ASSERT( pJob );
+            static_cast< HorizontalMipFilterJob* >( pJob )->Run();
+        }
+    };
+
+    /// Job for filtering a range of rows of the next mip level vertically from an intermediate image.
+    class VerticalMipFilterJob
+    {
+    public:
+        /// [in] Intermediate image (destination width, source height).
+        const FloatImage* pSource;
+        /// [out] Destination mip level.
+        FloatImage* pDestination;
+        /// [in] Vertical filter weights.
+        const FilterTable* pFilter;
+        /// [in] First row to filter.
+        uint32_t startRow;
+        /// [in] Number of rows to filter.
+        uint32_t rowCount;
+        /// [in] True to renormalize the filtered texels as tangent-space normals.
+        bool bNormalMap;
+
+        /// Filter the rows assigned to this job.
+        void Run()
+        {
+            const FilterTable& rFilter = *pFilter;
+            uint32_t tapCount = rFilter.tapCount;
+            uint32_t width = pDestination->width;
+            uint32_t sourceHeight = pSource->height;
+            size_t rowValueCount = static_cast< size_t >( width ) * 4;
+
+            for( uint32_t row = startRow; row < startRow + rowCount; ++row )
+            {
+                float32_t* pDestinationRow = pDestination->texels.GetData() + row * rowValueCount;
+                MemoryZero( pDestinationRow, rowValueCount * sizeof( float32_t ) );
+
+                int32_t firstSourceIndex = rFilter.firstSourceIndices[ row ];
+                const float32_t* pWeights = &rFilter.weights[ static_cast< size_t >( row ) * tapCount ];
+                for( uint32_t tapIndex = 0; tapIndex < tapCount; ++tapIndex )
+                {
+                    float32_t weight = pWeights[ tapIndex ];
+                    if( weight == 0.0f )
+                    {
+                        continue;
+                    }
+
+                    const float32_t* pSourceRow = pSource->texels.GetData() +
+                        WrapIndex( firstSourceIndex + static_cast< int32_t >( tapIndex ), sourceHeight ) * rowValueCount;
+                    for( size_t valueIndex = 0; valueIndex < rowValueCount; ++valueIndex )
+                    {
+                        pDestinationRow[ valueIndex ] += pSourceRow[ valueIndex ] * weight;
+                    }
+                }
+
+                if( bNormalMap )
+                {
+                    // Normals are stored biased into the [0, 1] range in the blue, green, and red channels.
+                    for( size_t valueIndex = 0; valueIndex < rowValueCount; valueIndex += 4 )
+                    {
+                        float32_t* pTexel = pDestinationRow + valueIndex;
+                        float32_t x = pTexel[ 2 ] * 2.0f - 1.0f;
+                        float32_t y = pTexel[ 1 ] * 2.0f - 1.0f;
+                        float32_t z = pTexel[ 0 ] * 2.0f - 1.0f;
+
+                        float32_t lengthSquared = x * x + y * y + z * z;
+                        if( lengthSquared > 1.0e-12f )
+                        {
+                            float32_t scale = 0.5f / sqrtf( lengthSquared );
+                            pTexel[ 2 ] = x * scale + 0.5f;
+                            pTexel[ 1 ] = y * scale + 0.5f;
+                            pTexel[ 0 ] = z * scale + 0.5f;
+                        }
+                    }
+                }
+            }
+        }
+
+        /// Callback executed to run the job.
+        static void RunCallback( void* pJob )
+        {
+            HELIUM_ASSERT( pJob );
+            static_cast< VerticalMipFilterJob* >( pJob )->Run();
+        }
+    };
+
+    /// Job for compressing a horizontal strip of a mip level.  Strips span the full width of the mip level and start
+    /// on a block row boundary, so the compressed strips of a level can simply be concatenated.
+    class CompressStripJob
+    {
+    public:
+        /// [in] Mip level to compress.
+        const FloatImage* pLevel;
+        /// [in] First row to compress.
+        uint32_t startRow;
+        /// [in] Number of rows to compress.
+        uint32_t rowCount;
+        /// [in] True if the level is in sRGB color space and needs to be converted back from linear space.
+        bool bSrgb;
+        /// [in] True if the level contains normal map data.
+        bool bNormalMap;
+        /// [in] Output format.
+        nvtt::Format outputFormat;
+        /// [out] Compressed strip data.
+        DynamicArray< uint8_t > output;
+        /// [out] True if compression succeeded.
+        bool bSuccess;
+
+        /// Compress the strip assigned to this job.
+        void Run()
+        {
+            bSuccess = false;
+
+            uint32_t width = pLevel->width;
+            size_t valueCount = static_cast< size_t >( width ) * rowCount * 4;
+            const float32_t* pSourceValue =
+                pLevel->texels.GetData() + static_cast< size_t >( startRow ) * width * 4;
+
+            // Convert the strip back to 32-bit BGRA for the NVIDIA texture tools library to process.
+            DynamicArray< uint8_t > bgraData;
+            bgraData.Reserve( valueCount );
+            bgraData.Resize( valueCount );
+
+            float32_t inverseGamma = 1.0f / SRGB_GAMMA;
+            uint8_t* pDestinationValue = bgraData.GetData();
+            for( size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex )
+            {
+                float32_t value = Clamp( pSourceValue[ valueIndex ], 0.0f, 1.0f );
+                if( bSrgb && ( valueIndex & 3 ) != 3 )
+                {
+                    value = powf( value, inverseGamma );
+                }
+
+                pDestinationValue[ valueIndex ] = static_cast< uint8_t >( value * 255.0f + 0.5f );
+            }
+
+            nvtt::InputOptions inputOptions;
+            inputOptions.setTextureLayout( nvtt::TextureType_2D, width, rowCount );
+            inputOptions.setMipmapData( bgraData.GetData(), width, rowCount );
+            inputOptions.setMipmapGeneration( false );
+            inputOptions.setWrapMode( nvtt::WrapMode_Repeat );
+            inputOptions.setGamma( 1.0f, 1.0f );
+            inputOptions.setNormalMap( bNormalMap );
+
+            MemoryTextureOutputHandler outputHandler( width, rowCount, false, false );
+
+            nvtt::OutputOptions outputOptions;
+            outputOptions.setOutputHandler( &outputHandler );
+            outputOptions.setOutputHeader( false );
+
+            nvtt::CompressionOptions compressionOptions;
+            compressionOptions.setFormat( outputFormat );
+            if( outputFormat == nvtt::Format_RGBA )
+            {
+#if HELIUM_ENDIAN_LITTLE
+                compressionOptions.setPixelFormat( 32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff );
+#else
+                compressionOptions.setPixelFormat( 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 );
+#endif
+            }
+
+            compressionOptions.setQuality( nvtt::Quality_Normal );
+
+            // Each job runs its own compressor on the CPU, so keep CUDA out of the picture to avoid contention for
+            // the device.
+            nvtt::Compressor compressor;
+            compressor.enableCudaAcceleration( false );
+            if( !compressor.process( inputOptions, compressionOptions, outputOptions ) )
+            {
+                return;
+            }
+
+            const MemoryTextureOutputHandler::MipLevelArray& rMipLevels = outputHandler.GetFace( 0 );
+            HELIUM_ASSERT( rMipLevels.GetSize() == 1 );
+            output = rMipLevels[ 0 ];
+
+            bSuccess = true;
+        }
+
+        /// Callback executed to run the job.
+        static void RunCallback( void* pJob )
+        {
+            HELIUM_ASSERT( pJob );
+            static_cast< CompressStripJob* >( pJob )->Run();
+        }
+    };
+
+    /// Generate the next mip level from the given level, filtering in parallel across row ranges.
+    static void GenerateMipLevel(
+        const FloatImage& rSource, FloatImage& rDestination, Texture::EMipFilter filter, bool bNormalMap )
+    {
+        uint32_t destinationWidth = Max< uint32_t >( rSource.width / 2, 1 );
+        uint32_t destinationHeight = Max< uint32_t >( rSource.height / 2, 1 );
+
+        FilterTable horizontalFilter;
+        BuildFilterTable( horizontalFilter, filter, rSource.width, destinationWidth );
+        FilterTable verticalFilter;
+        BuildFilterTable( verticalFilter, filter, rSource.height, destinationHeight );
+
+        FloatImage intermediate;
+        intermediate.Allocate( destinationWidth, rSource.height );
+        rDestination.Allocate( destinationWidth, destinationHeight );
+
+        uint32_t jobCount = ( rSource.height + MIP_FILTER_JOB_ROW_COUNT_MAX - 1 ) / MIP_FILTER_JOB_ROW_COUNT_MAX;
+        DynamicArray< HorizontalMipFilterJob > horizontalJobs;
+        horizontalJobs.Reserve( jobCount );
+        for( uint32_t startRow = 0; startRow < rSource.height; startRow += MIP_FILTER_JOB_ROW_COUNT_MAX )
+        {
+            HorizontalMipFilterJob* pJob = horizontalJobs.New();
+            HELIUM_ASSERT( pJob );
+            pJob->pSource = &rSource;
+            pJob->pDestination = &intermediate;
+            pJob->pFilter = &horizontalFilter;
+            pJob->startRow = startRow;
+            pJob->rowCount = Min( MIP_FILTER_JOB_ROW_COUNT_MAX, rSource.height - startRow );
+        }
+
+        JobManager::Run( horizontalJobs.GetData(), horizontalJobs.GetSize() );
+
+        jobCount = ( destinationHeight + MIP_FILTER_JOB_ROW_COUNT_MAX - 1 ) / MIP_FILTER_JOB_ROW_COUNT_MAX;
+        DynamicArray< VerticalMipFilterJob > verticalJobs;
+        verticalJobs.Reserve( jobCount );
+        for( uint32_t startRow = 0; startRow < destinationHeight; startRow += MIP_FILTER_JOB_ROW_COUNT_MAX )
+        {
+            VerticalMipFilterJob* pJob = verticalJobs.New();
+            HELIUM_ASSERT( pJob );
+            pJob->pSource = &intermediate;
+            pJob->pDestination = &rDestination;
+            pJob->pFilter = &verticalFilter;
+            pJob->startRow = startRow;
+            pJob->rowCount = Min( MIP_FILTER_JOB_ROW_COUNT_MAX, destinationHeight - startRow );
+            pJob->bNormalMap = bNormalMap;
+        }
+
+        JobManager::Run( verticalJobs.GetData(), verticalJobs.GetSize() );
+    }
+
+    /// Compress a mip level, splitting it into strips that are compressed in parallel.
+    ///
+    /// @return  True if compression succeeded, false if not.
+    static bool CompressMipLevel(
+        const FloatImage& rLevel,
+        bool bSrgb,
+        bool bNormalMap,
+        nvtt::Format outputFormat,
+        DynamicArray< uint8_t >& rOutput )
+    {
+        HELIUM_COMPILE_ASSERT( COMPRESSION_JOB_ROW_COUNT_MAX % 4 == 0 );
+
+        uint32_t height = rLevel.height;
+        uint32_t jobCount = ( height + COMPRESSION_JOB_ROW_COUNT_MAX - 1 ) / COMPRESSION_JOB_ROW_COUNT_MAX;
+
+        DynamicArray< CompressStripJob > jobs;
+        jobs.Reserve( jobCount );
+        for( uint32_t startRow = 0; startRow < height; startRow += COMPRESSION_JOB_ROW_COUNT_MAX )
+        {
+            CompressStripJob* pJob = jobs.New();
+            HELIUM_ASSERT( pJob );
+            pJob->pLevel = &rLevel;
+            pJob->startRow = startRow;
+            pJob->rowCount = Min( COMPRESSION_JOB_ROW_COUNT_MAX, height - startRow );
+            pJob->bSrgb = bSrgb;
+            pJob->bNormalMap = bNormalMap;
+            pJob->outputFormat = outputFormat;
+            pJob->bSuccess = false;
+        }
+
+        JobManager::Run( jobs.GetData(), jobs.GetSize() );
+
+        size_t outputSize = 0;
+        for( size_t jobIndex = 0; jobIndex < jobs.GetSize(); ++jobIndex )
+        {
+            if( !jobs[ jobIndex ].bSuccess )
+            {
+                return false;
+            }
+
+            outputSize += jobs[ jobIndex ].output.GetSize();
+        }
+
+        rOutput.Clear();
+        rOutput.Reserve( outputSize );
+        for( size_t jobIndex = 0; jobIndex < jobs.GetSize(); ++jobIndex )
+        {
+            const DynamicArray< uint8_t >& rStripData = jobs[ jobIndex ].output;
+            rOutput.AddArray( rStripData.GetData(), rStripData.GetSize() );
+        }
+
+        return true;
+    }
+}
+
 /// Constructor.
 Texture2dResourceHandler::Texture2dResourceHandler()
 {
@@ -162,7 +720,7 @@ bool Texture2dResourceHandler::CacheResource(
         }
     }
 
-    // Set up the input options for the texture compressor.
+    // Determine the output format for the texture compressor.
     Texture::ECompression compression = pTexture->GetCompression();
     HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( Texture::ECompression::MAX ) );
 
@@ -171,29 +729,6 @@ bool Texture2dResourceHandler::CacheResource(
     bool bSrgb = pTexture->GetSrgb();
     bool bCreateMipmaps = pTexture->GetCreateMipmaps();
 
-    nvtt::InputOptions inputOptions;
-    inputOptions.setTextureLayout( nvtt::TextureType_2D, imageWidth, imageHeight );
-    inputOptions.setMipmapData( pImagePixelData, imageWidth, imageHeight );
-    inputOptions.setMipmapGeneration( bCreateMipmaps );
-    inputOptions.setMipmapFilter( nvtt::MipmapFilter_Box );
-    inputOptions.setWrapMode( nvtt::WrapMode_Repeat );
-
-    float gamma = ( bSrgb ? 2.2f : 1.0f );
-    inputOptions.setGamma( gamma, gamma );
-
-    inputOptions.setNormalMap( bIsNormalMap );
-    inputOptions.setNormalizeMipmaps( bIsNormalMap );
-
-    // Set up the output options for the texture compressor.
-    MemoryTextureOutputHandler outputHandler( imageWidth, imageHeight, false, bCreateMipmaps );
-
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHandler( &outputHandler );
-    outputOptions.setOutputHeader( false );
-
-    // Set up the compression options for the texture compressor.
-    nvtt::CompressionOptions compressionOptions;
-
     nvtt::Format outputFormat = nvtt::Format_BC1;
     ERendererPixelFormat pixelFormat = RENDERER_PIXEL_FORMAT_BC1;
 
@@ -202,11 +737,6 @@ bool Texture2dResourceHandler::CacheResource(
     case Texture::ECompression::NONE:
         {
             outputFormat = nvtt::Format_RGBA;
-#if HELIUM_ENDIAN_LITTLE
-            compressionOptions.setPixelFormat( 32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff );
-#else
-            compressionOptions.setPixelFormat( 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 );
-#endif
             pixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_R8G8B8A8_SRGB : RENDERER_PIXEL_FORMAT_R8G8B8A8 );
 
             break;
@@ -268,31 +798,93 @@ bool Texture2dResourceHandler::CacheResource(
             break;
         }
 
+    case Texture::ECompression::NORMAL_MAP_TWO_CHANNEL:
+        {
+            outputFormat = nvtt::Format_BC5;
+            pixelFormat = RENDERER_PIXEL_FORMAT_BC5;
+
+            break;
+        }
+
     default:
         break;
     }
 
-    compressionOptions.setFormat( outputFormat );
-    compressionOptions.setQuality( nvtt::Quality_Normal );
+    // Convert the image to floating-point (in linear space for sRGB textures) for mip level generation.
+    float32_t decodeTable[ 256 ];
+    for( uint32_t value = 0; value < HELIUM_ARRAY_COUNT( decodeTable ); ++value )
+    {
+        float32_t normalizedValue = static_cast< float32_t >( value ) * ( 1.0f / 255.0f );
+        decodeTable[ value ] = ( bSrgb ? powf( normalizedValue, SRGB_GAMMA ) : normalizedValue );
+    }
+
+    FloatImage levels[ 2 ];
+    levels[ 0 ].Allocate( imageWidth, imageHeight );
 
-    // Compress the texture.
-    nvtt::Compressor compressor;
-    bool bCompressSuccess = compressor.process( inputOptions, compressionOptions, outputOptions );
-    HELIUM_ASSERT( bCompressSuccess );
-    if( !bCompressSuccess )
     {
-        HELIUM_TRACE(
-            TraceLevels::Error,
-            "Texture2dResourceHandler::CacheResource(): Texture compression failed for texture image \"%s\".\n",
-            *rSourceFilePath );
+        uint32_t jobCount = ( imageHeight + MIP_FILTER_JOB_ROW_COUNT_MAX - 1 ) / MIP_FILTER_JOB_ROW_COUNT_MAX;
+        DynamicArray< ConvertSourceImageJob > convertJobs;
+        convertJobs.Reserve( jobCount );
+        for( uint32_t startRow = 0; startRow < imageHeight; startRow += MIP_FILTER_JOB_ROW_COUNT_MAX )
+        {
+            ConvertSourceImageJob* pJob = convertJobs.New();
+            HELIUM_ASSERT( pJob );
+            pJob->pSource = static_cast< const uint8_t* >( pImagePixelData );
+            pJob->pDestination = &levels[ 0 ];
+            pJob->startRow = startRow;
+            pJob->rowCount = Min( MIP_FILTER_JOB_ROW_COUNT_MAX, imageHeight - startRow );
+            pJob->pDecodeTable = decodeTable;
+        }
 
-        return false;
+        JobManager::Run( convertJobs.GetData(), convertJobs.GetSize() );
     }
 
-    // Cache the data for each supported platform.
-    const MemoryTextureOutputHandler::MipLevelArray& rMipLevels = outputHandler.GetFace( 0 );
-    uint32_t mipLevelCount = static_cast< uint32_t >( rMipLevels.GetSize() );
-    HELIUM_ASSERT( mipLevelCount != 0 );
+    bgraImage.Unload();
+
+    // Compute the number of mip levels to generate.
+    uint32_t mipLevelCount = 1;
+    if( bCreateMipmaps )
+    {
+        for( uint32_t width = imageWidth, height = imageHeight; width > 1 || height > 1; width /= 2, height /= 2 )
+        {
+            ++mipLevelCount;
+        }
+    }
+
+    // Compress each mip level in strips spread across the job manager threads, generating the next level from the
+    // current one (in parallel as well) before moving on.  Only two levels of floating-point data are kept around at
+    // any given time.
+    MemoryTextureOutputHandler::MipLevelArray mipLevels;
+    mipLevels.Reserve( mipLevelCount );
+    mipLevels.Resize( mipLevelCount );
+
+    for( uint32_t mipIndex = 0; mipIndex < mipLevelCount; ++mipIndex )
+    {
+        FloatImage& rCurrentLevel = levels[ mipIndex & 1 ];
+
+        bool bCompressSuccess = CompressMipLevel(
+            rCurrentLevel,
+            bSrgb,
+            bIsNormalMap,
+            outputFormat,
+            mipLevels[ mipIndex ] );
+        HELIUM_ASSERT( bCompressSuccess );
+        if( !bCompressSuccess )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                "Texture2dResourceHandler::CacheResource(): Texture compression failed for mip level %" PRIu32 " of texture image \"%s\".\n",
+                mipIndex,
+                *rSourceFilePath );
+
+            return false;
+        }
+
+        if( mipIndex + 1 < mipLevelCount )
+        {
+            GenerateMipLevel( rCurrentLevel, levels[ ( mipIndex + 1 ) & 1 ], pTexture->GetMipFilter(), bIsNormalMap );
+        }
+    }
 
     int32_t pixelFormatIndex = static_cast< int32_t >( pixelFormat );
 
@@ -317,7 +909,7 @@ bool Texture2dResourceHandler::CacheResource(
 
         SaveObjectToPersistentDataBuffer(persistentResourceData.Get(), rPreprocessedData.persistentDataBuffer);
 
-        rPreprocessedData.subDataBuffers = rMipLevels;
+        rPreprocessedData.subDataBuffers = mipLevels;
 
         rPreprocessedData.bLoaded = true;
     }
@@ -5,6 +5,8 @@
 #include "Engine/Asset.h"
 #include "Engine/PackageLoader.h"
 #include "Engine/FileLocations.h"
+#include "Engine/MemoryTracker.h"
+#include "Engine/FrameProfiler.h"
 
 /// Asset cache name.
 
@@ -92,6 +94,7 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 
 	// Add the load request.
 	LoadRequest* pRequest = m_loadRequestPool.Allocate();
+	HELIUM_TRACK_ALLOCATION( MEMORY_TAG_ASSET_LOADER, sizeof( LoadRequest ) );
 	pRequest->path = path;
 	pRequest->pPackageLoader = pPackageLoader;
 	SetInvalid( pRequest->packageLoadRequestId );
@@ -113,6 +116,7 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 	else
 	{
 		// A matching request was added while we were building our request, so reuse it.
+		HELIUM_TRACK_FREE( MEMORY_TAG_ASSET_LOADER, sizeof( LoadRequest ) );
 		m_loadRequestPool.Release( pRequest );
 
 		pRequest = requestAccessor->Second();
@@ -177,6 +181,7 @@ bool AssetLoader::TryFinishLoad( size_t id, AssetPtr& rspObject )
 		pRequest->resolver.Clear();
 
 		m_loadRequestMap.Remove( requestAccessor );
+		HELIUM_TRACK_FREE( MEMORY_TAG_ASSET_LOADER, sizeof( LoadRequest ) );
 		m_loadRequestPool.Release( pRequest );
 	}
 
@@ -267,6 +272,8 @@ bool AssetLoader::CacheObject( Asset* /*pObject*/, bool /*bEvictPlatformPreproce
 /// Update object loading.
 void AssetLoader::Tick()
 {
+	HELIUM_FRAME_ZONE( "AssetLoader::Tick" );
+
 	// Tick package loaders first.
 	TickPackageLoaders();
 
@@ -315,6 +322,7 @@ void AssetLoader::Tick()
 					pRequest->resolver.Clear();
 
 					m_loadRequestMap.Remove( loadRequestAccessor );
+					HELIUM_TRACK_FREE( MEMORY_TAG_ASSET_LOADER, sizeof( LoadRequest ) );
 					m_loadRequestPool.Release( pRequest );
 				}
 			}
@@ -2,6 +2,8 @@
 #include "Engine/AsyncLoader.h"
 
 #include "Engine/FileLocations.h"
+#include "Engine/FrameProfiler.h"
+#include "Engine/MemoryTracker.h"
 #include "Foundation/FileStream.h"
 
 using namespace Helium;
@@ -93,6 +95,7 @@ size_t AsyncLoader::QueueRequest(
 
 	// Allocate and queue the request.
 	Request* pRequest = m_requestPool.Allocate();
+	HELIUM_TRACK_ALLOCATION( MEMORY_TAG_ASYNC_LOADER, sizeof( Request ) );
 	HELIUM_ASSERT( pRequest );
 	pRequest->pBuffer = pBuffer;
 	pRequest->fileName = rFileName;
@@ -135,6 +138,7 @@ size_t AsyncLoader::SyncRequest( size_t id )
 	}
 
 	size_t bytesRead = pRequest->bytesRead;
+	HELIUM_TRACK_FREE( MEMORY_TAG_ASYNC_LOADER, sizeof( Request ) );
 	m_requestPool.Release( pRequest );
 
 	return bytesRead;
@@ -165,6 +169,7 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 	}
 
 	rBytesRead = pRequest->bytesRead;
+	HELIUM_TRACK_FREE( MEMORY_TAG_ASYNC_LOADER, sizeof( Request ) );
 	m_requestPool.Release( pRequest );
 
 	return true;
@@ -261,6 +266,12 @@ AsyncLoader::LoadWorker::~LoadWorker()
 /// Execute the async loading work.
 void AsyncLoader::LoadWorker::Run()
 {
+	FrameProfiler* pFrameProfiler = FrameProfiler::GetInstance();
+	if( pFrameProfiler )
+	{
+		pFrameProfiler->SetThreadName( "AsyncLoader" );
+	}
+
 	BufferedStream* pBufferedStream = new BufferedStream;
 	HELIUM_ASSERT( pBufferedStream );
 
@@ -284,25 +295,29 @@ void AsyncLoader::LoadWorker::Run()
 
 		HELIUM_ASSERT( pRequest );
 
-		FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
-		if( !pFileStream )
-		{
-			SetInvalid( pRequest->bytesRead );
-		}
-		else
 		{
-			pRequest->bytesRead = 0;
+			HELIUM_FRAME_ZONE( "AsyncLoader::LoadRequest" );
 
-			pBufferedStream->Open( pFileStream );
-			int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( offset ) == pRequest->offset )
+			FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
+			if( !pFileStream )
 			{
-				pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+				SetInvalid( pRequest->bytesRead );
 			}
+			else
+			{
+				pRequest->bytesRead = 0;
 
-			pBufferedStream->Open( NULL );
+				pBufferedStream->Open( pFileStream );
+				int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
+				if( static_cast< uint64_t >( offset ) == pRequest->offset )
+				{
+					pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+				}
 
-			delete pFileStream;
+				pBufferedStream->Open( NULL );
+
+				delete pFileStream;
+			}
 		}
 
 		AtomicExchangeRelease( pRequest->processedCounter, 1 );
@@ -7,6 +7,7 @@
 
 #include "Engine/Asset.h"
 #include "Engine/FileLocations.h"
+#include "Engine/MemoryTracker.h"
 #include "Engine/AsyncLoader.h"
 
 #define USE_BSON_FOR_CACHE_FORMAT 0
@@ -131,6 +132,7 @@ void Cache::Shutdown()
 
 	m_bTocLoaded = false;
 
+	HELIUM_TRACK_FREE( MEMORY_TAG_CACHE, sizeof( Entry ) * m_entries.GetSize() );
 	m_entries.Clear();
 	m_entryMap.Clear();
 
@@ -272,6 +274,7 @@ bool Cache::TryFinishLoadToc()
 			{
 				Entry* pEntry = m_entries[ entryIndex ];
 				HELIUM_ASSERT( pEntry );
+				HELIUM_TRACK_FREE( MEMORY_TAG_CACHE, sizeof( Entry ) );
 				m_pEntryPool->Release( pEntry );
 			}
 
@@ -353,6 +356,7 @@ bool Cache::CacheEntry(
 
 	HELIUM_ASSERT( m_pEntryPool );
 	Entry* pEntryUpdate = m_pEntryPool->Allocate();
+	HELIUM_TRACK_ALLOCATION( MEMORY_TAG_CACHE, sizeof( Entry ) );
 	HELIUM_ASSERT( pEntryUpdate );
 	pEntryUpdate->offset = entryOffset;
 	pEntryUpdate->timestamp = timestamp;
@@ -380,6 +384,7 @@ bool Cache::CacheEntry(
 	{
 		HELIUM_TRACE( TraceLevels::Info, "Cache: Updating \"%s\" in cache \"%s\".\n", *path.ToString(), *m_cacheFileName );
 
+		HELIUM_TRACK_FREE( MEMORY_TAG_CACHE, sizeof( Entry ) );
 		m_pEntryPool->Release( pEntryUpdate );
 
 		pEntryUpdate = entryAccessor->Second();
@@ -437,6 +442,7 @@ bool Cache::CacheEntry(
 			{
 				m_entries.Pop();
 				m_entryMap.Remove( entryAccessor );
+				HELIUM_TRACK_FREE( MEMORY_TAG_CACHE, sizeof( Entry ) );
 				m_pEntryPool->Release( pEntryUpdate );
 			}
 			else
@@ -464,6 +470,7 @@ bool Cache::CacheEntry(
 				{
 					m_entries.Pop();
 					m_entryMap.Remove( entryAccessor );
+					HELIUM_TRACK_FREE( MEMORY_TAG_CACHE, sizeof( Entry ) );
 					m_pEntryPool->Release( pEntryUpdate );
 				}
 				else
@@ -712,6 +719,7 @@ bool Cache::FinalizeTocLoad()
 		}
 
 		Entry* pEntry = m_pEntryPool->Allocate();
+		HELIUM_TRACK_ALLOCATION( MEMORY_TAG_CACHE, sizeof( Entry ) );
 		HELIUM_ASSERT( pEntry );
 		pEntry->path = entryPath;
 		pEntry->subDataIndex = entrySubDataIndex;
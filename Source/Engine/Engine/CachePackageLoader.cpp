@@ -3,6 +3,7 @@
 
 #include "Engine/Asset.h"
 #include "Engine/AssetLoader.h"
+#include "Engine/MemoryTracker.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Resource.h"
@@ -59,8 +60,6 @@ bool CachePackageLoader::Initialize( Name cacheName )
 /// @see Initialize()
 void CachePackageLoader::Shutdown()
 {
-	DefaultAllocator allocator;
-
 	AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
 	HELIUM_ASSERT( pAsyncLoader );
 
@@ -76,8 +75,9 @@ void CachePackageLoader::Shutdown()
 				pAsyncLoader->SyncRequest( pRequest->asyncLoadId );
 			}
 
-			allocator.Free( pRequest->pAsyncLoadBuffer );
+			FreeAsyncLoadBuffer( pRequest );
 
+			HELIUM_TRACK_FREE( MEMORY_TAG_PACKAGE_LOADER, sizeof( LoadRequest ) );
 			m_loadRequestPool.Release( pRequest );
 		}
 	}
@@ -140,6 +140,7 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 			*path.ToString() );
 
 		LoadRequest* pRequest = m_loadRequestPool.Allocate();
+		HELIUM_TRACK_ALLOCATION( MEMORY_TAG_PACKAGE_LOADER, sizeof( LoadRequest ) );
 		HELIUM_ASSERT( pRequest );
 		pRequest->pEntry = NULL;
 		pRequest->pResolver = pResolver;
@@ -200,6 +201,7 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 #endif
 
 	LoadRequest* pRequest = m_loadRequestPool.Allocate();
+	HELIUM_TRACK_ALLOCATION( MEMORY_TAG_PACKAGE_LOADER, sizeof( LoadRequest ) );
 	HELIUM_ASSERT( pRequest );
 	pRequest->pEntry = pEntry;
 	pRequest->pResolver = pResolver;
@@ -242,6 +244,7 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 		size_t entrySize = pEntry->size;
 		pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
 		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+		HELIUM_TRACK_ALLOCATION( MEMORY_TAG_PACKAGE_LOADER, entrySize );
 
 		AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
 		HELIUM_ASSERT( pAsyncLoader );
@@ -325,6 +328,7 @@ bool CachePackageLoader::TryFinishLoadObject( size_t requestId, AssetPtr& rspObj
 		requestId );
 
 	m_loadRequests.Remove( requestId );
+	HELIUM_TRACK_FREE( MEMORY_TAG_PACKAGE_LOADER, sizeof( LoadRequest ) );
 	m_loadRequestPool.Release( pRequest );
 
 	return true;
@@ -433,8 +437,7 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 
 	// An error occurred attempting to load the property data, so mark any existing object as fully loaded (nothing
 	// else will be done with the object itself from here on out).
-	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-	pRequest->pAsyncLoadBuffer = NULL;
+	FreeAsyncLoadBuffer( pRequest );
 
 	Asset* pObject = pRequest->spObject;
 	if( pObject )
@@ -484,8 +487,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				"CachePackageLoader: Failed to load owner object for \"%s\".\n",
 				*pCacheEntry->path.ToString() );
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+			FreeAsyncLoadBuffer( pRequest );
 
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -559,8 +561,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 		}
 	}
 
-	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-	pRequest->pAsyncLoadBuffer = NULL;
+	FreeAsyncLoadBuffer( pRequest );
 
 	pObject->SetFlags( Asset::FLAG_PRELOADED );
 
@@ -679,3 +680,20 @@ bool CachePackageLoader::ReadCacheData( LoadRequest* pRequest )
 
 	return true;
 }
+
+/// Free the async load buffer of a load request, if one was allocated.
+///
+/// @param[in] pRequest  Load request data.
+void CachePackageLoader::FreeAsyncLoadBuffer( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	if( pRequest->pAsyncLoadBuffer )
+	{
+		HELIUM_ASSERT( pRequest->pEntry );
+		HELIUM_TRACK_FREE( MEMORY_TAG_PACKAGE_LOADER, pRequest->pEntry->size );
+
+		DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
+		pRequest->pAsyncLoadBuffer = NULL;
+	}
+}
@@ -111,6 +111,7 @@ namespace Helium
 		//@{
 		static void ResolvePackage( AssetPtr& spPackage, AssetPath packagePath );
 		static bool ReadCacheData( LoadRequest* pRequest );
+		static void FreeAsyncLoadBuffer( LoadRequest* pRequest );
 		//@}
 	};
 }
@@ -0,0 +1,452 @@
+#include "Precompile.h"
+#include "Engine/FrameProfiler.h"
+
+#include "Foundation/FileStream.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+FrameProfiler* FrameProfiler::sm_pInstance = NULL;
+
+/// Convert a timer tick count to microseconds.
+///
+/// @param[in] tickCount  Tick count.
+///
+/// @return  Number of microseconds.
+static float64_t TicksToMicroseconds( uint64_t tickCount )
+{
+	return static_cast< float64_t >( tickCount ) * Timer::GetSecondsPerTick() * 1000000.0;
+}
+
+/// Append a string to a JSON document as a quoted string value.
+///
+/// @param[in]  pString  String to append.
+/// @param[out] rJson    JSON document text.
+static void AppendJsonString( const char* pString, String& rJson )
+{
+	HELIUM_ASSERT( pString );
+
+	rJson += '"';
+	for( ; *pString != '\0'; ++pString )
+	{
+		char character = *pString;
+		if( character == '"' || character == '\\' )
+		{
+			rJson += '\\';
+			rJson += character;
+		}
+		else if( static_cast< unsigned char >( character ) >= ' ' )
+		{
+			rJson += character;
+		}
+	}
+	rJson += '"';
+}
+
+/// Constructor.
+FrameProfiler::FrameProfiler()
+	: m_statsFrameIndex( 0 )
+	, m_statsFrameCount( 0 )
+	, m_baseTickCount( 0 )
+	, m_bEnabled( false )
+{
+}
+
+/// Destructor.
+FrameProfiler::~FrameProfiler()
+{
+	Cleanup();
+}
+
+/// Initialize the profiler and start recording zones.
+///
+/// @return  True if initialization was successful, false if not.
+///
+/// @see Cleanup()
+bool FrameProfiler::Initialize()
+{
+	Cleanup();
+
+	m_baseTickCount = Timer::GetTickCount();
+	m_bEnabled = true;
+
+	return true;
+}
+
+/// Stop recording zones and free all profiling data.
+///
+/// This must not be called while other threads may still be recording zones.
+///
+/// @see Initialize()
+void FrameProfiler::Cleanup()
+{
+	m_bEnabled = false;
+
+	{
+		Locker< DynamicArray< ThreadData* >, SpinLock >::Handle handle( m_threads );
+		size_t threadCount = handle->GetSize();
+		for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+		{
+			delete ( *handle )[ threadIndex ];
+		}
+
+		handle->Clear();
+	}
+
+	m_threadData.SetPointer( NULL );
+
+	m_zones.Clear();
+	m_zoneMap.Clear();
+	m_statsFrameIndex = 0;
+	m_statsFrameCount = 0;
+}
+
+/// Set whether zones should be recorded.
+///
+/// Zones entered while recording is disabled are not recorded, even if recording is enabled before they exit.
+///
+/// @param[in] bEnabled  True to record zones, false to stop recording.
+///
+/// @see IsEnabled()
+void FrameProfiler::SetEnabled( bool bEnabled )
+{
+	m_bEnabled = bEnabled;
+}
+
+/// Set the name of the calling thread, as shown in exported traces.
+///
+/// @param[in] pName  Thread name.  This must remain valid for the lifetime of the profiler.
+void FrameProfiler::SetThreadName( const char* pName )
+{
+	HELIUM_ASSERT( pName );
+
+	ThreadData* pThreadData = GetThreadData();
+	HELIUM_ASSERT( pThreadData );
+	pThreadData->pName = pName;
+}
+
+/// Record a completed zone for the calling thread.
+///
+/// This is normally called through a Zone instance (see HELIUM_FRAME_ZONE()), but can also be used for timing that
+/// does not follow scope boundaries.
+///
+/// @param[in] pName           Zone name.  This must remain valid for the lifetime of the profiler.
+/// @param[in] startTickCount  Timer tick count when the zone was entered.
+/// @param[in] endTickCount    Timer tick count when the zone was exited.
+void FrameProfiler::RecordZone( const char* pName, uint64_t startTickCount, uint64_t endTickCount )
+{
+	HELIUM_ASSERT( pName );
+
+	ThreadData* pThreadData = GetThreadData();
+	HELIUM_ASSERT( pThreadData );
+
+	uint32_t eventCount = static_cast< uint32_t >( pThreadData->eventCount );
+	Event& rEvent = pThreadData->events[ eventCount & ( THREAD_EVENT_CAPACITY - 1 ) ];
+	rEvent.pName = pName;
+	rEvent.startTickCount = startTickCount;
+	rEvent.endTickCount = endTickCount;
+
+	// Publish the event only after it has been fully written.
+	AtomicIncrementRelease( pThreadData->eventCount );
+}
+
+/// Fold all zones recorded since the previous call into the rolling per-zone statistics.
+///
+/// This should be called once at the end of each frame.  Each zone is attributed to the frame in which it exits.  If
+/// a thread records more than THREAD_EVENT_CAPACITY zones in a single frame, its oldest zones for that frame are not
+/// counted.
+///
+/// @see GetZoneStats()
+void FrameProfiler::EndFrame()
+{
+	DynamicArray< ThreadData* > threads;
+	{
+		Locker< DynamicArray< ThreadData* >, SpinLock >::Handle handle( m_threads );
+		threads = *handle;
+	}
+
+	size_t threadCount = threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		ThreadData* pThreadData = threads[ threadIndex ];
+		HELIUM_ASSERT( pThreadData );
+
+		uint32_t eventCount = static_cast< uint32_t >( pThreadData->eventCount );
+		uint32_t newEventCount = eventCount - pThreadData->statsEventCount;
+		if( newEventCount > THREAD_EVENT_CAPACITY )
+		{
+			newEventCount = THREAD_EVENT_CAPACITY;
+		}
+
+		for( uint32_t eventIndex = eventCount - newEventCount; eventIndex != eventCount; ++eventIndex )
+		{
+			const Event& rEvent = pThreadData->events[ eventIndex & ( THREAD_EVENT_CAPACITY - 1 ) ];
+
+			ZoneRecord& rZone = GetZoneRecord( rEvent.pName );
+			rZone.pendingTickCount += rEvent.endTickCount - rEvent.startTickCount;
+			++rZone.pendingCallCount;
+		}
+
+		pThreadData->statsEventCount = eventCount;
+	}
+
+	// Store the frame totals in the rolling window.
+	float64_t millisecondsPerTick = Timer::GetSecondsPerTick() * 1000.0;
+
+	size_t zoneCount = m_zones.GetSize();
+	for( size_t zoneIndex = 0; zoneIndex < zoneCount; ++zoneIndex )
+	{
+		ZoneRecord& rZone = m_zones[ zoneIndex ];
+		rZone.frameMilliseconds[ m_statsFrameIndex ] =
+			static_cast< float32_t >( static_cast< float64_t >( rZone.pendingTickCount ) * millisecondsPerTick );
+		rZone.lastCallCount = rZone.pendingCallCount;
+
+		rZone.pendingTickCount = 0;
+		rZone.pendingCallCount = 0;
+	}
+
+	m_statsFrameIndex = ( m_statsFrameIndex + 1 ) % STATS_FRAME_COUNT;
+	if( m_statsFrameCount < STATS_FRAME_COUNT )
+	{
+		++m_statsFrameCount;
+	}
+}
+
+/// Get the rolling statistics for each zone recorded so far.
+///
+/// @param[out] rStats  Statistics for each zone, in order of first use.
+///
+/// @see EndFrame()
+void FrameProfiler::GetZoneStats( DynamicArray< ZoneStats >& rStats ) const
+{
+	rStats.Resize( 0 );
+
+	if( m_statsFrameCount == 0 )
+	{
+		return;
+	}
+
+	size_t lastFrameIndex = ( m_statsFrameIndex + STATS_FRAME_COUNT - 1 ) % STATS_FRAME_COUNT;
+
+	size_t zoneCount = m_zones.GetSize();
+	rStats.Reserve( zoneCount );
+	for( size_t zoneIndex = 0; zoneIndex < zoneCount; ++zoneIndex )
+	{
+		const ZoneRecord& rZone = m_zones[ zoneIndex ];
+
+		// Frames recorded before the zone was first used are still zero-filled, so they can be included.
+		float32_t totalMilliseconds = 0.0f;
+		float32_t maxMilliseconds = 0.0f;
+		for( size_t frameIndex = 0; frameIndex < m_statsFrameCount; ++frameIndex )
+		{
+			float32_t milliseconds = rZone.frameMilliseconds[ frameIndex ];
+			totalMilliseconds += milliseconds;
+			maxMilliseconds = Max( maxMilliseconds, milliseconds );
+		}
+
+		ZoneStats* pStats = rStats.New();
+		HELIUM_ASSERT( pStats );
+		pStats->pName = rZone.pName;
+		pStats->lastMilliseconds = rZone.frameMilliseconds[ lastFrameIndex ];
+		pStats->averageMilliseconds = totalMilliseconds / static_cast< float32_t >( m_statsFrameCount );
+		pStats->maxMilliseconds = maxMilliseconds;
+		pStats->lastCallCount = rZone.lastCallCount;
+	}
+}
+
+/// Write the most recent zones recorded by each thread to a file in the Chrome trace event JSON format.
+///
+/// Each zone is written as a complete ("X") event, with timestamps relative to the profiler's initialization.
+/// Threads may keep recording while the trace is written; any events they overwrite during the export are dropped.
+///
+/// @param[in] rFileName  Name of the file to write.
+///
+/// @return  True if the trace was written successfully, false if not.
+bool FrameProfiler::WriteChromeTrace( const String& rFileName )
+{
+	FileStream* pFileStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"FrameProfiler::WriteChromeTrace(): Failed to open \"%s\" for writing.\n",
+			*rFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	DynamicArray< ThreadData* > threads;
+	{
+		Locker< DynamicArray< ThreadData* >, SpinLock >::Handle handle( m_threads );
+		threads = *handle;
+	}
+
+	String json( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" );
+	bool bFirstEvent = true;
+
+	DynamicArray< Event > events;
+	String eventJson;
+
+	size_t threadCount = threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		const ThreadData* pThreadData = threads[ threadIndex ];
+		HELIUM_ASSERT( pThreadData );
+
+		// Name the thread.
+		String threadName;
+		if( pThreadData->pName )
+		{
+			threadName = pThreadData->pName;
+		}
+		else
+		{
+			threadName.Format( "Thread %" PRIu32, pThreadData->threadIndex );
+		}
+
+		eventJson.Format(
+			"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%" PRIu32 ",\"args\":{\"name\":",
+			( bFirstEvent ? "" : "," ),
+			pThreadData->threadIndex );
+		json += eventJson;
+		AppendJsonString( *threadName, json );
+		json += "}}";
+		bFirstEvent = false;
+
+		// Copy the events currently in the ring buffer, then drop any that may have been overwritten while copying.
+		uint32_t eventCount = static_cast< uint32_t >( pThreadData->eventCount );
+		uint32_t copyCount = ( eventCount < THREAD_EVENT_CAPACITY ? eventCount : THREAD_EVENT_CAPACITY );
+
+		events.Resize( 0 );
+		events.Reserve( copyCount );
+		for( uint32_t eventIndex = eventCount - copyCount; eventIndex != eventCount; ++eventIndex )
+		{
+			events.Push( pThreadData->events[ eventIndex & ( THREAD_EVENT_CAPACITY - 1 ) ] );
+		}
+
+		uint32_t overwrittenCount = static_cast< uint32_t >( pThreadData->eventCount ) - eventCount;
+		size_t firstEventIndex = Min( static_cast< size_t >( overwrittenCount ), events.GetSize() );
+
+		size_t copiedEventCount = events.GetSize();
+		for( size_t eventIndex = firstEventIndex; eventIndex < copiedEventCount; ++eventIndex )
+		{
+			const Event& rEvent = events[ eventIndex ];
+			HELIUM_ASSERT( rEvent.pName );
+
+			eventJson.Format(
+				",{\"ph\":\"X\",\"pid\":0,\"tid\":%" PRIu32 ",\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+				pThreadData->threadIndex,
+				TicksToMicroseconds( rEvent.startTickCount - m_baseTickCount ),
+				TicksToMicroseconds( rEvent.endTickCount - rEvent.startTickCount ) );
+			json += eventJson;
+			AppendJsonString( rEvent.pName, json );
+			json += '}';
+		}
+
+		// Flush the text for each thread to keep the string from growing too large.
+		pBufferedStream->Write( *json, sizeof( char ), json.GetSize() );
+		json.Clear();
+	}
+
+	json += "]}\n";
+	pBufferedStream->Write( *json, sizeof( char ), json.GetSize() );
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	HELIUM_TRACE( TraceLevels::Info, "FrameProfiler: Wrote trace to \"%s\".\n", *rFileName );
+
+	return true;
+}
+
+/// Get the singleton FrameProfiler instance.
+///
+/// @return  Pointer to the FrameProfiler instance, or null if it has not been started.
+///
+/// @see Startup(), Shutdown()
+FrameProfiler* FrameProfiler::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton FrameProfiler instance.
+///
+/// @see Shutdown(), GetInstance()
+void FrameProfiler::Startup()
+{
+	if( ++g_InitCount == 1 )
+	{
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new FrameProfiler;
+		HELIUM_ASSERT( sm_pInstance );
+		HELIUM_VERIFY( sm_pInstance->Initialize() );
+	}
+}
+
+/// Destroy the singleton FrameProfiler instance.
+///
+/// @see Startup(), GetInstance()
+void FrameProfiler::Shutdown()
+{
+	if( --g_InitCount == 0 )
+	{
+		HELIUM_ASSERT( sm_pInstance );
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Get the profiling data for the calling thread, allocating and registering it on first use.
+///
+/// @return  Profiling data for the calling thread.
+FrameProfiler::ThreadData* FrameProfiler::GetThreadData()
+{
+	ThreadData* pThreadData = static_cast< ThreadData* >( m_threadData.GetPointer() );
+	if( !pThreadData )
+	{
+		pThreadData = new ThreadData;
+		HELIUM_ASSERT( pThreadData );
+		pThreadData->eventCount = 0;
+		pThreadData->statsEventCount = 0;
+		pThreadData->pName = NULL;
+
+		{
+			Locker< DynamicArray< ThreadData* >, SpinLock >::Handle handle( m_threads );
+			pThreadData->threadIndex = static_cast< uint32_t >( handle->GetSize() );
+			handle->Push( pThreadData );
+		}
+
+		m_threadData.SetPointer( pThreadData );
+	}
+
+	return pThreadData;
+}
+
+/// Get the statistics record for a zone, adding a new record on first use.
+///
+/// @param[in] pName  Zone name.
+///
+/// @return  Zone statistics record.
+FrameProfiler::ZoneRecord& FrameProfiler::GetZoneRecord( const char* pName )
+{
+	HELIUM_ASSERT( pName );
+
+	uint64_t key = static_cast< uint64_t >( reinterpret_cast< uintptr_t >( pName ) );
+
+	HashMap< uint64_t, size_t >::Iterator zoneIterator = m_zoneMap.Find( key );
+	if( zoneIterator == m_zoneMap.End() )
+	{
+		size_t zoneIndex = m_zones.GetSize();
+		ZoneRecord* pZone = m_zones.New();
+		HELIUM_ASSERT( pZone );
+		MemoryZero( pZone, sizeof( *pZone ) );
+		pZone->pName = pName;
+
+		HELIUM_VERIFY( m_zoneMap.Insert( zoneIterator, HashMap< uint64_t, size_t >::ValueType( key, zoneIndex ) ) );
+	}
+
+	return m_zones[ zoneIterator->Second() ];
+}
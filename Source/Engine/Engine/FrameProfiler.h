@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+#include "Platform/Timer.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/String.h"
+
+#include "Engine/Engine.h"
+
+/// Non-zero if frame profiler zones should be compiled in.
+#ifndef HELIUM_FRAME_PROFILER
+# if !HELIUM_RELEASE || HELIUM_PROFILE
+#  define HELIUM_FRAME_PROFILER 1
+# else
+#  define HELIUM_FRAME_PROFILER 0
+# endif
+#endif
+
+namespace Helium
+{
+	/// Hierarchical CPU frame profiler.
+	///
+	/// Code is instrumented with scoped zones (see HELIUM_FRAME_ZONE()).  Each completed zone is recorded as a single
+	/// event in a fixed-size ring buffer owned by the calling thread, so recording never locks or allocates once a
+	/// thread has recorded its first zone.  Zones nest by scope, and the hierarchy is recovered from the event times.
+	///
+	/// The most recent events of each thread can be exported in the Chrome trace event JSON format (viewable in
+	/// chrome://tracing or Perfetto) with WriteChromeTrace().  EndFrame() also folds each frame's events into rolling
+	/// per-zone statistics, which are available in-process through GetZoneStats().
+	///
+	/// Zones can be recorded from any thread.  All other functions should only be called from the main thread.
+	class HELIUM_ENGINE_API FrameProfiler : NonCopyable
+	{
+	public:
+		/// Number of events held in each thread's ring buffer (must be a power of two).
+		static const uint32_t THREAD_EVENT_CAPACITY = 8192;
+		/// Number of frames over which rolling zone statistics are computed.
+		static const size_t STATS_FRAME_COUNT = 64;
+
+		/// Rolling statistics for a single zone.
+		struct ZoneStats
+		{
+			/// Zone name.
+			const char* pName;
+			/// Inclusive time spent in the zone during the last frame, in milliseconds.
+			float32_t lastMilliseconds;
+			/// Average inclusive time spent in the zone per frame over the rolling window, in milliseconds.
+			float32_t averageMilliseconds;
+			/// Largest inclusive time spent in the zone during any frame of the rolling window, in milliseconds.
+			float32_t maxMilliseconds;
+			/// Number of times the zone was entered during the last frame.
+			uint32_t lastCallCount;
+		};
+
+		/// Scoped profiler zone.
+		class Zone : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			inline explicit Zone( const char* pName );
+			inline ~Zone();
+			//@}
+
+		private:
+			/// Zone name (null if the profiler was not active when the zone was entered).
+			const char* m_pName;
+			/// Timer tick count when the zone was entered.
+			uint64_t m_startTickCount;
+		};
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Event Recording
+		//@{
+		inline bool IsEnabled() const;
+		void SetEnabled( bool bEnabled );
+
+		void SetThreadName( const char* pName );
+
+		void RecordZone( const char* pName, uint64_t startTickCount, uint64_t endTickCount );
+		//@}
+
+		/// @name Statistics
+		//@{
+		void EndFrame();
+
+		void GetZoneStats( DynamicArray< ZoneStats >& rStats ) const;
+		//@}
+
+		/// @name Export
+		//@{
+		bool WriteChromeTrace( const String& rFileName );
+		//@}
+
+		/// @name Static Access
+		//@{
+		static FrameProfiler* GetInstance();
+		static void Startup();
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Completed zone event.
+		struct Event
+		{
+			/// Zone name.
+			const char* pName;
+			/// Timer tick count when the zone was entered.
+			uint64_t startTickCount;
+			/// Timer tick count when the zone was exited.
+			uint64_t endTickCount;
+		};
+
+		/// Event ring buffer and other profiling data for a single thread.
+		struct ThreadData
+		{
+			/// Most recent events, indexed by the event count modulo THREAD_EVENT_CAPACITY.
+			Event events[ THREAD_EVENT_CAPACITY ];
+			/// Number of events recorded by the thread (wraps around, only written by the owning thread).
+			volatile int32_t eventCount;
+			/// Number of events already folded into the zone statistics.
+			uint32_t statsEventCount;
+
+			/// Thread name (null if not set).
+			const char* pName;
+			/// Thread index, in order of registration.
+			uint32_t threadIndex;
+		};
+
+		/// Rolling statistics data for a single zone.
+		struct ZoneRecord
+		{
+			/// Zone name.
+			const char* pName;
+			/// Inclusive time spent in the zone during each frame of the rolling window, in milliseconds.
+			float32_t frameMilliseconds[ STATS_FRAME_COUNT ];
+			/// Number of times the zone was entered during the last frame.
+			uint32_t lastCallCount;
+
+			/// Inclusive time accumulated for the frame being processed, in timer ticks.
+			uint64_t pendingTickCount;
+			/// Number of times the zone was entered during the frame being processed.
+			uint32_t pendingCallCount;
+		};
+
+		/// Profiling data for each thread that has recorded zones.
+		Locker< DynamicArray< ThreadData* >, SpinLock > m_threads;
+		/// Profiling data for the current thread.
+		ThreadLocalPointer m_threadData;
+
+		/// Statistics for each zone, in order of first use.
+		DynamicArray< ZoneRecord > m_zones;
+		/// Zone record indices, keyed by zone name address.
+		HashMap< uint64_t, size_t > m_zoneMap;
+		/// Index of the rolling statistics frame slot to fill next.
+		size_t m_statsFrameIndex;
+		/// Number of frames held in the rolling statistics window.
+		size_t m_statsFrameCount;
+
+		/// Timer tick count when the profiler was initialized (used as the origin for exported timestamps).
+		uint64_t m_baseTickCount;
+		/// True if zones are currently being recorded.
+		volatile bool m_bEnabled;
+
+		/// Singleton instance.
+		static FrameProfiler* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		FrameProfiler();
+		~FrameProfiler();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		ThreadData* GetThreadData();
+		ZoneRecord& GetZoneRecord( const char* pName );
+		//@}
+	};
+}
+
+#include "Engine/FrameProfiler.inl"
+
+#if HELIUM_FRAME_PROFILER
+# define HELIUM_FRAME_ZONE_CONCAT_INNER( A, B ) A##B
+# define HELIUM_FRAME_ZONE_CONCAT( A, B ) HELIUM_FRAME_ZONE_CONCAT_INNER( A, B )
+/// Profile the remainder of the current scope as a frame profiler zone.  The name must be a string with static
+/// storage duration (such as a string literal), as only its address is recorded.
+# define HELIUM_FRAME_ZONE( NAME ) \
+	Helium::FrameProfiler::Zone HELIUM_FRAME_ZONE_CONCAT( frameProfilerZone, __LINE__ )( NAME )
+#else
+# define HELIUM_FRAME_ZONE( NAME )
+#endif
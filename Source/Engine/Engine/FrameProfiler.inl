@@ -0,0 +1,41 @@
+/// Constructor.
+///
+/// @param[in] pName  Zone name.  This must remain valid for the lifetime of the profiler.
+Helium::FrameProfiler::Zone::Zone( const char* pName )
+	: m_pName( NULL )
+	, m_startTickCount( 0 )
+{
+	HELIUM_ASSERT( pName );
+
+	FrameProfiler* pProfiler = FrameProfiler::GetInstance();
+	if( pProfiler && pProfiler->IsEnabled() )
+	{
+		m_pName = pName;
+		m_startTickCount = Timer::GetTickCount();
+	}
+}
+
+/// Destructor.
+Helium::FrameProfiler::Zone::~Zone()
+{
+	if( m_pName )
+	{
+		uint64_t endTickCount = Timer::GetTickCount();
+
+		FrameProfiler* pProfiler = FrameProfiler::GetInstance();
+		if( pProfiler )
+		{
+			pProfiler->RecordZone( m_pName, m_startTickCount, endTickCount );
+		}
+	}
+}
+
+/// Get whether zones are currently being recorded.
+///
+/// @return  True if zones are being recorded, false if not.
+///
+/// @see SetEnabled()
+bool Helium::FrameProfiler::IsEnabled() const
+{
+	return m_bEnabled;
+}
@@ -0,0 +1,46 @@
+#include "Precompile.h"
+#include "Engine/MemoryConfig.h"
+
+#include "Reflect/TranslatorDeduction.h"
+
+using namespace Helium;
+
+//////////////////////////////////////////////////////////////////////////
+// MemoryBudgetConfig
+
+HELIUM_DEFINE_BASE_STRUCT( MemoryBudgetConfig );
+
+/// Constructor.
+MemoryBudgetConfig::MemoryBudgetConfig()
+	: m_BudgetMegabytes( 0 )
+{
+}
+
+void MemoryBudgetConfig::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &MemoryBudgetConfig::m_TagName, "m_TagName" );
+	comp.AddField( &MemoryBudgetConfig::m_BudgetMegabytes, "m_BudgetMegabytes" );
+}
+
+bool MemoryBudgetConfig::operator==( const MemoryBudgetConfig& _rhs ) const
+{
+	return (
+		m_TagName == _rhs.m_TagName &&
+		m_BudgetMegabytes == _rhs.m_BudgetMegabytes
+		);
+}
+
+bool MemoryBudgetConfig::operator!=( const MemoryBudgetConfig& _rhs ) const
+{
+	return !( *this == _rhs );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// MemoryConfig
+
+HELIUM_DEFINE_CLASS( Helium::MemoryConfig );
+
+void MemoryConfig::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &MemoryConfig::m_Budgets, "m_Budgets" );
+}
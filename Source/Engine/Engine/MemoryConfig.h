@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Engine/Engine.h"
+#include "Reflect/Object.h"
+
+namespace Helium
+{
+	/// Memory budget for a single memory tracker tag.
+	struct HELIUM_ENGINE_API MemoryBudgetConfig : public Reflect::Struct
+	{
+		HELIUM_DECLARE_BASE_STRUCT( MemoryBudgetConfig );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		/// Tag name (as returned by MemoryTracker::GetTagName()).
+		Name m_TagName;
+		/// Budget, in megabytes (zero for no budget).
+		uint32_t m_BudgetMegabytes;
+
+		MemoryBudgetConfig();
+
+		bool operator==( const MemoryBudgetConfig& _rhs ) const;
+		bool operator!=( const MemoryBudgetConfig& _rhs ) const;
+	};
+
+	/// Memory tracking configuration data.
+	class HELIUM_ENGINE_API MemoryConfig : public Reflect::Object
+	{
+		HELIUM_DECLARE_CLASS( Helium::MemoryConfig, Reflect::Object );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		/// Memory budgets for individual tags (tags without an entry have no budget).
+		DynamicArray< MemoryBudgetConfig > m_Budgets;
+	};
+}
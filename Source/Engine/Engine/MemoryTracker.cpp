@@ -0,0 +1,411 @@
+#include "Precompile.h"
+#include "Engine/MemoryTracker.h"
+
+#include "Foundation/FileStream.h"
+#include "Engine/Config.h"
+#include "Engine/MemoryConfig.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+MemoryTracker* MemoryTracker::sm_pInstance = NULL;
+
+/// Convert a byte count to kilobytes for display.
+///
+/// @param[in] size  Size, in bytes.
+///
+/// @return  Size, in kilobytes.
+static float64_t BytesToKilobytes( size_t size )
+{
+	return static_cast< float64_t >( size ) / 1024.0;
+}
+
+/// Constructor.
+MemoryTracker::MemoryTracker()
+{
+	MemoryZero( m_tags, sizeof( m_tags ) );
+}
+
+/// Destructor.
+MemoryTracker::~MemoryTracker()
+{
+	Cleanup();
+}
+
+/// Initialize this memory tracker.
+///
+/// @return  True if initialization was successful, false if not.
+///
+/// @see Cleanup()
+bool MemoryTracker::Initialize()
+{
+	Cleanup();
+
+	return true;
+}
+
+/// Reset all accounting data and budgets.
+///
+/// @see Initialize()
+void MemoryTracker::Cleanup()
+{
+	MutexScopeLock scopeLock( m_lock );
+	MemoryZero( m_tags, sizeof( m_tags ) );
+}
+
+/// Apply the tag budgets specified in the MemoryConfig configuration object.
+///
+/// This should be called once the configuration has been loaded.  Tags without a configured budget (or all tags, if
+/// no MemoryConfig exists) are left without a budget.
+void MemoryTracker::ApplyConfig()
+{
+	Config* pConfig = Config::GetInstance();
+	if( !pConfig )
+	{
+		return;
+	}
+
+	MemoryConfig* pMemoryConfig = pConfig->GetConfigObject< MemoryConfig >( Name( "MemoryConfig" ) );
+	if( !pMemoryConfig )
+	{
+		return;
+	}
+
+	size_t budgetCount = pMemoryConfig->m_Budgets.GetSize();
+	for( size_t budgetIndex = 0; budgetIndex < budgetCount; ++budgetIndex )
+	{
+		const MemoryBudgetConfig& rBudget = pMemoryConfig->m_Budgets[ budgetIndex ];
+
+		EMemoryTag tag = MEMORY_TAG_INVALID;
+		for( size_t tagIndex = 0; tagIndex < MEMORY_TAG_MAX; ++tagIndex )
+		{
+			if( rBudget.m_TagName == Name( GetTagName( static_cast< EMemoryTag >( tagIndex ) ) ) )
+			{
+				tag = static_cast< EMemoryTag >( tagIndex );
+				break;
+			}
+		}
+
+		if( tag == MEMORY_TAG_INVALID )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"MemoryTracker::ApplyConfig(): MemoryConfig specifies a budget for unknown memory tag \"%s\".\n",
+				*rBudget.m_TagName );
+
+			continue;
+		}
+
+		SetBudget( tag, static_cast< size_t >( rBudget.m_BudgetMegabytes ) * 1024 * 1024 );
+	}
+}
+
+/// Record an allocation.
+///
+/// @param[in] tag   Tag to which the allocation should be attributed.
+/// @param[in] size  Allocation size, in bytes.
+///
+/// @see RecordFree()
+void MemoryTracker::RecordAllocation( EMemoryTag tag, size_t size )
+{
+	HELIUM_ASSERT( static_cast< size_t >( tag ) < static_cast< size_t >( MEMORY_TAG_MAX ) );
+
+	size_t currentSize = 0;
+	size_t budget = 0;
+	bool bExceededBudget = false;
+
+	{
+		MutexScopeLock scopeLock( m_lock );
+
+		TagData& rTag = m_tags[ tag ];
+		rTag.currentSize += size;
+		if( rTag.currentSize > rTag.peakSize )
+		{
+			rTag.peakSize = rTag.currentSize;
+		}
+
+		++rTag.allocationCount;
+		++rTag.frameAllocationCount;
+
+		if( rTag.budget != 0 && rTag.currentSize > rTag.budget && !rTag.bOverBudget )
+		{
+			rTag.bOverBudget = true;
+
+			currentSize = rTag.currentSize;
+			budget = rTag.budget;
+			bExceededBudget = true;
+		}
+	}
+
+	// Log outside the lock, as tracing may itself allocate.
+	if( bExceededBudget )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"MemoryTracker: \"%s\" memory usage (%.1f KB) exceeded its budget (%.1f KB).\n",
+			GetTagName( tag ),
+			BytesToKilobytes( currentSize ),
+			BytesToKilobytes( budget ) );
+	}
+}
+
+/// Record a free of a previously recorded allocation.
+///
+/// @param[in] tag   Tag to which the allocation was attributed.
+/// @param[in] size  Allocation size, in bytes.
+///
+/// @see RecordAllocation()
+void MemoryTracker::RecordFree( EMemoryTag tag, size_t size )
+{
+	HELIUM_ASSERT( static_cast< size_t >( tag ) < static_cast< size_t >( MEMORY_TAG_MAX ) );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	// Allocations made before the tracker was started were never recorded, so don't let their frees underflow.
+	TagData& rTag = m_tags[ tag ];
+	rTag.currentSize = ( rTag.currentSize >= size ? rTag.currentSize - size : 0 );
+
+	if( rTag.bOverBudget && rTag.currentSize <= rTag.budget )
+	{
+		rTag.bOverBudget = false;
+	}
+}
+
+/// Get the tag of the innermost memory tracker scope active on the current thread.
+///
+/// @param[in] defaultTag  Tag to return if no scope is active.
+///
+/// @return  Current scope tag, or the given default if no scope is active.
+///
+/// @see SetScopeTag()
+EMemoryTag MemoryTracker::GetScopeTag( EMemoryTag defaultTag ) const
+{
+	uintptr_t scopeTag = reinterpret_cast< uintptr_t >( m_scopeTag.GetPointer() );
+
+	return ( scopeTag != 0 ? static_cast< EMemoryTag >( scopeTag - 1 ) : defaultTag );
+}
+
+/// Set the memory tracker scope tag for the current thread.
+///
+/// This is normally only called by Scope instances (see HELIUM_MEMORY_SCOPE()).
+///
+/// @param[in] tag  Scope tag, or MEMORY_TAG_INVALID to clear the scope.
+///
+/// @see GetScopeTag()
+void MemoryTracker::SetScopeTag( EMemoryTag tag )
+{
+	uintptr_t scopeTag = ( tag != MEMORY_TAG_INVALID ? static_cast< uintptr_t >( tag ) + 1 : 0 );
+	m_scopeTag.SetPointer( reinterpret_cast< void* >( scopeTag ) );
+}
+
+/// Set the budget for a tag.
+///
+/// @param[in] tag     Memory tag.
+/// @param[in] budget  Budget, in bytes (zero for no budget).
+///
+/// @see GetBudget(), ApplyConfig()
+void MemoryTracker::SetBudget( EMemoryTag tag, size_t budget )
+{
+	HELIUM_ASSERT( static_cast< size_t >( tag ) < static_cast< size_t >( MEMORY_TAG_MAX ) );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	TagData& rTag = m_tags[ tag ];
+	rTag.budget = budget;
+	rTag.bOverBudget = false;
+}
+
+/// Get the budget for a tag.
+///
+/// @param[in] tag  Memory tag.
+///
+/// @return  Budget, in bytes (zero if the tag has no budget).
+///
+/// @see SetBudget()
+size_t MemoryTracker::GetBudget( EMemoryTag tag ) const
+{
+	HELIUM_ASSERT( static_cast< size_t >( tag ) < static_cast< size_t >( MEMORY_TAG_MAX ) );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	return m_tags[ tag ].budget;
+}
+
+/// Finish accounting for the current frame.
+///
+/// This should be called once per frame, after all frame updates have completed.
+void MemoryTracker::EndFrame()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	for( size_t tagIndex = 0; tagIndex < MEMORY_TAG_MAX; ++tagIndex )
+	{
+		TagData& rTag = m_tags[ tagIndex ];
+		rTag.lastFrameAllocationCount = rTag.frameAllocationCount;
+		if( rTag.frameAllocationCount > rTag.peakFrameAllocationCount )
+		{
+			rTag.peakFrameAllocationCount = rTag.frameAllocationCount;
+		}
+
+		rTag.frameAllocationCount = 0;
+	}
+}
+
+/// Get the current memory statistics for a tag.
+///
+/// @param[in]  tag     Memory tag.
+/// @param[out] rStats  Tag statistics.
+void MemoryTracker::GetTagStats( EMemoryTag tag, TagStats& rStats ) const
+{
+	HELIUM_ASSERT( static_cast< size_t >( tag ) < static_cast< size_t >( MEMORY_TAG_MAX ) );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	const TagData& rTag = m_tags[ tag ];
+	rStats.pName = GetTagName( tag );
+	rStats.currentSize = rTag.currentSize;
+	rStats.peakSize = rTag.peakSize;
+	rStats.budget = rTag.budget;
+	rStats.allocationCount = rTag.allocationCount;
+	rStats.lastFrameAllocationCount = rTag.lastFrameAllocationCount;
+	rStats.peakFrameAllocationCount = rTag.peakFrameAllocationCount;
+}
+
+/// Write a text report of the current memory statistics for all tags to a file.
+///
+/// @param[in] rFileName  Path of the file to write.
+///
+/// @return  True if the report was written successfully, false if not.
+bool MemoryTracker::WriteReport( const String& rFileName ) const
+{
+	FileStream* pFileStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"MemoryTracker::WriteReport(): Failed to open \"%s\" for writing.\n",
+			*rFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	String report(
+		"Tag              Current (KB)     Peak (KB)   Budget (KB)   Allocations  Last frame  Peak frame\n" );
+	String line;
+
+	size_t totalCurrentSize = 0;
+	size_t totalPeakSize = 0;
+
+	TagStats stats;
+	for( size_t tagIndex = 0; tagIndex < MEMORY_TAG_MAX; ++tagIndex )
+	{
+		GetTagStats( static_cast< EMemoryTag >( tagIndex ), stats );
+
+		String budget( "-" );
+		if( stats.budget != 0 )
+		{
+			budget.Format( "%.1f%s", BytesToKilobytes( stats.budget ), ( stats.currentSize > stats.budget ? "!" : "" ) );
+		}
+
+		line.Format(
+			"%-16s %12.1f  %12.1f  %12s  %12" PRIu64 "  %10" PRIu32 "  %10" PRIu32 "\n",
+			stats.pName,
+			BytesToKilobytes( stats.currentSize ),
+			BytesToKilobytes( stats.peakSize ),
+			*budget,
+			stats.allocationCount,
+			stats.lastFrameAllocationCount,
+			stats.peakFrameAllocationCount );
+		report += line;
+
+		totalCurrentSize += stats.currentSize;
+		totalPeakSize += stats.peakSize;
+	}
+
+	// Tag peaks may have been reached at different times, so the summed peak is only an upper bound.
+	line.Format(
+		"%-16s %12.1f  %12.1f\n",
+		"Total",
+		BytesToKilobytes( totalCurrentSize ),
+		BytesToKilobytes( totalPeakSize ) );
+	report += line;
+
+	pBufferedStream->Write( *report, sizeof( char ), report.GetSize() );
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	HELIUM_TRACE( TraceLevels::Info, "MemoryTracker: Wrote report to \"%s\".\n", *rFileName );
+
+	return true;
+}
+
+/// Get the display name of a memory tag.
+///
+/// Tag names are also used to identify tags in the MemoryConfig configuration object.
+///
+/// @param[in] tag  Memory tag.
+///
+/// @return  Tag name.
+const char* MemoryTracker::GetTagName( EMemoryTag tag )
+{
+	HELIUM_ASSERT( static_cast< size_t >( tag ) < static_cast< size_t >( MEMORY_TAG_MAX ) );
+
+	static const char* const TAG_NAMES[] =
+	{
+		"Components",     // MEMORY_TAG_COMPONENTS
+		"AssetLoader",    // MEMORY_TAG_ASSET_LOADER
+		"PackageLoader",  // MEMORY_TAG_PACKAGE_LOADER
+		"Cache",          // MEMORY_TAG_CACHE
+		"AsyncLoader",    // MEMORY_TAG_ASYNC_LOADER
+		"Renderer",       // MEMORY_TAG_RENDERER
+		"Mesh",           // MEMORY_TAG_MESH
+		"Texture2d",      // MEMORY_TAG_TEXTURE_2D
+		"Shader",         // MEMORY_TAG_SHADER
+		"Font"            // MEMORY_TAG_FONT
+	};
+
+	HELIUM_COMPILE_ASSERT( HELIUM_ARRAY_COUNT( TAG_NAMES ) == MEMORY_TAG_MAX );
+
+	return TAG_NAMES[ tag ];
+}
+
+/// Get the singleton MemoryTracker instance.
+///
+/// @return  Pointer to the MemoryTracker instance, or null if it has not been started.
+///
+/// @see Startup(), Shutdown()
+MemoryTracker* MemoryTracker::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton MemoryTracker instance.
+///
+/// @see Shutdown(), GetInstance()
+void MemoryTracker::Startup()
+{
+	if( ++g_InitCount == 1 )
+	{
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new MemoryTracker;
+		HELIUM_ASSERT( sm_pInstance );
+		HELIUM_VERIFY( sm_pInstance->Initialize() );
+	}
+}
+
+/// Destroy the singleton MemoryTracker instance.
+///
+/// @see Startup(), GetInstance()
+void MemoryTracker::Shutdown()
+{
+	if( --g_InitCount == 0 )
+	{
+		HELIUM_ASSERT( sm_pInstance );
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
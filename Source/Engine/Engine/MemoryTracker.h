@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Platform/Mutex.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/String.h"
+
+#include "Engine/Engine.h"
+
+/// Non-zero if memory tracking should be compiled in.
+#ifndef HELIUM_MEMORY_TRACKER
+# if !HELIUM_RELEASE || HELIUM_PROFILE
+#  define HELIUM_MEMORY_TRACKER 1
+# else
+#  define HELIUM_MEMORY_TRACKER 0
+# endif
+#endif
+
+namespace Helium
+{
+	/// Memory tracker tags.
+	enum EMemoryTag
+	{
+		MEMORY_TAG_FIRST   =  0,
+		MEMORY_TAG_INVALID = -1,
+
+		/// Component pools.
+		MEMORY_TAG_COMPONENTS,
+		/// Asset loader requests.
+		MEMORY_TAG_ASSET_LOADER,
+		/// Cache package loader requests and load buffers.
+		MEMORY_TAG_PACKAGE_LOADER,
+		/// Cache tables of contents and entries.
+		MEMORY_TAG_CACHE,
+		/// Async loader requests.
+		MEMORY_TAG_ASYNC_LOADER,
+		/// Render resources not created on behalf of a specific asset type.
+		MEMORY_TAG_RENDERER,
+		/// Mesh render resources.
+		MEMORY_TAG_MESH,
+		/// Texture render resources.
+		MEMORY_TAG_TEXTURE_2D,
+		/// Shader render resources.
+		MEMORY_TAG_SHADER,
+		/// Font render resources.
+		MEMORY_TAG_FONT,
+
+		MEMORY_TAG_MAX,
+		MEMORY_TAG_LAST = MEMORY_TAG_MAX - 1
+	};
+
+	/// Per-subsystem memory accounting.
+	///
+	/// Allocations are attributed to a fixed set of tags (see EMemoryTag), either explicitly by the allocating code
+	/// (see HELIUM_TRACK_ALLOCATION() and HELIUM_TRACK_FREE()) or, for render resources, through the innermost tag
+	/// scope active on the creating thread (see HELIUM_MEMORY_SCOPE()).  Each tag keeps its current and peak size along
+	/// with allocation counts for the last frame, and may be given a budget in the MemoryConfig configuration object.
+	/// A warning is logged whenever a tag's current size first exceeds its budget.
+	///
+	/// All functions can be called from any thread, except for EndFrame() and ApplyConfig(), which should only be
+	/// called from the main thread.
+	class HELIUM_ENGINE_API MemoryTracker : NonCopyable
+	{
+	public:
+		/// Memory statistics for a single tag.
+		struct TagStats
+		{
+			/// Tag name.
+			const char* pName;
+			/// Number of bytes currently allocated.
+			size_t currentSize;
+			/// Largest number of bytes allocated at any one time.
+			size_t peakSize;
+			/// Budget, in bytes (zero if the tag has no budget).
+			size_t budget;
+			/// Total number of allocations made.
+			uint64_t allocationCount;
+			/// Number of allocations made during the last frame.
+			uint32_t lastFrameAllocationCount;
+			/// Largest number of allocations made during any single frame.
+			uint32_t peakFrameAllocationCount;
+		};
+
+		/// Scoped tag override for render resources created on the current thread.
+		class Scope : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			inline explicit Scope( EMemoryTag tag );
+			inline ~Scope();
+			//@}
+
+		private:
+			/// Scope tag that was active when this scope was entered.
+			EMemoryTag m_previousTag;
+			/// True if the tracker was active when this scope was entered.
+			bool m_bActive;
+		};
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+
+		void ApplyConfig();
+		//@}
+
+		/// @name Allocation Tracking
+		//@{
+		void RecordAllocation( EMemoryTag tag, size_t size );
+		void RecordFree( EMemoryTag tag, size_t size );
+
+		EMemoryTag GetScopeTag( EMemoryTag defaultTag ) const;
+		void SetScopeTag( EMemoryTag tag );
+		//@}
+
+		/// @name Budgets
+		//@{
+		void SetBudget( EMemoryTag tag, size_t budget );
+		size_t GetBudget( EMemoryTag tag ) const;
+		//@}
+
+		/// @name Statistics
+		//@{
+		void EndFrame();
+
+		void GetTagStats( EMemoryTag tag, TagStats& rStats ) const;
+		//@}
+
+		/// @name Export
+		//@{
+		bool WriteReport( const String& rFileName ) const;
+		//@}
+
+		/// @name Tag Information
+		//@{
+		static const char* GetTagName( EMemoryTag tag );
+		//@}
+
+		/// @name Static Access
+		//@{
+		inline static void TrackAllocation( EMemoryTag tag, size_t size );
+		inline static void TrackFree( EMemoryTag tag, size_t size );
+
+		static MemoryTracker* GetInstance();
+		static void Startup();
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Memory accounting data for a single tag.
+		struct TagData
+		{
+			/// Number of bytes currently allocated.
+			size_t currentSize;
+			/// Largest number of bytes allocated at any one time.
+			size_t peakSize;
+			/// Budget, in bytes (zero if the tag has no budget).
+			size_t budget;
+			/// Total number of allocations made.
+			uint64_t allocationCount;
+			/// Number of allocations made during the current frame.
+			uint32_t frameAllocationCount;
+			/// Number of allocations made during the last frame.
+			uint32_t lastFrameAllocationCount;
+			/// Largest number of allocations made during any single frame.
+			uint32_t peakFrameAllocationCount;
+			/// True if the budget has been exceeded and not yet returned to.
+			bool bOverBudget;
+		};
+
+		/// Accounting data for each tag.
+		TagData m_tags[ MEMORY_TAG_MAX ];
+		/// Lock for synchronizing access to the tag data.
+		mutable Mutex m_lock;
+		/// Tag of the innermost scope active on the current thread, offset by one (null if no scope is active).
+		ThreadLocalPointer m_scopeTag;
+
+		/// Singleton instance.
+		static MemoryTracker* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		MemoryTracker();
+		~MemoryTracker();
+		//@}
+	};
+}
+
+#include "Engine/MemoryTracker.inl"
+
+#if HELIUM_MEMORY_TRACKER
+# define HELIUM_MEMORY_SCOPE_CONCAT_INNER( A, B ) A##B
+# define HELIUM_MEMORY_SCOPE_CONCAT( A, B ) HELIUM_MEMORY_SCOPE_CONCAT_INNER( A, B )
+/// Attribute render resources created during the remainder of the current scope to the given memory tag.
+# define HELIUM_MEMORY_SCOPE( TAG ) \
+	Helium::MemoryTracker::Scope HELIUM_MEMORY_SCOPE_CONCAT( memoryTrackerScope, __LINE__ )( TAG )
+/// Record an allocation of the given size against a memory tag.
+# define HELIUM_TRACK_ALLOCATION( TAG, SIZE ) Helium::MemoryTracker::TrackAllocation( TAG, SIZE )
+/// Record a free of the given size against a memory tag.
+# define HELIUM_TRACK_FREE( TAG, SIZE ) Helium::MemoryTracker::TrackFree( TAG, SIZE )
+#else
+# define HELIUM_MEMORY_SCOPE( TAG )
+# define HELIUM_TRACK_ALLOCATION( TAG, SIZE )
+# define HELIUM_TRACK_FREE( TAG, SIZE )
+#endif
@@ -0,0 +1,60 @@
+/// Constructor.
+///
+/// @param[in] tag  Tag to which render resources created within this scope should be attributed.
+Helium::MemoryTracker::Scope::Scope( EMemoryTag tag )
+	: m_previousTag( MEMORY_TAG_INVALID )
+	, m_bActive( false )
+{
+	HELIUM_ASSERT( static_cast< size_t >( tag ) < static_cast< size_t >( MEMORY_TAG_MAX ) );
+
+	MemoryTracker* pTracker = MemoryTracker::GetInstance();
+	if( pTracker )
+	{
+		m_previousTag = pTracker->GetScopeTag( MEMORY_TAG_INVALID );
+		pTracker->SetScopeTag( tag );
+		m_bActive = true;
+	}
+}
+
+/// Destructor.
+Helium::MemoryTracker::Scope::~Scope()
+{
+	if( m_bActive )
+	{
+		MemoryTracker* pTracker = MemoryTracker::GetInstance();
+		if( pTracker )
+		{
+			pTracker->SetScopeTag( m_previousTag );
+		}
+	}
+}
+
+/// Record an allocation with the singleton memory tracker instance, if it exists.
+///
+/// @param[in] tag   Tag to which the allocation should be attributed.
+/// @param[in] size  Allocation size, in bytes.
+///
+/// @see TrackFree(), RecordAllocation()
+void Helium::MemoryTracker::TrackAllocation( EMemoryTag tag, size_t size )
+{
+	MemoryTracker* pTracker = MemoryTracker::GetInstance();
+	if( pTracker )
+	{
+		pTracker->RecordAllocation( tag, size );
+	}
+}
+
+/// Record a free with the singleton memory tracker instance, if it exists.
+///
+/// @param[in] tag   Tag to which the allocation was attributed.
+/// @param[in] size  Allocation size, in bytes.
+///
+/// @see TrackAllocation(), RecordFree()
+void Helium::MemoryTracker::TrackFree( EMemoryTag tag, size_t size )
+{
+	MemoryTracker* pTracker = MemoryTracker::GetInstance();
+	if( pTracker )
+	{
+		pTracker->RecordFree( tag, size );
+	}
+}
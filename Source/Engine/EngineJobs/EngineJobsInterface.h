@@ -54,6 +54,62 @@ private:
     Parameters m_parameters;
 };
 
+/// Parallel least-significant-digit radix sort of 64-bit keys.
+///
+/// Keys are sorted in ascending order, eight bits at a time.  Each pass builds per-job digit histograms and scatters
+/// keys in parallel using the JobManager, and passes in which all keys share the same digit are skipped entirely.
+class HELIUM_ENGINE_JOBS_API RadixSortJob : Helium::NonCopyable
+{
+public:
+    /// Number of key bits sorted in each pass.
+    static const uint32_t DIGIT_BIT_COUNT = 8;
+    /// Number of distinct values for each digit.
+    static const size_t DIGIT_VALUE_COUNT = 1 << DIGIT_BIT_COUNT;
+
+    class Parameters
+    {
+    public:
+        /// [inout] Keys to sort.
+        uint64_t* pKeys;
+        /// [in] Scratch buffer with space for at least as many keys as are being sorted.
+        uint64_t* pScratch;
+        /// [in] Number of keys to sort.
+        size_t count;
+        /// [in] Lowest key bit that affects the sort order (must be a multiple of DIGIT_BIT_COUNT).  Bits below this
+        ///      are not sorted and do not need to preserve their relative order.
+        uint32_t startBit;
+        /// [in] Minimum number of keys to assign to each parallel job.
+        size_t singleJobCount;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline RadixSortJob();
+    inline ~RadixSortJob();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run();
+    inline static void RunCallback( void* pJob );
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
 }  // namespace Helium
 
 #include "EngineJobs/EngineJobsInterface.inl"
@@ -0,0 +1,296 @@
+#include "Precompile.h"
+#include "EngineJobs/JobManager.h"
+
+#include "Engine/FrameProfiler.h"
+
+#include <thread>
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+JobManager* JobManager::sm_pInstance = NULL;
+
+/// Constructor.
+JobManager::JobManager()
+{
+}
+
+/// Destructor.
+JobManager::~JobManager()
+{
+    Cleanup();
+}
+
+/// Initialize the job manager and start up its worker threads.
+///
+/// @param[in] workerCount  Number of worker threads to spawn, or zero to spawn one worker for each hardware thread
+///                         beyond the calling thread.
+///
+/// @return  True if initialization was successful, false if not.
+///
+/// @see Cleanup()
+bool JobManager::Initialize( uint32_t workerCount )
+{
+    Cleanup();
+
+    if( workerCount == 0 )
+    {
+        uint32_t hardwareThreadCount = static_cast< uint32_t >( std::thread::hardware_concurrency() );
+        workerCount = ( hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0 );
+    }
+
+    workerCount = Min( workerCount, WORKER_COUNT_MAX );
+
+    m_workers.Reserve( workerCount );
+    m_threads.Reserve( workerCount );
+
+    for( uint32_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+    {
+        Worker* pWorker = new Worker( this );
+        HELIUM_ASSERT( pWorker );
+
+        RunnableThread* pThread = new RunnableThread( pWorker );
+        HELIUM_ASSERT( pThread );
+        HELIUM_VERIFY( pThread->Start( "JobManager - worker" ) );
+
+        m_workers.Push( pWorker );
+        m_threads.Push( pThread );
+    }
+
+    return true;
+}
+
+/// Stop all worker threads and shut down the job manager.
+///
+/// @see Initialize()
+void JobManager::Cleanup()
+{
+    size_t workerCount = m_workers.GetSize();
+    HELIUM_ASSERT( m_threads.GetSize() == workerCount );
+
+    for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+    {
+        m_workers[ workerIndex ]->Stop();
+    }
+
+    for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+    {
+        RunnableThread* pThread = m_threads[ workerIndex ];
+        HELIUM_ASSERT( pThread );
+        pThread->Join();
+        delete pThread;
+
+        delete m_workers[ workerIndex ];
+    }
+
+    m_threads.Clear();
+    m_workers.Clear();
+}
+
+/// Run a batch of jobs in parallel, blocking until all jobs in the batch have completed.
+///
+/// The calling thread participates in running jobs from the batch, so this is safe to call from within a job that is
+/// itself running on a worker thread.
+///
+/// @param[in] pRunFunction  Callback to execute for each job.
+/// @param[in] pJobs         Array of job objects.
+/// @param[in] jobSize       Size of each job object, in bytes.
+/// @param[in] jobCount      Number of jobs in the array.
+void JobManager::RunJobs( JOB_RUN_FUNC pRunFunction, void* pJobs, size_t jobSize, size_t jobCount )
+{
+    HELIUM_ASSERT( pRunFunction );
+    HELIUM_ASSERT( pJobs || jobCount == 0 );
+
+    if( jobCount == 0 )
+    {
+        return;
+    }
+
+    Batch batch;
+    batch.pRunFunction = pRunFunction;
+    batch.pJobs = static_cast< uint8_t* >( pJobs );
+    batch.jobSize = jobSize;
+    batch.jobCount = jobCount;
+    batch.nextJobIndex = 0;
+    AtomicExchangeRelease( batch.pendingJobCount, static_cast< int32_t >( jobCount ) );
+
+    {
+        Locker< DynamicArray< Batch* >, SpinLock >::Handle handle( m_batchQueue );
+        handle->Push( &batch );
+    }
+
+    size_t workerCount = m_workers.GetSize();
+    size_t wakeUpCount = Min( workerCount, jobCount - 1 );
+    for( size_t workerIndex = 0; workerIndex < wakeUpCount; ++workerIndex )
+    {
+        m_workers[ workerIndex ]->WakeUp();
+    }
+
+    // Help out with our own batch until no unclaimed jobs remain, then wait for any jobs still running on other
+    // threads.
+    while( TryRunJob( &batch ) )
+    {
+    }
+
+    while( batch.pendingJobCount != 0 )
+    {
+        Thread::Yield();
+    }
+}
+
+/// Claim and run a single job.
+///
+/// @param[in] pOwnerBatch  Batch from which to claim a job, or null to claim a job from the most recently queued
+///                         batch.
+///
+/// @return  True if a job was run, false if no unclaimed jobs were available.
+bool JobManager::TryRunJob( Batch* pOwnerBatch )
+{
+    Batch* pBatch;
+    size_t jobIndex;
+
+    {
+        Locker< DynamicArray< Batch* >, SpinLock >::Handle handle( m_batchQueue );
+
+        size_t batchCount = handle->GetSize();
+        if( batchCount == 0 )
+        {
+            return false;
+        }
+
+        size_t queueIndex = batchCount - 1;
+        if( pOwnerBatch )
+        {
+            while( handle->GetElement( queueIndex ) != pOwnerBatch )
+            {
+                if( queueIndex == 0 )
+                {
+                    return false;
+                }
+
+                --queueIndex;
+            }
+        }
+
+        pBatch = handle->GetElement( queueIndex );
+        HELIUM_ASSERT( pBatch );
+        HELIUM_ASSERT( pBatch->nextJobIndex < pBatch->jobCount );
+
+        // Batches are removed from the queue as soon as their last job is claimed.  Claimed jobs keep the batch
+        // alive, as the submitting thread waits for the pending job count to reach zero before returning.
+        jobIndex = pBatch->nextJobIndex++;
+        if( pBatch->nextJobIndex >= pBatch->jobCount )
+        {
+            handle->Remove( queueIndex );
+        }
+    }
+
+    {
+        HELIUM_FRAME_ZONE( "JobManager::RunJob" );
+        pBatch->pRunFunction( pBatch->pJobs + jobIndex * pBatch->jobSize );
+    }
+
+    AtomicDecrementRelease( pBatch->pendingJobCount );
+
+    return true;
+}
+
+/// Get the singleton JobManager instance.
+///
+/// @return  Pointer to the JobManager instance, or null if it has not been started.
+///
+/// @see Startup(), Shutdown()
+JobManager* JobManager::GetInstance()
+{
+    return sm_pInstance;
+}
+
+/// Create the singleton JobManager instance.
+///
+/// @see GetInstance()
+void JobManager::Startup()
+{
+    if ( ++g_InitCount == 1 )
+    {
+        HELIUM_ASSERT( !sm_pInstance );
+        sm_pInstance = new JobManager;
+        HELIUM_ASSERT( sm_pInstance );
+        if ( !HELIUM_VERIFY( sm_pInstance->Initialize() ) )
+        {
+            Shutdown();
+        }
+    }
+}
+
+/// Destroy the singleton JobManager instance.
+///
+/// @see GetInstance()
+void JobManager::Shutdown()
+{
+    if ( --g_InitCount == 0 )
+    {
+        HELIUM_ASSERT( sm_pInstance );
+        sm_pInstance->Cleanup();
+        delete sm_pInstance;
+        sm_pInstance = NULL;
+    }
+}
+
+/// Get the number of threads that can run jobs concurrently.
+///
+/// This is useful for determining how finely to partition work into jobs.
+///
+/// @return  Number of job manager worker threads plus the calling thread, or one if the job manager has not been
+///          started.
+uint32_t JobManager::GetConcurrency()
+{
+    return ( sm_pInstance ? sm_pInstance->GetWorkerCount() + 1 : 1 );
+}
+
+/// Constructor.
+///
+/// @param[in] pManager  Job manager that owns this worker.
+JobManager::Worker::Worker( JobManager* pManager )
+    : m_pManager( pManager )
+    , m_wakeUpCondition( false, false )
+    , m_stopCounter( 0 )
+{
+    HELIUM_ASSERT( pManager );
+}
+
+/// Destructor.
+JobManager::Worker::~Worker()
+{
+}
+
+/// Run queued jobs until stopped.
+void JobManager::Worker::Run()
+{
+    FrameProfiler* pFrameProfiler = FrameProfiler::GetInstance();
+    if( pFrameProfiler )
+    {
+        pFrameProfiler->SetThreadName( "JobManager worker" );
+    }
+
+    while( m_stopCounter == 0 )
+    {
+        if( !m_pManager->TryRunJob( NULL ) )
+        {
+            // Queue is empty, so sleep until notified.
+            m_wakeUpCondition.Wait();
+        }
+    }
+}
+
+/// Request the worker to stop processing and return at the next possible opportunity.
+void JobManager::Worker::Stop()
+{
+    AtomicExchangeRelease( m_stopCounter, 1 );
+    m_wakeUpCondition.Signal();
+}
+
+/// Wake up the worker thread to check for newly queued jobs.
+void JobManager::Worker::WakeUp()
+{
+    m_wakeUpCondition.Signal();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+
+#include "EngineJobs/EngineJobs.h"
+
+namespace Helium
+{
+    /// Job execution callback.
+    ///
+    /// @param[in] pJob  Job to run.
+    typedef void ( *JOB_RUN_FUNC )( void* pJob );
+
+    /// Worker thread pool for running batches of independent jobs in parallel.
+    ///
+    /// A batch is a contiguous array of job objects sharing the same run callback (typically the static RunCallback()
+    /// function provided by each job class).  The thread submitting a batch helps run jobs from it and does not return
+    /// until every job in the batch has completed, so batches can be safely submitted from within other jobs.  If the
+    /// job manager has not been started, batches are simply run inline on the calling thread.
+    class HELIUM_ENGINE_JOBS_API JobManager : NonCopyable
+    {
+    public:
+        /// Maximum number of worker threads to spawn.
+        static const uint32_t WORKER_COUNT_MAX = 32;
+
+        /// @name Initialization
+        //@{
+        bool Initialize( uint32_t workerCount = 0 );
+        void Cleanup();
+        //@}
+
+        /// @name Job Execution
+        //@{
+        inline uint32_t GetWorkerCount() const;
+
+        void RunJobs( JOB_RUN_FUNC pRunFunction, void* pJobs, size_t jobSize, size_t jobCount );
+        //@}
+
+        /// @name Static Access
+        //@{
+        static JobManager* GetInstance();
+        static void Startup();
+        static void Shutdown();
+
+        static uint32_t GetConcurrency();
+        template< typename JobType > static void Run( JobType* pJobs, size_t jobCount );
+        //@}
+
+    private:
+        /// Batch of jobs submitted for execution.
+        struct Batch
+        {
+            /// Job execution callback.
+            JOB_RUN_FUNC pRunFunction;
+            /// First job in the batch.
+            uint8_t* pJobs;
+            /// Size of each job object, in bytes.
+            size_t jobSize;
+            /// Number of jobs in the batch.
+            size_t jobCount;
+
+            /// Index of the next job to run.
+            size_t nextJobIndex;
+            /// Number of jobs that have not yet finished running.
+            volatile int32_t pendingJobCount;
+        };
+
+        /// Job worker thread runnable.
+        class Worker : public Runnable
+        {
+        public:
+            /// @name Construction/Destruction
+            //@{
+            explicit Worker( JobManager* pManager );
+            virtual ~Worker();
+            //@}
+
+            /// @name Runnable Interface
+            //@{
+            virtual void Run();
+            //@}
+
+            /// @name External Thread Control
+            //@{
+            void Stop();
+            void WakeUp();
+            //@}
+
+        private:
+            /// Owning job manager.
+            JobManager* m_pManager;
+            /// Condition used to wake up the worker thread when jobs are queued (or when it should shut down).
+            Condition m_wakeUpCondition;
+            /// Non-zero if this thread should stop when next possible, zero if it should continue.
+            volatile int32_t m_stopCounter;
+        };
+
+        /// Queue of batches with jobs that have not yet been started.
+        Locker< DynamicArray< Batch* >, SpinLock > m_batchQueue;
+
+        /// Worker threads.
+        DynamicArray< RunnableThread* > m_threads;
+        /// Worker thread runnables.
+        DynamicArray< Worker* > m_workers;
+
+        /// Singleton instance.
+        static JobManager* sm_pInstance;
+
+        /// @name Construction/Destruction
+        //@{
+        JobManager();
+        ~JobManager();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        bool TryRunJob( Batch* pOwnerBatch );
+        //@}
+    };
+}
+
+#include "EngineJobs/JobManager.inl"
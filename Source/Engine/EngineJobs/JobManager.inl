@@ -0,0 +1,34 @@
+namespace Helium
+{
+    /// Get the number of worker threads managed by this job manager.
+    ///
+    /// @return  Worker thread count.
+    uint32_t JobManager::GetWorkerCount() const
+    {
+        return static_cast< uint32_t >( m_workers.GetSize() );
+    }
+
+    /// Run a batch of jobs, using the job manager worker threads if the job manager has been started or running all
+    /// jobs inline on the calling thread if not.
+    ///
+    /// @param[in] pJobs     Array of jobs to run.  Each job type must provide a static RunCallback() function.
+    /// @param[in] jobCount  Number of jobs in the array.
+    template< typename JobType >
+    void JobManager::Run( JobType* pJobs, size_t jobCount )
+    {
+        HELIUM_ASSERT( pJobs || jobCount == 0 );
+
+        JobManager* pInstance = GetInstance();
+        if( !pInstance || jobCount <= 1 )
+        {
+            for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+            {
+                pJobs[ jobIndex ].Run();
+            }
+
+            return;
+        }
+
+        pInstance->RunJobs( &JobType::RunCallback, pJobs, sizeof( JobType ), jobCount );
+    }
+}
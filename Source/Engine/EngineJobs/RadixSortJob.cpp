@@ -0,0 +1,185 @@
+#include "Precompile.h"
+#include "EngineJobs/EngineJobsInterface.h"
+
+#include "EngineJobs/JobManager.h"
+
+using namespace Helium;
+
+/// Maximum number of jobs to split each radix sort pass across.
+static const size_t RADIX_SORT_JOB_COUNT_MAX = JobManager::WORKER_COUNT_MAX + 1;
+
+/// Job for counting the occurrences of each digit value within a range of keys.
+class RadixSortHistogramJob
+{
+public:
+    /// [in] First key to count.
+    const uint64_t* pKeys;
+    /// [in] Number of keys to count.
+    size_t count;
+    /// [in] Bit offset of the digit being counted.
+    uint32_t shift;
+    /// [out] Number of keys with each digit value (RadixSortJob::DIGIT_VALUE_COUNT entries).
+    size_t* pDigitCounts;
+
+    /// Count the digits of the keys assigned to this job.
+    void Run()
+    {
+        for( size_t valueIndex = 0; valueIndex < RadixSortJob::DIGIT_VALUE_COUNT; ++valueIndex )
+        {
+            pDigitCounts[ valueIndex ] = 0;
+        }
+
+        for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+        {
+            ++pDigitCounts[ ( pKeys[ keyIndex ] >> shift ) & ( RadixSortJob::DIGIT_VALUE_COUNT - 1 ) ];
+        }
+    }
+
+    /// Callback executed to run the job.
+    static void RunCallback( void* pJob )
+    {
+        HELIUM_ASSERT( pJob );
+        static_cast< RadixSortHistogramJob* >( pJob )->Run();
+    }
+};
+
+/// Job for moving a range of keys to their sorted location for the current digit.
+class RadixSortScatterJob
+{
+public:
+    /// [in] First key to move.
+    const uint64_t* pSource;
+    /// [out] Base of the key array into which keys should be moved.
+    uint64_t* pDestination;
+    /// [in] Number of keys to move.
+    size_t count;
+    /// [in] Bit offset of the digit being sorted.
+    uint32_t shift;
+    /// [inout] Destination index of the next key with each digit value (RadixSortJob::DIGIT_VALUE_COUNT entries).
+    size_t* pDigitOffsets;
+
+    /// Move the keys assigned to this job.
+    void Run()
+    {
+        for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+        {
+            uint64_t key = pSource[ keyIndex ];
+            size_t& rOffset = pDigitOffsets[ ( key >> shift ) & ( RadixSortJob::DIGIT_VALUE_COUNT - 1 ) ];
+            pDestination[ rOffset ] = key;
+            ++rOffset;
+        }
+    }
+
+    /// Callback executed to run the job.
+    static void RunCallback( void* pJob )
+    {
+        HELIUM_ASSERT( pJob );
+        static_cast< RadixSortScatterJob* >( pJob )->Run();
+    }
+};
+
+/// Sort the array of keys.
+void RadixSortJob::Run()
+{
+    size_t count = m_parameters.count;
+    if( count <= 1 )
+    {
+        return;
+    }
+
+    uint64_t* pKeys = m_parameters.pKeys;
+    uint64_t* pScratch = m_parameters.pScratch;
+    HELIUM_ASSERT( pKeys );
+    HELIUM_ASSERT( pScratch );
+
+    uint32_t startBit = m_parameters.startBit;
+    HELIUM_ASSERT( startBit % DIGIT_BIT_COUNT == 0 );
+    HELIUM_ASSERT( startBit < 64 );
+
+    // Split the keys into one range for each thread, keeping each range from getting too small to be worth running
+    // in parallel.
+    size_t singleJobCount = Max< size_t >( m_parameters.singleJobCount, 1 );
+    size_t jobCount = ( count + singleJobCount - 1 ) / singleJobCount;
+    jobCount = Min( jobCount, static_cast< size_t >( JobManager::GetConcurrency() ) );
+    jobCount = Clamp< size_t >( jobCount, 1, RADIX_SORT_JOB_COUNT_MAX );
+
+    size_t jobKeyCount = ( count + jobCount - 1 ) / jobCount;
+    jobCount = ( count + jobKeyCount - 1 ) / jobKeyCount;
+
+    DynamicArray< size_t > digitCounts;
+    digitCounts.Resize( jobCount * DIGIT_VALUE_COUNT );
+
+    RadixSortHistogramJob histogramJobs[ RADIX_SORT_JOB_COUNT_MAX ];
+    RadixSortScatterJob scatterJobs[ RADIX_SORT_JOB_COUNT_MAX ];
+
+    uint64_t* pSource = pKeys;
+    uint64_t* pDestination = pScratch;
+
+    for( uint32_t shift = startBit; shift < 64; shift += DIGIT_BIT_COUNT )
+    {
+        // Count the digit values in each key range.
+        for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+        {
+            size_t startIndex = jobIndex * jobKeyCount;
+
+            RadixSortHistogramJob& rJob = histogramJobs[ jobIndex ];
+            rJob.pKeys = pSource + startIndex;
+            rJob.count = Min( jobKeyCount, count - startIndex );
+            rJob.shift = shift;
+            rJob.pDigitCounts = digitCounts.GetData() + jobIndex * DIGIT_VALUE_COUNT;
+        }
+
+        JobManager::Run( histogramJobs, jobCount );
+
+        // Convert the counts to the destination offset for each digit value within each range, skipping the pass if
+        // every key has the same digit value.
+        bool bSkipPass = false;
+        size_t offset = 0;
+        for( size_t valueIndex = 0; valueIndex < DIGIT_VALUE_COUNT; ++valueIndex )
+        {
+            size_t valueStartOffset = offset;
+            for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+            {
+                size_t& rDigitCount = digitCounts[ jobIndex * DIGIT_VALUE_COUNT + valueIndex ];
+                size_t digitCount = rDigitCount;
+                rDigitCount = offset;
+                offset += digitCount;
+            }
+
+            if( offset - valueStartOffset == count )
+            {
+                bSkipPass = true;
+
+                break;
+            }
+        }
+
+        if( bSkipPass )
+        {
+            continue;
+        }
+
+        // Move each key to its location for this pass.
+        for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+        {
+            size_t startIndex = jobIndex * jobKeyCount;
+
+            RadixSortScatterJob& rJob = scatterJobs[ jobIndex ];
+            rJob.pSource = pSource + startIndex;
+            rJob.pDestination = pDestination;
+            rJob.count = Min( jobKeyCount, count - startIndex );
+            rJob.shift = shift;
+            rJob.pDigitOffsets = digitCounts.GetData() + jobIndex * DIGIT_VALUE_COUNT;
+        }
+
+        JobManager::Run( scatterJobs, jobCount );
+
+        Swap( pSource, pDestination );
+    }
+
+    // Make sure the sorted keys end up back in the key array.
+    if( pSource != pKeys )
+    {
+        MemoryCopy( pKeys, pSource, count * sizeof( uint64_t ) );
+    }
+}
@@ -0,0 +1,104 @@
+#include "EngineJobs/EngineJobsInterface.h"
+#include "EngineJobs/JobManager.h"
+
+#include "Foundation/DynamicArray.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+/// Fill an array with pseudo-random 64-bit keys.
+///
+/// @param[out] rKeys  Array to fill.
+/// @param[in]  count  Number of keys to generate.
+/// @param[in]  mask   Mask applied to each key (used to generate keys with unused digits).
+static void GenerateKeys( DynamicArray< uint64_t >& rKeys, size_t count, uint64_t mask )
+{
+    rKeys.Resize( count );
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+    {
+        // xorshift64* generator.
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        rKeys[ keyIndex ] = ( state * 0x2545f4914f6cdd1dULL ) & mask;
+    }
+}
+
+/// Sort a set of keys with RadixSortJob and check that the result matches std::sort.
+///
+/// @param[in] count           Number of keys to sort.
+/// @param[in] mask            Mask applied to each key.
+/// @param[in] startBit        Lowest key bit that affects the sort order.
+/// @param[in] singleJobCount  Minimum number of keys to assign to each parallel job.
+static void TestRadixSort( size_t count, uint64_t mask, uint32_t startBit, size_t singleJobCount )
+{
+    DynamicArray< uint64_t > keys;
+    GenerateKeys( keys, count, mask );
+
+    DynamicArray< uint64_t > expected( keys );
+    std::sort( expected.GetData(), expected.GetData() + count );
+
+    DynamicArray< uint64_t > scratch;
+    scratch.Resize( count );
+
+    RadixSortJob job;
+    RadixSortJob::Parameters& rParameters = job.GetParameters();
+    rParameters.pKeys = keys.GetData();
+    rParameters.pScratch = scratch.GetData();
+    rParameters.count = count;
+    rParameters.startBit = startBit;
+    rParameters.singleJobCount = singleJobCount;
+    job.Run();
+
+    // Bits below the start bit are not sorted, so only compare the bits that take part in the sort.
+    uint64_t sortMask = ( startBit < 64 ? ~( ( static_cast< uint64_t >( 1 ) << startBit ) - 1 ) : 0 );
+    for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+    {
+        ASSERT_EQ( expected[ keyIndex ] & sortMask, keys[ keyIndex ] & sortMask ) << "Key " << keyIndex;
+    }
+
+    // The sort must be a permutation of the input.
+    std::sort( keys.GetData(), keys.GetData() + count );
+    for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+    {
+        ASSERT_EQ( expected[ keyIndex ], keys[ keyIndex ] ) << "Key " << keyIndex;
+    }
+}
+
+TEST( RadixSortJob, EmptyAndSingleKey )
+{
+    TestRadixSort( 0, ~static_cast< uint64_t >( 0 ), 0, 1024 );
+    TestRadixSort( 1, ~static_cast< uint64_t >( 0 ), 0, 1024 );
+}
+
+TEST( RadixSortJob, MatchesStdSortSerial )
+{
+    TestRadixSort( 1000, ~static_cast< uint64_t >( 0 ), 0, 1024 );
+    TestRadixSort( 20000, ~static_cast< uint64_t >( 0 ), 0, 1024 );
+}
+
+TEST( RadixSortJob, SkipsUniformDigits )
+{
+    // Only the middle bytes vary, so most passes are skipped.
+    TestRadixSort( 5000, 0x0000ffffff000000ULL, 0, 1024 );
+}
+
+TEST( RadixSortJob, IgnoresBitsBelowStartBit )
+{
+    TestRadixSort( 5000, ~static_cast< uint64_t >( 0 ), 16, 1024 );
+}
+
+TEST( RadixSortJob, MatchesStdSortParallel )
+{
+    JobManager::Startup();
+
+    TestRadixSort( 100000, ~static_cast< uint64_t >( 0 ), 0, 256 );
+    TestRadixSort( 777, ~static_cast< uint64_t >( 0 ), 8, 64 );
+
+    JobManager::Shutdown();
+}
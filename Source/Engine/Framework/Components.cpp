@@ -6,6 +6,9 @@
 #include "Foundation/Numeric.h"
 #include "Reflect/TranslatorDeduction.h"
 #include "Engine/Asset.h"
+#include "Engine/FileLocations.h"
+#include "Engine/MemoryTracker.h"
+#include "Persist/Archive.h"
 
 HELIUM_DEFINE_BASE_STRUCT(Helium::Component);
 
@@ -25,6 +28,70 @@ int32_t                    g_ComponentManagerInstanceCount = 0;
 DynamicArray<TypeData *>   g_ComponentTypes;
 ComponentPtrBase*          g_ComponentPtrRegistry[COMPONENT_PTR_CHECK_FREQUENCY];
 uint16_t                   g_ComponentProcessPendingDeletesCallCount = 0;
+DynamicArray<ComponentTypeConfig> g_PoolProfileConfigs;
+String                     g_PoolProfileSystemPath;
+bool                       g_bRecordPoolProfile = false;
+
+// Extra capacity given to suggested pool sizes on top of the recorded high-water mark, as a percentage
+static const uint32_t POOL_SIZE_HEADROOM_PERCENT = 25;
+
+// Location of the pool profile recorded by previous sessions.  Each SystemDefinition gets its own profile (named
+// after its asset path), so games and tools sharing a user directory don't overwrite each other's sizes.
+static bool GetPoolProfilePath( FilePath &rPath )
+{
+	if ( g_PoolProfileSystemPath.IsEmpty() )
+	{
+		return false;
+	}
+
+	FilePath userDirectory;
+	if ( !FileLocations::GetUserDirectory( userDirectory ) )
+	{
+		return false;
+	}
+
+	String path( userDirectory.Data() );
+	path += "ComponentPoolProfile_";
+
+	for ( const char *pCharacter = *g_PoolProfileSystemPath; *pCharacter; ++pCharacter )
+	{
+		char character = *pCharacter;
+		bool bSafe = ( character >= 'a' && character <= 'z' ) ||
+			( character >= 'A' && character <= 'Z' ) ||
+			( character >= '0' && character <= '9' );
+		path += ( bSafe ? character : '_' );
+	}
+
+	path += ".json";
+	rPath = FilePath( *path );
+
+	return true;
+}
+
+// Load the pool sizes suggested by previous sessions, if any were recorded
+static void LoadPoolProfile()
+{
+	g_PoolProfileConfigs.Clear();
+
+	FilePath profilePath;
+	if ( !GetPoolProfilePath( profilePath ) || !profilePath.Exists() )
+	{
+		return;
+	}
+
+	Reflect::ObjectPtr spObject = Persist::ArchiveReader::ReadFromFile( profilePath );
+	ComponentPoolProfile *pProfile = Reflect::SafeCast< ComponentPoolProfile >( spObject.Get() );
+	if ( !pProfile )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"Components::Startup - Failed to read component pool profile '%s'.\n",
+			profilePath.Get().c_str() );
+		return;
+	}
+
+	g_PoolProfileConfigs = pProfile->m_ComponentTypeConfigs;
+}
 
 ComponentRegistrar<Helium::Component, void> Helium::Component::s_ComponentRegistrar("Helium::Component");
 
@@ -61,6 +128,51 @@ void Components::Startup( SystemDefinition *pSystemDefinition )
 				}
 			}
 		}
+
+		for (DynamicArray< TypeData * >::Iterator componentTypeIter = g_ComponentTypes.Begin(); 
+			componentTypeIter != g_ComponentTypes.End(); ++componentTypeIter)
+		{
+			(*componentTypeIter)->m_HighWaterCount = 0;
+		}
+
+		g_PoolProfileSystemPath.Clear();
+		g_bRecordPoolProfile = false;
+		if ( pSystemDefinition )
+		{
+			pSystemDefinition->GetPath().ToString( g_PoolProfileSystemPath );
+			g_bRecordPoolProfile = pSystemDefinition->m_bRecordComponentPoolProfile;
+		}
+
+		LoadPoolProfile();
+
+		// Profiled sizes grow the SystemDefinition sizes for types that were seen in previous sessions, but never shrink
+		// them below what was configured
+		if ( pSystemDefinition && pSystemDefinition->m_bAutoSizeComponentPools )
+		{
+			size_t appliedCount = 0;
+			for (DynamicArray< ComponentTypeConfig >::Iterator configIter = g_PoolProfileConfigs.Begin(); 
+				configIter != g_PoolProfileConfigs.End(); ++configIter)
+			{
+				for (DynamicArray< TypeData * >::Iterator componentTypeIter = g_ComponentTypes.Begin(); 
+					componentTypeIter != g_ComponentTypes.End(); ++componentTypeIter)
+				{
+					TypeData &rTypeData = **componentTypeIter;
+					if (rTypeData.m_Name == configIter->m_ComponentTypeName)
+					{
+						ComponentIndex profiledCount = static_cast< ComponentIndex >(
+							Min< uint32_t >( configIter->m_PoolSize, NumericLimits< ComponentIndex >::Maximum ) );
+						rTypeData.m_DefaultCount = Max( rTypeData.m_DefaultCount, profiledCount );
+						++appliedCount;
+						break;
+					}
+				}
+			}
+
+			HELIUM_TRACE(
+				TraceLevels::Info,
+				"Components::Startup - Sized %" PRIuSZ " component pools from the recorded pool profile.\n",
+				appliedCount );
+		}
 	}
 }
 
@@ -71,11 +183,29 @@ void Components::Shutdown()
 		HELIUM_TRACE( TraceLevels::Info, "Components shutting down.\n" );
 		HELIUM_ASSERT( !g_ComponentManagerInstanceCount );
 
+		if ( g_bRecordPoolProfile )
+		{
+			for (DynamicArray<TypeData *>::Iterator iter = g_ComponentTypes.Begin();
+				iter != g_ComponentTypes.End(); ++iter)
+			{
+				if ( (*iter)->m_HighWaterCount )
+				{
+					SavePoolProfile();
+					break;
+				}
+			}
+		}
+
+		g_PoolProfileConfigs.Clear();
+		g_PoolProfileSystemPath.Clear();
+		g_bRecordPoolProfile = false;
+
 		for (DynamicArray<TypeData *>::Iterator iter = g_ComponentTypes.Begin();
 			iter != g_ComponentTypes.End(); ++iter)
 		{
 			TypeData *data = *iter;
 			data->m_DefaultCount = 0;
+			data->m_HighWaterCount = 0;
 			data->m_ImplementedTypes.Clear();
 			data->m_ImplementingTypes.Clear();
 			data->m_Structure = NULL;
@@ -144,6 +274,88 @@ const TypeData* Components::GetTypeData( TypeId type )
 	return g_ComponentTypes[ type ];
 }
 
+ComponentIndex Components::GetSuggestedPoolSize( TypeId type )
+{
+	const TypeData *pTypeData = g_ComponentTypes[ type ];
+	HELIUM_ASSERT( pTypeData );
+
+	uint32_t highWaterCount = pTypeData->m_HighWaterCount;
+	if ( !highWaterCount )
+	{
+		return 0;
+	}
+
+	uint32_t suggestedCount = highWaterCount + ( highWaterCount * POOL_SIZE_HEADROOM_PERCENT + 99 ) / 100;
+	return static_cast< ComponentIndex >( Min< uint32_t >( suggestedCount, NumericLimits< ComponentIndex >::Maximum ) );
+}
+
+// Suggested sizes for every type used this session or in a previous session, suitable for pasting into
+// SystemDefinition::m_ComponentTypeConfigs.  Each type keeps the larger of its previously recorded size and this
+// session's size, so a session that happens to use fewer components does not shrink pools sized for heavier ones.
+void Components::GetSuggestedPoolSizes( DynamicArray< ComponentTypeConfig > &rConfigs )
+{
+	rConfigs = g_PoolProfileConfigs;
+
+	for (DynamicArray< TypeData * >::Iterator componentTypeIter = g_ComponentTypes.Begin(); 
+		componentTypeIter != g_ComponentTypes.End(); ++componentTypeIter)
+	{
+		TypeData &rTypeData = **componentTypeIter;
+		ComponentIndex suggestedCount = GetSuggestedPoolSize( rTypeData.m_TypeId );
+		if ( !suggestedCount )
+		{
+			continue;
+		}
+
+		bool found = false;
+		for (DynamicArray< ComponentTypeConfig >::Iterator configIter = rConfigs.Begin(); 
+			configIter != rConfigs.End(); ++configIter)
+		{
+			if (configIter->m_ComponentTypeName == rTypeData.m_Name)
+			{
+				configIter->m_PoolSize = Max< uint32_t >( configIter->m_PoolSize, suggestedCount );
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+		{
+			ComponentTypeConfig &rConfig = *rConfigs.New();
+			rConfig.m_ComponentTypeName = rTypeData.m_Name;
+			rConfig.m_PoolSize = suggestedCount;
+		}
+	}
+}
+
+bool Components::SavePoolProfile()
+{
+	FilePath profilePath;
+	if ( !GetPoolProfilePath( profilePath ) )
+	{
+		return false;
+	}
+
+	StrongPtr< ComponentPoolProfile > spProfile( new ComponentPoolProfile );
+	GetSuggestedPoolSizes( spProfile->m_ComponentTypeConfigs );
+
+	if ( !Persist::ArchiveWriter::WriteToFile( profilePath, spProfile ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"Components::SavePoolProfile - Failed to write component pool profile '%s'.\n",
+			profilePath.Get().c_str() );
+		return false;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		"Components::SavePoolProfile - Wrote suggested pool sizes for %" PRIuSZ " component types to '%s'.\n",
+		spProfile->m_ComponentTypeConfigs.GetSize(),
+		profilePath.Get().c_str() );
+
+	return true;
+}
+
 ComponentManagerPtr Components::CreateManager( World *pWorld )
 {
 	return new ComponentManager(pWorld);
@@ -151,6 +363,12 @@ ComponentManagerPtr Components::CreateManager( World *pWorld )
 
 #define PAD_VALUE( _VALUE , _PAD ) ((_VALUE + (_PAD-1)) & (~(_PAD-1)))
 
+// Total memory allocated for a pool, including its parallel data (used for memory tracking)
+static size_t GetPoolMemorySize( size_t memoryRequired, ComponentIndex count )
+{
+	return memoryRequired + sizeof( DataParallel ) * count;
+}
+
 Pool* Pool::CreatePool( ComponentManager *pComponentManager, const TypeData &rTypeData, ComponentIndex count )
 {
 	if ( !count )
@@ -172,6 +390,7 @@ Pool* Pool::CreatePool( ComponentManager *pComponentManager, const TypeData &rTy
 	new(pool) Pool();
 	
 	pool->m_ParallelData = HELIUM_NEW_A( g_ComponentAllocator, DataParallel, count );
+	HELIUM_TRACK_ALLOCATION( MEMORY_TAG_COMPONENTS, GetPoolMemorySize( memoryRequried, count ) );
 
 	pool->m_World = pComponentManager->GetWorld();
 	pool->m_ComponentManager = pComponentManager;
@@ -226,6 +445,11 @@ void Pool::DestroyPool( Pool *pPool )
 			pPool->m_Type->m_Structure->m_Name);
 	}
 
+	ComponentIndex count = static_cast< ComponentIndex >( pPool->m_Roster.GetSize() );
+	size_t poolSize = PAD_VALUE( sizeof( Components::Pool ), HELIUM_SIMD_ALIGNMENT );
+	size_t memoryRequired = poolSize + pPool->m_ComponentSize * count;
+	HELIUM_TRACK_FREE( MEMORY_TAG_COMPONENTS, GetPoolMemorySize( memoryRequired, count ) );
+
 	HELIUM_DELETE_A( g_ComponentAllocator, pPool->m_ParallelData );
 	pPool->~Pool();
 	g_ComponentAllocator.FreeAligned( pPool );
@@ -303,6 +527,12 @@ Component* Pool::Allocate( IHasComponents *owner, ComponentCollection &collectio
 	// Do we have a free component to allocate?
 	if (m_FirstUnallocatedIndex >= m_Roster.GetSize())
 	{
+		// Record the unmet demand so the suggested pool size covers it
+		if (m_FirstUnallocatedIndex < NumericLimits<ComponentIndex>::Maximum && m_FirstUnallocatedIndex + 1 > m_Type->m_HighWaterCount)
+		{
+			m_Type->m_HighWaterCount = m_FirstUnallocatedIndex + 1;
+		}
+
 		// Could not allocate the component because we ran out..
 		HELIUM_ASSERT_MSG( false, "Could not allocate component of type %s for host %x. No free instances are available. Maximum instances: %d", 
 			g_ComponentTypes[ m_TypeId ]->m_Structure->m_Name,
@@ -313,6 +543,10 @@ Component* Pool::Allocate( IHasComponents *owner, ComponentCollection &collectio
 
 	// Find out where the component we should allocate is in the roster
 	ComponentIndex roster_index = m_FirstUnallocatedIndex++;
+	if (m_FirstUnallocatedIndex > m_Type->m_HighWaterCount)
+	{
+		m_Type->m_HighWaterCount = m_FirstUnallocatedIndex;
+	}
 	
 	Component *component = m_Roster[roster_index];
 	ComponentIndex component_index = GetComponentIndex( component );
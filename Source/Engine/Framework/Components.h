@@ -67,6 +67,7 @@ namespace Helium
 	class World;
 	class ComponentPtrBase;
 	class SystemDefinition;
+	struct ComponentTypeConfig;
 
 	namespace Components
 	{
@@ -111,6 +112,7 @@ namespace Helium
 			DynamicArray<TypeId>       m_ImplementedTypes;       //< Parent type IDs of this type
 			DynamicArray<TypeId>       m_ImplementingTypes;      //< Child types IDs of this type
 			ComponentIndex             m_DefaultCount;           //< Default number of components of this type to make
+			mutable ComponentIndex     m_HighWaterCount;         //< Most components of this type requested at once by any one world this session
 
 			virtual void       Construct(Component *ptr) const = 0;
 			virtual void       Destruct(Component *ptr) const = 0;
@@ -232,6 +234,10 @@ namespace Helium
 			uint16_t                  _count);
 		HELIUM_FRAMEWORK_API const TypeData*     GetTypeData( TypeId type );
 
+		HELIUM_FRAMEWORK_API ComponentIndex      GetSuggestedPoolSize( TypeId type );
+		HELIUM_FRAMEWORK_API void                GetSuggestedPoolSizes( DynamicArray< ComponentTypeConfig > &rConfigs );
+		HELIUM_FRAMEWORK_API bool                SavePoolProfile();
+
 		HELIUM_FRAMEWORK_API ComponentManagerPtr   CreateManager( World *pWorld );
 
 		template <class T>  TypeId GetType();
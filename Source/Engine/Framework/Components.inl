@@ -7,6 +7,7 @@ namespace Helium
 		
 		TypeData::TypeData() 
 			: m_TypeId(Invalid<TypeId>())
+			, m_HighWaterCount(0)
 		{
 
 		}
@@ -10,7 +10,10 @@
 #include "Platform/Timer.h"
 #include "Platform/Process.h"
 #include "Engine/Config.h"
+#include "Engine/FrameProfiler.h"
+#include "Engine/MemoryTracker.h"
 #include "Engine/CacheManager.h"
+#include "EngineJobs/JobManager.h"
 #include "Framework/MemoryHeapPreInitialization.h"
 #include "Framework/AssetLoaderInitialization.h"
 #include "Framework/ConfigInitialization.h"
@@ -39,6 +42,7 @@ GameSystem::GameSystem()
 , m_pRendererInitialization( NULL )
 , m_pWindowManagerInitialization( NULL )
 , m_bStopRunning( false )
+, m_frameLimit( 0 )
 {
 }
 
@@ -87,7 +91,10 @@ bool GameSystem::Initialize(
 	Asset::s_CheckPreDestroy = checkPreDestroy;
 #endif
 
+	FrameProfiler::Startup();
+	MemoryTracker::Startup();
 	AsyncLoader::Startup();
+	JobManager::Startup();
 	CacheManager::Startup();
 	Reflect::Startup();
 	Persist::Startup();
@@ -99,6 +106,11 @@ bool GameSystem::Initialize(
 
 	rConfigInitialization.Startup();
 
+	// Apply memory budgets now that the configuration is loaded.
+	MemoryTracker* pMemoryTracker = MemoryTracker::GetInstance();
+	HELIUM_ASSERT( pMemoryTracker );
+	pMemoryTracker->ApplyConfig();
+
 	if ( !rSystemDefinitionPath.IsEmpty() )
 	{
 		AssetLoader* pAssetLoader = AssetLoader::GetInstance();
@@ -184,7 +196,10 @@ void GameSystem::Cleanup()
 	Reflect::Shutdown();
 	AssetType::Shutdown();
 	Asset::Shutdown();
+	JobManager::Shutdown();
 	AsyncLoader::Shutdown();
+	MemoryTracker::Shutdown();
+	FrameProfiler::Shutdown();
 
 	Reflect::ObjectRefCountSupport::Shutdown();
 
@@ -201,14 +216,44 @@ void GameSystem::Cleanup()
 /// @return  Result code of application execution.
 int32_t GameSystem::Run()
 {
+	FrameProfiler* pFrameProfiler = FrameProfiler::GetInstance();
+	if ( pFrameProfiler )
+	{
+		pFrameProfiler->SetThreadName( "Main" );
+	}
+
+	MemoryTracker* pMemoryTracker = MemoryTracker::GetInstance();
+
+	uint32_t frameCount = 0;
 	while ( !m_bStopRunning )
 	{
-		AssetLoader::GetInstance()->Tick();
-		m_AssetSyncUtility.Sync();
+		{
+			HELIUM_FRAME_ZONE( "GameSystem::Run" );
+
+			AssetLoader::GetInstance()->Tick();
+			m_AssetSyncUtility.Sync();
+
+			WorldManager* pWorldManager = WorldManager::GetInstance();
+			HELIUM_ASSERT( pWorldManager );
+			pWorldManager->Update( m_Schedule );
+		}
+
+		// Fold the frame's zones into the rolling profiler statistics.
+		if ( pFrameProfiler )
+		{
+			pFrameProfiler->EndFrame();
+		}
 
-		WorldManager* pWorldManager = WorldManager::GetInstance();
-		HELIUM_ASSERT( pWorldManager );
-		pWorldManager->Update( m_Schedule );
+		if ( pMemoryTracker )
+		{
+			pMemoryTracker->EndFrame();
+		}
+
+		++frameCount;
+		if ( m_frameLimit != 0 && frameCount >= m_frameLimit )
+		{
+			break;
+		}
 	}
 
 	m_bStopRunning = false;
@@ -216,6 +261,19 @@ int32_t GameSystem::Run()
 	return 0;
 }
 
+/// Set the number of frames to run before Run() returns.
+///
+/// This is mainly intended for running a fixed number of frames for benchmarking or testing (i.e. with the headless
+/// renderer).
+///
+/// @param[in] frameLimit  Number of frames to run, or zero to run until StopRunning() is called.
+///
+/// @see Run()
+void GameSystem::SetFrameLimit( uint32_t frameLimit )
+{
+	m_frameLimit = frameLimit;
+}
+
 /// Get the singleton GameSystem instance.
 ///
 /// @return  Pointer to the GameSystem instance.
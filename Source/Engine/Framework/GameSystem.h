@@ -45,6 +45,8 @@ namespace Helium
 		/// @name Application Loop
 		//@{
 		virtual int32_t Run();
+
+		void SetFrameLimit( uint32_t frameLimit );
 		//@}
 
 		/// @name Static Initialization
@@ -70,5 +72,7 @@ namespace Helium
 		AssetAwareThreadSynchronizer m_AssetSyncUtility;
 		TaskSchedule                 m_Schedule;
 		bool                         m_bStopRunning;
+		/// Number of frames after which Run() returns (zero to run until StopRunning() is called).
+		uint32_t                     m_frameLimit;
 	};
 }
@@ -0,0 +1,15 @@
+#include "Precompile.h"
+#include "Framework/NullWindowManagerInitialization.h"
+
+using namespace Helium;
+
+/// @copydoc WindowManagerInitialization::Startup()
+void NullWindowManagerInitialization::Startup()
+{
+	// No window manager is created (for running without a display).
+}
+
+/// @copydoc WindowManagerInitialization::Shutdown()
+void NullWindowManagerInitialization::Shutdown()
+{
+}
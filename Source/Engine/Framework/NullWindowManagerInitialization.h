@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Framework/WindowManagerInitialization.h"
+
+namespace Helium
+{
+	/// Window manager initializer that does not create a window manager.
+	class HELIUM_FRAMEWORK_API NullWindowManagerInitialization : public WindowManagerInitialization
+	{
+	public:
+		/// @name Window Manager Initialization
+		//@{
+		void Startup();
+		void Shutdown();
+		//@}
+	};
+}
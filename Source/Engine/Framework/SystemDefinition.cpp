@@ -28,6 +28,15 @@ void SystemDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 {
 	comp.AddField( &SystemDefinition::m_SystemComponents, "m_SystemComponents" );
 	comp.AddField( &SystemDefinition::m_ComponentTypeConfigs, "m_ComponentTypeConfigs" );
+	comp.AddField( &SystemDefinition::m_bAutoSizeComponentPools, "m_bAutoSizeComponentPools" );
+	comp.AddField( &SystemDefinition::m_bRecordComponentPoolProfile, "m_bRecordComponentPoolProfile" );
+}
+
+Helium::SystemDefinition::SystemDefinition()
+	: m_bAutoSizeComponentPools(false)
+	, m_bRecordComponentPoolProfile(false)
+{
+
 }
 
 void SystemDefinition::Initialize()
@@ -79,3 +88,13 @@ bool ComponentTypeConfig::operator!=( const ComponentTypeConfig& _rhs ) const
 {
 	return !( *this == _rhs );
 }
+
+//////////////////////////////////////////////////////////////////////////
+// ComponentPoolProfile
+
+HELIUM_DEFINE_CLASS( Helium::ComponentPoolProfile );
+
+void ComponentPoolProfile::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &ComponentPoolProfile::m_ComponentTypeConfigs, "m_ComponentTypeConfigs" );
+}
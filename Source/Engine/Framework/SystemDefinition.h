@@ -72,16 +72,29 @@ namespace Helium
 		inline bool operator!=( const ComponentTypeConfig& _rhs ) const;
 	};
 
+	// Suggested component pool sizes recorded from the pool high-water marks of previous sessions
+	class HELIUM_FRAMEWORK_API ComponentPoolProfile : public Reflect::Object
+	{
+		HELIUM_DECLARE_CLASS( Helium::ComponentPoolProfile, Reflect::Object );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		DynamicArray< ComponentTypeConfig > m_ComponentTypeConfigs;
+	};
+
 	class HELIUM_FRAMEWORK_API SystemDefinition : public Asset
 	{
 		HELIUM_DECLARE_ASSET( Helium::SystemDefinition, Helium::Asset )
 		static void PopulateMetaType( Reflect::MetaStruct& comp );
 
+		SystemDefinition();
+
 		void Initialize();
 		void Cleanup();
 
 		DynamicArray< ComponentTypeConfig > m_ComponentTypeConfigs;
 		DynamicArray< SystemComponentDefinitionPtr > m_SystemComponents;
+		bool m_bAutoSizeComponentPools; // Grow pools to the recorded ComponentPoolProfile sizes where they exceed m_ComponentTypeConfigs
+		bool m_bRecordComponentPoolProfile; // Write the pool sizes suggested by this session to the ComponentPoolProfile on shutdown
 	};
 	typedef Helium::StrongPtr< SystemDefinition > SystemDefinitionPtr;
 }
@@ -2,6 +2,7 @@
 #include "Precompile.h"
 #include "TaskScheduler.h"
 #include "Foundation/Map.h"
+#include "Engine/FrameProfiler.h"
 
 using namespace Helium;
 
@@ -280,11 +281,18 @@ bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc>
 
 void TaskScheduler::ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds )
 {
+	HELIUM_FRAME_ZONE( "TaskScheduler::ExecuteSchedule" );
+
 	int i = 0;
 	for (DynamicArray<TaskFunc>::ConstIterator iter = schedule.m_ScheduleFunc.Begin(); iter != schedule.m_ScheduleFunc.End(); ++iter)
 	{
+		const TaskDefinition *pTask = schedule.m_ScheduleInfo[i++];
+		HELIUM_ASSERT(pTask->m_Func == *iter);
+
+		// Profile each task under its definition name.
+		HELIUM_FRAME_ZONE( pTask->m_Name );
+
 		(*iter)( rWorlds );
-		HELIUM_ASSERT(schedule.m_ScheduleInfo[i++]->m_Func == *iter);
 	}
 }
 
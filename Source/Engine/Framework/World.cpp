@@ -314,3 +314,37 @@ Slice* World::GetSlice( size_t index ) const
 
 	return m_Slices[ index ];
 }
+
+/// Add a transform component to the list of transforms changed since the list was last cleared.
+///
+/// Transform components add themselves when they first become dirty, so systems depending on transforms only need to
+/// process this list instead of checking every component.
+///
+/// @param[in] pTransform  Changed transform component.
+///
+/// @see RemoveChangedTransform(), GetChangedTransforms(), ClearChangedTransforms()
+void World::AddChangedTransform( Component* pTransform )
+{
+	HELIUM_ASSERT( pTransform );
+
+	m_ChangedTransforms.Push( pTransform );
+}
+
+/// Remove a transform component from the changed transform list (i.e. when it is destroyed while dirty).
+///
+/// @param[in] pTransform  Transform component to remove.
+///
+/// @see AddChangedTransform()
+void World::RemoveChangedTransform( Component* pTransform )
+{
+	size_t transformCount = m_ChangedTransforms.GetSize();
+	for( size_t transformIndex = 0; transformIndex < transformCount; ++transformIndex )
+	{
+		if( m_ChangedTransforms[ transformIndex ] == pTransform )
+		{
+			m_ChangedTransforms.RemoveSwap( transformIndex );
+
+			return;
+		}
+	}
+}
@@ -64,6 +64,14 @@ namespace Helium
 		Slice* GetSlice( size_t index ) const;
 		//@}
 
+		/// @name Transform Change Tracking
+		//@{
+		void AddChangedTransform( Component* pTransform );
+		void RemoveChangedTransform( Component* pTransform );
+		inline const DynamicArray< Component* >& GetChangedTransforms() const;
+		inline void ClearChangedTransforms();
+		//@}
+
 	public:
 		// TEMPORARY!
 		ComponentManagerPtr m_ComponentManager;
@@ -77,6 +85,9 @@ namespace Helium
 		/// Active slices.
 		DynamicArray< SlicePtr > m_Slices;
 		SlicePtr m_RootSlice;
+
+		/// Transform components changed since the list was last cleared.
+		DynamicArray< Component* > m_ChangedTransforms;
 	};
 
 	typedef Helium::StrongPtr< World > WorldPtr;
@@ -19,4 +19,22 @@ namespace Helium
     {
         return m_Slices.GetSize();
     }
+
+    /// Get the transform components changed since the list was last cleared.
+    ///
+    /// @return  Changed transform components.
+    ///
+    /// @see AddChangedTransform(), ClearChangedTransforms()
+    const DynamicArray< Component* >& World::GetChangedTransforms() const
+    {
+        return m_ChangedTransforms;
+    }
+
+    /// Clear the list of changed transform components.
+    ///
+    /// @see GetChangedTransforms()
+    void World::ClearChangedTransforms()
+    {
+        m_ChangedTransforms.Resize( 0 );
+    }
 }
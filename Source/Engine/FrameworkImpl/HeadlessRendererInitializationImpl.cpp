@@ -0,0 +1,63 @@
+#include "Precompile.h"
+#include "FrameworkImpl/HeadlessRendererInitializationImpl.h"
+#include "Engine/Config.h"
+#include "Graphics/GraphicsConfig.h"
+#include "RenderingNull/NullRenderer.h"
+
+#include "Graphics/RenderResourceManager.h"
+#include "Graphics/DynamicDrawer.h"
+#include "Graphics/GlyphCache.h"
+#include "Graphics/ShaderVariantCache.h"
+#include "Graphics/TextureStreamingManager.h"
+
+using namespace Helium;
+
+/// @copydoc RendererInitialization::Initialize()
+bool HeadlessRendererInitializationImpl::Initialize()
+{
+	NullRenderer::Startup();
+	Renderer* pRenderer = NullRenderer::GetInstance();
+	if ( !HELIUM_VERIFY( pRenderer ) )
+	{
+		return false;
+	}
+
+	Config* pConfig = Config::GetInstance();
+	HELIUM_ASSERT( pConfig );
+
+	StrongPtr< GraphicsConfig > spGraphicsConfig( pConfig->GetConfigObject< GraphicsConfig >( Name( "GraphicsConfig" ) ) );
+	HELIUM_ASSERT( spGraphicsConfig );
+
+	// Create the application rendering context.  No window is associated with it.
+	Renderer::ContextInitParameters contextInitParams;
+	contextInitParams.pWindow = NULL;
+	contextInitParams.displayWidth = spGraphicsConfig->GetWidth();
+	contextInitParams.displayHeight = spGraphicsConfig->GetHeight();
+	if( !HELIUM_VERIFY( pRenderer->CreateMainContext( contextInitParams ) ) )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "Failed to create main renderer context.\n" );
+		return false;
+	}
+
+	RenderResourceManager::Startup();
+	DynamicDrawer::Startup();
+	TextureStreamingManager::Startup();
+	ShaderVariantCache::Startup();
+	GlyphCache::Startup();
+	return true;
+}
+
+/// @copydoc RendererInitialization::Shutdown()
+void HeadlessRendererInitializationImpl::Shutdown()
+{
+	GlyphCache::Shutdown();
+	ShaderVariantCache::Shutdown();
+	TextureStreamingManager::Shutdown();
+	DynamicDrawer::Shutdown();
+	RenderResourceManager::Shutdown();
+
+	if( Renderer::GetInstance() )
+	{
+		NullRenderer::Shutdown();
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "FrameworkImpl/FrameworkImpl.h"
+#include "Framework/RendererInitialization.h"
+
+namespace Helium
+{
+	/// Renderer factory implementation that creates a null renderer without a window.
+	///
+	/// Unlike NullRendererInitialization, a Renderer instance is created (see NullRenderer), so the complete graphics
+	/// pipeline can be run on machines without a GPU or display.
+	class HELIUM_FRAMEWORK_IMPL_API HeadlessRendererInitializationImpl : public RendererInitialization
+	{
+	public:
+		/// @name Renderer Initialization
+		//@{
+		virtual bool Initialize();
+		//@}
+
+		virtual void Shutdown();
+	};
+}
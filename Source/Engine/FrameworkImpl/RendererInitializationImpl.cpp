@@ -12,6 +12,10 @@
 
 #include "Graphics/RenderResourceManager.h"
 #include "Graphics/DynamicDrawer.h"
+#include "Graphics/GlyphCache.h"
+#include "Graphics/RenderThread.h"
+#include "Graphics/ShaderVariantCache.h"
+#include "Graphics/TextureStreamingManager.h"
 
 using namespace Helium;
 
@@ -86,6 +90,10 @@ bool RendererInitializationImpl::Initialize()
 
 	RenderResourceManager::Startup();
 	DynamicDrawer::Startup();
+	TextureStreamingManager::Startup();
+	ShaderVariantCache::Startup();
+	GlyphCache::Startup();
+	RenderThread::Startup();
 	return true;
 }
 
@@ -112,6 +120,10 @@ void RendererInitializationImpl::OnMainWindowDestroyed( Window* pWindow )
 
 void Helium::RendererInitializationImpl::Shutdown()
 {
+	RenderThread::Shutdown();
+	GlyphCache::Shutdown();
+	ShaderVariantCache::Shutdown();
+	TextureStreamingManager::Shutdown();
 	DynamicDrawer::Shutdown();
 	RenderResourceManager::Shutdown();
 
@@ -0,0 +1,552 @@
+#include "Precompile.h"
+#include "Graphics/AabbTree.h"
+
+#include "MathSimd/Frustum.h"
+
+using namespace Helium;
+
+const float32_t AabbTree::LEAF_MARGIN_SCALE = 0.1f;
+const float32_t AabbTree::LEAF_MARGIN_MIN = 0.05f;
+
+/// Compute the smallest box containing two boxes.
+///
+/// @param[in] rBox0  First box.
+/// @param[in] rBox1  Second box.
+///
+/// @return  Combined box.
+static Simd::AaBox CombineBoxes( const Simd::AaBox& rBox0, const Simd::AaBox& rBox1 )
+{
+	return Simd::AaBox(
+		Simd::Vector3( Simd::MinF32( rBox0.GetMinimum().GetSimdVector(), rBox1.GetMinimum().GetSimdVector() ) ),
+		Simd::Vector3( Simd::MaxF32( rBox0.GetMaximum().GetSimdVector(), rBox1.GetMaximum().GetSimdVector() ) ) );
+}
+
+/// Test whether a box fully contains another box.
+///
+/// @param[in] rOuter  Containing box.
+/// @param[in] rInner  Box to test.
+///
+/// @return  True if the inner box is entirely within the outer box, false if not.
+static bool BoxContains( const Simd::AaBox& rOuter, const Simd::AaBox& rInner )
+{
+	const Simd::Vector3& rOuterMinimum = rOuter.GetMinimum();
+	const Simd::Vector3& rOuterMaximum = rOuter.GetMaximum();
+	const Simd::Vector3& rInnerMinimum = rInner.GetMinimum();
+	const Simd::Vector3& rInnerMaximum = rInner.GetMaximum();
+
+	for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+	{
+		if( rInnerMinimum.GetElement( axisIndex ) < rOuterMinimum.GetElement( axisIndex ) ||
+			rInnerMaximum.GetElement( axisIndex ) > rOuterMaximum.GetElement( axisIndex ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// Compute the surface area of a box.
+///
+/// @param[in] rBox  Box.
+///
+/// @return  Box surface area.
+static float32_t GetBoxSurfaceArea( const Simd::AaBox& rBox )
+{
+	Simd::Vector3 extent = rBox.GetMaximum() - rBox.GetMinimum();
+	float32_t x = extent.GetElement( 0 );
+	float32_t y = extent.GetElement( 1 );
+	float32_t z = extent.GetElement( 2 );
+
+	return 2.0f * ( x * y + y * z + z * x );
+}
+
+/// Enlarge a leaf box by the leaf margin so that small movements do not require the leaf to be reinserted.
+///
+/// @param[in] rBox  Leaf bounds.
+///
+/// @return  Enlarged leaf box.
+static Simd::AaBox GetFatLeafBox( const Simd::AaBox& rBox )
+{
+	Simd::Vector3 margin = ( rBox.GetMaximum() - rBox.GetMinimum() ) * AabbTree::LEAF_MARGIN_SCALE;
+	margin.SetSimdVector( Simd::MaxF32( margin.GetSimdVector(), Simd::SetSplatF32( AabbTree::LEAF_MARGIN_MIN ) ) );
+
+	return Simd::AaBox( rBox.GetMinimum() - margin, rBox.GetMaximum() + margin );
+}
+
+/// Constructor.
+AabbTree::AabbTree()
+	: m_root( Invalid< size_t >() )
+	, m_freeList( Invalid< size_t >() )
+	, m_leafCount( 0 )
+{
+}
+
+/// Destructor.
+AabbTree::~AabbTree()
+{
+}
+
+/// Add a leaf to the tree.
+///
+/// @param[in] rBox      Leaf bounding box.
+/// @param[in] userData  User data to associate with the leaf.
+///
+/// @return  ID of the new leaf.
+///
+/// @see DestroyLeaf(), MoveLeaf()
+size_t AabbTree::CreateLeaf( const Simd::AaBox& rBox, size_t userData )
+{
+	size_t leafIndex = AllocateNode();
+
+	Node& rLeaf = m_nodes[ leafIndex ];
+	rLeaf.userData = userData;
+	rLeaf.height = 0;
+
+	rLeaf.box = GetFatLeafBox( rBox );
+
+	InsertLeaf( leafIndex );
+	++m_leafCount;
+
+	return leafIndex;
+}
+
+/// Remove a leaf from the tree.
+///
+/// @param[in] leafId  ID of the leaf to remove.
+///
+/// @see CreateLeaf(), MoveLeaf()
+void AabbTree::DestroyLeaf( size_t leafId )
+{
+	HELIUM_ASSERT( leafId < m_nodes.GetSize() );
+	HELIUM_ASSERT( m_nodes[ leafId ].IsLeaf() );
+	HELIUM_ASSERT( m_leafCount != 0 );
+
+	RemoveLeaf( leafId );
+	FreeNode( leafId );
+	--m_leafCount;
+}
+
+/// Update the bounding box of a leaf.
+///
+/// If the new box is still within the enlarged box stored for the leaf, the tree is left unchanged.  Otherwise, the
+/// leaf is reinserted into the tree with its new bounds.
+///
+/// @param[in] leafId  ID of the leaf to update.
+/// @param[in] rBox    New leaf bounding box.
+///
+/// @return  True if the tree was modified, false if the leaf bounds still fit within the stored leaf box.
+///
+/// @see CreateLeaf(), DestroyLeaf()
+bool AabbTree::MoveLeaf( size_t leafId, const Simd::AaBox& rBox )
+{
+	HELIUM_ASSERT( leafId < m_nodes.GetSize() );
+	HELIUM_ASSERT( m_nodes[ leafId ].IsLeaf() );
+
+	if( BoxContains( m_nodes[ leafId ].box, rBox ) )
+	{
+		return false;
+	}
+
+	RemoveLeaf( leafId );
+
+	m_nodes[ leafId ].box = GetFatLeafBox( rBox );
+
+	InsertLeaf( leafId );
+
+	return true;
+}
+
+/// Find the leaves whose boxes intersect a given view frustum.
+///
+/// Subtrees fully contained within the frustum are added in their entirety without testing their individual
+/// leaves.  Leaves that only partially intersect the frustum are reported separately, as the caller may want to
+/// perform a more precise test against their actual bounds.
+///
+/// @param[in]  rFrustum       Frustum to test.
+/// @param[out] rContained     User data for each leaf fully contained within the frustum (appended to the array).
+/// @param[out] rIntersecting  User data for each leaf partially intersecting the frustum (appended to the array).
+void AabbTree::QueryFrustum(
+	const Simd::Frustum& rFrustum,
+	DynamicArray< size_t >& rContained,
+	DynamicArray< size_t >& rIntersecting )
+{
+	if( IsInvalid( m_root ) )
+	{
+		return;
+	}
+
+	m_traversalStack.Resize( 0 );
+	m_traversalStack.Push( m_root );
+
+	while( m_traversalStack.GetSize() != 0 )
+	{
+		size_t nodeIndex = m_traversalStack.GetLast();
+		m_traversalStack.Pop();
+
+		const Node& rNode = m_nodes[ nodeIndex ];
+		if( !rFrustum.Intersects( rNode.box ) )
+		{
+			continue;
+		}
+
+		if( rFrustum.Contains( rNode.box ) )
+		{
+			AddSubtreeLeaves( nodeIndex, rContained );
+
+			continue;
+		}
+
+		if( rNode.IsLeaf() )
+		{
+			rIntersecting.Push( rNode.userData );
+		}
+		else
+		{
+			m_traversalStack.Push( rNode.children[ 0 ] );
+			m_traversalStack.Push( rNode.children[ 1 ] );
+		}
+	}
+}
+
+/// Allocate an unused node.
+///
+/// @return  Index of the allocated node.
+///
+/// @see FreeNode()
+size_t AabbTree::AllocateNode()
+{
+	size_t nodeIndex = m_freeList;
+	if( IsValid( nodeIndex ) )
+	{
+		m_freeList = m_nodes[ nodeIndex ].parent;
+	}
+	else
+	{
+		nodeIndex = m_nodes.GetSize();
+		m_nodes.New();
+	}
+
+	Node& rNode = m_nodes[ nodeIndex ];
+	SetInvalid( rNode.parent );
+	SetInvalid( rNode.children[ 0 ] );
+	SetInvalid( rNode.children[ 1 ] );
+	SetInvalid( rNode.userData );
+	rNode.height = 0;
+
+	return nodeIndex;
+}
+
+/// Return a node to the free node list.
+///
+/// @param[in] nodeIndex  Index of the node to free.
+///
+/// @see AllocateNode()
+void AabbTree::FreeNode( size_t nodeIndex )
+{
+	HELIUM_ASSERT( nodeIndex < m_nodes.GetSize() );
+
+	Node& rNode = m_nodes[ nodeIndex ];
+	rNode.parent = m_freeList;
+	rNode.height = -1;
+
+	m_freeList = nodeIndex;
+}
+
+/// Insert a leaf node into the tree hierarchy.
+///
+/// @param[in] leafIndex  Index of the leaf node to insert.
+///
+/// @see RemoveLeaf()
+void AabbTree::InsertLeaf( size_t leafIndex )
+{
+	if( IsInvalid( m_root ) )
+	{
+		m_root = leafIndex;
+		SetInvalid( m_nodes[ leafIndex ].parent );
+
+		return;
+	}
+
+	// Find the best sibling for the new leaf, descending into the child that yields the lowest increase in surface
+	// area.
+	Simd::AaBox leafBox = m_nodes[ leafIndex ].box;
+
+	size_t nodeIndex = m_root;
+	while( !m_nodes[ nodeIndex ].IsLeaf() )
+	{
+		const Node& rNode = m_nodes[ nodeIndex ];
+
+		float32_t area = GetBoxSurfaceArea( rNode.box );
+		float32_t combinedArea = GetBoxSurfaceArea( CombineBoxes( rNode.box, leafBox ) );
+
+		// Cost of creating a new parent for this node and the new leaf.
+		float32_t cost = 2.0f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down the tree.
+		float32_t inheritanceCost = 2.0f * ( combinedArea - area );
+
+		float32_t childCosts[ 2 ];
+		for( size_t childIndex = 0; childIndex < 2; ++childIndex )
+		{
+			const Node& rChild = m_nodes[ rNode.children[ childIndex ] ];
+			float32_t childCombinedArea = GetBoxSurfaceArea( CombineBoxes( rChild.box, leafBox ) );
+			childCosts[ childIndex ] = childCombinedArea + inheritanceCost;
+			if( !rChild.IsLeaf() )
+			{
+				childCosts[ childIndex ] -= GetBoxSurfaceArea( rChild.box );
+			}
+		}
+
+		if( cost < childCosts[ 0 ] && cost < childCosts[ 1 ] )
+		{
+			break;
+		}
+
+		nodeIndex = rNode.children[ childCosts[ 0 ] < childCosts[ 1 ] ? 0 : 1 ];
+	}
+
+	// Create a new parent for the sibling and the new leaf.
+	size_t siblingIndex = nodeIndex;
+	size_t oldParentIndex = m_nodes[ siblingIndex ].parent;
+
+	size_t newParentIndex = AllocateNode();
+	Node& rNewParent = m_nodes[ newParentIndex ];
+	rNewParent.parent = oldParentIndex;
+	rNewParent.box = CombineBoxes( leafBox, m_nodes[ siblingIndex ].box );
+	rNewParent.height = m_nodes[ siblingIndex ].height + 1;
+	rNewParent.children[ 0 ] = siblingIndex;
+	rNewParent.children[ 1 ] = leafIndex;
+
+	if( IsValid( oldParentIndex ) )
+	{
+		Node& rOldParent = m_nodes[ oldParentIndex ];
+		rOldParent.children[ rOldParent.children[ 0 ] == siblingIndex ? 0 : 1 ] = newParentIndex;
+	}
+	else
+	{
+		m_root = newParentIndex;
+	}
+
+	m_nodes[ siblingIndex ].parent = newParentIndex;
+	m_nodes[ leafIndex ].parent = newParentIndex;
+
+	// Refit the ancestors of the new leaf.
+	Refit( newParentIndex );
+}
+
+/// Remove a leaf node from the tree hierarchy.
+///
+/// @param[in] leafIndex  Index of the leaf node to remove.
+///
+/// @see InsertLeaf()
+void AabbTree::RemoveLeaf( size_t leafIndex )
+{
+	if( leafIndex == m_root )
+	{
+		SetInvalid( m_root );
+
+		return;
+	}
+
+	size_t parentIndex = m_nodes[ leafIndex ].parent;
+	HELIUM_ASSERT( IsValid( parentIndex ) );
+
+	const Node& rParent = m_nodes[ parentIndex ];
+	size_t grandParentIndex = rParent.parent;
+	size_t siblingIndex = rParent.children[ rParent.children[ 0 ] == leafIndex ? 1 : 0 ];
+
+	// Replace the parent with the leaf's sibling.
+	if( IsValid( grandParentIndex ) )
+	{
+		Node& rGrandParent = m_nodes[ grandParentIndex ];
+		rGrandParent.children[ rGrandParent.children[ 0 ] == parentIndex ? 0 : 1 ] = siblingIndex;
+		m_nodes[ siblingIndex ].parent = grandParentIndex;
+		FreeNode( parentIndex );
+
+		Refit( grandParentIndex );
+	}
+	else
+	{
+		m_root = siblingIndex;
+		SetInvalid( m_nodes[ siblingIndex ].parent );
+		FreeNode( parentIndex );
+	}
+
+	SetInvalid( m_nodes[ leafIndex ].parent );
+}
+
+/// Rebalance and update the bounds and heights of a node and all of its ancestors.
+///
+/// @param[in] nodeIndex  Index of the first node to refit.
+void AabbTree::Refit( size_t nodeIndex )
+{
+	while( IsValid( nodeIndex ) )
+	{
+		nodeIndex = Balance( nodeIndex );
+
+		Node& rNode = m_nodes[ nodeIndex ];
+		const Node& rChild0 = m_nodes[ rNode.children[ 0 ] ];
+		const Node& rChild1 = m_nodes[ rNode.children[ 1 ] ];
+
+		rNode.height = 1 + Max( rChild0.height, rChild1.height );
+		rNode.box = CombineBoxes( rChild0.box, rChild1.box );
+
+		nodeIndex = rNode.parent;
+	}
+}
+
+/// Perform a tree rotation at the given node if its subtrees are imbalanced.
+///
+/// @param[in] nodeIndex  Index of the node to balance.
+///
+/// @return  Index of the node that has taken the place of the specified node in the tree.
+size_t AabbTree::Balance( size_t nodeIndex )
+{
+	size_t indexA = nodeIndex;
+	Node& rA = m_nodes[ indexA ];
+	if( rA.IsLeaf() || rA.height < 2 )
+	{
+		return indexA;
+	}
+
+	size_t indexB = rA.children[ 0 ];
+	size_t indexC = rA.children[ 1 ];
+	Node& rB = m_nodes[ indexB ];
+	Node& rC = m_nodes[ indexC ];
+
+	int32_t balance = rC.height - rB.height;
+
+	// Rotate C up.
+	if( balance > 1 )
+	{
+		size_t indexF = rC.children[ 0 ];
+		size_t indexG = rC.children[ 1 ];
+		Node& rF = m_nodes[ indexF ];
+		Node& rG = m_nodes[ indexG ];
+
+		// Swap A and C.
+		rC.children[ 0 ] = indexA;
+		rC.parent = rA.parent;
+		rA.parent = indexC;
+
+		if( IsValid( rC.parent ) )
+		{
+			Node& rParent = m_nodes[ rC.parent ];
+			rParent.children[ rParent.children[ 0 ] == indexA ? 0 : 1 ] = indexC;
+		}
+		else
+		{
+			m_root = indexC;
+		}
+
+		// Rotate.
+		if( rF.height > rG.height )
+		{
+			rC.children[ 1 ] = indexF;
+			rA.children[ 1 ] = indexG;
+			rG.parent = indexA;
+
+			rA.box = CombineBoxes( rB.box, rG.box );
+			rC.box = CombineBoxes( rA.box, rF.box );
+
+			rA.height = 1 + Max( rB.height, rG.height );
+			rC.height = 1 + Max( rA.height, rF.height );
+		}
+		else
+		{
+			rC.children[ 1 ] = indexG;
+			rA.children[ 1 ] = indexF;
+			rF.parent = indexA;
+
+			rA.box = CombineBoxes( rB.box, rF.box );
+			rC.box = CombineBoxes( rA.box, rG.box );
+
+			rA.height = 1 + Max( rB.height, rF.height );
+			rC.height = 1 + Max( rA.height, rG.height );
+		}
+
+		return indexC;
+	}
+
+	// Rotate B up.
+	if( balance < -1 )
+	{
+		size_t indexD = rB.children[ 0 ];
+		size_t indexE = rB.children[ 1 ];
+		Node& rD = m_nodes[ indexD ];
+		Node& rE = m_nodes[ indexE ];
+
+		// Swap A and B.
+		rB.children[ 0 ] = indexA;
+		rB.parent = rA.parent;
+		rA.parent = indexB;
+
+		if( IsValid( rB.parent ) )
+		{
+			Node& rParent = m_nodes[ rB.parent ];
+			rParent.children[ rParent.children[ 0 ] == indexA ? 0 : 1 ] = indexB;
+		}
+		else
+		{
+			m_root = indexB;
+		}
+
+		// Rotate.
+		if( rD.height > rE.height )
+		{
+			rB.children[ 1 ] = indexD;
+			rA.children[ 0 ] = indexE;
+			rE.parent = indexA;
+
+			rA.box = CombineBoxes( rC.box, rE.box );
+			rB.box = CombineBoxes( rA.box, rD.box );
+
+			rA.height = 1 + Max( rC.height, rE.height );
+			rB.height = 1 + Max( rA.height, rD.height );
+		}
+		else
+		{
+			rB.children[ 1 ] = indexE;
+			rA.children[ 0 ] = indexD;
+			rD.parent = indexA;
+
+			rA.box = CombineBoxes( rC.box, rD.box );
+			rB.box = CombineBoxes( rA.box, rE.box );
+
+			rA.height = 1 + Max( rC.height, rD.height );
+			rB.height = 1 + Max( rA.height, rE.height );
+		}
+
+		return indexB;
+	}
+
+	return indexA;
+}
+
+/// Add the user data for every leaf in a subtree to an array.
+///
+/// @param[in]  nodeIndex  Index of the root node of the subtree.
+/// @param[out] rResults   Array to which leaf user data should be appended.
+void AabbTree::AddSubtreeLeaves( size_t nodeIndex, DynamicArray< size_t >& rResults )
+{
+	m_subtreeStack.Resize( 0 );
+	m_subtreeStack.Push( nodeIndex );
+
+	while( m_subtreeStack.GetSize() != 0 )
+	{
+		size_t subtreeNodeIndex = m_subtreeStack.GetLast();
+		m_subtreeStack.Pop();
+
+		const Node& rNode = m_nodes[ subtreeNodeIndex ];
+		if( rNode.IsLeaf() )
+		{
+			rResults.Push( rNode.userData );
+		}
+		else
+		{
+			m_subtreeStack.Push( rNode.children[ 0 ] );
+			m_subtreeStack.Push( rNode.children[ 1 ] );
+		}
+	}
+}
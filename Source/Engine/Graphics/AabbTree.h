@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/AaBox.h"
+
+namespace Helium
+{
+	namespace Simd
+	{
+		class Frustum;
+	}
+
+	/// Dynamic bounding volume hierarchy of axis-aligned bounding boxes.
+	///
+	/// Each leaf stores a box and an arbitrary user data value (i.e. a scene object ID).  Leaf boxes are enlarged by a
+	/// margin when inserted so that small changes in bounds do not require the tree to be modified.  When a leaf's
+	/// bounds move outside its enlarged box, the leaf is removed and reinserted, and the boxes of its ancestors are
+	/// refit along the way.  Insertion uses a surface area heuristic to choose sibling nodes, and tree rotations keep
+	/// the hierarchy balanced.
+	class HELIUM_GRAPHICS_API AabbTree : NonCopyable
+	{
+	public:
+		/// Amount by which leaf boxes are enlarged on each axis, as a fraction of the box size along that axis.
+		static const float32_t LEAF_MARGIN_SCALE;
+		/// Minimum amount by which leaf boxes are enlarged on each axis.
+		static const float32_t LEAF_MARGIN_MIN;
+
+		/// @name Construction/Destruction
+		//@{
+		AabbTree();
+		~AabbTree();
+		//@}
+
+		/// @name Leaf Management
+		//@{
+		size_t CreateLeaf( const Simd::AaBox& rBox, size_t userData );
+		void DestroyLeaf( size_t leafId );
+		bool MoveLeaf( size_t leafId, const Simd::AaBox& rBox );
+
+		inline size_t GetUserData( size_t leafId ) const;
+		inline const Simd::AaBox& GetLeafBox( size_t leafId ) const;
+		inline size_t GetLeafCount() const;
+		inline size_t GetHeight() const;
+		//@}
+
+		/// @name Queries
+		//@{
+		void QueryFrustum(
+			const Simd::Frustum& rFrustum, DynamicArray< size_t >& rContained, DynamicArray< size_t >& rIntersecting );
+		//@}
+
+	private:
+		/// Tree node.
+		struct Node
+		{
+			/// Node bounds (enlarged by the leaf margin for leaf nodes).
+			Simd::AaBox box;
+			/// Parent node index (or the next node in the free list for unused nodes).
+			size_t parent;
+			/// Child node indices (invalid for leaf nodes).
+			size_t children[ 2 ];
+			/// User data (leaf nodes only).
+			size_t userData;
+			/// Height of the node within the tree (zero for leaf nodes, -1 for unused nodes).
+			int32_t height;
+
+			inline bool IsLeaf() const;
+		};
+
+		/// Tree nodes.
+		DynamicArray< Node > m_nodes;
+		/// Root node index.
+		size_t m_root;
+		/// First node index in the free node list.
+		size_t m_freeList;
+		/// Number of leaf nodes in the tree.
+		size_t m_leafCount;
+
+		/// Node traversal stack (scratch buffer for queries).
+		DynamicArray< size_t > m_traversalStack;
+		/// Subtree traversal stack (scratch buffer for queries).
+		DynamicArray< size_t > m_subtreeStack;
+
+		/// @name Private Utility Functions
+		//@{
+		size_t AllocateNode();
+		void FreeNode( size_t nodeIndex );
+
+		void InsertLeaf( size_t leafIndex );
+		void RemoveLeaf( size_t leafIndex );
+		void Refit( size_t nodeIndex );
+		size_t Balance( size_t nodeIndex );
+
+		void AddSubtreeLeaves( size_t nodeIndex, DynamicArray< size_t >& rResults );
+		//@}
+	};
+}
+
+#include "Graphics/AabbTree.inl"
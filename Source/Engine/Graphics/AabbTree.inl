@@ -0,0 +1,56 @@
+namespace Helium
+{
+	/// Get the user data associated with a leaf.
+	///
+	/// @param[in] leafId  Leaf ID.
+	///
+	/// @return  Leaf user data.
+	///
+	/// @see GetLeafBox()
+	size_t AabbTree::GetUserData( size_t leafId ) const
+	{
+		HELIUM_ASSERT( leafId < m_nodes.GetSize() );
+		HELIUM_ASSERT( m_nodes[ leafId ].IsLeaf() );
+
+		return m_nodes[ leafId ].userData;
+	}
+
+	/// Get the enlarged bounding box stored for a leaf.
+	///
+	/// @param[in] leafId  Leaf ID.
+	///
+	/// @return  Leaf bounding box, including the leaf margin.
+	///
+	/// @see GetUserData()
+	const Simd::AaBox& AabbTree::GetLeafBox( size_t leafId ) const
+	{
+		HELIUM_ASSERT( leafId < m_nodes.GetSize() );
+		HELIUM_ASSERT( m_nodes[ leafId ].IsLeaf() );
+
+		return m_nodes[ leafId ].box;
+	}
+
+	/// Get the number of leaves in the tree.
+	///
+	/// @return  Leaf count.
+	size_t AabbTree::GetLeafCount() const
+	{
+		return m_leafCount;
+	}
+
+	/// Get the height of the tree.
+	///
+	/// @return  Height of the root node, or zero if the tree is empty.
+	size_t AabbTree::GetHeight() const
+	{
+		return ( IsValid( m_root ) ? static_cast< size_t >( m_nodes[ m_root ].height ) : 0 );
+	}
+
+	/// Get whether this node is a leaf node.
+	///
+	/// @return  True if this is a leaf node, false if not.
+	bool AabbTree::Node::IsLeaf() const
+	{
+		return IsInvalid( children[ 0 ] );
+	}
+}
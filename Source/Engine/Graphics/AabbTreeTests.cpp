@@ -0,0 +1,182 @@
+#include "Graphics/AabbTree.h"
+
+#include "MathSimd/Frustum.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+/// Create a cube centered at the given position.
+static Simd::AaBox MakeCube( float32_t x, float32_t y, float32_t z, float32_t halfSize )
+{
+	return Simd::AaBox(
+		Simd::Vector3( x - halfSize, y - halfSize, z - halfSize ),
+		Simd::Vector3( x + halfSize, y + halfSize, z + halfSize ) );
+}
+
+/// Check whether an array contains a given value.
+static bool Contains( const DynamicArray< size_t >& rValues, size_t value )
+{
+	size_t valueCount = rValues.GetSize();
+	for( size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex )
+	{
+		if( rValues[ valueIndex ] == value )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Query the tree with the frustum covering x and y from -1 to 1 and z from 0 to 1 (the clip volume of an identity
+/// view/projection transform).
+static void QueryUnitFrustum( AabbTree& rTree, DynamicArray< size_t >& rContained, DynamicArray< size_t >& rIntersecting )
+{
+	Simd::Frustum frustum( Simd::Matrix44::IDENTITY );
+
+	rContained.Resize( 0 );
+	rIntersecting.Resize( 0 );
+	rTree.QueryFrustum( frustum, rContained, rIntersecting );
+}
+
+TEST( AabbTree, CreateAndDestroyLeaves )
+{
+	AabbTree tree;
+	EXPECT_EQ( 0u, tree.GetLeafCount() );
+
+	size_t leafIds[ 16 ];
+	for( size_t leafIndex = 0; leafIndex < 16; ++leafIndex )
+	{
+		leafIds[ leafIndex ] = tree.CreateLeaf( MakeCube( static_cast< float32_t >( leafIndex ), 0.0f, 0.0f, 0.25f ), leafIndex );
+		EXPECT_EQ( leafIndex, tree.GetUserData( leafIds[ leafIndex ] ) );
+	}
+
+	EXPECT_EQ( 16u, tree.GetLeafCount() );
+
+	// Insertion keeps the tree balanced.
+	EXPECT_LE( tree.GetHeight(), 8u );
+
+	// Leaf boxes are enlarged, so they always contain the box they were created with.
+	for( size_t leafIndex = 0; leafIndex < 16; ++leafIndex )
+	{
+		const Simd::AaBox& rLeafBox = tree.GetLeafBox( leafIds[ leafIndex ] );
+		Simd::AaBox sourceBox = MakeCube( static_cast< float32_t >( leafIndex ), 0.0f, 0.0f, 0.25f );
+		for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+		{
+			EXPECT_LE( rLeafBox.GetMinimum().GetElement( axisIndex ), sourceBox.GetMinimum().GetElement( axisIndex ) );
+			EXPECT_GE( rLeafBox.GetMaximum().GetElement( axisIndex ), sourceBox.GetMaximum().GetElement( axisIndex ) );
+		}
+	}
+
+	for( size_t leafIndex = 0; leafIndex < 16; leafIndex += 2 )
+	{
+		tree.DestroyLeaf( leafIds[ leafIndex ] );
+	}
+
+	EXPECT_EQ( 8u, tree.GetLeafCount() );
+	for( size_t leafIndex = 1; leafIndex < 16; leafIndex += 2 )
+	{
+		EXPECT_EQ( leafIndex, tree.GetUserData( leafIds[ leafIndex ] ) );
+	}
+}
+
+TEST( AabbTree, QueryFrustum )
+{
+	AabbTree tree;
+
+	// Inside the frustum, straddling its right edge, and outside of it.
+	tree.CreateLeaf( MakeCube( 0.0f, 0.0f, 0.5f, 0.1f ), 1 );
+	tree.CreateLeaf( MakeCube( 1.0f, 0.0f, 0.5f, 0.1f ), 2 );
+	tree.CreateLeaf( MakeCube( 5.0f, 0.0f, 0.5f, 0.1f ), 3 );
+	tree.CreateLeaf( MakeCube( 0.0f, 0.0f, -5.0f, 0.1f ), 4 );
+
+	DynamicArray< size_t > contained;
+	DynamicArray< size_t > intersecting;
+	QueryUnitFrustum( tree, contained, intersecting );
+
+	EXPECT_TRUE( Contains( contained, 1 ) );
+	EXPECT_FALSE( Contains( intersecting, 1 ) );
+
+	EXPECT_TRUE( Contains( intersecting, 2 ) );
+	EXPECT_FALSE( Contains( contained, 2 ) );
+
+	EXPECT_FALSE( Contains( contained, 3 ) || Contains( intersecting, 3 ) );
+	EXPECT_FALSE( Contains( contained, 4 ) || Contains( intersecting, 4 ) );
+}
+
+TEST( AabbTree, MoveLeaf )
+{
+	AabbTree tree;
+
+	size_t leafId = tree.CreateLeaf( MakeCube( 0.0f, 0.0f, 0.5f, 0.1f ), 7 );
+	for( size_t leafIndex = 0; leafIndex < 8; ++leafIndex )
+	{
+		tree.CreateLeaf( MakeCube( 10.0f + static_cast< float32_t >( leafIndex ), 0.0f, 0.5f, 0.1f ), 100 + leafIndex );
+	}
+
+	// Small moves stay within the enlarged leaf box and leave the tree untouched.
+	EXPECT_FALSE( tree.MoveLeaf( leafId, MakeCube( 0.01f, 0.0f, 0.5f, 0.1f ) ) );
+
+	// Moving the leaf out of the frustum removes it from the query results.
+	EXPECT_TRUE( tree.MoveLeaf( leafId, MakeCube( -20.0f, 0.0f, 0.5f, 0.1f ) ) );
+	EXPECT_EQ( 7u, tree.GetUserData( leafId ) );
+	EXPECT_EQ( 9u, tree.GetLeafCount() );
+
+	DynamicArray< size_t > contained;
+	DynamicArray< size_t > intersecting;
+	QueryUnitFrustum( tree, contained, intersecting );
+	EXPECT_EQ( 0u, contained.GetSize() );
+	EXPECT_EQ( 0u, intersecting.GetSize() );
+
+	// Moving it back makes it visible again.
+	EXPECT_TRUE( tree.MoveLeaf( leafId, MakeCube( 0.0f, 0.0f, 0.5f, 0.1f ) ) );
+
+	QueryUnitFrustum( tree, contained, intersecting );
+	EXPECT_TRUE( Contains( contained, 7 ) );
+	EXPECT_EQ( 1u, contained.GetSize() + intersecting.GetSize() );
+}
+
+TEST( AabbTree, QueryMatchesBruteForce )
+{
+	AabbTree tree;
+
+	// Scatter leaves across a grid larger than the frustum.
+	static const size_t GRID_SIZE = 12;
+	for( size_t gridY = 0; gridY < GRID_SIZE; ++gridY )
+	{
+		for( size_t gridX = 0; gridX < GRID_SIZE; ++gridX )
+		{
+			float32_t x = static_cast< float32_t >( gridX ) * 0.4f - 2.2f;
+			float32_t y = static_cast< float32_t >( gridY ) * 0.4f - 2.2f;
+			tree.CreateLeaf( MakeCube( x, y, 0.5f, 0.05f ), gridY * GRID_SIZE + gridX );
+		}
+	}
+
+	EXPECT_EQ( GRID_SIZE * GRID_SIZE, tree.GetLeafCount() );
+
+	DynamicArray< size_t > contained;
+	DynamicArray< size_t > intersecting;
+	QueryUnitFrustum( tree, contained, intersecting );
+
+	// Every leaf whose box touches the frustum must be reported exactly once.
+	Simd::Frustum frustum( Simd::Matrix44::IDENTITY );
+	for( size_t gridY = 0; gridY < GRID_SIZE; ++gridY )
+	{
+		for( size_t gridX = 0; gridX < GRID_SIZE; ++gridX )
+		{
+			float32_t x = static_cast< float32_t >( gridX ) * 0.4f - 2.2f;
+			float32_t y = static_cast< float32_t >( gridY ) * 0.4f - 2.2f;
+			size_t userData = gridY * GRID_SIZE + gridX;
+
+			bool bContained = Contains( contained, userData );
+			bool bIntersecting = Contains( intersecting, userData );
+			EXPECT_FALSE( bContained && bIntersecting ) << "Leaf " << userData;
+
+			if( frustum.Intersects( MakeCube( x, y, 0.5f, 0.05f ) ) )
+			{
+				EXPECT_TRUE( bContained || bIntersecting ) << "Leaf " << userData;
+			}
+		}
+	}
+}
@@ -1,12 +1,17 @@
 #include "Precompile.h"
 #include "Graphics/Animation.h"
 
+#include "Reflect/TranslatorDeduction.h"
+
 #if HELIUM_USE_GRANNY_ANIMATION
 #include "GrannyAnimationInterface.h"
 #include "GrannyAnimationInterface.cpp.inl"
 #endif
 
 HELIUM_IMPLEMENT_ASSET( Helium::Animation, Graphics, AssetType::FLAG_NO_TEMPLATE );
+#if !HELIUM_USE_GRANNY_ANIMATION
+HELIUM_DEFINE_CLASS( Helium::Animation::PersistentResourceData );
+#endif
 
 using namespace Helium;
 
@@ -27,3 +32,124 @@ Name Animation::GetCacheName() const
 
     return cacheName;
 }
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+/// @copydoc Resource::LoadPersistentResourceObject()
+bool Animation::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+{
+    HELIUM_ASSERT( _object.ReferencesObject() );
+    if( !_object.ReferencesObject() )
+    {
+        return false;
+    }
+
+    _object->CopyTo( &m_persistentResourceData );
+
+    const PersistentResourceData& rData = m_persistentResourceData;
+    size_t trackCount = rData.m_trackNames.GetSize();
+    size_t keyCount = rData.m_keySamples.GetSize();
+    size_t keyWordCount = keyCount * AnimationClipData::KEY_CHANNEL_WORD_COUNT;
+    size_t rangeFloatCount = trackCount * AnimationClipData::RANGE_FLOAT_COUNT;
+    if( rData.m_keyOffsets.GetSize() != trackCount + 1 ||
+        rData.m_keyOffsets[ trackCount ] != keyCount ||
+        rData.m_rotationKeys.GetSize() != keyWordCount ||
+        rData.m_translationKeys.GetSize() != keyWordCount ||
+        rData.m_scaleKeys.GetSize() != keyWordCount ||
+        rData.m_translationRanges.GetSize() != rangeFloatCount ||
+        rData.m_scaleRanges.GetSize() != rangeFloatCount )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            "Animation::LoadPersistentResourceObject(): Inconsistent key data in animation \"%s\".\n",
+            *GetPath().ToString() );
+
+        m_persistentResourceData.m_trackNames.Clear();
+        m_persistentResourceData.m_keyOffsets.Clear();
+        m_persistentResourceData.m_sampleCount = 0;
+
+        return false;
+    }
+
+    return true;
+}
+
+/// Get a view of the compressed key data for sampling this animation.
+///
+/// The clip data references the key arrays owned by this animation, so it is only valid for as long as this
+/// animation remains loaded.
+///
+/// @param[out] rClipData  Clip data.
+void Animation::GetClipData( AnimationClipData& rClipData ) const
+{
+    const PersistentResourceData& rData = m_persistentResourceData;
+
+    rClipData.sampleRate = rData.m_sampleRate;
+    rClipData.sampleCount = rData.m_sampleCount;
+    rClipData.trackCount = static_cast< uint32_t >( rData.m_trackNames.GetSize() );
+    rClipData.pKeyOffsets = rData.m_keyOffsets.GetData();
+    rClipData.pKeySamples = rData.m_keySamples.GetData();
+    rClipData.pRotationKeys = rData.m_rotationKeys.GetData();
+    rClipData.pTranslationKeys = rData.m_translationKeys.GetData();
+    rClipData.pScaleKeys = rData.m_scaleKeys.GetData();
+    rClipData.pTranslationRanges = rData.m_translationRanges.GetData();
+    rClipData.pScaleRanges = rData.m_scaleRanges.GetData();
+}
+
+/// Build the table mapping the bones of a skeleton to the tracks in this animation.
+///
+/// Tracks are matched to bones by name.  Bones without a matching track are given an invalid track index, in which
+/// case they keep their reference pose transform when sampled.
+///
+/// @param[in]  pBoneNames         Skeleton bone names.
+/// @param[in]  boneCount          Number of bones in the skeleton.
+/// @param[out] pBoneTrackIndices  Track index of each bone.
+///
+/// @see AnimationClipData::Sample()
+void Animation::BuildBoneTrackMap( const Name* pBoneNames, uint8_t boneCount, uint16_t* pBoneTrackIndices ) const
+{
+    HELIUM_ASSERT( pBoneNames || boneCount == 0 );
+    HELIUM_ASSERT( pBoneTrackIndices || boneCount == 0 );
+
+    const DynamicArray< Name >& rTrackNames = m_persistentResourceData.m_trackNames;
+    size_t trackCount = rTrackNames.GetSize();
+
+    for( uint8_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+    {
+        uint16_t trackIndex = Invalid< uint16_t >();
+
+        Name boneName = pBoneNames[ boneIndex ];
+        for( size_t trackIndexCheck = 0; trackIndexCheck < trackCount; ++trackIndexCheck )
+        {
+            if( rTrackNames[ trackIndexCheck ] == boneName )
+            {
+                trackIndex = static_cast< uint16_t >( trackIndexCheck );
+
+                break;
+            }
+        }
+
+        pBoneTrackIndices[ boneIndex ] = trackIndex;
+    }
+}
+
+/// Constructor.
+Animation::PersistentResourceData::PersistentResourceData()
+: m_sampleRate( 0.0f )
+, m_sampleCount( 0 )
+{
+}
+
+void Animation::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+    comp.AddField( &PersistentResourceData::m_trackNames,           "m_trackNames" );
+    comp.AddField( &PersistentResourceData::m_keyOffsets,           "m_keyOffsets" );
+    comp.AddField( &PersistentResourceData::m_keySamples,           "m_keySamples" );
+    comp.AddField( &PersistentResourceData::m_rotationKeys,         "m_rotationKeys" );
+    comp.AddField( &PersistentResourceData::m_translationKeys,      "m_translationKeys" );
+    comp.AddField( &PersistentResourceData::m_scaleKeys,            "m_scaleKeys" );
+    comp.AddField( &PersistentResourceData::m_translationRanges,    "m_translationRanges" );
+    comp.AddField( &PersistentResourceData::m_scaleRanges,          "m_scaleRanges" );
+    comp.AddField( &PersistentResourceData::m_sampleRate,           "m_sampleRate" );
+    comp.AddField( &PersistentResourceData::m_sampleCount,          "m_sampleCount" );
+}
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
@@ -4,6 +4,7 @@
 #include "Engine/Resource.h"
 
 #include "GraphicsTypes/GraphicsTypes.h"
+#include "GraphicsTypes/AnimationClipData.h"
 
 #if HELIUM_USE_GRANNY_ANIMATION
 #include "GrannyAnimationInterface.h"
@@ -17,12 +18,54 @@ namespace Helium
         HELIUM_DECLARE_ASSET( Animation, Resource );
 
     public:
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// Persistent animation resource data.
+        ///
+        /// All channels of a track share the same key times.  See AnimationClipData for details on the key encoding.
+        struct HELIUM_GRAPHICS_API PersistentResourceData : public Object
+        {
+            HELIUM_DECLARE_CLASS(Animation::PersistentResourceData, Reflect::Object);
+
+            PersistentResourceData();
+            static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+            /// Name of the bone animated by each track.
+            DynamicArray< Name > m_trackNames;
+            /// Index of the first key of each track (plus the total key count).
+            DynamicArray< uint32_t > m_keyOffsets;
+            /// Source sample index of each key.
+            DynamicArray< uint16_t > m_keySamples;
+            /// Packed key rotations.
+            DynamicArray< uint16_t > m_rotationKeys;
+            /// Quantized key translations.
+            DynamicArray< uint16_t > m_translationKeys;
+            /// Quantized key scales.
+            DynamicArray< uint16_t > m_scaleKeys;
+            /// Translation quantization range of each track.
+            DynamicArray< float32_t > m_translationRanges;
+            /// Scale quantization range of each track.
+            DynamicArray< float32_t > m_scaleRanges;
+
+            /// Number of samples per second in the source animation.
+            float32_t m_sampleRate;
+            /// Number of samples in the source animation.
+            uint32_t m_sampleCount;
+        };
+#endif
+
         /// @name Construction/Destruction
         //@{
         Animation();
         virtual ~Animation();
         //@}
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// @name Resource Serialization
+        //@{
+        virtual bool LoadPersistentResourceObject( Reflect::ObjectPtr& _object ) override;
+        //@}
+#endif
+
         /// @name Resource Caching Support
         //@{
         virtual Name GetCacheName() const override;
@@ -32,6 +75,12 @@ namespace Helium
         //@{
 #if HELIUM_USE_GRANNY_ANIMATION
         inline const Granny::AnimationData& GetGrannyData() const;
+#else
+        inline size_t GetTrackCount() const;
+        inline Name GetTrackName( size_t trackIndex ) const;
+
+        void GetClipData( AnimationClipData& rClipData ) const;
+        void BuildBoneTrackMap( const Name* pBoneNames, uint8_t boneCount, uint16_t* pBoneTrackIndices ) const;
 #endif
         //@}
 
@@ -39,6 +88,9 @@ namespace Helium
 #if HELIUM_USE_GRANNY_ANIMATION
         /// Granny-specific animation data.
         Granny::AnimationData m_grannyData;
+#else
+        /// Persistent animation resource data.
+        PersistentResourceData m_persistentResourceData;
 #endif
     };
 }
@@ -8,5 +8,29 @@ namespace Helium
     {
         return m_grannyData;
     }
+#else  // HELIUM_USE_GRANNY_ANIMATION
+    /// Get the number of tracks in this animation.
+    ///
+    /// @return  Track count.
+    ///
+    /// @see GetTrackName()
+    size_t Animation::GetTrackCount() const
+    {
+        return m_persistentResourceData.m_trackNames.GetSize();
+    }
+
+    /// Get the name of the bone animated by a given track.
+    ///
+    /// @param[in] trackIndex  Track index.
+    ///
+    /// @return  Bone name.
+    ///
+    /// @see GetTrackCount()
+    Name Animation::GetTrackName( size_t trackIndex ) const
+    {
+        HELIUM_ASSERT( trackIndex < m_persistentResourceData.m_trackNames.GetSize() );
+
+        return m_persistentResourceData.m_trackNames[ trackIndex ];
+    }
 #endif  // HELIUM_USE_GRANNY_ANIMATION
 }
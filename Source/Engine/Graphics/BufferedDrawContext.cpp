@@ -0,0 +1,663 @@
+#include "Precompile.h"
+#include "Graphics/BufferedDrawContext.h"
+
+#include "Rendering/Renderer.h"
+#include "Rendering/RendererUtil.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RTexture2d.h"
+#include "Rendering/RVertexBuffer.h"
+
+using namespace Helium;
+
+/// Append a copy of draw calls recorded in another context, offsetting their vertex and index ranges to account for
+/// the vertices and indices already recorded in the destination context.
+///
+/// @param[in] rDestination   Draw calls to which the copies should be appended.
+/// @param[in] rSource        Draw calls to copy.
+/// @param[in] vertexOffset   Offset to apply to the base vertex index of each draw call.
+/// @param[in] indexOffset    Offset to apply to the start index of each indexed draw call.
+template< typename T >
+static void AppendDrawCalls(
+	DynamicArray< T >& rDestination,
+	const DynamicArray< T >& rSource,
+	uint32_t vertexOffset,
+	uint32_t indexOffset )
+{
+	size_t drawIndex = rDestination.GetSize();
+	rDestination.AddArray( rSource.GetData(), rSource.GetSize() );
+
+	size_t drawCount = rDestination.GetSize();
+	for( ; drawIndex < drawCount; ++drawIndex )
+	{
+		T& rDrawCall = rDestination[ drawIndex ];
+		rDrawCall.baseVertexIndex += vertexOffset;
+		if( IsValid( rDrawCall.startIndex ) )
+		{
+			rDrawCall.startIndex += indexOffset;
+		}
+	}
+}
+
+/// Constructor.
+BufferedDrawContext::BufferedDrawContext()
+	: m_bDrawing( false )
+{
+}
+
+/// Destructor.
+BufferedDrawContext::~BufferedDrawContext()
+{
+}
+
+/// Buffer an untextured primitive draw call.
+///
+/// @param[in] primitiveType      Type of primitive to draw.
+/// @param[in] pVertices          Vertices to use for drawing.
+/// @param[in] vertexCount        Number of vertices used for drawing.
+/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
+/// @param[in] primitiveCount     Number of primitives to draw.
+/// @param[in] blendColor         Color with which to blend each vertex color.
+/// @param[in] rasterizerState    Rasterizer state to use during rendering.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @see DrawTextured(), DrawPoints()
+void BufferedDrawContext::DrawUntextured(
+	ERendererPrimitiveType primitiveType,
+	const Simd::Matrix44& rTransform, 
+	const SimpleVertex* pVertices,
+	uint32_t vertexCount,
+	const uint32_t* pIndices,
+	uint32_t primitiveCount,
+	Color blendColor,
+	RenderResourceManager::ERasterizerState rasterizerState,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+	HELIUM_ASSERT( pVertices );
+	HELIUM_ASSERT( vertexCount );
+	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
+	HELIUM_ASSERT( primitiveCount );
+	HELIUM_ASSERT(
+		static_cast< size_t >( rasterizerState ) <
+		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	uint32_t baseVertexIndex = static_cast< uint32_t >( m_untexturedVertices.GetSize() );
+	m_untexturedVertices.AddArray( pVertices, vertexCount );
+
+	uint32_t startIndex;
+	SetInvalid( startIndex );
+	if( pIndices )
+	{
+		startIndex = static_cast< uint32_t >( m_untexturedIndices.GetSize() );
+		m_untexturedIndices.AddArray(
+			pIndices,
+			RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
+	}
+
+	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
+	UntexturedDrawCall* pDrawCall = m_untexturedDrawCalls[ stateIndex ].New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->transform = rTransform;
+	pDrawCall->primitiveType = primitiveType;
+	pDrawCall->baseVertexIndex = baseVertexIndex;
+	pDrawCall->vertexCount = vertexCount;
+	pDrawCall->startIndex = startIndex;
+	pDrawCall->primitiveCount = primitiveCount;
+	pDrawCall->blendColor = blendColor;
+}
+
+/// Buffer an untextured primitive draw call.
+///
+/// @param[in] primitiveType      Type of primitive to draw.
+/// @param[in] rTransform         World transform to apply when rendering.
+/// @param[in] pVertices          Vertex buffer to use for drawing.  This must contain a packed array of SimpleVertex
+///                               vertices.
+/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
+/// @param[in] baseVertexIndex    Index of the first vertex to use for rendering.  Index buffer values will be relative to
+///                               this vertex.
+/// @param[in] vertexCount        Number of vertices used for rendering.
+/// @param[in] startIndex         Index of the first index to use for drawing.
+/// @param[in] primitiveCount     Number of primitives to draw.
+/// @param[in] blendColor         Color with which to blend each vertex color.
+/// @param[in] rasterizerState    Rasterizer state to use during rendering.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @see DrawTextured(), DrawPoints()
+void BufferedDrawContext::DrawUntextured(
+	ERendererPrimitiveType primitiveType,
+	const Simd::Matrix44& rTransform,
+	RVertexBuffer* pVertices,
+	RIndexBuffer* pIndices,
+	uint32_t baseVertexIndex,
+	uint32_t vertexCount,
+	uint32_t startIndex,
+	uint32_t primitiveCount,
+	Color blendColor,
+	RenderResourceManager::ERasterizerState rasterizerState,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+	HELIUM_ASSERT( pVertices );
+	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
+	HELIUM_ASSERT( vertexCount );
+	HELIUM_ASSERT( primitiveCount );
+	HELIUM_ASSERT(
+		static_cast< size_t >( rasterizerState ) <
+		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
+	UntexturedBufferDrawCall* pDrawCall = m_untexturedBufferDrawCalls[ stateIndex ].New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->primitiveType = primitiveType;
+	pDrawCall->baseVertexIndex = baseVertexIndex;
+	pDrawCall->vertexCount = vertexCount;
+	pDrawCall->startIndex = startIndex;
+	pDrawCall->primitiveCount = primitiveCount;
+	pDrawCall->blendColor = blendColor;
+	pDrawCall->spVertexBuffer = pVertices;
+	pDrawCall->spIndexBuffer = pIndices;
+	pDrawCall->transform = rTransform;
+}
+
+/// Buffer a textured primitive draw call.
+///
+/// @param[in] primitiveType      Type of primitive to draw.
+/// @param[in] pVertices          Vertices to use for drawing.
+/// @param[in] vertexCount        Number of vertices used for drawing.
+/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
+/// @param[in] primitiveCount     Number of primitives to draw.
+/// @param[in] pTexture           Texture to apply to the mesh.
+/// @param[in] blendColor         Color with which to blend each vertex color.
+/// @param[in] rasterizerState    Rasterizer state to use during rendering.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @see DrawUntextured(), DrawPoints()
+void BufferedDrawContext::DrawTextured(
+	ERendererPrimitiveType primitiveType,
+	const Simd::Matrix44& rTransform,
+	const SimpleTexturedVertex* pVertices,
+	uint32_t vertexCount,
+	const uint32_t* pIndices,
+	uint32_t primitiveCount,
+	RTexture2d* pTexture,
+	Color blendColor,
+	RenderResourceManager::ERasterizerState rasterizerState,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+	HELIUM_ASSERT( pVertices );
+	HELIUM_ASSERT( vertexCount );
+	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
+	HELIUM_ASSERT( primitiveCount );
+	HELIUM_ASSERT( pTexture );
+	HELIUM_ASSERT(
+		static_cast< size_t >( rasterizerState ) <
+		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	uint32_t baseVertexIndex = static_cast< uint32_t >( m_texturedVertices.GetSize() );
+	m_texturedVertices.AddArray( pVertices, vertexCount );
+
+	uint32_t startIndex;
+	SetInvalid( startIndex );
+	if( pIndices )
+	{
+		startIndex = static_cast< uint32_t >( m_texturedIndices.GetSize() );
+		m_texturedIndices.AddArray(
+			pIndices,
+			RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
+	}
+
+	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
+	TexturedDrawCall* pDrawCall = m_texturedDrawCalls[ stateIndex ].New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->transform = rTransform;
+	pDrawCall->primitiveType = primitiveType;
+	pDrawCall->baseVertexIndex = baseVertexIndex;
+	pDrawCall->vertexCount = vertexCount;
+	pDrawCall->startIndex = startIndex;
+	pDrawCall->primitiveCount = primitiveCount;
+	pDrawCall->blendColor = blendColor;
+	pDrawCall->spTexture = pTexture;
+}
+
+/// Buffer a textured primitive draw call.
+///
+/// @param[in] primitiveType      Type of primitive to draw.
+/// @param[in] rTransform         World transform to apply when rendering.
+/// @param[in] pVertices          Vertex buffer to use for drawing.  This must contain a packed array of
+///                               SimpleTexturedVertex vertices.
+/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
+/// @param[in] baseVertexIndex    Index of the first vertex to use for rendering.  Index buffer values will be relative to
+///                               this vertex.
+/// @param[in] vertexCount        Number of vertices used for rendering.
+/// @param[in] startIndex         Index of the first index to use for drawing.
+/// @param[in] primitiveCount     Number of primitives to draw.
+/// @param[in] pTexture           Texture to apply to the mesh.
+/// @param[in] blendColor         Color with which to blend each vertex color.
+/// @param[in] rasterizerState    Rasterizer state to use during rendering.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @see DrawUntextured(), DrawPoints()
+void BufferedDrawContext::DrawTextured(
+	ERendererPrimitiveType primitiveType,
+	const Simd::Matrix44& rTransform,
+	RVertexBuffer* pVertices,
+	RIndexBuffer* pIndices,
+	uint32_t baseVertexIndex,
+	uint32_t vertexCount,
+	uint32_t startIndex,
+	uint32_t primitiveCount,
+	RTexture2d* pTexture,
+	Color blendColor,
+	RenderResourceManager::ERasterizerState rasterizerState,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+	HELIUM_ASSERT( pVertices );
+	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
+	HELIUM_ASSERT( vertexCount );
+	HELIUM_ASSERT( primitiveCount );
+	HELIUM_ASSERT( pTexture );
+	HELIUM_ASSERT(
+		static_cast< size_t >( rasterizerState ) <
+		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
+	TexturedBufferDrawCall* pDrawCall = m_texturedBufferDrawCalls[ stateIndex ].New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->primitiveType = primitiveType;
+	pDrawCall->baseVertexIndex = baseVertexIndex;
+	pDrawCall->vertexCount = vertexCount;
+	pDrawCall->startIndex = startIndex;
+	pDrawCall->primitiveCount = primitiveCount;
+	pDrawCall->blendColor = blendColor;
+	pDrawCall->spTexture = pTexture;
+	pDrawCall->spVertexBuffer = pVertices;
+	pDrawCall->spIndexBuffer = pIndices;
+	pDrawCall->transform = rTransform;
+}
+
+/// Buffer a point list draw call using points larger than a pixel.
+///
+/// @param[in] pVertices          Vertices to use for drawing.
+/// @param[in] pointCount         Number of points to draw.
+/// @param[in] blendColor         Color with which to blend each vertex color.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @see DrawUntextured(), DrawTextured()
+void BufferedDrawContext::DrawPoints(
+	const SimpleVertex* pVertices,
+	uint32_t pointCount,
+	Color blendColor,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( pVertices );
+	HELIUM_ASSERT( pointCount );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	uint32_t baseVertexIndex = static_cast< uint32_t >( m_untexturedVertices.GetSize() );
+	m_untexturedVertices.AddArray( pVertices, pointCount );
+
+	UntexturedDrawCall* pDrawCall = m_pointDrawCalls[ depthStencilState ].New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_POINT_LIST;
+	pDrawCall->baseVertexIndex = baseVertexIndex;
+	pDrawCall->vertexCount = pointCount;
+	SetInvalid( pDrawCall->startIndex );
+	pDrawCall->primitiveCount = pointCount;
+	pDrawCall->blendColor = blendColor;
+}
+
+/// Buffer a point list draw call using points larger than a pixel.
+///
+/// @param[in] rTransform         World transform to apply when rendering.
+/// @param[in] pVertices          Vertex buffer to use for drawing.  This must contain a packed array of SimpleVertex
+///                               vertices.
+/// @param[in] baseVertexIndex    Index of the first vertex to use for rendering.
+/// @param[in] pointCount         Number of points to draw.
+/// @param[in] blendColor         Color with which to blend each vertex color.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @see DrawUntextured(), DrawTextured()
+void BufferedDrawContext::DrawPoints(
+	const Simd::Matrix44& rTransform,
+	RVertexBuffer* pVertices,
+	uint32_t baseVertexIndex,
+	uint32_t pointCount,
+	Color blendColor,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( pVertices );
+	HELIUM_ASSERT( pointCount );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	UntexturedBufferDrawCall* pDrawCall = m_pointBufferDrawCalls[ depthStencilState ].New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_POINT_LIST;
+	pDrawCall->baseVertexIndex = baseVertexIndex;
+	pDrawCall->vertexCount = pointCount;
+	SetInvalid( pDrawCall->startIndex );
+	pDrawCall->primitiveCount = pointCount;
+	pDrawCall->blendColor = blendColor;
+	pDrawCall->spVertexBuffer = pVertices;
+	pDrawCall->spIndexBuffer = NULL;
+	pDrawCall->transform = rTransform;
+}
+/// Reserve space at the end of the buffered untextured vertices for a line list and buffer a draw call for it.
+///
+/// Vertices are written directly into the returned storage, avoiding the need to build them in a separate array
+/// first.  If the last line list buffered with the same states and blend color ends at the current end of the vertex
+/// storage, it is extended to include the new lines instead of adding another draw call.
+///
+/// @param[in] lineCount          Number of lines to draw.
+/// @param[in] blendColor         Color with which to blend each vertex color.
+/// @param[in] rasterizerState    Rasterizer state to use during rendering.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @return  Pointer to the storage for the line vertices (two per line, in world space), or null if no renderer is
+///          initialized.  The pointer is only valid until the next draw call is buffered.
+///
+/// @see DrawLineList()
+SimpleVertex* BufferedDrawContext::AllocateLineList(
+	uint32_t lineCount,
+	Color blendColor,
+	RenderResourceManager::ERasterizerState rasterizerState,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( lineCount );
+	HELIUM_ASSERT(
+		static_cast< size_t >( rasterizerState ) <
+		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return NULL;
+	}
+
+	uint32_t baseVertexIndex = static_cast< uint32_t >( m_untexturedVertices.GetSize() );
+	uint32_t vertexCount = lineCount * 2;
+
+	DynamicArray< UntexturedDrawCall >& rDrawCalls = m_untexturedDrawCalls[ GetStateIndex( rasterizerState, depthStencilState ) ];
+	size_t drawCallCount = rDrawCalls.GetSize();
+	UntexturedDrawCall* pDrawCall = ( drawCallCount != 0 ? &rDrawCalls[ drawCallCount - 1 ] : NULL );
+	if( pDrawCall &&
+		pDrawCall->primitiveType == RENDERER_PRIMITIVE_TYPE_LINE_LIST &&
+		IsInvalid( pDrawCall->startIndex ) &&
+		pDrawCall->baseVertexIndex + pDrawCall->vertexCount == baseVertexIndex &&
+		pDrawCall->blendColor.GetArgb() == blendColor.GetArgb() &&
+		pDrawCall->transform == Simd::Matrix44::IDENTITY )
+	{
+		pDrawCall->vertexCount += vertexCount;
+		pDrawCall->primitiveCount += lineCount;
+	}
+	else
+	{
+		pDrawCall = rDrawCalls.New();
+		HELIUM_ASSERT( pDrawCall );
+		pDrawCall->transform = Simd::Matrix44::IDENTITY;
+		pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_LINE_LIST;
+		pDrawCall->baseVertexIndex = baseVertexIndex;
+		pDrawCall->vertexCount = vertexCount;
+		SetInvalid( pDrawCall->startIndex );
+		pDrawCall->primitiveCount = lineCount;
+		pDrawCall->blendColor = blendColor;
+	}
+
+	m_untexturedVertices.Resize( baseVertexIndex + vertexCount );
+
+	return m_untexturedVertices.GetData() + baseVertexIndex;
+}
+
+/// Make sure the vertex and index storage can hold at least the given number of elements.
+///
+/// Storage is retained across frames, so this only needs to be called once (with an upper bound on a frame's
+/// workload) to avoid allocations while recording.
+///
+/// @param[in] untexturedVertexCount  Number of untextured vertices for which to reserve space.
+/// @param[in] texturedVertexCount    Number of textured vertices for which to reserve space.
+/// @param[in] indexCount             Number of indices for which to reserve space for both untextured and textured
+///                                   draw calls.
+void BufferedDrawContext::Reserve( uint32_t untexturedVertexCount, uint32_t texturedVertexCount, uint32_t indexCount )
+{
+	HELIUM_ASSERT( !m_bDrawing );
+
+	m_untexturedVertices.Reserve( untexturedVertexCount );
+	m_texturedVertices.Reserve( texturedVertexCount );
+	m_untexturedIndices.Reserve( indexCount );
+	m_texturedIndices.Reserve( indexCount );
+}
+
+/// Move all draw calls recorded in another context to the end of this context.
+///
+/// Draw calls are appended to the same state buckets they were recorded in, so they are rendered in the same relative
+/// order.  The source context is left empty, but keeps its storage for reuse.
+///
+/// @param[in] rContext  Context from which to take the recorded draw calls.
+void BufferedDrawContext::Append( BufferedDrawContext& rContext )
+{
+	HELIUM_ASSERT( &rContext != this );
+
+	uint32_t untexturedVertexOffset = static_cast< uint32_t >( m_untexturedVertices.GetSize() );
+	uint32_t texturedVertexOffset = static_cast< uint32_t >( m_texturedVertices.GetSize() );
+	uint32_t untexturedIndexOffset = static_cast< uint32_t >( m_untexturedIndices.GetSize() );
+	uint32_t texturedIndexOffset = static_cast< uint32_t >( m_texturedIndices.GetSize() );
+
+	m_untexturedVertices.AddArray( rContext.m_untexturedVertices.GetData(), rContext.m_untexturedVertices.GetSize() );
+	m_texturedVertices.AddArray( rContext.m_texturedVertices.GetData(), rContext.m_texturedVertices.GetSize() );
+	m_untexturedIndices.AddArray( rContext.m_untexturedIndices.GetData(), rContext.m_untexturedIndices.GetSize() );
+	m_texturedIndices.AddArray( rContext.m_texturedIndices.GetData(), rContext.m_texturedIndices.GetSize() );
+
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_untexturedDrawCalls ); ++stateIndex )
+	{
+		AppendDrawCalls(
+			m_untexturedDrawCalls[ stateIndex ],
+			rContext.m_untexturedDrawCalls[ stateIndex ],
+			untexturedVertexOffset,
+			untexturedIndexOffset );
+		AppendDrawCalls(
+			m_texturedDrawCalls[ stateIndex ],
+			rContext.m_texturedDrawCalls[ stateIndex ],
+			texturedVertexOffset,
+			texturedIndexOffset );
+
+		DynamicArray< UntexturedBufferDrawCall >& rUntexturedBufferDrawCalls = rContext.m_untexturedBufferDrawCalls[ stateIndex ];
+		m_untexturedBufferDrawCalls[ stateIndex ].AddArray(
+			rUntexturedBufferDrawCalls.GetData(),
+			rUntexturedBufferDrawCalls.GetSize() );
+
+		DynamicArray< TexturedBufferDrawCall >& rTexturedBufferDrawCalls = rContext.m_texturedBufferDrawCalls[ stateIndex ];
+		m_texturedBufferDrawCalls[ stateIndex ].AddArray(
+			rTexturedBufferDrawCalls.GetData(),
+			rTexturedBufferDrawCalls.GetSize() );
+	}
+
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_pointDrawCalls ); ++stateIndex )
+	{
+		AppendDrawCalls(
+			m_pointDrawCalls[ stateIndex ],
+			rContext.m_pointDrawCalls[ stateIndex ],
+			untexturedVertexOffset,
+			untexturedIndexOffset );
+
+		DynamicArray< UntexturedBufferDrawCall >& rPointBufferDrawCalls = rContext.m_pointBufferDrawCalls[ stateIndex ];
+		m_pointBufferDrawCalls[ stateIndex ].AddArray( rPointBufferDrawCalls.GetData(), rPointBufferDrawCalls.GetSize() );
+	}
+
+	rContext.RemoveAll();
+}
+
+/// Remove all buffered vertices, indices, and draw calls, keeping the allocated storage for reuse.
+///
+/// @see Clear()
+void BufferedDrawContext::RemoveAll()
+{
+	m_untexturedVertices.RemoveAll();
+	m_texturedVertices.RemoveAll();
+
+	m_untexturedIndices.RemoveAll();
+	m_texturedIndices.RemoveAll();
+
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_untexturedDrawCalls ); ++stateIndex )
+	{
+		m_texturedBufferDrawCalls[ stateIndex ].RemoveAll();
+		m_untexturedBufferDrawCalls[ stateIndex ].RemoveAll();
+
+		m_texturedDrawCalls[ stateIndex ].RemoveAll();
+		m_untexturedDrawCalls[ stateIndex ].RemoveAll();
+	}
+
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_pointDrawCalls ); ++stateIndex )
+	{
+		m_pointBufferDrawCalls[ stateIndex ].RemoveAll();
+		m_pointDrawCalls[ stateIndex ].RemoveAll();
+	}
+}
+
+/// Remove all buffered vertices, indices, and draw calls and free the allocated storage.
+///
+/// @see RemoveAll()
+void BufferedDrawContext::Clear()
+{
+	m_untexturedVertices.Clear();
+	m_texturedVertices.Clear();
+
+	m_untexturedIndices.Clear();
+	m_texturedIndices.Clear();
+
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_untexturedDrawCalls ); ++stateIndex )
+	{
+		m_untexturedDrawCalls[ stateIndex ].Clear();
+		m_texturedDrawCalls[ stateIndex ].Clear();
+
+		m_untexturedBufferDrawCalls[ stateIndex ].Clear();
+		m_texturedBufferDrawCalls[ stateIndex ].Clear();
+	}
+
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_pointDrawCalls ); ++stateIndex )
+	{
+		m_pointDrawCalls[ stateIndex ].Clear();
+		m_pointBufferDrawCalls[ stateIndex ].Clear();
+	}
+}
+
+/// Get the index into draw call arrays for the given rasterizer state and depth-stencil state combination.
+///
+/// @param[in] rasterizerState    Rasterizer state identifier.
+/// @param[in] depthStencilState  Depth-stencil state identifier.
+///
+/// @return  Array index for the given state combination.
+///
+/// @see GetStatesFromIndex()
+size_t BufferedDrawContext::GetStateIndex(
+	RenderResourceManager::ERasterizerState rasterizerState,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT(
+		static_cast< size_t >( rasterizerState ) <
+		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	return ( rasterizerState * RenderResourceManager::DEPTH_STENCIL_STATE_MAX + depthStencilState );
+}
+
+/// Get the rasterizer state and depth-stencil state identifiers for a given draw call array index.
+///
+/// @param[in]  stateIndex          Array index for a given state combination.
+/// @param[out] rRasterizerState    Rasterizer state associated with the given state index.
+/// @param[out] rDepthStencilState  Depth-stencil state associated with the given state index.
+///
+/// @see GetStateIndex()
+void BufferedDrawContext::GetStatesFromIndex(
+	size_t stateIndex,
+	RenderResourceManager::ERasterizerState& rRasterizerState,
+	RenderResourceManager::EDepthStencilState& rDepthStencilState )
+{
+	HELIUM_ASSERT(
+		stateIndex <
+		( static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX *
+		  RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) ) );
+
+	rRasterizerState = static_cast< RenderResourceManager::ERasterizerState >(
+		stateIndex / RenderResourceManager::DEPTH_STENCIL_STATE_MAX );
+	rDepthStencilState = static_cast< RenderResourceManager::EDepthStencilState >(
+		stateIndex % RenderResourceManager::DEPTH_STENCIL_STATE_MAX );
+}
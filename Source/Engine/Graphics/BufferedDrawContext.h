@@ -0,0 +1,193 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "MathSimd/Matrix44.h"
+#include "Rendering/RRenderResource.h"
+#include "GraphicsTypes/VertexTypes.h"
+#include "Graphics/RenderResourceManager.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( RIndexBuffer );
+	HELIUM_DECLARE_RPTR( RTexture2d );
+	HELIUM_DECLARE_RPTR( RVertexBuffer );
+
+	class BufferedDrawer;
+
+	/// Recording context for buffered primitive draw calls.
+	///
+	/// BufferedDrawer derives from this class to record draw calls issued from the main thread.  Other threads can record
+	/// draw calls at the same time by acquiring their own context with BufferedDrawer::AcquireContext() and handing it
+	/// back with BufferedDrawer::SubmitContext() once recording is done; submitted contexts are merged into the drawer
+	/// during the next BufferedDrawer::BeginDrawing() call.
+	///
+	/// Vertex, index, and draw call storage is retained between frames, so recording does not allocate once the storage
+	/// has grown to fit a frame's workload (Reserve() can be used to size it up front).
+	class HELIUM_GRAPHICS_API BufferedDrawContext : NonCopyable
+	{
+		friend class BufferedDrawer;
+
+	public:
+		/// @name Construction/Destruction
+		//@{
+		BufferedDrawContext();
+		~BufferedDrawContext();
+		//@}
+
+		/// @name Draw Call Generation
+		//@{
+		void DrawUntextured(
+			ERendererPrimitiveType primitiveType, const Simd::Matrix44& rTransform, const SimpleVertex* pVertices, uint32_t vertexCount,
+			const uint32_t* pIndices, uint32_t primitiveCount, Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::ERasterizerState rasterizerState = RenderResourceManager::RASTERIZER_STATE_DEFAULT,
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_DEFAULT );
+		void DrawUntextured(
+			ERendererPrimitiveType primitiveType, const Simd::Matrix44& rTransform, RVertexBuffer* pVertices,
+			RIndexBuffer* pIndices, uint32_t baseVertexIndex, uint32_t vertexCount, uint32_t startIndex,
+			uint32_t primitiveCount, Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::ERasterizerState rasterizerState = RenderResourceManager::RASTERIZER_STATE_DEFAULT,
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_DEFAULT );
+
+		void DrawTextured(
+			ERendererPrimitiveType primitiveType, const Simd::Matrix44& rTransform, const SimpleTexturedVertex* pVertices, uint32_t vertexCount,
+			const uint32_t* pIndices, uint32_t primitiveCount, RTexture2d* pTexture,
+			Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::ERasterizerState rasterizerState = RenderResourceManager::RASTERIZER_STATE_DEFAULT,
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_DEFAULT );
+		void DrawTextured(
+			ERendererPrimitiveType primitiveType, const Simd::Matrix44& rTransform, RVertexBuffer* pVertices,
+			RIndexBuffer* pIndices, uint32_t baseVertexIndex, uint32_t vertexCount, uint32_t startIndex,
+			uint32_t primitiveCount, RTexture2d* pTexture, Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::ERasterizerState rasterizerState = RenderResourceManager::RASTERIZER_STATE_DEFAULT,
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_DEFAULT );
+
+		void DrawPoints(
+			const SimpleVertex* pVertices, uint32_t pointCount, Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_NONE );
+		void DrawPoints(
+			const Simd::Matrix44& rTransform, RVertexBuffer* pVertices, uint32_t baseVertexIndex, uint32_t pointCount,
+			Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_NONE );
+
+		inline void DrawLineList( const SimpleVertex* pVertices, uint32_t pointCount, Color blendColor = Color( 0xffffffff ) );
+		inline void DrawLineList(
+			const Simd::Matrix44& rTransform, RVertexBuffer* pVertices, uint32_t baseVertexIndex, uint32_t pointCount,
+			Color blendColor = Color( 0xffffffff ) );
+
+		inline void DrawLineStrip( const SimpleVertex* pVertices, uint32_t pointCount, Color blendColor = Color( 0xffffffff ) );
+		inline void DrawLineStrip(
+			const Simd::Matrix44& rTransform, RVertexBuffer* pVertices, uint32_t baseVertexIndex, uint32_t pointCount,
+			Color blendColor = Color( 0xffffffff ) );
+
+		inline void DrawTexturedQuad(
+			RTexture2d* pTexture, const Simd::Matrix44& rTransform, const Simd::Vector2& rUvTopLeft,
+			const Simd::Vector2& rUvBottomRight, Color blendColor = Color( 0xffffffff ) );
+		inline void DrawTexturedQuad(
+			RTexture2d* pTexture, const Simd::Matrix44& rTransform, Color blendColor = Color( 0xffffffff ) );
+
+		SimpleVertex* AllocateLineList(
+			uint32_t lineCount, Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::ERasterizerState rasterizerState = RenderResourceManager::RASTERIZER_STATE_DEFAULT,
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_DEFAULT );
+		//@}
+
+		/// @name Storage Management
+		//@{
+		void Reserve( uint32_t untexturedVertexCount, uint32_t texturedVertexCount, uint32_t indexCount );
+		//@}
+
+	protected:
+		/// Untextured primitive draw call information using internal vertex/index buffers.
+		struct UntexturedDrawCall
+		{
+			/// World transform.
+			Simd::Matrix44 transform;
+			/// Primitive type.
+			ERendererPrimitiveType primitiveType;
+			/// Starting vertex index.
+			uint32_t baseVertexIndex;
+			/// Vertex count.
+			uint32_t vertexCount;
+			/// Starting index offset.
+			uint32_t startIndex;
+			/// Number of primitives to draw.
+			uint32_t primitiveCount;
+			/// Color with which to blend each vertex color.
+			Color blendColor;
+		};
+
+		/// Textured primitive draw call information using internal vertex/index buffers.
+		struct TexturedDrawCall : UntexturedDrawCall
+		{
+			/// Texture with which to draw.
+			RTexture2dPtr spTexture;
+		};
+
+		/// Untextured primitive draw call information using external vertex/index buffers.
+		HELIUM_SIMD_ALIGN_PRE struct UntexturedBufferDrawCall : UntexturedDrawCall
+		{
+			/// Vertex buffer.
+			RVertexBufferPtr spVertexBuffer;
+			/// Index buffer.
+			RIndexBufferPtr spIndexBuffer;
+		} HELIUM_SIMD_ALIGN_POST;
+
+		/// Textured primitive draw call information using external vertex/index buffers.
+		HELIUM_SIMD_ALIGN_PRE struct TexturedBufferDrawCall : UntexturedBufferDrawCall
+		{
+			/// Texture with which to draw.
+			RTexture2dPtr spTexture;
+		} HELIUM_SIMD_ALIGN_POST;
+
+		/// Untextured draw call vertices.
+		DynamicArray< SimpleVertex > m_untexturedVertices;
+		/// Textured draw call vertices.
+		DynamicArray< SimpleTexturedVertex > m_texturedVertices;
+
+		/// Untextured draw call indices.
+		DynamicArray< uint32_t > m_untexturedIndices;
+		/// Textured draw call indices.
+		DynamicArray< uint32_t > m_texturedIndices;
+
+		/// Untextured draw call data using internal vertex/index buffers.
+		DynamicArray< UntexturedDrawCall > m_untexturedDrawCalls[ RenderResourceManager::RASTERIZER_STATE_MAX * RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
+		/// Textured draw call data using internal vertex/index buffers.
+		DynamicArray< TexturedDrawCall > m_texturedDrawCalls[ RenderResourceManager::RASTERIZER_STATE_MAX * RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
+		/// Point draw call data using internal vertex/index buffers.
+		DynamicArray< UntexturedDrawCall > m_pointDrawCalls[ RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
+
+		/// Untextured draw call data using external vertex/index buffers.
+		DynamicArray< UntexturedBufferDrawCall > m_untexturedBufferDrawCalls[ RenderResourceManager::RASTERIZER_STATE_MAX * RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
+		/// Textured draw call data using external vertex/index buffers.
+		DynamicArray< TexturedBufferDrawCall > m_texturedBufferDrawCalls[ RenderResourceManager::RASTERIZER_STATE_MAX * RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
+		/// Point draw call data using external vertex/index buffers.
+		DynamicArray< UntexturedBufferDrawCall > m_pointBufferDrawCalls[ RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
+
+		/// Vertices for drawing quads.
+		RVertexBufferPtr m_spQuadVertexBuffer;
+
+		/// True if the buffered draw commands are in use for rendering (no new commands can be buffered), false if not
+		/// (new commands can be buffered).
+		bool m_bDrawing;
+
+		/// @name Protected Utility Functions
+		//@{
+		void Append( BufferedDrawContext& rContext );
+		void RemoveAll();
+		void Clear();
+		//@}
+
+		/// @name Static Utility Functions
+		//@{
+		static size_t GetStateIndex(
+			RenderResourceManager::ERasterizerState rasterizerState,
+			RenderResourceManager::EDepthStencilState depthStencilState );
+		static void GetStatesFromIndex(
+			size_t stateIndex, RenderResourceManager::ERasterizerState& rRasterizerState,
+			RenderResourceManager::EDepthStencilState& rDepthStencilState );
+		//@}
+	};
+}
+
+#include "Graphics/BufferedDrawContext.inl"
@@ -0,0 +1,137 @@
+namespace Helium
+{
+	/// Buffer a line list draw call using world-space vertices.
+	///
+	/// Consecutive line lists drawn with the same blend color are merged into a single draw call.
+	///
+	/// @param[in] pVertices   Line vertices, two per line.
+	/// @param[in] pointCount  Number of vertices to draw.
+	/// @param[in] blendColor  Color with which to blend each vertex color.
+	///
+	/// @see DrawLineStrip(), AllocateLineList()
+	void BufferedDrawContext::DrawLineList( const SimpleVertex* pVertices, uint32_t pointCount, Color blendColor )
+	{
+		HELIUM_ASSERT( pVertices );
+		HELIUM_ASSERT( pointCount >= 2 );
+
+		uint32_t lineCount = pointCount / 2;
+		SimpleVertex* pLineVertices = AllocateLineList( lineCount, blendColor );
+		if( pLineVertices )
+		{
+			MemoryCopy( pLineVertices, pVertices, lineCount * 2 * sizeof( SimpleVertex ) );
+		}
+	}
+
+	/// Buffer a line list draw call using vertices stored in a vertex buffer.
+	///
+	/// @param[in] rTransform       World transform to apply when rendering.
+	/// @param[in] pVertices        Vertex buffer containing a packed array of SimpleVertex vertices.
+	/// @param[in] baseVertexIndex  Index of the first vertex to use for rendering.
+	/// @param[in] pointCount       Number of vertices to draw.
+	/// @param[in] blendColor       Color with which to blend each vertex color.
+	///
+	/// @see DrawLineStrip()
+	void BufferedDrawContext::DrawLineList(
+		const Simd::Matrix44& rTransform,
+		RVertexBuffer* pVertices,
+		uint32_t baseVertexIndex,
+		uint32_t pointCount,
+		Color blendColor )
+	{
+		DrawUntextured(
+			RENDERER_PRIMITIVE_TYPE_LINE_LIST, rTransform, pVertices, NULL, baseVertexIndex, pointCount, 0, pointCount / 2,
+			blendColor );
+	}
+
+	/// Buffer a line strip draw call using world-space vertices.
+	///
+	/// @param[in] pVertices   Line strip vertices.
+	/// @param[in] pointCount  Number of vertices to draw.
+	/// @param[in] blendColor  Color with which to blend each vertex color.
+	///
+	/// @see DrawLineList()
+	void BufferedDrawContext::DrawLineStrip( const SimpleVertex* pVertices, uint32_t pointCount, Color blendColor )
+	{
+		DrawUntextured(
+			RENDERER_PRIMITIVE_TYPE_LINE_STRIP, Simd::Matrix44::IDENTITY, pVertices, pointCount, NULL, pointCount - 1,
+			blendColor );
+	}
+
+	/// Buffer a line strip draw call using vertices stored in a vertex buffer.
+	///
+	/// @param[in] rTransform       World transform to apply when rendering.
+	/// @param[in] pVertices        Vertex buffer containing a packed array of SimpleVertex vertices.
+	/// @param[in] baseVertexIndex  Index of the first vertex to use for rendering.
+	/// @param[in] pointCount       Number of vertices to draw.
+	/// @param[in] blendColor       Color with which to blend each vertex color.
+	///
+	/// @see DrawLineList()
+	void BufferedDrawContext::DrawLineStrip(
+		const Simd::Matrix44& rTransform,
+		RVertexBuffer* pVertices,
+		uint32_t baseVertexIndex,
+		uint32_t pointCount,
+		Color blendColor )
+	{
+		DrawUntextured(
+			RENDERER_PRIMITIVE_TYPE_LINE_STRIP, rTransform, pVertices, NULL, baseVertexIndex, pointCount, 0, pointCount - 1,
+			blendColor );
+	}
+
+	/// Buffer a unit quad draw call using a sub-rectangle of a texture.
+	///
+	/// @param[in] pTexture        Texture to apply to the quad.
+	/// @param[in] rTransform      World transform to apply when rendering.
+	/// @param[in] rUvTopLeft      Texture coordinates at the top-left corner of the quad.
+	/// @param[in] rUvBottomRight  Texture coordinates at the bottom-right corner of the quad.
+	/// @param[in] blendColor      Color with which to blend each vertex color.
+	void BufferedDrawContext::DrawTexturedQuad(
+		RTexture2d* pTexture,
+		const Simd::Matrix44& rTransform,
+		const Simd::Vector2& rUvTopLeft,
+		const Simd::Vector2& rUvBottomRight,
+		Color blendColor )
+	{
+		const SimpleTexturedVertex vertices[] =
+		{
+			SimpleTexturedVertex( Simd::Vector3( -0.5f, 0.5f, 1.0f ), Simd::Vector2( rUvTopLeft.GetX(), rUvBottomRight.GetY() ) ),
+			SimpleTexturedVertex( Simd::Vector3( 0.5f, 0.5f, 1.0f ), rUvBottomRight ),
+			SimpleTexturedVertex( Simd::Vector3( -0.5f, -0.5f, 1.0f ), rUvTopLeft ),
+			SimpleTexturedVertex( Simd::Vector3( 0.5f, -0.5f, 1.0f ), Simd::Vector2( rUvBottomRight.GetX(), rUvTopLeft.GetY() ) )
+		};
+
+		DrawTextured(
+			RENDERER_PRIMITIVE_TYPE_TRIANGLE_STRIP,
+			rTransform,
+			vertices,
+			static_cast< uint32_t >( HELIUM_ARRAY_COUNT( vertices ) ),
+			NULL,
+			2,
+			pTexture,
+			blendColor,
+			RenderResourceManager::RASTERIZER_STATE_DOUBLE_SIDED,
+			RenderResourceManager::DEPTH_STENCIL_STATE_TEST_ONLY );
+	}
+
+	/// Buffer a unit quad draw call covering an entire texture.
+	///
+	/// @param[in] pTexture    Texture to apply to the quad.
+	/// @param[in] rTransform  World transform to apply when rendering.
+	/// @param[in] blendColor  Color with which to blend each vertex color.
+	void BufferedDrawContext::DrawTexturedQuad( RTexture2d* pTexture, const Simd::Matrix44& rTransform, Color blendColor )
+	{
+		DrawTextured(
+			RENDERER_PRIMITIVE_TYPE_TRIANGLE_STRIP,
+			rTransform,
+			m_spQuadVertexBuffer.Get(),
+			NULL,
+			0,
+			4,
+			0,
+			2,
+			pTexture,
+			blendColor,
+			RenderResourceManager::RASTERIZER_STATE_DOUBLE_SIDED,
+			RenderResourceManager::DEPTH_STENCIL_STATE_TEST_ONLY );
+	}
+}
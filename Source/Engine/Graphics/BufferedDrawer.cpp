@@ -14,10 +14,24 @@
 #include "Rendering/RVertexInputLayout.h"
 #include "Rendering/RVertexShader.h"
 #include "Graphics/Font.h"
+#include "Graphics/GlyphCache.h"
 #include "Graphics/Shader.h"
 
 using namespace Helium;
 
+/// Bind a single vertex buffer to the first vertex buffer slot.
+///
+/// @param[in] pCommandProxy  Render command proxy to use.
+/// @param[in] pBuffer        Vertex buffer to bind.
+/// @param[in] stride         Bytes between consecutive vertices.
+static void BindVertexBuffer( RRenderCommandProxy* pCommandProxy, RVertexBuffer* pBuffer, uint32_t stride )
+{
+	HELIUM_ASSERT( pCommandProxy );
+
+	uint32_t offset = 0;
+	pCommandProxy->SetVertexBuffers( 0, 1, &pBuffer, &stride, &offset );
+}
+
 /// Constructor.
 BufferedDrawer::BufferedDrawer()
 	: m_instanceVertexConstantTransform( Simd::Matrix44::IDENTITY )
@@ -25,7 +39,6 @@ BufferedDrawer::BufferedDrawer()
 	, m_instancePixelConstantBlendColor( Color( 0xffffffff ) )
 	, m_instancePixelConstantBufferIndex( Invalid< uint32_t >() )
 	, m_currentResourceSetIndex( 0 )
-	, m_bDrawing( false )
 {
 	for( size_t resourceSetIndex = 0; resourceSetIndex < HELIUM_ARRAY_COUNT( m_resourceSets ); ++resourceSetIndex )
 	{
@@ -42,6 +55,7 @@ BufferedDrawer::BufferedDrawer()
 /// Destructor.
 BufferedDrawer::~BufferedDrawer()
 {
+	DestroyContexts();
 }
 
 /// Initialize this buffered drawing interface.
@@ -153,32 +167,21 @@ bool BufferedDrawer::Initialize()
 /// @see Initialize()
 void BufferedDrawer::Shutdown()
 {
-	m_untexturedVertices.Clear();
-	m_texturedVertices.Clear();
+	DestroyContexts();
 
-	m_untexturedIndices.Clear();
-	m_texturedIndices.Clear();
+	Clear();
 
-	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_untexturedDrawCalls ); ++stateIndex )
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_worldTextDrawCalls ); ++stateIndex )
 	{
-		m_untexturedDrawCalls[ stateIndex ].Clear();
-		m_texturedDrawCalls[ stateIndex ].Clear();
-
-		m_untexturedBufferDrawCalls[ stateIndex ].Clear();
-		m_texturedBufferDrawCalls[ stateIndex ].Clear();
-
 		m_worldTextDrawCalls[ stateIndex ].Clear();
 	}
 
-	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_pointDrawCalls ); ++stateIndex )
-	{
-		m_pointDrawCalls[ stateIndex ].Clear();
-		m_pointBufferDrawCalls[ stateIndex ].Clear();
-	}
-
 	m_screenTextDrawCalls.Clear();
 	m_projectedTextDrawCalls.Clear();
-	m_screenTextGlyphIndices.Clear();
+	m_screenTextGlyphs.Clear();
+	m_projectedTextGlyphs.Clear();
+
+	m_textLayoutCache.Clear();
 
 	m_spQuadVertexBuffer.Release();
 	m_spScreenSpaceTextIndexBuffer.Release();
@@ -227,369 +230,116 @@ void BufferedDrawer::Shutdown()
 	m_bDrawing = false;
 }
 
-/// Buffer an untextured primitive draw call.
+/// Acquire a recording context for buffering draw calls from a thread other than the one that owns this drawer.
 ///
-/// @param[in] primitiveType      Type of primitive to draw.
-/// @param[in] pVertices          Vertices to use for drawing.
-/// @param[in] vertexCount        Number of vertices used for drawing.
-/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
-/// @param[in] primitiveCount     Number of primitives to draw.
-/// @param[in] blendColor         Color with which to blend each vertex color.
-/// @param[in] rasterizerState    Rasterizer state to use during rendering.
-/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+/// Contexts are pooled and reused across frames, so a context only allocates until its storage has grown to fit the
+/// calling thread's workload.  This can be called from any thread.
 ///
-/// @see DrawTextured(), DrawPoints()
-void BufferedDrawer::DrawUntextured(
-	ERendererPrimitiveType primitiveType,
-	const Simd::Matrix44& rTransform, 
-	const SimpleVertex* pVertices,
-	uint32_t vertexCount,
-	const uint16_t* pIndices,
-	uint32_t primitiveCount,
-	Color blendColor,
-	RenderResourceManager::ERasterizerState rasterizerState,
-	RenderResourceManager::EDepthStencilState depthStencilState )
+/// @return  Recording context to use for buffering draw calls.  It must be handed back using SubmitContext() before
+///          BeginDrawing() is called for the frame in which its draw calls should be rendered.
+///
+/// @see SubmitContext()
+BufferedDrawContext* BufferedDrawer::AcquireContext()
 {
-	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
-	HELIUM_ASSERT( pVertices );
-	HELIUM_ASSERT( vertexCount );
-	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
-	HELIUM_ASSERT( primitiveCount );
-	HELIUM_ASSERT(
-		static_cast< size_t >( rasterizerState ) <
-		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
-	HELIUM_ASSERT(
-		static_cast< size_t >( depthStencilState ) <
-		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
-
-	// Cannot add draw calls while rendering.
-	HELIUM_ASSERT( !m_bDrawing );
-
-	// Don't buffer any drawing information if we have no renderer.
-	if( !Renderer::GetInstance() )
+	BufferedDrawContext* pContext = NULL;
 	{
-		return;
+		Locker< DynamicArray< BufferedDrawContext* >, SpinLock >::Handle handle( m_freeContexts );
+		if( !handle->IsEmpty() )
+		{
+			pContext = handle->Pop();
+		}
 	}
 
-	uint32_t baseVertexIndex = static_cast< uint32_t >( m_untexturedVertices.GetSize() );
-	m_untexturedVertices.AddArray( pVertices, vertexCount );
-
-	uint32_t startIndex;
-	SetInvalid( startIndex );
-	if( pIndices )
+	if( !pContext )
 	{
-		startIndex = static_cast< uint32_t >( m_untexturedIndices.GetSize() );
-		m_untexturedIndices.AddArray(
-			pIndices,
-			RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
+		pContext = new BufferedDrawContext;
+		HELIUM_ASSERT( pContext );
+		pContext->m_spQuadVertexBuffer = m_spQuadVertexBuffer;
 	}
 
-	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
-	UntexturedDrawCall* pDrawCall = m_untexturedDrawCalls[ stateIndex ].New();
-	HELIUM_ASSERT( pDrawCall );
-	pDrawCall->transform = rTransform;
-	pDrawCall->primitiveType = primitiveType;
-	pDrawCall->baseVertexIndex = baseVertexIndex;
-	pDrawCall->vertexCount = vertexCount;
-	pDrawCall->startIndex = startIndex;
-	pDrawCall->primitiveCount = primitiveCount;
-	pDrawCall->blendColor = blendColor;
+	HELIUM_ASSERT( !pContext->m_bDrawing );
+
+	return pContext;
 }
 
-/// Buffer an untextured primitive draw call.
+/// Hand back a recording context acquired using AcquireContext().
 ///
-/// @param[in] primitiveType      Type of primitive to draw.
-/// @param[in] rTransform         World transform to apply when rendering.
-/// @param[in] pVertices          Vertex buffer to use for drawing.  This must contain a packed array of SimpleVertex
-///                               vertices.
-/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
-/// @param[in] baseVertexIndex    Index of the first vertex to use for rendering.  Index buffer values will be relative to
-///                               this vertex.
-/// @param[in] vertexCount        Number of vertices used for rendering.
-/// @param[in] startIndex         Index of the first index to use for drawing.
-/// @param[in] primitiveCount     Number of primitives to draw.
-/// @param[in] blendColor         Color with which to blend each vertex color.
-/// @param[in] rasterizerState    Rasterizer state to use during rendering.
-/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+/// The draw calls recorded in the context will be merged into this drawer during the next BeginDrawing() call, after
+/// which the context is returned to the pool.  No more draw calls can be recorded in the context once it has been
+/// submitted.  This can be called from any thread.
 ///
-/// @see DrawTextured(), DrawPoints()
-void BufferedDrawer::DrawUntextured(
-	ERendererPrimitiveType primitiveType,
-	const Simd::Matrix44& rTransform,
-	RVertexBuffer* pVertices,
-	RIndexBuffer* pIndices,
-	uint32_t baseVertexIndex,
-	uint32_t vertexCount,
-	uint32_t startIndex,
-	uint32_t primitiveCount,
-	Color blendColor,
-	RenderResourceManager::ERasterizerState rasterizerState,
-	RenderResourceManager::EDepthStencilState depthStencilState )
+/// @param[in] pContext  Recording context to submit.
+///
+/// @see AcquireContext()
+void BufferedDrawer::SubmitContext( BufferedDrawContext* pContext )
 {
-	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
-	HELIUM_ASSERT( pVertices );
-	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
-	HELIUM_ASSERT( vertexCount );
-	HELIUM_ASSERT( primitiveCount );
-	HELIUM_ASSERT(
-		static_cast< size_t >( rasterizerState ) <
-		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
-	HELIUM_ASSERT(
-		static_cast< size_t >( depthStencilState ) <
-		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+	HELIUM_ASSERT( pContext );
+	HELIUM_ASSERT( pContext != this );
+	HELIUM_ASSERT( !pContext->m_bDrawing );
 
-	// Cannot add draw calls while rendering.
-	HELIUM_ASSERT( !m_bDrawing );
+	pContext->m_bDrawing = true;
 
-	// Don't buffer any drawing information if we have no renderer.
-	if( !Renderer::GetInstance() )
-	{
-		return;
-	}
-
-	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
-	UntexturedBufferDrawCall* pDrawCall = m_untexturedBufferDrawCalls[ stateIndex ].New();
-	HELIUM_ASSERT( pDrawCall );
-	pDrawCall->primitiveType = primitiveType;
-	pDrawCall->baseVertexIndex = baseVertexIndex;
-	pDrawCall->vertexCount = vertexCount;
-	pDrawCall->startIndex = startIndex;
-	pDrawCall->primitiveCount = primitiveCount;
-	pDrawCall->blendColor = blendColor;
-	pDrawCall->spVertexBuffer = pVertices;
-	pDrawCall->spIndexBuffer = pIndices;
-	pDrawCall->transform = rTransform;
+	Locker< DynamicArray< BufferedDrawContext* >, SpinLock >::Handle handle( m_submittedContexts );
+	handle->Push( pContext );
 }
 
-/// Buffer a textured primitive draw call.
-///
-/// @param[in] primitiveType      Type of primitive to draw.
-/// @param[in] pVertices          Vertices to use for drawing.
-/// @param[in] vertexCount        Number of vertices used for drawing.
-/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
-/// @param[in] primitiveCount     Number of primitives to draw.
-/// @param[in] pTexture           Texture to apply to the mesh.
-/// @param[in] blendColor         Color with which to blend each vertex color.
-/// @param[in] rasterizerState    Rasterizer state to use during rendering.
-/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+/// Merge the draw calls from all submitted recording contexts into this drawer and return the contexts to the pool.
 ///
-/// @see DrawUntextured(), DrawPoints()
-void BufferedDrawer::DrawTextured(
-	ERendererPrimitiveType primitiveType,
-	const Simd::Matrix44& rTransform,
-	const SimpleTexturedVertex* pVertices,
-	uint32_t vertexCount,
-	const uint16_t* pIndices,
-	uint32_t primitiveCount,
-	RTexture2d* pTexture,
-	Color blendColor,
-	RenderResourceManager::ERasterizerState rasterizerState,
-	RenderResourceManager::EDepthStencilState depthStencilState )
+/// @see SubmitContext()
+void BufferedDrawer::MergeSubmittedContexts()
 {
-	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
-	HELIUM_ASSERT( pVertices );
-	HELIUM_ASSERT( vertexCount );
-	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
-	HELIUM_ASSERT( primitiveCount );
-	HELIUM_ASSERT( pTexture );
-	HELIUM_ASSERT(
-		static_cast< size_t >( rasterizerState ) <
-		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
-	HELIUM_ASSERT(
-		static_cast< size_t >( depthStencilState ) <
-		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
-
-	// Cannot add draw calls while rendering.
-	HELIUM_ASSERT( !m_bDrawing );
-
-	// Don't buffer any drawing information if we have no renderer.
-	if( !Renderer::GetInstance() )
+	Locker< DynamicArray< BufferedDrawContext* >, SpinLock >::Handle submittedHandle( m_submittedContexts );
+	if( submittedHandle->IsEmpty() )
 	{
 		return;
 	}
 
-	uint32_t baseVertexIndex = static_cast< uint32_t >( m_texturedVertices.GetSize() );
-	m_texturedVertices.AddArray( pVertices, vertexCount );
-
-	uint32_t startIndex;
-	SetInvalid( startIndex );
-	if( pIndices )
+	BufferedDrawContext** ppContexts = submittedHandle->GetData();
+	size_t contextCount = submittedHandle->GetSize();
+	for( size_t contextIndex = 0; contextIndex < contextCount; ++contextIndex )
 	{
-		startIndex = static_cast< uint32_t >( m_texturedIndices.GetSize() );
-		m_texturedIndices.AddArray(
-			pIndices,
-			RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
-	}
-
-	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
-	TexturedDrawCall* pDrawCall = m_texturedDrawCalls[ stateIndex ].New();
-	HELIUM_ASSERT( pDrawCall );
-	pDrawCall->transform = rTransform;
-	pDrawCall->primitiveType = primitiveType;
-	pDrawCall->baseVertexIndex = baseVertexIndex;
-	pDrawCall->vertexCount = vertexCount;
-	pDrawCall->startIndex = startIndex;
-	pDrawCall->primitiveCount = primitiveCount;
-	pDrawCall->blendColor = blendColor;
-	pDrawCall->spTexture = pTexture;
-}
-
-/// Buffer a textured primitive draw call.
-///
-/// @param[in] primitiveType      Type of primitive to draw.
-/// @param[in] rTransform         World transform to apply when rendering.
-/// @param[in] pVertices          Vertex buffer to use for drawing.  This must contain a packed array of
-///                               SimpleTexturedVertex vertices.
-/// @param[in] pIndices           Indices to use for drawing.  If this is null, unindexed rendering will be performed.
-/// @param[in] baseVertexIndex    Index of the first vertex to use for rendering.  Index buffer values will be relative to
-///                               this vertex.
-/// @param[in] vertexCount        Number of vertices used for rendering.
-/// @param[in] startIndex         Index of the first index to use for drawing.
-/// @param[in] primitiveCount     Number of primitives to draw.
-/// @param[in] pTexture           Texture to apply to the mesh.
-/// @param[in] blendColor         Color with which to blend each vertex color.
-/// @param[in] rasterizerState    Rasterizer state to use during rendering.
-/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
-///
-/// @see DrawUntextured(), DrawPoints()
-void BufferedDrawer::DrawTextured(
-	ERendererPrimitiveType primitiveType,
-	const Simd::Matrix44& rTransform,
-	RVertexBuffer* pVertices,
-	RIndexBuffer* pIndices,
-	uint32_t baseVertexIndex,
-	uint32_t vertexCount,
-	uint32_t startIndex,
-	uint32_t primitiveCount,
-	RTexture2d* pTexture,
-	Color blendColor,
-	RenderResourceManager::ERasterizerState rasterizerState,
-	RenderResourceManager::EDepthStencilState depthStencilState )
-{
-	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
-	HELIUM_ASSERT( pVertices );
-	HELIUM_ASSERT( pIndices || vertexCount == RendererUtil::PrimitiveCountToIndexCount( primitiveType, primitiveCount ) );
-	HELIUM_ASSERT( vertexCount );
-	HELIUM_ASSERT( primitiveCount );
-	HELIUM_ASSERT( pTexture );
-	HELIUM_ASSERT(
-		static_cast< size_t >( rasterizerState ) <
-		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
-	HELIUM_ASSERT(
-		static_cast< size_t >( depthStencilState ) <
-		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+		BufferedDrawContext* pContext = ppContexts[ contextIndex ];
+		HELIUM_ASSERT( pContext );
+		HELIUM_ASSERT( pContext->m_bDrawing );
 
-	// Cannot add draw calls while rendering.
-	HELIUM_ASSERT( !m_bDrawing );
-
-	// Don't buffer any drawing information if we have no renderer.
-	if( !Renderer::GetInstance() )
-	{
-		return;
+		Append( *pContext );
+		pContext->m_bDrawing = false;
 	}
 
-	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
-	TexturedBufferDrawCall* pDrawCall = m_texturedBufferDrawCalls[ stateIndex ].New();
-	HELIUM_ASSERT( pDrawCall );
-	pDrawCall->primitiveType = primitiveType;
-	pDrawCall->baseVertexIndex = baseVertexIndex;
-	pDrawCall->vertexCount = vertexCount;
-	pDrawCall->startIndex = startIndex;
-	pDrawCall->primitiveCount = primitiveCount;
-	pDrawCall->blendColor = blendColor;
-	pDrawCall->spTexture = pTexture;
-	pDrawCall->spVertexBuffer = pVertices;
-	pDrawCall->spIndexBuffer = pIndices;
-	pDrawCall->transform = rTransform;
+	Locker< DynamicArray< BufferedDrawContext* >, SpinLock >::Handle freeHandle( m_freeContexts );
+	freeHandle->AddArray( ppContexts, contextCount );
+	submittedHandle->RemoveAll();
 }
 
-/// Buffer a point list draw call using points larger than a pixel.
+/// Destroy all pooled and submitted recording contexts.
 ///
-/// @param[in] pVertices          Vertices to use for drawing.
-/// @param[in] pointCount         Number of points to draw.
-/// @param[in] blendColor         Color with which to blend each vertex color.
-/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
-///
-/// @see DrawUntextured(), DrawTextured()
-void BufferedDrawer::DrawPoints(
-	const SimpleVertex* pVertices,
-	uint32_t pointCount,
-	Color blendColor,
-	RenderResourceManager::EDepthStencilState depthStencilState )
+/// Any contexts still held by other threads are not tracked by this drawer, so all contexts must have been submitted
+/// before this is called.
+void BufferedDrawer::DestroyContexts()
 {
-	HELIUM_ASSERT( pVertices );
-	HELIUM_ASSERT( pointCount );
-	HELIUM_ASSERT(
-		static_cast< size_t >( depthStencilState ) <
-		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
-
-	// Cannot add draw calls while rendering.
-	HELIUM_ASSERT( !m_bDrawing );
-
-	// Don't buffer any drawing information if we have no renderer.
-	if( !Renderer::GetInstance() )
 	{
-		return;
-	}
-
-	uint32_t baseVertexIndex = static_cast< uint32_t >( m_untexturedVertices.GetSize() );
-	m_untexturedVertices.AddArray( pVertices, pointCount );
-
-	UntexturedDrawCall* pDrawCall = m_pointDrawCalls[ depthStencilState ].New();
-	HELIUM_ASSERT( pDrawCall );
-	pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_POINT_LIST;
-	pDrawCall->baseVertexIndex = baseVertexIndex;
-	pDrawCall->vertexCount = pointCount;
-	SetInvalid( pDrawCall->startIndex );
-	pDrawCall->primitiveCount = pointCount;
-	pDrawCall->blendColor = blendColor;
-}
-
-/// Buffer a point list draw call using points larger than a pixel.
-///
-/// @param[in] rTransform         World transform to apply when rendering.
-/// @param[in] pVertices          Vertex buffer to use for drawing.  This must contain a packed array of SimpleVertex
-///                               vertices.
-/// @param[in] baseVertexIndex    Index of the first vertex to use for rendering.
-/// @param[in] pointCount         Number of points to draw.
-/// @param[in] blendColor         Color with which to blend each vertex color.
-/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
-///
-/// @see DrawUntextured(), DrawTextured()
-void BufferedDrawer::DrawPoints(
-	const Simd::Matrix44& rTransform,
-	RVertexBuffer* pVertices,
-	uint32_t baseVertexIndex,
-	uint32_t pointCount,
-	Color blendColor,
-	RenderResourceManager::EDepthStencilState depthStencilState )
-{
-	HELIUM_ASSERT( pVertices );
-	HELIUM_ASSERT( pointCount );
-	HELIUM_ASSERT(
-		static_cast< size_t >( depthStencilState ) <
-		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+		Locker< DynamicArray< BufferedDrawContext* >, SpinLock >::Handle handle( m_submittedContexts );
+		BufferedDrawContext** ppContexts = handle->GetData();
+		size_t contextCount = handle->GetSize();
+		for( size_t contextIndex = 0; contextIndex < contextCount; ++contextIndex )
+		{
+			delete ppContexts[ contextIndex ];
+		}
 
-	// Cannot add draw calls while rendering.
-	HELIUM_ASSERT( !m_bDrawing );
+		handle->Clear();
+	}
 
-	// Don't buffer any drawing information if we have no renderer.
-	if( !Renderer::GetInstance() )
 	{
-		return;
-	}
+		Locker< DynamicArray< BufferedDrawContext* >, SpinLock >::Handle handle( m_freeContexts );
+		BufferedDrawContext** ppContexts = handle->GetData();
+		size_t contextCount = handle->GetSize();
+		for( size_t contextIndex = 0; contextIndex < contextCount; ++contextIndex )
+		{
+			delete ppContexts[ contextIndex ];
+		}
 
-	UntexturedBufferDrawCall* pDrawCall = m_pointBufferDrawCalls[ depthStencilState ].New();
-	HELIUM_ASSERT( pDrawCall );
-	pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_POINT_LIST;
-	pDrawCall->baseVertexIndex = baseVertexIndex;
-	pDrawCall->vertexCount = pointCount;
-	SetInvalid( pDrawCall->startIndex );
-	pDrawCall->primitiveCount = pointCount;
-	pDrawCall->blendColor = blendColor;
-	pDrawCall->spVertexBuffer = pVertices;
-	pDrawCall->spIndexBuffer = NULL;
-	pDrawCall->transform = rTransform;
+		handle->Clear();
+	}
 }
 
 /// Draw text in world space at a specific transform.
@@ -638,9 +388,67 @@ void BufferedDrawer::DrawWorldText(
 		return;
 	}
 
+	uint32_t glyphCount;
+	const TextLayoutCache::Glyph* pGlyphs = m_textLayoutCache.GetLayout( pFont, rText, glyphCount );
+
+	static const uint32_t quadIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
+	uint32_t fontCharacterCount = pFont->GetCharacterCount();
+
 	// Render the text.
-	WorldSpaceTextGlyphHandler glyphHandler( this, pFont, color, rasterizerState, depthStencilState, rTransform );
-	pFont->ProcessText( rText, glyphHandler );
+	for( uint32_t glyphIndex = 0; glyphIndex < glyphCount; ++glyphIndex )
+	{
+		const TextLayoutCache::Glyph& rGlyph = pGlyphs[ glyphIndex ];
+		if( rGlyph.characterIndex >= fontCharacterCount )
+		{
+			continue;
+		}
+
+		// Texture coordinates are not cached with the layout, as characters can move within the glyph cache.
+		Font::GlyphImage image;
+		if( !pFont->GetGlyphImage( pFont->GetCharacter( rGlyph.characterIndex ), image ) )
+		{
+			continue;
+		}
+
+		Simd::Vector3 corners[] =
+		{
+			Simd::Vector3( rGlyph.cornerMinX, rGlyph.cornerTopY, 0.0f ),
+			Simd::Vector3( rGlyph.cornerMaxX, rGlyph.cornerTopY, 0.0f ),
+			Simd::Vector3( rGlyph.cornerMaxX, rGlyph.cornerBottomY, 0.0f ),
+			Simd::Vector3( rGlyph.cornerMinX, rGlyph.cornerBottomY, 0.0f )
+		};
+
+		rTransform.TransformPoint( corners[ 0 ], corners[ 0 ] );
+		rTransform.TransformPoint( corners[ 1 ], corners[ 1 ] );
+		rTransform.TransformPoint( corners[ 2 ], corners[ 2 ] );
+		rTransform.TransformPoint( corners[ 3 ], corners[ 3 ] );
+
+		const SimpleTexturedVertex vertices[] =
+		{
+			SimpleTexturedVertex( corners[ 0 ], Simd::Vector2( image.texCoordMinX, image.texCoordMinY ), color ),
+			SimpleTexturedVertex( corners[ 1 ], Simd::Vector2( image.texCoordMaxX, image.texCoordMinY ), color ),
+			SimpleTexturedVertex( corners[ 2 ], Simd::Vector2( image.texCoordMaxX, image.texCoordMaxY ), color ),
+			SimpleTexturedVertex( corners[ 3 ], Simd::Vector2( image.texCoordMinX, image.texCoordMaxY ), color )
+		};
+
+		uint32_t baseVertexIndex = static_cast< uint32_t >( m_texturedVertices.GetSize() );
+		uint32_t startIndex = static_cast< uint32_t >( m_texturedIndices.GetSize() );
+
+		m_texturedVertices.AddArray( vertices, 4 );
+		m_texturedIndices.AddArray( quadIndices, 6 );
+
+		TexturedDrawCall* pDrawCall = m_worldTextDrawCalls[ stateIndex ].New();
+		HELIUM_ASSERT( pDrawCall );
+		pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST;
+		pDrawCall->baseVertexIndex = baseVertexIndex;
+		pDrawCall->vertexCount = 4;
+		pDrawCall->startIndex = startIndex;
+		pDrawCall->primitiveCount = 2;
+		pDrawCall->blendColor = Color( 0xffffffff );
+		pDrawCall->spTexture = image.pTexture;
+	}
 }
 
 /// Draw text in screen space at a specific transform.
@@ -681,9 +489,23 @@ void BufferedDrawer::DrawScreenText(
 		return;
 	}
 
+	uint32_t glyphCount;
+	const TextLayoutCache::Glyph* pGlyphs = m_textLayoutCache.GetLayout( pFont, rText, glyphCount );
+	if( glyphCount == 0 )
+	{
+		return;
+	}
+
 	// Store the information needed for drawing the text later.
-	ScreenSpaceTextGlyphHandler glyphHandler( this, pFont, x, y, color, size );
-	pFont->ProcessText( rText, glyphHandler );
+	ScreenTextDrawCall* pDrawCall = m_screenTextDrawCalls.New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->x = x;
+	pDrawCall->y = y;
+	pDrawCall->color = color;
+	pDrawCall->size = size;
+	pDrawCall->glyphCount = glyphCount;
+
+	m_screenTextGlyphs.AddArray( pGlyphs, glyphCount );
 }
 
 /// Draw text in screen space based off a world-space origin point.
@@ -726,9 +548,26 @@ void BufferedDrawer::DrawProjectedText(
 		return;
 	}
 
+	uint32_t glyphCount;
+	const TextLayoutCache::Glyph* pGlyphs = m_textLayoutCache.GetLayout( pFont, rText, glyphCount );
+	if( glyphCount == 0 )
+	{
+		return;
+	}
+
 	// Store the information needed for drawing the text later.
-	ProjectedTextGlyphHandler glyphHandler( this, pFont, rWorldOffset, screenOffsetX, screenOffsetY, color, size );
-	pFont->ProcessText( rText, glyphHandler );
+	ProjectedTextDrawCall* pDrawCall = m_projectedTextDrawCalls.New();
+	HELIUM_ASSERT( pDrawCall );
+	pDrawCall->x = screenOffsetX;
+	pDrawCall->y = screenOffsetY;
+	pDrawCall->color = color;
+	pDrawCall->size = size;
+	pDrawCall->glyphCount = glyphCount;
+	pDrawCall->worldPosition[ 0 ] = rWorldOffset.GetElement( 0 );
+	pDrawCall->worldPosition[ 1 ] = rWorldOffset.GetElement( 1 );
+	pDrawCall->worldPosition[ 2 ] = rWorldOffset.GetElement( 2 );
+
+	m_projectedTextGlyphs.AddArray( pGlyphs, glyphCount );
 }
 
 /// Push buffered draw command data into vertex and index buffers for rendering.
@@ -743,6 +582,9 @@ void BufferedDrawer::BeginDrawing()
 	HELIUM_ASSERT( !m_bDrawing );
 	m_bDrawing = true;
 
+	// Pull in any draw calls recorded by other threads since the last frame.
+	MergeSubmittedContexts();
+
 	// If a renderer is not initialized, we don't need to do anything.
 	Renderer* pRenderer = Renderer::GetInstance();
 	if( !pRenderer )
@@ -751,7 +593,8 @@ void BufferedDrawer::BeginDrawing()
 		HELIUM_ASSERT( m_untexturedIndices.IsEmpty() );
 		HELIUM_ASSERT( m_texturedVertices.IsEmpty() );
 		HELIUM_ASSERT( m_texturedIndices.IsEmpty() );
-		HELIUM_ASSERT( m_screenTextGlyphIndices.IsEmpty() );
+		HELIUM_ASSERT( m_screenTextGlyphs.IsEmpty() );
+		HELIUM_ASSERT( m_projectedTextGlyphs.IsEmpty() );
 
 		return;
 	}
@@ -764,11 +607,11 @@ void BufferedDrawer::BeginDrawing()
 	uint_fast32_t texturedVertexCount = static_cast< uint_fast32_t >( m_texturedVertices.GetSize() );
 	uint_fast32_t texturedIndexCount = static_cast< uint_fast32_t >( m_texturedIndices.GetSize() );
 
-	uint_fast32_t screenTextGlyphIndexCount = static_cast< uint_fast32_t >( m_screenTextGlyphIndices.GetSize() );
-	uint_fast32_t screenTextVertexCount = screenTextGlyphIndexCount * 4;
+	uint_fast32_t screenTextGlyphCount = static_cast< uint_fast32_t >( m_screenTextGlyphs.GetSize() );
+	uint_fast32_t screenTextVertexCount = screenTextGlyphCount * 4;
 
-	uint_fast32_t projectedTextGlyphIndexCount = static_cast< uint_fast32_t >( m_projectedTextGlyphIndices.GetSize() );
-	uint_fast32_t projectedTextVertexCount = projectedTextGlyphIndexCount * 4;
+	uint_fast32_t projectedTextGlyphCount = static_cast< uint_fast32_t >( m_projectedTextGlyphs.GetSize() );
+	uint_fast32_t projectedTextVertexCount = projectedTextGlyphCount * 4;
 
 	if( untexturedVertexCount > rResourceSet.untexturedVertexBufferSize )
 	{
@@ -795,9 +638,9 @@ void BufferedDrawer::BeginDrawing()
 	{
 		rResourceSet.spUntexturedIndexBuffer.Release();
 		rResourceSet.spUntexturedIndexBuffer = pRenderer->CreateIndexBuffer(
-			untexturedIndexCount * sizeof( uint16_t ),
+			untexturedIndexCount * sizeof( uint32_t ),
 			RENDERER_BUFFER_USAGE_DYNAMIC,
-			RENDERER_INDEX_FORMAT_UINT16 );
+			RENDERER_INDEX_FORMAT_UINT32 );
 		if( !rResourceSet.spUntexturedIndexBuffer )
 		{
 			HELIUM_TRACE(
@@ -838,9 +681,9 @@ void BufferedDrawer::BeginDrawing()
 	{
 		rResourceSet.spTexturedIndexBuffer.Release();
 		rResourceSet.spTexturedIndexBuffer = pRenderer->CreateIndexBuffer(
-			texturedIndexCount * sizeof( uint16_t ),
+			texturedIndexCount * sizeof( uint32_t ),
 			RENDERER_BUFFER_USAGE_DYNAMIC,
-			RENDERER_INDEX_FORMAT_UINT16 );
+			RENDERER_INDEX_FORMAT_UINT32 );
 		if( !rResourceSet.spTexturedIndexBuffer )
 		{
 			HELIUM_TRACE(
@@ -916,7 +759,7 @@ void BufferedDrawer::BeginDrawing()
 			MemoryCopy(
 				pMappedIndexBuffer,
 				m_untexturedIndices.GetData(),
-				untexturedIndexCount * sizeof( uint16_t ) );
+				untexturedIndexCount * sizeof( uint32_t ) );
 			rResourceSet.spUntexturedIndexBuffer->Unmap();
 		}
 	}
@@ -938,7 +781,7 @@ void BufferedDrawer::BeginDrawing()
 			MemoryCopy(
 				pMappedIndexBuffer,
 				m_texturedIndices.GetData(),
-				texturedIndexCount * sizeof( uint16_t ) );
+				texturedIndexCount * sizeof( uint32_t ) );
 			rResourceSet.spTexturedIndexBuffer->Unmap();
 		}
 	}
@@ -949,7 +792,7 @@ void BufferedDrawer::BeginDrawing()
 			RENDERER_BUFFER_MAP_HINT_DISCARD ) );
 		HELIUM_ASSERT( pScreenVertices );
 
-		uint32_t* pGlyphIndex = m_screenTextGlyphIndices.GetData();
+		const TextLayoutCache::Glyph* pGlyph = m_screenTextGlyphs.GetData();
 
 		size_t textDrawCount = m_screenTextDrawCalls.GetSize();
 		for( size_t drawIndex = 0; drawIndex < textDrawCount; ++drawIndex )
@@ -965,17 +808,14 @@ void BufferedDrawer::BeginDrawing()
 				float32_t y = static_cast< float32_t >( rDrawCall.y );
 				Color color = rDrawCall.color;
 
-				float32_t inverseTextureWidth = 1.0f / static_cast< float32_t >( pFont->GetTextureSheetWidth() );
-				float32_t inverseTextureHeight = 1.0f / static_cast< float32_t >( pFont->GetTextureSheetHeight() );
-
 				uint32_t fontCharacterCount = pFont->GetCharacterCount();
 
 				for( uint_fast32_t glyphIndexOffset = 0; glyphIndexOffset < glyphCount; ++glyphIndexOffset )
 				{
-					uint32_t glyphIndex = *pGlyphIndex;
-					++pGlyphIndex;
+					const TextLayoutCache::Glyph& rGlyph = *pGlyph;
+					++pGlyph;
 
-					if( glyphIndex >= fontCharacterCount )
+					if( rGlyph.characterIndex >= fontCharacterCount )
 					{
 						MemoryZero( pScreenVertices, sizeof( *pScreenVertices ) * 4 );
 						pScreenVertices += 4;
@@ -983,26 +823,26 @@ void BufferedDrawer::BeginDrawing()
 						continue;
 					}
 
-					const Font::Character& rCharacter = pFont->GetCharacter( glyphIndex );
+					const Font::Character& rCharacter = pFont->GetCharacter( rGlyph.characterIndex );
 
-					float32_t imageWidthFloat = static_cast< float32_t >( rCharacter.imageWidth );
-					float32_t imageHeightFloat = static_cast< float32_t >( rCharacter.imageHeight );
+					float32_t cornerMinX = x + rGlyph.cornerMinX;
+					float32_t cornerMinY = y - rGlyph.cornerTopY;
+					float32_t cornerMaxX = x + rGlyph.cornerMaxX;
+					float32_t cornerMaxY = y - rGlyph.cornerBottomY;
 
-					float32_t cornerMinX = Floor( x + 0.5f ) + static_cast< float32_t >( rCharacter.bearingX >> 6 );
-					float32_t cornerMinY = y - static_cast< float32_t >( rCharacter.bearingY >> 6 );
-					float32_t cornerMaxX = cornerMinX + imageWidthFloat;
-					float32_t cornerMaxY = cornerMinY + imageHeightFloat;
+					// Characters without an available image are left with empty texture coordinates and skipped when
+					// drawing.
+					Font::GlyphImage image;
+					if( !pFont->GetGlyphImage( rCharacter, image ) )
+					{
+						MemoryZero( &image, sizeof( image ) );
+					}
 
 					Float32 texCoordMinX32, texCoordMinY32, texCoordMaxX32, texCoordMaxY32;
-					texCoordMinX32.value = static_cast< float32_t >( rCharacter.imageX );
-					texCoordMinY32.value = static_cast< float32_t >( rCharacter.imageY );
-					texCoordMaxX32.value = texCoordMinX32.value + imageWidthFloat;
-					texCoordMaxY32.value = texCoordMinY32.value + imageHeightFloat;
-
-					texCoordMinX32.value *= inverseTextureWidth;
-					texCoordMinY32.value *= inverseTextureHeight;
-					texCoordMaxX32.value *= inverseTextureWidth;
-					texCoordMaxY32.value *= inverseTextureHeight;
+					texCoordMinX32.value = image.texCoordMinX;
+					texCoordMinY32.value = image.texCoordMinY;
+					texCoordMaxX32.value = image.texCoordMaxX;
+					texCoordMaxY32.value = image.texCoordMaxY;
 
 					Float16 texCoordMinX = Float32To16( texCoordMinX32 );
 					Float16 texCoordMinY = Float32To16( texCoordMinY32 );
@@ -1048,13 +888,11 @@ void BufferedDrawer::BeginDrawing()
 					pScreenVertices->texCoords[ 0 ] = texCoordMinX;
 					pScreenVertices->texCoords[ 1 ] = texCoordMaxY;
 					++pScreenVertices;
-
-					x += Font::Fixed26x6ToFloat32( rCharacter.advance );
 				}
 			}
 			else
 			{
-				pGlyphIndex += glyphCount;
+				pGlyph += glyphCount;
 
 				size_t vertexSkipCount = glyphCount * 4;
 				MemoryZero( pScreenVertices, vertexSkipCount * sizeof( *pScreenVertices ) );
@@ -1071,7 +909,7 @@ void BufferedDrawer::BeginDrawing()
 			rResourceSet.spProjectedTextVertexBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
 		HELIUM_ASSERT( pProjectedVertices );
 
-		uint32_t* pGlyphIndex = m_projectedTextGlyphIndices.GetData();
+		const TextLayoutCache::Glyph* pGlyph = m_projectedTextGlyphs.GetData();
 
 		size_t textDrawCount = m_projectedTextDrawCalls.GetSize();
 		for( size_t drawIndex = 0; drawIndex < textDrawCount; ++drawIndex )
@@ -1090,17 +928,14 @@ void BufferedDrawer::BeginDrawing()
 				float32_t y = static_cast< float32_t >( rDrawCall.y );
 				Color color = rDrawCall.color;
 
-				float32_t inverseTextureWidth = 1.0f / static_cast< float32_t >( pFont->GetTextureSheetWidth() );
-				float32_t inverseTextureHeight = 1.0f / static_cast< float32_t >( pFont->GetTextureSheetHeight() );
-
 				uint32_t fontCharacterCount = pFont->GetCharacterCount();
 
 				for( uint_fast32_t glyphIndexOffset = 0; glyphIndexOffset < glyphCount; ++glyphIndexOffset )
 				{
-					uint32_t glyphIndex = *pGlyphIndex;
-					++pGlyphIndex;
+					const TextLayoutCache::Glyph& rGlyph = *pGlyph;
+					++pGlyph;
 
-					if( glyphIndex >= fontCharacterCount )
+					if( rGlyph.characterIndex >= fontCharacterCount )
 					{
 						MemoryZero( pProjectedVertices, sizeof( *pProjectedVertices ) * 4 );
 						pProjectedVertices += 4;
@@ -1108,26 +943,26 @@ void BufferedDrawer::BeginDrawing()
 						continue;
 					}
 
-					const Font::Character& rCharacter = pFont->GetCharacter( glyphIndex );
+					const Font::Character& rCharacter = pFont->GetCharacter( rGlyph.characterIndex );
 
-					float32_t imageWidthFloat = static_cast< float32_t >( rCharacter.imageWidth );
-					float32_t imageHeightFloat = static_cast< float32_t >( rCharacter.imageHeight );
+					float32_t cornerMinX = x + rGlyph.cornerMinX;
+					float32_t cornerMinY = y - rGlyph.cornerTopY;
+					float32_t cornerMaxX = x + rGlyph.cornerMaxX;
+					float32_t cornerMaxY = y - rGlyph.cornerBottomY;
 
-					float32_t cornerMinX = Floor( x + 0.5f ) + static_cast< float32_t >( rCharacter.bearingX >> 6 );
-					float32_t cornerMinY = y - static_cast< float32_t >( rCharacter.bearingY >> 6 );
-					float32_t cornerMaxX = cornerMinX + imageWidthFloat;
-					float32_t cornerMaxY = cornerMinY + imageHeightFloat;
+					// Characters without an available image are left with empty texture coordinates and skipped when
+					// drawing.
+					Font::GlyphImage image;
+					if( !pFont->GetGlyphImage( rCharacter, image ) )
+					{
+						MemoryZero( &image, sizeof( image ) );
+					}
 
 					Float32 texCoordMinX32, texCoordMinY32, texCoordMaxX32, texCoordMaxY32;
-					texCoordMinX32.value = static_cast< float32_t >( rCharacter.imageX );
-					texCoordMinY32.value = static_cast< float32_t >( rCharacter.imageY );
-					texCoordMaxX32.value = texCoordMinX32.value + imageWidthFloat;
-					texCoordMaxY32.value = texCoordMinY32.value + imageHeightFloat;
-
-					texCoordMinX32.value *= inverseTextureWidth;
-					texCoordMinY32.value *= inverseTextureHeight;
-					texCoordMaxX32.value *= inverseTextureWidth;
-					texCoordMaxY32.value *= inverseTextureHeight;
+					texCoordMinX32.value = image.texCoordMinX;
+					texCoordMinY32.value = image.texCoordMinY;
+					texCoordMaxX32.value = image.texCoordMaxX;
+					texCoordMaxY32.value = image.texCoordMaxY;
 
 					Float16 texCoordMinX = Float32To16( texCoordMinX32 );
 					Float16 texCoordMinY = Float32To16( texCoordMinY32 );
@@ -1185,13 +1020,11 @@ void BufferedDrawer::BeginDrawing()
 					pProjectedVertices->screenOffset[ 0 ] = cornerMinX;
 					pProjectedVertices->screenOffset[ 1 ] = cornerMaxY;
 					++pProjectedVertices;
-
-					x += Font::Fixed26x6ToFloat32( rCharacter.advance );
 				}
 			}
 			else
 			{
-				pGlyphIndex += glyphCount;
+				pGlyph += glyphCount;
 
 				size_t vertexSkipCount = glyphCount * 4;
 				MemoryZero( pProjectedVertices, vertexSkipCount * sizeof( *pProjectedVertices ) );
@@ -1202,6 +1035,13 @@ void BufferedDrawer::BeginDrawing()
 		rResourceSet.spProjectedTextVertexBuffer->Unmap();
 	}
 
+	// Upload any character images added to the glyph cache while building the text geometry.
+	GlyphCache* pGlyphCache = GlyphCache::GetInstance();
+	if( pGlyphCache )
+	{
+		pGlyphCache->Flush();
+	}
+
 	// Clear the buffered vertex and index data, as it is no longer needed.
 	m_untexturedVertices.RemoveAll();
 	m_texturedVertices.RemoveAll();
@@ -1233,32 +1073,27 @@ void BufferedDrawer::EndDrawing()
 		HELIUM_ASSERT( m_untexturedIndices.IsEmpty() );
 		HELIUM_ASSERT( m_texturedVertices.IsEmpty() );
 		HELIUM_ASSERT( m_texturedIndices.IsEmpty() );
-		HELIUM_ASSERT( m_screenTextGlyphIndices.IsEmpty() );
+		HELIUM_ASSERT( m_screenTextGlyphs.IsEmpty() );
+		HELIUM_ASSERT( m_projectedTextGlyphs.IsEmpty() );
 
 		return;
 	}
 
 	// Clear all buffered draw call data.
-	m_screenTextGlyphIndices.RemoveAll();
+	m_screenTextGlyphs.RemoveAll();
+	m_projectedTextGlyphs.RemoveAll();
 	m_projectedTextDrawCalls.RemoveAll();
 	m_screenTextDrawCalls.RemoveAll();
 
-	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_untexturedDrawCalls ); ++stateIndex )
+	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_worldTextDrawCalls ); ++stateIndex )
 	{
 		m_worldTextDrawCalls[ stateIndex ].RemoveAll();
-
-		m_texturedBufferDrawCalls[ stateIndex ].RemoveAll();
-		m_untexturedBufferDrawCalls[ stateIndex ].RemoveAll();
-
-		m_texturedDrawCalls[ stateIndex ].RemoveAll();
-		m_untexturedDrawCalls[ stateIndex ].RemoveAll();
 	}
 
-	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_pointDrawCalls ); ++stateIndex )
-	{
-		m_pointBufferDrawCalls[ stateIndex ].RemoveAll();
-		m_pointDrawCalls[ stateIndex ].RemoveAll();
-	}
+	RemoveAll();
+
+	// Evict text layouts that are no longer being drawn.
+	m_textLayoutCache.Update();
 
 	// Release all fences used to block the usage lifetime of various instance-specific shader constant buffers.
 	for( size_t fenceIndex = 0; fenceIndex < HELIUM_ARRAY_COUNT( m_instanceVertexConstantFences ); ++fenceIndex )
@@ -1430,9 +1265,6 @@ void BufferedDrawer::DrawWorldElements( const Simd::Matrix44& rInverseViewProjec
 	worldResources.spCommandProxy = pRenderer->GetImmediateCommandProxy();
 	HELIUM_ASSERT( worldResources.spCommandProxy );
 
-	StateCache stateCache( worldResources.spCommandProxy );
-	worldResources.pStateCache = &stateCache;
-
 	// Depth-stencil states are fortunately already sorted in the order in which we want to render them (full depth
 	// testing/writing, testing only, and finally no depth testing/writing), so we can just loop through them normally.
 	for( size_t depthStencilStateIndex = 0;
@@ -1445,13 +1277,16 @@ void BufferedDrawer::DrawWorldElements( const Simd::Matrix44& rInverseViewProjec
 	}
 
 	// Unset resources.
-	stateCache.SetVertexBuffer( NULL, 0 );
-	stateCache.SetIndexBuffer( NULL );
-	stateCache.SetVertexShader( NULL );
-	stateCache.SetPixelShader( NULL );
-	stateCache.SetVertexInputLayout( NULL );
-	stateCache.SetPixelConstantBuffer( NULL );
-	stateCache.SetTexture( NULL );
+	RRenderCommandProxy* pCommandProxy = worldResources.spCommandProxy;
+	BindVertexBuffer( pCommandProxy, NULL, 0 );
+	pCommandProxy->SetIndexBuffer( NULL );
+	pCommandProxy->SetVertexShader( NULL );
+	pCommandProxy->SetPixelShader( NULL );
+	pCommandProxy->SetVertexInputLayout( NULL );
+
+	RConstantBuffer* pNullConstantBuffer = NULL;
+	pCommandProxy->SetPixelConstantBuffers( 0, 1, &pNullConstantBuffer );
+	pCommandProxy->SetTexture( 0, NULL );
 }
 
 /// Issue draw commands for buffered development-mode draw calls in screen space.
@@ -1549,22 +1384,24 @@ void BufferedDrawer::DrawScreenElements()
 
 	// Draw each block of text.
 	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-	StateCache stateCache( spCommandProxy );
 
 	RVertexBuffer* pScreenSpaceTextVertexBuffer =
 		m_resourceSets[ m_currentResourceSetIndex ].spScreenSpaceTextVertexBuffer;
 	if( pScreenSpaceTextVertexBuffer && screenTextDrawCount != 0 && spScreenTextVertexShader )
 	{
-		stateCache.SetVertexShader( spScreenTextVertexShader );
-		stateCache.SetPixelShader( spScreenTextPixelShader );
+		spCommandProxy->SetVertexShader( spScreenTextVertexShader );
+		spCommandProxy->SetPixelShader( spScreenTextPixelShader );
 
-		stateCache.SetVertexBuffer( pScreenSpaceTextVertexBuffer, static_cast< uint32_t >( sizeof( ScreenVertex ) ) );
-		stateCache.SetIndexBuffer( m_spScreenSpaceTextIndexBuffer );
+		BindVertexBuffer(
+			spCommandProxy,
+			pScreenSpaceTextVertexBuffer,
+			static_cast< uint32_t >( sizeof( ScreenVertex ) ) );
+		spCommandProxy->SetIndexBuffer( m_spScreenSpaceTextIndexBuffer );
 
 		spScreenTextVertexShader->CacheDescription( pRenderer, spScreenVertexDescription );
 		RVertexInputLayout* pVertexInputLayout = spScreenTextVertexShader->GetCachedInputLayout();
 		HELIUM_ASSERT( pVertexInputLayout );
-		stateCache.SetVertexInputLayout( pVertexInputLayout );
+		spCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
 		uint_fast32_t glyphIndexOffset = 0;
 
@@ -1586,14 +1423,14 @@ void BufferedDrawer::DrawScreenElements()
 
 			for( uint_fast32_t drawCallGlyphIndex = 0; drawCallGlyphIndex < drawCallGlyphCount; ++drawCallGlyphIndex )
 			{
-				uint32_t glyphIndex = m_screenTextGlyphIndices[ glyphIndexOffset ];
+				uint32_t glyphIndex = m_screenTextGlyphs[ glyphIndexOffset ].characterIndex;
 				if( glyphIndex < fontCharacterCount )
 				{
 					const Font::Character& rCharacter = pFont->GetCharacter( glyphIndex );
-					RTexture2d* pTexture = pFont->GetTextureSheet( rCharacter.texture );
+					RTexture2d* pTexture = pFont->GetGlyphTexture( rCharacter );
 					if( pTexture )
 					{
-						stateCache.SetTexture( pTexture );
+						spCommandProxy->SetTexture( 0, pTexture );
 
 						spCommandProxy->DrawIndexed(
 							RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST,
@@ -1613,22 +1450,25 @@ void BufferedDrawer::DrawScreenElements()
 	RVertexBuffer* pProjectedTextVertexBuffer = m_resourceSets[ m_currentResourceSetIndex ].spProjectedTextVertexBuffer;
 	if( pProjectedTextVertexBuffer && projectedTextDrawCount != 0 && spProjectedTextVertexShader )
 	{
-		stateCache.SetVertexShader( spProjectedTextVertexShader );
-		stateCache.SetPixelShader( spScreenTextPixelShader );
+		spCommandProxy->SetVertexShader( spProjectedTextVertexShader );
+		spCommandProxy->SetPixelShader( spScreenTextPixelShader );
 
-		stateCache.SetVertexBuffer( pProjectedTextVertexBuffer, static_cast< uint32_t >( sizeof( ProjectedVertex ) ) );
-		stateCache.SetIndexBuffer( m_spScreenSpaceTextIndexBuffer );
+		BindVertexBuffer(
+			spCommandProxy,
+			pProjectedTextVertexBuffer,
+			static_cast< uint32_t >( sizeof( ProjectedVertex ) ) );
+		spCommandProxy->SetIndexBuffer( m_spScreenSpaceTextIndexBuffer );
 
 		spProjectedTextVertexShader->CacheDescription( pRenderer, spProjectedVertexDescription );
 		RVertexInputLayout* pVertexInputLayout = spProjectedTextVertexShader->GetCachedInputLayout();
 		HELIUM_ASSERT( pVertexInputLayout );
-		stateCache.SetVertexInputLayout( pVertexInputLayout );
+		spCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
 		uint_fast32_t glyphIndexOffset = 0;
 
-		for( size_t drawIndex = 0; drawIndex < screenTextDrawCount; ++drawIndex )
+		for( size_t drawIndex = 0; drawIndex < projectedTextDrawCount; ++drawIndex )
 		{
-			const ScreenTextDrawCall& rDrawCall = m_screenTextDrawCalls[ drawIndex ];
+			const ProjectedTextDrawCall& rDrawCall = m_projectedTextDrawCalls[ drawIndex ];
 
 			uint_fast32_t drawCallGlyphCount = rDrawCall.glyphCount;
 
@@ -1644,14 +1484,14 @@ void BufferedDrawer::DrawScreenElements()
 
 			for( uint_fast32_t drawCallGlyphIndex = 0; drawCallGlyphIndex < drawCallGlyphCount; ++drawCallGlyphIndex )
 			{
-				uint32_t glyphIndex = m_screenTextGlyphIndices[ glyphIndexOffset ];
+				uint32_t glyphIndex = m_projectedTextGlyphs[ glyphIndexOffset ].characterIndex;
 				if( glyphIndex < fontCharacterCount )
 				{
 					const Font::Character& rCharacter = pFont->GetCharacter( glyphIndex );
-					RTexture2d* pTexture = pFont->GetTextureSheet( rCharacter.texture );
+					RTexture2d* pTexture = pFont->GetGlyphTexture( rCharacter );
 					if( pTexture )
 					{
-						stateCache.SetTexture( pTexture );
+						spCommandProxy->SetTexture( 0, pTexture );
 
 						spCommandProxy->DrawIndexed(
 							RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST,
@@ -1668,7 +1508,7 @@ void BufferedDrawer::DrawScreenElements()
 		}
 	}
 
-	stateCache.SetTexture( NULL );
+	spCommandProxy->SetTexture( 0, NULL );
 }
 
 /// Draw world elements for the specified depth-stencil state.
@@ -1693,9 +1533,6 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 	RRenderCommandProxy* pCommandProxy = rWorldResources.spCommandProxy;
 	HELIUM_ASSERT( pCommandProxy );
 
-	StateCache* pStateCache = rWorldResources.pStateCache;
-	HELIUM_ASSERT( pStateCache );
-
 	RBlendState* pBlendStateTransparent = pRenderResourceManager->GetBlendState(
 		RenderResourceManager::BLEND_STATE_TRANSPARENT );
 	HELIUM_ASSERT( pBlendStateTransparent );
@@ -1723,12 +1560,12 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 		size_t texturedBufferDrawCallCount = rTexturedBufferDrawCalls.GetSize();
 		if( texturedBufferDrawCallCount != 0 && rWorldResources.spTextureBlendVertexShader )
 		{
-			pStateCache->SetRasterizerState( pRasterizerState );
-			pStateCache->SetBlendState( pBlendStateTransparent );
-			pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+			pCommandProxy->SetRasterizerState( pRasterizerState );
+			pCommandProxy->SetBlendState( pBlendStateTransparent );
+			pCommandProxy->SetDepthStencilState( pDepthStencilState, 0 );
 
-			pStateCache->SetVertexShader( rWorldResources.spTextureBlendVertexShader );
-			pStateCache->SetPixelShader( rWorldResources.spTextureBlendPixelShader );
+			pCommandProxy->SetVertexShader( rWorldResources.spTextureBlendVertexShader );
+			pCommandProxy->SetPixelShader( rWorldResources.spTextureBlendPixelShader );
 
 			rWorldResources.spTextureBlendVertexShader->CacheDescription(
 				pRenderer,
@@ -1736,16 +1573,17 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 			RVertexInputLayout* pVertexInputLayout =
 				rWorldResources.spTextureBlendVertexShader->GetCachedInputLayout();
 			HELIUM_ASSERT( pVertexInputLayout );
-			pStateCache->SetVertexInputLayout( pVertexInputLayout );
+			pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
 			for( size_t drawCallIndex = 0; drawCallIndex < texturedBufferDrawCallCount; ++drawCallIndex )
 			{
 				const TexturedBufferDrawCall& rDrawCall = rTexturedBufferDrawCalls[ drawCallIndex ];
 
-				pStateCache->SetVertexBuffer(
+				BindVertexBuffer(
+					pCommandProxy,
 					rDrawCall.spVertexBuffer,
 					static_cast< uint32_t >( sizeof( SimpleTexturedVertex ) ) );
-				pStateCache->SetTexture( rDrawCall.spTexture );
+				pCommandProxy->SetTexture( 0, rDrawCall.spTexture );
 
 				RConstantBuffer* pConstantBuffer = SetInstanceVertexConstantData(
 					pCommandProxy,
@@ -1753,16 +1591,16 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					rInverseViewProjection,
 					rDrawCall.transform );
 				HELIUM_ASSERT( pConstantBuffer );
-				pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+				pCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
 
 				pConstantBuffer = SetInstancePixelConstantData( pCommandProxy, rResourceSet, rDrawCall.blendColor );
 				HELIUM_ASSERT( pConstantBuffer );
-				pStateCache->SetPixelConstantBuffer( pConstantBuffer );
+				pCommandProxy->SetPixelConstantBuffers( 0, 1, &pConstantBuffer );
 
 				RIndexBuffer* pIndexBuffer = rDrawCall.spIndexBuffer;
 				if( pIndexBuffer )
 				{
-					pStateCache->SetIndexBuffer( pIndexBuffer );
+					pCommandProxy->SetIndexBuffer( pIndexBuffer );
 					pCommandProxy->DrawIndexed(
 						rDrawCall.primitiveType,
 						rDrawCall.baseVertexIndex,
@@ -1790,23 +1628,24 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 
 			if( ( texturedDrawCallCount | worldTextDrawCallCount ) != 0 )
 			{
-				pStateCache->SetVertexBuffer(
+				BindVertexBuffer(
+					pCommandProxy,
 					rResourceSet.spTexturedVertexBuffer,
 					static_cast< uint32_t >( sizeof( SimpleTexturedVertex ) ) );
 
 				if ( rResourceSet.spTexturedIndexBuffer )
 				{
-					pStateCache->SetIndexBuffer( rResourceSet.spTexturedIndexBuffer );
+					pCommandProxy->SetIndexBuffer( rResourceSet.spTexturedIndexBuffer );
 				}
 				
 				if( texturedDrawCallCount != 0 && rWorldResources.spTextureBlendVertexShader )
 				{
-					pStateCache->SetRasterizerState( pRasterizerState );
-					pStateCache->SetBlendState( pBlendStateTransparent );
-					pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+					pCommandProxy->SetRasterizerState( pRasterizerState );
+					pCommandProxy->SetBlendState( pBlendStateTransparent );
+					pCommandProxy->SetDepthStencilState( pDepthStencilState, 0 );
 
-					pStateCache->SetVertexShader( rWorldResources.spTextureBlendVertexShader );
-					pStateCache->SetPixelShader( rWorldResources.spTextureBlendPixelShader );
+					pCommandProxy->SetVertexShader( rWorldResources.spTextureBlendVertexShader );
+					pCommandProxy->SetPixelShader( rWorldResources.spTextureBlendPixelShader );
 
 					rWorldResources.spTextureBlendVertexShader->CacheDescription(
 						pRenderer,
@@ -1814,13 +1653,13 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					RVertexInputLayout* pVertexInputLayout =
 						rWorldResources.spTextureBlendVertexShader->GetCachedInputLayout();
 					HELIUM_ASSERT( pVertexInputLayout );
-					pStateCache->SetVertexInputLayout( pVertexInputLayout );
+					pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
 					for( size_t drawCallIndex = 0; drawCallIndex < texturedDrawCallCount; ++drawCallIndex )
 					{
 						const TexturedDrawCall& rDrawCall = rTexturedDrawCalls[ drawCallIndex ];
 
-						pStateCache->SetTexture( rDrawCall.spTexture );
+						pCommandProxy->SetTexture( 0, rDrawCall.spTexture );
 						
 						RConstantBuffer* pConstantBuffer = SetInstanceVertexConstantData(
 							pCommandProxy,
@@ -1828,14 +1667,14 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 							rInverseViewProjection,
 							rDrawCall.transform );
 						HELIUM_ASSERT( pConstantBuffer );
-						pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+						pCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
 
 						RConstantBuffer* pPixelConstantBuffer = SetInstancePixelConstantData(
 							pCommandProxy,
 							rResourceSet,
 							rDrawCall.blendColor );
 						HELIUM_ASSERT( pPixelConstantBuffer );
-						pStateCache->SetPixelConstantBuffer( pPixelConstantBuffer );
+						pCommandProxy->SetPixelConstantBuffers( 0, 1, &pPixelConstantBuffer );
 
 						uint32_t startIndex = rDrawCall.startIndex;
 						if( IsValid( startIndex ) )
@@ -1860,12 +1699,12 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 
 				if( worldTextDrawCallCount != 0 && rWorldResources.spTextureAlphaVertexShader )
 				{
-					pStateCache->SetRasterizerState( pRasterizerState );
-					pStateCache->SetBlendState( pBlendStateTransparent );
-					pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+					pCommandProxy->SetRasterizerState( pRasterizerState );
+					pCommandProxy->SetBlendState( pBlendStateTransparent );
+					pCommandProxy->SetDepthStencilState( pDepthStencilState, 0 );
 
-					pStateCache->SetVertexShader( rWorldResources.spTextureAlphaVertexShader );
-					pStateCache->SetPixelShader( rWorldResources.spTextureAlphaPixelShader );
+					pCommandProxy->SetVertexShader( rWorldResources.spTextureAlphaVertexShader );
+					pCommandProxy->SetPixelShader( rWorldResources.spTextureAlphaPixelShader );
 
 					rWorldResources.spTextureAlphaVertexShader->CacheDescription(
 						pRenderer,
@@ -1873,7 +1712,7 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					RVertexInputLayout* pVertexInputLayout =
 						rWorldResources.spTextureAlphaVertexShader->GetCachedInputLayout();
 					HELIUM_ASSERT( pVertexInputLayout );
-					pStateCache->SetVertexInputLayout( pVertexInputLayout );
+					pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
 					RConstantBuffer* pConstantBuffer = SetInstanceVertexConstantData(
 							pCommandProxy,
@@ -1881,20 +1720,20 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 							rInverseViewProjection,
 							Simd::Matrix44::IDENTITY);
 					HELIUM_ASSERT( pConstantBuffer );
-					pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+					pCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
 
 					for( size_t drawCallIndex = 0; drawCallIndex < worldTextDrawCallCount; ++drawCallIndex )
 					{
 						const TexturedDrawCall& rDrawCall = rWorldTextDrawCalls[ drawCallIndex ];
 
-						pStateCache->SetTexture( rDrawCall.spTexture );
+						pCommandProxy->SetTexture( 0, rDrawCall.spTexture );
 
 						RConstantBuffer* pPixelConstantBuffer = SetInstancePixelConstantData(
 							pCommandProxy,
 							rResourceSet,
 							rDrawCall.blendColor );
 						HELIUM_ASSERT( pPixelConstantBuffer );
-						pStateCache->SetPixelConstantBuffer( pPixelConstantBuffer );
+						pCommandProxy->SetPixelConstantBuffers( 0, 1, &pPixelConstantBuffer );
 
 						HELIUM_ASSERT( IsValid( rDrawCall.startIndex ) );  // Text should always used indexed rendering.
 						pCommandProxy->DrawIndexed(
@@ -1917,12 +1756,12 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 			size_t untexturedBufferDrawCallCount = rUntexturedBufferDrawCalls.GetSize();
 			if( untexturedBufferDrawCallCount != 0 )
 			{
-				pStateCache->SetRasterizerState( pRasterizerState );
-				pStateCache->SetBlendState( pBlendStateTransparent );
-				pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+				pCommandProxy->SetRasterizerState( pRasterizerState );
+				pCommandProxy->SetBlendState( pBlendStateTransparent );
+				pCommandProxy->SetDepthStencilState( pDepthStencilState, 0 );
 
-				pStateCache->SetVertexShader( rWorldResources.spUntexturedVertexShader );
-				pStateCache->SetPixelShader( rWorldResources.spUntexturedPixelShader );
+				pCommandProxy->SetVertexShader( rWorldResources.spUntexturedVertexShader );
+				pCommandProxy->SetPixelShader( rWorldResources.spUntexturedPixelShader );
 
 				rWorldResources.spUntexturedVertexShader->CacheDescription(
 					pRenderer,
@@ -1930,15 +1769,16 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 				RVertexInputLayout* pVertexInputLayout =
 					rWorldResources.spUntexturedVertexShader->GetCachedInputLayout();
 				HELIUM_ASSERT( pVertexInputLayout );
-				pStateCache->SetVertexInputLayout( pVertexInputLayout );
+				pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
-				pStateCache->SetTexture( NULL );
+				pCommandProxy->SetTexture( 0, NULL );
 
 				for( size_t drawCallIndex = 0; drawCallIndex < untexturedBufferDrawCallCount; ++drawCallIndex )
 				{
 					const UntexturedBufferDrawCall& rDrawCall = rUntexturedBufferDrawCalls[ drawCallIndex ];
 
-					pStateCache->SetVertexBuffer(
+					BindVertexBuffer(
+						pCommandProxy,
 						rDrawCall.spVertexBuffer,
 						static_cast< uint32_t >( sizeof( SimpleVertex ) ) );
 
@@ -1948,19 +1788,19 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 						rInverseViewProjection,
 						rDrawCall.transform );
 					HELIUM_ASSERT( pConstantBuffer );
-					pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+					pCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
 
 					RConstantBuffer* pPixelConstantBuffer = SetInstancePixelConstantData(
 						pCommandProxy,
 						rResourceSet,
 						rDrawCall.blendColor );
 					HELIUM_ASSERT( pPixelConstantBuffer );
-					pStateCache->SetPixelConstantBuffer( pPixelConstantBuffer );
+					pCommandProxy->SetPixelConstantBuffers( 0, 1, &pPixelConstantBuffer );
 
 					RIndexBuffer* pIndexBuffer = rDrawCall.spIndexBuffer;
 					if( pIndexBuffer )
 					{
-						pStateCache->SetIndexBuffer( pIndexBuffer );
+						pCommandProxy->SetIndexBuffer( pIndexBuffer );
 						pCommandProxy->DrawIndexed(
 							rDrawCall.primitiveType,
 							rDrawCall.baseVertexIndex,
@@ -1985,20 +1825,21 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 				size_t untexturedDrawCallCount = rUntexturedDrawCalls.GetSize();
 				if( untexturedDrawCallCount != 0 )
 				{
-					pStateCache->SetRasterizerState( pRasterizerState );
-					pStateCache->SetBlendState( pBlendStateTransparent );
-					pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+					pCommandProxy->SetRasterizerState( pRasterizerState );
+					pCommandProxy->SetBlendState( pBlendStateTransparent );
+					pCommandProxy->SetDepthStencilState( pDepthStencilState, 0 );
 
-					pStateCache->SetVertexShader( rWorldResources.spUntexturedVertexShader );
-					pStateCache->SetPixelShader( rWorldResources.spUntexturedPixelShader );
+					pCommandProxy->SetVertexShader( rWorldResources.spUntexturedVertexShader );
+					pCommandProxy->SetPixelShader( rWorldResources.spUntexturedPixelShader );
 
-					pStateCache->SetVertexBuffer(
+					BindVertexBuffer(
+						pCommandProxy,
 						rResourceSet.spUntexturedVertexBuffer,
 						static_cast< uint32_t >( sizeof( SimpleVertex ) ) );
 
 					if ( rResourceSet.spUntexturedIndexBuffer )
 					{
-						pStateCache->SetIndexBuffer( rResourceSet.spUntexturedIndexBuffer );
+						pCommandProxy->SetIndexBuffer( rResourceSet.spUntexturedIndexBuffer );
 					}
 
 					rWorldResources.spUntexturedVertexShader->CacheDescription(
@@ -2007,9 +1848,9 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					RVertexInputLayout* pVertexInputLayout =
 						rWorldResources.spUntexturedVertexShader->GetCachedInputLayout();
 					HELIUM_ASSERT( pVertexInputLayout );
-					pStateCache->SetVertexInputLayout( pVertexInputLayout );
+					pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
-					pStateCache->SetTexture( NULL );
+					pCommandProxy->SetTexture( 0, NULL );
 
 					for( size_t drawCallIndex = 0; drawCallIndex < untexturedDrawCallCount; ++drawCallIndex )
 					{
@@ -2021,14 +1862,14 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 							rInverseViewProjection,
 							rDrawCall.transform );
 						HELIUM_ASSERT( pConstantBuffer );
-						pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+						pCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
 
 						RConstantBuffer* pPixelConstantBuffer = SetInstancePixelConstantData(
 							pCommandProxy,
 							rResourceSet,
 							rDrawCall.blendColor );
 						HELIUM_ASSERT( pPixelConstantBuffer );
-						pStateCache->SetPixelConstantBuffer( pPixelConstantBuffer );
+						pCommandProxy->SetPixelConstantBuffers( 0, 1, &pPixelConstantBuffer );
 
 						uint32_t startIndex = rDrawCall.startIndex;
 						if( IsValid( startIndex ) )
@@ -2065,12 +1906,12 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 		size_t pointBufferDrawCallCount = rPointBufferDrawCalls.GetSize();
 		if( pointBufferDrawCallCount != 0 )
 		{
-			pStateCache->SetRasterizerState( pRasterizerState );
-			pStateCache->SetBlendState( pBlendStateTransparent );
-			pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+			pCommandProxy->SetRasterizerState( pRasterizerState );
+			pCommandProxy->SetBlendState( pBlendStateTransparent );
+			pCommandProxy->SetDepthStencilState( pDepthStencilState, 0 );
 
-			pStateCache->SetVertexShader( rWorldResources.spUntexturedPointsVertexShader );
-			pStateCache->SetPixelShader( rWorldResources.spUntexturedPixelShader );
+			pCommandProxy->SetVertexShader( rWorldResources.spUntexturedPointsVertexShader );
+			pCommandProxy->SetPixelShader( rWorldResources.spUntexturedPixelShader );
 
 			rWorldResources.spUntexturedPointsVertexShader->CacheDescription(
 				pRenderer,
@@ -2078,15 +1919,16 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 			RVertexInputLayout* pVertexInputLayout =
 				rWorldResources.spUntexturedPointsVertexShader->GetCachedInputLayout();
 			HELIUM_ASSERT( pVertexInputLayout );
-			pStateCache->SetVertexInputLayout( pVertexInputLayout );
+			pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
-			pStateCache->SetTexture( NULL );
+			pCommandProxy->SetTexture( 0, NULL );
 
 			for( size_t drawCallIndex = 0; drawCallIndex < pointBufferDrawCallCount; ++drawCallIndex )
 			{
 				const UntexturedBufferDrawCall& rDrawCall = rPointBufferDrawCalls[ drawCallIndex ];
 
-				pStateCache->SetVertexBuffer(
+				BindVertexBuffer(
+					pCommandProxy,
 					rDrawCall.spVertexBuffer,
 					static_cast< uint32_t >( sizeof( SimpleVertex ) ) );
 
@@ -2096,14 +1938,14 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					rInverseViewProjection,
 					rDrawCall.transform );
 				HELIUM_ASSERT( pConstantBuffer );
-				pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+				pCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
 
 				RConstantBuffer* pPixelConstantBuffer = SetInstancePixelConstantData(
 					pCommandProxy,
 					rResourceSet,
 					rDrawCall.blendColor );
 				HELIUM_ASSERT( pPixelConstantBuffer );
-				pStateCache->SetPixelConstantBuffer( pPixelConstantBuffer );
+				pCommandProxy->SetPixelConstantBuffers( 0, 1, &pPixelConstantBuffer );
 
 				HELIUM_ASSERT( !rDrawCall.spIndexBuffer );  // No index buffer is given for points.
 				pCommandProxy->DrawUnindexed(
@@ -2119,14 +1961,15 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 			size_t pointDrawCallCount = rPointDrawCalls.GetSize();
 			if( pointDrawCallCount != 0 )
 			{
-				pStateCache->SetRasterizerState( pRasterizerState );
-				pStateCache->SetBlendState( pBlendStateTransparent );
-				pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+				pCommandProxy->SetRasterizerState( pRasterizerState );
+				pCommandProxy->SetBlendState( pBlendStateTransparent );
+				pCommandProxy->SetDepthStencilState( pDepthStencilState, 0 );
 
-				pStateCache->SetVertexShader( rWorldResources.spUntexturedPointsVertexShader );
-				pStateCache->SetPixelShader( rWorldResources.spUntexturedPixelShader );
+				pCommandProxy->SetVertexShader( rWorldResources.spUntexturedPointsVertexShader );
+				pCommandProxy->SetPixelShader( rWorldResources.spUntexturedPixelShader );
 
-				pStateCache->SetVertexBuffer(
+				BindVertexBuffer(
+					pCommandProxy,
 					rResourceSet.spUntexturedVertexBuffer,
 					static_cast< uint32_t >( sizeof( SimpleVertex ) ) );
 				// No index buffer is given for points.
@@ -2137,9 +1980,9 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 				RVertexInputLayout* pVertexInputLayout =
 					rWorldResources.spUntexturedPointsVertexShader->GetCachedInputLayout();
 				HELIUM_ASSERT( pVertexInputLayout );
-				pStateCache->SetVertexInputLayout( pVertexInputLayout );
+				pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
 
-				pStateCache->SetTexture( NULL );
+				pCommandProxy->SetTexture( 0, NULL );
 
 				RConstantBuffer* pConstantBuffer = SetInstanceVertexConstantData(
 					pCommandProxy,
@@ -2147,7 +1990,7 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					rInverseViewProjection,
 					Simd::Matrix44::IDENTITY );
 				HELIUM_ASSERT( pConstantBuffer );
-				pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+				pCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
 
 				for( size_t drawCallIndex = 0; drawCallIndex < pointDrawCallCount; ++drawCallIndex )
 				{
@@ -2158,7 +2001,7 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 						rResourceSet,
 						rDrawCall.blendColor );
 					HELIUM_ASSERT( pPixelConstantBuffer );
-					pStateCache->SetPixelConstantBuffer( pPixelConstantBuffer );
+					pCommandProxy->SetPixelConstantBuffers( 0, 1, &pPixelConstantBuffer );
 
 					// No index buffer is given for points.
 					pCommandProxy->DrawUnindexed(
@@ -2303,464 +2146,3 @@ RConstantBuffer* BufferedDrawer::SetInstancePixelConstantData(
 
 	return rResourceSet.instancePixelConstantBuffers[ bufferIndex ];
 }
-
-/// Get the index into draw call arrays for the given rasterizer state and depth-stencil state combination.
-///
-/// @param[in] rasterizerState    Rasterizer state identifier.
-/// @param[in] depthStencilState  Depth-stencil state identifier.
-///
-/// @return  Array index for the given state combination.
-///
-/// @see GetStatesFromIndex()
-size_t BufferedDrawer::GetStateIndex(
-	RenderResourceManager::ERasterizerState rasterizerState,
-	RenderResourceManager::EDepthStencilState depthStencilState )
-{
-	HELIUM_ASSERT(
-		static_cast< size_t >( rasterizerState ) <
-		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
-	HELIUM_ASSERT(
-		static_cast< size_t >( depthStencilState ) <
-		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
-
-	return ( rasterizerState * RenderResourceManager::DEPTH_STENCIL_STATE_MAX + depthStencilState );
-}
-
-/// Get the rasterizer state and depth-stencil state identifiers for a given draw call array index.
-///
-/// @param[in]  stateIndex          Array index for a given state combination.
-/// @param[out] rRasterizerState    Rasterizer state associated with the given state index.
-/// @param[out] rDepthStencilState  Depth-stencil state associated with the given state index.
-///
-/// @see GetStateIndex()
-void BufferedDrawer::GetStatesFromIndex(
-	size_t stateIndex,
-	RenderResourceManager::ERasterizerState& rRasterizerState,
-	RenderResourceManager::EDepthStencilState& rDepthStencilState )
-{
-	HELIUM_ASSERT(
-		stateIndex <
-		( static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX *
-		  RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) ) );
-
-	rRasterizerState = static_cast< RenderResourceManager::ERasterizerState >(
-		stateIndex / RenderResourceManager::DEPTH_STENCIL_STATE_MAX );
-	rDepthStencilState = static_cast< RenderResourceManager::EDepthStencilState >(
-		stateIndex % RenderResourceManager::DEPTH_STENCIL_STATE_MAX );
-}
-
-/// Constructor.
-///
-/// @param[in] pCommandProxy  Render command proxy interface to use when issuing state changes.
-BufferedDrawer::StateCache::StateCache( RRenderCommandProxy* pCommandProxy )
-	: m_spRenderCommandProxy( pCommandProxy )
-	, m_stencilReferenceValue( 0 )
-	, m_vertexStride( 0 )
-{
-}
-
-/// Set the render command proxy to use for issuing state changes.
-///
-/// @param[in] pCommandProxy  Render command proxy interface to use when issuing state changes.
-void BufferedDrawer::StateCache::SetRenderCommandProxy( RRenderCommandProxy* pCommandProxy )
-{
-	if( m_spRenderCommandProxy != pCommandProxy )
-	{
-		m_spRenderCommandProxy = pCommandProxy;
-		ResetStateCache();
-	}
-}
-
-/// Set the rasterizer state.
-///
-/// @param[in] pState  Rasterizer state to set.
-void BufferedDrawer::StateCache::SetRasterizerState( RRasterizerState* pState )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spRasterizerState != pState )
-	{
-		m_spRasterizerState = pState;
-		m_spRenderCommandProxy->SetRasterizerState( pState );
-	}
-}
-
-/// Set the blend state.
-///
-/// @param[in] pState  Blend state to set.
-void BufferedDrawer::StateCache::SetBlendState( RBlendState* pState )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spBlendState != pState )
-	{
-		m_spBlendState = pState;
-		m_spRenderCommandProxy->SetBlendState( pState );
-	}
-}
-
-/// Set the depth-stencil state.
-///
-/// @param[in] pState                 Depth-stencil state to set.
-/// @param[in] stencilReferenceValue  Stencil reference value to set.
-void BufferedDrawer::StateCache::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spDepthStencilState != pState || m_stencilReferenceValue != stencilReferenceValue )
-	{
-		m_spDepthStencilState = pState;
-		m_stencilReferenceValue = stencilReferenceValue;
-		m_spRenderCommandProxy->SetDepthStencilState( pState, stencilReferenceValue );
-	}
-}
-
-/// Set the current vertex buffer.
-///
-/// @param[in] pBuffer  Vertex buffer to set.
-/// @param[in] stride   Bytes between consecutive vertices.
-void BufferedDrawer::StateCache::SetVertexBuffer( RVertexBuffer* pBuffer, uint32_t stride )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spVertexBuffer != pBuffer || m_vertexStride != stride )
-	{
-		m_spVertexBuffer = pBuffer;
-		m_vertexStride = stride;
-
-		uint32_t offset = 0;
-		m_spRenderCommandProxy->SetVertexBuffers( 0, 1, &pBuffer, &stride, &offset );
-	}
-}
-
-/// Set the current index buffer.
-///
-/// @param[in] pBuffer  Index buffer to set.
-void BufferedDrawer::StateCache::SetIndexBuffer( RIndexBuffer* pBuffer )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spIndexBuffer != pBuffer )
-	{
-		m_spIndexBuffer = pBuffer;
-		m_spRenderCommandProxy->SetIndexBuffer( pBuffer );
-	}
-}
-
-/// Set the current vertex shader.
-///
-/// @param[in] pShader  Vertex shader to set.
-void BufferedDrawer::StateCache::SetVertexShader( RVertexShader* pShader )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spVertexShader != pShader )
-	{
-		m_spVertexShader = pShader;
-		m_spRenderCommandProxy->SetVertexShader( pShader );
-	}
-}
-
-/// Set the current pixel shader.
-///
-/// @param[in] pShader  Pixel shader to set.
-void BufferedDrawer::StateCache::SetPixelShader( RPixelShader* pShader )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spPixelShader != pShader )
-	{
-		m_spPixelShader = pShader;
-		m_spRenderCommandProxy->SetPixelShader( pShader );
-	}
-}
-
-/// Set the current vertex input layout.
-///
-/// @param[in] pLayout  Vertex input layout to set.
-void BufferedDrawer::StateCache::SetVertexInputLayout( RVertexInputLayout* pLayout )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spVertexInputLayout != pLayout )
-	{
-		m_spVertexInputLayout = pLayout;
-		m_spRenderCommandProxy->SetVertexInputLayout( pLayout );
-	}
-}
-
-/// Set the current vertex shader constant buffer.
-///
-/// @param[in] pConstantBuffer  Constant buffer to set.
-void BufferedDrawer::StateCache::SetVertexConstantBuffer( RConstantBuffer* pConstantBuffer )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spVertexConstantBuffer != pConstantBuffer )
-	{
-		m_spVertexConstantBuffer = pConstantBuffer;
-		m_spRenderCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
-	}
-}
-
-/// Set the current pixel shader constant buffer.
-///
-/// @param[in] pConstantBuffer  Constant buffer to set.
-void BufferedDrawer::StateCache::SetPixelConstantBuffer( RConstantBuffer* pConstantBuffer )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spPixelConstantBuffer != pConstantBuffer )
-	{
-		m_spPixelConstantBuffer = pConstantBuffer;
-		m_spRenderCommandProxy->SetPixelConstantBuffers( 0, 1, &pConstantBuffer );
-	}
-}
-
-/// Set the current texture.
-///
-/// @param[in] pTexture  Texture to set.
-void BufferedDrawer::StateCache::SetTexture( RTexture2d* pTexture )
-{
-	HELIUM_ASSERT( m_spRenderCommandProxy );
-
-	if( m_spTexture != pTexture )
-	{
-		m_spTexture = pTexture;
-		m_spRenderCommandProxy->SetTexture( 0, pTexture );
-	}
-}
-
-/// Clear all cached state data.
-void BufferedDrawer::StateCache::ResetStateCache()
-{
-	m_spRasterizerState.Release();
-	m_spBlendState.Release();
-	m_spDepthStencilState.Release();
-	m_stencilReferenceValue = 0;
-
-	m_spVertexBuffer.Release();
-	m_vertexStride = 0;
-
-	m_spIndexBuffer.Release();
-
-	m_spVertexShader.Release();
-	m_spPixelShader.Release();
-	m_spVertexInputLayout.Release();
-
-	m_spVertexConstantBuffer.Release();
-	m_spPixelConstantBuffer.Release();
-
-	m_spTexture.Release();
-}
-
-/// Constructor.
-///
-/// @param[in] pDrawer            Buffered drawer instance being used to perform the rendering.
-/// @param[in] pFont              Font being used for rendering.
-/// @param[in] color              Text color.
-/// @param[in] rasterizerState    Rasterizer state to use during rendering.
-/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
-/// @param[in] rTransform         World-space transform matrix.
-BufferedDrawer::WorldSpaceTextGlyphHandler::WorldSpaceTextGlyphHandler(
-	BufferedDrawer* pDrawer,
-	Font* pFont,
-	Color color,
-	RenderResourceManager::ERasterizerState rasterizerState,
-	RenderResourceManager::EDepthStencilState depthStencilState,
-	const Simd::Matrix44& rTransform )
-	: m_rTransform( rTransform )
-	, m_pDrawer( pDrawer )
-	, m_pFont( pFont )
-	, m_stateIndex( GetStateIndex( rasterizerState, depthStencilState ) )
-	, m_color( color )
-	, m_inverseTextureWidth( 1.0f / static_cast< float32_t >( pFont->GetTextureSheetWidth() ) )
-	, m_inverseTextureHeight( 1.0f / static_cast< float32_t >( pFont->GetTextureSheetHeight() ) )
-	, m_penX( 0.0f )
-{
-	m_quadIndices[ 0 ] = 0;
-	m_quadIndices[ 1 ] = 1;
-	m_quadIndices[ 2 ] = 2;
-	m_quadIndices[ 3 ] = 0;
-	m_quadIndices[ 4 ] = 2;
-	m_quadIndices[ 5 ] = 3;
-}
-
-/// Draw the specified character.
-///
-/// @param[in] pCharacter  Character to draw.
-void BufferedDrawer::WorldSpaceTextGlyphHandler::operator()( const Font::Character* pCharacter )
-{
-	HELIUM_ASSERT( pCharacter );
-
-	RTexture2d* pTexture = m_pFont->GetTextureSheet( pCharacter->texture );
-	if( !pTexture )
-	{
-		return;
-	}
-
-	float32_t imageWidthFloat = static_cast< float32_t >( pCharacter->imageWidth );
-	float32_t imageHeightFloat = static_cast< float32_t >( pCharacter->imageHeight );
-
-	float32_t cornerMinX = Floor( m_penX + 0.5f ) + static_cast< float32_t >( pCharacter->bearingX >> 6 );
-	float32_t cornerMinY = static_cast< float32_t >( pCharacter->bearingY >> 6 );
-	float32_t cornerMaxX = cornerMinX + imageWidthFloat;
-	float32_t cornerMaxY = cornerMinY - imageHeightFloat;
-
-	Simd::Vector3 corners[] =
-	{
-		Simd::Vector3( cornerMinX, cornerMinY, 0.0f ),
-		Simd::Vector3( cornerMaxX, cornerMinY, 0.0f ),
-		Simd::Vector3( cornerMaxX, cornerMaxY, 0.0f ),
-		Simd::Vector3( cornerMinX, cornerMaxY, 0.0f )
-	};
-
-	m_rTransform.TransformPoint( corners[ 0 ], corners[ 0 ] );
-	m_rTransform.TransformPoint( corners[ 1 ], corners[ 1 ] );
-	m_rTransform.TransformPoint( corners[ 2 ], corners[ 2 ] );
-	m_rTransform.TransformPoint( corners[ 3 ], corners[ 3 ] );
-
-	float32_t texCoordMinX = static_cast< float32_t >( pCharacter->imageX );
-	float32_t texCoordMinY = static_cast< float32_t >( pCharacter->imageY );
-	float32_t texCoordMaxX = texCoordMinX + imageWidthFloat;
-	float32_t texCoordMaxY = texCoordMinY + imageHeightFloat;
-
-	texCoordMinX *= m_inverseTextureWidth;
-	texCoordMinY *= m_inverseTextureHeight;
-	texCoordMaxX *= m_inverseTextureWidth;
-	texCoordMaxY *= m_inverseTextureHeight;
-
-	const SimpleTexturedVertex vertices[] =
-	{
-		SimpleTexturedVertex( corners[ 0 ], Simd::Vector2( texCoordMinX, texCoordMinY ), m_color ),
-		SimpleTexturedVertex( corners[ 1 ], Simd::Vector2( texCoordMaxX, texCoordMinY ), m_color ),
-		SimpleTexturedVertex( corners[ 2 ], Simd::Vector2( texCoordMaxX, texCoordMaxY ), m_color ),
-		SimpleTexturedVertex( corners[ 3 ], Simd::Vector2( texCoordMinX, texCoordMaxY ), m_color )
-	};
-
-	uint32_t baseVertexIndex = static_cast< uint32_t >( m_pDrawer->m_texturedVertices.GetSize() );
-	uint32_t startIndex = static_cast< uint32_t >( m_pDrawer->m_texturedIndices.GetSize() );
-
-	m_pDrawer->m_texturedVertices.AddArray( vertices, 4 );
-	m_pDrawer->m_texturedIndices.AddArray( m_quadIndices, 6 );
-
-	TexturedDrawCall* pDrawCall = m_pDrawer->m_worldTextDrawCalls[ m_stateIndex ].New();
-	HELIUM_ASSERT( pDrawCall );
-	pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST;
-	pDrawCall->baseVertexIndex = baseVertexIndex;
-	pDrawCall->vertexCount = 4;
-	pDrawCall->startIndex = startIndex;
-	pDrawCall->primitiveCount = 2;
-	pDrawCall->blendColor = Color( 0xffffffff );
-	pDrawCall->spTexture = pTexture;
-
-	m_penX += Font::Fixed26x6ToFloat32( pCharacter->advance );
-}
-
-/// Constructor.
-///
-/// @param[in] pDrawer  Buffered drawer instance being used to perform the rendering.
-/// @param[in] pFont    Font being used for rendering.
-/// @param[in] x        Pixel x-coordinate at which to begin rendering the text.
-/// @param[in] y        Pixel y-coordinate at which to begin rendering the text.
-/// @param[in] color    Color with which to render the text.
-/// @param[in] size     Size at which to render the text.
-BufferedDrawer::ScreenSpaceTextGlyphHandler::ScreenSpaceTextGlyphHandler(
-	BufferedDrawer* pDrawer,
-	Font* pFont,
-	int32_t x,
-	int32_t y,
-	Color color,
-	RenderResourceManager::EDebugFontSize size )
-	: m_pDrawer( pDrawer )
-	, m_pFont( pFont )
-	, m_pDrawCall( NULL )
-	, m_x( x )
-	, m_y( y )
-	, m_color( color )
-	, m_size( size )
-{
-}
-
-/// Draw the specified character.
-///
-/// @param[in] pCharacter  Character to draw.
-void BufferedDrawer::ScreenSpaceTextGlyphHandler::operator()( const Font::Character* pCharacter )
-{
-	HELIUM_ASSERT( pCharacter );
-
-	uint32_t characterIndex = m_pFont->GetCharacterIndex( pCharacter );
-
-	m_pDrawer->m_screenTextGlyphIndices.Push( characterIndex );
-
-	if( !m_pDrawCall )
-	{
-		m_pDrawCall = m_pDrawer->m_screenTextDrawCalls.New();
-		HELIUM_ASSERT( m_pDrawCall );
-		m_pDrawCall->x = m_x;
-		m_pDrawCall->y = m_y;
-		m_pDrawCall->color = m_color;
-		m_pDrawCall->size = m_size;
-		m_pDrawCall->glyphCount = 0;
-	}
-
-	++m_pDrawCall->glyphCount;
-}
-
-/// Constructor.
-///
-/// @param[in] pDrawer        Buffered drawer instance being used to perform the rendering.
-/// @param[in] pFont          Font being used for rendering.
-/// @param[in] rWorldOffset   World-space offset at which to begin rendering the text.
-/// @param[in] screenOffsetX  Horizontal pixel offset at which to begin rendering the text.
-/// @param[in] screenOffsetY  Vertical pixel offset at which to begin rendering the text.
-/// @param[in] color          Color with which to render the text.
-/// @param[in] size           Size at which to render the text.
-BufferedDrawer::ProjectedTextGlyphHandler::ProjectedTextGlyphHandler(
-	BufferedDrawer* pDrawer,
-	Font* pFont,
-	const Simd::Vector3& rWorldOffset,
-	int32_t screenOffsetX,
-	int32_t screenOffsetY,
-	Color color,
-	RenderResourceManager::EDebugFontSize size )
-	: m_pDrawer( pDrawer )
-	, m_pFont( pFont )
-	, m_pDrawCall( NULL )
-	, m_worldOffsetX( rWorldOffset.GetElement( 0 ) )
-	, m_worldOffsetY( rWorldOffset.GetElement( 1 ) )
-	, m_worldOffsetZ( rWorldOffset.GetElement( 2 ) )
-	, m_screenOffsetX( screenOffsetX )
-	, m_screenOffsetY( screenOffsetY )
-	, m_color( color )
-	, m_size( size )
-{
-}
-
-/// Draw the specified character.
-///
-/// @param[in] pCharacter  Character to draw.
-void BufferedDrawer::ProjectedTextGlyphHandler::operator()( const Font::Character* pCharacter )
-{
-	HELIUM_ASSERT( pCharacter );
-
-	uint32_t characterIndex = m_pFont->GetCharacterIndex( pCharacter );
-
-	m_pDrawer->m_screenTextGlyphIndices.Push( characterIndex );
-
-	if( !m_pDrawCall )
-	{
-		m_pDrawCall = m_pDrawer->m_projectedTextDrawCalls.New();
-		HELIUM_ASSERT( m_pDrawCall );
-		m_pDrawCall->x = m_screenOffsetX;
-		m_pDrawCall->y = m_screenOffsetY;
-		m_pDrawCall->color = m_color;
-		m_pDrawCall->size = m_size;
-		m_pDrawCall->glyphCount = 0;
-		m_pDrawCall->worldPosition[ 0 ] = m_worldOffsetX;
-		m_pDrawCall->worldPosition[ 1 ] = m_worldOffsetY;
-		m_pDrawCall->worldPosition[ 2 ] = m_worldOffsetZ;
-	}
-
-	++m_pDrawCall->glyphCount;
-}
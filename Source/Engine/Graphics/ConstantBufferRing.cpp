@@ -0,0 +1,196 @@
+#include "Precompile.h"
+#include "Graphics/ConstantBufferRing.h"
+
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RFence.h"
+#include "Rendering/RRenderCommandProxy.h"
+#include "Rendering/Renderer.h"
+
+using namespace Helium;
+
+/// Constructor.
+ConstantBufferRing::ConstantBufferRing()
+	: m_regionSize( 0 )
+	, m_regionIndex( REGION_COUNT - 1 )
+	, m_regionOffset( 0 )
+	, m_pMappedRegion( NULL )
+{
+}
+
+/// Destructor.
+ConstantBufferRing::~ConstantBufferRing()
+{
+	Shutdown();
+}
+
+/// Map the next frame region for suballocation.
+///
+/// @param[in] requiredSize  Total space, in bytes, needed for all allocations in the coming frame (each allocation
+///                          size should be computed using GetAllocationSize()).
+///
+/// @return  True if the region was mapped successfully, false if the ring buffer could not be created.
+///
+/// @see Allocate(), EndFrame(), FenceFrame()
+bool ConstantBufferRing::BeginFrame( size_t requiredSize )
+{
+	HELIUM_ASSERT( !m_pMappedRegion );
+
+	Renderer* pRenderer = Renderer::GetInstance();
+	if ( !pRenderer )
+	{
+		return false;
+	}
+
+	m_regionIndex = ( m_regionIndex + 1 ) % REGION_COUNT;
+	m_regionOffset = 0;
+
+	// Recreate the buffer with larger regions if the current frame will not fit.
+	requiredSize = GetAllocationSize( requiredSize );
+	if ( !m_spBuffer || requiredSize > m_regionSize )
+	{
+		SyncAllFences();
+		m_spBuffer.Release();
+
+		size_t regionSize = Max( Max( requiredSize, m_regionSize + m_regionSize / 2 ), REGION_SIZE_MIN );
+		regionSize = GetAllocationSize( regionSize );
+
+		m_spBuffer = pRenderer->CreateConstantBuffer( regionSize * REGION_COUNT, RENDERER_BUFFER_USAGE_DYNAMIC );
+		if ( !m_spBuffer )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				"ConstantBufferRing::BeginFrame(): Failed to create a constant ring buffer with %" PRIuSZ " bytes per frame.\n",
+				regionSize );
+
+			m_regionSize = 0;
+
+			return false;
+		}
+
+		m_regionSize = regionSize;
+		m_regionIndex = 0;
+	}
+
+	// Wait for the GPU to finish with the last frame that used this region.
+	RFencePtr& rspRegionFence = m_regionFences[m_regionIndex];
+	RFence* pRegionFence = rspRegionFence;
+	if ( pRegionFence )
+	{
+		pRenderer->SyncFence( pRegionFence );
+		rspRegionFence.Release();
+	}
+
+	ERendererBufferMapHint mapHint =
+		( m_regionIndex == 0 ? RENDERER_BUFFER_MAP_HINT_DISCARD : RENDERER_BUFFER_MAP_HINT_NO_OVERWRITE );
+	m_pMappedRegion = static_cast<uint8_t*>( m_spBuffer->Map( mapHint ) );
+	HELIUM_ASSERT( m_pMappedRegion );
+	m_pMappedRegion += m_regionIndex * m_regionSize;
+
+	return true;
+}
+
+/// Suballocate space for shader constants from the current frame region.
+///
+/// @param[in]  size     Number of bytes to allocate.
+/// @param[out] rOffset  Byte offset of the allocation within the ring buffer, for binding the range using
+///                      RRenderCommandProxy::SetVertexConstantBuffers() or SetPixelConstantBuffers().
+///
+/// @return  Address at which to write the constant data, or null if the frame region is out of space.
+///
+/// @see BeginFrame(), EndFrame()
+void* ConstantBufferRing::Allocate( size_t size, uint32_t& rOffset )
+{
+	HELIUM_ASSERT( m_pMappedRegion );
+
+	size = GetAllocationSize( size );
+	if ( size > m_regionSize - m_regionOffset )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"ConstantBufferRing::Allocate(): Frame region is out of space (%" PRIuSZ " bytes requested, %" PRIuSZ " bytes free).\n",
+			size,
+			m_regionSize - m_regionOffset );
+
+		return NULL;
+	}
+
+	void* pAllocation = m_pMappedRegion + m_regionOffset;
+	rOffset = static_cast<uint32_t>( m_regionIndex * m_regionSize + m_regionOffset );
+	m_regionOffset += size;
+
+	return pAllocation;
+}
+
+/// Unmap the current frame region once all constant data for the frame has been written.
+///
+/// @see BeginFrame(), FenceFrame()
+void ConstantBufferRing::EndFrame()
+{
+	if ( m_pMappedRegion )
+	{
+		HELIUM_ASSERT( m_spBuffer );
+		m_spBuffer->Unmap();
+		m_pMappedRegion = NULL;
+	}
+}
+
+/// Place a fence after all commands using the current frame region.
+///
+/// This should be called once all draw calls for the frame have been issued.
+///
+/// @param[in] pCommandProxy  Command proxy to which the fence should be issued.
+///
+/// @see EndFrame()
+void ConstantBufferRing::FenceFrame( RRenderCommandProxy* pCommandProxy )
+{
+	HELIUM_ASSERT( pCommandProxy );
+	HELIUM_ASSERT( !m_pMappedRegion );
+
+	if ( !m_spBuffer )
+	{
+		return;
+	}
+
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	RFencePtr& rspRegionFence = m_regionFences[m_regionIndex];
+	HELIUM_ASSERT( !rspRegionFence );
+	rspRegionFence = pRenderer->CreateFence();
+	HELIUM_ASSERT( rspRegionFence );
+	pCommandProxy->SetFence( rspRegionFence );
+}
+
+/// Release the ring buffer and all frame region fences.
+void ConstantBufferRing::Shutdown()
+{
+	EndFrame();
+
+	for ( size_t regionIndex = 0; regionIndex < REGION_COUNT; ++regionIndex )
+	{
+		m_regionFences[regionIndex].Release();
+	}
+
+	m_spBuffer.Release();
+	m_regionSize = 0;
+	m_regionIndex = REGION_COUNT - 1;
+	m_regionOffset = 0;
+}
+
+/// Wait for the GPU to finish with all frame regions.
+void ConstantBufferRing::SyncAllFences()
+{
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	for ( size_t regionIndex = 0; regionIndex < REGION_COUNT; ++regionIndex )
+	{
+		RFencePtr& rspRegionFence = m_regionFences[regionIndex];
+		RFence* pRegionFence = rspRegionFence;
+		if ( pRegionFence )
+		{
+			pRenderer->SyncFence( pRegionFence );
+			rspRegionFence.Release();
+		}
+	}
+}
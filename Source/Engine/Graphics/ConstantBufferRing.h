@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Rendering/RRenderResource.h"
+#include "Rendering/RendererTypes.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( RConstantBuffer );
+	HELIUM_DECLARE_RPTR( RFence );
+	HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+
+	/// Per-frame ring buffer for dynamic shader constants.
+	///
+	/// A single large constant buffer is split into one region for each frame that can be in flight at once.  Each
+	/// frame, the next region is mapped once, shader constants for all draw calls are suballocated from it at
+	/// CONSTANT_BUFFER_RANGE_ALIGNMENT boundaries, and the resulting ranges are bound by offset.  A fence is placed
+	/// after the commands using each region so that the region is not overwritten until the GPU has finished with it.
+	/// The buffer is grown (after waiting for all outstanding regions) if a frame requires more space than a region
+	/// provides.
+	class HELIUM_GRAPHICS_API ConstantBufferRing : NonCopyable
+	{
+	public:
+		/// Number of frame regions in the ring buffer.
+		static const size_t REGION_COUNT = 2;
+		/// Minimum size of each frame region, in bytes.
+		static const size_t REGION_SIZE_MIN = 64 * 1024;
+
+		/// @name Construction/Destruction
+		//@{
+		ConstantBufferRing();
+		~ConstantBufferRing();
+		//@}
+
+		/// @name Frame Updating
+		//@{
+		bool BeginFrame( size_t requiredSize );
+		void* Allocate( size_t size, uint32_t& rOffset );
+		void EndFrame();
+
+		void FenceFrame( RRenderCommandProxy* pCommandProxy );
+
+		void Shutdown();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline RConstantBuffer* GetBuffer() const;
+		inline size_t GetRegionSize() const;
+		//@}
+
+		/// @name Static Utility Functions
+		//@{
+		inline static size_t GetAllocationSize( size_t size );
+		//@}
+
+	private:
+		/// Ring buffer covering all frame regions.
+		RConstantBufferPtr m_spBuffer;
+		/// Fences placed after the commands using each frame region.
+		RFencePtr m_regionFences[REGION_COUNT];
+
+		/// Size of each frame region, in bytes.
+		size_t m_regionSize;
+		/// Index of the current frame region.
+		size_t m_regionIndex;
+		/// Offset of the next free byte within the current frame region.
+		size_t m_regionOffset;
+		/// Mapped address of the current frame region (null if not mapped).
+		uint8_t* m_pMappedRegion;
+
+		/// @name Private Utility Functions
+		//@{
+		void SyncAllFences();
+		//@}
+	};
+}
+
+#include "Graphics/ConstantBufferRing.inl"
@@ -0,0 +1,32 @@
+namespace Helium
+{
+	/// Get the ring buffer resource from which all frame allocations are made.
+	///
+	/// @return  Ring constant buffer, or null if the buffer has not been created.
+	///
+	/// @see GetRegionSize()
+	RConstantBuffer* ConstantBufferRing::GetBuffer() const
+	{
+		return m_spBuffer;
+	}
+
+	/// Get the size of each frame region in the ring buffer.
+	///
+	/// @return  Frame region size, in bytes.
+	///
+	/// @see GetBuffer()
+	size_t ConstantBufferRing::GetRegionSize() const
+	{
+		return m_regionSize;
+	}
+
+	/// Get the amount of ring buffer space used by an allocation of the given size.
+	///
+	/// @param[in] size  Allocation size, in bytes.
+	///
+	/// @return  Allocation size rounded up to the constant buffer range alignment.
+	size_t ConstantBufferRing::GetAllocationSize( size_t size )
+	{
+		return Align( size, CONSTANT_BUFFER_RANGE_ALIGNMENT );
+	}
+}
@@ -1,6 +1,9 @@
 #include "Precompile.h"
 #include "Graphics/Font.h"
 
+#include "Graphics/GlyphCache.h"
+#include "Engine/MemoryTracker.h"
+
 #include "Rendering/RendererUtil.h"
 #include "Rendering/Renderer.h"
 
@@ -27,6 +30,7 @@ void Font::Character::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &Character::bearingX,        "bearingX" );
     comp.AddField( &Character::bearingY,        "bearingY" );
     comp.AddField( &Character::advance,         "advance" );
+    comp.AddField( &Character::imageOffset,     "imageOffset" );
     comp.AddField( &Character::texture,         "texture" );
 }
 
@@ -38,6 +42,9 @@ Font::PersistentResourceData::PersistentResourceData()
 , m_pspTextures( NULL )
 , m_pTextureLoadIds( NULL )
 , m_textureCount( 0 )
+, m_textureWidth( 0 )
+, m_textureHeight( 0 )
+, m_bDynamicGlyphs( false )
 {
 
 }
@@ -50,6 +57,9 @@ void Font::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &PersistentResourceData::m_maxAdvance,       "m_maxAdvance" );
     comp.AddField( &PersistentResourceData::m_characters,       "m_characters" );
     comp.AddField( &PersistentResourceData::m_textureCount,     "m_textureCount" );
+    comp.AddField( &PersistentResourceData::m_textureWidth,     "m_textureWidth" );
+    comp.AddField( &PersistentResourceData::m_textureHeight,    "m_textureHeight" );
+    comp.AddField( &PersistentResourceData::m_bDynamicGlyphs,   "m_bDynamicGlyphs" );
 }
 
 /// Constructor.
@@ -60,15 +70,28 @@ Font::Font()
     , m_textureSheetHeight( DEFAULT_TEXTURE_SHEET_HEIGHT )
     , m_textureCompression( DEFAULT_TEXTURE_COMPRESSION )
     , m_bAntialiased( true )
+    , m_bDynamicGlyphs( false )
+    , m_pGlyphImageData( NULL )
 {
+    MemorySet( m_bmpPageIndices, 0xff, sizeof( m_bmpPageIndices ) );
+    SetInvalid( m_glyphImageLoadId );
 }
 
 /// Destructor.
 Font::~Font()
 {
+    HELIUM_ASSERT( IsInvalid( m_glyphImageLoadId ) );
+
+    GlyphCache* pGlyphCache = GlyphCache::GetInstance();
+    if( pGlyphCache )
+    {
+        pGlyphCache->ReleaseFont( this );
+    }
+
     //delete [] m_pCharacters;
     delete [] m_persistentResourceData.m_pspTextures;
     delete [] m_persistentResourceData.m_pTextureLoadIds;
+    delete [] m_pGlyphImageData;
 }
 
 void Font::PopulateMetaType( Reflect::MetaStruct& comp )
@@ -79,6 +102,7 @@ void Font::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &Font::m_textureSheetHeight,   "m_textureSheetHeight" );
     comp.AddField( &Font::m_textureCompression,   "m_textureCompression" );
     comp.AddField( &Font::m_bAntialiased,         "m_bAntialiased" );
+    comp.AddField( &Font::m_bDynamicGlyphs,       "m_bDynamicGlyphs" );
 }
 
 /// @copydoc Asset::NeedsPrecacheResourceData()
@@ -106,13 +130,60 @@ bool Font::BeginPrecacheResourceData()
         return true;
     }
 
-    // Allocate and begin loading texture resources.
+    // Fonts using the glyph cache only need the individual character images loaded into memory.  These are uploaded
+    // to the glyph cache textures on demand as characters are drawn.
+    if( m_persistentResourceData.m_bDynamicGlyphs )
+    {
+        delete [] m_pGlyphImageData;
+        m_pGlyphImageData = NULL;
+
+        size_t glyphImageSize = GetSubDataSize( 0 );
+        if( IsInvalid( glyphImageSize ) )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                "Font::BeginPrecacheResourceData(): Unable to locate cached character image data for font \"%s\".\n",
+                *GetPath().ToString() );
+
+            return true;
+        }
+
+        m_pGlyphImageData = new uint8_t [ Max< size_t >( glyphImageSize, 1 ) ];
+        HELIUM_ASSERT( m_pGlyphImageData );
+
+        m_glyphImageLoadId = BeginLoadSubData( m_pGlyphImageData, 0, glyphImageSize );
+        if( IsInvalid( m_glyphImageLoadId ) )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                "Font::BeginPrecacheResourceData(): Failed to begin loading character image data for font \"%s\".\n",
+                *GetPath().ToString() );
+
+            delete [] m_pGlyphImageData;
+            m_pGlyphImageData = NULL;
+        }
+
+        return true;
+    }
+
+    // Allocate and begin loading texture resources.  Fonts cached before sheet sizes were stored with the font data
+    // always use the requested sheet size.
+    uint16_t textureSheetWidth = m_persistentResourceData.m_textureWidth;
+    uint16_t textureSheetHeight = m_persistentResourceData.m_textureHeight;
+    if( textureSheetWidth == 0 || textureSheetHeight == 0 )
+    {
+        textureSheetWidth = m_textureSheetWidth;
+        textureSheetHeight = m_textureSheetHeight;
+    }
+
+    textureSheetWidth = Max< uint16_t >( textureSheetWidth, 1 );
+    textureSheetHeight = Max< uint16_t >( textureSheetHeight, 1 );
+
     ERendererPixelFormat format =
         ( m_textureCompression == ECompression::COLOR_COMPRESSED ? RENDERER_PIXEL_FORMAT_BC1 : RENDERER_PIXEL_FORMAT_R8 );
-    size_t blockRowCount = RendererUtil::PixelToBlockRowCount( m_textureSheetHeight, format );
+    size_t blockRowCount = RendererUtil::PixelToBlockRowCount( textureSheetHeight, format );
 
-    uint16_t textureSheetWidth = Max< uint16_t >( m_textureSheetWidth, 1 );
-    uint16_t textureSheetHeight = Max< uint16_t >( m_textureSheetHeight, 1 );
+    HELIUM_MEMORY_SCOPE( MEMORY_TAG_FONT );
 
     for( uint_fast8_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
     {
@@ -184,6 +255,18 @@ bool Font::TryFinishPrecacheResourceData()
     HELIUM_ASSERT( m_persistentResourceData.m_pspTextures || textureCount == 0 );
 
     bool bLoadComplete = true;
+    if( IsValid( m_glyphImageLoadId ) )
+    {
+        if( TryFinishLoadSubData( m_glyphImageLoadId ) )
+        {
+            SetInvalid( m_glyphImageLoadId );
+        }
+        else
+        {
+            bLoadComplete = false;
+        }
+    }
+
     for( uint_fast8_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
     {
         size_t& rLoadId = m_persistentResourceData.m_pTextureLoadIds[ textureIndex ];
@@ -256,9 +339,81 @@ bool Helium::Font::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
         }
     }
 
+    BuildCharacterLookupTable();
+
+    return true;
+}
+
+/// Get the texture and texture coordinates to use for rendering the specified character.
+///
+/// For fonts using the GlyphCache, this will add the character image to the cache if it is not already resident, so
+/// it should be called for each character when building text geometry, before GlyphCache::Flush() is called for the
+/// current frame.
+///
+/// @param[in]  rCharacter  Character data (must be stored in this font).
+/// @param[out] rImage      Character image location.
+///
+/// @return  True if the character image is available for rendering, false if not (i.e. the character has no image,
+///          its texture failed to load, or the glyph cache is full).
+///
+/// @see GetGlyphTexture()
+bool Font::GetGlyphImage( const Character& rCharacter, GlyphImage& rImage ) const
+{
+    if( m_persistentResourceData.m_bDynamicGlyphs )
+    {
+        GlyphCache* pGlyphCache = GlyphCache::GetInstance();
+
+        return ( pGlyphCache && pGlyphCache->GetGlyphImage( this, rCharacter, rImage ) );
+    }
+
+    RTexture2d* pTexture = GetGlyphTexture( rCharacter );
+    if( !pTexture )
+    {
+        return false;
+    }
+
+    float32_t inverseTextureWidth = 1.0f / static_cast< float32_t >( pTexture->GetWidth() );
+    float32_t inverseTextureHeight = 1.0f / static_cast< float32_t >( pTexture->GetHeight() );
+
+    float32_t imageMinX = static_cast< float32_t >( rCharacter.imageX );
+    float32_t imageMinY = static_cast< float32_t >( rCharacter.imageY );
+
+    rImage.pTexture = pTexture;
+    rImage.texCoordMinX = imageMinX * inverseTextureWidth;
+    rImage.texCoordMinY = imageMinY * inverseTextureHeight;
+    rImage.texCoordMaxX = ( imageMinX + static_cast< float32_t >( rCharacter.imageWidth ) ) * inverseTextureWidth;
+    rImage.texCoordMaxY = ( imageMinY + static_cast< float32_t >( rCharacter.imageHeight ) ) * inverseTextureHeight;
+
     return true;
 }
 
+/// Get the texture containing the image for the specified character.
+///
+/// Unlike GetGlyphImage(), this will not add characters to the GlyphCache, so it can be safely used when issuing draw
+/// calls for text geometry that has already been built.
+///
+/// @param[in] rCharacter  Character data (must be stored in this font).
+///
+/// @return  Texture containing the character image, or null if the image is not available.
+///
+/// @see GetGlyphImage()
+RTexture2d* Font::GetGlyphTexture( const Character& rCharacter ) const
+{
+    if( m_persistentResourceData.m_bDynamicGlyphs )
+    {
+        GlyphCache* pGlyphCache = GlyphCache::GetInstance();
+
+        return ( pGlyphCache ? pGlyphCache->FindGlyphTexture( this, rCharacter ) : NULL );
+    }
+
+    if( rCharacter.texture >= m_persistentResourceData.m_textureCount )
+    {
+        return NULL;
+    }
+
+    return m_persistentResourceData.m_pspTextures[ rCharacter.texture ];
+}
+
 /// @copydoc Resource::GetCacheName()
 Name Font::GetCacheName() const
 {
@@ -266,3 +421,42 @@ Name Font::GetCacheName() const
 
     return cacheName;
 }
+
+/// Build the direct lookup table for characters in the Basic Multilingual Plane.
+///
+/// The table is split into pages of BMP_PAGE_SIZE code points, with only pages containing at least one character
+/// allocated, so fonts covering only a few scripts don't pay for the entire plane.
+void Font::BuildCharacterLookupTable()
+{
+    MemorySet( m_bmpPageIndices, 0xff, sizeof( m_bmpPageIndices ) );
+    m_bmpCharacterIndices.Resize( 0 );
+
+    const DynamicArray< Character >& rCharacters = m_persistentResourceData.m_characters;
+    size_t characterCount = rCharacters.GetSize();
+    HELIUM_ASSERT( characterCount <= UINT32_MAX );
+
+    for( size_t characterIndex = 0; characterIndex < characterCount; ++characterIndex )
+    {
+        uint32_t codePoint = rCharacters[ characterIndex ].codePoint;
+        if( codePoint >= BMP_PAGE_SIZE * BMP_PAGE_COUNT )
+        {
+            // Characters are sorted by code point, so all remaining characters are outside the BMP.
+            break;
+        }
+
+        uint16_t& rPageIndex = m_bmpPageIndices[ codePoint / BMP_PAGE_SIZE ];
+        if( IsInvalid( rPageIndex ) )
+        {
+            size_t pageOffset = m_bmpCharacterIndices.GetSize();
+            rPageIndex = static_cast< uint16_t >( pageOffset / BMP_PAGE_SIZE );
+
+            m_bmpCharacterIndices.Resize( pageOffset + BMP_PAGE_SIZE );
+            MemorySet( m_bmpCharacterIndices.GetData() + pageOffset, 0xff, BMP_PAGE_SIZE * sizeof( uint32_t ) );
+        }
+
+        m_bmpCharacterIndices[ static_cast< size_t >( rPageIndex ) * BMP_PAGE_SIZE + codePoint % BMP_PAGE_SIZE ] =
+            static_cast< uint32_t >( characterIndex );
+    }
+
+    m_bmpCharacterIndices.Trim();
+}
@@ -50,6 +50,11 @@ namespace Helium
         /// Default texture compression scheme.
         static const ECompression::Enum DEFAULT_TEXTURE_COMPRESSION;
 
+        /// Number of code points in each page of the Basic Multilingual Plane character lookup table.
+        static const uint32_t BMP_PAGE_SIZE = 256;
+        /// Number of pages in the Basic Multilingual Plane character lookup table.
+        static const uint32_t BMP_PAGE_COUNT = 256;
+
         /// Character information.
         struct HELIUM_GRAPHICS_API Character : Reflect::Struct
         {
@@ -68,6 +73,7 @@ namespace Helium
                     bearingX == rhs.bearingX &&
                     bearingY == rhs.bearingY &&
                     advance == rhs.advance &&
+                    imageOffset == rhs.imageOffset &&
                     texture == rhs.texture); 
             }
 
@@ -102,9 +108,29 @@ namespace Helium
             /// value, in pixels).
             int32_t advance;
 
+            /// Byte offset of the 8-bit grayscale character image within the glyph image data (only used by fonts
+            /// whose glyphs are rendered through the GlyphCache).
+            uint32_t imageOffset;
+
             /// Texture sheet index.
             uint8_t texture;
         };
+
+        /// Location of a character image within a texture.
+        struct GlyphImage
+        {
+            /// Texture containing the character image.
+            RTexture2d* pTexture;
+
+            /// Horizontal texture coordinate of the left edge of the character image.
+            float32_t texCoordMinX;
+            /// Vertical texture coordinate of the top edge of the character image.
+            float32_t texCoordMinY;
+            /// Horizontal texture coordinate of the right edge of the character image.
+            float32_t texCoordMaxX;
+            /// Vertical texture coordinate of the bottom edge of the character image.
+            float32_t texCoordMaxY;
+        };
         
         struct HELIUM_GRAPHICS_API PersistentResourceData : public Object
         {
@@ -132,6 +158,16 @@ namespace Helium
             size_t* m_pTextureLoadIds;
             /// Number of texture sheets.
             uint8_t m_textureCount;
+            /// Width of each texture sheet, in texels (may be larger than the requested sheet width if needed to fit
+            /// the largest character).
+            uint16_t m_textureWidth;
+            /// Height of each texture sheet, in texels (may be larger than the requested sheet height if needed to
+            /// fit the largest character).
+            uint16_t m_textureHeight;
+
+            /// True if character images are stored individually and rendered through the GlyphCache instead of
+            /// being prebuilt into texture sheets.
+            bool m_bDynamicGlyphs;
         };
         
         /// Persistent font resource data.
@@ -171,6 +207,7 @@ namespace Helium
         inline ECompression GetTextureCompression() const;
 
         inline bool GetAntialiased() const;
+        inline bool GetDynamicGlyphs() const;
 
         inline int32_t GetAscenderFixed() const;
         inline int32_t GetDescenderFixed() const;
@@ -201,6 +238,15 @@ namespace Helium
         inline RTexture2d* GetTextureSheet( uint8_t index ) const;
         //@}
 
+        /// @name Character Image Access
+        //@{
+        bool GetGlyphImage( const Character& rCharacter, GlyphImage& rImage ) const;
+        RTexture2d* GetGlyphTexture( const Character& rCharacter ) const;
+
+        inline bool UsesGlyphCache() const;
+        inline const uint8_t* GetGlyphImageData() const;
+        //@}
+
         /// @name Text Processing Support
         //@{
         template< typename GlyphHandler, typename CharType > 
@@ -232,6 +278,25 @@ namespace Helium
         
         /// True if this font should use anti-aliasing to smooth edges, false if not.
         bool m_bAntialiased;
+        /// True if character images should be rendered on demand through the GlyphCache instead of being prebuilt
+        /// into texture sheets (recommended for fonts with large character sets).
+        bool m_bDynamicGlyphs;
+
+        /// Character indices for each populated page of the Basic Multilingual Plane lookup table.
+        DynamicArray< uint32_t > m_bmpCharacterIndices;
+        /// Index of the lookup table page for each range of Basic Multilingual Plane code points (invalid if no
+        /// characters in the range exist in this font).
+        uint16_t m_bmpPageIndices[ BMP_PAGE_COUNT ];
+
+        /// Character image data for fonts using the GlyphCache.
+        uint8_t* m_pGlyphImageData;
+        /// Character image data load ID.
+        size_t m_glyphImageLoadId;
+
+        /// @name Private Utility Functions
+        //@{
+        void BuildCharacterLookupTable();
+        //@}
 
         /// @name Text Processing Support, Private
         //@{
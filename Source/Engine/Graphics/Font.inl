@@ -60,6 +60,20 @@ bool Helium::Font::GetAntialiased() const
     return m_bAntialiased;
 }
 
+/// Get whether this font requests character images to be rendered on demand through the GlyphCache.
+///
+/// Note that fonts with too many characters to fit in the maximum number of texture sheets will use the GlyphCache
+/// regardless of this setting (see UsesGlyphCache()).
+///
+/// @return  True if character images should be rendered through the GlyphCache, false if texture sheets should be
+///          used when possible.
+///
+/// @see UsesGlyphCache()
+bool Helium::Font::GetDynamicGlyphs() const
+{
+    return m_bDynamicGlyphs;
+}
+
 /// Get the maximum ascender height of this font in pixels, as a 26.6 fixed-point value.
 ///
 /// @return  Maximum ascender height from the baseline, in pixels.
@@ -178,7 +192,8 @@ uint32_t Helium::Font::GetCharacterIndex( const Character* pCharacter ) const
 
 /// Find the character data for the given Unicode character code point.
 ///
-/// This will perform a binary search for the character with the given code point.
+/// Characters in the Basic Multilingual Plane are located through a direct lookup table, while characters in the
+/// supplementary planes fall back to a binary search.
 ///
 /// @param[in] codePoint  Unicode code point value.
 ///
@@ -188,6 +203,20 @@ uint32_t Helium::Font::GetCharacterIndex( const Character* pCharacter ) const
 /// @see GetCharacterCount(), GetCharacter(), GetCharacterIndex()
 const Helium::Font::Character* Helium::Font::FindCharacter( uint32_t codePoint ) const
 {
+    if( codePoint < BMP_PAGE_SIZE * BMP_PAGE_COUNT )
+    {
+        uint16_t pageIndex = m_bmpPageIndices[ codePoint / BMP_PAGE_SIZE ];
+        if( IsInvalid( pageIndex ) )
+        {
+            return NULL;
+        }
+
+        uint32_t characterIndex = m_bmpCharacterIndices[
+            static_cast< size_t >( pageIndex ) * BMP_PAGE_SIZE + codePoint % BMP_PAGE_SIZE ];
+
+        return ( IsValid( characterIndex ) ? &m_persistentResourceData.m_characters[ characterIndex ] : NULL );
+    }
+
     uint32_t baseIndex = 0;
     uint32_t searchCount = static_cast<uint32_t>(m_persistentResourceData.m_characters.GetSize());
     while( searchCount != 0 )
@@ -240,6 +269,29 @@ Helium::RTexture2d* Helium::Font::GetTextureSheet( uint8_t index ) const
     return m_persistentResourceData.m_pspTextures[ index ];
 }
 
+/// Get whether the character images for this font are rendered on demand through the GlyphCache.
+///
+/// @return  True if the GlyphCache is used for this font, false if prebuilt texture sheets are used.
+///
+/// @see GetDynamicGlyphs(), GetGlyphImageData()
+bool Helium::Font::UsesGlyphCache() const
+{
+    return m_persistentResourceData.m_bDynamicGlyphs;
+}
+
+/// Get the character image data for a font using the GlyphCache.
+///
+/// Each character image is stored as a tightly packed 8-bit grayscale image of Character::imageWidth by
+/// Character::imageHeight pixels, starting at Character::imageOffset bytes into this buffer.
+///
+/// @return  Character image data, or null if the font does not use the GlyphCache or its data is not loaded.
+///
+/// @see UsesGlyphCache()
+const uint8_t* Helium::Font::GetGlyphImageData() const
+{
+    return ( IsValid( m_glyphImageLoadId ) ? NULL : m_pGlyphImageData );
+}
+
 /// Parse a string and pass valid character information to a custom handler.
 ///
 /// @param[in] pString         String to process.
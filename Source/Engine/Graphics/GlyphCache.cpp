@@ -0,0 +1,532 @@
+#include "Precompile.h"
+#include "Graphics/GlyphCache.h"
+
+#include "Engine/MemoryTracker.h"
+#include "Rendering/Renderer.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+GlyphCache* GlyphCache::sm_pInstance = NULL;
+
+/// Constructor.
+GlyphCache::GlyphCache()
+	: m_frameIndex( 0 )
+{
+}
+
+/// Destructor.
+GlyphCache::~GlyphCache()
+{
+	Cleanup();
+}
+
+/// Initialize the glyph cache.
+///
+/// @return  True if initialization was successful, false if not (including if no renderer is active).
+///
+/// @see Cleanup()
+bool GlyphCache::Initialize()
+{
+	Cleanup();
+
+	if ( !Renderer::GetInstance() )
+	{
+		return false;
+	}
+
+	m_pages.Reserve( PAGE_COUNT_MAX );
+
+	return true;
+}
+
+/// Release all cache pages and cached characters.
+///
+/// @see Initialize()
+void GlyphCache::Cleanup()
+{
+	size_t pageCount = m_pages.GetSize();
+	for ( size_t pageIndex = 0; pageIndex < pageCount; ++pageIndex )
+	{
+		delete [] m_pages[pageIndex].pImage;
+	}
+
+	m_pages.Clear();
+	m_entryMap.Clear();
+	m_fonts.Clear();
+}
+
+/// Get the texture and texture coordinates to use for rendering the specified character, adding the character image
+/// to the cache if it is not already resident.
+///
+/// @param[in]  pFont       Font owning the character.
+/// @param[in]  rCharacter  Character data (must be stored in the given font).
+/// @param[out] rImage      Character image location.
+///
+/// @return  True if the character image is available for rendering, false if not (i.e. the character has no image,
+///          the font data is not loaded, or all cache space is in use by characters drawn during the current or
+///          previous frame).
+///
+/// @see FindGlyphTexture()
+bool GlyphCache::GetGlyphImage( const Font* pFont, const Font::Character& rCharacter, Font::GlyphImage& rImage )
+{
+	HELIUM_ASSERT( pFont );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	uint16_t imageWidth = rCharacter.imageWidth;
+	uint16_t imageHeight = rCharacter.imageHeight;
+	if ( imageWidth == 0 || imageHeight == 0 )
+	{
+		return false;
+	}
+
+	size_t fontIndex = FindFontIndex( pFont );
+	if ( IsInvalid( fontIndex ) )
+	{
+		fontIndex = FindFontIndex( NULL );
+		if ( IsInvalid( fontIndex ) )
+		{
+			fontIndex = m_fonts.GetSize();
+			m_fonts.Push( pFont );
+		}
+		else
+		{
+			m_fonts[fontIndex] = pFont;
+		}
+	}
+
+	uint64_t key = ( static_cast< uint64_t >( fontIndex ) << 32 ) | pFont->GetCharacterIndex( &rCharacter );
+
+	HashMap< uint64_t, Entry >::Iterator entryIterator = m_entryMap.Find( key );
+	if ( entryIterator == m_entryMap.End() )
+	{
+		const uint8_t* pGlyphImageData = pFont->GetGlyphImageData();
+		if ( !pGlyphImageData )
+		{
+			return false;
+		}
+
+		size_t pageIndex, shelfIndex;
+		if ( !Allocate( imageWidth, imageHeight, pageIndex, shelfIndex ) )
+		{
+			return false;
+		}
+
+		Page& rPage = m_pages[pageIndex];
+		Shelf& rShelf = rPage.shelves[shelfIndex];
+
+		Entry entry;
+		entry.x = rShelf.penX;
+		entry.y = rShelf.y;
+		entry.width = imageWidth;
+		entry.height = imageHeight;
+		entry.pageIndex = static_cast< uint16_t >( pageIndex );
+		entry.shelfIndex = static_cast< uint16_t >( shelfIndex );
+
+		rShelf.penX += imageWidth + GLYPH_PADDING;
+		rShelf.glyphKeys.Push( key );
+
+		// Copy the character image into the page.
+		const uint8_t* pSourceRow = pGlyphImageData + rCharacter.imageOffset;
+		uint8_t* pDestRow = rPage.pImage + static_cast< size_t >( entry.y ) * PAGE_SIZE + entry.x;
+		for ( uint_fast16_t rowIndex = 0; rowIndex < imageHeight; ++rowIndex )
+		{
+			MemoryCopy( pDestRow, pSourceRow, imageWidth );
+			pSourceRow += imageWidth;
+			pDestRow += PAGE_SIZE;
+		}
+
+		rPage.bDirty = true;
+
+		HELIUM_VERIFY( m_entryMap.Insert( entryIterator, HashMap< uint64_t, Entry >::ValueType( key, entry ) ) );
+	}
+
+	const Entry& rEntry = entryIterator->Second();
+
+	Page& rPage = m_pages[rEntry.pageIndex];
+	rPage.shelves[rEntry.shelfIndex].lastUseFrame = m_frameIndex;
+
+	const float32_t inversePageSize = 1.0f / static_cast< float32_t >( PAGE_SIZE );
+
+	rImage.pTexture = rPage.spTexture;
+	rImage.texCoordMinX = static_cast< float32_t >( rEntry.x ) * inversePageSize;
+	rImage.texCoordMinY = static_cast< float32_t >( rEntry.y ) * inversePageSize;
+	rImage.texCoordMaxX = static_cast< float32_t >( rEntry.x + rEntry.width ) * inversePageSize;
+	rImage.texCoordMaxY = static_cast< float32_t >( rEntry.y + rEntry.height ) * inversePageSize;
+
+	return true;
+}
+
+/// Get the texture containing the image for the specified character if it is resident in the cache.
+///
+/// @param[in] pFont       Font owning the character.
+/// @param[in] rCharacter  Character data (must be stored in the given font).
+///
+/// @return  Texture containing the character image, or null if the character is not in the cache.
+///
+/// @see GetGlyphImage()
+RTexture2d* GlyphCache::FindGlyphTexture( const Font* pFont, const Font::Character& rCharacter ) const
+{
+	HELIUM_ASSERT( pFont );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	size_t fontIndex = FindFontIndex( pFont );
+	if ( IsInvalid( fontIndex ) )
+	{
+		return NULL;
+	}
+
+	uint64_t key = ( static_cast< uint64_t >( fontIndex ) << 32 ) | pFont->GetCharacterIndex( &rCharacter );
+
+	HashMap< uint64_t, Entry >::ConstIterator entryIterator = m_entryMap.Find( key );
+	if ( entryIterator == m_entryMap.End() )
+	{
+		return NULL;
+	}
+
+	return m_pages[entryIterator->Second().pageIndex].spTexture;
+}
+
+/// Remove all characters belonging to the specified font from the cache.
+///
+/// This must be called before a font using the cache is destroyed.
+///
+/// @param[in] pFont  Font to release.
+void GlyphCache::ReleaseFont( const Font* pFont )
+{
+	HELIUM_ASSERT( pFont );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	size_t fontIndex = FindFontIndex( pFont );
+	if ( IsInvalid( fontIndex ) )
+	{
+		return;
+	}
+
+	m_fonts[fontIndex] = NULL;
+
+	size_t pageCount = m_pages.GetSize();
+	for ( size_t pageIndex = 0; pageIndex < pageCount; ++pageIndex )
+	{
+		Page& rPage = m_pages[pageIndex];
+
+		size_t shelfCount = rPage.shelves.GetSize();
+		for ( size_t shelfIndex = 0; shelfIndex < shelfCount; ++shelfIndex )
+		{
+			Shelf& rShelf = rPage.shelves[shelfIndex];
+			if ( rShelf.glyphKeys.IsEmpty() )
+			{
+				continue;
+			}
+
+			size_t keyIndex = rShelf.glyphKeys.GetSize();
+			while ( keyIndex != 0 )
+			{
+				--keyIndex;
+
+				uint64_t key = rShelf.glyphKeys[keyIndex];
+				if ( static_cast< size_t >( key >> 32 ) == fontIndex )
+				{
+					m_entryMap.Remove( key );
+					rShelf.glyphKeys.RemoveSwap( keyIndex );
+				}
+			}
+
+			// Space within a shelf is only reclaimed once the entire shelf is empty.
+			if ( rShelf.glyphKeys.IsEmpty() )
+			{
+				EvictShelf( rPage, rShelf );
+			}
+		}
+	}
+}
+
+/// Upload all modified cache pages to their textures.
+///
+/// This should be called once text geometry for the current frame has been built and before any of it is drawn.
+void GlyphCache::Flush()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	size_t pageCount = m_pages.GetSize();
+	for ( size_t pageIndex = 0; pageIndex < pageCount; ++pageIndex )
+	{
+		Page& rPage = m_pages[pageIndex];
+		if ( !rPage.bDirty )
+		{
+			continue;
+		}
+
+		RTexture2d* pTexture = rPage.spTexture;
+		HELIUM_ASSERT( pTexture );
+
+		size_t pitch = 0;
+		uint8_t* pMappedData = static_cast< uint8_t* >( pTexture->Map( 0, pitch, RENDERER_BUFFER_MAP_HINT_DISCARD ) );
+		HELIUM_ASSERT( pMappedData );
+		if ( !pMappedData )
+		{
+			continue;
+		}
+
+		const uint8_t* pSourceRow = rPage.pImage;
+		for ( uint_fast16_t rowIndex = 0; rowIndex < PAGE_SIZE; ++rowIndex )
+		{
+			MemoryCopy( pMappedData, pSourceRow, PAGE_SIZE );
+			pSourceRow += PAGE_SIZE;
+			pMappedData += pitch;
+		}
+
+		pTexture->Unmap( 0 );
+
+		rPage.bDirty = false;
+	}
+}
+
+/// Advance to the next frame.  Characters drawn during the current or previous frame are never evicted.
+void GlyphCache::Update()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	++m_frameIndex;
+}
+
+/// Get the singleton GlyphCache instance.
+///
+/// @return  Pointer to the GlyphCache instance, or null if the cache is not active.
+///
+/// @see Startup(), Shutdown()
+GlyphCache* GlyphCache::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton GlyphCache instance.
+///
+/// @see Shutdown(), GetInstance()
+void GlyphCache::Startup()
+{
+	if ( ++g_InitCount == 1 )
+	{
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new GlyphCache;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !sm_pInstance->Initialize() )
+		{
+			delete sm_pInstance;
+			sm_pInstance = NULL;
+		}
+	}
+}
+
+/// Destroy the singleton GlyphCache instance.
+///
+/// @see Startup(), GetInstance()
+void GlyphCache::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Find the index associated with the specified font in the font table.
+///
+/// @param[in] pFont  Font to locate (null to locate an unused slot).
+///
+/// @return  Font index, or an invalid index if the font is not in the table.
+size_t GlyphCache::FindFontIndex( const Font* pFont ) const
+{
+	size_t fontCount = m_fonts.GetSize();
+	for ( size_t fontIndex = 0; fontIndex < fontCount; ++fontIndex )
+	{
+		if ( m_fonts[fontIndex] == pFont )
+		{
+			return fontIndex;
+		}
+	}
+
+	return Invalid< size_t >();
+}
+
+/// Allocate space in the cache for a character image.
+///
+/// The shelf with the closest height that has enough space is used if possible.  Otherwise, a new shelf is opened,
+/// allocating a new page if necessary.  If all pages are full, the least recently used shelf tall enough for the image
+/// is cleared and reused (shelves used during the current or previous frame are never cleared, as the render thread
+/// may still be drawing the previous frame).
+///
+/// @param[in]  width        Character image width, in texels.
+/// @param[in]  height       Character image height, in texels.
+/// @param[out] rPageIndex   Index of the page in which to store the image.
+/// @param[out] rShelfIndex  Index of the shelf in which to store the image (the image should be stored at the current
+///                          shelf pen location).
+///
+/// @return  True if space was allocated, false if not.
+bool GlyphCache::Allocate( uint16_t width, uint16_t height, size_t& rPageIndex, size_t& rShelfIndex )
+{
+	uint_fast32_t paddedWidth = static_cast< uint_fast32_t >( width ) + GLYPH_PADDING;
+	uint_fast32_t shelfHeight = static_cast< uint_fast32_t >( height ) + GLYPH_PADDING;
+	shelfHeight = ( shelfHeight + SHELF_HEIGHT_GRANULARITY - 1 ) & ~static_cast< uint_fast32_t >( SHELF_HEIGHT_GRANULARITY - 1 );
+
+	if ( paddedWidth + GLYPH_PADDING > PAGE_SIZE || shelfHeight + GLYPH_PADDING > PAGE_SIZE )
+	{
+		return false;
+	}
+
+	// Look for the existing shelf with the least wasted space (ignoring shelves more than twice as tall as needed).
+	size_t pageCount = m_pages.GetSize();
+
+	SetInvalid( rPageIndex );
+	uint_fast32_t bestShelfHeight = shelfHeight * 2 + 1;
+
+	for ( size_t pageIndex = 0; pageIndex < pageCount; ++pageIndex )
+	{
+		const Page& rPage = m_pages[pageIndex];
+
+		size_t shelfCount = rPage.shelves.GetSize();
+		for ( size_t shelfIndex = 0; shelfIndex < shelfCount; ++shelfIndex )
+		{
+			const Shelf& rShelf = rPage.shelves[shelfIndex];
+			if ( rShelf.height >= shelfHeight &&
+				rShelf.height < bestShelfHeight &&
+				rShelf.penX + paddedWidth <= PAGE_SIZE )
+			{
+				rPageIndex = pageIndex;
+				rShelfIndex = shelfIndex;
+				bestShelfHeight = rShelf.height;
+			}
+		}
+	}
+
+	if ( IsValid( rPageIndex ) )
+	{
+		return true;
+	}
+
+	// Open a new shelf, allocating a new page if the existing pages are full.
+	for ( size_t pageIndex = 0; pageIndex <= pageCount; ++pageIndex )
+	{
+		if ( pageIndex == pageCount && ( pageCount >= PAGE_COUNT_MAX || !AddPage() ) )
+		{
+			break;
+		}
+
+		Page& rPage = m_pages[pageIndex];
+		if ( rPage.shelfEndY + shelfHeight > PAGE_SIZE )
+		{
+			continue;
+		}
+
+		Shelf* pShelf = rPage.shelves.New();
+		HELIUM_ASSERT( pShelf );
+		pShelf->lastUseFrame = m_frameIndex;
+		pShelf->y = rPage.shelfEndY;
+		pShelf->height = static_cast< uint16_t >( shelfHeight );
+		pShelf->penX = GLYPH_PADDING;
+
+		rPage.shelfEndY = static_cast< uint16_t >( rPage.shelfEndY + shelfHeight );
+
+		rPageIndex = pageIndex;
+		rShelfIndex = rPage.shelves.GetSize() - 1;
+
+		return true;
+	}
+
+	// Evict the least recently used shelf that is tall enough, skipping shelves used during the current or previous
+	// frame.
+	pageCount = m_pages.GetSize();
+	uint32_t oldestFrameAge = 1;
+
+	for ( size_t pageIndex = 0; pageIndex < pageCount; ++pageIndex )
+	{
+		const Page& rPage = m_pages[pageIndex];
+
+		size_t shelfCount = rPage.shelves.GetSize();
+		for ( size_t shelfIndex = 0; shelfIndex < shelfCount; ++shelfIndex )
+		{
+			const Shelf& rShelf = rPage.shelves[shelfIndex];
+			uint32_t frameAge = m_frameIndex - rShelf.lastUseFrame;
+			if ( rShelf.height >= shelfHeight && frameAge > oldestFrameAge )
+			{
+				rPageIndex = pageIndex;
+				rShelfIndex = shelfIndex;
+				oldestFrameAge = frameAge;
+			}
+		}
+	}
+
+	if ( IsInvalid( rPageIndex ) )
+	{
+		return false;
+	}
+
+	Page& rPage = m_pages[rPageIndex];
+	EvictShelf( rPage, rPage.shelves[rShelfIndex] );
+
+	return true;
+}
+
+/// Allocate a new cache page.
+///
+/// @return  True if the page was allocated successfully, false if not.
+bool GlyphCache::AddPage()
+{
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	HELIUM_MEMORY_SCOPE( MEMORY_TAG_FONT );
+	RTexture2dPtr spTexture = pRenderer->CreateTexture2d(
+		PAGE_SIZE,
+		PAGE_SIZE,
+		1,
+		RENDERER_PIXEL_FORMAT_R8,
+		RENDERER_BUFFER_USAGE_DYNAMIC );
+	if ( !spTexture )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"GlyphCache::AddPage(): Failed to allocate %" PRIu16 "x%" PRIu16 " glyph cache texture.\n",
+			PAGE_SIZE,
+			PAGE_SIZE );
+
+		return false;
+	}
+
+	size_t imageSize = static_cast< size_t >( PAGE_SIZE ) * PAGE_SIZE;
+
+	Page* pPage = m_pages.New();
+	HELIUM_ASSERT( pPage );
+	pPage->spTexture = spTexture;
+	pPage->pImage = new uint8_t [ imageSize ];
+	HELIUM_ASSERT( pPage->pImage );
+	MemoryZero( pPage->pImage, imageSize );
+	pPage->shelfEndY = GLYPH_PADDING;
+	pPage->bDirty = true;
+
+	return true;
+}
+
+/// Remove all characters from a shelf and clear its image data so it can be reused.
+///
+/// @param[in] rPage   Page containing the shelf.
+/// @param[in] rShelf  Shelf to clear.
+void GlyphCache::EvictShelf( Page& rPage, Shelf& rShelf )
+{
+	size_t keyCount = rShelf.glyphKeys.GetSize();
+	for ( size_t keyIndex = 0; keyIndex < keyCount; ++keyIndex )
+	{
+		m_entryMap.Remove( rShelf.glyphKeys[keyIndex] );
+	}
+
+	rShelf.glyphKeys.Resize( 0 );
+	rShelf.penX = GLYPH_PADDING;
+
+	MemoryZero(
+		rPage.pImage + static_cast< size_t >( rShelf.y ) * PAGE_SIZE,
+		static_cast< size_t >( rShelf.height ) * PAGE_SIZE );
+	rPage.bDirty = true;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Platform/Mutex.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Graphics/Font.h"
+#include "Rendering/RTexture2d.h"
+
+namespace Helium
+{
+	/// Shared texture cache for font character images.
+	///
+	/// Fonts with large character sets (i.e. CJK fonts) cannot reasonably keep every character resident in prebuilt
+	/// texture sheets.  Such fonts instead store each character image individually, and characters are packed into the
+	/// glyph cache textures the first time they are drawn.  Each cache page is packed using horizontal shelves of
+	/// similar height.  When the cache is full, the least recently used shelf not drawn during the current or previous
+	/// frame is cleared and reused.
+	///
+	/// Character images are written to a system memory copy of each page, and modified pages are uploaded to their
+	/// textures by Flush(), which must be called after text geometry has been built and before it is drawn.
+	///
+	/// With pipelined rendering, text geometry is built on the game thread while the render thread flushes and draws
+	/// the previous frame, so all cache access is synchronized.
+	class HELIUM_GRAPHICS_API GlyphCache : NonCopyable
+	{
+	public:
+		/// Width and height of each cache page texture, in texels.
+		static const uint16_t PAGE_SIZE = 1024;
+		/// Maximum number of cache pages.
+		static const size_t PAGE_COUNT_MAX = 4;
+		/// Number of texels of padding between characters (used to avoid bleeding when filtering).
+		static const uint16_t GLYPH_PADDING = 1;
+		/// Granularity of shelf heights, in texels (used to allow shelves to be reused by similarly sized characters).
+		static const uint16_t SHELF_HEIGHT_GRANULARITY = 4;
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Character Image Access
+		//@{
+		bool GetGlyphImage( const Font* pFont, const Font::Character& rCharacter, Font::GlyphImage& rImage );
+		RTexture2d* FindGlyphTexture( const Font* pFont, const Font::Character& rCharacter ) const;
+
+		void ReleaseFont( const Font* pFont );
+		//@}
+
+		/// @name Updating
+		//@{
+		void Flush();
+		void Update();
+
+		inline uint32_t GetFrameIndex() const;
+		inline size_t GetGlyphCount() const;
+		inline size_t GetPageCount() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static GlyphCache* GetInstance();
+		static void Startup();
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Row of characters within a cache page.
+		struct Shelf
+		{
+			/// Keys of the characters stored in the shelf.
+			DynamicArray< uint64_t > glyphKeys;
+			/// Index of the frame in which a character in the shelf was last used.
+			uint32_t lastUseFrame;
+			/// Vertical texel coordinate of the top of the shelf.
+			uint16_t y;
+			/// Shelf height, in texels.
+			uint16_t height;
+			/// Horizontal texel coordinate of the next free space in the shelf.
+			uint16_t penX;
+		};
+
+		/// Cache page.
+		struct Page
+		{
+			/// Page texture.
+			RTexture2dPtr spTexture;
+			/// System memory copy of the page texture data.
+			uint8_t* pImage;
+			/// Page shelves.
+			DynamicArray< Shelf > shelves;
+			/// Vertical texel coordinate of the space following the last shelf.
+			uint16_t shelfEndY;
+			/// True if the texture needs to be updated with the page image.
+			bool bDirty;
+		};
+
+		/// Cached character entry.
+		struct Entry
+		{
+			/// Horizontal texel coordinate of the character image.
+			uint16_t x;
+			/// Vertical texel coordinate of the character image.
+			uint16_t y;
+			/// Character image width, in texels.
+			uint16_t width;
+			/// Character image height, in texels.
+			uint16_t height;
+			/// Page index.
+			uint16_t pageIndex;
+			/// Shelf index within the page.
+			uint16_t shelfIndex;
+		};
+
+		/// Cache pages.
+		DynamicArray< Page > m_pages;
+		/// Cached character entries by character key.
+		HashMap< uint64_t, Entry > m_entryMap;
+		/// Fonts with characters in the cache (indexed by the font portion of each character key).
+		DynamicArray< const Font* > m_fonts;
+
+		/// Current frame index.
+		uint32_t m_frameIndex;
+
+		/// Lock for synchronizing access between the game and render threads.
+		mutable Mutex m_lock;
+
+		/// Singleton instance.
+		static GlyphCache* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		GlyphCache();
+		~GlyphCache();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		size_t FindFontIndex( const Font* pFont ) const;
+		bool Allocate( uint16_t width, uint16_t height, size_t& rPageIndex, size_t& rShelfIndex );
+		bool AddPage();
+		void EvictShelf( Page& rPage, Shelf& rShelf );
+		//@}
+	};
+}
+
+#include "Graphics/GlyphCache.inl"
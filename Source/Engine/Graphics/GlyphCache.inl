@@ -0,0 +1,26 @@
+namespace Helium
+{
+	/// Get the index of the current cache frame.  Character use is tracked per frame.
+	///
+	/// @return  Current frame index.
+	uint32_t GlyphCache::GetFrameIndex() const
+	{
+		return m_frameIndex;
+	}
+
+	/// Get the number of characters currently resident in the cache.
+	///
+	/// @return  Cached character count.
+	size_t GlyphCache::GetGlyphCount() const
+	{
+		return m_entryMap.GetSize();
+	}
+
+	/// Get the number of cache pages currently allocated.
+	///
+	/// @return  Cache page count.
+	size_t GlyphCache::GetPageCount() const
+	{
+		return m_pages.GetSize();
+	}
+}
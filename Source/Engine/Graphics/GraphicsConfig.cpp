@@ -17,8 +17,11 @@ GraphicsConfig::GraphicsConfig()
 , m_maxAnisotropy( 0 )
 , m_shadowMode( EShadowMode::PCF_DITHERED )
 , m_shadowBufferSize( DEFAULT_SHADOW_BUFFER_SIZE )
+, m_textureStreamingBudget( DEFAULT_TEXTURE_STREAMING_BUDGET )
+, m_shaderVariantCacheSize( DEFAULT_SHADER_VARIANT_CACHE_SIZE )
 , m_bFullscreen( false )
 , m_bVsync( true )
+, m_bPipelinedRendering( false )
 {
 }
 
@@ -37,4 +40,7 @@ void GraphicsConfig::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &GraphicsConfig::m_maxAnisotropy, "m_MaxAnisotropy" );
     comp.AddField( &GraphicsConfig::m_shadowMode, "m_ShadowMode" );
     comp.AddField( &GraphicsConfig::m_shadowBufferSize, "m_ShadowBufferSize" );
+    comp.AddField( &GraphicsConfig::m_textureStreamingBudget, "m_TextureStreamingBudget" );
+    comp.AddField( &GraphicsConfig::m_shaderVariantCacheSize, "m_ShaderVariantCacheSize" );
+    comp.AddField( &GraphicsConfig::m_bPipelinedRendering, "m_bPipelinedRendering" );
 }
@@ -62,6 +62,12 @@ namespace Helium
         /// Default shadow buffer size.
         static const uint32_t DEFAULT_SHADOW_BUFFER_SIZE = 1024;
 
+        /// Default texture streaming budget, in megabytes.
+        static const uint32_t DEFAULT_TEXTURE_STREAMING_BUDGET = 256;
+
+        /// Default maximum number of shader variants to keep cached.
+        static const uint32_t DEFAULT_SHADER_VARIANT_CACHE_SIZE = 512;
+
         /// @name Construction/Destruction
         //@{
         GraphicsConfig();
@@ -81,8 +87,13 @@ namespace Helium
         inline EShadowMode GetShadowMode() const;
         inline uint32_t GetShadowBufferSize() const;
 
+        inline uint32_t GetTextureStreamingBudget() const;
+
+        inline uint32_t GetShaderVariantCacheSize() const;
+
         inline bool GetFullscreen() const;
         inline bool GetVsync() const;
+        inline bool GetPipelinedRendering() const;
         //@}
 
     public:
@@ -101,10 +112,20 @@ namespace Helium
         /// Shadow buffer size (width/height, in texels).
         uint32_t m_shadowBufferSize;
 
+        /// Memory budget for streamed texture mip levels, in megabytes (zero to disable texture streaming and always
+        /// load full mip chains).
+        uint32_t m_textureStreamingBudget;
+
+        /// Maximum number of shader variants to keep cached (zero to disable the cache and always load all shader
+        /// variants used by each material up front).
+        uint32_t m_shaderVariantCacheSize;
+
         /// True to run in fullscreen mode, false to run in windowed mode.
         bool m_bFullscreen;
         /// True to enable vsync.
         bool m_bVsync;
+        /// True to render scenes on a dedicated render thread, one frame behind the game thread.
+        bool m_bPipelinedRendering;
     };
 }
 
@@ -52,6 +52,22 @@ namespace Helium
         return m_shadowBufferSize;
     }
 
+    /// Get the memory budget for streamed texture mip levels.
+    ///
+    /// @return  Texture streaming budget, in megabytes, or zero if texture streaming is disabled.
+    uint32_t GraphicsConfig::GetTextureStreamingBudget() const
+    {
+        return m_textureStreamingBudget;
+    }
+
+    /// Get the maximum number of shader variants to keep cached.
+    ///
+    /// @return  Shader variant cache size, or zero if shader variants are not cached.
+    uint32_t GraphicsConfig::GetShaderVariantCacheSize() const
+    {
+        return m_shaderVariantCacheSize;
+    }
+
     /// Get whether fullscreen mode is enabled.
     ///
     /// @return  True if fullscreen mode is enabled, false if not.
@@ -67,4 +83,12 @@ namespace Helium
     {
         return m_bVsync;
     }
+
+    /// Get whether scenes are rendered on a dedicated render thread.
+    ///
+    /// @return  True if pipelined rendering is enabled, false if scenes are rendered inline on the game thread.
+    bool GraphicsConfig::GetPipelinedRendering() const
+    {
+        return m_bPipelinedRendering;
+    }
 }
@@ -1,8 +1,12 @@
 
 #include "Precompile.h"
 #include "Graphics/GraphicsManagerComponent.h"
+#include "Graphics/GlyphCache.h"
 #include "Graphics/GraphicsScene.h"
 #include "Graphics/RenderResourceManager.h"
+#include "Graphics/RenderThread.h"
+#include "Graphics/ShaderVariantCache.h"
+#include "Graphics/TextureStreamingManager.h"
 #include "Rendering/Renderer.h"
 #include "Framework/TaskScheduler.h"
 #include "Framework/World.h"
@@ -84,4 +88,90 @@ HELIUM_DEFINE_TASK( GraphicsManagerDrawTask, ForEachWorld< DrawGraphics >, TickT
 void Helium::GraphicsManagerDrawTask::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecutesWithin< Helium::StandardDependencies::Render >();
-}
\ No newline at end of file
+}
+
+/// Run a per-frame cache update, deferring it to the next render thread synchronization point if pipelined rendering
+/// is enabled (caches are shared with rendering, so they must not be updated while the render thread is busy).
+///
+/// @param[in] pCallback  Update function.
+static void RunRenderSyncUpdate( RenderThread::SYNC_CALLBACK pCallback )
+{
+	RenderThread* pRenderThread = RenderThread::GetInstance();
+	if ( pRenderThread )
+	{
+		pRenderThread->QueueSyncCallback( pCallback );
+	}
+	else
+	{
+		pCallback();
+	}
+}
+
+static void UpdateTextureStreamingManager()
+{
+	TextureStreamingManager* pTextureStreamingManager = TextureStreamingManager::GetInstance();
+	if ( pTextureStreamingManager )
+	{
+		pTextureStreamingManager->Update();
+	}
+}
+
+void UpdateTextureStreaming( DynamicArray< WorldPtr > &rWorlds )
+{
+	// Texture mip levels are requested while drawing each world, so update streaming once all worlds are drawn.
+	RunRenderSyncUpdate( UpdateTextureStreamingManager );
+}
+
+HELIUM_DEFINE_TASK( TextureStreamingUpdateTask, UpdateTextureStreaming, TickTypes::Client )
+
+void Helium::TextureStreamingUpdateTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteAfter< Helium::GraphicsManagerDrawTask >();
+	rContract.ExecutesWithin< Helium::StandardDependencies::Render >();
+}
+
+static void UpdateShaderVariantCacheInstance()
+{
+	ShaderVariantCache* pShaderVariantCache = ShaderVariantCache::GetInstance();
+	if ( pShaderVariantCache )
+	{
+		pShaderVariantCache->Update();
+	}
+}
+
+void UpdateShaderVariantCache( DynamicArray< WorldPtr > &rWorlds )
+{
+	// Shader variants are requested while drawing each world, so update the cache once all worlds are drawn.
+	RunRenderSyncUpdate( UpdateShaderVariantCacheInstance );
+}
+
+HELIUM_DEFINE_TASK( ShaderVariantCacheUpdateTask, UpdateShaderVariantCache, TickTypes::Client )
+
+void Helium::ShaderVariantCacheUpdateTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteAfter< Helium::GraphicsManagerDrawTask >();
+	rContract.ExecutesWithin< Helium::StandardDependencies::Render >();
+}
+
+static void UpdateGlyphCacheInstance()
+{
+	GlyphCache* pGlyphCache = GlyphCache::GetInstance();
+	if ( pGlyphCache )
+	{
+		pGlyphCache->Update();
+	}
+}
+
+void UpdateGlyphCache( DynamicArray< WorldPtr > &rWorlds )
+{
+	// Characters drawn during a frame are protected from eviction, so only advance the frame once all worlds are drawn.
+	RunRenderSyncUpdate( UpdateGlyphCacheInstance );
+}
+
+HELIUM_DEFINE_TASK( GlyphCacheUpdateTask, UpdateGlyphCache, TickTypes::Client )
+
+void Helium::GlyphCacheUpdateTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteAfter< Helium::GraphicsManagerDrawTask >();
+	rContract.ExecutesWithin< Helium::StandardDependencies::Render >();
+}
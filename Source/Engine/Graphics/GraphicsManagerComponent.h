@@ -12,6 +12,7 @@ namespace Helium
 
 	class GraphicsScene;
 	class BufferedDrawer;
+	class SpriteBatcher;
 	typedef Helium::StrongPtr< GraphicsScene > GraphicsScenePtr;
 
 	class HELIUM_GRAPHICS_API GraphicsManagerComponent : public Component
@@ -28,6 +29,7 @@ namespace Helium
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 		inline BufferedDrawer& GetBufferedDrawer();
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+		inline SpriteBatcher&  GetSpriteBatcher();
 
 	private:
 		/// Graphics scene instance.
@@ -52,6 +54,24 @@ namespace Helium
 		HELIUM_DECLARE_TASK(GraphicsManagerDrawTask)
 		virtual void DefineContract(TaskContract &rContract);
 	};
+
+	struct HELIUM_GRAPHICS_API TextureStreamingUpdateTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(TextureStreamingUpdateTask)
+		virtual void DefineContract(TaskContract &rContract);
+	};
+
+	struct HELIUM_GRAPHICS_API ShaderVariantCacheUpdateTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(ShaderVariantCacheUpdateTask)
+		virtual void DefineContract(TaskContract &rContract);
+	};
+
+	struct HELIUM_GRAPHICS_API GlyphCacheUpdateTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(GlyphCacheUpdateTask)
+		virtual void DefineContract(TaskContract &rContract);
+	};
 }
 
 #include "Graphics/GraphicsManagerComponent.inl"
@@ -12,4 +12,9 @@ namespace Helium
 		return m_spGraphicsScene->GetSceneBufferedDrawer();
 	}
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+	SpriteBatcher& GraphicsManagerComponent::GetSpriteBatcher()
+	{
+		return m_spGraphicsScene->GetSpriteBatcher();
+	}
 }
@@ -1,13 +1,17 @@
 #include "Precompile.h"
 #include "Graphics/GraphicsScene.h"
 
+#include "MathSimd/Matrix44Soa.h"
 #include "MathSimd/Plane.h"
+#include "MathSimd/QuatSoa.h"
 #include "MathSimd/Vector3Soa.h"
 #include "MathSimd/VectorConversion.h"
 #include "EngineJobs/EngineJobsInterface.h"
+#include "EngineJobs/JobManager.h"
 #include "Rendering/RConstantBuffer.h"
 #include "Rendering/RIndexBuffer.h"
 #include "Rendering/RPixelShader.h"
+#include "Rendering/RRenderCommandList.h"
 #include "Rendering/RRenderCommandProxy.h"
 #include "Rendering/RRenderContext.h"
 #include "Rendering/Renderer.h"
@@ -20,7 +24,10 @@
 #include "Graphics/DynamicDrawer.h"
 #include "Graphics/Material.h"
 #include "Graphics/RenderResourceManager.h"
-#include "Graphics/Texture.h"
+#include "Graphics/RenderThread.h"
+#include "Graphics/Texture2d.h"
+#include "Graphics/TextureStreamingManager.h"
+#include "Engine/FrameProfiler.h"
 #include "Framework/World.h"
 #include "Framework/Entity.h"
 #include "Framework/Slice.h"
@@ -31,15 +38,200 @@ HELIUM_DEFINE_CLASS( Helium::GraphicsScene );
 
 using namespace Helium;
 
-HELIUM_DEFINE_COMPONENT( Helium::SceneObjectTransform, 32 );
-
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 static const size_t SCENE_VIEW_BUFFERED_DRAWER_POOL_BLOCK_SIZE = 4;
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
-namespace Helium
+/// Culling sphere radius for scene objects whose world bounds have not yet been set (ensures they are never visible).
+static const float32_t UNSET_BOUNDS_SPHERE_RADIUS = -1.0e30f;
+
+#if HELIUM_SIMD_SSE
+/// Number of queued scene object transform updates processed at once (one per SIMD lane).
+static const size_t TRANSFORM_UPDATE_BLOCK_SIZE = 4;
+
+/// Inputs and results for a block of scene object transform updates, stored in struct-of-arrays format.
+HELIUM_SIMD_ALIGN_PRE struct TransformUpdateBlock
+{
+	/// Rotation x-components.
+	float32_t rotationX[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Rotation y-components.
+	float32_t rotationY[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Rotation z-components.
+	float32_t rotationZ[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Rotation w-components.
+	float32_t rotationW[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Position x-coordinates.
+	float32_t positionX[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Position y-coordinates.
+	float32_t positionY[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Position z-coordinates.
+	float32_t positionZ[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Uniform scales.
+	float32_t scale[TRANSFORM_UPDATE_BLOCK_SIZE];
+
+	/// Vertex position dequantization offset x-coordinates.
+	float32_t positionOffsetX[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Vertex position dequantization offset y-coordinates.
+	float32_t positionOffsetY[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Vertex position dequantization offset z-coordinates.
+	float32_t positionOffsetZ[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Vertex position dequantization scales.
+	float32_t positionScale[TRANSFORM_UPDATE_BLOCK_SIZE];
+
+	/// Bounding box center x-coordinates (local space on input, world space on output).
+	float32_t centerX[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Bounding box center y-coordinates (local space on input, world space on output).
+	float32_t centerY[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Bounding box center z-coordinates (local space on input, world space on output).
+	float32_t centerZ[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Bounding box half-extent x-components (local space on input, world space on output).
+	float32_t extentX[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Bounding box half-extent y-components (local space on input, world space on output).
+	float32_t extentY[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// Bounding box half-extent z-components (local space on input, world space on output).
+	float32_t extentZ[TRANSFORM_UPDATE_BLOCK_SIZE];
+	/// World-space bounding sphere radii.
+	float32_t radius[TRANSFORM_UPDATE_BLOCK_SIZE];
+} HELIUM_SIMD_ALIGN_POST;
+
+/// Compute the absolute value of each component of a SIMD vector.
+///
+/// @param[in] vec  SIMD vector.
+///
+/// @return  Absolute values.
+static Simd::Register AbsF32( Simd::Register vec )
+{
+	return Simd::MaxF32( vec, Simd::SubtractF32( Simd::LoadZeros(), vec ) );
+}
+
+/// Compute the world-space half-extents of a set of bounding boxes from their local-space half-extents.
+///
+/// @param[in]  rTransform  Local-to-world transforms.
+/// @param[in]  rExtents    Local-space box half-extents.
+/// @param[out] rResult     World-space axis-aligned box half-extents.
+static void TransformBoxExtents(
+	const Simd::Matrix44Soa& rTransform,
+	const Simd::Vector3Soa& rExtents,
+	Simd::Vector3Soa& rResult )
+{
+	Simd::Vector4Soa xAxis;
+	Simd::Vector4Soa yAxis;
+	Simd::Vector4Soa zAxis;
+	rTransform.GetRow( 0, xAxis );
+	rTransform.GetRow( 1, yAxis );
+	rTransform.GetRow( 2, zAxis );
+
+	Simd::Register x = Simd::MultiplyF32( AbsF32( xAxis.m_x ), rExtents.m_x );
+	Simd::Register y = Simd::MultiplyF32( AbsF32( xAxis.m_y ), rExtents.m_x );
+	Simd::Register z = Simd::MultiplyF32( AbsF32( xAxis.m_z ), rExtents.m_x );
+
+	x = Simd::MultiplyAddF32( AbsF32( yAxis.m_x ), rExtents.m_y, x );
+	y = Simd::MultiplyAddF32( AbsF32( yAxis.m_y ), rExtents.m_y, y );
+	z = Simd::MultiplyAddF32( AbsF32( yAxis.m_z ), rExtents.m_y, z );
+
+	x = Simd::MultiplyAddF32( AbsF32( zAxis.m_x ), rExtents.m_z, x );
+	y = Simd::MultiplyAddF32( AbsF32( zAxis.m_y ), rExtents.m_z, y );
+	z = Simd::MultiplyAddF32( AbsF32( zAxis.m_z ), rExtents.m_z, z );
+
+	rResult.m_x = x;
+	rResult.m_y = y;
+	rResult.m_z = z;
+}
+#endif  // HELIUM_SIMD_SSE
+
+/// Number of sort key bits holding the sub-mesh ID.
+static const uint32_t SORT_KEY_SUB_MESH_BIT_COUNT = 20;
+/// Number of sort key bits holding the render pass.
+static const uint32_t SORT_KEY_PASS_BIT_COUNT = 2;
+/// Number of sort key bits holding the quantized depth for front-to-back sorting.
+static const uint32_t SORT_KEY_FRONT_TO_BACK_DEPTH_BIT_COUNT = 24;
+/// Number of sort key bits holding the mesh for front-to-back sorting.
+static const uint32_t SORT_KEY_FRONT_TO_BACK_MESH_BIT_COUNT = 18;
+/// Number of sort key bits holding each shader variant for material sorting.
+static const uint32_t SORT_KEY_MATERIAL_VARIANT_BIT_COUNT = 8;
+/// Number of sort key bits holding the material for material sorting.
+static const uint32_t SORT_KEY_MATERIAL_MATERIAL_BIT_COUNT = 10;
+/// Number of sort key bits holding the mesh for material sorting.
+static const uint32_t SORT_KEY_MATERIAL_MESH_BIT_COUNT = 8;
+/// Number of sort key bits holding the quantized depth for material sorting.
+static const uint32_t SORT_KEY_MATERIAL_DEPTH_BIT_COUNT = 8;
+/// Number of depth bits actually used when sorting front to back for the depth-only pre-pass (coarser than for shadow
+/// depth rendering so that sub-meshes sharing a mesh within each depth slice end up adjacent and can be instanced).
+static const uint32_t SORT_KEY_PRE_PASS_DEPTH_BIT_COUNT = 8;
+
+/// Minimum number of consecutive matching sub-meshes to draw using a single instanced draw call.
+static const size_t INSTANCE_RUN_LENGTH_MIN = 2;
+/// Number of instances that can be stored in the shared instance vertex buffer.
+static const size_t INSTANCE_VERTEX_BUFFER_INSTANCE_COUNT = 4096;
+/// Minimum number of shadow depth pass draw calls to record in each job.
+static const size_t SHADOW_DEPTH_RECORD_JOB_DRAW_COUNT_MIN = 64;
+/// Maximum number of jobs across which to record the shadow depth pass.
+static const size_t SHADOW_DEPTH_RECORD_JOB_COUNT_MAX = JobManager::WORKER_COUNT_MAX + 1;
+
+/// Size of the global vertex shader constants for each scene view, in bytes.
+static const uint32_t VIEW_VERTEX_GLOBAL_DATA_SIZE = sizeof( float32_t ) * 32;
+/// Size of the base-pass vertex shader constants for each scene view, in bytes.
+static const uint32_t VIEW_VERTEX_BASE_PASS_DATA_SIZE = sizeof( float32_t ) * 24;
+/// Size of the screen-space vertex shader constants for each scene view, in bytes.
+static const uint32_t VIEW_VERTEX_SCREEN_DATA_SIZE = sizeof( float32_t ) * 20;
+/// Size of the base-pass pixel shader constants for each scene view, in bytes.
+static const uint32_t VIEW_PIXEL_BASE_PASS_DATA_SIZE = sizeof( float32_t ) * 16;
+/// Size of the shadow depth pass vertex shader constants for each scene view, in bytes.
+static const uint32_t SHADOW_VIEW_VERTEX_DATA_SIZE = sizeof( float32_t ) * 32;
+/// Size of the vertex shader constants for each static mesh instance, in bytes.
+static const uint32_t STATIC_INSTANCE_VERTEX_GLOBAL_DATA_SIZE = sizeof( float32_t ) * 12;
+/// Size of the vertex shader constants for each skinned mesh instance, in bytes.
+static const uint32_t SKINNED_INSTANCE_VERTEX_GLOBAL_DATA_SIZE = sizeof( float32_t ) * 12 * BONE_COUNT_MAX;
+
+/// Get the sort key bits for a sub-mesh ID.
+///
+/// @param[in] subMeshId  Sub-mesh ID.
+///
+/// @return  Sub-mesh ID sort key bits.
+static uint64_t GetSortKeySubMeshBits( size_t subMeshId )
+{
+	HELIUM_ASSERT( subMeshId < ( static_cast< size_t >( 1 ) << SORT_KEY_SUB_MESH_BIT_COUNT ) );
+
+	return static_cast< uint64_t >( subMeshId );
+}
+
+/// Get a compact value identifying a resource for storage in a sort key.
+///
+/// The value is derived from a hash of the resource address, so equal resources always produce equal values while
+/// different resources only rarely collide (a collision only affects how well state changes are grouped, not the
+/// correctness of rendering).
+///
+/// @param[in] pResource  Resource address.
+/// @param[in] bitCount   Number of bits available in the sort key.
+///
+/// @return  Sort key value (zero for null resources).
+static uint64_t GetSortKeyPointerBits( const void* pResource, uint32_t bitCount )
+{
+	if ( !pResource )
+	{
+		return 0;
+	}
+
+	uint64_t hash = static_cast< uint64_t >( reinterpret_cast< uintptr_t >( pResource ) ) * 0x9e3779b97f4a7c15ULL;
+	uint64_t value = hash >> ( 64 - bitCount );
+
+	return ( value != 0 ? value : 1 );
+}
+
+/// Quantize a depth value for storage in a sort key.
+///
+/// @param[in] depth       Depth to quantize.
+/// @param[in] minDepth    Smallest depth being sorted.
+/// @param[in] depthScale  Scale mapping depths offset by the minimum depth to the range [0, 1].
+/// @param[in] bitCount    Number of bits available in the sort key.
+///
+/// @return  Quantized depth.
+static uint64_t QuantizeSortKeyDepth( float32_t depth, float32_t minDepth, float32_t depthScale, uint32_t bitCount )
 {
-	HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+	float32_t maxValue = static_cast< float32_t >( ( static_cast< uint64_t >( 1 ) << bitCount ) - 1 );
+	float32_t value = Clamp( ( depth - minDepth ) * depthScale, 0.0f, 1.0f ) * maxValue;
+
+	return static_cast< uint64_t >( value + 0.5f );
 }
 
 /// Constructor.
@@ -57,28 +249,108 @@ GraphicsScene::GraphicsScene()
 	, m_directionalLightColor( 0xffffffff )
 	, m_directionalLightBrightness( 1.0f )
 	, m_activeViewId( Invalid< uint32_t >() )
-	, m_constantBufferSetIndex( 0 )
+	, m_instanceVertexBufferOffset( 0 )
+	, m_pRenderSnapshot( NULL )
+	, m_renderSnapshotIndex( 0 )
+	, m_bOcclusionCulling( true )
 {
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
-	HELIUM_VERIFY( m_sceneBufferedDrawer.Initialize() );
+	for ( size_t drawerIndex = 0; drawerIndex < HELIUM_ARRAY_COUNT( m_sceneBufferedDrawers ); ++drawerIndex )
+	{
+		HELIUM_VERIFY( m_sceneBufferedDrawers[drawerIndex].Initialize() );
+	}
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 }
 
 /// Destructor.
 GraphicsScene::~GraphicsScene()
 {
+	// Make sure the render thread is no longer using this scene.
+	RenderThread* pRenderThread = RenderThread::GetInstance();
+	if ( pRenderThread )
+	{
+		pRenderThread->Flush();
+	}
 }
 
 /// Update this graphics scene for the current frame.
+///
+/// Scene objects are placed and culled and the state needed for rendering is captured into a render snapshot, which
+/// is then either rendered immediately or, if pipelined rendering is enabled, queued on the render thread to be
+/// rendered while the next frame is being simulated.
+///
+/// @see Render()
 void GraphicsScene::Update( World *pWorld )
 {
-	// Check for lost devices.
-	Renderer* pRenderer = Renderer::GetInstance();
-	if ( !pRenderer )
+	HELIUM_FRAME_ZONE( "GraphicsScene::Update" );
+
+	// Place all scene objects moved since the last update.  This does not depend on the renderer, so do it first to
+	// keep the queue from growing while rendering is unavailable.
+	ApplySceneObjectTransformUpdates();
+
+	if ( !Renderer::GetInstance() )
 	{
 		return;
 	}
 
+	// Update each scene view as necessary.
+	size_t sceneViewCount = m_sceneViews.GetSize();
+	for ( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
+	{
+		if ( m_sceneViews.IsElementValid( viewIndex ) )
+		{
+			m_sceneViews[viewIndex].ConditionalUpdate();
+		}
+	}
+
+	// Capture the scene state for rendering into the snapshot not currently in use by the renderer.
+	size_t captureIndex = m_renderSnapshotIndex ^ 1;
+	CaptureRenderSnapshot( m_renderSnapshots[captureIndex] );
+
+	// Sort and expand the sprites submitted this frame alongside the snapshot.
+	m_spriteBatcher.Capture( captureIndex );
+
+	// Wait for the previous frame to finish rendering before publishing the new snapshot.
+	RenderThread* pRenderThread = RenderThread::GetInstance();
+	if ( pRenderThread )
+	{
+		pRenderThread->Flush();
+	}
+
+	// Nothing is being drawn at this point, so the materials about to be drawn can safely pick up their shader
+	// variants.
+	ResolveMaterialShaderVariants( m_renderSnapshots[captureIndex] );
+
+	m_renderSnapshotIndex = captureIndex;
+	m_pRenderSnapshot = &m_renderSnapshots[captureIndex];
+
+	if ( pRenderThread )
+	{
+		pRenderThread->QueueScene( this );
+	}
+	else
+	{
+		Render();
+	}
+}
+
+/// Render the most recently captured render snapshot.
+///
+/// This is called from the render thread if pipelined rendering is enabled, or from Update() on the game thread if
+/// not.  Only the snapshot and render-side working data may be accessed here, as the game thread may be updating the
+/// scene at the same time.
+///
+/// @see Update()
+void GraphicsScene::Render()
+{
+	HELIUM_FRAME_ZONE( "GraphicsScene::Render" );
+
+	HELIUM_ASSERT( m_pRenderSnapshot );
+
+	// Check for lost devices.
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
 	Renderer::EStatus rendererStatus = pRenderer->GetStatus();
 	if ( rendererStatus != Renderer::STATUS_READY )
 	{
@@ -103,7 +375,7 @@ void GraphicsScene::Update( World *pWorld )
 		return;
 	}
 
-	size_t sceneViewCount = m_sceneViews.GetSize();
+	size_t sceneViewCount = m_pRenderSnapshot->sceneViews.GetSize();
 	if ( sceneViewCount == 0 )
 	{
 		return;
@@ -116,51 +388,32 @@ void GraphicsScene::Update( World *pWorld )
 		m_shadowViewInverseViewProjectionMatrices.Resize( sceneViewCount );
 	}
 
-	// Update each scene view as necessary and compute their inverse view/projection matrices.
+	// Compute the inverse view/projection matrices of each scene view.
 	for ( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
 	{
-		if ( !m_sceneViews.IsElementValid( viewIndex ) )
+		if ( m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) )
 		{
-			continue;
+			UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
 		}
-
-		m_sceneViews[viewIndex].ConditionalUpdate();
-		UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
-	}
-
-	// Update each scene object as necessary.
-	size_t sceneObjectCount = m_sceneObjects.GetSize();
-	//for( size_t objectIndex = 0; objectIndex < sceneObjectCount; ++objectIndex )
-	//{
-	//    if( !m_sceneObjects.IsElementValid( objectIndex ) )
-	//    {
-	//        continue;
-	//    }
-
-	//    m_sceneObjects[ objectIndex ].ConditionalUpdate( this );
-	//}
-
-	for ( ImplementingComponentIterator<SceneObjectTransform> iter( *pWorld->m_ComponentManager ); *iter; iter.Advance() )
-	{
-		iter->GraphicsSceneObjectUpdate( this );
 	}
 
-	// Swap dynamic constant buffers and update their contents.
-	SwapDynamicConstantBuffers();
+	// Allocate and update the dynamic shader constants for the current frame.
+	UpdateDynamicConstantBuffers();
 
-	// Resize the visible object bit array as necessary.
-	m_visibleSceneObjects.Reserve( sceneObjectCount );
-	m_visibleSceneObjects.Resize( sceneObjectCount );
+	// Copy the captured sprite geometry for the current frame to the GPU.
+	m_spriteBatcher.Upload( m_renderSnapshotIndex );
 
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 	// Set up the scene's buffered drawer for the current frame.
-	m_sceneBufferedDrawer.BeginDrawing();
+	BufferedDrawer& rSceneBufferedDrawer = m_sceneBufferedDrawers[m_renderSnapshotIndex];
+	rSceneBufferedDrawer.BeginDrawing();
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
 	// Update and render each scene view.
 	for ( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
 	{
-		if ( m_activeViewId != Invalid< uint32_t >() && viewIndex != m_activeViewId )
+		uint32_t activeViewId = m_pRenderSnapshot->activeViewId;
+		if ( activeViewId != Invalid< uint32_t >() && viewIndex != activeViewId )
 		{
 			continue;
 		}
@@ -168,9 +421,9 @@ void GraphicsScene::Update( World *pWorld )
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 		// Set up the current view's buffered drawer for the current frame.
 		BufferedDrawer* pDrawer = NULL;
-		if ( viewIndex < m_viewBufferedDrawers.GetSize() )
+		if ( viewIndex < m_pRenderSnapshot->viewBufferedDrawers.GetSize() )
 		{
-			pDrawer = m_viewBufferedDrawers[viewIndex];
+			pDrawer = m_pRenderSnapshot->viewBufferedDrawers[viewIndex];
 			if ( pDrawer )
 			{
 				pDrawer->BeginDrawing();
@@ -189,9 +442,15 @@ void GraphicsScene::Update( World *pWorld )
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 	}
 
+	// Fence the constant ring buffer region used for the current frame so that it is not overwritten until rendering
+	// has completed.
+	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
+	HELIUM_ASSERT( spCommandProxy );
+	m_constantBufferRing.FenceFrame( spCommandProxy );
+
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 	// Finish drawing with the scene's buffered drawer.
-	m_sceneBufferedDrawer.EndDrawing();
+	rSceneBufferedDrawer.EndDrawing();
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 }
 
@@ -225,16 +484,27 @@ void GraphicsScene::ReleaseSceneView( uint32_t id )
 		SetInvalid( m_activeViewId );
 	}
 
-	// Release any allocated buffered drawing interface for the view being released.
+	// Release any allocated buffered drawing interfaces for the view being released, making sure the render thread
+	// is no longer using them first.
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
-	if ( id < m_viewBufferedDrawers.GetSize() )
+	RenderThread* pRenderThread = RenderThread::GetInstance();
+	if ( pRenderThread )
 	{
-		BufferedDrawer* pDrawer = m_viewBufferedDrawers[id];
-		if ( pDrawer )
+		pRenderThread->Flush();
+	}
+
+	for ( size_t setIndex = 0; setIndex < HELIUM_ARRAY_COUNT( m_viewBufferedDrawers ); ++setIndex )
+	{
+		DynamicArray< BufferedDrawer* >& rViewBufferedDrawers = m_viewBufferedDrawers[setIndex];
+		if ( id < rViewBufferedDrawers.GetSize() )
 		{
-			pDrawer->Shutdown();
-			m_viewBufferedDrawerPool.Release( pDrawer );
-			m_viewBufferedDrawers[id] = NULL;
+			BufferedDrawer* pDrawer = rViewBufferedDrawers[id];
+			if ( pDrawer )
+			{
+				pDrawer->Shutdown();
+				m_viewBufferedDrawerPool.Release( pDrawer );
+				rViewBufferedDrawers[id] = NULL;
+			}
 		}
 	}
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
@@ -262,7 +532,57 @@ size_t GraphicsScene::AllocateSceneObject()
 	GraphicsSceneObject* pSceneObject = m_sceneObjects.New();
 	HELIUM_ASSERT( pSceneObject );
 
-	return m_sceneObjects.GetElementIndex( pSceneObject );
+	size_t id = m_sceneObjects.GetElementIndex( pSceneObject );
+
+	// Add the object to the end of the packed culling slots.  The object is never visible until its world bounds
+	// are set.
+	size_t slotIndex = m_cullSlotSceneObjectIds.GetSize();
+	m_cullSlotSceneObjectIds.Push( id );
+
+	size_t sceneObjectCullSlotCount = m_sceneObjectCullSlots.GetSize();
+	if ( id >= sceneObjectCullSlotCount )
+	{
+		m_sceneObjectCullSlots.Add( Invalid< size_t >(), id - sceneObjectCullSlotCount + 1 );
+	}
+
+	m_sceneObjectCullSlots[id] = slotIndex;
+
+	size_t sceneObjectTreeLeafCount = m_sceneObjectTreeLeaves.GetSize();
+	if ( id >= sceneObjectTreeLeafCount )
+	{
+		m_sceneObjectTreeLeaves.Add( Invalid< size_t >(), id - sceneObjectTreeLeafCount + 1 );
+	}
+
+	SetInvalid( m_sceneObjectTreeLeaves[id] );
+
+	size_t sceneObjectFirstSubMeshCount = m_sceneObjectFirstSubMeshIds.GetSize();
+	if ( id >= sceneObjectFirstSubMeshCount )
+	{
+		m_sceneObjectFirstSubMeshIds.Add( Invalid< size_t >(), id - sceneObjectFirstSubMeshCount + 1 );
+	}
+
+	SetInvalid( m_sceneObjectFirstSubMeshIds[id] );
+
+	size_t sceneObjectLocalSpaceCount = m_sceneObjectLocalSpaces.GetSize();
+	if ( id >= sceneObjectLocalSpaceCount )
+	{
+		m_sceneObjectLocalSpaces.Add( SceneObjectLocalSpace(), id - sceneObjectLocalSpaceCount + 1 );
+	}
+
+	SceneObjectLocalSpace& rLocalSpace = m_sceneObjectLocalSpaces[id];
+	rLocalSpace.boundsCenter = Simd::Vector3( 0.0f );
+	rLocalSpace.boundsExtent = Simd::Vector3( 0.0f );
+	rLocalSpace.positionOffset = Simd::Vector3( 0.0f );
+	rLocalSpace.positionScale = 1.0f;
+
+	if ( slotIndex / CULL_BLOCK_SPHERE_COUNT >= m_cullBlocks.GetSize() )
+	{
+		m_cullBlocks.New();
+	}
+
+	SetCullSlotSphere( slotIndex, Simd::Sphere( 0.0f, 0.0f, 0.0f, UNSET_BOUNDS_SPHERE_RADIUS ) );
+
+	return id;
 }
 
 /// Detach and release a previously allocated scene object.
@@ -276,167 +596,610 @@ void GraphicsScene::ReleaseSceneObject( size_t id )
 	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
 
 	m_sceneObjects.Remove( id );
+
+	// Drop any queued transform changes, as the ID may be reused before the next update.
+	size_t transformUpdateCount = m_sceneObjectTransformUpdates.GetSize();
+	for ( size_t updateIndex = 0; updateIndex < transformUpdateCount; ++updateIndex )
+	{
+		SceneObjectTransformUpdate& rUpdate = m_sceneObjectTransformUpdates[updateIndex];
+		if ( rUpdate.sceneObjectId == id )
+		{
+			SetInvalid( rUpdate.sceneObjectId );
+		}
+	}
+
+	// All sub-meshes should have been released before their scene object.
+	HELIUM_ASSERT( id < m_sceneObjectFirstSubMeshIds.GetSize() );
+	HELIUM_ASSERT( IsInvalid( m_sceneObjectFirstSubMeshIds[id] ) );
+
+	HELIUM_ASSERT( id < m_sceneObjectTreeLeaves.GetSize() );
+	size_t leafId = m_sceneObjectTreeLeaves[id];
+	if ( IsValid( leafId ) )
+	{
+		m_sceneObjectTree.DestroyLeaf( leafId );
+		SetInvalid( m_sceneObjectTreeLeaves[id] );
+	}
+
+	// Keep the culling slots packed by moving the object in the last slot into the slot being released.
+	HELIUM_ASSERT( id < m_sceneObjectCullSlots.GetSize() );
+	size_t slotIndex = m_sceneObjectCullSlots[id];
+	HELIUM_ASSERT( slotIndex < m_cullSlotSceneObjectIds.GetSize() );
+	SetInvalid( m_sceneObjectCullSlots[id] );
+
+	size_t lastSlotIndex = m_cullSlotSceneObjectIds.GetSize() - 1;
+	if ( slotIndex != lastSlotIndex )
+	{
+		size_t movedId = m_cullSlotSceneObjectIds[lastSlotIndex];
+		m_cullSlotSceneObjectIds[slotIndex] = movedId;
+		m_sceneObjectCullSlots[movedId] = slotIndex;
+
+		const CullBlock& rLastBlock = m_cullBlocks[lastSlotIndex / CULL_BLOCK_SPHERE_COUNT];
+		size_t lastLaneIndex = lastSlotIndex % CULL_BLOCK_SPHERE_COUNT;
+		SetCullSlotSphere(
+			slotIndex,
+			Simd::Sphere(
+				rLastBlock.centerX[lastLaneIndex],
+				rLastBlock.centerY[lastLaneIndex],
+				rLastBlock.centerZ[lastLaneIndex],
+				rLastBlock.radius[lastLaneIndex] ) );
+	}
+
+	m_cullSlotSceneObjectIds.Pop();
+	m_cullBlocks.Resize(
+		( m_cullSlotSceneObjectIds.GetSize() + CULL_BLOCK_SPHERE_COUNT - 1 ) / CULL_BLOCK_SPHERE_COUNT );
 }
 
-/// Allocate new scene object sub-mesh data and add it to the scene.
+/// Set the world-space bounds of a scene object.
 ///
-/// @param[in] sceneObjectId  ID of the parent graphics scene object used to control the placement of the sub-mesh
-///                           as well as provide its vertex data.
+/// World bounds must be set through the scene (instead of directly on the scene object) so that the bounding
+/// sphere and bounding volume hierarchy used for view culling are kept up to date.
 ///
-/// @return  ID of the newly allocated object.
+/// @param[in] id    ID of the scene object to update.
+/// @param[in] rBox  World-space bounding box.
 ///
-/// @see ReleaseSceneObjectSubMeshData(), GetSceneObjectSubMeshData()
-size_t GraphicsScene::AllocateSceneObjectSubMeshData( size_t sceneObjectId )
+/// @see AllocateSceneObject(), GetSceneObject()
+void GraphicsScene::SetSceneObjectWorldBounds( size_t id, const Simd::AaBox& rBox )
 {
-	HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
-	HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
-
-	GraphicsSceneObject::SubMeshData* pSubMeshData = m_sceneObjectSubMeshes.New( sceneObjectId );
-	HELIUM_ASSERT( pSubMeshData );
+	HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
 
-	return m_sceneObjectSubMeshes.GetElementIndex( pSubMeshData );
+	m_sceneObjects[id].SetWorldBounds( rBox );
+	UpdateSceneObjectCullBounds( id );
 }
 
-/// Detach and release previously allocated scene object sub-mesh data.
+/// Set the local-space bounds of a scene object.
 ///
-/// @param[in] id  ID of the object to release.
+/// Local bounds are transformed into world bounds whenever a new transform is queued for the object using
+/// QueueSceneObjectTransform().  Objects default to empty bounds at their local origin.
 ///
-/// @see AllocateScenObjectSubMeshData(), GetSceneObjectSubMeshData()
-void GraphicsScene::ReleaseSceneObjectSubMeshData( size_t id )
+/// @param[in] id    ID of the scene object to update.
+/// @param[in] rBox  Local-space bounding box.
+///
+/// @see SetSceneObjectPositionQuantization(), QueueSceneObjectTransform()
+void GraphicsScene::SetSceneObjectLocalBounds( size_t id, const Simd::AaBox& rBox )
 {
-	HELIUM_ASSERT( id < m_sceneObjectSubMeshes.GetSize() );
-	HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( id ) );
+	HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+	HELIUM_ASSERT( id < m_sceneObjectLocalSpaces.GetSize() );
 
-	m_sceneObjectSubMeshes.Remove( id );
+	const Simd::Vector3& rMinimum = rBox.GetMinimum();
+	const Simd::Vector3& rMaximum = rBox.GetMaximum();
+
+	SceneObjectLocalSpace& rLocalSpace = m_sceneObjectLocalSpaces[id];
+	rLocalSpace.boundsCenter = ( rMinimum + rMaximum ) * 0.5f;
+	rLocalSpace.boundsExtent = ( rMaximum - rMinimum ) * 0.5f;
 }
 
-/// Set the properties for the scene's ambient lighting.
+/// Set the offset and scale used to dequantize the vertex positions of a scene object.
 ///
-/// @param[in] rTopColor         Ambient light coloring to apply to upward-facing normals.
-/// @param[in] topBrightness     Ambient light brightness factor to apply to upward-facing normals.
-/// @param[in] rBottomColor      Ambient light coloring to apply to downward-facing normals.
-/// @param[in] bottomBrightness  Ambient light brightness factor to apply to downward-facing normals.
+/// The dequantization is folded into the transform set on the scene object whenever a new transform is queued
+/// using QueueSceneObjectTransform().  Objects default to no offset and a scale of one.
 ///
-/// @see GetAmbientLightTopColor(), GetAmbientLightTopBrightness(), GetAmbientLightBottomColor(),
-///      GetAmbientLightBottomBrightness()
-void GraphicsScene::SetAmbientLight(
-	const Color& rTopColor,
-	float32_t topBrightness,
-	const Color& rBottomColor,
-	float32_t bottomBrightness )
+/// @param[in] id       ID of the scene object to update.
+/// @param[in] rOffset  Offset applied to vertex positions after scaling.
+/// @param[in] scale    Scale applied to vertex positions.
+///
+/// @see SetSceneObjectLocalBounds(), QueueSceneObjectTransform()
+void GraphicsScene::SetSceneObjectPositionQuantization( size_t id, const Simd::Vector3& rOffset, float32_t scale )
 {
-	m_ambientLightTopColor = rTopColor;
-	m_ambientLightTopBrightness = topBrightness;
-	m_ambientLightBottomColor = rBottomColor;
-	m_ambientLightBottomBrightness = bottomBrightness;
+	HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+	HELIUM_ASSERT( id < m_sceneObjectLocalSpaces.GetSize() );
+
+	SceneObjectLocalSpace& rLocalSpace = m_sceneObjectLocalSpaces[id];
+	rLocalSpace.positionOffset = rOffset;
+	rLocalSpace.positionScale = scale;
 }
 
-/// Set the properties for the scene's global directional light.
+/// Queue a change in the placement of a scene object.
 ///
-/// @param[in] rDirection  Light direction.
-/// @param[in] rColor      Light color.
-/// @param[in] brightness  Light brightness factor.
+/// Queued changes are applied together at the start of the next Update(), which rebuilds the transform, world bounds
+/// and culling data of only the objects that moved.  If the same object is queued more than once, the last change
+/// wins.
 ///
-/// @see GetDirectionalLightDirection(), GetDirectionalLightColor(), GetDirectionalLightBrightness()
-void GraphicsScene::SetDirectionalLight( const Simd::Vector3& rDirection, const Color& rColor, float32_t brightness )
+/// @param[in] id         ID of the scene object to update.
+/// @param[in] rPosition  World-space position.
+/// @param[in] rRotation  World-space rotation.
+/// @param[in] scale      Uniform scale.
+///
+/// @see SetSceneObjectLocalBounds(), SetSceneObjectPositionQuantization()
+void GraphicsScene::QueueSceneObjectTransform(
+	size_t id,
+	const Simd::Vector3& rPosition,
+	const Simd::Quat& rRotation,
+	float32_t scale )
 {
-	m_directionalLightDirection = rDirection;
-	m_directionalLightDirection.Normalize();
+	HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
 
-	m_directionalLightColor = rColor;
-	m_directionalLightBrightness = brightness;
+	SceneObjectTransformUpdate* pUpdate = m_sceneObjectTransformUpdates.New();
+	HELIUM_ASSERT( pUpdate );
+	pUpdate->rotation = rRotation;
+	pUpdate->position = rPosition;
+	pUpdate->scale = scale;
+	pUpdate->sceneObjectId = id;
 }
 
-#if GRAPHICS_SCENE_BUFFERED_DRAWER
-/// Get the buffered drawing interface for the specified scene view.
-///
-/// Draw calls buffered through the provided interface will only be rendered on the scene view with the specified
-/// ID.
-///
-/// @param[in] id  Scene view ID.
+/// Apply all scene object transform changes queued since the last update.
 ///
-/// @return  Pointer to the buffered drawing interface for the specified scene view if valid, null if not.
+/// Only queued objects are touched.  Their transforms, world bounding boxes and bounding spheres are built four at a
+/// time in struct-of-arrays form, then written back to each object along with its culling data.
 ///
-/// @see GetSceneBufferedDrawer()
-BufferedDrawer* GraphicsScene::GetSceneViewBufferedDrawer( uint32_t id )
+/// @see QueueSceneObjectTransform()
+void GraphicsScene::ApplySceneObjectTransformUpdates()
 {
-	// Make sure the ID references a valid view first.
-	if ( id >= m_sceneViews.GetSize() || !m_sceneViews.IsElementValid( id ) )
-	{
-		return NULL;
-	}
-
-	// If a buffered drawer does not already exist for the specified view, allocate one from the object pool.
-	BufferedDrawer* pDrawer = NULL;
-
-	size_t viewBufferedDrawerCount = m_viewBufferedDrawers.GetSize();
-	if ( id < viewBufferedDrawerCount )
+	size_t updateCount = m_sceneObjectTransformUpdates.GetSize();
+	if ( updateCount == 0 )
 	{
-		pDrawer = m_viewBufferedDrawers[id];
+		return;
 	}
 
-	if ( !pDrawer )
+#if HELIUM_SIMD_SSE
+	TransformUpdateBlock block;
+	size_t laneSceneObjectIds[TRANSFORM_UPDATE_BLOCK_SIZE];
+	Simd::Matrix44 laneTransforms[TRANSFORM_UPDATE_BLOCK_SIZE];
+
+	Simd::QuatSoa rotations;
+	Simd::Vector3Soa positions;
+	Simd::Vector3Soa positionOffsets;
+	Simd::Vector3Soa centers;
+	Simd::Vector3Soa extents;
+	Simd::Matrix44Soa transforms;
+
+	for ( size_t baseIndex = 0; baseIndex < updateCount; baseIndex += TRANSFORM_UPDATE_BLOCK_SIZE )
 	{
-		pDrawer = m_viewBufferedDrawerPool.Allocate();
-		if ( pDrawer )
+		// Gather the next set of updates, padding unused lanes (and lanes for released objects) with an identity
+		// placement.
+		size_t laneCount = Min( updateCount - baseIndex, TRANSFORM_UPDATE_BLOCK_SIZE );
+		for ( size_t laneIndex = 0; laneIndex < TRANSFORM_UPDATE_BLOCK_SIZE; ++laneIndex )
 		{
-			if ( id >= viewBufferedDrawerCount )
+			size_t sceneObjectId = Invalid< size_t >();
+			if ( laneIndex < laneCount )
+			{
+				sceneObjectId = m_sceneObjectTransformUpdates[baseIndex + laneIndex].sceneObjectId;
+			}
+
+			laneSceneObjectIds[laneIndex] = sceneObjectId;
+
+			if ( IsInvalid( sceneObjectId ) )
+			{
+				block.rotationX[laneIndex] = 0.0f;
+				block.rotationY[laneIndex] = 0.0f;
+				block.rotationZ[laneIndex] = 0.0f;
+				block.rotationW[laneIndex] = 1.0f;
+				block.positionX[laneIndex] = 0.0f;
+				block.positionY[laneIndex] = 0.0f;
+				block.positionZ[laneIndex] = 0.0f;
+				block.scale[laneIndex] = 1.0f;
+				block.positionOffsetX[laneIndex] = 0.0f;
+				block.positionOffsetY[laneIndex] = 0.0f;
+				block.positionOffsetZ[laneIndex] = 0.0f;
+				block.positionScale[laneIndex] = 1.0f;
+				block.centerX[laneIndex] = 0.0f;
+				block.centerY[laneIndex] = 0.0f;
+				block.centerZ[laneIndex] = 0.0f;
+				block.extentX[laneIndex] = 0.0f;
+				block.extentY[laneIndex] = 0.0f;
+				block.extentZ[laneIndex] = 0.0f;
+
+				continue;
+			}
+
+			const SceneObjectTransformUpdate& rUpdate = m_sceneObjectTransformUpdates[baseIndex + laneIndex];
+			HELIUM_ASSERT( sceneObjectId < m_sceneObjectLocalSpaces.GetSize() );
+			const SceneObjectLocalSpace& rLocalSpace = m_sceneObjectLocalSpaces[sceneObjectId];
+
+			block.rotationX[laneIndex] = rUpdate.rotation.GetElement( 0 );
+			block.rotationY[laneIndex] = rUpdate.rotation.GetElement( 1 );
+			block.rotationZ[laneIndex] = rUpdate.rotation.GetElement( 2 );
+			block.rotationW[laneIndex] = rUpdate.rotation.GetElement( 3 );
+			block.positionX[laneIndex] = rUpdate.position.GetElement( 0 );
+			block.positionY[laneIndex] = rUpdate.position.GetElement( 1 );
+			block.positionZ[laneIndex] = rUpdate.position.GetElement( 2 );
+			block.scale[laneIndex] = rUpdate.scale;
+			block.positionOffsetX[laneIndex] = rLocalSpace.positionOffset.GetElement( 0 );
+			block.positionOffsetY[laneIndex] = rLocalSpace.positionOffset.GetElement( 1 );
+			block.positionOffsetZ[laneIndex] = rLocalSpace.positionOffset.GetElement( 2 );
+			block.positionScale[laneIndex] = rLocalSpace.positionScale;
+			block.centerX[laneIndex] = rLocalSpace.boundsCenter.GetElement( 0 );
+			block.centerY[laneIndex] = rLocalSpace.boundsCenter.GetElement( 1 );
+			block.centerZ[laneIndex] = rLocalSpace.boundsCenter.GetElement( 2 );
+			block.extentX[laneIndex] = rLocalSpace.boundsExtent.GetElement( 0 );
+			block.extentY[laneIndex] = rLocalSpace.boundsExtent.GetElement( 1 );
+			block.extentZ[laneIndex] = rLocalSpace.boundsExtent.GetElement( 2 );
+		}
+
+		// Build the world transforms.
+		rotations.Load( block.rotationX, block.rotationY, block.rotationZ, block.rotationW );
+		positions.Load( block.positionX, block.positionY, block.positionZ );
+		transforms.SetRotationTranslationScaling( rotations, positions, Simd::LoadAligned( block.scale ) );
+
+		// Transform the local bounding box centers and project their extents onto the world axes.  The bounding
+		// sphere of each world box shares its center, with a radius equal to the length of its half-extents.
+		centers.Load( block.centerX, block.centerY, block.centerZ );
+		extents.Load( block.extentX, block.extentY, block.extentZ );
+
+		transforms.TransformPoint( centers, centers );
+		TransformBoxExtents( transforms, extents, extents );
+
+		centers.Store( block.centerX, block.centerY, block.centerZ );
+		extents.Store( block.extentX, block.extentY, block.extentZ );
+		Simd::StoreAligned( block.radius, extents.GetMagnitude() );
+
+		// Fold the dequantization of vertex positions into the rendering transforms.
+		positionOffsets.Load( block.positionOffsetX, block.positionOffsetY, block.positionOffsetZ );
+		transforms.TranslateLocal( positionOffsets );
+		transforms.ScaleLocal( Simd::LoadAligned( block.positionScale ) );
+		transforms.Scatter( laneTransforms[0], laneTransforms[1], laneTransforms[2], laneTransforms[3] );
+
+		// Write the results back to each scene object.
+		for ( size_t laneIndex = 0; laneIndex < laneCount; ++laneIndex )
+		{
+			size_t sceneObjectId = laneSceneObjectIds[laneIndex];
+			if ( IsInvalid( sceneObjectId ) )
 			{
-				m_viewBufferedDrawers.Add( NULL, id - viewBufferedDrawerCount + 1 );
+				continue;
 			}
 
-			m_viewBufferedDrawers[id] = pDrawer;
+			Simd::Vector3 center( block.centerX[laneIndex], block.centerY[laneIndex], block.centerZ[laneIndex] );
+			Simd::Vector3 extent( block.extentX[laneIndex], block.extentY[laneIndex], block.extentZ[laneIndex] );
 
-			HELIUM_VERIFY( pDrawer->Initialize() );
+			HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+			GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+			rSceneObject.SetTransform( laneTransforms[laneIndex] );
+			rSceneObject.SetWorldBounds(
+				Simd::AaBox( center - extent, center + extent ),
+				Simd::Sphere( center, block.radius[laneIndex] ) );
+
+			UpdateSceneObjectCullBounds( sceneObjectId );
 		}
 	}
+#else  // HELIUM_SIMD_SSE
+	for ( size_t updateIndex = 0; updateIndex < updateCount; ++updateIndex )
+	{
+		const SceneObjectTransformUpdate& rUpdate = m_sceneObjectTransformUpdates[updateIndex];
+		size_t sceneObjectId = rUpdate.sceneObjectId;
+		if ( IsInvalid( sceneObjectId ) )
+		{
+			continue;
+		}
 
-	return pDrawer;
-}
-#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+		HELIUM_ASSERT( sceneObjectId < m_sceneObjectLocalSpaces.GetSize() );
+		const SceneObjectLocalSpace& rLocalSpace = m_sceneObjectLocalSpaces[sceneObjectId];
 
-/// Get the name of the default sampler state used by material shaders.  Note that this must match the name given in
-/// Data/Shaders/Common.inl.
-///
-/// @return  Default sampler state name.
-Name GraphicsScene::GetDefaultSamplerStateName()
-{
-	static Name defaultSamplerStateName( "DefaultSamplerState" );
+		Simd::Matrix44 transform( Simd::Matrix44::INIT_ROTATION_TRANSLATION, rUpdate.rotation, rUpdate.position );
+		transform.ScaleLocal( rUpdate.scale );
 
-	return defaultSamplerStateName;
-}
+		Simd::AaBox worldBounds(
+			rLocalSpace.boundsCenter - rLocalSpace.boundsExtent,
+			rLocalSpace.boundsCenter + rLocalSpace.boundsExtent );
+		worldBounds.TransformBy( transform );
 
-/// Get the name of the shadow map sampler state.
-///
-/// @return  Shadow map sampler state name.
-Name GraphicsScene::GetShadowSamplerStateName()
-{
-	static Name shadowSamplerStateName( "ShadowSamplerState" );
+		transform.TranslateLocal( rLocalSpace.positionOffset );
+		transform.ScaleLocal( rLocalSpace.positionScale );
 
-	return shadowSamplerStateName;
+		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+		m_sceneObjects[sceneObjectId].SetTransform( transform );
+		SetSceneObjectWorldBounds( sceneObjectId, worldBounds );
+	}
+#endif  // HELIUM_SIMD_SSE
+
+	m_sceneObjectTransformUpdates.Resize( 0 );
 }
 
-/// Get the reserved name for the shadow map texture in material shaders.
+/// Update the culling sphere and bounding volume hierarchy leaf of a scene object from its current world bounds.
 ///
-/// @return  Shadow map shader texture input name.
-Name GraphicsScene::GetShadowMapTextureName()
+/// @param[in] id  ID of the scene object to update.
+///
+/// @see SetSceneObjectWorldBounds()
+void GraphicsScene::UpdateSceneObjectCullBounds( size_t id )
 {
-	static Name shadowMapTextureName( "_ShadowMap" );
+	const GraphicsSceneObject& rSceneObject = m_sceneObjects[id];
 
-	return shadowMapTextureName;
-}
+	HELIUM_ASSERT( id < m_sceneObjectCullSlots.GetSize() );
+	SetCullSlotSphere( m_sceneObjectCullSlots[id], rSceneObject.GetWorldSphere() );
 
-/// Update the shadow depth pass inverse view/projection matrix for a given scene view.
-///
+	HELIUM_ASSERT( id < m_sceneObjectTreeLeaves.GetSize() );
+	const Simd::AaBox& rBox = rSceneObject.GetWorldBox();
+	size_t& rLeafId = m_sceneObjectTreeLeaves[id];
+	if ( IsValid( rLeafId ) )
+	{
+		m_sceneObjectTree.MoveLeaf( rLeafId, rBox );
+	}
+	else
+	{
+		rLeafId = m_sceneObjectTree.CreateLeaf( rBox, id );
+	}
+}
+
+/// Allocate new scene object sub-mesh data and add it to the scene.
+///
+/// @param[in] sceneObjectId  ID of the parent graphics scene object used to control the placement of the sub-mesh
+///                           as well as provide its vertex data.
+///
+/// @return  ID of the newly allocated object, or an invalid index if the scene already holds the maximum number of
+///          sub-meshes that can be sorted for rendering.
+///
+/// @see ReleaseSceneObjectSubMeshData(), GetSceneObjectSubMeshData()
+size_t GraphicsScene::AllocateSceneObjectSubMeshData( size_t sceneObjectId )
+{
+	HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+
+	GraphicsSceneObject::SubMeshData* pSubMeshData = m_sceneObjectSubMeshes.New( sceneObjectId );
+	HELIUM_ASSERT( pSubMeshData );
+
+	size_t id = m_sceneObjectSubMeshes.GetElementIndex( pSubMeshData );
+
+	// Sub-mesh IDs are stored in the low bits of the render sort keys, so IDs that do not fit cannot be drawn.
+	if ( id >= ( static_cast< size_t >( 1 ) << SORT_KEY_SUB_MESH_BIT_COUNT ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"GraphicsScene::AllocateSceneObjectSubMeshData(): Scene sub-mesh limit of %" PRIuSZ " reached.\n",
+			static_cast< size_t >( 1 ) << SORT_KEY_SUB_MESH_BIT_COUNT );
+
+		m_sceneObjectSubMeshes.Remove( id );
+
+		return Invalid< size_t >();
+	}
+
+	// Link the sub-mesh into the sub-mesh list of its scene object.
+	size_t nextSubMeshCount = m_nextSubMeshIds.GetSize();
+	if ( id >= nextSubMeshCount )
+	{
+		m_nextSubMeshIds.Add( Invalid< size_t >(), id - nextSubMeshCount + 1 );
+	}
+
+	HELIUM_ASSERT( sceneObjectId < m_sceneObjectFirstSubMeshIds.GetSize() );
+	m_nextSubMeshIds[id] = m_sceneObjectFirstSubMeshIds[sceneObjectId];
+	m_sceneObjectFirstSubMeshIds[sceneObjectId] = id;
+
+	return id;
+}
+
+/// Detach and release previously allocated scene object sub-mesh data.
+///
+/// @param[in] id  ID of the object to release.
+///
+/// @see AllocateScenObjectSubMeshData(), GetSceneObjectSubMeshData()
+void GraphicsScene::ReleaseSceneObjectSubMeshData( size_t id )
+{
+	HELIUM_ASSERT( id < m_sceneObjectSubMeshes.GetSize() );
+	HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( id ) );
+
+	// Unlink the sub-mesh from the sub-mesh list of its scene object.
+	size_t sceneObjectId = m_sceneObjectSubMeshes[id].GetSceneObjectId();
+	HELIUM_ASSERT( sceneObjectId < m_sceneObjectFirstSubMeshIds.GetSize() );
+	HELIUM_ASSERT( id < m_nextSubMeshIds.GetSize() );
+
+	size_t* pLinkId = &m_sceneObjectFirstSubMeshIds[sceneObjectId];
+	while ( *pLinkId != id )
+	{
+		HELIUM_ASSERT( IsValid( *pLinkId ) );
+		pLinkId = &m_nextSubMeshIds[*pLinkId];
+	}
+
+	*pLinkId = m_nextSubMeshIds[id];
+	SetInvalid( m_nextSubMeshIds[id] );
+
+	m_sceneObjectSubMeshes.Remove( id );
+}
+
+/// Allocate an occluder.
+///
+/// Occluders are simple, closed meshes (such as walls and large buildings) rasterized into a software depth buffer
+/// before drawing each scene view.  Scene objects completely hidden behind them are skipped when drawing.  Occluders
+/// are not drawn themselves, so they are usually paired with a scene object for the detailed mesh.
+///
+/// @param[in] pVertices      Occluder vertex positions (three floats per vertex).
+/// @param[in] vertexCount    Number of occluder vertices.
+/// @param[in] pIndices       Occluder triangle list indices.
+/// @param[in] triangleCount  Number of occluder triangles.
+///
+/// @return  ID of the allocated occluder.
+///
+/// @see ReleaseOccluder(), SetOccluderTransform()
+size_t GraphicsScene::AllocateOccluder(
+	const float32_t* pVertices,
+	uint32_t vertexCount,
+	const uint16_t* pIndices,
+	uint32_t triangleCount )
+{
+	HELIUM_ASSERT( pVertices || vertexCount == 0 );
+	HELIUM_ASSERT( pIndices || triangleCount == 0 );
+
+	Occluder* pOccluder = m_occluders.New();
+	HELIUM_ASSERT( pOccluder );
+
+	pOccluder->transform = Simd::Matrix44::IDENTITY;
+	pOccluder->vertices.Resize( 0 );
+	pOccluder->vertices.AddArray( pVertices, static_cast< size_t >( vertexCount ) * 3 );
+	pOccluder->indices.Resize( 0 );
+	pOccluder->indices.AddArray( pIndices, static_cast< size_t >( triangleCount ) * 3 );
+
+	return m_occluders.GetElementIndex( pOccluder );
+}
+
+/// Release a previously allocated occluder.
+///
+/// @param[in] id  ID of the occluder to release.
+///
+/// @see AllocateOccluder()
+void GraphicsScene::ReleaseOccluder( size_t id )
+{
+	HELIUM_ASSERT( id < m_occluders.GetSize() );
+	HELIUM_ASSERT( m_occluders.IsElementValid( id ) );
+
+	m_occluders.Remove( id );
+}
+
+/// Set the world transform of an occluder.
+///
+/// @param[in] id          ID of the occluder to update.
+/// @param[in] rTransform  World transform.
+///
+/// @see AllocateOccluder()
+void GraphicsScene::SetOccluderTransform( size_t id, const Simd::Matrix44& rTransform )
+{
+	HELIUM_ASSERT( id < m_occluders.GetSize() );
+	HELIUM_ASSERT( m_occluders.IsElementValid( id ) );
+
+	m_occluders[id].transform = rTransform;
+}
+
+/// Set the properties for the scene's ambient lighting.
+///
+/// @param[in] rTopColor         Ambient light coloring to apply to upward-facing normals.
+/// @param[in] topBrightness     Ambient light brightness factor to apply to upward-facing normals.
+/// @param[in] rBottomColor      Ambient light coloring to apply to downward-facing normals.
+/// @param[in] bottomBrightness  Ambient light brightness factor to apply to downward-facing normals.
+///
+/// @see GetAmbientLightTopColor(), GetAmbientLightTopBrightness(), GetAmbientLightBottomColor(),
+///      GetAmbientLightBottomBrightness()
+void GraphicsScene::SetAmbientLight(
+	const Color& rTopColor,
+	float32_t topBrightness,
+	const Color& rBottomColor,
+	float32_t bottomBrightness )
+{
+	m_ambientLightTopColor = rTopColor;
+	m_ambientLightTopBrightness = topBrightness;
+	m_ambientLightBottomColor = rBottomColor;
+	m_ambientLightBottomBrightness = bottomBrightness;
+}
+
+/// Set the properties for the scene's global directional light.
+///
+/// @param[in] rDirection  Light direction.
+/// @param[in] rColor      Light color.
+/// @param[in] brightness  Light brightness factor.
+///
+/// @see GetDirectionalLightDirection(), GetDirectionalLightColor(), GetDirectionalLightBrightness()
+void GraphicsScene::SetDirectionalLight( const Simd::Vector3& rDirection, const Color& rColor, float32_t brightness )
+{
+	m_directionalLightDirection = rDirection;
+	m_directionalLightDirection.Normalize();
+
+	m_directionalLightColor = rColor;
+	m_directionalLightBrightness = brightness;
+}
+
+#if GRAPHICS_SCENE_BUFFERED_DRAWER
+/// Get the buffered drawing interface for the specified scene view.
+///
+/// Draw calls buffered through the provided interface will only be rendered on the scene view with the specified
+/// ID.  As with GetSceneBufferedDrawer(), the returned drawer changes every update and should not be cached across
+/// frames.
+///
+/// @param[in] id  Scene view ID.
+///
+/// @return  Pointer to the buffered drawing interface for the specified scene view if valid, null if not.
+///
+/// @see GetSceneBufferedDrawer()
+BufferedDrawer* GraphicsScene::GetSceneViewBufferedDrawer( uint32_t id )
+{
+	// Make sure the ID references a valid view first.
+	if ( id >= m_sceneViews.GetSize() || !m_sceneViews.IsElementValid( id ) )
+	{
+		return NULL;
+	}
+
+	// If buffered drawers do not already exist for the specified view, allocate one for each render snapshot from the
+	// object pool.
+	DynamicArray< BufferedDrawer* >& rCaptureDrawers = m_viewBufferedDrawers[m_renderSnapshotIndex ^ 1];
+	if ( id < rCaptureDrawers.GetSize() && rCaptureDrawers[id] )
+	{
+		return rCaptureDrawers[id];
+	}
+
+	for ( size_t setIndex = 0; setIndex < HELIUM_ARRAY_COUNT( m_viewBufferedDrawers ); ++setIndex )
+	{
+		BufferedDrawer* pDrawer = m_viewBufferedDrawerPool.Allocate();
+		if ( !pDrawer )
+		{
+			return NULL;
+		}
+
+		DynamicArray< BufferedDrawer* >& rViewBufferedDrawers = m_viewBufferedDrawers[setIndex];
+		size_t viewBufferedDrawerCount = rViewBufferedDrawers.GetSize();
+		if ( id >= viewBufferedDrawerCount )
+		{
+			rViewBufferedDrawers.Add( NULL, id - viewBufferedDrawerCount + 1 );
+		}
+
+		HELIUM_ASSERT( !rViewBufferedDrawers[id] );
+		rViewBufferedDrawers[id] = pDrawer;
+
+		HELIUM_VERIFY( pDrawer->Initialize() );
+	}
+
+	return rCaptureDrawers[id];
+}
+#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+/// Get the name of the default sampler state used by material shaders.  Note that this must match the name given in
+/// Data/Shaders/Common.inl.
+///
+/// @return  Default sampler state name.
+Name GraphicsScene::GetDefaultSamplerStateName()
+{
+	static Name defaultSamplerStateName( "DefaultSamplerState" );
+
+	return defaultSamplerStateName;
+}
+
+/// Get the name of the shadow map sampler state.
+///
+/// @return  Shadow map sampler state name.
+Name GraphicsScene::GetShadowSamplerStateName()
+{
+	static Name shadowSamplerStateName( "ShadowSamplerState" );
+
+	return shadowSamplerStateName;
+}
+
+/// Get the reserved name for the shadow map texture in material shaders.
+///
+/// @return  Shadow map shader texture input name.
+Name GraphicsScene::GetShadowMapTextureName()
+{
+	static Name shadowMapTextureName( "_ShadowMap" );
+
+	return shadowMapTextureName;
+}
+
+/// Update the shadow depth pass inverse view/projection matrix for a given scene view.
+///
 /// @param[in] viewIndex  Index of the scene view for which to update the shadow depth pass transform matrix.
 void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIndex )
 {
-	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
-	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+	HELIUM_ASSERT( viewIndex < m_pRenderSnapshot->sceneViews.GetSize() );
+	HELIUM_ASSERT( m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) );
 	HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
 
 	// Compute the scene directional light's view basis for shadow calculation.
-	Simd::Vector3 shadowViewForward = m_directionalLightDirection;
+	Simd::Vector3 shadowViewForward = m_pRenderSnapshot->directionalLightDirection;
 	Simd::Vector3 shadowViewUp( 0.0f, 1.0f, 0.0f );
 
 	Simd::Vector3 shadowViewRight;
@@ -446,7 +1209,7 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
 	shadowViewUp.CrossSet( shadowViewForward, shadowViewRight );
 
 	// Compute the corners of the view frustum region affected by shadowing.
-	GraphicsSceneView& rView = m_sceneViews[viewIndex];
+	GraphicsSceneView& rView = m_pRenderSnapshot->sceneViews[viewIndex];
 
 	float32_t shadowCutoffDistance = rView.GetShadowCutoffDistance();
 
@@ -569,17 +1332,18 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
 /// @param[in] viewIndex  Index of the scene view for which to update the shadow depth pass transform matrix.
 void GraphicsScene::UpdateShadowInverseViewProjectionMatrixLspsm( size_t viewIndex )
 {
-	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
-	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+	HELIUM_ASSERT( viewIndex < m_pRenderSnapshot->sceneViews.GetSize() );
+	HELIUM_ASSERT( m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) );
 	HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
 
 	// XXX TMC TODO: Implement!!
 	UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
 }
 
-/// Swap the dynamic constant buffers for view and instance data and push the current frame's data into the new
-/// buffers.
-void GraphicsScene::SwapDynamicConstantBuffers()
+/// Allocate the current frame's view and instance shader constants from the constant ring buffer and fill them in.
+///
+/// The constant ring buffer is mapped once for the entire frame, and all allocations are written before it is unmapped.
+void GraphicsScene::UpdateDynamicConstantBuffers()
 {
 	// No need to update any rendering data if we have no active renderer.
 	Renderer* pRenderer = Renderer::GetInstance();
@@ -622,63 +1386,168 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 		shadowMapUvTransform.SetElement( 13, negHalfShadowMapUsableY + 1.0f );
 	}
 
-	// Swap buffer sets.
-	size_t bufferSetIndex = ( m_constantBufferSetIndex + 1 ) % HELIUM_ARRAY_COUNT( m_viewVertexGlobalDataBuffers );
-	m_constantBufferSetIndex = bufferSetIndex;
+	size_t sceneViewCount = m_pRenderSnapshot->sceneViews.GetSize();
+	size_t sceneObjectCount = m_pRenderSnapshot->sceneObjects.GetSize();
+	size_t subMeshCount = m_pRenderSnapshot->sceneObjectSubMeshes.GetSize();
 
-	// Update view constant buffers.
-	DynamicArray< RConstantBufferPtr >& rViewVertexGlobalDataBuffers = m_viewVertexGlobalDataBuffers[bufferSetIndex];
-	DynamicArray< RConstantBufferPtr >& rViewVertexBasePassDataBuffers = m_viewVertexBasePassDataBuffers[bufferSetIndex];
-	DynamicArray< RConstantBufferPtr >& rViewVertexScreenDataBuffers = m_viewVertexScreenDataBuffers[bufferSetIndex];
-	DynamicArray< RConstantBufferPtr >& rViewPixelBasePassDataBuffers = m_viewPixelBasePassDataBuffers[bufferSetIndex];
-	DynamicArray< RConstantBufferPtr >& rShadowViewVertexDataBuffers = m_shadowViewVertexDataBuffers[bufferSetIndex];
+	// Reset all constant ring buffer offsets from the previous frame.
+	size_t offsetCount = m_viewConstantBufferOffsets.GetSize();
+	if ( offsetCount < sceneViewCount )
+	{
+		ViewConstantBufferOffsets invalidOffsets;
+		MemorySet( &invalidOffsets, 0xff, sizeof( invalidOffsets ) );
+		m_viewConstantBufferOffsets.Add( invalidOffsets, sceneViewCount - offsetCount );
+	}
 
-	size_t sceneViewCount = m_sceneViews.GetSize();
-	size_t viewBufferCount = rViewVertexGlobalDataBuffers.GetSize();
-	HELIUM_ASSERT( rViewVertexBasePassDataBuffers.GetSize() == viewBufferCount );
-	HELIUM_ASSERT( rViewVertexScreenDataBuffers.GetSize() == viewBufferCount );
-	HELIUM_ASSERT( rViewPixelBasePassDataBuffers.GetSize() == viewBufferCount );
-	HELIUM_ASSERT( rShadowViewVertexDataBuffers.GetSize() == viewBufferCount );
-	if ( viewBufferCount < sceneViewCount )
+	MemorySet( m_viewConstantBufferOffsets.GetData(), 0xff, sceneViewCount * sizeof( ViewConstantBufferOffsets ) );
+
+	offsetCount = m_objectVertexGlobalDataOffsets.GetSize();
+	if ( offsetCount < sceneObjectCount )
+	{
+		m_objectVertexGlobalDataOffsets.Add( Invalid< uint32_t >(), sceneObjectCount - offsetCount );
+	}
+
+	MemorySet( m_objectVertexGlobalDataOffsets.GetData(), 0xff, sceneObjectCount * sizeof( uint32_t ) );
+
+	size_t mappedBufferCount = m_mappedObjectVertexGlobalDataBuffers.GetSize();
+	if ( mappedBufferCount < sceneObjectCount )
+	{
+		m_mappedObjectVertexGlobalDataBuffers.Add( NULL, sceneObjectCount - mappedBufferCount );
+	}
+
+	MemoryZero( m_mappedObjectVertexGlobalDataBuffers.GetData(), sceneObjectCount * sizeof( float32_t* ) );
+
+	offsetCount = m_subMeshVertexGlobalDataOffsets.GetSize();
+	if ( offsetCount < subMeshCount )
+	{
+		m_subMeshVertexGlobalDataOffsets.Add( Invalid< uint32_t >(), subMeshCount - offsetCount );
+	}
+
+	MemorySet( m_subMeshVertexGlobalDataOffsets.GetData(), 0xff, subMeshCount * sizeof( uint32_t ) );
+
+	mappedBufferCount = m_mappedSubMeshVertexGlobalDataBuffers.GetSize();
+	if ( mappedBufferCount < subMeshCount )
 	{
-		size_t additionalBufferCount = sceneViewCount - viewBufferCount;
-		rViewVertexGlobalDataBuffers.Add( NULL, additionalBufferCount );
-		rViewVertexBasePassDataBuffers.Add( NULL, additionalBufferCount );
-		rViewVertexScreenDataBuffers.Add( NULL, additionalBufferCount );
-		rViewPixelBasePassDataBuffers.Add( NULL, additionalBufferCount );
-		rShadowViewVertexDataBuffers.Add( NULL, additionalBufferCount );
+		m_mappedSubMeshVertexGlobalDataBuffers.Add( NULL, subMeshCount - mappedBufferCount );
 	}
 
+	MemoryZero( m_mappedSubMeshVertexGlobalDataBuffers.GetData(), subMeshCount * sizeof( float32_t* ) );
+
+	// Compute the amount of constant ring buffer space needed for the current frame.  View constants are allocated
+	// for each valid view, static mesh instance constants for each visible scene object, and skinned mesh instance
+	// constants for each visible skinned sub-mesh.  Instances needing constants are flagged with a zero offset until
+	// the actual allocations are made once the ring buffer is mapped.
+	size_t viewDataSize =
+		ConstantBufferRing::GetAllocationSize( VIEW_VERTEX_GLOBAL_DATA_SIZE ) +
+		ConstantBufferRing::GetAllocationSize( VIEW_VERTEX_BASE_PASS_DATA_SIZE ) +
+		ConstantBufferRing::GetAllocationSize( VIEW_VERTEX_SCREEN_DATA_SIZE ) +
+		ConstantBufferRing::GetAllocationSize( VIEW_PIXEL_BASE_PASS_DATA_SIZE ) +
+		ConstantBufferRing::GetAllocationSize( SHADOW_VIEW_VERTEX_DATA_SIZE );
+
+	size_t requiredSize = 0;
 	for ( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
 	{
-		if ( !m_sceneViews.IsElementValid( viewIndex ) )
+		if ( m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) )
 		{
-			continue;
+			requiredSize += viewDataSize;
 		}
+	}
 
-		// Update the global vertex shader constants.
-		RConstantBufferPtr spBuffer = rViewVertexGlobalDataBuffers[viewIndex];
-		if ( !spBuffer )
+	// Every sub-mesh drawn in a view is also in its shadow depth pass list, so the union of those lists covers all
+	// instances drawn this frame.
+	size_t visibilityCount = m_pRenderSnapshot->viewVisibility.GetSize();
+	for ( size_t viewIndex = 0; viewIndex < visibilityCount; ++viewIndex )
+	{
+		const DynamicArray< size_t >& rSubMeshIndices = m_pRenderSnapshot->viewVisibility[viewIndex].shadowSubMeshIds;
+		size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+		for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
 		{
-			spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 32, RENDERER_BUFFER_USAGE_DYNAMIC );
-			if ( !spBuffer )
+			size_t subMeshIndex = rSubMeshIndices[meshIndexIndex];
+			HELIUM_ASSERT( subMeshIndex < subMeshCount );
+
+			// Skip skinned sub-meshes already flagged for another view.
+			if ( IsValid( m_subMeshVertexGlobalDataOffsets[subMeshIndex] ) )
+			{
+				continue;
+			}
+
+			GraphicsSceneObject::SubMeshData& rSubMesh = m_pRenderSnapshot->sceneObjectSubMeshes[subMeshIndex];
+
+			size_t sceneObjectIndex = rSubMesh.GetSceneObjectId();
+			HELIUM_ASSERT( sceneObjectIndex < sceneObjectCount );
+
+			// If the main scene object for the sub mesh is already flagged, we know it is a static mesh that has
+			// already been processed, so we can skip it.
+			if ( IsValid( m_objectVertexGlobalDataOffsets[sceneObjectIndex] ) )
+			{
+				continue;
+			}
+
+			// Determine whether the object should be rendered as a static mesh (vertex constants per scene object) or
+			// skinned mesh (vertex constants per sub-mesh).
+			GraphicsSceneObject& rSceneObject = m_pRenderSnapshot->sceneObjects[sceneObjectIndex];
+
+			if ( rSceneObject.GetBoneCount() != 0 &&
+				rSceneObject.GetBonePalette() &&
+				rSubMesh.GetSkinningPaletteMap() )
 			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					"GraphicsScene::SwapDynamicConstantBuffers(): View vertex global data constant buffer creation failed!\n" );
+				m_subMeshVertexGlobalDataOffsets[subMeshIndex] = 0;
+				requiredSize += ConstantBufferRing::GetAllocationSize( SKINNED_INSTANCE_VERTEX_GLOBAL_DATA_SIZE );
 			}
+			else
+			{
+				m_objectVertexGlobalDataOffsets[sceneObjectIndex] = 0;
+				requiredSize += ConstantBufferRing::GetAllocationSize( STATIC_INSTANCE_VERTEX_GLOBAL_DATA_SIZE );
+			}
+		}
+	}
+
+	// Map the current frame's region of the constant ring buffer.
+	if ( !m_constantBufferRing.BeginFrame( requiredSize ) )
+	{
+		MemorySet( m_objectVertexGlobalDataOffsets.GetData(), 0xff, sceneObjectCount * sizeof( uint32_t ) );
+		MemorySet( m_subMeshVertexGlobalDataOffsets.GetData(), 0xff, subMeshCount * sizeof( uint32_t ) );
+
+		return;
+	}
 
-			rViewVertexGlobalDataBuffers[viewIndex] = spBuffer;
+	// Update view constants.
+	for ( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
+	{
+		if ( !m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) )
+		{
+			continue;
 		}
 
-		if ( spBuffer )
+		ViewConstantBufferOffsets offsets;
+		float32_t* pVertexGlobalData = static_cast<float32_t*>(
+			m_constantBufferRing.Allocate( VIEW_VERTEX_GLOBAL_DATA_SIZE, offsets.vertexGlobalData ) );
+		float32_t* pVertexBasePassData = static_cast<float32_t*>(
+			m_constantBufferRing.Allocate( VIEW_VERTEX_BASE_PASS_DATA_SIZE, offsets.vertexBasePassData ) );
+		float32_t* pVertexScreenData = static_cast<float32_t*>(
+			m_constantBufferRing.Allocate( VIEW_VERTEX_SCREEN_DATA_SIZE, offsets.vertexScreenData ) );
+		float32_t* pPixelBasePassData = static_cast<float32_t*>(
+			m_constantBufferRing.Allocate( VIEW_PIXEL_BASE_PASS_DATA_SIZE, offsets.pixelBasePassData ) );
+		float32_t* pShadowViewVertexData = static_cast<float32_t*>(
+			m_constantBufferRing.Allocate( SHADOW_VIEW_VERTEX_DATA_SIZE, offsets.shadowViewVertexData ) );
+		if ( !pVertexGlobalData ||
+			!pVertexBasePassData ||
+			!pVertexScreenData ||
+			!pPixelBasePassData ||
+			!pShadowViewVertexData )
 		{
-			float32_t* pMappedData = static_cast<float32_t*>( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
-			HELIUM_ASSERT( pMappedData );
+			continue;
+		}
 
-			GraphicsSceneView& rView = m_sceneViews[viewIndex];
-			const Simd::Matrix44& rInverseViewProjectionMatrix = rView.GetInverseViewProjectionMatrix();
-			const Simd::Matrix44& rInverseViewMatrix = rView.GetInverseViewMatrix();
+		m_viewConstantBufferOffsets[viewIndex] = offsets;
+
+		GraphicsSceneView& rView = m_pRenderSnapshot->sceneViews[viewIndex];
+		const Simd::Matrix44& rInverseViewProjectionMatrix = rView.GetInverseViewProjectionMatrix();
+		const Simd::Matrix44& rInverseViewMatrix = rView.GetInverseViewMatrix();
+
+		// Update the global vertex shader constants.
+		{
+			float32_t* pMappedData = pVertexGlobalData;
 
 			*( pMappedData++ ) = rInverseViewProjectionMatrix.GetElement( 0 );
 			*( pMappedData++ ) = rInverseViewProjectionMatrix.GetElement( 4 );
@@ -713,29 +1582,11 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 			*( pMappedData++ ) = rInverseViewMatrix.GetElement( 7 );
 			*( pMappedData++ ) = rInverseViewMatrix.GetElement( 11 );
 			*pMappedData = rInverseViewMatrix.GetElement( 15 );
-
-			spBuffer->Unmap();
 		}
 
 		// Update the base-pass vertex shader constants.
-		spBuffer = rViewVertexBasePassDataBuffers[viewIndex];
-		if ( !spBuffer )
-		{
-			spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 24, RENDERER_BUFFER_USAGE_DYNAMIC );
-			if ( !spBuffer )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					"GraphicsScene::SwapDynamicConstantBuffers(): View vertex base-pass data constant buffer creation failed!\n" );
-			}
-
-			rViewVertexBasePassDataBuffers[viewIndex] = spBuffer;
-		}
-
-		if ( spBuffer )
 		{
-			float32_t* pMappedData = static_cast<float32_t*>( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
-			HELIUM_ASSERT( pMappedData );
+			float32_t* pMappedData = pVertexBasePassData;
 
 			HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
 			Simd::Matrix44 shadowViewInvViewProj;
@@ -743,10 +1594,7 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 				m_shadowViewInverseViewProjectionMatrices[viewIndex],
 				shadowMapUvTransform );
 
-			GraphicsSceneView& rView = m_sceneViews[viewIndex];
-			const Simd::Matrix44& rInverseViewMatrix = rView.GetInverseViewMatrix();
-
-			Simd::Vector3 lightDir = -m_directionalLightDirection;
+			Simd::Vector3 lightDir = -m_pRenderSnapshot->directionalLightDirection;
 			lightDir = rInverseViewMatrix.TransformVector( lightDir );
 
 			*( pMappedData++ ) = shadowViewInvViewProj.GetElement( 0 );
@@ -775,37 +1623,15 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 			*( pMappedData++ ) = static_cast<float32_t>( rView.GetViewportHeight() ) * 0.5f;
 			*( pMappedData++ ) = 0.0f;
 			*pMappedData = 0.0f;
-
-			spBuffer->Unmap();
 		}
 
 		// Update the screen-space vertex shader constants.
-		spBuffer = rViewVertexScreenDataBuffers[viewIndex];
-		if ( !spBuffer )
 		{
-			spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 20, RENDERER_BUFFER_USAGE_DYNAMIC );
-			if ( !spBuffer )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					"GraphicsScene::SwapDynamicConstantBuffers(): View vertex screen-space data constant buffer creation failed!\n" );
-			}
-
-			rViewVertexScreenDataBuffers[viewIndex] = spBuffer;
-		}
-
-		if ( spBuffer )
-		{
-			float32_t* pMappedData = static_cast<float32_t*>( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
-			HELIUM_ASSERT( pMappedData );
-
-			GraphicsSceneView& rView = m_sceneViews[viewIndex];
+			float32_t* pMappedData = pVertexScreenData;
 
 			float32_t invWidth = 1.0f / static_cast<float32_t>( rView.GetViewportWidth() );
 			float32_t invHeight = 1.0f / static_cast<float32_t>( rView.GetViewportHeight() );
 
-			const Simd::Matrix44& rInverseViewProjectionMatrix = rView.GetInverseViewProjectionMatrix();
-
 			*( pMappedData++ ) = 2.0f * invWidth;
 			*( pMappedData++ ) = -2.0f * invHeight;
 			*( pMappedData++ ) = -1.0f - invWidth;
@@ -827,72 +1653,37 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 			*( pMappedData++ ) = rInverseViewProjectionMatrix.GetElement( 7 );
 			*( pMappedData++ ) = rInverseViewProjectionMatrix.GetElement( 11 );
 			*pMappedData = rInverseViewProjectionMatrix.GetElement( 15 );
-
-			spBuffer->Unmap();
 		}
 
 		// Update the base-pass pixel shader constants.
-		spBuffer = rViewPixelBasePassDataBuffers[viewIndex];
-		if ( !spBuffer )
-		{
-			spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 16, RENDERER_BUFFER_USAGE_DYNAMIC );
-			if ( !spBuffer )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					"GraphicsScene::SwapDynamicConstantBuffers(): View pixel base-pass data constant buffer creation failed!\n" );
-			}
-
-			rViewPixelBasePassDataBuffers[viewIndex] = spBuffer;
-		}
-
-		if ( spBuffer )
 		{
-			float32_t* pMappedData = static_cast<float32_t*>( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
-			HELIUM_ASSERT( pMappedData );
+			const RenderSnapshot& rSnapshot = *m_pRenderSnapshot;
+			float32_t* pMappedData = pPixelBasePassData;
 
-			*( pMappedData++ ) = m_ambientLightTopColor.GetFloatR() * m_ambientLightTopBrightness;
-			*( pMappedData++ ) = m_ambientLightTopColor.GetFloatG() * m_ambientLightTopBrightness;
-			*( pMappedData++ ) = m_ambientLightTopColor.GetFloatB() * m_ambientLightTopBrightness;
+			*( pMappedData++ ) = rSnapshot.ambientLightTopColor.GetFloatR() * rSnapshot.ambientLightTopBrightness;
+			*( pMappedData++ ) = rSnapshot.ambientLightTopColor.GetFloatG() * rSnapshot.ambientLightTopBrightness;
+			*( pMappedData++ ) = rSnapshot.ambientLightTopColor.GetFloatB() * rSnapshot.ambientLightTopBrightness;
 			*( pMappedData++ ) = 1.0f;
 
-			*( pMappedData++ ) = m_ambientLightBottomColor.GetFloatR() * m_ambientLightBottomBrightness;
-			*( pMappedData++ ) = m_ambientLightBottomColor.GetFloatG() * m_ambientLightBottomBrightness;
-			*( pMappedData++ ) = m_ambientLightBottomColor.GetFloatB() * m_ambientLightBottomBrightness;
+			*( pMappedData++ ) = rSnapshot.ambientLightBottomColor.GetFloatR() * rSnapshot.ambientLightBottomBrightness;
+			*( pMappedData++ ) = rSnapshot.ambientLightBottomColor.GetFloatG() * rSnapshot.ambientLightBottomBrightness;
+			*( pMappedData++ ) = rSnapshot.ambientLightBottomColor.GetFloatB() * rSnapshot.ambientLightBottomBrightness;
 			*( pMappedData++ ) = 1.0f;
 
-			*( pMappedData++ ) = m_directionalLightColor.GetFloatR() * m_directionalLightBrightness;
-			*( pMappedData++ ) = m_directionalLightColor.GetFloatG() * m_directionalLightBrightness;
-			*( pMappedData++ ) = m_directionalLightColor.GetFloatB() * m_directionalLightBrightness;
+			*( pMappedData++ ) = rSnapshot.directionalLightColor.GetFloatR() * rSnapshot.directionalLightBrightness;
+			*( pMappedData++ ) = rSnapshot.directionalLightColor.GetFloatG() * rSnapshot.directionalLightBrightness;
+			*( pMappedData++ ) = rSnapshot.directionalLightColor.GetFloatB() * rSnapshot.directionalLightBrightness;
 			*( pMappedData++ ) = 1.0f;
 
 			*( pMappedData++ ) = inverseShadowMapResolutionX;
 			*( pMappedData++ ) = inverseShadowMapResolutionY;
 			*( pMappedData++ ) = 0.0f;
 			*pMappedData = 0.0f;
-
-			spBuffer->Unmap();
 		}
 
 		// Update the shadow depth pass vertex shader constants.
-		spBuffer = rShadowViewVertexDataBuffers[viewIndex];
-		if ( !spBuffer )
-		{
-			spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 32, RENDERER_BUFFER_USAGE_DYNAMIC );
-			if ( !spBuffer )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					"GraphicsScene::SwapDynamicConstantBuffers(): Shadow view vertex data constant buffer creation failed!\n" );
-			}
-
-			rShadowViewVertexDataBuffers[viewIndex] = spBuffer;
-		}
-
-		if ( spBuffer )
 		{
-			float32_t* pMappedData = static_cast<float32_t*>( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
-			HELIUM_ASSERT( pMappedData );
+			float32_t* pMappedData = pShadowViewVertexData;
 
 			HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
 			const Simd::Matrix44& rShadowViewInvViewProj = m_shadowViewInverseViewProjectionMatrices[viewIndex];
@@ -913,215 +1704,103 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 			*( pMappedData++ ) = rShadowViewInvViewProj.GetElement( 7 );
 			*( pMappedData++ ) = rShadowViewInvViewProj.GetElement( 11 );
 			*pMappedData = rShadowViewInvViewProj.GetElement( 15 );
-
-			spBuffer->Unmap();
 		}
 	}
 
-	// Map each instance constant buffer for updating.
-	DynamicArray< RConstantBufferPtr >& rStaticInstanceVertexGlobalDataBufferPool =
-		m_staticInstanceVertexGlobalDataBufferPool[bufferSetIndex];
-	DynamicArray< RConstantBufferPtr >& rSkinnedInstanceVertexGlobalDataBufferPool =
-		m_skinnedInstanceVertexGlobalDataBufferPool[bufferSetIndex];
-	HELIUM_UNREF( rSkinnedInstanceVertexGlobalDataBufferPool );
-
-	size_t sceneObjectCount = m_sceneObjects.GetSize();
-	size_t instanceBufferCount = m_objectVertexGlobalDataBuffers.GetSize();
-	if ( instanceBufferCount < sceneObjectCount )
-	{
-		MemoryZero( m_objectVertexGlobalDataBuffers.GetData(), instanceBufferCount * sizeof( RConstantBuffer* ) );
-		m_objectVertexGlobalDataBuffers.Add( NULL, sceneObjectCount - instanceBufferCount );
-	}
-	else
-	{
-		MemoryZero( m_objectVertexGlobalDataBuffers.GetData(), sceneObjectCount * sizeof( RConstantBuffer* ) );
-	}
-
-	size_t mappedBufferCount = m_mappedObjectVertexGlobalDataBuffers.GetSize();
-	if ( mappedBufferCount < sceneObjectCount )
-	{
-		MemoryZero( m_mappedObjectVertexGlobalDataBuffers.GetData(), mappedBufferCount * sizeof( float32_t* ) );
-		m_mappedObjectVertexGlobalDataBuffers.Add( NULL, sceneObjectCount - mappedBufferCount );
-	}
-	else
-	{
-		MemoryZero( m_mappedObjectVertexGlobalDataBuffers.GetData(), sceneObjectCount * sizeof( float32_t* ) );
-	}
-
-	size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
-	instanceBufferCount = m_subMeshVertexGlobalDataBuffers.GetSize();
-	if ( instanceBufferCount < subMeshCount )
-	{
-		MemoryZero( m_subMeshVertexGlobalDataBuffers.GetData(), instanceBufferCount * sizeof( RConstantBuffer* ) );
-		m_subMeshVertexGlobalDataBuffers.Add( NULL, subMeshCount - instanceBufferCount );
-	}
-	else
-	{
-		MemoryZero( m_subMeshVertexGlobalDataBuffers.GetData(), subMeshCount * sizeof( RConstantBuffer* ) );
-	}
-
-	mappedBufferCount = m_mappedSubMeshVertexGlobalDataBuffers.GetSize();
-	if ( mappedBufferCount < subMeshCount )
-	{
-		MemoryZero( m_mappedSubMeshVertexGlobalDataBuffers.GetData(), mappedBufferCount * sizeof( float32_t* ) );
-		m_mappedSubMeshVertexGlobalDataBuffers.Add( NULL, subMeshCount - mappedBufferCount );
-	}
-	else
-	{
-		MemoryZero( m_mappedSubMeshVertexGlobalDataBuffers.GetData(), subMeshCount * sizeof( float32_t* ) );
-	}
-
-	size_t staticBufferIndex = 0;
-	size_t skinnedBufferIndex = 0;
-	HELIUM_UNREF( skinnedBufferIndex );
-
-	for ( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
+	// Allocate the instance constants flagged above.
+	for ( size_t objectIndex = 0; objectIndex < sceneObjectCount; ++objectIndex )
 	{
-		if ( !m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
-		{
-			continue;
-		}
-
-		GraphicsSceneObject::SubMeshData& rSubMesh = m_sceneObjectSubMeshes[subMeshIndex];
-
-		size_t sceneObjectIndex = rSubMesh.GetSceneObjectId();
-		HELIUM_ASSERT( sceneObjectIndex < sceneObjectCount );
-
-		// If the main scene object for the sub mesh already has a constant buffer assigned, we know it is a static
-		// mesh that has already been processed, so we can skip it.
-		if ( m_objectVertexGlobalDataBuffers[sceneObjectIndex] )
-		{
-			continue;
-		}
-
-		// Determine whether the object should be rendered as a static mesh (vertex constant buffer per scene
-		// object) or skinned mesh (vertex constant buffer per sub-mesh).
-		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectIndex ) );
-		GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectIndex];
-
-		RConstantBuffer* pBuffer = NULL;
-
-		uint_fast8_t boneCount = rSceneObject.GetBoneCount();
-		if ( boneCount != 0 )
+		uint32_t& rOffset = m_objectVertexGlobalDataOffsets[objectIndex];
+		if ( IsValid( rOffset ) )
 		{
-			const Simd::Matrix44* pBonePalette = rSceneObject.GetBonePalette();
-			if ( pBonePalette )
+			void* pMappedData = m_constantBufferRing.Allocate( STATIC_INSTANCE_VERTEX_GLOBAL_DATA_SIZE, rOffset );
+			if ( pMappedData )
 			{
-				const uint8_t* pSkinningPaletteMap = rSubMesh.GetSkinningPaletteMap();
-				if ( pSkinningPaletteMap )
-				{
-					RConstantBuffer* pBuffer;
-					if ( skinnedBufferIndex < rSkinnedInstanceVertexGlobalDataBufferPool.GetSize() )
-					{
-						pBuffer = rSkinnedInstanceVertexGlobalDataBufferPool[skinnedBufferIndex];
-						HELIUM_ASSERT( pBuffer );
-					}
-					else
-					{
-						HELIUM_ASSERT( skinnedBufferIndex == rSkinnedInstanceVertexGlobalDataBufferPool.GetSize() );
-
-						pBuffer = pRenderer->CreateConstantBuffer(
-							sizeof( float32_t ) * 12 * BONE_COUNT_MAX,
-							RENDERER_BUFFER_USAGE_DYNAMIC );
-						if ( !pBuffer )
-						{
-							HELIUM_TRACE(
-								TraceLevels::Error,
-								"GraphicsScene::SwapDynamicConstantBuffers(): Skinned mesh instance vertex constant global data buffer creation failed!\n" );
-						}
-						else
-						{
-							rSkinnedInstanceVertexGlobalDataBufferPool.Push( pBuffer );
-						}
-					}
-
-					if ( pBuffer )
-					{
-						++skinnedBufferIndex;
-
-						m_subMeshVertexGlobalDataBuffers[subMeshIndex] = pBuffer;
-
-						void* pMappedData = pBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD );
-						HELIUM_ASSERT( pMappedData );
-						m_mappedSubMeshVertexGlobalDataBuffers[subMeshIndex] =
-							static_cast<float32_t*>( pMappedData );
-
-						continue;
-					}
-				}
+				m_mappedObjectVertexGlobalDataBuffers[objectIndex] = static_cast<float32_t*>( pMappedData );
+			}
+			else
+			{
+				SetInvalid( rOffset );
 			}
 		}
+	}
 
-		// Instance data not mapped as a skinned mesh, so map as a static mesh.
-		if ( staticBufferIndex < rStaticInstanceVertexGlobalDataBufferPool.GetSize() )
-		{
-			pBuffer = rStaticInstanceVertexGlobalDataBufferPool[staticBufferIndex];
-			HELIUM_ASSERT( pBuffer );
-		}
-		else
+	for ( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
+	{
+		uint32_t& rOffset = m_subMeshVertexGlobalDataOffsets[subMeshIndex];
+		if ( IsValid( rOffset ) )
 		{
-			HELIUM_ASSERT( staticBufferIndex == rStaticInstanceVertexGlobalDataBufferPool.GetSize() );
-
-			pBuffer = pRenderer->CreateConstantBuffer(
-				sizeof( float32_t ) * 12,
-				RENDERER_BUFFER_USAGE_DYNAMIC );
-			if ( !pBuffer )
+			void* pMappedData = m_constantBufferRing.Allocate( SKINNED_INSTANCE_VERTEX_GLOBAL_DATA_SIZE, rOffset );
+			if ( pMappedData )
 			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					"GraphicsScene::SwapDynamicConstantBuffers(): Static mesh instance vertex constant global data buffer creation failed!\n" );
+				m_mappedSubMeshVertexGlobalDataBuffers[subMeshIndex] = static_cast<float32_t*>( pMappedData );
 			}
 			else
 			{
-				rStaticInstanceVertexGlobalDataBufferPool.Push( pBuffer );
+				SetInvalid( rOffset );
 			}
 		}
-
-		if ( pBuffer )
-		{
-			++staticBufferIndex;
-
-			m_objectVertexGlobalDataBuffers[sceneObjectIndex] = pBuffer;
-
-			void* pMappedData = pBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD );
-			HELIUM_ASSERT( pMappedData );
-			m_mappedObjectVertexGlobalDataBuffers[sceneObjectIndex] = static_cast<float32_t*>( pMappedData );
-		}
 	}
 
-	// Update each constant buffer in parallel.
+	// Update each instance's constants in parallel.
 	{
 		UpdateGraphicsSceneConstantBuffersJobSpawner job;
 		UpdateGraphicsSceneConstantBuffersJobSpawner::Parameters& rParameters = job.GetParameters();
 		rParameters.sceneObjectCount = static_cast<uint32_t>( sceneObjectCount );
 		rParameters.subMeshCount = static_cast<uint32_t>( subMeshCount );
-		rParameters.pSceneObjects = m_sceneObjects.GetData();
+		rParameters.pSceneObjects = m_pRenderSnapshot->sceneObjects.GetData();
 		rParameters.ppSceneObjectConstantBufferData = m_mappedObjectVertexGlobalDataBuffers.GetData();
-		rParameters.pSubMeshes = m_sceneObjectSubMeshes.GetData();
+		rParameters.pSubMeshes = m_pRenderSnapshot->sceneObjectSubMeshes.GetData();
 		rParameters.ppSubMeshConstantBufferData = m_mappedSubMeshVertexGlobalDataBuffers.GetData();
 		job.Run();
 	}
 
-	// Unmap the constant buffers.
-	for ( size_t objectIndex = 0; objectIndex < sceneObjectCount; ++objectIndex )
+	// Unmap the constant ring buffer.  The mapped addresses are no longer valid past this point.
+	m_constantBufferRing.EndFrame();
+}
+
+/// Get the constant ring buffer range holding the instance vertex shader constants for a given sub-mesh.
+///
+/// @param[in]  subMeshIndex   Index of the sub-mesh draw record in the render snapshot.
+/// @param[in]  sceneObjectId  Index of the draw record of the scene object to which the sub-mesh belongs.
+/// @param[out] rOffset        Byte offset of the instance constants in the constant ring buffer.
+/// @param[out] rSize          Size of the instance constants, in bytes.
+///
+/// @return  True if instance constants were allocated for the current frame, false if not.
+bool GraphicsScene::GetInstanceVertexGlobalDataRange(
+	size_t subMeshIndex,
+	size_t sceneObjectId,
+	uint32_t& rOffset,
+	uint32_t& rSize ) const
+{
+	if ( !m_constantBufferRing.GetBuffer() )
 	{
-		if ( m_mappedObjectVertexGlobalDataBuffers[objectIndex] )
-		{
-			RConstantBuffer* pBuffer = m_objectVertexGlobalDataBuffers[objectIndex];
-			HELIUM_ASSERT( pBuffer );
-			pBuffer->Unmap();
-		}
+		return false;
 	}
 
-	for ( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
+	// Skinned mesh constants are stored per sub-mesh, while static mesh constants are shared by all sub-meshes of the
+	// scene object.
+	HELIUM_ASSERT( subMeshIndex < m_subMeshVertexGlobalDataOffsets.GetSize() );
+	uint32_t offset = m_subMeshVertexGlobalDataOffsets[subMeshIndex];
+	if ( IsValid( offset ) )
 	{
-		if ( m_mappedSubMeshVertexGlobalDataBuffers[subMeshIndex] )
-		{
-			RConstantBuffer* pBuffer = m_subMeshVertexGlobalDataBuffers[subMeshIndex];
-			HELIUM_ASSERT( pBuffer );
-			pBuffer->Unmap();
-		}
+		rOffset = offset;
+		rSize = SKINNED_INSTANCE_VERTEX_GLOBAL_DATA_SIZE;
+
+		return true;
+	}
+
+	HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataOffsets.GetSize() );
+	offset = m_objectVertexGlobalDataOffsets[sceneObjectId];
+	if ( IsValid( offset ) )
+	{
+		rOffset = offset;
+		rSize = STATIC_INSTANCE_VERTEX_GLOBAL_DATA_SIZE;
+
+		return true;
 	}
+
+	return false;
 }
 
 /// Render the specified scene view.
@@ -1130,62 +1809,35 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 ///                       of the scene view sparse array).
 void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 {
-	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+	HELIUM_FRAME_ZONE( "GraphicsScene::DrawSceneView" );
 
-	if ( !m_sceneViews.IsElementValid( viewIndex ) )
+	HELIUM_ASSERT( viewIndex < m_pRenderSnapshot->sceneViews.GetSize() );
+
+	if ( !m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) )
 	{
 		return;
 	}
 
-	RConstantBuffer* pViewVertexGlobalDataBuffer =
-		m_viewVertexGlobalDataBuffers[m_constantBufferSetIndex][viewIndex];
-	if ( !pViewVertexGlobalDataBuffer )
+	// Make sure the view's shader constants were allocated for the current frame.
+	HELIUM_ASSERT( viewIndex < m_viewConstantBufferOffsets.GetSize() );
+	const ViewConstantBufferOffsets& rViewOffsets = m_viewConstantBufferOffsets[viewIndex];
+	RConstantBuffer* pViewConstantBuffer = m_constantBufferRing.GetBuffer();
+	if ( !pViewConstantBuffer || IsInvalid( rViewOffsets.vertexGlobalData ) )
 	{
 		return;
 	}
 
-	GraphicsSceneView& rView = m_sceneViews[viewIndex];
+	GraphicsSceneView& rView = m_pRenderSnapshot->sceneViews[viewIndex];
 	RRenderContext* pRenderContext = rView.GetRenderContext();
 	if ( !pRenderContext )
 	{
 		return;
 	}
 
-	// Determine which scene objects are visible in the current view.
-	m_visibleSceneObjects.UnsetAll();
-
-	const Simd::Frustum& rViewFrustum = rView.GetFrustum();
-
-	size_t sceneObjectCount = m_sceneObjects.GetSize();
-	for ( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
-	{
-		if ( m_sceneObjects.IsElementValid( sceneObjectIndex ) )
-		{
-			//const AaBox& rObjectBounds = m_sceneObjects[ sceneObjectIndex ].GetWorldBox();
-			const Simd::Sphere& rObjectBounds = m_sceneObjects[sceneObjectIndex].GetWorldSphere();
-			if ( rViewFrustum.Intersects( rObjectBounds ) )
-			{
-				m_visibleSceneObjects.SetElement( sceneObjectIndex );
-			}
-		}
-	}
-
-	// Build a list of indices for each visible sub-mesh for sorting.
-	m_sceneObjectSubMeshIndices.Resize( 0 );
-
-	size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
-	for ( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
-	{
-		if ( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
-		{
-			size_t sceneObjectId = m_sceneObjectSubMeshes[subMeshIndex].GetSceneObjectId();
-			HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
-			if ( m_visibleSceneObjects[sceneObjectId] )
-			{
-				m_sceneObjectSubMeshIndices.Push( subMeshIndex );
-			}
-		}
-	}
+	// Start with the sub-meshes within the view frustum, as captured on the game thread.
+	HELIUM_ASSERT( viewIndex < m_pRenderSnapshot->viewVisibility.GetSize() );
+	const ViewVisibility& rVisibility = m_pRenderSnapshot->viewVisibility[viewIndex];
+	m_sceneObjectSubMeshIndices = rVisibility.shadowSubMeshIds;
 
 	// Get the renderer interface and the main command proxy for the renderer.
 	Renderer* pRenderer = Renderer::GetInstance();
@@ -1215,6 +1867,10 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 	// Draw shadow depth pass (this will also set up the shadow depth scene as needed).
 	DrawShadowDepthPass( viewIndex );
 
+	// Switch to the sub-meshes not hidden behind occluders.  This is done after the shadow depth pass, as objects
+	// hidden from the view can still cast visible shadows.
+	m_sceneObjectSubMeshIndices = rVisibility.subMeshIds;
+
 	// Set up normal scene rendering.
 	RSurface* pDepthStencilSurface = rView.GetDepthStencilSurface();
 
@@ -1236,20 +1892,36 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 	spCommandProxy->Clear( RENDERER_CLEAR_FLAG_ALL, rView.GetClearColor() );
 
 	spCommandProxy->SetRasterizerState( pRasterizerStateDefault );
-	spCommandProxy->SetVertexConstantBuffers( 0, 1, &pViewVertexGlobalDataBuffer );
+	spCommandProxy->SetVertexConstantBuffers(
+		0,
+		1,
+		&pViewConstantBuffer,
+		NULL,
+		&rViewOffsets.vertexGlobalData,
+		&VIEW_VERTEX_GLOBAL_DATA_SIZE );
 
 	// Draw passes...
 	DrawDepthPrePass( viewIndex );
 	DrawBasePass( viewIndex );
 
+	// Draw batched sprites using the view's global vertex constants.
+	spCommandProxy->SetVertexConstantBuffers(
+		0,
+		1,
+		&pViewConstantBuffer,
+		NULL,
+		&rViewOffsets.vertexGlobalData,
+		&VIEW_VERTEX_GLOBAL_DATA_SIZE );
+	m_spriteBatcher.Draw( spCommandProxy, m_renderSnapshotIndex );
+
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 	// Draw buffered world-space draw calls for the current scene and view.
 	const Simd::Matrix44& rInverseViewProjectionMatrix = rView.GetInverseViewProjectionMatrix();
-	m_sceneBufferedDrawer.DrawWorldElements( rInverseViewProjectionMatrix );
+	m_sceneBufferedDrawers[m_renderSnapshotIndex].DrawWorldElements( rInverseViewProjectionMatrix );
 
-	if ( viewIndex < m_viewBufferedDrawers.GetSize() )
+	if ( viewIndex < m_pRenderSnapshot->viewBufferedDrawers.GetSize() )
 	{
-		BufferedDrawer* pDrawer = m_viewBufferedDrawers[viewIndex];
+		BufferedDrawer* pDrawer = m_pRenderSnapshot->viewBufferedDrawers[viewIndex];
 		if ( pDrawer )
 		{
 			pDrawer->DrawWorldElements( rInverseViewProjectionMatrix );
@@ -1315,35 +1987,952 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 	// Draw buffered screen-space draw calls for the current scene and view.
-	RConstantBuffer* pScreenSpaceVertexConstantBuffer =
-		m_viewVertexScreenDataBuffers[m_constantBufferSetIndex][viewIndex];
-	if ( pScreenSpaceVertexConstantBuffer )
 	{
-		spCommandProxy->SetVertexConstantBuffers( 0, 1, &pScreenSpaceVertexConstantBuffer );
+		spCommandProxy->SetVertexConstantBuffers(
+			0,
+			1,
+			&pViewConstantBuffer,
+			NULL,
+			&rViewOffsets.vertexScreenData,
+			&VIEW_VERTEX_SCREEN_DATA_SIZE );
 		spCommandProxy->SetRasterizerState( pRasterizerStateDefault );
 
 		RBlendState* pBlendStateTranslucent = pRenderResourceManager->GetBlendState(
 			RenderResourceManager::BLEND_STATE_TRANSPARENT );
 		spCommandProxy->SetBlendState( pBlendStateTranslucent );
 
-		m_sceneBufferedDrawer.DrawScreenElements();
+		m_sceneBufferedDrawers[m_renderSnapshotIndex].DrawScreenElements();
+
+		if ( viewIndex < m_pRenderSnapshot->viewBufferedDrawers.GetSize() )
+		{
+			BufferedDrawer* pDrawer = m_pRenderSnapshot->viewBufferedDrawers[viewIndex];
+			if ( pDrawer )
+			{
+				pDrawer->DrawScreenElements();
+			}
+		}
+	}
+#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+	spCommandProxy->EndScene();
+
+	spCommandProxy->UnbindResources();
+
+	pRenderContext->Swap();
+}
+
+/// Capture the scene state needed to render the current frame.
+///
+/// Scene objects are culled against each scene view to be rendered and the texture mip levels needed for the visible
+/// sub-meshes are requested from the texture streaming manager here, on the game thread, so that rendering only
+/// needs to read the captured snapshot.  Only the visible sub-meshes and their scene objects are captured (see
+/// CaptureDrawRecords()); scene views are few, so they are copied in full.
+///
+/// @param[out] rSnapshot  Snapshot in which to store the captured state.  This must not be in use by the renderer.
+void GraphicsScene::CaptureRenderSnapshot( RenderSnapshot& rSnapshot )
+{
+	HELIUM_FRAME_ZONE( "GraphicsScene::CaptureRenderSnapshot" );
+
+	rSnapshot.sceneViews = m_sceneViews;
+
+	rSnapshot.directionalLightDirection = m_directionalLightDirection;
+	rSnapshot.directionalLightColor = m_directionalLightColor;
+	rSnapshot.directionalLightBrightness = m_directionalLightBrightness;
+	rSnapshot.ambientLightTopColor = m_ambientLightTopColor;
+	rSnapshot.ambientLightTopBrightness = m_ambientLightTopBrightness;
+	rSnapshot.ambientLightBottomColor = m_ambientLightBottomColor;
+	rSnapshot.ambientLightBottomBrightness = m_ambientLightBottomBrightness;
+	rSnapshot.activeViewId = m_activeViewId;
+
+#if GRAPHICS_SCENE_BUFFERED_DRAWER
+	rSnapshot.viewBufferedDrawers = m_viewBufferedDrawers[m_renderSnapshotIndex ^ 1];
+#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+	// Resize the visible object bit array as necessary.
+	size_t sceneObjectCount = m_sceneObjects.GetSize();
+	m_visibleSceneObjects.Reserve( sceneObjectCount );
+	m_visibleSceneObjects.Resize( sceneObjectCount );
+
+	// Determine the visible sub-meshes in each scene view that will be rendered.
+	size_t sceneViewCount = m_sceneViews.GetSize();
+	rSnapshot.viewVisibility.Resize( sceneViewCount );
+	for ( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
+	{
+		ViewVisibility& rVisibility = rSnapshot.viewVisibility[viewIndex];
+		rVisibility.shadowSubMeshIds.Resize( 0 );
+		rVisibility.subMeshIds.Resize( 0 );
+
+		if ( !m_sceneViews.IsElementValid( viewIndex ) ||
+			( m_activeViewId != Invalid< uint32_t >() && viewIndex != m_activeViewId ) )
+		{
+			continue;
+		}
+
+		CaptureSceneViewVisibility( static_cast<uint_fast32_t>( viewIndex ), rVisibility );
+	}
+
+	CaptureDrawRecords( rSnapshot );
+}
+
+/// Determine the sub-meshes visible in a given scene view.
+///
+/// @param[in]  viewIndex    Index of a valid scene view.
+/// @param[out] rVisibility  Visible sub-mesh lists.
+void GraphicsScene::CaptureSceneViewVisibility( uint_fast32_t viewIndex, ViewVisibility& rVisibility )
+{
+	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+
+	// Determine which scene objects are visible in the view.
+	CullSceneObjects( m_sceneViews[viewIndex].GetFrustum() );
+	GatherVisibleSubMeshes( rVisibility.shadowSubMeshIds );
+
+	// Let the texture streaming manager know what texture detail is needed for the visible sub-meshes.
+	RequestTextureMipLevels( viewIndex, rVisibility.shadowSubMeshIds );
+
+	// Remove scene objects hidden behind occluders for all passes except the shadow depth pass, as objects hidden
+	// from the view can still cast visible shadows.
+	if ( CullOccludedSceneObjects( viewIndex ) )
+	{
+		GatherVisibleSubMeshes( rVisibility.subMeshIds );
+	}
+	else
+	{
+		rVisibility.subMeshIds = rVisibility.shadowSubMeshIds;
+	}
+}
+
+/// Build a list of indices for each visible sub-mesh by walking the sub-mesh list of each visible scene object.
+///
+/// @param[out] rSubMeshIds  Visible sub-mesh IDs.
+///
+/// @see CullSceneObjects()
+void GraphicsScene::GatherVisibleSubMeshes( DynamicArray< size_t >& rSubMeshIds ) const
+{
+	rSubMeshIds.Resize( 0 );
+
+	size_t visibleSceneObjectCount = m_visibleSceneObjectIds.GetSize();
+	for ( size_t visibleIndex = 0; visibleIndex < visibleSceneObjectCount; ++visibleIndex )
+	{
+		size_t sceneObjectId = m_visibleSceneObjectIds[visibleIndex];
+		HELIUM_ASSERT( sceneObjectId < m_sceneObjectFirstSubMeshIds.GetSize() );
+
+		size_t subMeshIndex = m_sceneObjectFirstSubMeshIds[sceneObjectId];
+		while ( IsValid( subMeshIndex ) )
+		{
+			HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) );
+			rSubMeshIds.Push( subMeshIndex );
+
+			subMeshIndex = m_nextSubMeshIds[subMeshIndex];
+		}
+	}
+}
+
+/// Copy the sub-meshes visible in any view of a render snapshot, along with their scene objects, into the snapshot's
+/// draw records, and replace the sub-mesh IDs in each view's visible sub-mesh lists with draw record indices.
+///
+/// Draw records are reused between captures, and resource references are only reassigned when they change, so that
+/// capturing an unchanged scene does not touch any reference counts.
+///
+/// @param[in,out] rSnapshot  Snapshot whose visible sub-mesh lists have been captured.
+void GraphicsScene::CaptureDrawRecords( RenderSnapshot& rSnapshot )
+{
+	size_t sceneObjectCount = m_sceneObjects.GetSize();
+	size_t recordIndexCount = m_sceneObjectRecordIndices.GetSize();
+	if ( recordIndexCount < sceneObjectCount )
+	{
+		m_sceneObjectRecordIndices.Add( Invalid< size_t >(), sceneObjectCount - recordIndexCount );
+	}
+
+	size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
+	recordIndexCount = m_subMeshRecordIndices.GetSize();
+	if ( recordIndexCount < subMeshCount )
+	{
+		m_subMeshRecordIndices.Add( Invalid< size_t >(), subMeshCount - recordIndexCount );
+	}
+
+	m_recordSceneObjectIds.Resize( 0 );
+	m_recordSubMeshIds.Resize( 0 );
+
+	size_t bonePaletteSize = 0;
+	size_t viewCount = rSnapshot.viewVisibility.GetSize();
+	for ( size_t viewIndex = 0; viewIndex < viewCount; ++viewIndex )
+	{
+		ViewVisibility& rVisibility = rSnapshot.viewVisibility[viewIndex];
+		bonePaletteSize += AssignDrawRecords( rVisibility.shadowSubMeshIds );
+		bonePaletteSize += AssignDrawRecords( rVisibility.subMeshIds );
+	}
+
+	// Copy the sub-mesh data, pointing each record at the record of its scene object.
+	size_t subMeshRecordCount = m_recordSubMeshIds.GetSize();
+	rSnapshot.sceneObjectSubMeshes.Resize( subMeshRecordCount );
+	for ( size_t recordIndex = 0; recordIndex < subMeshRecordCount; ++recordIndex )
+	{
+		size_t subMeshId = m_recordSubMeshIds[recordIndex];
+		SetInvalid( m_subMeshRecordIndices[subMeshId] );
+
+		const GraphicsSceneObject::SubMeshData& rSubMesh = m_sceneObjectSubMeshes[subMeshId];
+		GraphicsSceneObject::SubMeshData& rRecord = rSnapshot.sceneObjectSubMeshes[recordIndex];
+
+		rRecord.m_sceneObjectId = m_sceneObjectRecordIndices[rSubMesh.GetSceneObjectId()];
+		HELIUM_ASSERT( rRecord.m_sceneObjectId < m_recordSceneObjectIds.GetSize() );
+
+		if ( rRecord.GetMaterial().Get() != rSubMesh.GetMaterial().Get() )
+		{
+			rRecord.SetMaterial( rSubMesh.GetMaterial() );
+		}
+
+		rRecord.SetSkinningPaletteMap( rSubMesh.GetSkinningPaletteMap() );
+		rRecord.SetPrimitiveType( rSubMesh.GetPrimitiveType() );
+		rRecord.SetPrimitiveCount( rSubMesh.GetPrimitiveCount() );
+		rRecord.SetStartVertex( rSubMesh.GetStartVertex() );
+		rRecord.SetVertexRange( rSubMesh.GetVertexRange() );
+		rRecord.SetStartIndex( rSubMesh.GetStartIndex() );
+	}
+
+	// Copy the scene objects.  Bone palettes are owned by the animation code and may change during the next frame, so
+	// copy them into the snapshot as well and point the captured scene objects at the copies.
+	size_t objectRecordCount = m_recordSceneObjectIds.GetSize();
+	rSnapshot.sceneObjects.Resize( objectRecordCount );
+	rSnapshot.bonePalettes.Resize( bonePaletteSize );
+
+	size_t bonePaletteOffset = 0;
+	for ( size_t recordIndex = 0; recordIndex < objectRecordCount; ++recordIndex )
+	{
+		size_t sceneObjectId = m_recordSceneObjectIds[recordIndex];
+		SetInvalid( m_sceneObjectRecordIndices[sceneObjectId] );
+
+		const GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+		GraphicsSceneObject& rRecord = rSnapshot.sceneObjects[recordIndex];
+
+		rRecord.SetTransform( rSceneObject.GetTransform() );
+
+		if ( rRecord.GetVertexBuffer() != rSceneObject.GetVertexBuffer() ||
+			rRecord.GetVertexDescription() != rSceneObject.GetVertexDescription() ||
+			rRecord.GetVertexStride() != rSceneObject.GetVertexStride() )
+		{
+			rRecord.SetVertexData(
+				rSceneObject.GetVertexBuffer(),
+				rSceneObject.GetVertexDescription(),
+				rSceneObject.GetVertexStride() );
+		}
+
+		if ( rRecord.GetIndexBuffer() != rSceneObject.GetIndexBuffer() )
+		{
+			rRecord.SetIndexBuffer( rSceneObject.GetIndexBuffer() );
+		}
+
+		uint8_t boneCount = rSceneObject.GetBoneCount();
+#if HELIUM_USE_GRANNY_ANIMATION
+		rRecord.SetBoneData( rSceneObject.GetBoneData(), boneCount );
+#else
+		rRecord.SetBoneData( rSceneObject.GetInverseReferencePose(), boneCount );
+#endif
+
+		const Simd::Matrix44* pBonePalette = rSceneObject.GetBonePalette();
+		if ( !pBonePalette )
+		{
+			rRecord.SetBonePalette( NULL );
+
+			continue;
+		}
+
+		Simd::Matrix44* pBonePaletteCopy = rSnapshot.bonePalettes.GetData() + bonePaletteOffset;
+		MemoryCopy( pBonePaletteCopy, pBonePalette, sizeof( Simd::Matrix44 ) * boneCount );
+		rRecord.SetBonePalette( pBonePaletteCopy );
+
+		bonePaletteOffset += boneCount;
+	}
+
+	HELIUM_ASSERT( bonePaletteOffset == bonePaletteSize );
+}
+
+/// Replace the sub-mesh IDs in a visible sub-mesh list with render snapshot draw record indices, assigning a new draw
+/// record to each sub-mesh and scene object not yet captured.
+///
+/// @param[in,out] rSubMeshIds  Visible sub-mesh IDs, replaced by draw record indices.
+///
+/// @return  Number of bone palette entries needed by the newly assigned scene object records.
+///
+/// @see CaptureDrawRecords()
+size_t GraphicsScene::AssignDrawRecords( DynamicArray< size_t >& rSubMeshIds )
+{
+	size_t bonePaletteSize = 0;
+
+	size_t subMeshIdCount = rSubMeshIds.GetSize();
+	for ( size_t subMeshIdIndex = 0; subMeshIdIndex < subMeshIdCount; ++subMeshIdIndex )
+	{
+		size_t subMeshId = rSubMeshIds[subMeshIdIndex];
+		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( subMeshId ) );
+
+		size_t& rSubMeshRecordIndex = m_subMeshRecordIndices[subMeshId];
+		if ( IsInvalid( rSubMeshRecordIndex ) )
+		{
+			rSubMeshRecordIndex = m_recordSubMeshIds.GetSize();
+			m_recordSubMeshIds.Push( subMeshId );
+
+			size_t sceneObjectId = m_sceneObjectSubMeshes[subMeshId].GetSceneObjectId();
+			HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+
+			size_t& rSceneObjectRecordIndex = m_sceneObjectRecordIndices[sceneObjectId];
+			if ( IsInvalid( rSceneObjectRecordIndex ) )
+			{
+				rSceneObjectRecordIndex = m_recordSceneObjectIds.GetSize();
+				m_recordSceneObjectIds.Push( sceneObjectId );
+
+				const GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+				if ( rSceneObject.GetBonePalette() )
+				{
+					bonePaletteSize += rSceneObject.GetBoneCount();
+				}
+			}
+		}
+
+		rSubMeshIds[subMeshIdIndex] = rSubMeshRecordIndex;
+	}
+
+	return bonePaletteSize;
+}
+
+/// Store the bounding sphere for the scene object in a given culling slot.
+///
+/// @param[in] slotIndex  Culling slot index.
+/// @param[in] rSphere    World-space bounding sphere.
+///
+/// @see CullSceneObjects()
+void GraphicsScene::SetCullSlotSphere( size_t slotIndex, const Simd::Sphere& rSphere )
+{
+	HELIUM_ASSERT( slotIndex / CULL_BLOCK_SPHERE_COUNT < m_cullBlocks.GetSize() );
+
+	CullBlock& rBlock = m_cullBlocks[slotIndex / CULL_BLOCK_SPHERE_COUNT];
+	size_t laneIndex = slotIndex % CULL_BLOCK_SPHERE_COUNT;
+
+	rBlock.centerX[laneIndex] = rSphere.GetElement( 0 );
+	rBlock.centerY[laneIndex] = rSphere.GetElement( 1 );
+	rBlock.centerZ[laneIndex] = rSphere.GetElement( 2 );
+	rBlock.radius[laneIndex] = rSphere.GetElement( 3 );
+}
+
+/// Flag the scene objects whose bounds intersect a given view frustum in the visible scene object array and build the
+/// list of visible scene object IDs.
+///
+/// The scene object bounding volume hierarchy is queried first.  Objects in subtrees entirely inside the frustum are
+/// flagged without further testing, while the bounding spheres of objects only partially intersecting the frustum
+/// are gathered and tested against the frustum planes a full culling block at a time.
+///
+/// @param[in] rFrustum  World-space view frustum.
+///
+/// @see SetCullSlotSphere()
+void GraphicsScene::CullSceneObjects( const Simd::Frustum& rFrustum )
+{
+	m_visibleSceneObjects.UnsetAll();
+	m_visibleSceneObjectIds.Resize( 0 );
+
+	m_containedSceneObjectIds.Resize( 0 );
+	m_intersectingSceneObjectIds.Resize( 0 );
+	m_sceneObjectTree.QueryFrustum( rFrustum, m_containedSceneObjectIds, m_intersectingSceneObjectIds );
+
+	size_t containedCount = m_containedSceneObjectIds.GetSize();
+	for ( size_t containedIndex = 0; containedIndex < containedCount; ++containedIndex )
+	{
+		size_t sceneObjectId = m_containedSceneObjectIds[containedIndex];
+		HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
+		m_visibleSceneObjects.SetElement( sceneObjectId );
+		m_visibleSceneObjectIds.Push( sceneObjectId );
+	}
+
+	size_t intersectingCount = m_intersectingSceneObjectIds.GetSize();
+
+	CullBlock gatherBlock;
+	Simd::Vector3Soa centers;
+	for ( size_t baseIndex = 0; baseIndex < intersectingCount; baseIndex += CULL_BLOCK_SPHERE_COUNT )
+	{
+		// Gather the spheres for the next set of objects, padding unused lanes with spheres that are never visible.
+		size_t laneCount = Min( intersectingCount - baseIndex, CULL_BLOCK_SPHERE_COUNT );
+		for ( size_t laneIndex = 0; laneIndex < CULL_BLOCK_SPHERE_COUNT; ++laneIndex )
+		{
+			if ( laneIndex < laneCount )
+			{
+				size_t sceneObjectId = m_intersectingSceneObjectIds[baseIndex + laneIndex];
+				HELIUM_ASSERT( sceneObjectId < m_sceneObjectCullSlots.GetSize() );
+				size_t slotIndex = m_sceneObjectCullSlots[sceneObjectId];
+				const CullBlock& rBlock = m_cullBlocks[slotIndex / CULL_BLOCK_SPHERE_COUNT];
+				size_t slotLaneIndex = slotIndex % CULL_BLOCK_SPHERE_COUNT;
+
+				gatherBlock.centerX[laneIndex] = rBlock.centerX[slotLaneIndex];
+				gatherBlock.centerY[laneIndex] = rBlock.centerY[slotLaneIndex];
+				gatherBlock.centerZ[laneIndex] = rBlock.centerZ[slotLaneIndex];
+				gatherBlock.radius[laneIndex] = rBlock.radius[slotLaneIndex];
+			}
+			else
+			{
+				gatherBlock.centerX[laneIndex] = 0.0f;
+				gatherBlock.centerY[laneIndex] = 0.0f;
+				gatherBlock.centerZ[laneIndex] = 0.0f;
+				gatherBlock.radius[laneIndex] = UNSET_BOUNDS_SPHERE_RADIUS;
+			}
+		}
+
+		centers.Load( gatherBlock.centerX, gatherBlock.centerY, gatherBlock.centerZ );
+		Simd::Register radii = Simd::LoadAligned( gatherBlock.radius );
+
+		uint32_t visibleMask = rFrustum.IntersectsSpheres( centers, radii );
+		for ( size_t laneIndex = 0; laneIndex < laneCount; ++laneIndex )
+		{
+			if ( visibleMask & ( 1 << laneIndex ) )
+			{
+				size_t sceneObjectId = m_intersectingSceneObjectIds[baseIndex + laneIndex];
+				HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
+				m_visibleSceneObjects.SetElement( sceneObjectId );
+				m_visibleSceneObjectIds.Push( sceneObjectId );
+			}
+		}
+	}
+}
+
+/// Remove scene objects hidden behind occluders from the visible scene object list.
+///
+/// All occluders are rasterized into the occlusion buffer using the view and projection of the given scene view, and
+/// the world bounds of each visible scene object are then tested against the buffer.
+///
+/// - The m_visibleSceneObjects and m_visibleSceneObjectIds arrays should already be prepared with the scene objects
+///   within the view frustum.
+///
+/// @param[in] viewIndex  Index of the scene view being captured.
+///
+/// @return  True if any scene objects were removed, false if not.
+bool GraphicsScene::CullOccludedSceneObjects( uint_fast32_t viewIndex )
+{
+	if ( !m_bOcclusionCulling || m_occluders.GetSize() == 0 || m_visibleSceneObjectIds.IsEmpty() )
+	{
+		return false;
+	}
+
+	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+	const GraphicsSceneView& rView = m_sceneViews[viewIndex];
+
+	Simd::Matrix44 viewProjection;
+	viewProjection.MultiplySet( rView.GetViewMatrix(), rView.GetProjectionMatrix() );
+
+	m_occlusionBuffer.Clear( viewProjection );
+
+	size_t occluderCount = m_occluders.GetSize();
+	for ( size_t occluderIndex = 0; occluderIndex < occluderCount; ++occluderIndex )
+	{
+		if ( !m_occluders.IsElementValid( occluderIndex ) )
+		{
+			continue;
+		}
+
+		const Occluder& rOccluder = m_occluders[occluderIndex];
+		m_occlusionBuffer.RasterizeOccluder(
+			rOccluder.transform,
+			rOccluder.vertices.GetData(),
+			static_cast< uint32_t >( rOccluder.vertices.GetSize() / 3 ),
+			rOccluder.indices.GetData(),
+			static_cast< uint32_t >( rOccluder.indices.GetSize() / 3 ) );
+	}
+
+	if ( m_occlusionBuffer.GetRasterizedTriangleCount() == 0 )
+	{
+		return false;
+	}
+
+	m_occlusionBuffer.BuildHierarchy();
+
+	// Test each visible scene object, compacting the list of visible scene objects in place.
+	size_t visibleSceneObjectCount = m_visibleSceneObjectIds.GetSize();
+	size_t keptSceneObjectCount = 0;
+	for ( size_t visibleIndex = 0; visibleIndex < visibleSceneObjectCount; ++visibleIndex )
+	{
+		size_t sceneObjectId = m_visibleSceneObjectIds[visibleIndex];
+		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+
+		if ( m_occlusionBuffer.IsBoxOccluded( m_sceneObjects[sceneObjectId].GetWorldBox() ) )
+		{
+			m_visibleSceneObjects.UnsetElement( sceneObjectId );
+		}
+		else
+		{
+			m_visibleSceneObjectIds[keptSceneObjectCount] = sceneObjectId;
+			++keptSceneObjectCount;
+		}
+	}
+
+	if ( keptSceneObjectCount == visibleSceneObjectCount )
+	{
+		return false;
+	}
+
+	m_visibleSceneObjectIds.Resize( keptSceneObjectCount );
+
+	return true;
+}
+
+/// Resolve the shader variants of the materials of all sub-meshes to be drawn in the base pass of a captured snapshot.
+///
+/// Materials only pick up shader variants loaded on demand through the shader variant cache here, so that drawing
+/// never modifies a material or the cache.  This must not be called while the snapshot's frame is being rendered.
+///
+/// @param[in] rSnapshot  Captured render snapshot.
+///
+/// @see Material::ResolveShaderVariants()
+void GraphicsScene::ResolveMaterialShaderVariants( const RenderSnapshot& rSnapshot )
+{
+	size_t viewCount = rSnapshot.viewVisibility.GetSize();
+	for ( size_t viewIndex = 0; viewIndex < viewCount; ++viewIndex )
+	{
+		const DynamicArray< size_t >& rSubMeshIndices = rSnapshot.viewVisibility[viewIndex].subMeshIds;
+		size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+		for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+		{
+			size_t meshIndex = rSubMeshIndices[meshIndexIndex];
+			HELIUM_ASSERT( meshIndex < rSnapshot.sceneObjectSubMeshes.GetSize() );
+
+			Material* pMaterial = rSnapshot.sceneObjectSubMeshes[meshIndex].GetMaterial();
+			if ( pMaterial )
+			{
+				pMaterial->ResolveShaderVariants();
+			}
+		}
+	}
+}
+
+/// Request the texture mip levels needed for rendering the visible sub-meshes in the specified scene view.
+///
+/// The on-screen size of each sub-mesh is estimated from the projected size of its scene object's bounding sphere,
+/// assuming each texture is mapped once across the object.
+///
+/// @param[in] viewIndex    Index of the scene view being captured.
+/// @param[in] rSubMeshIds  IDs of the sub-meshes visible in the scene view.
+void GraphicsScene::RequestTextureMipLevels( uint_fast32_t viewIndex, const DynamicArray< size_t >& rSubMeshIds )
+{
+	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+
+	TextureStreamingManager* pTextureStreamingManager = TextureStreamingManager::GetInstance();
+	if ( !pTextureStreamingManager )
+	{
+		return;
+	}
+
+	GraphicsSceneView& rView = m_sceneViews[viewIndex];
+	const Simd::Vector3& rViewOrigin = rView.GetOrigin();
+
+	// Scale from the ratio of an object's diameter to its distance from the camera to its size in pixels.
+	float32_t projectionScale = rView.GetProjectionMatrix().GetElement( 5 ) *
+		static_cast<float32_t>( rView.GetViewportHeight() ) * 0.5f;
+
+	size_t subMeshIndexCount = rSubMeshIds.GetSize();
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		size_t meshIndex = rSubMeshIds[meshIndexIndex];
+		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
+
+		GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[meshIndex];
+
+		Material* pMaterial = rSubMeshData.GetMaterial();
+		if ( !pMaterial )
+		{
+			continue;
+		}
+
+		size_t materialTextureCount = pMaterial->GetTextureParameterCount();
+		if ( materialTextureCount == 0 )
+		{
+			continue;
+		}
+
+		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+
+		const Simd::Sphere& rObjectBounds = m_sceneObjects[sceneObjectId].GetWorldSphere();
+		Simd::Vector3 objectCenter(
+			rObjectBounds.GetElement( 0 ),
+			rObjectBounds.GetElement( 1 ),
+			rObjectBounds.GetElement( 2 ) );
+		float32_t objectRadius = rObjectBounds.GetElement( 3 );
+
+		// Use the distance to the nearest point on the bounding sphere, requesting full detail if the camera is
+		// inside it.
+		float32_t distance = ( objectCenter - rViewOrigin ).GetMagnitude() - objectRadius;
+		bool bFullDetail = ( distance <= HELIUM_EPSILON );
+		float32_t screenSize = ( bFullDetail ? 0.0f : 2.0f * objectRadius * projectionScale / distance );
+
+		for ( size_t materialTextureIndex = 0; materialTextureIndex < materialTextureCount; ++materialTextureIndex )
+		{
+			const Material::TextureParameter& rTextureParameter = pMaterial->GetTextureParameter(
+				materialTextureIndex );
+			Texture2d* pTexture2d = Reflect::SafeCast< Texture2d >( rTextureParameter.value.Get() );
+			if ( !pTexture2d )
+			{
+				continue;
+			}
+
+			uint32_t mipIndex = 0;
+			if ( !bFullDetail )
+			{
+				mipIndex = TextureStreamingManager::ComputeMipIndex(
+					Max( pTexture2d->GetWidth(), pTexture2d->GetHeight() ),
+					pTexture2d->GetMipCount(),
+					screenSize );
+			}
+
+			pTextureStreamingManager->RequestMipLevel( pTexture2d, mipIndex );
+		}
+	}
+}
+
+/// Compute the view depth of each visible sub-mesh along a given direction for building sort keys.
+///
+/// Depths are stored in m_subMeshSortDepths, in the same order as m_sceneObjectSubMeshIndices.
+///
+/// @param[in]  rDirection   World-space direction along which to measure depth.
+/// @param[out] rMinDepth    Smallest depth of all visible sub-meshes.
+/// @param[out] rDepthScale  Scale to apply to depths offset by the minimum depth in order to map them to the range
+///                          [0, 1].
+void GraphicsScene::ComputeSubMeshSortDepths(
+	const Simd::Vector3& rDirection,
+	float32_t& rMinDepth,
+	float32_t& rDepthScale )
+{
+	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+	m_subMeshSortDepths.Resize( subMeshIndexCount );
+
+	float32_t minDepth = 0.0f;
+	float32_t maxDepth = 0.0f;
+
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
+		HELIUM_ASSERT( meshIndex < m_pRenderSnapshot->sceneObjectSubMeshes.GetSize() );
+
+		size_t sceneObjectId = m_pRenderSnapshot->sceneObjectSubMeshes[meshIndex].GetSceneObjectId();
+		HELIUM_ASSERT( sceneObjectId < m_pRenderSnapshot->sceneObjects.GetSize() );
+
+		const Simd::Matrix44& rTransform = m_pRenderSnapshot->sceneObjects[sceneObjectId].GetTransform();
+		Simd::Vector3 position = Simd::Vector4ToVector3( rTransform.GetRow( 3 ) );
+		float32_t depth = position.Dot( rDirection );
+		m_subMeshSortDepths[meshIndexIndex] = depth;
+
+		if ( meshIndexIndex == 0 )
+		{
+			minDepth = depth;
+			maxDepth = depth;
+		}
+		else
+		{
+			minDepth = Min( minDepth, depth );
+			maxDepth = Max( maxDepth, depth );
+		}
+	}
+
+	rMinDepth = minDepth;
+	rDepthScale = ( maxDepth > minDepth ? 1.0f / ( maxDepth - minDepth ) : 0.0f );
+}
+
+/// Sort the visible sub-mesh list from front to back along a given direction.
+///
+/// Sort keys hold (from the most significant bits down) the render pass, the quantized depth, the mesh vertex buffer,
+/// and the sub-mesh ID.  Depth is quantized more coarsely for the depth-only pre-pass so that instances of the same
+/// mesh at similar depths are grouped together.
+///
+/// @param[in] pass        Render pass for which sub-meshes are being sorted.
+/// @param[in] rDirection  World-space direction along which to sort.
+///
+/// @see SortSubMeshesByMaterial()
+void GraphicsScene::SortSubMeshesFrontToBack( ESortKeyPass pass, const Simd::Vector3& rDirection )
+{
+	float32_t minDepth, depthScale;
+	ComputeSubMeshSortDepths( rDirection, minDepth, depthScale );
+
+	const uint32_t meshShift = SORT_KEY_SUB_MESH_BIT_COUNT;
+	const uint32_t depthShift = meshShift + SORT_KEY_FRONT_TO_BACK_MESH_BIT_COUNT;
+	const uint32_t passShift = depthShift + SORT_KEY_FRONT_TO_BACK_DEPTH_BIT_COUNT;
+	HELIUM_COMPILE_ASSERT(
+		SORT_KEY_SUB_MESH_BIT_COUNT + SORT_KEY_FRONT_TO_BACK_MESH_BIT_COUNT + SORT_KEY_FRONT_TO_BACK_DEPTH_BIT_COUNT +
+		SORT_KEY_PASS_BIT_COUNT == 64 );
+
+	uint32_t depthBitCount =
+		( pass == SORT_KEY_PASS_DEPTH_PRE_PASS ? SORT_KEY_PRE_PASS_DEPTH_BIT_COUNT : SORT_KEY_FRONT_TO_BACK_DEPTH_BIT_COUNT );
+	HELIUM_COMPILE_ASSERT( SORT_KEY_PRE_PASS_DEPTH_BIT_COUNT <= SORT_KEY_FRONT_TO_BACK_DEPTH_BIT_COUNT );
+
+	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+	m_subMeshSortKeys.Resize( subMeshIndexCount );
+
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
+		const GraphicsSceneObject& rSceneObject =
+			m_pRenderSnapshot->sceneObjects[m_pRenderSnapshot->sceneObjectSubMeshes[meshIndex].GetSceneObjectId()];
+
+		uint64_t depth = QuantizeSortKeyDepth(
+			m_subMeshSortDepths[meshIndexIndex],
+			minDepth,
+			depthScale,
+			depthBitCount );
+		uint64_t mesh = GetSortKeyPointerBits( rSceneObject.GetVertexBuffer(), SORT_KEY_FRONT_TO_BACK_MESH_BIT_COUNT );
+
+		m_subMeshSortKeys[meshIndexIndex] =
+			( static_cast< uint64_t >( pass ) << passShift ) |
+			( depth << depthShift ) |
+			( mesh << meshShift ) |
+			GetSortKeySubMeshBits( meshIndex );
+	}
+
+	SortSubMeshKeys();
+}
+
+/// Sort the visible sub-mesh list by material in order to reduce shader and material state changes.
+///
+/// Sort keys hold (from the most significant bits down) the render pass, the vertex and pixel shader variants, the
+/// material, the mesh vertex buffer, a coarsely quantized depth (so that sub-meshes sharing the same state are drawn
+/// roughly front to back), and the sub-mesh ID.
+///
+/// @param[in] rViewDirection  World-space view direction.
+///
+/// @see SortSubMeshesFrontToBack()
+void GraphicsScene::SortSubMeshesByMaterial( const Simd::Vector3& rViewDirection )
+{
+	float32_t minDepth, depthScale;
+	ComputeSubMeshSortDepths( rViewDirection, minDepth, depthScale );
+
+	const uint32_t depthShift = SORT_KEY_SUB_MESH_BIT_COUNT;
+	const uint32_t meshShift = depthShift + SORT_KEY_MATERIAL_DEPTH_BIT_COUNT;
+	const uint32_t materialShift = meshShift + SORT_KEY_MATERIAL_MESH_BIT_COUNT;
+	const uint32_t pixelVariantShift = materialShift + SORT_KEY_MATERIAL_MATERIAL_BIT_COUNT;
+	const uint32_t vertexVariantShift = pixelVariantShift + SORT_KEY_MATERIAL_VARIANT_BIT_COUNT;
+	const uint32_t passShift = vertexVariantShift + SORT_KEY_MATERIAL_VARIANT_BIT_COUNT;
+	HELIUM_COMPILE_ASSERT(
+		SORT_KEY_SUB_MESH_BIT_COUNT + SORT_KEY_MATERIAL_DEPTH_BIT_COUNT + SORT_KEY_MATERIAL_MESH_BIT_COUNT +
+		SORT_KEY_MATERIAL_MATERIAL_BIT_COUNT + SORT_KEY_MATERIAL_VARIANT_BIT_COUNT * 2 + SORT_KEY_PASS_BIT_COUNT == 64 );
+
+	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+	m_subMeshSortKeys.Resize( subMeshIndexCount );
+
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
+		const GraphicsSceneObject::SubMeshData& rSubMeshData = m_pRenderSnapshot->sceneObjectSubMeshes[meshIndex];
+		const GraphicsSceneObject& rSceneObject = m_pRenderSnapshot->sceneObjects[rSubMeshData.GetSceneObjectId()];
+
+		// Sub-meshes without a material are sorted first.
+		uint64_t vertexVariant = 0;
+		uint64_t pixelVariant = 0;
+		uint64_t material = 0;
+
+		Material* pMaterial = rSubMeshData.GetMaterial();
+		if ( pMaterial )
+		{
+			vertexVariant = GetSortKeyPointerBits(
+				pMaterial->GetShaderVariant( RShader::TYPE_VERTEX ),
+				SORT_KEY_MATERIAL_VARIANT_BIT_COUNT );
+			pixelVariant = GetSortKeyPointerBits(
+				pMaterial->GetShaderVariant( RShader::TYPE_PIXEL ),
+				SORT_KEY_MATERIAL_VARIANT_BIT_COUNT );
+			material = GetSortKeyPointerBits( pMaterial, SORT_KEY_MATERIAL_MATERIAL_BIT_COUNT );
+		}
+
+		uint64_t mesh = GetSortKeyPointerBits( rSceneObject.GetVertexBuffer(), SORT_KEY_MATERIAL_MESH_BIT_COUNT );
+		uint64_t depth = QuantizeSortKeyDepth(
+			m_subMeshSortDepths[meshIndexIndex],
+			minDepth,
+			depthScale,
+			SORT_KEY_MATERIAL_DEPTH_BIT_COUNT );
+
+		m_subMeshSortKeys[meshIndexIndex] =
+			( static_cast< uint64_t >( SORT_KEY_PASS_BASE ) << passShift ) |
+			( vertexVariant << vertexVariantShift ) |
+			( pixelVariant << pixelVariantShift ) |
+			( material << materialShift ) |
+			( mesh << meshShift ) |
+			( depth << depthShift ) |
+			GetSortKeySubMeshBits( meshIndex );
+	}
+
+	SortSubMeshKeys();
+}
+
+/// Sort the keys built for the visible sub-mesh list and reorder the list to match.
+///
+/// - The m_subMeshSortKeys array should already be filled with a sort key for each entry in
+///   m_sceneObjectSubMeshIndices.
+///
+/// @see SortSubMeshesFrontToBack(), SortSubMeshesByMaterial()
+void GraphicsScene::SortSubMeshKeys()
+{
+	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+	HELIUM_ASSERT( m_subMeshSortKeys.GetSize() == subMeshIndexCount );
+
+	m_subMeshSortScratch.Resize( subMeshIndexCount );
+
+	{
+		RadixSortJob job;
+		RadixSortJob::Parameters& rParameters = job.GetParameters();
+		rParameters.pKeys = m_subMeshSortKeys.GetData();
+		rParameters.pScratch = m_subMeshSortScratch.GetData();
+		rParameters.count = subMeshIndexCount;
+		rParameters.startBit =
+			SORT_KEY_SUB_MESH_BIT_COUNT - SORT_KEY_SUB_MESH_BIT_COUNT % RadixSortJob::DIGIT_BIT_COUNT;
+		job.Run();
+	}
+
+	const uint64_t subMeshMask = ( static_cast< uint64_t >( 1 ) << SORT_KEY_SUB_MESH_BIT_COUNT ) - 1;
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		m_sceneObjectSubMeshIndices[meshIndexIndex] =
+			static_cast< size_t >( m_subMeshSortKeys[meshIndexIndex] & subMeshMask );
+	}
+}
+
+/// Get the number of consecutive entries in the sorted visible sub-mesh list, starting from a given entry, that can be
+/// drawn as instances of the same geometry using a single instanced draw call.
+///
+/// Entries can only be instanced together if they draw the same primitive range from the same vertex and index
+/// buffers with the same vertex layout, and if their scene objects are not skinned.
+///
+/// @param[in] meshIndexIndex  Index of the first entry in m_sceneObjectSubMeshIndices.
+/// @param[in] bMatchMaterial  True if all instances must also use the same material, false if only the geometry needs
+///                            to match (i.e. for depth-only rendering).
+///
+/// @return  Number of entries in the run (always at least one, and never more than the number of instances that fit
+///          in the shared instance vertex buffer).
+///
+/// @see WriteInstanceData()
+size_t GraphicsScene::GetInstanceRunLength( size_t meshIndexIndex, bool bMatchMaterial ) const
+{
+	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+	HELIUM_ASSERT( meshIndexIndex < subMeshIndexCount );
+
+	const GraphicsSceneObject::SubMeshData& rFirstSubMeshData =
+		m_pRenderSnapshot->sceneObjectSubMeshes[m_sceneObjectSubMeshIndices[meshIndexIndex]];
+	const GraphicsSceneObject& rFirstSceneObject =
+		m_pRenderSnapshot->sceneObjects[rFirstSubMeshData.GetSceneObjectId()];
+	if ( rFirstSceneObject.GetBoneCount() != 0 && rFirstSceneObject.GetBonePalette() )
+	{
+		return 1;
+	}
+
+	const Material* pMaterial = rFirstSubMeshData.GetMaterial();
+
+	size_t runEndIndex = Min( subMeshIndexCount, meshIndexIndex + INSTANCE_VERTEX_BUFFER_INSTANCE_COUNT );
+	size_t runIndex;
+	for ( runIndex = meshIndexIndex + 1; runIndex < runEndIndex; ++runIndex )
+	{
+		const GraphicsSceneObject::SubMeshData& rSubMeshData =
+			m_pRenderSnapshot->sceneObjectSubMeshes[m_sceneObjectSubMeshIndices[runIndex]];
+		if ( rSubMeshData.GetPrimitiveType() != rFirstSubMeshData.GetPrimitiveType() ||
+			rSubMeshData.GetPrimitiveCount() != rFirstSubMeshData.GetPrimitiveCount() ||
+			rSubMeshData.GetStartVertex() != rFirstSubMeshData.GetStartVertex() ||
+			rSubMeshData.GetVertexRange() != rFirstSubMeshData.GetVertexRange() ||
+			rSubMeshData.GetStartIndex() != rFirstSubMeshData.GetStartIndex() )
+		{
+			break;
+		}
 
-		if ( viewIndex < m_viewBufferedDrawers.GetSize() )
+		if ( bMatchMaterial )
 		{
-			BufferedDrawer* pDrawer = m_viewBufferedDrawers[viewIndex];
-			if ( pDrawer )
+			const Material* pSubMeshMaterial = rSubMeshData.GetMaterial();
+			if ( pSubMeshMaterial != pMaterial )
 			{
-				pDrawer->DrawScreenElements();
+				break;
 			}
 		}
+
+		const GraphicsSceneObject& rSceneObject = m_pRenderSnapshot->sceneObjects[rSubMeshData.GetSceneObjectId()];
+		if ( rSceneObject.GetVertexBuffer() != rFirstSceneObject.GetVertexBuffer() ||
+			rSceneObject.GetIndexBuffer() != rFirstSceneObject.GetIndexBuffer() ||
+			rSceneObject.GetVertexDescription() != rFirstSceneObject.GetVertexDescription() ||
+			rSceneObject.GetVertexStride() != rFirstSceneObject.GetVertexStride() ||
+			( rSceneObject.GetBoneCount() != 0 && rSceneObject.GetBonePalette() ) )
+		{
+			break;
+		}
 	}
-#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
-	spCommandProxy->EndScene();
+	return runIndex - meshIndexIndex;
+}
 
-	spCommandProxy->UnbindResources();
+/// Write the world transforms for a run of sub-mesh instances to the shared instance vertex buffer.
+///
+/// Instance data is appended to the data already written to the buffer, with the buffer contents being discarded
+/// once its end is reached.
+///
+/// @param[in]  meshIndexIndex  Index of the entry in m_sceneObjectSubMeshIndices for the first instance.
+/// @param[in]  instanceCount   Number of instances to write.
+/// @param[out] rByteOffset     Byte offset of the first instance within the shared instance vertex buffer.
+///
+/// @return  True if the instance data was written successfully, false if the instance vertex buffer could not be
+///          created.
+///
+/// @see GetInstanceRunLength()
+bool GraphicsScene::WriteInstanceData( size_t meshIndexIndex, size_t instanceCount, uint32_t& rByteOffset )
+{
+	HELIUM_ASSERT( instanceCount != 0 );
+	HELIUM_ASSERT( instanceCount <= INSTANCE_VERTEX_BUFFER_INSTANCE_COUNT );
+	HELIUM_ASSERT( meshIndexIndex + instanceCount <= m_sceneObjectSubMeshIndices.GetSize() );
 
-	pRenderContext->Swap();
+	if ( !m_spInstanceVertexBuffer )
+	{
+		Renderer* pRenderer = Renderer::GetInstance();
+		HELIUM_ASSERT( pRenderer );
+
+		m_spInstanceVertexBuffer = pRenderer->CreateVertexBuffer(
+			sizeof( InstanceVertex ) * INSTANCE_VERTEX_BUFFER_INSTANCE_COUNT,
+			RENDERER_BUFFER_USAGE_DYNAMIC );
+		if ( !m_spInstanceVertexBuffer )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				"GraphicsScene::WriteInstanceData(): Instance vertex buffer creation failed!\n" );
+
+			return false;
+		}
+
+		// Make sure the new buffer is discarded when first mapped.
+		m_instanceVertexBufferOffset = INSTANCE_VERTEX_BUFFER_INSTANCE_COUNT;
+	}
+
+	ERendererBufferMapHint mapHint = RENDERER_BUFFER_MAP_HINT_NO_OVERWRITE;
+	if ( m_instanceVertexBufferOffset + instanceCount > INSTANCE_VERTEX_BUFFER_INSTANCE_COUNT )
+	{
+		mapHint = RENDERER_BUFFER_MAP_HINT_DISCARD;
+		m_instanceVertexBufferOffset = 0;
+	}
+
+	InstanceVertex* pInstances = static_cast<InstanceVertex*>( m_spInstanceVertexBuffer->Map( mapHint ) );
+	HELIUM_ASSERT( pInstances );
+	pInstances += m_instanceVertexBufferOffset;
+
+	for ( size_t instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex )
+	{
+		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex + instanceIndex];
+		size_t sceneObjectId = m_pRenderSnapshot->sceneObjectSubMeshes[meshIndex].GetSceneObjectId();
+		const GraphicsSceneObject& rSceneObject = m_pRenderSnapshot->sceneObjects[sceneObjectId];
+		const Simd::Matrix44& rTransform = rSceneObject.GetTransform();
+
+		// Transpose the matrix for proper interpretation by the shader (same as the per-instance constant buffer data).
+		float32_t* pTransform = &pInstances[instanceIndex].transform[0][0];
+		*( pTransform++ ) = rTransform.GetElement( 0 );
+		*( pTransform++ ) = rTransform.GetElement( 4 );
+		*( pTransform++ ) = rTransform.GetElement( 8 );
+		*( pTransform++ ) = rTransform.GetElement( 12 );
+		*( pTransform++ ) = rTransform.GetElement( 1 );
+		*( pTransform++ ) = rTransform.GetElement( 5 );
+		*( pTransform++ ) = rTransform.GetElement( 9 );
+		*( pTransform++ ) = rTransform.GetElement( 13 );
+		*( pTransform++ ) = rTransform.GetElement( 2 );
+		*( pTransform++ ) = rTransform.GetElement( 6 );
+		*( pTransform++ ) = rTransform.GetElement( 10 );
+		*pTransform = rTransform.GetElement( 14 );
+	}
+
+	m_spInstanceVertexBuffer->Unmap();
+
+	rByteOffset = static_cast<uint32_t>( m_instanceVertexBufferOffset * sizeof( InstanceVertex ) );
+	m_instanceVertexBufferOffset += instanceCount;
+
+	return true;
 }
 
 /// Draw the shadow depth render pass.
@@ -1357,8 +2946,8 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 /// @see DrawDepthPrePass(), DrawBasePass()
 void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 {
-	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
-	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+	HELIUM_ASSERT( viewIndex < m_pRenderSnapshot->sceneViews.GetSize() );
+	HELIUM_ASSERT( m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) );
 
 	RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
 	HELIUM_ASSERT( pRenderResourceManager );
@@ -1413,10 +3002,11 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 	HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
 	RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast<RVertexShader*>( pPrePassShaderResource );
 
-	// Make sure the shadow depth pass constant buffer exists.
-	RConstantBuffer* pShadowViewVertexDataBuffer =
-		m_shadowViewVertexDataBuffers[m_constantBufferSetIndex][viewIndex];
-	if ( !pShadowViewVertexDataBuffer )
+	// Make sure the shadow depth pass constants were allocated for the current frame.
+	HELIUM_ASSERT( viewIndex < m_viewConstantBufferOffsets.GetSize() );
+	const ViewConstantBufferOffsets& rViewOffsets = m_viewConstantBufferOffsets[viewIndex];
+	RConstantBuffer* pShadowViewVertexDataBuffer = m_constantBufferRing.GetBuffer();
+	if ( !pShadowViewVertexDataBuffer || IsInvalid( rViewOffsets.shadowViewVertexData ) )
 	{
 		return;
 	}
@@ -1435,20 +3025,7 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 	// Sort meshes based on distance from front to back in order to reduce overdraw.
 	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
 
-	{
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
-
-		SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-		rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-		rParameters.count = subMeshIndexCount;
-		rParameters.compare = SubMeshFrontToBackCompare(
-			m_directionalLightDirection,
-			m_sceneObjects,
-			m_sceneObjectSubMeshes );
-		rParameters.singleJobCount = 100;
-
-		job.Run();
-	}
+	SortSubMeshesFrontToBack( SORT_KEY_PASS_SHADOW_DEPTH, m_pRenderSnapshot->directionalLightDirection );
 
 	// Prepare the shadow depth pass scene for rendering.
 	Renderer* pRenderer = Renderer::GetInstance();
@@ -1477,36 +3054,43 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 	spCommandProxy->BeginScene();
 	spCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
 
-	spCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
+	spCommandProxy->SetVertexConstantBuffers(
+		0,
+		1,
+		&pShadowViewVertexDataBuffer,
+		NULL,
+		&rViewOffsets.shadowViewVertexData,
+		&SHADOW_VIEW_VERTEX_DATA_SIZE );
 	spCommandProxy->SetPixelShader( NULL );
 
-	RVertexShader* pPreviousVertexShader = NULL;
+	// Resolve the state of each draw call up front.  Caching vertex input layouts updates shared shader state, so
+	// this is done serially before any recording jobs are started.
+	m_shadowDepthDraws.Resize( 0 );
+	m_shadowDepthDraws.Reserve( subMeshIndexCount );
 
 	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
 	{
 		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
-		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
+		HELIUM_ASSERT( meshIndex < m_pRenderSnapshot->sceneObjectSubMeshes.GetSize() );
 
-		GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[meshIndex];
+		GraphicsSceneObject::SubMeshData& rSubMeshData = m_pRenderSnapshot->sceneObjectSubMeshes[meshIndex];
 
 		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
 		HELIUM_ASSERT( IsValid( sceneObjectId ) );
-		HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
-		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+		HELIUM_ASSERT( sceneObjectId < m_pRenderSnapshot->sceneObjects.GetSize() );
 
-		HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
-		RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[meshIndex];
-		if ( !pInstanceVertexGlobalDataBuffer )
+		uint32_t instanceVertexGlobalDataOffset;
+		uint32_t instanceVertexGlobalDataSize;
+		if ( !GetInstanceVertexGlobalDataRange(
+			meshIndex,
+			sceneObjectId,
+			instanceVertexGlobalDataOffset,
+			instanceVertexGlobalDataSize ) )
 		{
-			HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
-			pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[sceneObjectId];
-			if ( !pInstanceVertexGlobalDataBuffer )
-			{
-				continue;
-			}
+			continue;
 		}
 
-		GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+		GraphicsSceneObject& rSceneObject = m_pRenderSnapshot->sceneObjects[sceneObjectId];
 
 		RVertexBuffer* pVertexBuffer = rSceneObject.GetVertexBuffer();
 		if ( !pVertexBuffer )
@@ -1543,38 +3127,156 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 			continue;
 		}
 
-		uint32_t vertexStride = rSceneObject.GetVertexStride();
-		uint32_t offset = 0;
+		ShadowDepthDraw* pDraw = m_shadowDepthDraws.New();
+		HELIUM_ASSERT( pDraw );
+		pDraw->pVertexShader = pVertexShader;
+		pDraw->pInputLayout = pInputLayout;
+		pDraw->pVertexBuffer = pVertexBuffer;
+		pDraw->pIndexBuffer = pIndexBuffer;
+		pDraw->vertexStride = rSceneObject.GetVertexStride();
+		pDraw->instanceVertexGlobalDataOffset = instanceVertexGlobalDataOffset;
+		pDraw->instanceVertexGlobalDataSize = instanceVertexGlobalDataSize;
+		pDraw->primitiveType = rSubMeshData.GetPrimitiveType();
+		pDraw->primitiveCount = rSubMeshData.GetPrimitiveCount();
+		pDraw->startVertex = rSubMeshData.GetStartVertex();
+		pDraw->vertexRange = rSubMeshData.GetVertexRange();
+		pDraw->startIndex = rSubMeshData.GetStartIndex();
+	}
 
-		ERendererPrimitiveType primitiveType = rSubMeshData.GetPrimitiveType();
-		uint32_t primitiveCount = rSubMeshData.GetPrimitiveCount();
-		uint32_t startVertex = rSubMeshData.GetStartVertex();
-		uint32_t vertexRange = rSubMeshData.GetVertexRange();
-		uint32_t startIndex = rSubMeshData.GetStartIndex();
+	RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_constantBufferRing.GetBuffer();
 
-		if ( pPreviousVertexShader != pVertexShader )
+	// Split the draw calls across jobs, keeping each job from getting too small to be worth recording in parallel.
+	size_t drawCount = m_shadowDepthDraws.GetSize();
+	size_t jobCount = ( drawCount + SHADOW_DEPTH_RECORD_JOB_DRAW_COUNT_MIN - 1 ) / SHADOW_DEPTH_RECORD_JOB_DRAW_COUNT_MIN;
+	jobCount = Min( jobCount, static_cast< size_t >( JobManager::GetConcurrency() ) );
+	jobCount = Min( jobCount, SHADOW_DEPTH_RECORD_JOB_COUNT_MAX );
+
+	if ( jobCount <= 1 )
+	{
+		RecordShadowDepthDraws(
+			spCommandProxy,
+			pInstanceVertexGlobalDataBuffer,
+			m_shadowDepthDraws.GetData(),
+			drawCount );
+	}
+	else
+	{
+		// Each job records into its own deferred command proxy, and the resulting lists are then executed in order on
+		// the immediate proxy.
+		while ( m_shadowDepthCommandProxies.GetSize() < jobCount )
 		{
-			spCommandProxy->SetVertexShader( pVertexShader );
-			pPreviousVertexShader = pVertexShader;
+			RRenderCommandProxyPtr spDeferredCommandProxy = pRenderer->CreateDeferredCommandProxy();
+			HELIUM_ASSERT( spDeferredCommandProxy );
+			m_shadowDepthCommandProxies.Push( spDeferredCommandProxy );
 		}
 
-		spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
-		spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-		spCommandProxy->SetIndexBuffer( pIndexBuffer );
-		spCommandProxy->SetVertexInputLayout( pInputLayout );
+		m_shadowDepthCommandLists.Resize( jobCount );
 
-		spCommandProxy->DrawIndexed(
-			primitiveType,
-			startVertex,
-			0,
-			vertexRange,
-			startIndex,
-			primitiveCount );
+		size_t jobDrawCount = ( drawCount + jobCount - 1 ) / jobCount;
+		jobCount = ( drawCount + jobDrawCount - 1 ) / jobDrawCount;
+
+		ShadowDepthRecordJob jobs[ SHADOW_DEPTH_RECORD_JOB_COUNT_MAX ];
+		for ( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+		{
+			size_t startIndex = jobIndex * jobDrawCount;
+
+			ShadowDepthRecordJob& rJob = jobs[jobIndex];
+			rJob.pCommandProxy = m_shadowDepthCommandProxies[jobIndex];
+			rJob.pInstanceVertexGlobalDataBuffer = pInstanceVertexGlobalDataBuffer;
+			rJob.pDraws = m_shadowDepthDraws.GetData() + startIndex;
+			rJob.drawCount = Min( jobDrawCount, drawCount - startIndex );
+			rJob.pspCommandList = &m_shadowDepthCommandLists[jobIndex];
+		}
+
+		JobManager::Run( jobs, jobCount );
+
+		for ( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+		{
+			RRenderCommandListPtr& rspCommandList = m_shadowDepthCommandLists[jobIndex];
+			HELIUM_ASSERT( rspCommandList );
+			spCommandProxy->ExecuteCommandList( rspCommandList );
+			rspCommandList.Release();
+		}
 	}
 
 	spCommandProxy->EndScene();
 }
 
+/// Record a range of shadow depth pass draw calls.
+///
+/// The shadow view constants, render targets, and other pass-wide state are expected to have already been set when
+/// the recorded commands are executed, but the vertex shader is always set by the first draw call so that each range
+/// can be recorded into a separate command list.
+///
+/// @param[in] pCommandProxy                    Command proxy to record into.
+/// @param[in] pInstanceVertexGlobalDataBuffer  Constant buffer holding the instance vertex constants.
+/// @param[in] pDraws                           Draw calls to record.
+/// @param[in] drawCount                        Number of draw calls to record.
+void GraphicsScene::RecordShadowDepthDraws(
+	RRenderCommandProxy* pCommandProxy,
+	RConstantBuffer* pInstanceVertexGlobalDataBuffer,
+	const ShadowDepthDraw* pDraws,
+	size_t drawCount )
+{
+	HELIUM_ASSERT( pCommandProxy );
+	HELIUM_ASSERT( pDraws || drawCount == 0 );
+
+	RVertexShader* pPreviousVertexShader = NULL;
+
+	for ( size_t drawIndex = 0; drawIndex < drawCount; ++drawIndex )
+	{
+		const ShadowDepthDraw& rDraw = pDraws[drawIndex];
+
+		if ( pPreviousVertexShader != rDraw.pVertexShader )
+		{
+			pCommandProxy->SetVertexShader( rDraw.pVertexShader );
+			pPreviousVertexShader = rDraw.pVertexShader;
+		}
+
+		RVertexBuffer* pVertexBuffer = rDraw.pVertexBuffer;
+		uint32_t vertexStride = rDraw.vertexStride;
+		uint32_t offset = 0;
+
+		pCommandProxy->SetVertexConstantBuffers(
+			1,
+			1,
+			&pInstanceVertexGlobalDataBuffer,
+			NULL,
+			&rDraw.instanceVertexGlobalDataOffset,
+			&rDraw.instanceVertexGlobalDataSize );
+		pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+		pCommandProxy->SetIndexBuffer( rDraw.pIndexBuffer );
+		pCommandProxy->SetVertexInputLayout( rDraw.pInputLayout );
+
+		pCommandProxy->DrawIndexed(
+			rDraw.primitiveType,
+			rDraw.startVertex,
+			0,
+			rDraw.vertexRange,
+			rDraw.startIndex,
+			rDraw.primitiveCount );
+	}
+}
+
+/// Record the draw calls assigned to this job and finish the resulting command list.
+void GraphicsScene::ShadowDepthRecordJob::Run()
+{
+	HELIUM_ASSERT( pCommandProxy );
+	HELIUM_ASSERT( pspCommandList );
+
+	RecordShadowDepthDraws( pCommandProxy, pInstanceVertexGlobalDataBuffer, pDraws, drawCount );
+	pCommandProxy->FinishCommandList( *pspCommandList );
+}
+
+/// Callback executed to run the job.
+///
+/// @param[in] pJob  Job to run.
+void GraphicsScene::ShadowDepthRecordJob::RunCallback( void* pJob )
+{
+	HELIUM_ASSERT( pJob );
+	static_cast< ShadowDepthRecordJob* >( pJob )->Run();
+}
+
 /// Draw the depth-only pre-pass for the given scene view.
 ///
 /// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
@@ -1588,8 +3290,8 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 /// @see DrawShadowDepthPass(), DrawBasePass()
 void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 {
-	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
-	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+	HELIUM_ASSERT( viewIndex < m_pRenderSnapshot->sceneViews.GetSize() );
+	HELIUM_ASSERT( m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) );
 
 	RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
 	HELIUM_ASSERT( pRenderResourceManager );
@@ -1637,26 +3339,40 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 	HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
 	RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast<RVertexShader*>( pPrePassShaderResource );
 
+	// Get the instanced pre-pass vertex shader if hardware instancing is supported (if the shader does not provide an
+	// instancing toggle, the same variant as the one without instancing will be returned).
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	RVertexShader* pPrePassInstancedVertexShader = NULL;
+	if ( pRenderer->SupportsAllFeatures( RENDERER_FEATURE_FLAG_INSTANCING ) )
+	{
+		Name instancingToggleName = GetInstancingToggleName();
+
+		optionSelectPair.choice = GetNoneOptionName();
+		optionSetIndex = rPrePassShaderSysOptions.GetOptionSetIndex(
+			RShader::TYPE_VERTEX,
+			&instancingToggleName,
+			1,
+			&optionSelectPair,
+			1 );
+		pPrePassShaderResource = pPrePassVertexShaderVariant->GetRenderResource( optionSetIndex );
+		if ( pPrePassShaderResource && pPrePassShaderResource != pPrePassNoSkinningVertexShader )
+		{
+			HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
+			pPrePassInstancedVertexShader = static_cast<RVertexShader*>( pPrePassShaderResource );
+		}
+	}
+
 	// Sort meshes based on distance from front to back in order to reduce overdraw.
-	GraphicsSceneView& rView = m_sceneViews[viewIndex];
+	GraphicsSceneView& rView = m_pRenderSnapshot->sceneViews[viewIndex];
 	const Simd::Vector3& rViewDirection = rView.GetForward();
 
 	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
 
-	{
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
-		SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-		rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-		rParameters.count = subMeshIndexCount;
-		rParameters.compare = SubMeshFrontToBackCompare( rViewDirection, m_sceneObjects, m_sceneObjectSubMeshes );
-		rParameters.singleJobCount = 100;
-		job.Run();
-	}
+	SortSubMeshesFrontToBack( SORT_KEY_PASS_DEPTH_PRE_PASS, rViewDirection );
 
 	// Initialize the blend state and shaders for performing no color writes.
-	Renderer* pRenderer = Renderer::GetInstance();
-	HELIUM_ASSERT( pRenderer );
-
 	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
 	HELIUM_ASSERT( spCommandProxy );
 
@@ -1666,34 +3382,38 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 
 	spCommandProxy->SetPixelShader( NULL );
 
-	// Draw each visible mesh instance.
+	// Draw each visible mesh instance, drawing runs of sub-meshes that share the same geometry using a single instanced
+	// draw call where possible.
 	RVertexShader* pPreviousVertexShader = NULL;
+	size_t instanceCount = 1;
 
-	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; meshIndexIndex += instanceCount )
 	{
+		instanceCount = 1;
+
 		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
-		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
+		HELIUM_ASSERT( meshIndex < m_pRenderSnapshot->sceneObjectSubMeshes.GetSize() );
 
-		GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[meshIndex];
+		GraphicsSceneObject::SubMeshData& rSubMeshData = m_pRenderSnapshot->sceneObjectSubMeshes[meshIndex];
 
 		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
 		HELIUM_ASSERT( IsValid( sceneObjectId ) );
-		HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
-		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+		HELIUM_ASSERT( sceneObjectId < m_pRenderSnapshot->sceneObjects.GetSize() );
 
-		HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
-		RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[meshIndex];
-		if ( !pInstanceVertexGlobalDataBuffer )
+		uint32_t instanceVertexGlobalDataOffset;
+		uint32_t instanceVertexGlobalDataSize;
+		if ( !GetInstanceVertexGlobalDataRange(
+			meshIndex,
+			sceneObjectId,
+			instanceVertexGlobalDataOffset,
+			instanceVertexGlobalDataSize ) )
 		{
-			HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
-			pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[sceneObjectId];
-			if ( !pInstanceVertexGlobalDataBuffer )
-			{
-				continue;
-			}
+			continue;
 		}
 
-		GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+		RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_constantBufferRing.GetBuffer();
+
+		GraphicsSceneObject& rSceneObject = m_pRenderSnapshot->sceneObjects[sceneObjectId];
 
 		RVertexBuffer* pVertexBuffer = rSceneObject.GetVertexBuffer();
 		if ( !pVertexBuffer )
@@ -1714,9 +3434,27 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 		}
 
 		RVertexShader* pVertexShader;
+		uint32_t instanceDataOffset = 0;
 		if ( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() )
 		{
 			pVertexShader = pPrePassNoSkinningVertexShader;
+
+			if ( pPrePassInstancedVertexShader )
+			{
+				size_t runLength = GetInstanceRunLength( meshIndexIndex, false );
+				if ( runLength >= INSTANCE_RUN_LENGTH_MIN )
+				{
+					RVertexDescription* pInstancedVertexDescription =
+						pRenderResourceManager->GetInstancedMeshVertexDescription( pVertexDescription );
+					if ( pInstancedVertexDescription &&
+						WriteInstanceData( meshIndexIndex, runLength, instanceDataOffset ) )
+					{
+						instanceCount = runLength;
+						pVertexShader = pPrePassInstancedVertexShader;
+						pVertexDescription = pInstancedVertexDescription;
+					}
+				}
+			}
 		}
 		else
 		{
@@ -1745,18 +3483,53 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 			pPreviousVertexShader = pVertexShader;
 		}
 
-		spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
+		if ( instanceCount > 1 )
+		{
+			RVertexBuffer* pInstanceVertexBuffer = m_spInstanceVertexBuffer;
+			uint32_t instanceStride = static_cast<uint32_t>( sizeof( InstanceVertex ) );
+			spCommandProxy->SetVertexBuffers(
+				INSTANCE_DATA_VERTEX_STREAM_INDEX,
+				1,
+				&pInstanceVertexBuffer,
+				&instanceStride,
+				&instanceDataOffset );
+		}
+		else
+		{
+			spCommandProxy->SetVertexConstantBuffers(
+				1,
+				1,
+				&pInstanceVertexGlobalDataBuffer,
+				NULL,
+				&instanceVertexGlobalDataOffset,
+				&instanceVertexGlobalDataSize );
+		}
+
 		spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
 		spCommandProxy->SetIndexBuffer( pIndexBuffer );
 		spCommandProxy->SetVertexInputLayout( pInputLayout );
 
-		spCommandProxy->DrawIndexed(
-			primitiveType,
-			startVertex,
-			0,
-			vertexRange,
-			startIndex,
-			primitiveCount );
+		if ( instanceCount > 1 )
+		{
+			spCommandProxy->DrawIndexedInstanced(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount,
+				static_cast<uint32_t>( instanceCount ) );
+		}
+		else
+		{
+			spCommandProxy->DrawIndexed(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount );
+		}
 	}
 }
 
@@ -1775,20 +3548,16 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 /// @see DrawShadowDepthPass(), DrawDepthPrePass()
 void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 {
-	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
-	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
-
-	// Make sure per-view constant buffers for the base pass exist.
-	RConstantBuffer* pViewVertexBasePassDataBuffer =
-		m_viewVertexBasePassDataBuffers[m_constantBufferSetIndex][viewIndex];
-	if ( !pViewVertexBasePassDataBuffer )
-	{
-		return;
-	}
-
-	RConstantBuffer* pViewPixelBasePassDataBuffer =
-		m_viewPixelBasePassDataBuffers[m_constantBufferSetIndex][viewIndex];
-	if ( !pViewPixelBasePassDataBuffer )
+	HELIUM_ASSERT( viewIndex < m_pRenderSnapshot->sceneViews.GetSize() );
+	HELIUM_ASSERT( m_pRenderSnapshot->sceneViews.IsElementValid( viewIndex ) );
+
+	// Make sure per-view constants for the base pass were allocated for the current frame.
+	HELIUM_ASSERT( viewIndex < m_viewConstantBufferOffsets.GetSize() );
+	const ViewConstantBufferOffsets& rViewOffsets = m_viewConstantBufferOffsets[viewIndex];
+	RConstantBuffer* pViewConstantBuffer = m_constantBufferRing.GetBuffer();
+	if ( !pViewConstantBuffer ||
+		IsInvalid( rViewOffsets.vertexBasePassData ) ||
+		IsInvalid( rViewOffsets.pixelBasePassData ) )
 	{
 		return;
 	}
@@ -1822,19 +3591,11 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 
 	systemSelections[0].choice = shadowSelectOptions[shadowMode];
 
-	// Sort meshes based on material in order to reduce shader switches.
+	// Sort meshes based on material in order to reduce shader switches (and roughly front to back within each
+	// material).
 	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
 
-	{
-		SortJob< size_t, SubMeshMaterialCompare > job;
-		SortJob< size_t, SubMeshMaterialCompare >::Parameters& rParameters = job.GetParameters();
-		rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-		rParameters.count = subMeshIndexCount;
-		rParameters.compare = SubMeshMaterialCompare( m_sceneObjectSubMeshes );
-		rParameters.singleJobCount = 100;
-
-		job.Run();
-	}
+	SortSubMeshesByMaterial( m_pRenderSnapshot->sceneViews[viewIndex].GetForward() );
 
 	// Set the opaque rendering blend state and per-view constant buffers for this pass.
 	Renderer* pRenderer = Renderer::GetInstance();
@@ -1847,8 +3608,20 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 		RenderResourceManager::BLEND_STATE_OPAQUE );
 	spCommandProxy->SetBlendState( pBlendStateOpaque );
 
-	spCommandProxy->SetVertexConstantBuffers( 1, 1, &pViewVertexBasePassDataBuffer );
-	spCommandProxy->SetPixelConstantBuffers( 0, 1, &pViewPixelBasePassDataBuffer );
+	spCommandProxy->SetVertexConstantBuffers(
+		1,
+		1,
+		&pViewConstantBuffer,
+		NULL,
+		&rViewOffsets.vertexBasePassData,
+		&VIEW_VERTEX_BASE_PASS_DATA_SIZE );
+	spCommandProxy->SetPixelConstantBuffers(
+		0,
+		1,
+		&pViewConstantBuffer,
+		NULL,
+		&rViewOffsets.pixelBasePassData,
+		&VIEW_PIXEL_BASE_PASS_DATA_SIZE );
 
 	// Draw each visible sub-mesh.
 	Name defaultSamplerStateName = GetDefaultSamplerStateName();
@@ -1864,36 +3637,44 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 
 	RTexture2d* pShadowDepthTexture = pRenderResourceManager->GetShadowDepthTexture();
 
+	// Runs of sub-meshes sharing the same geometry and material are drawn using a single instanced draw call when
+	// hardware instancing is supported.
+	bool bInstancingSupported = pRenderer->SupportsAllFeatures( RENDERER_FEATURE_FLAG_INSTANCING );
+	Name instancingToggleName = GetInstancingToggleName();
+
 	RVertexShader* pPreviousVertexShader = NULL;
 	RPixelShader* pPreviousPixelShader = NULL;
 	RConstantBuffer* pPreviousMaterialVertexConstantBuffer = NULL;
 	RConstantBuffer* pPreviousMaterialPixelConstantBuffer = NULL;
+	size_t instanceCount = 1;
 
-	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; meshIndexIndex += instanceCount )
 	{
+		instanceCount = 1;
+
 		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
-		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
+		HELIUM_ASSERT( meshIndex < m_pRenderSnapshot->sceneObjectSubMeshes.GetSize() );
 
-		GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[meshIndex];
+		GraphicsSceneObject::SubMeshData& rSubMeshData = m_pRenderSnapshot->sceneObjectSubMeshes[meshIndex];
 
 		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
 		HELIUM_ASSERT( IsValid( sceneObjectId ) );
-		HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
-		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+		HELIUM_ASSERT( sceneObjectId < m_pRenderSnapshot->sceneObjects.GetSize() );
 
-		HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
-		RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[meshIndex];
-		if ( !pInstanceVertexGlobalDataBuffer )
+		uint32_t instanceVertexGlobalDataOffset;
+		uint32_t instanceVertexGlobalDataSize;
+		if ( !GetInstanceVertexGlobalDataRange(
+			meshIndex,
+			sceneObjectId,
+			instanceVertexGlobalDataOffset,
+			instanceVertexGlobalDataSize ) )
 		{
-			HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
-			pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[sceneObjectId];
-			if ( !pInstanceVertexGlobalDataBuffer )
-			{
-				continue;
-			}
+			continue;
 		}
 
-		GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+		RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_constantBufferRing.GetBuffer();
+
+		GraphicsSceneObject& rSceneObject = m_pRenderSnapshot->sceneObjects[sceneObjectId];
 
 		RVertexBuffer* pVertexBuffer = rSceneObject.GetVertexBuffer();
 		if ( !pVertexBuffer )
@@ -1974,6 +3755,36 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 			continue;
 		}
 
+		// Switch to the instanced vertex shader variant if this sub-mesh starts a run that can be instanced (if the
+		// shader does not provide an instancing toggle, the same variant as the one without instancing will be
+		// returned).
+		uint32_t instanceDataOffset = 0;
+		if ( bInstancingSupported && systemSelections[1].choice == GetNoneOptionName() )
+		{
+			size_t runLength = GetInstanceRunLength( meshIndexIndex, true );
+			if ( runLength >= INSTANCE_RUN_LENGTH_MIN )
+			{
+				size_t instancedVertexShaderIndex = rSystemOptions.GetOptionSetIndex(
+					RShader::TYPE_VERTEX,
+					&instancingToggleName,
+					1,
+					systemSelections,
+					HELIUM_ARRAY_COUNT( systemSelections ) );
+				RVertexShader* pInstancedVertexShader = static_cast<RVertexShader*>(
+					pVertexShaderVariant->GetRenderResource( instancedVertexShaderIndex ) );
+				RVertexDescription* pInstancedVertexDescription =
+					pRenderResourceManager->GetInstancedMeshVertexDescription( pVertexDescription );
+				if ( pInstancedVertexShader && pInstancedVertexShader != pVertexShader &&
+					pInstancedVertexDescription &&
+					WriteInstanceData( meshIndexIndex, runLength, instanceDataOffset ) )
+				{
+					instanceCount = runLength;
+					pVertexShader = pInstancedVertexShader;
+					pVertexDescription = pInstancedVertexDescription;
+				}
+			}
+		}
+
 		pVertexShader->CacheDescription( pRenderer, pVertexDescription );
 		RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
 		if ( !pInputLayout )
@@ -1995,7 +3806,27 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 		uint32_t vertexRange = rSubMeshData.GetVertexRange();
 		uint32_t startIndex = rSubMeshData.GetStartIndex();
 
-		spCommandProxy->SetVertexConstantBuffers( 2, 1, &pInstanceVertexGlobalDataBuffer );
+		if ( instanceCount > 1 )
+		{
+			RVertexBuffer* pInstanceVertexBuffer = m_spInstanceVertexBuffer;
+			uint32_t instanceStride = static_cast<uint32_t>( sizeof( InstanceVertex ) );
+			spCommandProxy->SetVertexBuffers(
+				INSTANCE_DATA_VERTEX_STREAM_INDEX,
+				1,
+				&pInstanceVertexBuffer,
+				&instanceStride,
+				&instanceDataOffset );
+		}
+		else
+		{
+			spCommandProxy->SetVertexConstantBuffers(
+				2,
+				1,
+				&pInstanceVertexGlobalDataBuffer,
+				NULL,
+				&instanceVertexGlobalDataOffset,
+				&instanceVertexGlobalDataSize );
+		}
 
 		if ( pMaterialVertexConstantBuffer != pPreviousMaterialVertexConstantBuffer )
 		{
@@ -2094,13 +3925,27 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 			}
 		}
 
-		spCommandProxy->DrawIndexed(
-			primitiveType,
-			startVertex,
-			0,
-			vertexRange,
-			startIndex,
-			primitiveCount );
+		if ( instanceCount > 1 )
+		{
+			spCommandProxy->DrawIndexedInstanced(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount,
+				static_cast<uint32_t>( instanceCount ) );
+		}
+		else
+		{
+			spCommandProxy->DrawIndexed(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount );
+		}
 	}
 }
 
@@ -2138,123 +3983,27 @@ Name GraphicsScene::GetSkinningSmoothOptionName()
 	return skinningSmoothOptionName;
 }
 
-/// Get the name of the rigid skinning system select option for shaders.
-///
-/// @return  Rigid skinning select option name.
-///
-/// @see GetSkinningSysSelectName(), GetSkinningSmoothOptionName()
-Name GraphicsScene::GetSkinningRigidOptionName()
-{
-	static Name skinningRigidOptionName( "SKINNING_RIGID" );
-
-	return skinningRigidOptionName;
-}
-
-/// Constructor.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare()
-	: m_cameraDirection( 0.0f )
-	, m_pSceneObjects( NULL )
-	, m_pSubMeshes( NULL )
-{
-}
-
-/// Constructor.
-///
-/// @param[in] rCameraDirection  Camera world direction.
-/// @param[in] rSceneObjects     List of graphics scene objects in the scene.
-/// @param[in] rSubMeshes        List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare(
-	const Simd::Vector3& rCameraDirection,
-	const SparseArray< GraphicsSceneObject >& rSceneObjects,
-	const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-	: m_cameraDirection( rCameraDirection )
-	, m_pSceneObjects( &rSceneObjects )
-	, m_pSubMeshes( &rSubMeshes )
-{
-}
-
-/// Compare two sub-meshes for sorting.
+/// Get the name of the instancing system toggle for shaders.
 ///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
+/// Shaders supporting hardware instancing read each instance world transform from vertex inputs (see InstanceVertex)
+/// instead of from the per-instance vertex constant buffer when this toggle is enabled.
 ///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshFrontToBackCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
-{
-	const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-	const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-	size_t sceneObjectIndex0 = rSubMesh0.GetSceneObjectId();
-	HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex0 ) );
-	size_t sceneObjectIndex1 = rSubMesh1.GetSceneObjectId();
-	HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex1 ) );
-
-	const GraphicsSceneObject& rSceneObject0 = m_pSceneObjects->GetElement( sceneObjectIndex0 );
-	const GraphicsSceneObject& rSceneObject1 = m_pSceneObjects->GetElement( sceneObjectIndex1 );
-
-	Simd::Vector3 object0Pos = Simd::Vector4ToVector3( rSceneObject0.GetTransform().GetRow( 3 ) );
-	Simd::Vector3 object1Pos = Simd::Vector4ToVector3( rSceneObject1.GetTransform().GetRow( 3 ) );
-
-	float distance0 = object0Pos.Dot( m_cameraDirection );
-	float distance1 = object1Pos.Dot( m_cameraDirection );
-
-	return ( distance0 < distance1 );
-}
-
-/// Constructor.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare()
-	: m_pSubMeshes( NULL )
+/// @return  Instancing system toggle name.
+Name GraphicsScene::GetInstancingToggleName()
 {
-}
+	static Name instancingToggleName( "INSTANCING" );
 
-/// Constructor.
-///
-/// @param[in] rSubMeshes  List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare(
-	const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-	: m_pSubMeshes( &rSubMeshes )
-{
+	return instancingToggleName;
 }
 
-/// Compare two sub-meshes for sorting.
+/// Get the name of the rigid skinning system select option for shaders.
 ///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
+/// @return  Rigid skinning select option name.
 ///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshMaterialCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
+/// @see GetSkinningSysSelectName(), GetSkinningSmoothOptionName()
+Name GraphicsScene::GetSkinningRigidOptionName()
 {
-	const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-	const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-	Material* pMaterial0 = rSubMesh0.GetMaterial();
-	Material* pMaterial1 = rSubMesh1.GetMaterial();
-	if ( pMaterial0 == pMaterial1 )
-	{
-		return false;
-	}
-
-	if ( !pMaterial0 )
-	{
-		return true;
-	}
-
-	if ( !pMaterial1 )
-	{
-		return false;
-	}
-
-	ShaderVariant* pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_VERTEX );
-	ShaderVariant* pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_VERTEX );
-	if ( pVariant0 != pVariant1 )
-	{
-		return ( pVariant0 < pVariant1 );
-	}
-
-	pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_PIXEL );
-	pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_PIXEL );
+	static Name skinningRigidOptionName( "SKINNING_RIGID" );
 
-	return ( pVariant0 < pVariant1 );
+	return skinningRigidOptionName;
 }
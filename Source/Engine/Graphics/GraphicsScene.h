@@ -5,9 +5,14 @@
 #include "Reflect/Object.h"
 
 #include "Foundation/BitArray.h"
+#include "MathSimd/Quat.h"
 #include "Rendering/RRenderResource.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
 #include "GraphicsTypes/GraphicsSceneView.h"
+#include "Graphics/OcclusionBuffer.h"
+#include "Graphics/AabbTree.h"
+#include "Graphics/ConstantBufferRing.h"
+#include "Graphics/SpriteBatcher.h"
 
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 #include "Foundation/ObjectPool.h"
@@ -17,13 +22,13 @@
 namespace Helium
 {
     HELIUM_DECLARE_RPTR( RConstantBuffer );
+    HELIUM_DECLARE_RPTR( RVertexBuffer );
+    HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+    HELIUM_DECLARE_RPTR( RRenderCommandList );
 
-    class HELIUM_GRAPHICS_API SceneObjectTransform : public Helium::Component
-    {
-        HELIUM_DECLARE_COMPONENT(Helium::SceneObjectTransform, Helium::Component);
-
-        virtual void GraphicsSceneObjectUpdate(GraphicsScene *pScene) { }
-    };
+    class RIndexBuffer;
+    class RVertexInputLayout;
+    class RVertexShader;
 
     /// Manager for a graphics scene.
     class HELIUM_GRAPHICS_API GraphicsScene : public Reflect::Object
@@ -40,6 +45,7 @@ namespace Helium
         /// @name Updating
         //@{
         virtual void Update( World *pWorld );
+        void Render();
         //@}
 
         /// @name Scene View Management
@@ -56,6 +62,17 @@ namespace Helium
         size_t AllocateSceneObject();
         void ReleaseSceneObject( size_t id );
         inline GraphicsSceneObject* GetSceneObject( size_t id );
+
+        void SetSceneObjectWorldBounds( size_t id, const Simd::AaBox& rBox );
+        //@}
+
+        /// @name Scene Asset Transform Updating
+        //@{
+        void SetSceneObjectLocalBounds( size_t id, const Simd::AaBox& rBox );
+        void SetSceneObjectPositionQuantization( size_t id, const Simd::Vector3& rOffset, float32_t scale );
+
+        void QueueSceneObjectTransform(
+            size_t id, const Simd::Vector3& rPosition, const Simd::Quat& rRotation, float32_t scale );
         //@}
 
         /// @name Scene Asset Sub-mesh Allocation
@@ -65,6 +82,18 @@ namespace Helium
         inline GraphicsSceneObject::SubMeshData* GetSceneObjectSubMeshData( size_t id );
         //@}
 
+        /// @name Occlusion Culling
+        //@{
+        size_t AllocateOccluder(
+            const float32_t* pVertices, uint32_t vertexCount, const uint16_t* pIndices, uint32_t triangleCount );
+        void ReleaseOccluder( size_t id );
+        void SetOccluderTransform( size_t id, const Simd::Matrix44& rTransform );
+
+        inline void SetOcclusionCullingEnabled( bool bEnabled );
+        inline bool IsOcclusionCullingEnabled() const;
+        inline const OcclusionBuffer& GetOcclusionBuffer() const;
+        //@}
+
         /// @name Lighting
         //@{
         void SetAmbientLight(
@@ -88,6 +117,11 @@ namespace Helium
         //@}
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
+        /// @name Sprite Drawing Support
+        //@{
+        inline SpriteBatcher& GetSpriteBatcher();
+        //@}
+
         /// @name Static Reserved Names
         //@{
         static Name GetDefaultSamplerStateName();
@@ -96,50 +130,184 @@ namespace Helium
         //@}
 
     private:
-        /// Front-to-back sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshFrontToBackCompare
+        /// Number of scene object bounding spheres stored in each culling block (one per SIMD lane).
+        static const size_t CULL_BLOCK_SPHERE_COUNT = 4;
+
+        /// Bounding spheres for a block of scene objects, stored in struct-of-arrays format for SIMD culling.
+        HELIUM_SIMD_ALIGN_PRE struct CullBlock
         {
-        public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshFrontToBackCompare();
-            SubMeshFrontToBackCompare(
-                const Simd::Vector3& rCameraDirection, const SparseArray< GraphicsSceneObject >& rSceneObjects,
-                const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
-
-        private:
-            /// Camera direction.
-            Simd::Vector3 m_cameraDirection;
-            /// Scene object list.
-            const SparseArray< GraphicsSceneObject >* m_pSceneObjects;
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+            /// Sphere center x-coordinates.
+            float32_t centerX[ CULL_BLOCK_SPHERE_COUNT ];
+            /// Sphere center y-coordinates.
+            float32_t centerY[ CULL_BLOCK_SPHERE_COUNT ];
+            /// Sphere center z-coordinates.
+            float32_t centerZ[ CULL_BLOCK_SPHERE_COUNT ];
+            /// Sphere radii.
+            float32_t radius[ CULL_BLOCK_SPHERE_COUNT ];
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// Local-space data needed to rebuild the transform and world bounds of a scene object when it moves.
+        HELIUM_SIMD_ALIGN_PRE struct SceneObjectLocalSpace
+        {
+            /// Local-space bounding box center.
+            Simd::Vector3 boundsCenter;
+            /// Local-space bounding box half-extents.
+            Simd::Vector3 boundsExtent;
+            /// Offset applied to (quantized) vertex positions ahead of the world transform.
+            Simd::Vector3 positionOffset;
+            /// Scale applied to (quantized) vertex positions ahead of the world transform.
+            float32_t positionScale;
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// Scene object placement queued for the next update.
+        HELIUM_SIMD_ALIGN_PRE struct SceneObjectTransformUpdate
+        {
+            /// World-space rotation.
+            Simd::Quat rotation;
+            /// World-space position.
+            Simd::Vector3 position;
+            /// Uniform scale.
+            float32_t scale;
+            /// ID of the scene object to update (invalid if the object was released after being queued).
+            size_t sceneObjectId;
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// Occluder geometry rasterized into the occlusion buffer.
+        HELIUM_SIMD_ALIGN_PRE struct Occluder
+        {
+            /// World transform.
+            Simd::Matrix44 transform;
+            /// Vertex positions (three floats per vertex).
+            DynamicArray< float32_t > vertices;
+            /// Triangle list indices.
+            DynamicArray< uint16_t > indices;
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// Constant ring buffer offsets of the shader constants for a scene view (invalid if not allocated).
+        struct ViewConstantBufferOffsets
+        {
+            /// Global vertex constants.
+            uint32_t vertexGlobalData;
+            /// Base-pass vertex constants.
+            uint32_t vertexBasePassData;
+            /// Screen-space vertex constants.
+            uint32_t vertexScreenData;
+            /// Base-pass pixel constants.
+            uint32_t pixelBasePassData;
+            /// Shadow depth pass vertex constants.
+            uint32_t shadowViewVertexData;
+        };
+
+        /// Sub-meshes visible in a scene view, captured for a render snapshot.
+        ///
+        /// Sub-meshes are identified by scene sub-mesh ID while the view is being culled, and by index into the render
+        /// snapshot's sub-mesh records once the snapshot has been captured.
+        struct ViewVisibility
+        {
+            /// Sub-meshes visible within the view frustum (including those hidden behind occluders, which can still
+            /// cast visible shadows).
+            DynamicArray< size_t > shadowSubMeshIds;
+            /// Sub-meshes visible within the view frustum and not hidden behind occluders.
+            DynamicArray< size_t > subMeshIds;
         };
 
-        /// Material-based sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshMaterialCompare
+        /// Immutable copy of the scene state needed to render a frame, captured on the game thread.
+        HELIUM_SIMD_ALIGN_PRE struct RenderSnapshot
+        {
+            /// Scene views.
+            SparseArray< GraphicsSceneView > sceneViews;
+            /// Draw records for the scene objects owning the visible sub-meshes (skinned objects reference the bone
+            /// palette copies below).
+            DynamicArray< GraphicsSceneObject > sceneObjects;
+            /// Draw records for the sub-meshes visible in any view (scene object IDs index the records above).
+            DynamicArray< GraphicsSceneObject::SubMeshData > sceneObjectSubMeshes;
+            /// Copies of the bone palettes of the visible skinned scene objects.
+            DynamicArray< Simd::Matrix44 > bonePalettes;
+
+            /// Visible sub-meshes for each scene view ID.
+            DynamicArray< ViewVisibility > viewVisibility;
+#if GRAPHICS_SCENE_BUFFERED_DRAWER
+            /// Buffered drawer holding the draw calls recorded for each scene view ID (null if none).
+            DynamicArray< BufferedDrawer* > viewBufferedDrawers;
+#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+            /// Directional light direction.
+            Simd::Vector3 directionalLightDirection;
+            /// Directional light color.
+            Color directionalLightColor;
+            /// Directional light brightness.
+            float32_t directionalLightBrightness;
+
+            /// Ambient light top color.
+            Color ambientLightTopColor;
+            /// Ambient light top brightness.
+            float32_t ambientLightTopBrightness;
+            /// Ambient light bottom color.
+            Color ambientLightBottomColor;
+            /// Ambient light bottom brightness.
+            float32_t ambientLightBottomBrightness;
+
+            /// ID of the scene view to render (invalid to render all views).
+            uint32_t activeViewId;
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// Resolved state for a single shadow depth pass draw call.
+        struct ShadowDepthDraw
+        {
+            /// Vertex shader.
+            RVertexShader* pVertexShader;
+            /// Vertex input layout.
+            RVertexInputLayout* pInputLayout;
+            /// Vertex buffer.
+            RVertexBuffer* pVertexBuffer;
+            /// Index buffer.
+            RIndexBuffer* pIndexBuffer;
+            /// Vertex stride, in bytes.
+            uint32_t vertexStride;
+            /// Instance vertex constant ring buffer offset.
+            uint32_t instanceVertexGlobalDataOffset;
+            /// Instance vertex constant size, in bytes.
+            uint32_t instanceVertexGlobalDataSize;
+
+            /// Primitive type.
+            ERendererPrimitiveType primitiveType;
+            /// Number of primitives to draw.
+            uint32_t primitiveCount;
+            /// First vertex used.
+            uint32_t startVertex;
+            /// Number of vertices used.
+            uint32_t vertexRange;
+            /// First index to draw.
+            uint32_t startIndex;
+        };
+
+        /// Job for recording a range of shadow depth pass draw calls into a deferred command list.
+        class ShadowDepthRecordJob
         {
         public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshMaterialCompare();
-            explicit SubMeshMaterialCompare( const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
-
-        private:
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+            /// [in] Deferred command proxy to record into.
+            RRenderCommandProxy* pCommandProxy;
+            /// [in] Constant buffer holding the instance vertex constants.
+            RConstantBuffer* pInstanceVertexGlobalDataBuffer;
+            /// [in] First draw call to record.
+            const ShadowDepthDraw* pDraws;
+            /// [in] Number of draw calls to record.
+            size_t drawCount;
+            /// [out] Recorded command list.
+            RRenderCommandListPtr* pspCommandList;
+
+            void Run();
+            static void RunCallback( void* pJob );
+        };
+
+        /// Render pass identifiers stored in the highest bits of sub-mesh sort keys.
+        enum ESortKeyPass
+        {
+            SORT_KEY_PASS_SHADOW_DEPTH,
+            SORT_KEY_PASS_DEPTH_PRE_PASS,
+            SORT_KEY_PASS_BASE,
+
+            SORT_KEY_PASS_MAX
         };
 
         /// Scene view list.
@@ -148,20 +316,71 @@ namespace Helium
         SparseArray< GraphicsSceneObject > m_sceneObjects;
         /// Scene object sub-data list.
         SparseArray< GraphicsSceneObject::SubMeshData > m_sceneObjectSubMeshes;
+        /// Occluder list.
+        SparseArray< Occluder > m_occluders;
+
+        /// Software depth buffer used for occlusion culling.
+        OcclusionBuffer m_occlusionBuffer;
 
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
-        /// Buffered drawing support for the entire scene (presented in all views).
-        BufferedDrawer m_sceneBufferedDrawer;
+        /// Buffered drawing support for the entire scene (presented in all views), one for each render snapshot.
+        BufferedDrawer m_sceneBufferedDrawers[ 2 ];
         /// Pool of buffered drawing objects for various scene views.
         ObjectPool< BufferedDrawer > m_viewBufferedDrawerPool;
-        /// Buffered drawing objects for each scene view.
-        DynamicArray< BufferedDrawer* > m_viewBufferedDrawers;
+        /// Buffered drawing objects for each scene view, one set for each render snapshot.
+        DynamicArray< BufferedDrawer* > m_viewBufferedDrawers[ 2 ];
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
+        /// Sprite batcher captured with each render snapshot.
+        SpriteBatcher m_spriteBatcher;
+
+        /// Scene object bounding spheres, packed into blocks for culling.
+        DynamicArray< CullBlock > m_cullBlocks;
+        /// ID of the scene object stored in each culling slot.
+        DynamicArray< size_t > m_cullSlotSceneObjectIds;
+        /// Culling slot index for each scene object ID.
+        DynamicArray< size_t > m_sceneObjectCullSlots;
+
+        /// Local-space bounds and vertex position dequantization for each scene object ID.
+        DynamicArray< SceneObjectLocalSpace > m_sceneObjectLocalSpaces;
+        /// Scene object transform changes queued since the last update.
+        DynamicArray< SceneObjectTransformUpdate > m_sceneObjectTransformUpdates;
+
+        /// Bounding volume hierarchy of scene object world bounds.
+        AabbTree m_sceneObjectTree;
+        /// Bounding volume hierarchy leaf ID for each scene object ID (invalid until world bounds are set).
+        DynamicArray< size_t > m_sceneObjectTreeLeaves;
+        /// Scene objects whose bounds are fully contained within the frustum being culled (scratch buffer).
+        DynamicArray< size_t > m_containedSceneObjectIds;
+        /// Scene objects whose bounds partially intersect the frustum being culled (scratch buffer).
+        DynamicArray< size_t > m_intersectingSceneObjectIds;
+
+        /// First sub-mesh ID in the sub-mesh list of each scene object ID.
+        DynamicArray< size_t > m_sceneObjectFirstSubMeshIds;
+        /// Next sub-mesh ID belonging to the same scene object, for each sub-mesh ID.
+        DynamicArray< size_t > m_nextSubMeshIds;
+
+        /// Render snapshot draw record index for each scene object ID (invalid outside of snapshot capture).
+        DynamicArray< size_t > m_sceneObjectRecordIndices;
+        /// Render snapshot draw record index for each sub-mesh ID (invalid outside of snapshot capture).
+        DynamicArray< size_t > m_subMeshRecordIndices;
+        /// Scene object ID captured in each render snapshot scene object record (scratch buffer).
+        DynamicArray< size_t > m_recordSceneObjectIds;
+        /// Sub-mesh ID captured in each render snapshot sub-mesh record (scratch buffer).
+        DynamicArray< size_t > m_recordSubMeshIds;
+
         /// Visible scene objects for the current view.
         BitArray<> m_visibleSceneObjects;
+        /// IDs of the visible scene objects for the current view.
+        DynamicArray< size_t > m_visibleSceneObjectIds;
         /// Scene object sub-data index list (for sorting during rendering).
         DynamicArray< size_t > m_sceneObjectSubMeshIndices;
+        /// Packed sort keys for each visible sub-mesh.
+        DynamicArray< uint64_t > m_subMeshSortKeys;
+        /// Scratch buffer for sorting sub-mesh sort keys.
+        DynamicArray< uint64_t > m_subMeshSortScratch;
+        /// View depth of each visible sub-mesh (scratch buffer for building sort keys).
+        DynamicArray< float32_t > m_subMeshSortDepths;
 
         /// Ambient light top color.
         Color m_ambientLightTopColor;
@@ -185,47 +404,90 @@ namespace Helium
         /// Pre-computed shadow depth pass inverse view/projection matrices.
         DynamicArray< Simd::Matrix44 > m_shadowViewInverseViewProjectionMatrices;
 
-        /// Per-view global vertex constant buffers.
-        DynamicArray< RConstantBufferPtr > m_viewVertexGlobalDataBuffers[ 2 ];
-        /// Per-view base-pass vertex constant buffers.
-        DynamicArray< RConstantBufferPtr > m_viewVertexBasePassDataBuffers[ 2 ];
-        /// Per-view screen-space vertex constant buffers.
-        DynamicArray< RConstantBufferPtr > m_viewVertexScreenDataBuffers[ 2 ];
-
-        /// Per-view base-pass pixel constant buffers.
-        DynamicArray< RConstantBufferPtr > m_viewPixelBasePassDataBuffers[ 2 ];
-
-        /// Per-view vertex constant buffers for shadow depth rendering.
-        DynamicArray< RConstantBufferPtr > m_shadowViewVertexDataBuffers[ 2 ];
+        /// Per-frame ring buffer from which all dynamic view and instance shader constants are allocated.
+        ConstantBufferRing m_constantBufferRing;
 
-        /// Pool of per-instance vertex constant buffers for non-skinned meshes.
-        DynamicArray< RConstantBufferPtr > m_staticInstanceVertexGlobalDataBufferPool[ 2 ];
-        /// Pool of per-instance vertex constant buffers for skinned meshes.
-        DynamicArray< RConstantBufferPtr > m_skinnedInstanceVertexGlobalDataBufferPool[ 2 ];
+        /// Per-view constant ring buffer offsets for the current frame.
+        DynamicArray< ViewConstantBufferOffsets > m_viewConstantBufferOffsets;
 
-        /// Scene object global vertex constant buffers.
-        DynamicArray< RConstantBuffer* > m_objectVertexGlobalDataBuffers;
+        /// Scene object global vertex constant ring buffer offsets (invalid if not allocated).
+        DynamicArray< uint32_t > m_objectVertexGlobalDataOffsets;
         /// Mapped scene object global vertex constant buffer addresses.
         DynamicArray< float32_t* > m_mappedObjectVertexGlobalDataBuffers;
 
-        /// Sub-mesh global vertex constant buffers.
-        DynamicArray< RConstantBuffer* > m_subMeshVertexGlobalDataBuffers;
+        /// Sub-mesh global vertex constant ring buffer offsets (invalid if not allocated).
+        DynamicArray< uint32_t > m_subMeshVertexGlobalDataOffsets;
         /// Mapped sub-mesh global veretex constant buffer addresses.
         DynamicArray< float32_t* > m_mappedSubMeshVertexGlobalDataBuffers;
 
-        /// Current dynamic constant buffer set index.
-        size_t m_constantBufferSetIndex;
+        /// Resolved shadow depth pass draw calls for the view being rendered.
+        DynamicArray< ShadowDepthDraw > m_shadowDepthDraws;
+        /// Deferred command proxies used to record the shadow depth pass in parallel (one per job).
+        DynamicArray< RRenderCommandProxyPtr > m_shadowDepthCommandProxies;
+        /// Shadow depth pass command lists recorded by each job.
+        DynamicArray< RRenderCommandListPtr > m_shadowDepthCommandLists;
+
+        /// Per-instance transform vertex buffer shared by all instanced draw calls.
+        RVertexBufferPtr m_spInstanceVertexBuffer;
+        /// Index of the next unused instance in the shared instance vertex buffer.
+        size_t m_instanceVertexBufferOffset;
+
+        /// Render snapshots (one being rendered while the other is captured for the next frame).
+        RenderSnapshot m_renderSnapshots[ 2 ];
+        /// Snapshot currently being rendered (null until the first snapshot is captured).
+        RenderSnapshot* m_pRenderSnapshot;
+        /// Index of the snapshot currently being rendered (the game thread captures into and records buffered draw
+        /// calls for the other one).
+        size_t m_renderSnapshotIndex;
+
+        /// True if scene objects hidden behind occluders should be culled.
+        bool m_bOcclusionCulling;
+
+        /// @name Scene Object Updating
+        //@{
+        void ApplySceneObjectTransformUpdates();
+        void UpdateSceneObjectCullBounds( size_t id );
+        //@}
+
+        /// @name Render Snapshot Capture
+        //@{
+        void CaptureRenderSnapshot( RenderSnapshot& rSnapshot );
+        void CaptureSceneViewVisibility( uint_fast32_t viewIndex, ViewVisibility& rVisibility );
+        void GatherVisibleSubMeshes( DynamicArray< size_t >& rSubMeshIds ) const;
+        void CaptureDrawRecords( RenderSnapshot& rSnapshot );
+        size_t AssignDrawRecords( DynamicArray< size_t >& rSubMeshIds );
+
+        void SetCullSlotSphere( size_t slotIndex, const Simd::Sphere& rSphere );
+        void CullSceneObjects( const Simd::Frustum& rFrustum );
+        bool CullOccludedSceneObjects( uint_fast32_t viewIndex );
+
+        void RequestTextureMipLevels( uint_fast32_t viewIndex, const DynamicArray< size_t >& rSubMeshIds );
+        void ResolveMaterialShaderVariants( const RenderSnapshot& rSnapshot );
+        //@}
 
         /// @name Rendering
         //@{
         void UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIndex );
         void UpdateShadowInverseViewProjectionMatrixLspsm( size_t viewIndex );
 
-        void SwapDynamicConstantBuffers();
+        void UpdateDynamicConstantBuffers();
+        bool GetInstanceVertexGlobalDataRange(
+            size_t subMeshIndex, size_t sceneObjectId, uint32_t& rOffset, uint32_t& rSize ) const;
 
         void DrawSceneView( uint_fast32_t viewIndex );
 
+        void ComputeSubMeshSortDepths( const Simd::Vector3& rDirection, float32_t& rMinDepth, float32_t& rDepthScale );
+        void SortSubMeshesFrontToBack( ESortKeyPass pass, const Simd::Vector3& rDirection );
+        void SortSubMeshesByMaterial( const Simd::Vector3& rViewDirection );
+        void SortSubMeshKeys();
+
+        size_t GetInstanceRunLength( size_t meshIndexIndex, bool bMatchMaterial ) const;
+        bool WriteInstanceData( size_t meshIndexIndex, size_t instanceCount, uint32_t& rByteOffset );
+
         void DrawShadowDepthPass( uint_fast32_t viewIndex );
+        static void RecordShadowDepthDraws(
+            RRenderCommandProxy* pCommandProxy, RConstantBuffer* pInstanceVertexGlobalDataBuffer,
+            const ShadowDepthDraw* pDraws, size_t drawCount );
         void DrawDepthPrePass( uint_fast32_t viewIndex );
         void DrawBasePass( uint_fast32_t viewIndex );
         //@}
@@ -237,6 +499,8 @@ namespace Helium
         static Name GetSkinningSysSelectName();
         static Name GetSkinningSmoothOptionName();
         static Name GetSkinningRigidOptionName();
+
+        static Name GetInstancingToggleName();
         //@}
     };
 }
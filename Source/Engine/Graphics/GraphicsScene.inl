@@ -45,6 +45,37 @@ namespace Helium
         return &m_sceneObjectSubMeshes[ id ];
     }
 
+    /// Set whether scene objects hidden behind occluders are culled when drawing.
+    ///
+    /// @param[in] bEnabled  True to enable occlusion culling, false to disable it.
+    ///
+    /// @see IsOcclusionCullingEnabled(), AllocateOccluder()
+    void GraphicsScene::SetOcclusionCullingEnabled( bool bEnabled )
+    {
+        m_bOcclusionCulling = bEnabled;
+    }
+
+    /// Get whether scene objects hidden behind occluders are culled when drawing.
+    ///
+    /// @return  True if occlusion culling is enabled, false if not.
+    ///
+    /// @see SetOcclusionCullingEnabled()
+    bool GraphicsScene::IsOcclusionCullingEnabled() const
+    {
+        return m_bOcclusionCulling;
+    }
+
+    /// Get the software depth buffer used for occlusion culling.
+    ///
+    /// The buffer holds the occluders rasterized for the most recently drawn scene view, which can be useful for
+    /// debugging.
+    ///
+    /// @return  Occlusion depth buffer.
+    const OcclusionBuffer& GraphicsScene::GetOcclusionBuffer() const
+    {
+        return m_occlusionBuffer;
+    }
+
     /// Get the ambient light color for upward-facing normals.
     ///
     /// @return  Ambient light color for upward-facing normals.
@@ -121,14 +152,27 @@ namespace Helium
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
     /// Get the buffered drawing interface for the entire scene.
     ///
-    /// Draw calls buffered through this interface will be presented on all views for this scene.
+    /// Draw calls buffered through this interface will be presented on all views for this scene.  The scene keeps a
+    /// separate drawer for each render snapshot, so the returned drawer changes every update and should not be cached
+    /// across frames.
     ///
     /// @return  Reference to the buffered drawing interface for this scene.
     ///
     /// @see GetSceneViewBufferedDrawer()
     BufferedDrawer& GraphicsScene::GetSceneBufferedDrawer()
     {
-        return m_sceneBufferedDrawer;
+        return m_sceneBufferedDrawers[ m_renderSnapshotIndex ^ 1 ];
     }
 #endif  // !HELIUM_RELEASE && !HELIUM_PROFILE
+
+    /// Get the sprite batcher for this scene.
+    ///
+    /// Sprites added to the batcher are captured with the render snapshot during the next Update() and drawn in each
+    /// scene view after the base pass.
+    ///
+    /// @return  Reference to the sprite batcher for this scene.
+    SpriteBatcher& GraphicsScene::GetSpriteBatcher()
+    {
+        return m_spriteBatcher;
+    }
 }
@@ -3,6 +3,7 @@
 
 #include "Rendering/RConstantBuffer.h"
 #include "Rendering/Renderer.h"
+#include "Graphics/ShaderVariantCache.h"
 #include "Graphics/Texture.h"
 
 #include "Reflect/TranslatorDeduction.h"
@@ -19,12 +20,16 @@ using namespace Helium;
 
 /// Constructor.
 Material::Material()
+	: m_shaderVariantResolveFrame( 0 )
 {
+	SetInvalid( m_shaderVariantCacheMaterialIndex );
+
 	MemoryZero( m_persistentResourceData.m_shaderVariantIndices, sizeof( m_persistentResourceData.m_shaderVariantIndices ) );
 
 	for( size_t shaderTypeIndex = 0; shaderTypeIndex < HELIUM_ARRAY_COUNT( m_persistentResourceData.m_shaderVariantIndices ); ++shaderTypeIndex )
 	{
 		SetInvalid( m_shaderVariantLoadIds[ shaderTypeIndex ] );
+		SetInvalid( m_shaderVariantCacheIndices[ shaderTypeIndex ] );
 		SetInvalid( m_constantBufferLoadIds[ shaderTypeIndex ] );
 	}
 
@@ -36,6 +41,7 @@ Material::Material()
 /// Destructor.
 Material::~Material()
 {
+	ReleaseShaderVariantCacheEntries();
 }
 
 
@@ -154,9 +160,18 @@ bool Material::BeginPrecacheResourceData()
 	}
 #endif
 
-	// Preload shader variant resources.
+	ReleaseShaderVariantCacheEntries();
+
+	// Preload shader variant resources, unless they can be resolved on demand through the shader variant cache.  Tools
+	// builds always preload variants, as synchronizing the material parameters with the shader requires them.
+#if HELIUM_TOOLS
+	bool bDeferShaderVariants = false;
+#else
+	bool bDeferShaderVariants = ( ShaderVariantCache::GetInstance() != NULL );
+#endif
+
 	Shader* pShader = m_spShader;
-	if( !pShader )
+	if( !pShader || bDeferShaderVariants )
 	{
 		for( size_t shaderTypeIndex = 0; shaderTypeIndex < HELIUM_ARRAY_COUNT( m_shaderVariants ); ++shaderTypeIndex )
 		{
@@ -298,6 +313,98 @@ bool Helium::Material::LoadPersistentResourceObject( Reflect::ObjectPtr &_object
 	return true;
 }
 
+/// Resolve the shader variants of this material that were not preloaded through the shader variant cache.
+///
+/// Each variant is acquired from the cache the first time the material is resolved, and loaded asynchronously if it
+/// is not already cached.  Variants that have finished loading are picked up for GetShaderVariant() to return, and
+/// are marked as used in the current frame.  Once a material has gone ShaderVariantCache::MATERIAL_IDLE_FRAME_COUNT
+/// frames without being resolved, the cache releases its entries and variants until it is resolved again.
+///
+/// This must be called on the game thread (while nothing is being drawn) for each material about to be drawn, as
+/// GetShaderVariant() only returns variants that have already been resolved and never touches the cache itself.
+///
+/// @see GetShaderVariant()
+void Material::ResolveShaderVariants()
+{
+	ShaderVariantCache* pShaderVariantCache = ShaderVariantCache::GetInstance();
+	Shader* pShader = m_spShader;
+	if( !pShaderVariantCache || !pShader )
+	{
+		return;
+	}
+
+	m_shaderVariantResolveFrame = pShaderVariantCache->GetFrameIndex();
+
+	for( size_t shaderTypeIndex = 0; shaderTypeIndex < HELIUM_ARRAY_COUNT( m_shaderVariantCacheIndices ); ++shaderTypeIndex )
+	{
+		// Variants preloaded with the material are not tracked by the cache.
+		size_t entryIndex = m_shaderVariantCacheIndices[ shaderTypeIndex ];
+		if( IsInvalid( entryIndex ) )
+		{
+			if( m_shaderVariants[ shaderTypeIndex ] || IsValid( m_shaderVariantLoadIds[ shaderTypeIndex ] ) )
+			{
+				continue;
+			}
+
+			entryIndex = pShaderVariantCache->Acquire(
+				pShader,
+				static_cast< RShader::EType >( shaderTypeIndex ),
+				m_persistentResourceData.m_shaderVariantIndices[ shaderTypeIndex ] );
+			if( IsInvalid( entryIndex ) )
+			{
+				continue;
+			}
+
+			m_shaderVariantCacheIndices[ shaderTypeIndex ] = entryIndex;
+
+			// Let the cache release the entry again once this material stops being drawn.
+			if( IsInvalid( m_shaderVariantCacheMaterialIndex ) )
+			{
+				m_shaderVariantCacheMaterialIndex = pShaderVariantCache->AddMaterial( this );
+			}
+		}
+
+		ShaderVariant* pVariant = pShaderVariantCache->GetVariant( entryIndex );
+		if( m_shaderVariants[ shaderTypeIndex ].Get() != pVariant )
+		{
+			m_shaderVariants[ shaderTypeIndex ] = pVariant;
+		}
+	}
+}
+
+/// Release any shader variant cache entries acquired by this material, along with the variants resolved from them, and
+/// stop the cache from tracking this material.
+void Material::ReleaseShaderVariantCacheEntries()
+{
+	ShaderVariantCache* pShaderVariantCache = ShaderVariantCache::GetInstance();
+
+	for( size_t shaderTypeIndex = 0; shaderTypeIndex < HELIUM_ARRAY_COUNT( m_shaderVariantCacheIndices ); ++shaderTypeIndex )
+	{
+		size_t entryIndex = m_shaderVariantCacheIndices[ shaderTypeIndex ];
+		if( IsValid( entryIndex ) )
+		{
+			m_shaderVariants[ shaderTypeIndex ].Release();
+
+			if( pShaderVariantCache )
+			{
+				pShaderVariantCache->Release( entryIndex );
+			}
+		}
+
+		SetInvalid( m_shaderVariantCacheIndices[ shaderTypeIndex ] );
+	}
+
+	if( IsValid( m_shaderVariantCacheMaterialIndex ) )
+	{
+		if( pShaderVariantCache )
+		{
+			pShaderVariantCache->RemoveMaterial( m_shaderVariantCacheMaterialIndex );
+		}
+
+		SetInvalid( m_shaderVariantCacheMaterialIndex );
+	}
+}
+
 /// @copydoc Resource::GetCacheName()
 Name Material::GetCacheName() const
 {
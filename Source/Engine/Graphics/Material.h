@@ -26,6 +26,8 @@ namespace Helium
 	{
 		HELIUM_DECLARE_ASSET( Material, Resource );
 
+		friend class ShaderVariantCache;
+
 	public:
 		/// Scalar floating-point parameter.
 		struct HELIUM_GRAPHICS_API Float1Parameter : Reflect::Struct
@@ -150,6 +152,8 @@ namespace Helium
 		inline Shader* GetShader() const;
 		inline uint32_t GetShaderVariantIndex( RShader::EType shaderType ) const;
 		inline ShaderVariant* GetShaderVariant( RShader::EType shaderType ) const;
+		void ResolveShaderVariants();
+		inline uint32_t GetShaderVariantResolveFrame() const;
 
 		inline RConstantBuffer* GetConstantBuffer( RShader::EType shaderType ) const;
 
@@ -187,15 +191,27 @@ namespace Helium
 		//@}
 
 	private:
+		/// @name Private Utility Functions
+		//@{
+		void ReleaseShaderVariantCacheEntries();
+		//@}
+
 		/// Material shader.
 		//AssetPtr m_spShaderAsAsset;
 		ShaderPtr m_spShader;
 		PersistentResourceData m_persistentResourceData;
 
-		/// Cached references to the specific shader variants used by this material.
+		/// Cached references to the specific shader variants used by this material (either preloaded or resolved through
+		/// the shader variant cache).
 		ShaderVariantPtr m_shaderVariants[ RShader::TYPE_MAX ];
 		/// Shader variant load IDs.
 		size_t m_shaderVariantLoadIds[ RShader::TYPE_MAX ];
+		/// Shader variant cache entries for variants resolved on demand.
+		size_t m_shaderVariantCacheIndices[ RShader::TYPE_MAX ];
+		/// Index of this material in the shader variant cache's list of materials holding entries.
+		size_t m_shaderVariantCacheMaterialIndex;
+		/// Shader variant cache frame in which the shader variants were last resolved.
+		uint32_t m_shaderVariantResolveFrame;
 
 		/// Constant buffers for material parameters.
 		RConstantBufferPtr m_constantBuffers[ RShader::TYPE_MAX ];
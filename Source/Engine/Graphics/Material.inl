@@ -24,7 +24,10 @@ namespace Helium
     ///
     /// @param[in] shaderType  Shader type.
     ///
-    /// @return  Shader variant resource.
+    /// @return  Shader variant resource, or null if the variant is not available (or is still being loaded through the
+    ///          shader variant cache).
+    ///
+    /// @see ResolveShaderVariants()
     ShaderVariant* Material::GetShaderVariant( RShader::EType shaderType ) const
     {
         HELIUM_ASSERT( static_cast< size_t >( shaderType ) < static_cast< size_t >( RShader::TYPE_MAX ) );
@@ -32,6 +35,16 @@ namespace Helium
         return m_shaderVariants[ shaderType ];
     }
 
+    /// Get the shader variant cache frame in which ResolveShaderVariants() was last called for this material.
+    ///
+    /// @return  Cache frame index of the last variant resolve.
+    ///
+    /// @see ResolveShaderVariants(), ShaderVariantCache::GetFrameIndex()
+    uint32_t Material::GetShaderVariantResolveFrame() const
+    {
+        return m_shaderVariantResolveFrame;
+    }
+
     /// Get the constant buffer render resource for the specified shader type.
     ///
     /// @param[in] shaderType  Shader type.
@@ -4,6 +4,7 @@
 #include "Engine/AsyncLoader.h"
 #include "MathSimd/Matrix44.h"
 #include "Engine/CacheManager.h"
+#include "Engine/MemoryTracker.h"
 #include "Rendering/RIndexBuffer.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RVertexBuffer.h"
@@ -20,7 +21,9 @@ using namespace Helium;
 
 /// Constructor.
 Mesh::Mesh()
-: m_vertexBufferLoadId( Invalid< size_t >() )
+: m_bQuantizeVertices( false )
+, m_bOccluder( false )
+, m_vertexBufferLoadId( Invalid< size_t >() )
 , m_indexBufferLoadId( Invalid< size_t >() )
 {
 }
@@ -49,6 +52,8 @@ void Mesh::RefCountPreDestroy()
 void Mesh::PopulateMetaType(Reflect::MetaStruct& comp)
 {
     comp.AddField(&Mesh::m_materials, "m_materials");
+    comp.AddField(&Mesh::m_bQuantizeVertices, "m_bQuantizeVertices");
+    comp.AddField(&Mesh::m_bOccluder, "m_bOccluder");
 }
 
 /// @copydoc Asset::NeedsPrecacheResourceData()
@@ -69,6 +74,8 @@ bool Mesh::BeginPrecacheResourceData()
         return true;
     }
 
+    HELIUM_MEMORY_SCOPE( MEMORY_TAG_MESH );
+
     if( m_persistentResourceData.m_vertexCount != 0 )
     {
         size_t vertexDataSize = GetSubDataSize( 0 );
@@ -212,6 +219,7 @@ bool Mesh::TryFinishPrecacheResourceData()
 Mesh::PersistentResourceData::PersistentResourceData()
 : m_vertexCount( 0 )
 , m_triangleCount( 0 )
+, m_bQuantizedPositions( false )
 #if !HELIUM_USE_GRANNY_ANIMATION
 , m_boneCount( 0 )
 #endif
@@ -227,6 +235,9 @@ void Mesh::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &PersistentResourceData::m_vertexCount,              "m_vertexCount" );
     comp.AddField( &PersistentResourceData::m_triangleCount,            "m_triangleCount" );
     comp.AddField( &PersistentResourceData::m_bounds,                   "m_bounds" );
+    comp.AddField( &PersistentResourceData::m_bQuantizedPositions,      "m_bQuantizedPositions" );
+    comp.AddField( &PersistentResourceData::m_occluderVertices,         "m_occluderVertices" );
+    comp.AddField( &PersistentResourceData::m_occluderIndices,          "m_occluderIndices" );
 #if !HELIUM_USE_GRANNY_ANIMATION
     comp.AddField( &PersistentResourceData::m_boneCount,                "m_boneCount" );
     comp.AddField( &PersistentResourceData::m_pBoneNames,               "m_pBoneNames" );
@@ -248,6 +259,19 @@ bool Helium::Mesh::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 
     _object->CopyTo(&m_persistentResourceData);
 
+    // Drop malformed occluder data rather than risk reading out of bounds when rasterizing.
+    if( m_persistentResourceData.m_occluderVertices.GetSize() % 3 != 0 ||
+        m_persistentResourceData.m_occluderIndices.GetSize() % 3 != 0 )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            "Mesh::LoadPersistentResourceObject(): Malformed occluder data in mesh \"%s\".\n",
+            *GetPath().ToString() );
+
+        m_persistentResourceData.m_occluderVertices.Clear();
+        m_persistentResourceData.m_occluderIndices.Clear();
+    }
+
     return true;
 }
 
@@ -283,3 +307,35 @@ const uint8_t* Mesh::GetSectionSkinningPaletteMap( size_t sectionIndex ) const
 
     return m_persistentResourceData.m_skinningPaletteMap.GetData() + sectionIndex * boneCount;
 }
+
+/// Compute the parameters used to quantize vertex positions for a mesh with the given bounds.
+///
+/// Quantized positions are stored relative to the center of the mesh bounds, scaled uniformly so that the largest
+/// bounds half-extent maps to the range [-1, 1].  A uniform scale is used so that the dequantization can be folded
+/// into the mesh world transform without affecting normal and tangent directions.
+///
+/// @param[in]  rBounds   Mesh bounds.
+/// @param[out] rOffset   Offset to add to dequantized positions.
+/// @param[out] rScale    Scale to apply to quantized positions (in the range [-1, 1]) prior to adding the offset.
+///
+/// @see HasQuantizedPositions()
+void Mesh::GetPositionQuantization( const Simd::AaBox& rBounds, Simd::Vector3& rOffset, float32_t& rScale )
+{
+    const Simd::Vector3& rMinimum = rBounds.GetMinimum();
+    const Simd::Vector3& rMaximum = rBounds.GetMaximum();
+
+    rScale = 0.0f;
+    for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+    {
+        float32_t minimum = rMinimum.GetElement( axisIndex );
+        float32_t maximum = rMaximum.GetElement( axisIndex );
+        rOffset.SetElement( axisIndex, ( minimum + maximum ) * 0.5f );
+        rScale = Max( rScale, ( maximum - minimum ) * 0.5f );
+    }
+
+    // Avoid a degenerate transform for meshes collapsed to a single point.
+    if( rScale < HELIUM_EPSILON )
+    {
+        rScale = 1.0f;
+    }
+}
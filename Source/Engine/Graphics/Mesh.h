@@ -58,6 +58,14 @@ namespace Helium
         
             /// Mesh bounds.
             Simd::AaBox m_bounds;
+
+            /// True if vertex positions are stored in QuantizedStaticMeshVertex format.
+            bool m_bQuantizedPositions;
+
+            /// Simplified occluder vertex positions (three floats per vertex, empty if not an occluder).
+            DynamicArray< float32_t > m_occluderVertices;
+            /// Simplified occluder triangle list indices.
+            DynamicArray< uint16_t > m_occluderIndices;
         
 #if !HELIUM_USE_GRANNY_ANIMATION
             /// Bone count (if the mesh is a skinned mesh).  Note we place this variable separate from the other skinned
@@ -130,6 +138,17 @@ namespace Helium
 
         inline const Simd::AaBox& GetBounds() const;
 
+        inline bool GetQuantizeVertices() const;
+        inline bool HasQuantizedPositions() const;
+        static void GetPositionQuantization( const Simd::AaBox& rBounds, Simd::Vector3& rOffset, float32_t& rScale );
+
+        inline bool GetOccluder() const;
+        inline bool HasOccluderData() const;
+        inline const float32_t* GetOccluderVertices() const;
+        inline uint32_t GetOccluderVertexCount() const;
+        inline const uint16_t* GetOccluderIndices() const;
+        inline uint32_t GetOccluderTriangleCount() const;
+
         inline RVertexBuffer* GetVertexBuffer() const;
         inline RIndexBuffer* GetIndexBuffer() const;
         //@}
@@ -143,6 +162,10 @@ namespace Helium
 
         /// Default material set.
         DynamicArray< MaterialPtr > m_materials;
+        /// True to store static mesh vertices in quantized format when caching.
+        bool m_bQuantizeVertices;
+        /// True to build a simplified occluder mesh for occlusion culling when caching.
+        bool m_bOccluder;
         
         /// Vertex buffer.
         RVertexBufferPtr m_spVertexBuffer;
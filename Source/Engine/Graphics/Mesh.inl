@@ -171,6 +171,89 @@ namespace Helium
         return m_persistentResourceData.m_bounds;
     }
 
+    /// Get whether static mesh vertices should be stored in quantized format when this mesh is cached.
+    ///
+    /// @return  True if vertices should be quantized, false if not.
+    ///
+    /// @see HasQuantizedPositions()
+    bool Mesh::GetQuantizeVertices() const
+    {
+        return m_bQuantizeVertices;
+    }
+
+    /// Get whether the vertex buffer for this mesh stores quantized vertex positions.
+    ///
+    /// If positions are quantized, vertices are stored using the QuantizedStaticMeshVertex layout, and the
+    /// transform returned by GetPositionQuantization() must be applied to restore positions in mesh space.
+    ///
+    /// @return  True if vertex positions are quantized, false if not.
+    ///
+    /// @see GetPositionQuantization(), GetQuantizeVertices()
+    bool Mesh::HasQuantizedPositions() const
+    {
+        return m_persistentResourceData.m_bQuantizedPositions;
+    }
+
+    /// Get whether a simplified occluder mesh should be built for this mesh when it is cached.
+    ///
+    /// @return  True if this mesh should be used as an occluder, false if not.
+    ///
+    /// @see HasOccluderData()
+    bool Mesh::GetOccluder() const
+    {
+        return m_bOccluder;
+    }
+
+    /// Get whether this mesh has simplified occluder geometry for occlusion culling.
+    ///
+    /// @return  True if occluder geometry is available, false if not.
+    ///
+    /// @see GetOccluderVertices(), GetOccluderIndices(), GetOccluder()
+    bool Mesh::HasOccluderData() const
+    {
+        return !m_persistentResourceData.m_occluderIndices.IsEmpty();
+    }
+
+    /// Get the simplified occluder vertex positions.
+    ///
+    /// @return  Occluder vertex positions (three floats per vertex), or null if there is no occluder data.
+    ///
+    /// @see GetOccluderVertexCount(), GetOccluderIndices()
+    const float32_t* Mesh::GetOccluderVertices() const
+    {
+        return m_persistentResourceData.m_occluderVertices.GetData();
+    }
+
+    /// Get the number of simplified occluder vertices.
+    ///
+    /// @return  Occluder vertex count.
+    ///
+    /// @see GetOccluderVertices()
+    uint32_t Mesh::GetOccluderVertexCount() const
+    {
+        return static_cast< uint32_t >( m_persistentResourceData.m_occluderVertices.GetSize() / 3 );
+    }
+
+    /// Get the simplified occluder triangle list indices.
+    ///
+    /// @return  Occluder triangle indices, or null if there is no occluder data.
+    ///
+    /// @see GetOccluderTriangleCount(), GetOccluderVertices()
+    const uint16_t* Mesh::GetOccluderIndices() const
+    {
+        return m_persistentResourceData.m_occluderIndices.GetData();
+    }
+
+    /// Get the number of simplified occluder triangles.
+    ///
+    /// @return  Occluder triangle count.
+    ///
+    /// @see GetOccluderIndices()
+    uint32_t Mesh::GetOccluderTriangleCount() const
+    {
+        return static_cast< uint32_t >( m_persistentResourceData.m_occluderIndices.GetSize() / 3 );
+    }
+
     /// Get the vertex buffer for this mesh.
     ///
     /// @return  Vertex buffer.
@@ -0,0 +1,542 @@
+#include "Precompile.h"
+#include "Graphics/OcclusionBuffer.h"
+
+#include "MathSimd/Matrix44Soa.h"
+#include "MathSimd/Vector4.h"
+#include "MathSimd/Vector4Soa.h"
+
+using namespace Helium;
+
+/// Depth value to which the buffer is cleared (farther than any occluder).
+static const float32_t OCCLUSION_DEPTH_FAR = 1.0e30f;
+/// Smallest clip-space w-coordinate treated as being in front of the near plane.
+static const float32_t OCCLUSION_CLIP_W_MIN = 1.0e-4f;
+/// Smallest screen-space triangle area (in square pixels) worth rasterizing.
+static const float32_t OCCLUSION_TRIANGLE_AREA_MIN = 1.0e-6f;
+
+/// Constructor.
+OcclusionBuffer::OcclusionBuffer()
+	: m_viewProjection( Simd::Matrix44::IDENTITY )
+	, m_width( 0 )
+	, m_height( 0 )
+	, m_tileCountX( 0 )
+	, m_tileCountY( 0 )
+	, m_rasterizedTriangleCount( 0 )
+{
+	SetResolution( DEFAULT_WIDTH, DEFAULT_HEIGHT );
+}
+
+/// Set the resolution of the depth buffer.
+///
+/// Both dimensions are rounded up to a multiple of TILE_SIZE.  The buffer is cleared, so this should be called before
+/// Clear() for the frame in which the new resolution is to be used.
+///
+/// @param[in] width   Requested width, in pixels.
+/// @param[in] height  Requested height, in pixels.
+///
+/// @see GetWidth(), GetHeight()
+void OcclusionBuffer::SetResolution( uint32_t width, uint32_t height )
+{
+	m_tileCountX = Max< uint32_t >( ( width + TILE_SIZE - 1 ) / TILE_SIZE, 1 );
+	m_tileCountY = Max< uint32_t >( ( height + TILE_SIZE - 1 ) / TILE_SIZE, 1 );
+	m_width = m_tileCountX * TILE_SIZE;
+	m_height = m_tileCountY * TILE_SIZE;
+
+	m_depth.Resize( static_cast< size_t >( m_width ) * m_height );
+	m_tileDepths.Resize( static_cast< size_t >( m_tileCountX ) * m_tileCountY );
+
+	Clear( m_viewProjection );
+}
+
+/// Clear the depth buffer and set the view for the next set of occluders.
+///
+/// @param[in] rViewProjection  Combined view/projection matrix of the view being culled.
+void OcclusionBuffer::Clear( const Simd::Matrix44& rViewProjection )
+{
+	m_viewProjection = rViewProjection;
+	m_rasterizedTriangleCount = 0;
+
+	size_t pixelCount = m_depth.GetSize();
+	float32_t* pDepth = m_depth.GetData();
+	for ( size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex )
+	{
+		pDepth[pixelIndex] = OCCLUSION_DEPTH_FAR;
+	}
+
+	size_t tileCount = m_tileDepths.GetSize();
+	float32_t* pTileDepths = m_tileDepths.GetData();
+	for ( size_t tileIndex = 0; tileIndex < tileCount; ++tileIndex )
+	{
+		pTileDepths[tileIndex] = OCCLUSION_DEPTH_FAR;
+	}
+}
+
+/// Rasterize an occluder mesh into the depth buffer.
+///
+/// @param[in] rWorldTransform  Occluder world transform.
+/// @param[in] pVertices        Occluder vertex positions (three floats per vertex).
+/// @param[in] vertexCount      Number of occluder vertices.
+/// @param[in] pIndices         Occluder triangle list indices.
+/// @param[in] triangleCount    Number of occluder triangles.
+///
+/// @see Clear(), BuildHierarchy()
+void OcclusionBuffer::RasterizeOccluder(
+	const Simd::Matrix44& rWorldTransform,
+	const float32_t* pVertices,
+	uint32_t vertexCount,
+	const uint16_t* pIndices,
+	uint32_t triangleCount )
+{
+	if ( vertexCount == 0 || triangleCount == 0 )
+	{
+		return;
+	}
+
+	HELIUM_ASSERT( pVertices );
+	HELIUM_ASSERT( pIndices );
+
+	Simd::Matrix44 worldViewProjection;
+	worldViewProjection.MultiplySet( rWorldTransform, m_viewProjection );
+
+	TransformVertices( worldViewProjection, pVertices, vertexCount );
+
+	for ( uint32_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex, pIndices += 3 )
+	{
+		HELIUM_ASSERT( pIndices[0] < vertexCount );
+		HELIUM_ASSERT( pIndices[1] < vertexCount );
+		HELIUM_ASSERT( pIndices[2] < vertexCount );
+
+		RasterizeTriangle( pIndices[0], pIndices[1], pIndices[2] );
+	}
+}
+
+/// Compute the farthest depth of each tile of the depth buffer.
+///
+/// This must be called after all occluders have been rasterized and before testing for occlusion.
+///
+/// @see IsBoxOccluded()
+void OcclusionBuffer::BuildHierarchy()
+{
+	const float32_t* pDepth = m_depth.GetData();
+	float32_t* pTileDepths = m_tileDepths.GetData();
+
+	for ( uint32_t tileY = 0; tileY < m_tileCountY; ++tileY )
+	{
+		for ( uint32_t tileX = 0; tileX < m_tileCountX; ++tileX )
+		{
+			const float32_t* pTileRow = pDepth + static_cast< size_t >( tileY ) * TILE_SIZE * m_width + tileX * TILE_SIZE;
+
+#if HELIUM_SIMD_SSE
+			Simd::Register farthest = Simd::LoadUnaligned( pTileRow );
+			for ( uint32_t rowIndex = 0; rowIndex < TILE_SIZE; ++rowIndex, pTileRow += m_width )
+			{
+				for ( uint32_t columnIndex = 0; columnIndex < TILE_SIZE; columnIndex += 4 )
+				{
+					farthest = Simd::MaxF32( farthest, Simd::LoadUnaligned( pTileRow + columnIndex ) );
+				}
+			}
+
+			HELIUM_SIMD_ALIGN_PRE float32_t lanes[4] HELIUM_SIMD_ALIGN_POST;
+			Simd::StoreAligned( lanes, farthest );
+			float32_t tileDepth = Max( Max( lanes[0], lanes[1] ), Max( lanes[2], lanes[3] ) );
+#else
+			float32_t tileDepth = pTileRow[0];
+			for ( uint32_t rowIndex = 0; rowIndex < TILE_SIZE; ++rowIndex, pTileRow += m_width )
+			{
+				for ( uint32_t columnIndex = 0; columnIndex < TILE_SIZE; ++columnIndex )
+				{
+					tileDepth = Max( tileDepth, pTileRow[columnIndex] );
+				}
+			}
+#endif
+
+			pTileDepths[tileY * m_tileCountX + tileX] = tileDepth;
+		}
+	}
+}
+
+/// Test whether a world-space bounding box is hidden behind the occluders rasterized into the buffer.
+///
+/// The box is projected to screen space, and it is considered occluded only if its nearest depth is behind the
+/// farthest depth of every tile touched by its screen-space bounds.  Boxes crossing the near plane or lying
+/// entirely off-screen are never reported as occluded.
+///
+/// @param[in] rBox  World-space bounding box.
+///
+/// @return  True if the box is definitely hidden, false if it may be visible.
+///
+/// @see BuildHierarchy()
+bool OcclusionBuffer::IsBoxOccluded( const Simd::AaBox& rBox ) const
+{
+	const Simd::Vector3& rMinimum = rBox.GetMinimum();
+	const Simd::Vector3& rMaximum = rBox.GetMaximum();
+
+	float32_t halfWidth = static_cast< float32_t >( m_width ) * 0.5f;
+	float32_t halfHeight = static_cast< float32_t >( m_height ) * 0.5f;
+
+	float32_t minClipW, minNdcX, maxNdcX, minNdcY, maxNdcY, minDepth;
+
+#if HELIUM_SIMD_SSE
+	// Project all eight corners of the box at once, four corners per SIMD vector.
+	HELIUM_SIMD_ALIGN_PRE float32_t cornerX[4] HELIUM_SIMD_ALIGN_POST =
+	{
+		rMinimum.GetElement( 0 ), rMaximum.GetElement( 0 ), rMinimum.GetElement( 0 ), rMaximum.GetElement( 0 )
+	};
+	HELIUM_SIMD_ALIGN_PRE float32_t cornerY[4] HELIUM_SIMD_ALIGN_POST =
+	{
+		rMinimum.GetElement( 1 ), rMinimum.GetElement( 1 ), rMaximum.GetElement( 1 ), rMaximum.GetElement( 1 )
+	};
+
+	Simd::Matrix44Soa viewProjection;
+	viewProjection.Splat( m_viewProjection );
+
+	Simd::Vector4Soa nearCorners(
+		Simd::LoadAligned( cornerX ),
+		Simd::LoadAligned( cornerY ),
+		Simd::SetSplatF32( rMinimum.GetElement( 2 ) ),
+		Simd::SetSplatF32( 1.0f ) );
+	Simd::Vector4Soa farCorners(
+		nearCorners.m_x,
+		nearCorners.m_y,
+		Simd::SetSplatF32( rMaximum.GetElement( 2 ) ),
+		nearCorners.m_w );
+
+	viewProjection.Transform( nearCorners, nearCorners );
+	viewProjection.Transform( farCorners, farCorners );
+
+	Simd::Register one = Simd::SetSplatF32( 1.0f );
+	Simd::Register clipWMin = Simd::SetSplatF32( OCCLUSION_CLIP_W_MIN );
+	Simd::Register nearInverseW = Simd::DivideF32( one, Simd::MaxF32( nearCorners.m_w, clipWMin ) );
+	Simd::Register farInverseW = Simd::DivideF32( one, Simd::MaxF32( farCorners.m_w, clipWMin ) );
+
+	Simd::Register nearNdcX = Simd::MultiplyF32( nearCorners.m_x, nearInverseW );
+	Simd::Register farNdcX = Simd::MultiplyF32( farCorners.m_x, farInverseW );
+	Simd::Register nearNdcY = Simd::MultiplyF32( nearCorners.m_y, nearInverseW );
+	Simd::Register farNdcY = Simd::MultiplyF32( farCorners.m_y, farInverseW );
+
+	HELIUM_SIMD_ALIGN_PRE float32_t lanes[6][4] HELIUM_SIMD_ALIGN_POST;
+	Simd::StoreAligned( lanes[0], Simd::MinF32( nearCorners.m_w, farCorners.m_w ) );
+	Simd::StoreAligned( lanes[1], Simd::MinF32( nearNdcX, farNdcX ) );
+	Simd::StoreAligned( lanes[2], Simd::MaxF32( nearNdcX, farNdcX ) );
+	Simd::StoreAligned( lanes[3], Simd::MinF32( nearNdcY, farNdcY ) );
+	Simd::StoreAligned( lanes[4], Simd::MaxF32( nearNdcY, farNdcY ) );
+	Simd::StoreAligned( lanes[5], Simd::MinF32(
+		Simd::MultiplyF32( nearCorners.m_z, nearInverseW ),
+		Simd::MultiplyF32( farCorners.m_z, farInverseW ) ) );
+
+	minClipW = Min( Min( lanes[0][0], lanes[0][1] ), Min( lanes[0][2], lanes[0][3] ) );
+	minNdcX = Min( Min( lanes[1][0], lanes[1][1] ), Min( lanes[1][2], lanes[1][3] ) );
+	maxNdcX = Max( Max( lanes[2][0], lanes[2][1] ), Max( lanes[2][2], lanes[2][3] ) );
+	minNdcY = Min( Min( lanes[3][0], lanes[3][1] ), Min( lanes[3][2], lanes[3][3] ) );
+	maxNdcY = Max( Max( lanes[4][0], lanes[4][1] ), Max( lanes[4][2], lanes[4][3] ) );
+	minDepth = Min( Min( lanes[5][0], lanes[5][1] ), Min( lanes[5][2], lanes[5][3] ) );
+#else
+	minClipW = OCCLUSION_DEPTH_FAR;
+	minNdcX = OCCLUSION_DEPTH_FAR;
+	maxNdcX = -OCCLUSION_DEPTH_FAR;
+	minNdcY = OCCLUSION_DEPTH_FAR;
+	maxNdcY = -OCCLUSION_DEPTH_FAR;
+	minDepth = OCCLUSION_DEPTH_FAR;
+
+	for ( uint32_t cornerIndex = 0; cornerIndex < 8; ++cornerIndex )
+	{
+		Simd::Vector4 corner(
+			( cornerIndex & 1 ) ? rMaximum.GetElement( 0 ) : rMinimum.GetElement( 0 ),
+			( cornerIndex & 2 ) ? rMaximum.GetElement( 1 ) : rMinimum.GetElement( 1 ),
+			( cornerIndex & 4 ) ? rMaximum.GetElement( 2 ) : rMinimum.GetElement( 2 ),
+			1.0f );
+		Simd::Vector4 clip = m_viewProjection.Transform( corner );
+
+		float32_t clipW = clip.GetElement( 3 );
+		float32_t inverseW = 1.0f / Max( clipW, OCCLUSION_CLIP_W_MIN );
+		float32_t ndcX = clip.GetElement( 0 ) * inverseW;
+		float32_t ndcY = clip.GetElement( 1 ) * inverseW;
+
+		minClipW = Min( minClipW, clipW );
+		minNdcX = Min( minNdcX, ndcX );
+		maxNdcX = Max( maxNdcX, ndcX );
+		minNdcY = Min( minNdcY, ndcY );
+		maxNdcY = Max( maxNdcY, ndcY );
+		minDepth = Min( minDepth, clip.GetElement( 2 ) * inverseW );
+	}
+#endif
+
+	if ( minClipW <= OCCLUSION_CLIP_W_MIN )
+	{
+		return false;
+	}
+
+	// Screen-space y increases downward.
+	float32_t minScreenX = minNdcX * halfWidth + halfWidth;
+	float32_t maxScreenX = maxNdcX * halfWidth + halfWidth;
+	float32_t minScreenY = halfHeight - maxNdcY * halfHeight;
+	float32_t maxScreenY = halfHeight - minNdcY * halfHeight;
+
+	float32_t widthFloat = static_cast< float32_t >( m_width );
+	float32_t heightFloat = static_cast< float32_t >( m_height );
+	if ( maxScreenX < 0.0f || maxScreenY < 0.0f || minScreenX >= widthFloat || minScreenY >= heightFloat )
+	{
+		return false;
+	}
+
+	uint32_t minTileX = static_cast< uint32_t >( Max( minScreenX, 0.0f ) ) / TILE_SIZE;
+	uint32_t minTileY = static_cast< uint32_t >( Max( minScreenY, 0.0f ) ) / TILE_SIZE;
+	uint32_t maxTileX = Min( static_cast< uint32_t >( Min( maxScreenX, widthFloat - 1.0f ) ) / TILE_SIZE, m_tileCountX - 1 );
+	uint32_t maxTileY = Min( static_cast< uint32_t >( Min( maxScreenY, heightFloat - 1.0f ) ) / TILE_SIZE, m_tileCountY - 1 );
+
+	const float32_t* pTileDepths = m_tileDepths.GetData();
+	for ( uint32_t tileY = minTileY; tileY <= maxTileY; ++tileY )
+	{
+		const float32_t* pTileRow = pTileDepths + tileY * m_tileCountX;
+		for ( uint32_t tileX = minTileX; tileX <= maxTileX; ++tileX )
+		{
+			if ( pTileRow[tileX] >= minDepth )
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/// Transform a set of occluder vertices to screen space, storing the results in the scratch vertex buffers.
+///
+/// @param[in] rWorldViewProjection  Combined world/view/projection transform.
+/// @param[in] pVertices             Vertex positions (three floats per vertex).
+/// @param[in] vertexCount           Number of vertices.
+void OcclusionBuffer::TransformVertices(
+	const Simd::Matrix44& rWorldViewProjection,
+	const float32_t* pVertices,
+	uint32_t vertexCount )
+{
+	HELIUM_ASSERT( pVertices );
+
+	// Pad the scratch buffers so that whole SIMD vectors can be stored.
+	size_t paddedVertexCount = ( static_cast< size_t >( vertexCount ) + 3 ) & ~static_cast< size_t >( 3 );
+	m_screenX.Resize( paddedVertexCount );
+	m_screenY.Resize( paddedVertexCount );
+	m_screenDepth.Resize( paddedVertexCount );
+	m_clipW.Resize( paddedVertexCount );
+
+	float32_t halfWidth = static_cast< float32_t >( m_width ) * 0.5f;
+	float32_t halfHeight = static_cast< float32_t >( m_height ) * 0.5f;
+
+#if HELIUM_SIMD_SSE
+	Simd::Matrix44Soa transform;
+	transform.Splat( rWorldViewProjection );
+
+	Simd::Register one = Simd::SetSplatF32( 1.0f );
+	Simd::Register clipWMin = Simd::SetSplatF32( OCCLUSION_CLIP_W_MIN );
+	Simd::Register halfWidthVec = Simd::SetSplatF32( halfWidth );
+	Simd::Register halfHeightVec = Simd::SetSplatF32( halfHeight );
+
+	HELIUM_SIMD_ALIGN_PRE float32_t positionX[4] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t positionY[4] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t positionZ[4] HELIUM_SIMD_ALIGN_POST;
+
+	Simd::Vector4Soa clip;
+	for ( size_t baseIndex = 0; baseIndex < paddedVertexCount; baseIndex += 4 )
+	{
+		for ( size_t laneIndex = 0; laneIndex < 4; ++laneIndex )
+		{
+			size_t vertexIndex = Min< size_t >( baseIndex + laneIndex, vertexCount - 1 );
+			const float32_t* pVertex = pVertices + vertexIndex * 3;
+			positionX[laneIndex] = pVertex[0];
+			positionY[laneIndex] = pVertex[1];
+			positionZ[laneIndex] = pVertex[2];
+		}
+
+		Simd::Vector4Soa position(
+			Simd::LoadAligned( positionX ),
+			Simd::LoadAligned( positionY ),
+			Simd::LoadAligned( positionZ ),
+			one );
+		transform.Transform( position, clip );
+
+		Simd::Register inverseW = Simd::DivideF32( one, Simd::MaxF32( clip.m_w, clipWMin ) );
+
+		Simd::StoreUnaligned(
+			m_screenX.GetData() + baseIndex,
+			Simd::MultiplyAddF32( Simd::MultiplyF32( clip.m_x, inverseW ), halfWidthVec, halfWidthVec ) );
+		Simd::StoreUnaligned(
+			m_screenY.GetData() + baseIndex,
+			Simd::SubtractF32( halfHeightVec, Simd::MultiplyF32( Simd::MultiplyF32( clip.m_y, inverseW ), halfHeightVec ) ) );
+		Simd::StoreUnaligned( m_screenDepth.GetData() + baseIndex, Simd::MultiplyF32( clip.m_z, inverseW ) );
+		Simd::StoreUnaligned( m_clipW.GetData() + baseIndex, clip.m_w );
+	}
+#else
+	for ( uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		const float32_t* pVertex = pVertices + vertexIndex * 3;
+		Simd::Vector4 clip = rWorldViewProjection.Transform( Simd::Vector4( pVertex[0], pVertex[1], pVertex[2], 1.0f ) );
+
+		float32_t clipW = clip.GetElement( 3 );
+		float32_t inverseW = 1.0f / Max( clipW, OCCLUSION_CLIP_W_MIN );
+
+		m_screenX[vertexIndex] = clip.GetElement( 0 ) * inverseW * halfWidth + halfWidth;
+		m_screenY[vertexIndex] = halfHeight - clip.GetElement( 1 ) * inverseW * halfHeight;
+		m_screenDepth[vertexIndex] = clip.GetElement( 2 ) * inverseW;
+		m_clipW[vertexIndex] = clipW;
+	}
+#endif
+}
+
+/// Rasterize a single transformed occluder triangle into the depth buffer.
+///
+/// Pixels whose centers lie inside the triangle keep the nearest of their current depth and the triangle depth.
+/// Both front and back faces are rasterized, so single-sided occluders (i.e. walls built from a single quad) work
+/// regardless of their winding.
+///
+/// @param[in] vertexIndex0  Index of the first triangle vertex in the scratch vertex buffers.
+/// @param[in] vertexIndex1  Index of the second triangle vertex in the scratch vertex buffers.
+/// @param[in] vertexIndex2  Index of the third triangle vertex in the scratch vertex buffers.
+void OcclusionBuffer::RasterizeTriangle( uint32_t vertexIndex0, uint32_t vertexIndex1, uint32_t vertexIndex2 )
+{
+	// Skip triangles crossing the near plane rather than clipping them.  Dropping part of an occluder only makes the
+	// culling less aggressive.
+	if ( m_clipW[vertexIndex0] <= OCCLUSION_CLIP_W_MIN ||
+		m_clipW[vertexIndex1] <= OCCLUSION_CLIP_W_MIN ||
+		m_clipW[vertexIndex2] <= OCCLUSION_CLIP_W_MIN )
+	{
+		return;
+	}
+
+	float32_t x0 = m_screenX[vertexIndex0];
+	float32_t y0 = m_screenY[vertexIndex0];
+	float32_t z0 = m_screenDepth[vertexIndex0];
+	float32_t x1 = m_screenX[vertexIndex1];
+	float32_t y1 = m_screenY[vertexIndex1];
+	float32_t z1 = m_screenDepth[vertexIndex1];
+	float32_t x2 = m_screenX[vertexIndex2];
+	float32_t y2 = m_screenY[vertexIndex2];
+	float32_t z2 = m_screenDepth[vertexIndex2];
+
+	// Orient the triangle so that all edge functions are positive inside it.
+	float32_t area = ( x1 - x0 ) * ( y2 - y0 ) - ( x2 - x0 ) * ( y1 - y0 );
+	if ( area < 0.0f )
+	{
+		float32_t swapValue = x1;
+		x1 = x2;
+		x2 = swapValue;
+		swapValue = y1;
+		y1 = y2;
+		y2 = swapValue;
+		swapValue = z1;
+		z1 = z2;
+		z2 = swapValue;
+		area = -area;
+	}
+
+	if ( area < OCCLUSION_TRIANGLE_AREA_MIN )
+	{
+		return;
+	}
+
+	// Compute the screen-space bounds of the triangle, clamped to the buffer.  The horizontal range is aligned to
+	// whole groups of four pixels.
+	float32_t widthFloat = static_cast< float32_t >( m_width );
+	float32_t heightFloat = static_cast< float32_t >( m_height );
+
+	float32_t minXFloat = Max( Min( Min( x0, x1 ), x2 ), 0.0f );
+	float32_t maxXFloat = Min( Max( Max( x0, x1 ), x2 ), widthFloat - 1.0f );
+	float32_t minYFloat = Max( Min( Min( y0, y1 ), y2 ), 0.0f );
+	float32_t maxYFloat = Min( Max( Max( y0, y1 ), y2 ), heightFloat - 1.0f );
+	if ( minXFloat > maxXFloat || minYFloat > maxYFloat )
+	{
+		return;
+	}
+
+	uint32_t minX = static_cast< uint32_t >( minXFloat ) & ~3u;
+	uint32_t maxX = static_cast< uint32_t >( maxXFloat );
+	uint32_t minY = static_cast< uint32_t >( minYFloat );
+	uint32_t maxY = static_cast< uint32_t >( maxYFloat );
+
+	// Edge functions (a * x + b * y + c) for each edge, along with the depth plane equation.
+	float32_t a01 = y0 - y1;
+	float32_t b01 = x1 - x0;
+	float32_t c01 = x0 * y1 - y0 * x1;
+	float32_t a12 = y1 - y2;
+	float32_t b12 = x2 - x1;
+	float32_t c12 = x1 * y2 - y1 * x2;
+	float32_t a20 = y2 - y0;
+	float32_t b20 = x0 - x2;
+	float32_t c20 = x2 * y0 - y2 * x0;
+
+	float32_t inverseArea = 1.0f / area;
+	float32_t depthDx = ( ( z1 - z0 ) * ( y2 - y0 ) - ( z2 - z0 ) * ( y1 - y0 ) ) * inverseArea;
+	float32_t depthDy = ( ( z2 - z0 ) * ( x1 - x0 ) - ( z1 - z0 ) * ( x2 - x0 ) ) * inverseArea;
+	float32_t depthOrigin = z0 - depthDx * x0 - depthDy * y0;
+
+	float32_t* pDepth = m_depth.GetData();
+
+#if HELIUM_SIMD_SSE
+	HELIUM_SIMD_ALIGN_PRE static const float32_t pixelCenterOffsets[4] HELIUM_SIMD_ALIGN_POST =
+	{
+		0.5f, 1.5f, 2.5f, 3.5f
+	};
+
+	Simd::Register zero = Simd::LoadZeros();
+	Simd::Register startX = Simd::AddF32(
+		Simd::SetSplatF32( static_cast< float32_t >( minX ) ),
+		Simd::LoadAligned( pixelCenterOffsets ) );
+
+	Simd::Register a01Vec = Simd::SetSplatF32( a01 );
+	Simd::Register a12Vec = Simd::SetSplatF32( a12 );
+	Simd::Register a20Vec = Simd::SetSplatF32( a20 );
+	Simd::Register depthDxVec = Simd::SetSplatF32( depthDx );
+
+	// Edge function and depth steps when moving four pixels to the right.
+	Simd::Register edge01Step = Simd::SetSplatF32( a01 * 4.0f );
+	Simd::Register edge12Step = Simd::SetSplatF32( a12 * 4.0f );
+	Simd::Register edge20Step = Simd::SetSplatF32( a20 * 4.0f );
+	Simd::Register depthStep = Simd::SetSplatF32( depthDx * 4.0f );
+
+	for ( uint32_t y = minY; y <= maxY; ++y )
+	{
+		float32_t pixelY = static_cast< float32_t >( y ) + 0.5f;
+
+		Simd::Register edge01 = Simd::MultiplyAddF32( a01Vec, startX, Simd::SetSplatF32( b01 * pixelY + c01 ) );
+		Simd::Register edge12 = Simd::MultiplyAddF32( a12Vec, startX, Simd::SetSplatF32( b12 * pixelY + c12 ) );
+		Simd::Register edge20 = Simd::MultiplyAddF32( a20Vec, startX, Simd::SetSplatF32( b20 * pixelY + c20 ) );
+		Simd::Register depth = Simd::MultiplyAddF32(
+			depthDxVec, startX, Simd::SetSplatF32( depthDy * pixelY + depthOrigin ) );
+
+		float32_t* pRow = pDepth + static_cast< size_t >( y ) * m_width;
+		for ( uint32_t x = minX; x <= maxX; x += 4 )
+		{
+			Simd::Mask inside = Simd::MaskAnd(
+				Simd::MaskAnd( Simd::GreaterEqualsF32( edge01, zero ), Simd::GreaterEqualsF32( edge12, zero ) ),
+				Simd::GreaterEqualsF32( edge20, zero ) );
+
+			Simd::Register current = Simd::LoadUnaligned( pRow + x );
+			Simd::StoreUnaligned( pRow + x, Simd::Select( current, Simd::MinF32( current, depth ), inside ) );
+
+			edge01 = Simd::AddF32( edge01, edge01Step );
+			edge12 = Simd::AddF32( edge12, edge12Step );
+			edge20 = Simd::AddF32( edge20, edge20Step );
+			depth = Simd::AddF32( depth, depthStep );
+		}
+	}
+#else
+	for ( uint32_t y = minY; y <= maxY; ++y )
+	{
+		float32_t pixelY = static_cast< float32_t >( y ) + 0.5f;
+
+		float32_t* pRow = pDepth + static_cast< size_t >( y ) * m_width;
+		for ( uint32_t x = minX; x <= maxX; ++x )
+		{
+			float32_t pixelX = static_cast< float32_t >( x ) + 0.5f;
+			if ( a01 * pixelX + b01 * pixelY + c01 >= 0.0f &&
+				a12 * pixelX + b12 * pixelY + c12 >= 0.0f &&
+				a20 * pixelX + b20 * pixelY + c20 >= 0.0f )
+			{
+				float32_t depth = depthOrigin + depthDx * pixelX + depthDy * pixelY;
+				pRow[x] = Min( pRow[x], depth );
+			}
+		}
+	}
+#endif
+
+	++m_rasterizedTriangleCount;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/AaBox.h"
+#include "MathSimd/Matrix44.h"
+
+namespace Helium
+{
+	/// Low-resolution software depth buffer for occlusion culling.
+	///
+	/// Occluder triangles are rasterized on the CPU into a small depth buffer four pixels at a time, after which the
+	/// farthest depth in each tile of TILE_SIZE x TILE_SIZE pixels is gathered into a hierarchical depth buffer.  Scene
+	/// object bounds are then tested against the tiles they cover, and objects whose nearest depth is behind every
+	/// covered tile can be skipped when drawing.  Since this does not touch the renderer at all, it works with any
+	/// rendering backend and can be used without one.
+	///
+	/// Depth values are post-projection depths (clip z / clip w), with smaller values closer to the viewer.  Triangles
+	/// crossing the near plane are not rasterized, and bounds crossing the near plane are never reported as occluded,
+	/// so clipping is never needed and errors always fall on the side of drawing too much.
+	class HELIUM_GRAPHICS_API OcclusionBuffer : NonCopyable
+	{
+	public:
+		/// Width and height of each hierarchical depth tile, in pixels.
+		static const uint32_t TILE_SIZE = 8;
+
+		/// Default depth buffer width.
+		static const uint32_t DEFAULT_WIDTH = 256;
+		/// Default depth buffer height.
+		static const uint32_t DEFAULT_HEIGHT = 128;
+
+		/// @name Construction/Destruction
+		//@{
+		OcclusionBuffer();
+		//@}
+
+		/// @name Initialization
+		//@{
+		void SetResolution( uint32_t width, uint32_t height );
+		inline uint32_t GetWidth() const;
+		inline uint32_t GetHeight() const;
+		//@}
+
+		/// @name Rasterization
+		//@{
+		void Clear( const Simd::Matrix44& rViewProjection );
+		void RasterizeOccluder(
+			const Simd::Matrix44& rWorldTransform, const float32_t* pVertices, uint32_t vertexCount,
+			const uint16_t* pIndices, uint32_t triangleCount );
+		void BuildHierarchy();
+		//@}
+
+		/// @name Occlusion Testing
+		//@{
+		bool IsBoxOccluded( const Simd::AaBox& rBox ) const;
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline const float32_t* GetDepthData() const;
+		inline const float32_t* GetTileDepthData() const;
+		inline uint32_t GetTileCountX() const;
+		inline uint32_t GetTileCountY() const;
+
+		inline uint32_t GetRasterizedTriangleCount() const;
+		//@}
+
+	private:
+		/// Depth buffer (m_width * m_height entries).
+		DynamicArray< float32_t > m_depth;
+		/// Farthest depth in each tile.
+		DynamicArray< float32_t > m_tileDepths;
+
+		/// Screen-space x-coordinate of each transformed occluder vertex (scratch buffer).
+		DynamicArray< float32_t > m_screenX;
+		/// Screen-space y-coordinate of each transformed occluder vertex (scratch buffer).
+		DynamicArray< float32_t > m_screenY;
+		/// Depth of each transformed occluder vertex (scratch buffer).
+		DynamicArray< float32_t > m_screenDepth;
+		/// Clip-space w-coordinate of each transformed occluder vertex (scratch buffer).
+		DynamicArray< float32_t > m_clipW;
+
+		/// Current view/projection matrix.
+		Simd::Matrix44 m_viewProjection;
+
+		/// Depth buffer width, in pixels (always a multiple of TILE_SIZE).
+		uint32_t m_width;
+		/// Depth buffer height, in pixels (always a multiple of TILE_SIZE).
+		uint32_t m_height;
+		/// Number of tile columns.
+		uint32_t m_tileCountX;
+		/// Number of tile rows.
+		uint32_t m_tileCountY;
+
+		/// Number of occluder triangles rasterized since the last call to Clear().
+		uint32_t m_rasterizedTriangleCount;
+
+		/// @name Private Utility Functions
+		//@{
+		void TransformVertices( const Simd::Matrix44& rWorldViewProjection, const float32_t* pVertices, uint32_t vertexCount );
+		void RasterizeTriangle( uint32_t vertexIndex0, uint32_t vertexIndex1, uint32_t vertexIndex2 );
+		//@}
+	};
+}
+
+#include "Graphics/OcclusionBuffer.inl"
@@ -0,0 +1,72 @@
+namespace Helium
+{
+	/// Get the depth buffer width.
+	///
+	/// @return  Width, in pixels.
+	///
+	/// @see GetHeight(), SetResolution()
+	uint32_t OcclusionBuffer::GetWidth() const
+	{
+		return m_width;
+	}
+
+	/// Get the depth buffer height.
+	///
+	/// @return  Height, in pixels.
+	///
+	/// @see GetWidth(), SetResolution()
+	uint32_t OcclusionBuffer::GetHeight() const
+	{
+		return m_height;
+	}
+
+	/// Get the contents of the depth buffer.
+	///
+	/// @return  Depth buffer rows (GetWidth() * GetHeight() values, top row first).
+	///
+	/// @see GetTileDepthData()
+	const float32_t* OcclusionBuffer::GetDepthData() const
+	{
+		return m_depth.GetData();
+	}
+
+	/// Get the farthest depth of each tile, as computed by the last call to BuildHierarchy().
+	///
+	/// @return  Tile depths (GetTileCountX() * GetTileCountY() values, top row first).
+	///
+	/// @see GetDepthData(), BuildHierarchy()
+	const float32_t* OcclusionBuffer::GetTileDepthData() const
+	{
+		return m_tileDepths.GetData();
+	}
+
+	/// Get the number of tile columns in the hierarchical depth buffer.
+	///
+	/// @return  Tile column count.
+	///
+	/// @see GetTileCountY()
+	uint32_t OcclusionBuffer::GetTileCountX() const
+	{
+		return m_tileCountX;
+	}
+
+	/// Get the number of tile rows in the hierarchical depth buffer.
+	///
+	/// @return  Tile row count.
+	///
+	/// @see GetTileCountX()
+	uint32_t OcclusionBuffer::GetTileCountY() const
+	{
+		return m_tileCountY;
+	}
+
+	/// Get the number of occluder triangles rasterized since the buffer was last cleared.
+	///
+	/// Triangles that are degenerate, off-screen, or crossing the near plane are not counted.
+	///
+	/// @return  Rasterized triangle count.
+	uint32_t OcclusionBuffer::GetRasterizedTriangleCount() const
+	{
+		return m_rasterizedTriangleCount;
+	}
+}
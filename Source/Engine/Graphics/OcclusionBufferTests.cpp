@@ -0,0 +1,138 @@
+#include "Graphics/OcclusionBuffer.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+/// Quad vertices (x, y, z) covering clip-space x and y from -1 to 1 at z = 0.
+static const float32_t QUAD_VERTICES[] =
+{
+	-1.0f, -1.0f, 0.0f,
+	 1.0f, -1.0f, 0.0f,
+	 1.0f,  1.0f, 0.0f,
+	-1.0f,  1.0f, 0.0f,
+};
+
+/// Quad triangle indices.
+static const uint16_t QUAD_INDICES[] =
+{
+	0, 1, 2,
+	0, 2, 3,
+};
+
+/// Rasterize the test quad scaled and offset in clip space.
+///
+/// The view/projection transform is the identity, so clip-space x and y map directly to the screen and the depth of
+/// each pixel is the clip-space z-coordinate.
+///
+/// @param[in] rBuffer  Occlusion buffer into which to rasterize.
+/// @param[in] minX     Left edge of the quad in clip space.
+/// @param[in] maxX     Right edge of the quad in clip space.
+/// @param[in] depth    Depth of the quad.
+static void RasterizeQuad( OcclusionBuffer& rBuffer, float32_t minX, float32_t maxX, float32_t depth )
+{
+	float32_t scaleX = ( maxX - minX ) * 0.5f;
+	Simd::Matrix44 worldTransform(
+		scaleX, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		minX + scaleX, 0.0f, depth, 1.0f );
+
+	rBuffer.RasterizeOccluder( worldTransform, QUAD_VERTICES, 4, QUAD_INDICES, 2 );
+}
+
+/// Create a box spanning the given clip-space bounds.
+static Simd::AaBox MakeBox(
+	float32_t minX, float32_t minY, float32_t minZ, float32_t maxX, float32_t maxY, float32_t maxZ )
+{
+	return Simd::AaBox( Simd::Vector3( minX, minY, minZ ), Simd::Vector3( maxX, maxY, maxZ ) );
+}
+
+TEST( OcclusionBuffer, ResolutionRoundsUpToTiles )
+{
+	OcclusionBuffer buffer;
+	buffer.SetResolution( 100, 37 );
+
+	EXPECT_EQ( 0u, buffer.GetWidth() % OcclusionBuffer::TILE_SIZE );
+	EXPECT_EQ( 0u, buffer.GetHeight() % OcclusionBuffer::TILE_SIZE );
+	EXPECT_LE( 100u, buffer.GetWidth() );
+	EXPECT_LE( 37u, buffer.GetHeight() );
+	EXPECT_EQ( buffer.GetWidth() / OcclusionBuffer::TILE_SIZE, buffer.GetTileCountX() );
+	EXPECT_EQ( buffer.GetHeight() / OcclusionBuffer::TILE_SIZE, buffer.GetTileCountY() );
+}
+
+TEST( OcclusionBuffer, EmptyBufferOccludesNothing )
+{
+	OcclusionBuffer buffer;
+	buffer.SetResolution( 64, 64 );
+	buffer.Clear( Simd::Matrix44::IDENTITY );
+	buffer.BuildHierarchy();
+
+	EXPECT_FALSE( buffer.IsBoxOccluded( MakeBox( -0.5f, -0.5f, 0.5f, 0.5f, 0.5f, 0.9f ) ) );
+}
+
+TEST( OcclusionBuffer, FullScreenOccluder )
+{
+	OcclusionBuffer buffer;
+	buffer.SetResolution( 64, 64 );
+	buffer.Clear( Simd::Matrix44::IDENTITY );
+
+	RasterizeQuad( buffer, -1.0f, 1.0f, 0.5f );
+	EXPECT_EQ( 2u, buffer.GetRasterizedTriangleCount() );
+
+	buffer.BuildHierarchy();
+
+	// Every pixel should hold the occluder depth.
+	const float32_t* pDepth = buffer.GetDepthData();
+	size_t pixelCount = static_cast< size_t >( buffer.GetWidth() ) * buffer.GetHeight();
+	for ( size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex )
+	{
+		ASSERT_NEAR( 0.5f, pDepth[pixelIndex], 1.0e-5f ) << "Pixel " << pixelIndex;
+	}
+
+	// Boxes behind the occluder are hidden, while boxes in front of or straddling it are not.
+	EXPECT_TRUE( buffer.IsBoxOccluded( MakeBox( -0.5f, -0.5f, 0.6f, 0.5f, 0.5f, 0.9f ) ) );
+	EXPECT_TRUE( buffer.IsBoxOccluded( MakeBox( -1.0f, -1.0f, 0.51f, 1.0f, 1.0f, 0.52f ) ) );
+	EXPECT_FALSE( buffer.IsBoxOccluded( MakeBox( -0.5f, -0.5f, 0.1f, 0.5f, 0.5f, 0.2f ) ) );
+	EXPECT_FALSE( buffer.IsBoxOccluded( MakeBox( -0.5f, -0.5f, 0.4f, 0.5f, 0.5f, 0.6f ) ) );
+
+	// Boxes entirely off-screen are never reported as occluded.
+	EXPECT_FALSE( buffer.IsBoxOccluded( MakeBox( 2.0f, -0.5f, 0.6f, 3.0f, 0.5f, 0.9f ) ) );
+}
+
+TEST( OcclusionBuffer, PartialOccluder )
+{
+	OcclusionBuffer buffer;
+	buffer.SetResolution( 64, 64 );
+	buffer.Clear( Simd::Matrix44::IDENTITY );
+
+	// Cover the left half of the screen only.
+	RasterizeQuad( buffer, -1.0f, 0.0f, 0.5f );
+	buffer.BuildHierarchy();
+
+	EXPECT_TRUE( buffer.IsBoxOccluded( MakeBox( -0.9f, -0.5f, 0.6f, -0.2f, 0.5f, 0.9f ) ) );
+	EXPECT_FALSE( buffer.IsBoxOccluded( MakeBox( 0.2f, -0.5f, 0.6f, 0.9f, 0.5f, 0.9f ) ) );
+
+	// A box straddling the occluder edge is visible through the uncovered half.
+	EXPECT_FALSE( buffer.IsBoxOccluded( MakeBox( -0.5f, -0.5f, 0.6f, 0.5f, 0.5f, 0.9f ) ) );
+}
+
+TEST( OcclusionBuffer, NearestOccluderWins )
+{
+	OcclusionBuffer buffer;
+	buffer.SetResolution( 64, 64 );
+	buffer.Clear( Simd::Matrix44::IDENTITY );
+
+	RasterizeQuad( buffer, -1.0f, 1.0f, 0.8f );
+	RasterizeQuad( buffer, -1.0f, 1.0f, 0.3f );
+	buffer.BuildHierarchy();
+
+	EXPECT_TRUE( buffer.IsBoxOccluded( MakeBox( -0.5f, -0.5f, 0.4f, 0.5f, 0.5f, 0.6f ) ) );
+
+	// Clearing the buffer removes all occluders.
+	buffer.Clear( Simd::Matrix44::IDENTITY );
+	buffer.BuildHierarchy();
+
+	EXPECT_EQ( 0u, buffer.GetRasterizedTriangleCount() );
+	EXPECT_FALSE( buffer.IsBoxOccluded( MakeBox( -0.5f, -0.5f, 0.4f, 0.5f, 0.5f, 0.6f ) ) );
+}
@@ -10,6 +10,7 @@
 #include "Rendering/RSamplerState.h"
 #include "Rendering/RSurface.h"
 #include "Rendering/RVertexDescription.h"
+#include "GraphicsTypes/VertexTypes.h"
 #include "Graphics/Font.h"
 #include "Graphics/GraphicsConfig.h"
 #include "Graphics/Shader.h"
@@ -229,6 +230,49 @@ bool RenderResourceManager::Initialize()
 	m_staticMeshVertexDescriptions[1] = pRenderer->CreateVertexDescription( vertexElements, 6 );
 	HELIUM_ASSERT( m_staticMeshVertexDescriptions[1] );
 
+	vertexElements[0].type = RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM;
+
+	m_quantizedStaticMeshVertexDescriptions[0] = pRenderer->CreateVertexDescription( vertexElements, 5 );
+	HELIUM_ASSERT( m_quantizedStaticMeshVertexDescriptions[0] );
+
+	m_quantizedStaticMeshVertexDescriptions[1] = pRenderer->CreateVertexDescription( vertexElements, 6 );
+	HELIUM_ASSERT( m_quantizedStaticMeshVertexDescriptions[1] );
+
+	// Create the instanced static mesh vertex descriptions, which append the rows of the per-instance transform
+	// (InstanceVertex) read from the instance data stream to the regular static mesh vertex data.
+	RVertexDescription::Element instanceElements[3];
+	for ( size_t rowIndex = 0; rowIndex < HELIUM_ARRAY_COUNT( instanceElements ); ++rowIndex )
+	{
+		instanceElements[rowIndex].type = RENDERER_VERTEX_DATA_TYPE_FLOAT32_4;
+		instanceElements[rowIndex].semantic = RENDERER_VERTEX_SEMANTIC_TEXCOORD;
+		instanceElements[rowIndex].semanticIndex = static_cast<uint8_t>( INSTANCE_TRANSFORM_TEXCOORD_INDEX + rowIndex );
+		instanceElements[rowIndex].bufferIndex = static_cast<uint8_t>( INSTANCE_DATA_VERTEX_STREAM_INDEX );
+	}
+
+	RVertexDescription::Element instancedVertexElements[6 + HELIUM_ARRAY_COUNT( instanceElements )];
+
+	for ( size_t setIndex = 0; setIndex < MESH_TEXTURE_COORDINATE_SET_COUNT_MAX; ++setIndex )
+	{
+		size_t meshElementCount = 5 + setIndex;
+		size_t elementCount = meshElementCount + HELIUM_ARRAY_COUNT( instanceElements );
+		MemoryCopy( instancedVertexElements, vertexElements, meshElementCount * sizeof( vertexElements[0] ) );
+		MemoryCopy( instancedVertexElements + meshElementCount, instanceElements, sizeof( instanceElements ) );
+
+		instancedVertexElements[0].type = RENDERER_VERTEX_DATA_TYPE_FLOAT32_3;
+		m_instancedStaticMeshVertexDescriptions[setIndex] = pRenderer->CreateVertexDescription(
+			instancedVertexElements,
+			elementCount );
+		HELIUM_ASSERT( m_instancedStaticMeshVertexDescriptions[setIndex] );
+
+		instancedVertexElements[0].type = RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM;
+		m_instancedQuantizedStaticMeshVertexDescriptions[setIndex] = pRenderer->CreateVertexDescription(
+			instancedVertexElements,
+			elementCount );
+		HELIUM_ASSERT( m_instancedQuantizedStaticMeshVertexDescriptions[setIndex] );
+	}
+
+	vertexElements[0].type = RENDERER_VERTEX_DATA_TYPE_FLOAT32_3;
+
 	vertexElements[1].type = RENDERER_VERTEX_DATA_TYPE_UINT8_4_NORM;
 	vertexElements[1].semantic = RENDERER_VERTEX_SEMANTIC_BLENDWEIGHT;
 	vertexElements[1].semanticIndex = 0;
@@ -473,6 +517,9 @@ void RenderResourceManager::Cleanup()
 		++descriptionIndex )
 	{
 		m_staticMeshVertexDescriptions[descriptionIndex].Release();
+		m_quantizedStaticMeshVertexDescriptions[descriptionIndex].Release();
+		m_instancedStaticMeshVertexDescriptions[descriptionIndex].Release();
+		m_instancedQuantizedStaticMeshVertexDescriptions[descriptionIndex].Release();
 	}
 
 	m_spSkinnedMeshVertexDescription.Release();
@@ -793,6 +840,25 @@ RVertexDescription* RenderResourceManager::GetStaticMeshVertexDescription( size_
 	return m_staticMeshVertexDescriptions[textureCoordinateSetCount - 1];
 }
 
+/// Get the description for quantized static mesh vertices with the specified number of texture coordinate sets.
+///
+/// Quantized vertices store positions as normalized 16-bit integers (see QuantizedStaticMeshVertex).
+///
+/// @param[in] textureCoordinateSetCount  Number of texture coordinate sets (must be between 1 and
+///                                       MESH_TEXTURE_COORDINATE_SET_COUNT_MAX, inclusive).
+///
+/// @return  Vertex description.
+///
+/// @see GetStaticMeshVertexDescription(), GetSkinnedMeshVertexDescription()
+RVertexDescription* RenderResourceManager::GetQuantizedStaticMeshVertexDescription(
+	size_t textureCoordinateSetCount ) const
+{
+	HELIUM_ASSERT( textureCoordinateSetCount >= 1 );
+	HELIUM_ASSERT( textureCoordinateSetCount <= MESH_TEXTURE_COORDINATE_SET_COUNT_MAX );
+
+	return m_quantizedStaticMeshVertexDescriptions[textureCoordinateSetCount - 1];
+}
+
 /// Get the description for skinned mesh vertices.
 ///
 /// @return  Skinned mesh vertex description.
@@ -804,6 +870,40 @@ RVertexDescription* RenderResourceManager::GetSkinnedMeshVertexDescription() con
 	return m_spSkinnedMeshVertexDescription;
 }
 
+/// Get the instanced counterpart of a static mesh vertex description.
+///
+/// Instanced descriptions contain the same per-vertex elements as the given description, followed by the rows of the
+/// per-instance transform (InstanceVertex) read from the vertex buffer at INSTANCE_DATA_VERTEX_STREAM_INDEX.
+///
+/// @param[in] pDescription  Static mesh or quantized static mesh vertex description.
+///
+/// @return  Instanced vertex description, or null if the given description has no instanced counterpart (such as
+///          skinned mesh vertex descriptions).
+///
+/// @see GetStaticMeshVertexDescription(), GetQuantizedStaticMeshVertexDescription()
+RVertexDescription* RenderResourceManager::GetInstancedMeshVertexDescription( RVertexDescription* pDescription ) const
+{
+	if ( !pDescription )
+	{
+		return NULL;
+	}
+
+	for ( size_t setIndex = 0; setIndex < MESH_TEXTURE_COORDINATE_SET_COUNT_MAX; ++setIndex )
+	{
+		if ( pDescription == m_staticMeshVertexDescriptions[setIndex] )
+		{
+			return m_instancedStaticMeshVertexDescriptions[setIndex];
+		}
+
+		if ( pDescription == m_quantizedStaticMeshVertexDescriptions[setIndex] )
+		{
+			return m_instancedQuantizedStaticMeshVertexDescriptions[setIndex];
+		}
+	}
+
+	return NULL;
+}
+
 /// Get the texture to which scene color data is written each frame.
 ///
 /// @return  Scene color target texture.
@@ -149,7 +149,9 @@ namespace Helium
 		RVertexDescription* GetScreenVertexDescription() const;
 		RVertexDescription* GetProjectedVertexDescription() const;
 		RVertexDescription* GetStaticMeshVertexDescription( size_t textureCoordinateSetCount ) const;
+		RVertexDescription* GetQuantizedStaticMeshVertexDescription( size_t textureCoordinateSetCount ) const;
 		RVertexDescription* GetSkinnedMeshVertexDescription() const;
+		RVertexDescription* GetInstancedMeshVertexDescription( RVertexDescription* pDescription ) const;
 		//@}
 
 		/// @name Resource Access
@@ -200,8 +202,14 @@ namespace Helium
 		RVertexDescriptionPtr m_spProjectedVertexDescription;
 		/// Static mesh vertex descriptions.
 		RVertexDescriptionPtr m_staticMeshVertexDescriptions[MESH_TEXTURE_COORDINATE_SET_COUNT_MAX];
+		/// Quantized static mesh vertex descriptions.
+		RVertexDescriptionPtr m_quantizedStaticMeshVertexDescriptions[MESH_TEXTURE_COORDINATE_SET_COUNT_MAX];
 		/// Skinned mesh vertex description.
 		RVertexDescriptionPtr m_spSkinnedMeshVertexDescription;
+		/// Static mesh vertex descriptions with per-instance transform data.
+		RVertexDescriptionPtr m_instancedStaticMeshVertexDescriptions[MESH_TEXTURE_COORDINATE_SET_COUNT_MAX];
+		/// Quantized static mesh vertex descriptions with per-instance transform data.
+		RVertexDescriptionPtr m_instancedQuantizedStaticMeshVertexDescriptions[MESH_TEXTURE_COORDINATE_SET_COUNT_MAX];
 
 		/// Scene render texture.
 		RTexture2dPtr m_spSceneTexture;
@@ -0,0 +1,296 @@
+#include "Precompile.h"
+#include "Graphics/RenderThread.h"
+
+#include "Engine/Config.h"
+#include "Engine/FrameProfiler.h"
+#include "Rendering/Renderer.h"
+#include "Graphics/GraphicsConfig.h"
+#include "Graphics/GraphicsScene.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+RenderThread* RenderThread::sm_pInstance = NULL;
+
+/// Constructor.
+RenderThread::RenderThread()
+	: m_pThread( NULL )
+	, m_pWorker( NULL )
+{
+}
+
+/// Destructor.
+RenderThread::~RenderThread()
+{
+	Cleanup();
+}
+
+/// Initialize the render thread.
+///
+/// @return  True if initialization was successful, false if not (including if pipelined rendering is disabled in
+///          the graphics configuration or the active renderer cannot be used from another thread).
+///
+/// @see Cleanup()
+bool RenderThread::Initialize()
+{
+	Cleanup();
+
+	Config* pConfig = Config::GetInstance();
+	if ( !HELIUM_VERIFY( pConfig ) )
+	{
+		return false;
+	}
+
+	StrongPtr< GraphicsConfig > spGraphicsConfig( pConfig->GetConfigObject< GraphicsConfig >( Name( "GraphicsConfig" ) ) );
+	if ( !spGraphicsConfig )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "RenderThread::Initialize(): Initialization failed; missing GraphicsConfig.\n" );
+		return false;
+	}
+
+	if ( !spGraphicsConfig->GetPipelinedRendering() )
+	{
+		HELIUM_TRACE( TraceLevels::Info, "RenderThread::Initialize(): Pipelined rendering disabled.\n" );
+		return false;
+	}
+
+	Renderer* pRenderer = Renderer::GetInstance();
+	if ( !pRenderer || !pRenderer->SupportsAllFeatures( RENDERER_FEATURE_FLAG_MULTITHREADED ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"RenderThread::Initialize(): The active renderer does not support multithreaded use; pipelined rendering disabled.\n" );
+		return false;
+	}
+
+	m_pWorker = new RenderWorker;
+	HELIUM_ASSERT( m_pWorker );
+
+	m_pThread = new RunnableThread( m_pWorker );
+	HELIUM_ASSERT( m_pThread );
+	HELIUM_VERIFY( m_pThread->Start( "RenderThread - scene rendering" ) );
+
+	return true;
+}
+
+/// Finish rendering any queued scenes and shut down the render thread.
+///
+/// @see Initialize()
+void RenderThread::Cleanup()
+{
+	if ( m_pWorker )
+	{
+		Flush();
+		m_pWorker->Stop();
+	}
+
+	if ( m_pThread )
+	{
+		m_pThread->Join();
+		delete m_pThread;
+		m_pThread = NULL;
+	}
+
+	delete m_pWorker;
+	m_pWorker = NULL;
+
+	m_syncCallbacks.Clear();
+}
+
+/// Queue a graphics scene to render its most recently published render snapshot on the render thread.
+///
+/// The scene must not modify the published snapshot until the next call to Flush().
+///
+/// @param[in] pScene  Scene to render.
+///
+/// @see Flush()
+void RenderThread::QueueScene( GraphicsScene* pScene )
+{
+	HELIUM_ASSERT( pScene );
+	HELIUM_ASSERT( m_pWorker );
+
+	m_pWorker->QueueScene( pScene );
+}
+
+/// Defer a game thread callback to the next synchronization point.
+///
+/// This is used for per-frame work that touches data shared with rendering (such as resource caches), which must
+/// not run while the render thread is busy.  A callback queued more than once before the next synchronization point
+/// is only run once.
+///
+/// @param[in] pCallback  Callback to run.
+///
+/// @see Flush()
+void RenderThread::QueueSyncCallback( SYNC_CALLBACK pCallback )
+{
+	HELIUM_ASSERT( pCallback );
+
+	size_t callbackCount = m_syncCallbacks.GetSize();
+	for ( size_t callbackIndex = 0; callbackIndex < callbackCount; ++callbackIndex )
+	{
+		if ( m_syncCallbacks[callbackIndex] == pCallback )
+		{
+			return;
+		}
+	}
+
+	m_syncCallbacks.Push( pCallback );
+}
+
+/// Block until all queued scenes have been rendered, then run any deferred synchronization callbacks.
+///
+/// @see QueueScene(), QueueSyncCallback()
+void RenderThread::Flush()
+{
+	HELIUM_FRAME_ZONE( "RenderThread::Flush" );
+
+	if ( m_pWorker )
+	{
+		m_pWorker->Flush();
+	}
+
+	// Callbacks may queue further callbacks, so don't cache the array size.
+	for ( size_t callbackIndex = 0; callbackIndex < m_syncCallbacks.GetSize(); ++callbackIndex )
+	{
+		SYNC_CALLBACK pCallback = m_syncCallbacks[callbackIndex];
+		HELIUM_ASSERT( pCallback );
+		pCallback();
+	}
+
+	m_syncCallbacks.Resize( 0 );
+}
+
+/// Get the singleton RenderThread instance.
+///
+/// @return  Pointer to the RenderThread instance, or null if pipelined rendering is not active.
+///
+/// @see Startup(), Shutdown()
+RenderThread* RenderThread::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton RenderThread instance.
+///
+/// @see Shutdown(), GetInstance()
+void RenderThread::Startup()
+{
+	if ( ++g_InitCount == 1 )
+	{
+		Config::Startup();
+
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new RenderThread;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !sm_pInstance->Initialize() )
+		{
+			delete sm_pInstance;
+			sm_pInstance = NULL;
+		}
+	}
+}
+
+/// Destroy the singleton RenderThread instance.
+///
+/// @see Startup(), GetInstance()
+void RenderThread::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		if ( sm_pInstance )
+		{
+			sm_pInstance->Cleanup();
+			delete sm_pInstance;
+			sm_pInstance = NULL;
+		}
+
+		Config::Shutdown();
+	}
+}
+
+/// Constructor.
+RenderThread::RenderWorker::RenderWorker()
+	: m_wakeUpCondition( false, false )
+	, m_renderedCondition( false, false )
+	, m_pendingCounter( 0 )
+	, m_stopCounter( 0 )
+{
+}
+
+/// Destructor.
+RenderThread::RenderWorker::~RenderWorker()
+{
+}
+
+/// Render queued scenes until stopped.
+void RenderThread::RenderWorker::Run()
+{
+	FrameProfiler* pFrameProfiler = FrameProfiler::GetInstance();
+	if ( pFrameProfiler )
+	{
+		pFrameProfiler->SetThreadName( "RenderThread" );
+	}
+
+	while ( m_stopCounter == 0 )
+	{
+		GraphicsScene* pScene = NULL;
+		{
+			Locker< DynamicArray< GraphicsScene* >, SpinLock >::Handle handle( m_sceneQueue );
+			if ( !handle->IsEmpty() )
+			{
+				pScene = ( *handle )[0];
+				handle->Remove( 0 );
+			}
+		}
+
+		if ( !pScene )
+		{
+			// Queue is empty, so sleep until notified.
+			m_wakeUpCondition.Wait();
+
+			continue;
+		}
+
+		pScene->Render();
+
+		AtomicDecrementRelease( m_pendingCounter );
+		m_renderedCondition.Signal();
+	}
+}
+
+/// Request the render worker to stop processing and return at the next possible opportunity.
+void RenderThread::RenderWorker::Stop()
+{
+	AtomicExchangeRelease( m_stopCounter, 1 );
+	m_wakeUpCondition.Signal();
+}
+
+/// Queue a scene for rendering.
+///
+/// @param[in] pScene  Scene to render.
+///
+/// @see Flush()
+void RenderThread::RenderWorker::QueueScene( GraphicsScene* pScene )
+{
+	HELIUM_ASSERT( pScene );
+
+	AtomicIncrementAcquire( m_pendingCounter );
+
+	{
+		Locker< DynamicArray< GraphicsScene* >, SpinLock >::Handle handle( m_sceneQueue );
+		handle->Push( pScene );
+	}
+
+	m_wakeUpCondition.Signal();
+}
+
+/// Block the current thread until all queued scenes have been rendered.
+///
+/// @see QueueScene()
+void RenderThread::RenderWorker::Flush()
+{
+	while ( m_pendingCounter != 0 )
+	{
+		m_renderedCondition.Wait();
+	}
+}
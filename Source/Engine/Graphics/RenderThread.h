@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	class GraphicsScene;
+
+	/// Dedicated thread for pipelined scene rendering.
+	///
+	/// When pipelined rendering is enabled in the graphics configuration, each graphics scene captures an immutable
+	/// render snapshot of its state on the game thread and queues itself with this manager instead of rendering
+	/// inline.  The render thread then renders the snapshot while the game thread moves on to simulating the next
+	/// frame, so frame time approaches the longer of the simulation and rendering times instead of their sum.
+	///
+	/// Flush() is the synchronization point between the two threads: it blocks until all queued scenes have been
+	/// rendered, then runs any game thread callbacks deferred with QueueSyncCallback() while the render thread is
+	/// known to be idle.
+	///
+	/// The render thread is only started if the active renderer reports RENDERER_FEATURE_FLAG_MULTITHREADED.
+	class HELIUM_GRAPHICS_API RenderThread : NonCopyable
+	{
+	public:
+		/// Callback run on the game thread at the next synchronization point.
+		typedef void ( *SYNC_CALLBACK )();
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Frame Submission
+		//@{
+		void QueueScene( GraphicsScene* pScene );
+		void QueueSyncCallback( SYNC_CALLBACK pCallback );
+
+		void Flush();
+		//@}
+
+		/// @name Static Access
+		//@{
+		static RenderThread* GetInstance();
+		static void Startup();
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Render thread runnable.
+		class RenderWorker : public Runnable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			RenderWorker();
+			virtual ~RenderWorker();
+			//@}
+
+			/// @name Runnable Interface
+			//@{
+			virtual void Run();
+			//@}
+
+			/// @name External Thread Control
+			//@{
+			void Stop();
+			//@}
+
+			/// @name External Queue Control
+			//@{
+			void QueueScene( GraphicsScene* pScene );
+			void Flush();
+			//@}
+
+		private:
+			/// Scenes waiting to be rendered, in submission order.
+			Locker< DynamicArray< GraphicsScene* >, SpinLock > m_sceneQueue;
+			/// Condition used to wake up the render thread when scenes are queued (or when it should shut down).
+			Condition m_wakeUpCondition;
+			/// Condition signaled by the render thread each time it finishes rendering a scene.
+			Condition m_renderedCondition;
+
+			/// Number of scenes queued that have not finished rendering.
+			volatile int32_t m_pendingCounter;
+			/// Non-zero if this thread should stop when next possible, zero if it should continue.
+			volatile int32_t m_stopCounter;
+		};
+
+		/// Callbacks to run at the next synchronization point.
+		DynamicArray< SYNC_CALLBACK > m_syncCallbacks;
+
+		/// Rendering thread.
+		RunnableThread* m_pThread;
+		/// Rendering thread worker.
+		RenderWorker* m_pWorker;
+
+		/// Singleton instance.
+		static RenderThread* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		RenderThread();
+		~RenderThread();
+		//@}
+	};
+}
@@ -3,6 +3,7 @@
 
 #include "Platform/Thread.h"
 #include "Engine/AssetLoader.h"
+#include "Engine/MemoryTracker.h"
 #include "Rendering/RPixelShader.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RVertexShader.h"
@@ -191,8 +192,9 @@ void Shader::PostSave()
     // XXX TMC TODO: Replace with a more robust method for checking whether we're running within the editor.
     if( !IsDefaultTemplate() && m_bPrecacheAllVariants && sm_pBeginLoadVariantOverride )
     {
-        AssetLoader* pAssetLoader = AssetLoader::GetInstance();
-        HELIUM_ASSERT( pAssetLoader );
+        // Begin loading all variants up front so that they are processed as a single batch, then sync with each
+        // request as it completes instead of waiting on each variant in turn.
+        DynamicArray< size_t > loadIds;
 
         for( size_t shaderTypeIndex = 0; shaderTypeIndex < HELIUM_ARRAY_COUNT( m_variantCounts ); ++shaderTypeIndex )
         {
@@ -200,18 +202,38 @@ void Shader::PostSave()
 
             size_t variantCount = m_variantCounts[ shaderTypeIndex ];
             HELIUM_ASSERT( variantCount <= UINT32_MAX );
+            loadIds.Reserve( loadIds.GetSize() + variantCount );
             for( size_t variantIndex = 0; variantIndex < variantCount; ++variantIndex )
             {
                 size_t loadId = BeginLoadVariant( shaderType, static_cast< uint32_t >( variantIndex ) );
                 if( IsValid( loadId ) )
                 {
-                    ShaderVariantPtr spVariant;
-                    while( !TryFinishLoadVariant( loadId, spVariant ) )
-                    {
-                        Thread::Yield();
-                    }
+                    loadIds.Push( loadId );
+                }
+            }
+        }
+
+        while( !loadIds.IsEmpty() )
+        {
+            bool bFinishedAny = false;
+
+            size_t loadIndex = loadIds.GetSize();
+            while( loadIndex != 0 )
+            {
+                --loadIndex;
+
+                ShaderVariantPtr spVariant;
+                if( TryFinishLoadVariant( loadIds[ loadIndex ], spVariant ) )
+                {
+                    loadIds.RemoveSwap( loadIndex );
+                    bFinishedAny = true;
                 }
             }
+
+            if( !bFinishedAny )
+            {
+                Thread::Yield();
+            }
         }
     }
 }
@@ -263,23 +285,7 @@ size_t Shader::BeginLoadVariant( RShader::EType shaderType, uint32_t userOptionI
         return loadId;
     }
 
-    // Build the object path name.
-    char shaderTypeCharacter;
-    if( shaderType == RShader::TYPE_VERTEX )
-    {
-        shaderTypeCharacter = 'v';
-    }
-    else
-    {
-        HELIUM_ASSERT( shaderType == RShader::TYPE_PIXEL );
-        shaderTypeCharacter = 'p';
-    }
-
-    String variantNameString;
-    variantNameString.Format( "%c%" PRIu32, shaderTypeCharacter, userOptionIndex );
-
-    AssetPath variantPath;
-    HELIUM_VERIFY( variantPath.Set( Name( variantNameString ), false, GetPath() ) );
+    AssetPath variantPath = GetVariantPath( GetPath(), shaderType, userOptionIndex );
 
     // Begin the load process.
     AssetLoader* pAssetLoader = AssetLoader::GetInstance();
@@ -325,6 +331,35 @@ bool Shader::TryFinishLoadVariant( size_t loadId, ShaderVariantPtr& rspVariant )
     return bFinished;
 }
 
+/// Get the asset path of a shader variant.
+///
+/// @param[in] rShaderPath      Path of the shader owning the variant.
+/// @param[in] shaderType       Shader type.
+/// @param[in] userOptionIndex  Index associated with the user option combination for the shader variant.
+///
+/// @return  Shader variant path.
+AssetPath Shader::GetVariantPath( const AssetPath& rShaderPath, RShader::EType shaderType, uint32_t userOptionIndex )
+{
+    char shaderTypeCharacter;
+    if( shaderType == RShader::TYPE_VERTEX )
+    {
+        shaderTypeCharacter = 'v';
+    }
+    else
+    {
+        HELIUM_ASSERT( shaderType == RShader::TYPE_PIXEL );
+        shaderTypeCharacter = 'p';
+    }
+
+    String variantNameString;
+    variantNameString.Format( "%c%" PRIu32, shaderTypeCharacter, userOptionIndex );
+
+    AssetPath variantPath;
+    HELIUM_VERIFY( variantPath.Set( Name( variantNameString ), false, rShaderPath ) );
+
+    return variantPath;
+}
+
 /// Set override callbacks for loading shader variants.
 ///
 /// @param[in] pBeginLoadVariantOverride      Override callback to initiate loading of a shader variant.
@@ -813,6 +848,8 @@ bool ShaderVariant::TryFinishPrecacheResourceData()
     Renderer* pRenderer = Renderer::GetInstance();
     HELIUM_ASSERT( pRenderer );
 
+    HELIUM_MEMORY_SCOPE( MEMORY_TAG_SHADER );
+
     // Get the type of shader being loaded.
     Name variantName = GetName();
     char shaderTypeCharacter = ( *variantName )[ 0 ];
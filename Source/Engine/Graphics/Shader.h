@@ -312,8 +312,13 @@ namespace Helium
 
 		/// @name Variant Identification
 		//@{
+		inline uint32_t GetVariantCount( RShader::EType shaderType ) const;
+
 		size_t BeginLoadVariant( RShader::EType shaderType, uint32_t userOptionIndex );
 		bool TryFinishLoadVariant( size_t loadId, ShaderVariantPtr& rspVariant );
+
+		static AssetPath GetVariantPath(
+			const AssetPath& rShaderPath, RShader::EType shaderType, uint32_t userOptionIndex );
 		//@}
 
 		/// @name Variant Load Override Support
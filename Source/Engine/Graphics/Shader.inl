@@ -188,6 +188,18 @@ namespace Helium
         return m_persistentResourceData.GetUserOptions();
     }
 
+    /// Get the number of user option variants available for a given shader type.
+    ///
+    /// @param[in] shaderType  Shader type.
+    ///
+    /// @return  Number of shader variants.
+    uint32_t Shader::GetVariantCount( RShader::EType shaderType ) const
+    {
+        HELIUM_ASSERT( static_cast< size_t >( shaderType ) < static_cast< size_t >( RShader::TYPE_MAX ) );
+
+        return m_variantCounts[ shaderType ];
+    }
+
     /// Get the currently registered override callback for handling shader variant begin-load calls.
     ///
     /// @return  Pointer to the currently registered begin-load override callback.
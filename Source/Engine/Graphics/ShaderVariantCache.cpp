@@ -0,0 +1,825 @@
+#include "Precompile.h"
+#include "Graphics/ShaderVariantCache.h"
+
+#include "Platform/Thread.h"
+#include "Engine/AssetLoader.h"
+#include "Engine/Config.h"
+#include "Engine/FileLocations.h"
+#include "EngineJobs/EngineJobsInterface.h"
+#include "Graphics/GraphicsConfig.h"
+#include "Graphics/Material.h"
+#include "Persist/Archive.h"
+
+#include "Reflect/TranslatorDeduction.h"
+
+HELIUM_DEFINE_BASE_STRUCT( Helium::ShaderVariantUsage );
+HELIUM_DEFINE_CLASS( Helium::ShaderVariantUsageList );
+
+using namespace Helium;
+
+/// Usage record comparison (sorts most used records first).
+class ShaderVariantUsageCompare
+{
+public:
+	/// Compare two usage records.
+	///
+	/// @param[in] rUsage0  First usage record.
+	/// @param[in] rUsage1  Second usage record.
+	///
+	/// @return  True if the first record was used more often than the second, false if not.
+	bool operator()( const ShaderVariantUsage& rUsage0, const ShaderVariantUsage& rUsage1 ) const
+	{
+		return ( rUsage0.useCount > rUsage1.useCount );
+	}
+};
+
+static uint32_t g_InitCount = 0;
+ShaderVariantCache* ShaderVariantCache::sm_pInstance = NULL;
+
+void ShaderVariantUsage::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &ShaderVariantUsage::shaderPath,       "shaderPath" );
+	comp.AddField( &ShaderVariantUsage::shaderType,       "shaderType" );
+	comp.AddField( &ShaderVariantUsage::userOptionIndex,  "userOptionIndex" );
+	comp.AddField( &ShaderVariantUsage::useCount,         "useCount" );
+}
+
+void ShaderVariantUsageList::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &ShaderVariantUsageList::m_usage, "m_usage" );
+}
+
+/// Constructor.
+ShaderVariantCache::ShaderVariantCache()
+	: m_entryCountMax( 0 )
+	, m_frameIndex( 0 )
+{
+}
+
+/// Destructor.
+ShaderVariantCache::~ShaderVariantCache()
+{
+	Cleanup();
+}
+
+/// Initialize the shader variant cache and queue the warm-up list recorded during previous sessions.
+///
+/// @return  True if initialization was successful, false if not (including if the cache is disabled in the graphics
+///          configuration).
+///
+/// @see Cleanup()
+bool ShaderVariantCache::Initialize()
+{
+	Cleanup();
+
+	Config* pConfig = Config::GetInstance();
+	if ( !HELIUM_VERIFY( pConfig ) )
+	{
+		return false;
+	}
+
+	StrongPtr< GraphicsConfig > spGraphicsConfig( pConfig->GetConfigObject< GraphicsConfig >( Name( "GraphicsConfig" ) ) );
+	if ( !spGraphicsConfig )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "ShaderVariantCache::Initialize(): Initialization failed; missing GraphicsConfig.\n" );
+		return false;
+	}
+
+	m_entryCountMax = spGraphicsConfig->GetShaderVariantCacheSize();
+	if ( m_entryCountMax == 0 )
+	{
+		HELIUM_TRACE( TraceLevels::Info, "ShaderVariantCache::Initialize(): Shader variant cache disabled.\n" );
+		return false;
+	}
+
+	LoadUsage();
+
+	return true;
+}
+
+/// Release all cached shader variants and shut down the cache.
+///
+/// Any variant loads in progress are completed before returning.
+///
+/// @see Initialize()
+void ShaderVariantCache::Cleanup()
+{
+	// Drop the entries still held by materials so that they can acquire them again if the cache is reinitialized.
+	size_t materialCount = m_materials.GetSize();
+	for ( size_t materialIndex = 0; materialIndex < materialCount; ++materialIndex )
+	{
+		if ( m_materials.IsElementValid( materialIndex ) )
+		{
+			m_materials[materialIndex]->ReleaseShaderVariantCacheEntries();
+		}
+	}
+
+	m_materials.Clear();
+
+	AssetLoader* pAssetLoader = AssetLoader::GetInstance();
+
+	size_t warmUpRequestCount = m_warmUpRequests.GetSize();
+	for ( size_t requestIndex = 0; requestIndex < warmUpRequestCount; ++requestIndex )
+	{
+		HELIUM_ASSERT( pAssetLoader );
+
+		AssetPtr spObject;
+		while ( !pAssetLoader->TryFinishLoad( m_warmUpRequests[requestIndex].loadId, spObject ) )
+		{
+			Thread::Yield();
+		}
+	}
+
+	size_t loadingCount = m_loadingEntries.GetSize();
+	for ( size_t loadingIndex = 0; loadingIndex < loadingCount; ++loadingIndex )
+	{
+		Entry& rEntry = m_entries[m_loadingEntries[loadingIndex]];
+		HELIUM_ASSERT( rEntry.state == ENTRY_STATE_LOADING );
+
+		Shader* pShader = rEntry.spShader;
+		HELIUM_ASSERT( pShader );
+		while ( !pShader->TryFinishLoadVariant( rEntry.loadId, rEntry.spVariant ) )
+		{
+			Thread::Yield();
+		}
+	}
+
+	m_entries.Clear();
+	m_entryMap.Clear();
+
+	m_demandQueue.Clear();
+	m_prefetchQueue.Clear();
+	m_loadingEntries.Clear();
+
+	m_usage.Clear();
+	m_usageMap.Clear();
+
+	m_warmUpList.Clear();
+	m_warmUpRequests.Clear();
+
+	m_evictionIndices.Clear();
+
+	m_entryCountMax = 0;
+}
+
+/// Acquire a reference to a shader variant, queuing it for loading if it is not already cached.
+///
+/// Variants are cached by their shader and user option index, so materials sharing the same option set share a single
+/// cache entry.  An acquired entry is never released from the cache until each reference to it has been released.
+///
+/// @param[in] pShader          Shader owning the variant.
+/// @param[in] shaderType       Shader type.
+/// @param[in] userOptionIndex  Index associated with the user option combination for the variant.
+///
+/// @return  Index of the cache entry for the variant, or an invalid index if the variant does not exist.
+///
+/// @see Release(), GetVariant()
+size_t ShaderVariantCache::Acquire( Shader* pShader, RShader::EType shaderType, uint32_t userOptionIndex )
+{
+	size_t entryIndex = FindOrAddEntry( pShader, shaderType, userOptionIndex, true );
+	if ( IsValid( entryIndex ) )
+	{
+		++m_entries[entryIndex].referenceCount;
+	}
+
+	return entryIndex;
+}
+
+/// Release a reference to a shader variant acquired using Acquire().
+///
+/// @param[in] entryIndex  Index of the cache entry to release.
+///
+/// @see Acquire()
+void ShaderVariantCache::Release( size_t entryIndex )
+{
+	if ( IsInvalid( entryIndex ) || entryIndex >= m_entries.GetSize() || !m_entries.IsElementValid( entryIndex ) )
+	{
+		return;
+	}
+
+	Entry& rEntry = m_entries[entryIndex];
+	HELIUM_ASSERT( rEntry.referenceCount != 0 );
+	--rEntry.referenceCount;
+}
+
+/// Get the shader variant for a cache entry, marking it as used in the current frame.
+///
+/// @param[in] entryIndex  Index of the cache entry, as returned by Acquire().
+///
+/// @return  Shader variant, or null if the variant has not finished loading or failed to load.
+///
+/// @see Acquire()
+ShaderVariant* ShaderVariantCache::GetVariant( size_t entryIndex )
+{
+	HELIUM_ASSERT( entryIndex < m_entries.GetSize() );
+	HELIUM_ASSERT( m_entries.IsElementValid( entryIndex ) );
+
+	Entry& rEntry = m_entries[entryIndex];
+	if ( rEntry.lastUseFrame != m_frameIndex )
+	{
+		rEntry.lastUseFrame = m_frameIndex;
+
+		if ( IsInvalid( rEntry.usageIndex ) )
+		{
+			rEntry.usageIndex = FindOrAddUsage( rEntry );
+		}
+
+		++m_usage[rEntry.usageIndex].useCount;
+	}
+
+	return rEntry.spVariant;
+}
+
+/// Queue a shader variant for loading in the background without acquiring it.
+///
+/// Prefetched variants are only loaded while no variants needed for rendering are waiting to load, and are released
+/// once they become the least recently used variants in an over-full cache.
+///
+/// @param[in] pShader          Shader owning the variant.
+/// @param[in] shaderType       Shader type.
+/// @param[in] userOptionIndex  Index associated with the user option combination for the variant.
+void ShaderVariantCache::Prefetch( Shader* pShader, RShader::EType shaderType, uint32_t userOptionIndex )
+{
+	FindOrAddEntry( pShader, shaderType, userOptionIndex, false );
+}
+
+/// Start tracking a material that has acquired variants from this cache.
+///
+/// Tracked materials that have not resolved their variants for MATERIAL_IDLE_FRAME_COUNT frames release their cache
+/// entries during Update().
+///
+/// @param[in] pMaterial  Material holding acquired cache entries.
+///
+/// @return  Index with which to remove the material again.
+///
+/// @see RemoveMaterial()
+size_t ShaderVariantCache::AddMaterial( Material* pMaterial )
+{
+	HELIUM_ASSERT( pMaterial );
+
+	Material** ppMaterial = m_materials.New();
+	HELIUM_ASSERT( ppMaterial );
+	*ppMaterial = pMaterial;
+
+	return m_materials.GetElementIndex( ppMaterial );
+}
+
+/// Stop tracking a material added using AddMaterial().
+///
+/// @param[in] materialIndex  Index returned by AddMaterial().
+///
+/// @see AddMaterial()
+void ShaderVariantCache::RemoveMaterial( size_t materialIndex )
+{
+	if ( IsInvalid( materialIndex ) || materialIndex >= m_materials.GetSize() || !m_materials.IsElementValid( materialIndex ) )
+	{
+		return;
+	}
+
+	m_materials.Remove( materialIndex );
+}
+
+/// Update pending variant loads, warm up recorded variants, and release least recently used variants if the cache is
+/// over its size limit.  This should be called once per frame, after all rendering for the frame has been issued.
+void ShaderVariantCache::Update()
+{
+	// Sync with completed variant loads.
+	size_t loadingIndex = m_loadingEntries.GetSize();
+	while ( loadingIndex != 0 )
+	{
+		--loadingIndex;
+
+		Entry& rEntry = m_entries[m_loadingEntries[loadingIndex]];
+		HELIUM_ASSERT( rEntry.state == ENTRY_STATE_LOADING );
+
+		Shader* pShader = rEntry.spShader;
+		HELIUM_ASSERT( pShader );
+		if ( !pShader->TryFinishLoadVariant( rEntry.loadId, rEntry.spVariant ) )
+		{
+			continue;
+		}
+
+		if ( !rEntry.spVariant )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"ShaderVariantCache::Update(): Failed to load shader variant \"%s\".\n",
+				*rEntry.path.ToString() );
+		}
+
+		SetInvalid( rEntry.loadId );
+		rEntry.state = ENTRY_STATE_LOADED;
+
+		m_loadingEntries.RemoveSwap( loadingIndex );
+	}
+
+	// Variants needed for rendering take priority over warming up the cache.
+	BeginLoads( m_demandQueue );
+	UpdateWarmUp();
+	if ( m_demandQueue.IsEmpty() )
+	{
+		BeginLoads( m_prefetchQueue );
+	}
+
+	// Let go of variants held by materials that are no longer being drawn, so that they can be evicted.
+	ReleaseIdleMaterials();
+
+	if ( m_entryMap.GetSize() > m_entryCountMax )
+	{
+		Evict();
+	}
+
+	++m_frameIndex;
+}
+
+/// Save the recorded shader variant usage to the user data directory for warming up the cache in future sessions.
+///
+/// @return  True if the usage list was saved successfully, false if not.
+bool ShaderVariantCache::SaveUsage() const
+{
+	FilePath usageFilePath;
+	if ( !GetUsageFilePath( usageFilePath ) )
+	{
+		HELIUM_TRACE( TraceLevels::Warning, "ShaderVariantCache::SaveUsage(): No user data directory could be determined.\n" );
+		return false;
+	}
+
+	ShaderVariantUsageList* pUsageList = new ShaderVariantUsageList;
+	HELIUM_ASSERT( pUsageList );
+	Reflect::ObjectPtr spUsageList( pUsageList );
+
+	DynamicArray< ShaderVariantUsage >& rUsage = pUsageList->m_usage;
+	rUsage = m_usage;
+
+	if ( !rUsage.IsEmpty() )
+	{
+		SortJob< ShaderVariantUsage, ShaderVariantUsageCompare > sortJob;
+		SortJob< ShaderVariantUsage, ShaderVariantUsageCompare >::Parameters& rParameters = sortJob.GetParameters();
+		rParameters.pBase = rUsage.GetData();
+		rParameters.count = rUsage.GetSize();
+		rParameters.compare = ShaderVariantUsageCompare();
+		rParameters.singleJobCount = 100;
+		sortJob.Run();
+	}
+
+	// Only keep as many variants as the cache can hold, and drop variants that are no longer used.
+	size_t usageCount = Min( rUsage.GetSize(), m_entryCountMax );
+	while ( usageCount != 0 && rUsage[usageCount - 1].useCount == 0 )
+	{
+		--usageCount;
+	}
+
+	rUsage.Resize( usageCount );
+
+	Persist::ArchiveWriter::WriteToFile( usageFilePath, spUsageList );
+
+	return true;
+}
+
+/// Get the singleton ShaderVariantCache instance.
+///
+/// @return  Pointer to the ShaderVariantCache instance, or null if shader variant caching is not active.
+///
+/// @see Startup(), Shutdown()
+ShaderVariantCache* ShaderVariantCache::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton ShaderVariantCache instance.
+///
+/// @see Shutdown(), GetInstance()
+void ShaderVariantCache::Startup()
+{
+	if ( ++g_InitCount == 1 )
+	{
+		Config::Startup();
+
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new ShaderVariantCache;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !sm_pInstance->Initialize() )
+		{
+			delete sm_pInstance;
+			sm_pInstance = NULL;
+		}
+	}
+}
+
+/// Save recorded variant usage and destroy the singleton ShaderVariantCache instance.
+///
+/// @see Startup(), GetInstance()
+void ShaderVariantCache::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		if ( sm_pInstance )
+		{
+			sm_pInstance->SaveUsage();
+			sm_pInstance->Cleanup();
+			delete sm_pInstance;
+			sm_pInstance = NULL;
+		}
+
+		Config::Shutdown();
+	}
+}
+
+/// Find the cache entry for a shader variant, adding and queuing the variant for loading if it is not yet cached.
+///
+/// @param[in] pShader          Shader owning the variant.
+/// @param[in] shaderType       Shader type.
+/// @param[in] userOptionIndex  Index associated with the user option combination for the variant.
+/// @param[in] bDemand          True if the variant is needed for rendering, false if it is being prefetched.
+///
+/// @return  Index of the cache entry for the variant, or an invalid index if the variant does not exist.
+size_t ShaderVariantCache::FindOrAddEntry(
+	Shader* pShader,
+	RShader::EType shaderType,
+	uint32_t userOptionIndex,
+	bool bDemand )
+{
+	HELIUM_ASSERT( pShader );
+	HELIUM_ASSERT( static_cast< size_t >( shaderType ) < static_cast< size_t >( RShader::TYPE_MAX ) );
+
+	if ( userOptionIndex >= pShader->GetVariantCount( shaderType ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"ShaderVariantCache: Invalid user option index %" PRIu32 " specified for variant of shader \"%s\".\n",
+			userOptionIndex,
+			*pShader->GetPath().ToString() );
+
+		return Invalid< size_t >();
+	}
+
+	AssetPath variantPath = Shader::GetVariantPath( pShader->GetPath(), shaderType, userOptionIndex );
+
+	HashMap< AssetPath, size_t >::Iterator entryIterator = m_entryMap.Find( variantPath );
+	if ( entryIterator != m_entryMap.End() )
+	{
+		size_t entryIndex = entryIterator->Second();
+		HELIUM_ASSERT( m_entries.IsElementValid( entryIndex ) );
+
+		// Promote prefetched variants that are now needed for rendering.
+		if ( bDemand && m_entries[entryIndex].state == ENTRY_STATE_QUEUED )
+		{
+			size_t queueIndex = m_prefetchQueue.GetSize();
+			while ( queueIndex != 0 )
+			{
+				--queueIndex;
+				if ( m_prefetchQueue[queueIndex] == entryIndex )
+				{
+					m_prefetchQueue.Remove( queueIndex );
+					m_demandQueue.Push( entryIndex );
+
+					break;
+				}
+			}
+		}
+
+		return entryIndex;
+	}
+
+	Entry* pEntry = m_entries.New();
+	HELIUM_ASSERT( pEntry );
+	pEntry->path = variantPath;
+	pEntry->spShader = pShader;
+	SetInvalid( pEntry->loadId );
+	SetInvalid( pEntry->usageIndex );
+	pEntry->lastUseFrame = m_frameIndex - 1;  // Not used yet this frame.
+	pEntry->referenceCount = 0;
+	pEntry->userOptionIndex = userOptionIndex;
+	pEntry->shaderType = shaderType;
+	pEntry->state = ENTRY_STATE_QUEUED;
+
+	size_t entryIndex = m_entries.GetElementIndex( pEntry );
+	HELIUM_VERIFY( m_entryMap.Insert( entryIterator, HashMap< AssetPath, size_t >::ValueType( variantPath, entryIndex ) ) );
+
+	if ( bDemand )
+	{
+		m_demandQueue.Push( entryIndex );
+	}
+	else
+	{
+		m_prefetchQueue.Push( entryIndex );
+	}
+
+	return entryIndex;
+}
+
+/// Find the usage record for a cache entry, adding a new record if the variant has not been used before.
+///
+/// @param[in] rEntry  Cache entry.
+///
+/// @return  Index of the usage record for the entry.
+size_t ShaderVariantCache::FindOrAddUsage( const Entry& rEntry )
+{
+	HashMap< AssetPath, size_t >::Iterator usageIterator = m_usageMap.Find( rEntry.path );
+	if ( usageIterator != m_usageMap.End() )
+	{
+		return usageIterator->Second();
+	}
+
+	ShaderVariantUsage* pUsage = m_usage.New();
+	HELIUM_ASSERT( pUsage );
+	pUsage->shaderPath = Name( rEntry.spShader->GetPath().ToString() );
+	pUsage->shaderType = static_cast< uint32_t >( rEntry.shaderType );
+	pUsage->userOptionIndex = rEntry.userOptionIndex;
+	pUsage->useCount = 0;
+
+	size_t usageIndex = m_usage.GetSize() - 1;
+	HELIUM_VERIFY( m_usageMap.Insert( usageIterator, HashMap< AssetPath, size_t >::ValueType( rEntry.path, usageIndex ) ) );
+
+	return usageIndex;
+}
+
+/// Begin loading queued variants, in queue order, until the maximum number of concurrent loads is reached.
+///
+/// @param[in] rQueue  Queue of entries waiting to load.
+void ShaderVariantCache::BeginLoads( DynamicArray< size_t >& rQueue )
+{
+	size_t queueSize = rQueue.GetSize();
+	size_t queueIndex = 0;
+	while ( queueIndex < queueSize && m_loadingEntries.GetSize() < LOAD_COUNT_MAX )
+	{
+		size_t entryIndex = rQueue[queueIndex];
+		++queueIndex;
+
+		Entry& rEntry = m_entries[entryIndex];
+		HELIUM_ASSERT( rEntry.state == ENTRY_STATE_QUEUED );
+
+		Shader* pShader = rEntry.spShader;
+		HELIUM_ASSERT( pShader );
+		rEntry.loadId = pShader->BeginLoadVariant( rEntry.shaderType, rEntry.userOptionIndex );
+		if ( IsInvalid( rEntry.loadId ) )
+		{
+			rEntry.state = ENTRY_STATE_LOADED;
+
+			continue;
+		}
+
+		rEntry.state = ENTRY_STATE_LOADING;
+		m_loadingEntries.Push( entryIndex );
+	}
+
+	rQueue.Remove( 0, queueIndex );
+}
+
+/// Load the shaders for variants on the warm-up list and prefetch the variants once their shaders are loaded.
+void ShaderVariantCache::UpdateWarmUp()
+{
+	AssetLoader* pAssetLoader = AssetLoader::GetInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	size_t requestIndex = m_warmUpRequests.GetSize();
+	while ( requestIndex != 0 )
+	{
+		--requestIndex;
+
+		WarmUpRequest& rRequest = m_warmUpRequests[requestIndex];
+
+		AssetPtr spObject;
+		if ( !pAssetLoader->TryFinishLoad( rRequest.loadId, spObject ) )
+		{
+			continue;
+		}
+
+		Shader* pShader = Reflect::SafeCast< Shader >( spObject.Get() );
+		if ( pShader && rRequest.userOptionIndex < pShader->GetVariantCount( rRequest.shaderType ) )
+		{
+			Prefetch( pShader, rRequest.shaderType, rRequest.userOptionIndex );
+		}
+
+		m_warmUpRequests.RemoveSwap( requestIndex );
+	}
+
+	// Only start warming up additional variants while no variants are needed for rendering and the cache has room.
+	while ( !m_warmUpList.IsEmpty() &&
+		m_demandQueue.IsEmpty() &&
+		m_warmUpRequests.GetSize() < WARM_UP_SHADER_LOAD_COUNT_MAX &&
+		m_entryMap.GetSize() + m_warmUpRequests.GetSize() < m_entryCountMax )
+	{
+		ShaderVariantUsage usage = m_warmUpList.GetLast();
+		m_warmUpList.Pop();
+
+		WarmUpRequest request;
+		if ( !request.shaderPath.Set( *usage.shaderPath ) )
+		{
+			continue;
+		}
+
+		request.shaderType = static_cast< RShader::EType >( usage.shaderType );
+		request.userOptionIndex = usage.userOptionIndex;
+
+		if ( m_entryMap.Find( Shader::GetVariantPath( request.shaderPath, request.shaderType, request.userOptionIndex ) ) !=
+			m_entryMap.End() )
+		{
+			continue;
+		}
+
+		request.loadId = pAssetLoader->BeginLoadObject( request.shaderPath );
+		if ( IsValid( request.loadId ) )
+		{
+			m_warmUpRequests.Push( request );
+		}
+	}
+}
+
+/// Release the cache entries held by materials whose variants have not been resolved for MATERIAL_IDLE_FRAME_COUNT
+/// frames.
+void ShaderVariantCache::ReleaseIdleMaterials()
+{
+	size_t materialCount = m_materials.GetSize();
+	for ( size_t materialIndex = 0; materialIndex < materialCount; ++materialIndex )
+	{
+		if ( !m_materials.IsElementValid( materialIndex ) )
+		{
+			continue;
+		}
+
+		// Releasing the entries removes the material from the list.
+		Material* pMaterial = m_materials[materialIndex];
+		HELIUM_ASSERT( pMaterial );
+		if ( m_frameIndex - pMaterial->GetShaderVariantResolveFrame() >= MATERIAL_IDLE_FRAME_COUNT )
+		{
+			pMaterial->ReleaseShaderVariantCacheEntries();
+		}
+	}
+}
+
+/// Release the least recently used variants that are not currently acquired until the cache is within its size
+/// limit.
+void ShaderVariantCache::Evict()
+{
+	m_evictionIndices.Resize( 0 );
+
+	size_t entryCount = m_entries.GetSize();
+	for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		if ( !m_entries.IsElementValid( entryIndex ) )
+		{
+			continue;
+		}
+
+		const Entry& rEntry = m_entries[entryIndex];
+		if ( rEntry.state == ENTRY_STATE_LOADED && rEntry.referenceCount == 0 )
+		{
+			m_evictionIndices.Push( entryIndex );
+		}
+	}
+
+	size_t candidateCount = m_evictionIndices.GetSize();
+	if ( candidateCount == 0 )
+	{
+		return;
+	}
+
+	SortJob< size_t, EvictionCompare > sortJob;
+	SortJob< size_t, EvictionCompare >::Parameters& rParameters = sortJob.GetParameters();
+	rParameters.pBase = m_evictionIndices.GetData();
+	rParameters.count = candidateCount;
+	rParameters.compare = EvictionCompare( &m_entries, m_frameIndex );
+	rParameters.singleJobCount = 100;
+	sortJob.Run();
+
+	size_t evictCount = Min( m_entryMap.GetSize() - m_entryCountMax, candidateCount );
+	for ( size_t evictIndex = 0; evictIndex < evictCount; ++evictIndex )
+	{
+		size_t entryIndex = m_evictionIndices[evictIndex];
+
+		HELIUM_VERIFY( m_entryMap.Remove( m_entries[entryIndex].path ) );
+		m_entries.Remove( entryIndex );
+	}
+}
+
+/// Load the usage recorded during previous sessions and build the warm-up list from it.
+void ShaderVariantCache::LoadUsage()
+{
+	FilePath usageFilePath;
+	if ( !GetUsageFilePath( usageFilePath ) || !usageFilePath.Exists() )
+	{
+		return;
+	}
+
+	Reflect::ObjectPtr spObject = Persist::ArchiveReader::ReadFromFile( usageFilePath );
+	ShaderVariantUsageList* pUsageList = Reflect::SafeCast< ShaderVariantUsageList >( spObject.Get() );
+	if ( !pUsageList )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			"ShaderVariantCache: Shader variant usage list \"%s\" failed to load.  No variants will be warmed up.\n",
+			usageFilePath.Get().c_str() );
+
+		return;
+	}
+
+	const DynamicArray< ShaderVariantUsage >& rUsage = pUsageList->m_usage;
+	size_t usageCount = Min( rUsage.GetSize(), m_entryCountMax );
+
+	m_usage.Reserve( usageCount );
+	m_warmUpList.Reserve( usageCount );
+
+	// The saved list is sorted from most to least used, so fill the warm-up list in reverse order to pop the most used
+	// variants first.  Counts carried over from earlier sessions are halved so the list follows recent usage.
+	size_t usageIndex = usageCount;
+	while ( usageIndex != 0 )
+	{
+		--usageIndex;
+
+		const ShaderVariantUsage& rRecord = rUsage[usageIndex];
+		if ( rRecord.shaderType >= static_cast< uint32_t >( RShader::TYPE_MAX ) || rRecord.useCount == 0 )
+		{
+			continue;
+		}
+
+		AssetPath shaderPath;
+		if ( !shaderPath.Set( *rRecord.shaderPath ) )
+		{
+			continue;
+		}
+
+		AssetPath variantPath = Shader::GetVariantPath(
+			shaderPath,
+			static_cast< RShader::EType >( rRecord.shaderType ),
+			rRecord.userOptionIndex );
+
+		HashMap< AssetPath, size_t >::Iterator usageIterator = m_usageMap.Find( variantPath );
+		if ( usageIterator != m_usageMap.End() )
+		{
+			continue;
+		}
+
+		m_warmUpList.Push( rRecord );
+
+		m_usage.Push( rRecord );
+		m_usage.GetLast().useCount = ( rRecord.useCount + 1 ) / 2;
+
+		HELIUM_VERIFY( m_usageMap.Insert(
+			usageIterator,
+			HashMap< AssetPath, size_t >::ValueType( variantPath, m_usage.GetSize() - 1 ) ) );
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		"ShaderVariantCache: Queued %" PRIuSZ " shader variants for warm-up.\n",
+		m_warmUpList.GetSize() );
+}
+
+/// Get the path of the file in which recorded shader variant usage is stored.
+///
+/// @param[out] rPath  Usage file path.
+///
+/// @return  True if the path was determined successfully, false if no user data directory is available.
+bool ShaderVariantCache::GetUsageFilePath( FilePath& rPath )
+{
+	FilePath userDirectory;
+	if ( !FileLocations::GetUserDirectory( userDirectory ) )
+	{
+		return false;
+	}
+
+	String usageFilePath( userDirectory.Data() );
+	usageFilePath += "ShaderVariantUsage.json";
+	rPath = FilePath( *usageFilePath );
+
+	return true;
+}
+
+/// Constructor.
+ShaderVariantCache::EvictionCompare::EvictionCompare()
+	: m_pEntries( NULL )
+	, m_frameIndex( 0 )
+{
+}
+
+/// Constructor.
+///
+/// @param[in] pEntries    Cache entries.
+/// @param[in] frameIndex  Current frame index.
+ShaderVariantCache::EvictionCompare::EvictionCompare( const SparseArray< Entry >* pEntries, uint32_t frameIndex )
+	: m_pEntries( pEntries )
+	, m_frameIndex( frameIndex )
+{
+	HELIUM_ASSERT( pEntries );
+}
+
+/// Compare two cache entries for eviction.
+///
+/// @param[in] entryIndex0  Index of the first entry.
+/// @param[in] entryIndex1  Index of the second entry.
+///
+/// @return  True if the first entry should be evicted before the second, false if not.
+bool ShaderVariantCache::EvictionCompare::operator()( size_t entryIndex0, size_t entryIndex1 ) const
+{
+	HELIUM_ASSERT( m_pEntries );
+
+	uint32_t age0 = m_frameIndex - m_pEntries->GetElement( entryIndex0 ).lastUseFrame;
+	uint32_t age1 = m_frameIndex - m_pEntries->GetElement( entryIndex1 ).lastUseFrame;
+	if ( age0 != age1 )
+	{
+		return ( age0 > age1 );
+	}
+
+	return ( entryIndex0 < entryIndex1 );
+}
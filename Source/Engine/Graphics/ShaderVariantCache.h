@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/SparseArray.h"
+#include "Engine/AssetPath.h"
+#include "Graphics/Shader.h"
+
+namespace Helium
+{
+	class Material;
+
+	/// Recorded use of a shader variant, saved between sessions to build the shader variant warm-up list.
+	struct HELIUM_GRAPHICS_API ShaderVariantUsage : Reflect::Struct
+	{
+		HELIUM_DECLARE_BASE_STRUCT( Helium::ShaderVariantUsage );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		inline bool operator==( const ShaderVariantUsage& _rhs ) const;
+		inline bool operator!=( const ShaderVariantUsage& _rhs ) const;
+
+		/// Path of the shader owning the variant.
+		Name shaderPath;
+		/// Shader type.
+		uint32_t shaderType;
+		/// Index associated with the user option combination for the variant.
+		uint32_t userOptionIndex;
+		/// Number of frames in which the variant was used.
+		uint32_t useCount;
+	};
+
+	/// Persistent list of recorded shader variant usage.
+	class HELIUM_GRAPHICS_API ShaderVariantUsageList : public Reflect::Object
+	{
+	public:
+		HELIUM_DECLARE_CLASS( ShaderVariantUsageList, Reflect::Object );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		/// Variant usage records, sorted from most to least used.
+		DynamicArray< ShaderVariantUsage > m_usage;
+	};
+
+	/// Cache of loaded shader variants.
+	///
+	/// Rather than having every material load its shader variants up front, materials acquire an entry in this cache
+	/// the first time a variant is needed for rendering (see Acquire()).  Acquisition happens on the game thread while
+	/// capturing a scene for rendering (see Material::ResolveShaderVariants()), never from draw code.  Variants are
+	/// loaded asynchronously in batches during Update(), and GetVariant() returns null until loading has completed, so
+	/// the first frames using a material may skip drawing it.  Materials that have not been drawn for
+	/// MATERIAL_IDLE_FRAME_COUNT frames release their entries again.  Entries no longer acquired by any material are
+	/// kept around until the cache exceeds its configured size, at which point the least recently used variants are
+	/// released.
+	///
+	/// Variant usage is recorded across the session and saved to the user data directory on shutdown.  On the next
+	/// startup, the most used variants are loaded in the background whenever no variants are needed for rendering, so
+	/// they are typically already resident by the time they are first requested.
+	class HELIUM_GRAPHICS_API ShaderVariantCache : NonCopyable
+	{
+	public:
+		/// Maximum number of variant loads that can be in progress at once.
+		static const size_t LOAD_COUNT_MAX = 16;
+		/// Maximum number of shaders that can be loading at once for warming up variants.
+		static const size_t WARM_UP_SHADER_LOAD_COUNT_MAX = 4;
+		/// Number of frames a material can go without resolving its variants before its entries are released.
+		static const uint32_t MATERIAL_IDLE_FRAME_COUNT = 120;
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Variant Access
+		//@{
+		size_t Acquire( Shader* pShader, RShader::EType shaderType, uint32_t userOptionIndex );
+		void Release( size_t entryIndex );
+		ShaderVariant* GetVariant( size_t entryIndex );
+
+		void Prefetch( Shader* pShader, RShader::EType shaderType, uint32_t userOptionIndex );
+		//@}
+
+		/// @name Material Tracking
+		//@{
+		size_t AddMaterial( Material* pMaterial );
+		void RemoveMaterial( size_t materialIndex );
+		//@}
+
+		/// @name Updating
+		//@{
+		void Update();
+
+		inline uint32_t GetFrameIndex() const;
+		inline size_t GetEntryCount() const;
+		inline size_t GetLoadingCount() const;
+		inline size_t GetEntryCountMax() const;
+		//@}
+
+		/// @name Usage Recording
+		//@{
+		bool SaveUsage() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static ShaderVariantCache* GetInstance();
+		static void Startup();
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Cache entry state.
+		enum EEntryState
+		{
+			/// Waiting for a load slot.
+			ENTRY_STATE_QUEUED,
+			/// Variant load in progress.
+			ENTRY_STATE_LOADING,
+			/// Variant load completed (the variant may be null if it failed to load).
+			ENTRY_STATE_LOADED
+		};
+
+		/// Shader variant cache entry.
+		struct Entry
+		{
+			/// Variant asset path.
+			AssetPath path;
+			/// Shader owning the variant.
+			ShaderPtr spShader;
+			/// Loaded variant.
+			ShaderVariantPtr spVariant;
+			/// Variant load ID.
+			size_t loadId;
+			/// Index of the usage record for the variant.
+			size_t usageIndex;
+			/// Index of the frame in which the variant was last used.
+			uint32_t lastUseFrame;
+			/// Number of times the entry has been acquired and not released.
+			uint32_t referenceCount;
+			/// User option index.
+			uint32_t userOptionIndex;
+			/// Shader type.
+			RShader::EType shaderType;
+			/// Current state.
+			EEntryState state;
+		};
+
+		/// Pending shader load for warming up a variant.
+		struct WarmUpRequest
+		{
+			/// Shader path.
+			AssetPath shaderPath;
+			/// Shader load ID.
+			size_t loadId;
+			/// User option index.
+			uint32_t userOptionIndex;
+			/// Shader type.
+			RShader::EType shaderType;
+		};
+
+		/// Cache eviction comparison (sorts least recently used entries first).
+		class EvictionCompare
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			EvictionCompare();
+			EvictionCompare( const SparseArray< Entry >* pEntries, uint32_t frameIndex );
+			//@}
+
+			/// @name Overloaded Operators
+			//@{
+			bool operator()( size_t entryIndex0, size_t entryIndex1 ) const;
+			//@}
+
+		private:
+			/// Cache entries.
+			const SparseArray< Entry >* m_pEntries;
+			/// Current frame index.
+			uint32_t m_frameIndex;
+		};
+
+		/// Cache entries.
+		SparseArray< Entry > m_entries;
+		/// Cache entry indices by variant path.
+		HashMap< AssetPath, size_t > m_entryMap;
+
+		/// Entries needed for rendering that are waiting to be loaded.
+		DynamicArray< size_t > m_demandQueue;
+		/// Entries prefetched for warming up that are waiting to be loaded.
+		DynamicArray< size_t > m_prefetchQueue;
+		/// Entries currently loading.
+		DynamicArray< size_t > m_loadingEntries;
+
+		/// Recorded variant usage.
+		DynamicArray< ShaderVariantUsage > m_usage;
+		/// Usage record indices by variant path.
+		HashMap< AssetPath, size_t > m_usageMap;
+
+		/// Variants remaining to be warmed up, most used last.
+		DynamicArray< ShaderVariantUsage > m_warmUpList;
+		/// Shader loads in progress for warming up variants.
+		DynamicArray< WarmUpRequest > m_warmUpRequests;
+
+		/// Materials holding acquired entries, checked for idle materials during Update().
+		SparseArray< Material* > m_materials;
+
+		/// Entry indices sorted for eviction (scratch buffer for Update()).
+		DynamicArray< size_t > m_evictionIndices;
+
+		/// Maximum number of entries to keep in the cache.
+		size_t m_entryCountMax;
+		/// Current frame index.
+		uint32_t m_frameIndex;
+
+		/// Singleton instance.
+		static ShaderVariantCache* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		ShaderVariantCache();
+		~ShaderVariantCache();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		size_t FindOrAddEntry( Shader* pShader, RShader::EType shaderType, uint32_t userOptionIndex, bool bDemand );
+		size_t FindOrAddUsage( const Entry& rEntry );
+		void BeginLoads( DynamicArray< size_t >& rQueue );
+		void UpdateWarmUp();
+		void ReleaseIdleMaterials();
+		void Evict();
+
+		void LoadUsage();
+		static bool GetUsageFilePath( FilePath& rPath );
+		//@}
+	};
+}
+
+#include "Graphics/ShaderVariantCache.inl"
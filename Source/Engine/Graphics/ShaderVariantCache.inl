@@ -0,0 +1,53 @@
+namespace Helium
+{
+	bool ShaderVariantUsage::operator==( const ShaderVariantUsage& _rhs ) const
+	{
+		return (
+			shaderPath == _rhs.shaderPath &&
+			shaderType == _rhs.shaderType &&
+			userOptionIndex == _rhs.userOptionIndex &&
+			useCount == _rhs.useCount
+			);
+	}
+
+	bool ShaderVariantUsage::operator!=( const ShaderVariantUsage& _rhs ) const
+	{
+		return !( *this == _rhs );
+	}
+
+	/// Get the index of the current cache frame.  Variant use is tracked per frame.
+	///
+	/// @return  Current frame index.
+	uint32_t ShaderVariantCache::GetFrameIndex() const
+	{
+		return m_frameIndex;
+	}
+
+	/// Get the number of entries in the cache, including variants still waiting to load.
+	///
+	/// @return  Cache entry count.
+	///
+	/// @see GetEntryCountMax()
+	size_t ShaderVariantCache::GetEntryCount() const
+	{
+		return m_entryMap.GetSize();
+	}
+
+	/// Get the number of variant loads currently in progress.
+	///
+	/// @return  Number of loading variants.
+	size_t ShaderVariantCache::GetLoadingCount() const
+	{
+		return m_loadingEntries.GetSize();
+	}
+
+	/// Get the number of entries above which the least recently used variants are released.
+	///
+	/// @return  Maximum cache entry count.
+	///
+	/// @see GetEntryCount()
+	size_t ShaderVariantCache::GetEntryCountMax() const
+	{
+		return m_entryCountMax;
+	}
+}
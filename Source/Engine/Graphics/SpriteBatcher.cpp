@@ -0,0 +1,522 @@
+#include "Precompile.h"
+#include "Graphics/SpriteBatcher.h"
+
+#include "Rendering/Renderer.h"
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RPixelShader.h"
+#include "Rendering/RRenderCommandProxy.h"
+#include "Rendering/RTexture2d.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexShader.h"
+#include "Graphics/RenderResourceManager.h"
+#include "Graphics/Shader.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+/// Number of vertices used for each sprite quad.
+static const uint32_t SPRITE_VERTEX_COUNT = 4;
+/// Number of indices used for each sprite quad.
+static const uint32_t SPRITE_INDEX_COUNT = 6;
+
+/// Constructor.
+SpriteBatcher::SpriteBatcher()
+	: m_vertexBufferIndex( 0 )
+	, m_indexBufferCapacity( 0 )
+{
+	for( size_t bufferIndex = 0; bufferIndex < HELIUM_ARRAY_COUNT( m_vertexBufferCapacities ); ++bufferIndex )
+	{
+		m_vertexBufferCapacities[ bufferIndex ] = 0;
+	}
+
+	for( size_t frameIndex = 0; frameIndex < FRAME_COUNT; ++frameIndex )
+	{
+		m_frames[ frameIndex ].pVertexBuffer = NULL;
+	}
+}
+
+/// Destructor.
+SpriteBatcher::~SpriteBatcher()
+{
+	Shutdown();
+}
+
+/// Release all sprite data and rendering resources.
+void SpriteBatcher::Shutdown()
+{
+	m_sprites.Clear();
+	m_sortEntries.Clear();
+
+	for( size_t frameIndex = 0; frameIndex < FRAME_COUNT; ++frameIndex )
+	{
+		Frame& rFrame = m_frames[ frameIndex ];
+		rFrame.vertices.Clear();
+		rFrame.batches.Clear();
+		rFrame.pVertexBuffer = NULL;
+	}
+
+	for( size_t bufferIndex = 0; bufferIndex < HELIUM_ARRAY_COUNT( m_spVertexBuffers ); ++bufferIndex )
+	{
+		m_spVertexBuffers[ bufferIndex ].Release();
+		m_vertexBufferCapacities[ bufferIndex ] = 0;
+	}
+
+	m_vertexBufferIndex = 0;
+
+	m_spIndexBuffer.Release();
+	m_indexBufferCapacity = 0;
+
+	m_spPixelConstantBuffer.Release();
+}
+
+/// Add a sprite to draw with the next captured frame.
+///
+/// The sprite is a unit quad in the xy-plane, centered on the origin of its local space.
+///
+/// @param[in] pTexture        Sprite texture (or texture atlas).
+/// @param[in] rTransform      World transform of the unit sprite quad.
+/// @param[in] rUvTopLeft      Texture coordinates at the top-left corner of the sprite.
+/// @param[in] rUvBottomRight  Texture coordinates at the bottom-right corner of the sprite.
+/// @param[in] layer           Sort layer.  Sprites in lower layers are drawn before sprites in higher layers.
+/// @param[in] color           Color with which to blend the sprite.
+///
+/// @see Capture(), GetAtlasUvCoordinates()
+void SpriteBatcher::DrawSprite(
+	RTexture2d* pTexture,
+	const Simd::Matrix44& rTransform,
+	const Simd::Vector2& rUvTopLeft,
+	const Simd::Vector2& rUvBottomRight,
+	int32_t layer,
+	Color color )
+{
+	HELIUM_ASSERT( pTexture );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	uint32_t spriteIndex = static_cast< uint32_t >( m_sprites.GetSize() );
+
+	Sprite* pSprite = m_sprites.New();
+	HELIUM_ASSERT( pSprite );
+	pSprite->transform = rTransform;
+	pSprite->spTexture = pTexture;
+	pSprite->uvTopLeft[ 0 ] = rUvTopLeft.GetX();
+	pSprite->uvTopLeft[ 1 ] = rUvTopLeft.GetY();
+	pSprite->uvBottomRight[ 0 ] = rUvBottomRight.GetX();
+	pSprite->uvBottomRight[ 1 ] = rUvBottomRight.GetY();
+	pSprite->layer = layer;
+	pSprite->color = color;
+
+	SortEntry* pSortEntry = m_sortEntries.New();
+	HELIUM_ASSERT( pSortEntry );
+	pSortEntry->layer = layer;
+	pSortEntry->pTexture = pTexture;
+	pSortEntry->spriteIndex = spriteIndex;
+}
+
+/// Sort all sprites added since the last capture, expand them into the vertex data for the given frame, and record one
+/// batch for each run of sprites sharing the same layer and texture.
+///
+/// This should be called once per frame on the game thread, while the given frame is not being rendered.  The sprite
+/// list is emptied for the next frame.
+///
+/// @param[in] frameIndex  Index of the frame into which to capture the sprites (less than FRAME_COUNT).
+///
+/// @see Upload(), Draw()
+void SpriteBatcher::Capture( size_t frameIndex )
+{
+	HELIUM_ASSERT( frameIndex < FRAME_COUNT );
+
+	Frame& rFrame = m_frames[ frameIndex ];
+	rFrame.vertices.Resize( 0 );
+	rFrame.batches.Resize( 0 );
+	rFrame.pVertexBuffer = NULL;
+
+	uint32_t spriteCount = static_cast< uint32_t >( m_sprites.GetSize() );
+	if( spriteCount == 0 )
+	{
+		return;
+	}
+
+	HELIUM_ASSERT( m_sortEntries.GetSize() == spriteCount );
+	std::sort( m_sortEntries.GetData(), m_sortEntries.GetData() + spriteCount, SortEntryLess );
+
+	rFrame.vertices.Reserve( spriteCount * SPRITE_VERTEX_COUNT );
+	rFrame.vertices.Resize( spriteCount * SPRITE_VERTEX_COUNT );
+	SimpleTexturedVertex* pVertices = rFrame.vertices.GetData();
+
+	Simd::Vector3 corners[ SPRITE_VERTEX_COUNT ];
+
+	uint32_t runStartIndex = 0;
+	for( uint32_t sortIndex = 0; sortIndex < spriteCount; ++sortIndex )
+	{
+		const SortEntry& rSortEntry = m_sortEntries[ sortIndex ];
+		const Sprite& rSprite = m_sprites[ rSortEntry.spriteIndex ];
+
+		// Corner order matches the quad vertex buffer used by BufferedDrawContext::DrawTexturedQuad().
+		rSprite.transform.TransformPoint( Simd::Vector3( -0.5f, 0.5f, 1.0f ), corners[ 0 ] );
+		rSprite.transform.TransformPoint( Simd::Vector3( 0.5f, 0.5f, 1.0f ), corners[ 1 ] );
+		rSprite.transform.TransformPoint( Simd::Vector3( -0.5f, -0.5f, 1.0f ), corners[ 2 ] );
+		rSprite.transform.TransformPoint( Simd::Vector3( 0.5f, -0.5f, 1.0f ), corners[ 3 ] );
+
+		float32_t uvMinX = rSprite.uvTopLeft[ 0 ];
+		float32_t uvMinY = rSprite.uvTopLeft[ 1 ];
+		float32_t uvMaxX = rSprite.uvBottomRight[ 0 ];
+		float32_t uvMaxY = rSprite.uvBottomRight[ 1 ];
+
+		pVertices[ 0 ] = SimpleTexturedVertex( corners[ 0 ], Simd::Vector2( uvMinX, uvMaxY ), rSprite.color );
+		pVertices[ 1 ] = SimpleTexturedVertex( corners[ 1 ], Simd::Vector2( uvMaxX, uvMaxY ), rSprite.color );
+		pVertices[ 2 ] = SimpleTexturedVertex( corners[ 2 ], Simd::Vector2( uvMinX, uvMinY ), rSprite.color );
+		pVertices[ 3 ] = SimpleTexturedVertex( corners[ 3 ], Simd::Vector2( uvMaxX, uvMinY ), rSprite.color );
+		pVertices += SPRITE_VERTEX_COUNT;
+
+		// Record a batch once the end of a run of sprites sharing the same layer and texture has been reached.
+		uint32_t nextSortIndex = sortIndex + 1;
+		if( nextSortIndex < spriteCount )
+		{
+			const SortEntry& rNextSortEntry = m_sortEntries[ nextSortIndex ];
+			if( rNextSortEntry.layer == rSortEntry.layer && rNextSortEntry.pTexture == rSortEntry.pTexture )
+			{
+				continue;
+			}
+		}
+
+		Batch* pBatch = rFrame.batches.New();
+		HELIUM_ASSERT( pBatch );
+		pBatch->spTexture = rSprite.spTexture;
+		pBatch->startSprite = runStartIndex;
+		pBatch->spriteCount = nextSortIndex - runStartIndex;
+
+		runStartIndex = nextSortIndex;
+	}
+
+	m_sprites.RemoveAll();
+	m_sortEntries.RemoveAll();
+}
+
+/// Copy the vertices captured for the given frame into the next sprite vertex buffer.
+///
+/// This should be called once per frame on the rendering thread, before Draw() is called for any scene view.
+///
+/// @param[in] frameIndex  Index of the captured frame to upload (less than FRAME_COUNT).
+///
+/// @see Capture(), Draw()
+void SpriteBatcher::Upload( size_t frameIndex )
+{
+	HELIUM_ASSERT( frameIndex < FRAME_COUNT );
+
+	Frame& rFrame = m_frames[ frameIndex ];
+	rFrame.pVertexBuffer = NULL;
+
+	uint32_t spriteCount = static_cast< uint32_t >( rFrame.vertices.GetSize() / SPRITE_VERTEX_COUNT );
+	if( spriteCount == 0 || !ReserveBuffers( spriteCount ) )
+	{
+		return;
+	}
+
+	RVertexBuffer* pVertexBuffer = m_spVertexBuffers[ m_vertexBufferIndex ];
+	HELIUM_ASSERT( pVertexBuffer );
+
+	void* pMappedVertices = pVertexBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD );
+	HELIUM_ASSERT( pMappedVertices );
+	MemoryCopy( pMappedVertices, rFrame.vertices.GetData(), rFrame.vertices.GetSize() * sizeof( SimpleTexturedVertex ) );
+	pVertexBuffer->Unmap();
+
+	rFrame.pVertexBuffer = pVertexBuffer;
+
+	m_vertexBufferIndex = ( m_vertexBufferIndex + 1 ) % HELIUM_ARRAY_COUNT( m_spVertexBuffers );
+}
+
+/// Draw the sprites of the given frame, one draw call per batch.
+///
+/// This must be called after Upload() for the same frame, within a BeginScene()/EndScene() pair.  Vertex constant
+/// buffer 0 is expected to hold the view's global constant data, starting with the transposed inverse view/projection
+/// matrix, as sprite vertices are already in world space.  Blend, rasterizer, and depth-stencil states are changed
+/// without being restored.
+///
+/// @param[in] pCommandProxy  Command proxy through which to issue the draw calls.
+/// @param[in] frameIndex     Index of the captured frame to draw (less than FRAME_COUNT).
+///
+/// @see Capture(), Upload()
+void SpriteBatcher::Draw( RRenderCommandProxy* pCommandProxy, size_t frameIndex )
+{
+	HELIUM_ASSERT( pCommandProxy );
+	HELIUM_ASSERT( frameIndex < FRAME_COUNT );
+
+	const Frame& rFrame = m_frames[ frameIndex ];
+	RVertexBuffer* pVertexBuffer = rFrame.pVertexBuffer;
+	size_t batchCount = rFrame.batches.GetSize();
+	if( !pVertexBuffer || batchCount == 0 )
+	{
+		return;
+	}
+
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
+	HELIUM_ASSERT( pRenderResourceManager );
+
+	// Get the texture-blended variants of the simple world-space shaders.
+	ShaderVariant* pVertexShaderVariant = pRenderResourceManager->GetSimpleWorldSpaceVertexShader();
+	ShaderVariant* pPixelShaderVariant = pRenderResourceManager->GetSimpleWorldSpacePixelShader();
+	if( !pVertexShaderVariant || !pPixelShaderVariant )
+	{
+		return;
+	}
+
+	Shader* pShader = Reflect::AssertCast< Shader >( pVertexShaderVariant->GetOwner() );
+	HELIUM_ASSERT( pShader );
+
+	const Shader::Options& rSystemOptions = pShader->GetSystemOptions();
+
+	static const Shader::SelectPair textureBlendSelectOptions[] =
+	{
+		Shader::SelectPair( Name( "TEXTURING" ), Name( "TEXTURING_BLEND" ) ),
+	};
+
+	size_t optionSetIndex = rSystemOptions.GetOptionSetIndex(
+		RShader::TYPE_VERTEX,
+		NULL,
+		0,
+		textureBlendSelectOptions,
+		HELIUM_ARRAY_COUNT( textureBlendSelectOptions ) );
+	RShader* pShaderResource = pVertexShaderVariant->GetRenderResource( optionSetIndex );
+	HELIUM_ASSERT( !pShaderResource || pShaderResource->GetType() == RShader::TYPE_VERTEX );
+	RVertexShader* pVertexShader = static_cast< RVertexShader* >( pShaderResource );
+
+	optionSetIndex = rSystemOptions.GetOptionSetIndex(
+		RShader::TYPE_PIXEL,
+		NULL,
+		0,
+		textureBlendSelectOptions,
+		HELIUM_ARRAY_COUNT( textureBlendSelectOptions ) );
+	pShaderResource = pPixelShaderVariant->GetRenderResource( optionSetIndex );
+	HELIUM_ASSERT( !pShaderResource || pShaderResource->GetType() == RShader::TYPE_PIXEL );
+	RPixelShader* pPixelShader = static_cast< RPixelShader* >( pShaderResource );
+
+	if( !pVertexShader || !pPixelShader )
+	{
+		return;
+	}
+
+	// Sprite colors are stored in the vertices, so the shader blend color is always white.
+	if( !m_spPixelConstantBuffer )
+	{
+		static const float32_t whiteBlendColor[ 4 ] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		m_spPixelConstantBuffer = pRenderer->CreateConstantBuffer(
+			sizeof( whiteBlendColor ),
+			RENDERER_BUFFER_USAGE_STATIC,
+			whiteBlendColor );
+		if( !m_spPixelConstantBuffer )
+		{
+			return;
+		}
+	}
+
+	RVertexDescription* pVertexDescription = pRenderResourceManager->GetSimpleTexturedVertexDescription();
+	HELIUM_ASSERT( pVertexDescription );
+	pVertexShader->CacheDescription( pRenderer, pVertexDescription );
+	RVertexInputLayout* pVertexInputLayout = pVertexShader->GetCachedInputLayout();
+	HELIUM_ASSERT( pVertexInputLayout );
+
+	pCommandProxy->SetRasterizerState(
+		pRenderResourceManager->GetRasterizerState( RenderResourceManager::RASTERIZER_STATE_DOUBLE_SIDED ) );
+	pCommandProxy->SetBlendState(
+		pRenderResourceManager->GetBlendState( RenderResourceManager::BLEND_STATE_TRANSPARENT ) );
+	pCommandProxy->SetDepthStencilState(
+		pRenderResourceManager->GetDepthStencilState( RenderResourceManager::DEPTH_STENCIL_STATE_TEST_ONLY ),
+		0 );
+
+	pCommandProxy->SetVertexShader( pVertexShader );
+	pCommandProxy->SetPixelShader( pPixelShader );
+	pCommandProxy->SetVertexInputLayout( pVertexInputLayout );
+	pCommandProxy->SetPixelConstantBuffers( 0, 1, &m_spPixelConstantBuffer );
+
+	uint32_t stride = static_cast< uint32_t >( sizeof( SimpleTexturedVertex ) );
+	uint32_t offset = 0;
+	pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &stride, &offset );
+	pCommandProxy->SetIndexBuffer( m_spIndexBuffer );
+
+	for( size_t batchIndex = 0; batchIndex < batchCount; ++batchIndex )
+	{
+		const Batch& rBatch = rFrame.batches[ batchIndex ];
+
+		pCommandProxy->SetTexture( 0, rBatch.spTexture );
+		pCommandProxy->DrawIndexed(
+			RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST,
+			rBatch.startSprite * SPRITE_VERTEX_COUNT,
+			0,
+			rBatch.spriteCount * SPRITE_VERTEX_COUNT,
+			0,
+			rBatch.spriteCount * 2 );
+	}
+
+	// Unset resources.
+	RVertexBuffer* pNullVertexBuffer = NULL;
+	stride = 0;
+	pCommandProxy->SetVertexBuffers( 0, 1, &pNullVertexBuffer, &stride, &offset );
+	pCommandProxy->SetIndexBuffer( NULL );
+	pCommandProxy->SetVertexShader( NULL );
+	pCommandProxy->SetPixelShader( NULL );
+	pCommandProxy->SetVertexInputLayout( NULL );
+
+	RConstantBuffer* pNullConstantBuffer = NULL;
+	pCommandProxy->SetPixelConstantBuffers( 0, 1, &pNullConstantBuffer );
+	pCommandProxy->SetTexture( 0, NULL );
+}
+
+/// Compute the texture coordinates for a sub-rectangle of a texture atlas.
+///
+/// The texture coordinates are inset by half a texel on each side so that filtering does not pull in texels from
+/// neighboring atlas entries.
+///
+/// @param[in]  textureWidth    Atlas texture width, in pixels.
+/// @param[in]  textureHeight   Atlas texture height, in pixels.
+/// @param[in]  pixelX          Horizontal pixel coordinate of the left edge of the sub-rectangle.
+/// @param[in]  pixelY          Vertical pixel coordinate of the top edge of the sub-rectangle.
+/// @param[in]  pixelWidth      Sub-rectangle width, in pixels.
+/// @param[in]  pixelHeight     Sub-rectangle height, in pixels.
+/// @param[out] rUvTopLeft      Texture coordinates at the top-left corner of the sub-rectangle.
+/// @param[out] rUvBottomRight  Texture coordinates at the bottom-right corner of the sub-rectangle.
+void SpriteBatcher::GetAtlasUvCoordinates(
+	uint32_t textureWidth,
+	uint32_t textureHeight,
+	int32_t pixelX,
+	int32_t pixelY,
+	int32_t pixelWidth,
+	int32_t pixelHeight,
+	Simd::Vector2& rUvTopLeft,
+	Simd::Vector2& rUvBottomRight )
+{
+	if( textureWidth == 0 || textureHeight == 0 || pixelWidth <= 0 || pixelHeight <= 0 )
+	{
+		rUvTopLeft = Simd::Vector2( 0.0f, 0.0f );
+		rUvBottomRight = Simd::Vector2( 1.0f, 1.0f );
+
+		return;
+	}
+
+	float32_t inverseWidth = 1.0f / static_cast< float32_t >( textureWidth );
+	float32_t inverseHeight = 1.0f / static_cast< float32_t >( textureHeight );
+
+	float32_t insetX = Min( 0.5f, static_cast< float32_t >( pixelWidth ) * 0.5f );
+	float32_t insetY = Min( 0.5f, static_cast< float32_t >( pixelHeight ) * 0.5f );
+
+	rUvTopLeft = Simd::Vector2(
+		( static_cast< float32_t >( pixelX ) + insetX ) * inverseWidth,
+		( static_cast< float32_t >( pixelY ) + insetY ) * inverseHeight );
+	rUvBottomRight = Simd::Vector2(
+		( static_cast< float32_t >( pixelX + pixelWidth ) - insetX ) * inverseWidth,
+		( static_cast< float32_t >( pixelY + pixelHeight ) - insetY ) * inverseHeight );
+}
+
+/// Make sure the current vertex buffer and the quad index buffer can hold the given number of sprites.
+///
+/// @param[in] spriteCount  Number of sprites to draw.
+///
+/// @return  True if the buffers are large enough, false if they could not be created.
+bool SpriteBatcher::ReserveBuffers( uint32_t spriteCount )
+{
+	Renderer* pRenderer = Renderer::GetInstance();
+	if( !pRenderer )
+	{
+		return false;
+	}
+
+	// Grow by at least half the current capacity to keep reallocations rare as the sprite count climbs.
+	uint32_t& rVertexBufferCapacity = m_vertexBufferCapacities[ m_vertexBufferIndex ];
+	if( spriteCount > rVertexBufferCapacity )
+	{
+		uint32_t capacity = Max( Max( spriteCount, rVertexBufferCapacity + rVertexBufferCapacity / 2 ), SPRITE_CAPACITY_MIN );
+
+		RVertexBufferPtr& rspVertexBuffer = m_spVertexBuffers[ m_vertexBufferIndex ];
+		rspVertexBuffer.Release();
+		rspVertexBuffer = pRenderer->CreateVertexBuffer(
+			capacity * SPRITE_VERTEX_COUNT * sizeof( SimpleTexturedVertex ),
+			RENDERER_BUFFER_USAGE_DYNAMIC );
+		if( !rspVertexBuffer )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				"SpriteBatcher::ReserveBuffers(): Failed to create vertex buffer for %" PRIu32 " sprites.\n",
+				capacity );
+
+			rVertexBufferCapacity = 0;
+
+			return false;
+		}
+
+		rVertexBufferCapacity = capacity;
+	}
+
+	if( spriteCount > m_indexBufferCapacity )
+	{
+		uint32_t capacity = Max( Max( spriteCount, m_indexBufferCapacity + m_indexBufferCapacity / 2 ), SPRITE_CAPACITY_MIN );
+
+		DynamicArray< uint32_t > indices;
+		indices.Reserve( capacity * SPRITE_INDEX_COUNT );
+		for( uint32_t spriteIndex = 0; spriteIndex < capacity; ++spriteIndex )
+		{
+			uint32_t baseIndex = spriteIndex * SPRITE_VERTEX_COUNT;
+			indices.Push( baseIndex );
+			indices.Push( baseIndex + 1 );
+			indices.Push( baseIndex + 2 );
+			indices.Push( baseIndex + 2 );
+			indices.Push( baseIndex + 1 );
+			indices.Push( baseIndex + 3 );
+		}
+
+		m_spIndexBuffer.Release();
+		m_spIndexBuffer = pRenderer->CreateIndexBuffer(
+			capacity * SPRITE_INDEX_COUNT * sizeof( uint32_t ),
+			RENDERER_BUFFER_USAGE_STATIC,
+			RENDERER_INDEX_FORMAT_UINT32,
+			indices.GetData() );
+		if( !m_spIndexBuffer )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				"SpriteBatcher::ReserveBuffers(): Failed to create index buffer for %" PRIu32 " sprites.\n",
+				capacity );
+
+			m_indexBufferCapacity = 0;
+
+			return false;
+		}
+
+		m_indexBufferCapacity = capacity;
+	}
+
+	return true;
+}
+
+/// Sort comparison function for sprite sort entries.
+///
+/// Sprites are ordered by layer first so that layers are drawn back to front, then by texture so that each texture is
+/// drawn once per layer, and finally by submission order to keep the results stable between frames.
+///
+/// @param[in] rEntry0  First sort entry.
+/// @param[in] rEntry1  Second sort entry.
+///
+/// @return  True if the first entry should be drawn before the second, false if not.
+bool SpriteBatcher::SortEntryLess( const SortEntry& rEntry0, const SortEntry& rEntry1 )
+{
+	if( rEntry0.layer != rEntry1.layer )
+	{
+		return ( rEntry0.layer < rEntry1.layer );
+	}
+
+	if( rEntry0.pTexture != rEntry1.pTexture )
+	{
+		return ( rEntry0.pTexture < rEntry1.pTexture );
+	}
+
+	return ( rEntry0.spriteIndex < rEntry1.spriteIndex );
+}
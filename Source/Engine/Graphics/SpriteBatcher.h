@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/Matrix44.h"
+#include "Rendering/RRenderResource.h"
+#include "GraphicsTypes/VertexTypes.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( RConstantBuffer );
+	HELIUM_DECLARE_RPTR( RIndexBuffer );
+	HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+	HELIUM_DECLARE_RPTR( RTexture2d );
+	HELIUM_DECLARE_RPTR( RVertexBuffer );
+
+	/// Batched renderer for textured 2D sprites.
+	///
+	/// Sprites are gathered each frame into a persistent instance list on the game thread.  When captured, the list is
+	/// sorted by layer and texture, the sprite quads are expanded into the vertex array for one of two frames, and a
+	/// batch is recorded for each run of sprites sharing a layer and texture.  The render thread then copies a captured
+	/// frame's vertices into a persistent dynamic vertex buffer and issues one draw call per batch.  Quad indices come
+	/// from a static index buffer that only changes when the sprite capacity grows.
+	///
+	/// GPU resources are only created and mapped from Upload() and Draw(), so they are only touched by the thread doing
+	/// the rendering.
+	class HELIUM_GRAPHICS_API SpriteBatcher : NonCopyable
+	{
+	public:
+		/// Number of captured frames that can be held at once (one being rendered, one being captured).
+		static const size_t FRAME_COUNT = 2;
+		/// Minimum number of sprites for which vertex and index buffer space is allocated.
+		static const uint32_t SPRITE_CAPACITY_MIN = 256;
+
+		/// @name Construction/Destruction
+		//@{
+		SpriteBatcher();
+		~SpriteBatcher();
+		//@}
+
+		/// @name Initialization
+		//@{
+		void Shutdown();
+		//@}
+
+		/// @name Sprite Submission
+		//@{
+		void DrawSprite(
+			RTexture2d* pTexture, const Simd::Matrix44& rTransform, const Simd::Vector2& rUvTopLeft,
+			const Simd::Vector2& rUvBottomRight, int32_t layer = 0, Color color = Color( 0xffffffff ) );
+		//@}
+
+		/// @name Frame Capture
+		//@{
+		void Capture( size_t frameIndex );
+		//@}
+
+		/// @name Rendering
+		//@{
+		void Upload( size_t frameIndex );
+		void Draw( RRenderCommandProxy* pCommandProxy, size_t frameIndex );
+		//@}
+
+		/// @name Static Utility Functions
+		//@{
+		static void GetAtlasUvCoordinates(
+			uint32_t textureWidth, uint32_t textureHeight, int32_t pixelX, int32_t pixelY, int32_t pixelWidth,
+			int32_t pixelHeight, Simd::Vector2& rUvTopLeft, Simd::Vector2& rUvBottomRight );
+		//@}
+
+	private:
+		/// Sprite instance data.
+		HELIUM_SIMD_ALIGN_PRE struct Sprite
+		{
+			/// World transform of the unit sprite quad.
+			Simd::Matrix44 transform;
+			/// Sprite texture.
+			RTexture2dPtr spTexture;
+			/// Texture coordinates at the top-left corner of the sprite.
+			float32_t uvTopLeft[ 2 ];
+			/// Texture coordinates at the bottom-right corner of the sprite.
+			float32_t uvBottomRight[ 2 ];
+			/// Sort layer (lower layers are drawn first).
+			int32_t layer;
+			/// Color with which to blend the sprite.
+			Color color;
+		} HELIUM_SIMD_ALIGN_POST;
+
+		/// Sprite sort key.
+		struct SortEntry
+		{
+			/// Sort layer.
+			int32_t layer;
+			/// Sprite texture.
+			RTexture2d* pTexture;
+			/// Index of the sprite in the instance list.
+			uint32_t spriteIndex;
+		};
+
+		/// Run of sorted sprites sharing the same layer and texture.
+		struct Batch
+		{
+			/// Sprite texture.
+			RTexture2dPtr spTexture;
+			/// Index of the first sprite quad in the captured vertex data.
+			uint32_t startSprite;
+			/// Number of sprite quads.
+			uint32_t spriteCount;
+		};
+
+		/// Sprite data captured for rendering a single frame.
+		struct Frame
+		{
+			/// Expanded sprite quad vertices, in draw order.
+			DynamicArray< SimpleTexturedVertex > vertices;
+			/// Draw batches.
+			DynamicArray< Batch > batches;
+			/// Vertex buffer into which the vertices were uploaded (null if not uploaded).
+			RVertexBuffer* pVertexBuffer;
+		};
+
+		/// Sprites submitted for the current frame.
+		DynamicArray< Sprite > m_sprites;
+		/// Sort keys for the sprites submitted for the current frame.
+		DynamicArray< SortEntry > m_sortEntries;
+
+		/// Captured frame data.
+		Frame m_frames[ FRAME_COUNT ];
+
+		/// Dynamic vertex buffers for the expanded sprite quads (alternated between uploads).
+		RVertexBufferPtr m_spVertexBuffers[ 2 ];
+		/// Number of sprites that fit in each vertex buffer.
+		uint32_t m_vertexBufferCapacities[ 2 ];
+		/// Index of the vertex buffer to use for the next upload.
+		size_t m_vertexBufferIndex;
+
+		/// Static quad index buffer.
+		RIndexBufferPtr m_spIndexBuffer;
+		/// Number of sprites covered by the quad index buffer.
+		uint32_t m_indexBufferCapacity;
+
+		/// Pixel shader constants (white blend color, as sprite colors are stored in the vertices).
+		RConstantBufferPtr m_spPixelConstantBuffer;
+
+		/// @name Private Utility Functions
+		//@{
+		bool ReserveBuffers( uint32_t spriteCount );
+		//@}
+
+		/// @name Static Private Utility Functions
+		//@{
+		static bool SortEntryLess( const SortEntry& rEntry0, const SortEntry& rEntry1 );
+		//@}
+	};
+}
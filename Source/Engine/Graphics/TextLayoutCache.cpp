@@ -0,0 +1,151 @@
+#include "Precompile.h"
+#include "Graphics/TextLayoutCache.h"
+
+using namespace Helium;
+
+/// Constructor.
+TextLayoutCache::TextLayoutCache()
+	: m_frameIndex( 0 )
+{
+}
+
+/// Destructor.
+TextLayoutCache::~TextLayoutCache()
+{
+	Clear();
+}
+
+/// Get the layout of the given text, laying it out and caching it first if necessary.
+///
+/// @param[in]  pFont        Font with which to lay out the text.
+/// @param[in]  rText        Text to lay out.
+/// @param[out] rGlyphCount  Number of character quads in the returned layout.
+///
+/// @return  Laid-out character quads, or null if the text produced no characters.  The returned array is only valid
+///          until the next call to GetLayout(), Update(), or Clear().
+const TextLayoutCache::Glyph* TextLayoutCache::GetLayout( const Font* pFont, const String& rText, uint32_t& rGlyphCount )
+{
+	HELIUM_ASSERT( pFont );
+
+	rGlyphCount = 0;
+
+	if ( rText.IsEmpty() )
+	{
+		return NULL;
+	}
+
+	uint64_t key = ComputeKey( pFont, rText );
+
+	Entry* pEntry;
+
+	HashMap< uint64_t, size_t >::Iterator entryIterator = m_entryMap.Find( key );
+	if ( entryIterator != m_entryMap.End() )
+	{
+		pEntry = &m_entries[entryIterator->Second()];
+
+		// Key collisions simply replace the existing layout.
+		if ( pEntry->spFont.Get() != pFont || pEntry->text != rText )
+		{
+			pEntry->spFont = pFont;
+			pEntry->text = rText;
+			pEntry->glyphs.RemoveAll();
+
+			LayoutGlyphHandler glyphHandler( pFont, pEntry->glyphs );
+			pFont->ProcessText( rText, glyphHandler );
+		}
+	}
+	else
+	{
+		pEntry = m_entries.New();
+		HELIUM_ASSERT( pEntry );
+		pEntry->key = key;
+		pEntry->spFont = pFont;
+		pEntry->text = rText;
+
+		LayoutGlyphHandler glyphHandler( pFont, pEntry->glyphs );
+		pFont->ProcessText( rText, glyphHandler );
+
+		size_t entryIndex = m_entries.GetElementIndex( pEntry );
+		HELIUM_VERIFY( m_entryMap.Insert( entryIterator, HashMap< uint64_t, size_t >::ValueType( key, entryIndex ) ) );
+	}
+
+	pEntry->lastUseFrame = m_frameIndex;
+
+	rGlyphCount = static_cast< uint32_t >( pEntry->glyphs.GetSize() );
+
+	return pEntry->glyphs.GetData();
+}
+
+/// Advance the cache frame and evict layouts that have gone unused for too long.
+///
+/// This should be called once per frame, after all text for the frame has been laid out.
+void TextLayoutCache::Update()
+{
+	size_t entryCount = m_entries.GetSize();
+	for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		if ( !m_entries.IsElementValid( entryIndex ) )
+		{
+			continue;
+		}
+
+		const Entry& rEntry = m_entries[entryIndex];
+		if ( m_frameIndex - rEntry.lastUseFrame >= LAYOUT_FRAME_LIFETIME )
+		{
+			HELIUM_VERIFY( m_entryMap.Remove( rEntry.key ) );
+			m_entries.Remove( entryIndex );
+		}
+	}
+
+	++m_frameIndex;
+}
+
+/// Remove all cached layouts, releasing their font references.
+void TextLayoutCache::Clear()
+{
+	m_entryMap.Clear();
+	m_entries.Clear();
+}
+
+/// Compute the cache key for a string laid out with a specific font.
+///
+/// @param[in] pFont  Font with which the text is laid out.
+/// @param[in] rText  Text being laid out.
+///
+/// @return  Layout key.
+uint64_t TextLayoutCache::ComputeKey( const Font* pFont, const String& rText )
+{
+	uint64_t fontHash = static_cast< uint64_t >( reinterpret_cast< uintptr_t >( pFont ) ) * 0x9e3779b97f4a7c15ULL;
+	uint64_t textHash = static_cast< uint64_t >( StringHash( rText.GetData() ) );
+
+	return fontHash ^ ( textHash + ( static_cast< uint64_t >( rText.GetSize() ) << 32 ) );
+}
+
+/// Constructor.
+///
+/// @param[in] pFont    Font being used for layout.
+/// @param[in] rGlyphs  Glyph array to fill.
+TextLayoutCache::LayoutGlyphHandler::LayoutGlyphHandler( const Font* pFont, DynamicArray< Glyph >& rGlyphs )
+	: m_pFont( pFont )
+	, m_rGlyphs( rGlyphs )
+	, m_penX( 0.0f )
+{
+}
+
+/// Lay out the specified character.
+///
+/// @param[in] pCharacter  Character to lay out.
+void TextLayoutCache::LayoutGlyphHandler::operator()( const Font::Character* pCharacter )
+{
+	HELIUM_ASSERT( pCharacter );
+
+	Glyph* pGlyph = m_rGlyphs.New();
+	HELIUM_ASSERT( pGlyph );
+	pGlyph->characterIndex = m_pFont->GetCharacterIndex( pCharacter );
+	pGlyph->cornerMinX = Floor( m_penX + 0.5f ) + static_cast< float32_t >( pCharacter->bearingX >> 6 );
+	pGlyph->cornerMaxX = pGlyph->cornerMinX + static_cast< float32_t >( pCharacter->imageWidth );
+	pGlyph->cornerTopY = static_cast< float32_t >( pCharacter->bearingY >> 6 );
+	pGlyph->cornerBottomY = pGlyph->cornerTopY - static_cast< float32_t >( pCharacter->imageHeight );
+
+	m_penX += Font::Fixed26x6ToFloat32( pCharacter->advance );
+}
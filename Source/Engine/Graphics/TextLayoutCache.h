@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/SparseArray.h"
+#include "Graphics/Font.h"
+
+namespace Helium
+{
+	/// Cache of laid-out text strings.
+	///
+	/// Laying out a string requires converting it to Unicode code points, looking up each character in the font, and
+	/// accumulating the pen position across the string.  Text that is drawn repeatedly (i.e. HUD labels) will usually
+	/// not change between frames, so the resulting glyph quads are cached by font and string contents and reused until
+	/// the string changes.  Layouts that have not been requested for LAYOUT_FRAME_LIFETIME frames are evicted by
+	/// Update().
+	///
+	/// Only the glyph positions are cached.  Glyph texture coordinates can change as characters are moved in and out of
+	/// the glyph cache, so they are still resolved each time text geometry is built.
+	///
+	/// Each cached layout holds a reference to its font, so fonts stay loaded until their layouts are evicted.
+	class HELIUM_GRAPHICS_API TextLayoutCache : NonCopyable
+	{
+	public:
+		/// Number of frames a layout can go unused before it is evicted.
+		static const uint32_t LAYOUT_FRAME_LIFETIME = 60;
+
+		/// Laid-out character quad.
+		///
+		/// Corner coordinates are in pixels relative to the start of the text baseline, with the y-axis pointing up.
+		struct Glyph
+		{
+			/// Index of the character in the font.
+			uint32_t characterIndex;
+			/// Horizontal coordinate of the left edge of the character image.
+			float32_t cornerMinX;
+			/// Horizontal coordinate of the right edge of the character image.
+			float32_t cornerMaxX;
+			/// Vertical coordinate of the top edge of the character image.
+			float32_t cornerTopY;
+			/// Vertical coordinate of the bottom edge of the character image.
+			float32_t cornerBottomY;
+		};
+
+		/// @name Construction/Destruction
+		//@{
+		TextLayoutCache();
+		~TextLayoutCache();
+		//@}
+
+		/// @name Layout Access
+		//@{
+		const Glyph* GetLayout( const Font* pFont, const String& rText, uint32_t& rGlyphCount );
+		//@}
+
+		/// @name Updating
+		//@{
+		void Update();
+		void Clear();
+
+		inline size_t GetLayoutCount() const;
+		//@}
+
+	private:
+		/// Cached layout entry.
+		struct Entry
+		{
+			/// Layout key.
+			uint64_t key;
+			/// Font used to lay out the text.
+			StrongPtr< const Font > spFont;
+			/// Laid-out text.
+			String text;
+			/// Laid-out character quads.
+			DynamicArray< Glyph > glyphs;
+			/// Index of the frame in which the layout was last used.
+			uint32_t lastUseFrame;
+		};
+
+		/// Glyph handler for laying out text.
+		class LayoutGlyphHandler : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			LayoutGlyphHandler( const Font* pFont, DynamicArray< Glyph >& rGlyphs );
+			//@}
+
+			/// @name Overloaded Operators
+			//@{
+			void operator()( const Font::Character* pCharacter );
+			//@}
+
+		private:
+			/// Font being used for layout.
+			const Font* m_pFont;
+			/// Glyph array to fill.
+			DynamicArray< Glyph >& m_rGlyphs;
+			/// Current horizontal pen coordinate.
+			float32_t m_penX;
+		};
+
+		/// Cached layouts.
+		SparseArray< Entry > m_entries;
+		/// Cached layout entry indices by layout key.
+		HashMap< uint64_t, size_t > m_entryMap;
+
+		/// Current frame index.
+		uint32_t m_frameIndex;
+
+		/// @name Static Private Utility Functions
+		//@{
+		static uint64_t ComputeKey( const Font* pFont, const String& rText );
+		//@}
+	};
+}
+
+#include "Graphics/TextLayoutCache.inl"
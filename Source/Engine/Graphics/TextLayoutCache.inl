@@ -0,0 +1,10 @@
+namespace Helium
+{
+	/// Get the number of layouts currently stored in the cache.
+	///
+	/// @return  Cached layout count.
+	size_t TextLayoutCache::GetLayoutCount() const
+	{
+		return m_entryMap.GetSize();
+	}
+}
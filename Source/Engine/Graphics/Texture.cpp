@@ -6,6 +6,7 @@
 #include "Reflect/TranslatorDeduction.h"
 
 HELIUM_DEFINE_ENUM( Helium::Texture::ECompression );
+HELIUM_DEFINE_ENUM( Helium::Texture::EMipFilter );
 HELIUM_IMPLEMENT_ASSET( Helium::Texture, Graphics, AssetType::FLAG_ABSTRACT | AssetType::FLAG_NO_TEMPLATE );
 
 using namespace Helium;
@@ -15,6 +16,7 @@ Texture::Texture()
 : m_compression( ECompression::COLOR_SMOOTH_ALPHA )
 , m_bSrgb( true )
 , m_bCreateMipmaps( true )
+, m_mipFilter( EMipFilter::BOX )
 , m_bIgnoreAlpha( false )
 {
 }
@@ -37,6 +39,7 @@ void Texture::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &Texture::m_compression,  "m_compression" );
     comp.AddField( &Texture::m_bSrgb,          "m_bSrgb" );
     comp.AddField( &Texture::m_bCreateMipmaps, "m_bCreateMipmaps" );
+    comp.AddField( &Texture::m_mipFilter,      "m_mipFilter" );
     comp.AddField( &Texture::m_bIgnoreAlpha,   "m_bIgnoreAlpha" );
 }
 
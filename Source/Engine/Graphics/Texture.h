@@ -40,6 +40,9 @@ namespace Helium
                 NORMAL_MAP,
                 /// Compressed normal map, higher compression (DXT1 with special handling during mip level generation).
                 NORMAL_MAP_COMPACT,
+                /// Compressed two-channel normal map (BC5 with special handling during mip level generation).  Only the
+                /// X and Y components are stored, so shaders must reconstruct the Z component when sampling.
+                NORMAL_MAP_TWO_CHANNEL,
 
                 MAX,
             };
@@ -54,6 +57,32 @@ namespace Helium
                 info.AddElement( COLOR_SMOOTH_ALPHA,    "COLOR_SMOOTH_ALPHA" );
                 info.AddElement( NORMAL_MAP,            "NORMAL_MAP" );
                 info.AddElement( NORMAL_MAP_COMPACT,    "NORMAL_MAP_COMPACT" );
+                info.AddElement( NORMAL_MAP_TWO_CHANNEL, "NORMAL_MAP_TWO_CHANNEL" );
+            }
+        };
+
+        struct EMipFilter : Reflect::Enum
+        {
+            /// Filters used for downsampling each mip level from the level above it during resource preprocessing.
+            enum Enum
+            {
+                /// 2x2 box filter (fastest, blurriest at non-power-of-two sizes).
+                BOX,
+                /// Triangle (tent) filter.
+                TRIANGLE,
+                /// Kaiser-windowed sinc filter (sharpest, slowest).
+                KAISER,
+
+                MAX,
+            };
+
+            HELIUM_DECLARE_ENUM( EMipFilter );
+
+            static void PopulateMetaType( Helium::Reflect::MetaEnum& info )
+            {
+                info.AddElement( BOX,      "BOX" );
+                info.AddElement( TRIANGLE, "TRIANGLE" );
+                info.AddElement( KAISER,   "KAISER" );
             }
         };
 
@@ -76,6 +105,7 @@ namespace Helium
         inline ECompression GetCompression() const;
         inline bool GetSrgb() const;
         inline bool GetCreateMipmaps() const;
+        inline EMipFilter GetMipFilter() const;
         inline bool GetIgnoreAlpha() const;
         //@}
 
@@ -99,6 +129,8 @@ namespace Helium
         bool m_bSrgb;
         /// True to generate mipmaps, false to only use a single mipmap.
         bool m_bCreateMipmaps;
+        /// Filter used when generating mipmaps.
+        EMipFilter m_mipFilter;
         /// True to ignore any alpha channel data, false to keep it.
         bool m_bIgnoreAlpha;
     };
@@ -32,6 +32,14 @@ namespace Helium
         return m_bCreateMipmaps;
     }
 
+    /// Get the filter used to generate mipmaps during resource preprocessing.
+    ///
+    /// @return  Mipmap generation filter.
+    Texture::EMipFilter Texture::GetMipFilter() const
+    {
+        return m_mipFilter;
+    }
+
     /// Get whether the alpha channel in the source texture should be ignored.
     ///
     /// @return  True if the alpha channel should be ignored, false if not.
@@ -45,6 +53,8 @@ namespace Helium
     /// @return  True if the compression scheme is a normal map compression scheme, false if not.
     bool Texture::IsNormalMapCompression( ECompression compression )
     {
-        return ( compression == ECompression::NORMAL_MAP || compression == ECompression::NORMAL_MAP_COMPACT );
+        return ( compression == ECompression::NORMAL_MAP ||
+                 compression == ECompression::NORMAL_MAP_COMPACT ||
+                 compression == ECompression::NORMAL_MAP_TWO_CHANNEL );
     }
 }
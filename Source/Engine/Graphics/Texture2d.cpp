@@ -1,9 +1,12 @@
 #include "Precompile.h"
 #include "Graphics/Texture2d.h"
 
+#include "Platform/Thread.h"
+#include "Engine/MemoryTracker.h"
 #include "Rendering/RendererUtil.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RTexture2d.h"
+#include "Graphics/TextureStreamingManager.h"
 #include "Reflect/TranslatorDeduction.h"
 
 HELIUM_IMPLEMENT_ASSET( Helium::Texture2d, Graphics, AssetType::FLAG_NO_TEMPLATE );
@@ -31,12 +34,47 @@ void Texture2d::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& c
 
 /// Constructor.
 Texture2d::Texture2d()
+: m_residentMipIndex( 0 )
+, m_streamingMipIndexMax( 0 )
+, m_streamingMipIndex( 0 )
+, m_requestedMipIndex( 0 )
+, m_lastRequestFrame( 0 )
+, m_streamingManagerIndex( Invalid< size_t >() )
 {
 }
 
 /// Destructor.
 Texture2d::~Texture2d()
 {
+    HELIUM_ASSERT( IsInvalid( m_streamingManagerIndex ) );
+    HELIUM_ASSERT( !m_spStreamingTexture );
+}
+
+/// @copydoc Asset::PreDestroy()
+void Texture2d::RefCountPreDestroy()
+{
+    TextureStreamingManager* pStreamingManager = TextureStreamingManager::GetInstance();
+    if( pStreamingManager && IsValid( m_streamingManagerIndex ) )
+    {
+        pStreamingManager->UnregisterTexture( this );
+    }
+
+    HELIUM_ASSERT( IsInvalid( m_streamingManagerIndex ) );
+
+    // Pending loads write directly into mapped render resource memory, so they must be completed before the render
+    // resources can be released.
+    if( m_spStreamingTexture )
+    {
+        SyncLoadMipChain( m_spStreamingTexture, m_streamingLoadIds );
+        m_spStreamingTexture.Release();
+    }
+
+    if( !m_renderResourceLoadIds.IsEmpty() )
+    {
+        SyncLoadMipChain( GetRenderResource2d(), m_renderResourceLoadIds );
+    }
+
+    Base::RefCountPreDestroy();
 }
 
 /// @copydoc Asset::NeedsPrecacheResourceData()
@@ -56,15 +94,162 @@ bool Texture2d::BeginPrecacheResourceData()
         return true;
     }
 
+    const uint32_t mipCount = m_persistentResourceData.m_mipCount;
+    const int32_t pixelFormatIndex = m_persistentResourceData.m_pixelFormatIndex;
+    HELIUM_ASSERT( static_cast< size_t >( pixelFormatIndex ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+
+    // Cache the size of each mip chain for budgeting texture memory when streaming.
+    m_mipChainSizes.Reserve( mipCount );
+    m_mipChainSizes.Resize( mipCount );
+    m_mipChainSizes.Trim();
+
+    size_t chainSize = 0;
+    for( uint32_t mipIndex = mipCount; mipIndex-- != 0; )
+    {
+        size_t mipLevelSize = GetSubDataSize( mipIndex );
+        if( IsValid( mipLevelSize ) )
+        {
+            chainSize += mipLevelSize;
+        }
+
+        m_mipChainSizes[ mipIndex ] = chainSize;
+    }
+
+    // If mip streaming is enabled, only load the least detailed mip levels up front and leave the rest to the texture
+    // streaming manager.  Otherwise, load the full mip chain.
+    uint32_t firstMipIndex = 0;
+
+    TextureStreamingManager* pStreamingManager = TextureStreamingManager::GetInstance();
+    if( pStreamingManager )
+    {
+        firstMipIndex = TextureStreamingManager::GetResidentMipIndexMin(
+            m_persistentResourceData.m_baseLevelWidth,
+            m_persistentResourceData.m_baseLevelHeight,
+            mipCount );
+    }
+
+    m_streamingMipIndexMax = firstMipIndex;
+    m_residentMipIndex = firstMipIndex;
+
+    RTexture2d* pTexture2d = BeginLoadMipChain( firstMipIndex, m_renderResourceLoadIds );
+    if( !pTexture2d )
+    {
+        return false;
+    }
+
+    m_spTexture = pTexture2d;
+
+    return true;
+}
+
+/// @copydoc Asset::TryFinishPrecacheResourceData()
+bool Texture2d::TryFinishPrecacheResourceData()
+{
+    // Check all pending load requests.
+    if( !m_renderResourceLoadIds.IsEmpty() )
+    {
+        if( !TryFinishLoadMipChain( GetRenderResource2d(), m_renderResourceLoadIds ) )
+        {
+            return false;
+        }
+
+        m_renderResourceLoadIds.Clear();
+    }
+
+    // Hand textures with streamable mip levels off to the texture streaming manager.
+    if( m_spTexture && m_streamingMipIndexMax != 0 && IsInvalid( m_streamingManagerIndex ) )
+    {
+        TextureStreamingManager* pStreamingManager = TextureStreamingManager::GetInstance();
+        if( pStreamingManager )
+        {
+            pStreamingManager->RegisterTexture( this );
+        }
+    }
+
+    return true;
+}
+
+bool Texture2d::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+{
+    TextureStreamingManager* pStreamingManager = TextureStreamingManager::GetInstance();
+    if( pStreamingManager && IsValid( m_streamingManagerIndex ) )
+    {
+        pStreamingManager->UnregisterTexture( this );
+    }
+
+    if( m_spStreamingTexture )
+    {
+        SyncLoadMipChain( m_spStreamingTexture, m_streamingLoadIds );
+        m_spStreamingTexture.Release();
+    }
+
+    m_spTexture.Release();
+    m_mipChainSizes.Clear();
+    m_residentMipIndex = 0;
+    m_streamingMipIndexMax = 0;
+
+    HELIUM_ASSERT(_object.ReferencesObject());
+    if (!_object.ReferencesObject())
+    {
+        return false;
+    }
+
+    _object->CopyTo(&m_persistentResourceData);
+
+    return true;
+}
+
+/// @copydoc Texture::GetRenderResource2d()
+RTexture2d* Texture2d::GetRenderResource2d() const
+{
+    return static_cast< RTexture2d* >( m_spTexture.Get() );
+}
+
+/// Get the amount of memory used by a mip chain for this texture.
+///
+/// @param[in] firstMipIndex  Index of the most detailed mip level in the chain.
+///
+/// @return  Size of the mip chain starting at the given mip level, in bytes.
+size_t Texture2d::GetMipChainSize( uint32_t firstMipIndex ) const
+{
+    return ( firstMipIndex < m_mipChainSizes.GetSize() ? m_mipChainSizes[ firstMipIndex ] : 0 );
+}
+
+/// Create a render resource holding the given range of mip levels and begin asynchronously loading the mip data
+/// into it.
+///
+/// Mip level 0 of the created render resource corresponds to mip level @c firstMipIndex of this texture, so the
+/// render resource is sized accordingly.
+///
+/// @param[in]  firstMipIndex  Index of the most detailed mip level to load.
+/// @param[out] rLoadIds       Async load IDs for each mip level in the render resource.
+///
+/// @return  Newly created render resource if successful, null if creation failed.
+///
+/// @see TryFinishLoadMipChain(), SyncLoadMipChain()
+RTexture2d* Texture2d::BeginLoadMipChain( uint32_t firstMipIndex, DynamicArray< size_t >& rLoadIds )
+{
+    HELIUM_ASSERT( rLoadIds.IsEmpty() );
+
+    Renderer* pRenderer = Renderer::GetInstance();
+    HELIUM_ASSERT( pRenderer );
+
     const uint32_t baseLevelWidth = m_persistentResourceData.m_baseLevelWidth;
     const uint32_t baseLevelHeight = m_persistentResourceData.m_baseLevelHeight;
     const uint32_t mipCount = m_persistentResourceData.m_mipCount;
     const int32_t pixelFormatIndex = m_persistentResourceData.m_pixelFormatIndex;
 
+    HELIUM_ASSERT( firstMipIndex < mipCount || mipCount == 0 );
+
+    const uint32_t chainWidth = Max< uint32_t >( baseLevelWidth >> firstMipIndex, 1 );
+    const uint32_t chainHeight = Max< uint32_t >( baseLevelHeight >> firstMipIndex, 1 );
+    const uint32_t chainMipCount = mipCount - firstMipIndex;
+
+    HELIUM_MEMORY_SCOPE( MEMORY_TAG_TEXTURE_2D );
     RTexture2d* pTexture2d = pRenderer->CreateTexture2d(
-        baseLevelWidth,
-        baseLevelHeight,
-        mipCount,
+        chainWidth,
+        chainHeight,
+        chainMipCount,
         static_cast< ERendererPixelFormat >( pixelFormatIndex ),
         RENDERER_BUFFER_USAGE_STATIC );
 
@@ -72,42 +257,42 @@ bool Texture2d::BeginPrecacheResourceData()
     {
         HELIUM_TRACE(
             TraceLevels::Error,
-            "Texture2d::BeginPrecacheResourceData(): Failed to create texture render resource (width: %" PRIu32 "; height: %" PRIu32 "; mip count: %" PRIu32 "; pixel format index: %" PRId32 ").\n",
-            baseLevelWidth,
-            baseLevelHeight,
-            mipCount,
+            "Texture2d::BeginLoadMipChain(): Failed to create texture render resource (width: %" PRIu32 "; height: %" PRIu32 "; mip count: %" PRIu32 "; pixel format index: %" PRId32 ").\n",
+            chainWidth,
+            chainHeight,
+            chainMipCount,
             pixelFormatIndex );
 
-        return false;
+        return NULL;
     }
 
-    m_spTexture = pTexture2d;
-
-    m_renderResourceLoadIds.Reserve( mipCount );
-    m_renderResourceLoadIds.Resize( mipCount );
-    m_renderResourceLoadIds.Trim();
+    rLoadIds.Reserve( chainMipCount );
+    rLoadIds.Resize( chainMipCount );
+    rLoadIds.Trim();
 
     const ERendererPixelFormat format = static_cast< ERendererPixelFormat >( pixelFormatIndex );
     HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
 
-    for ( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    for ( uint32_t chainMipIndex = 0; chainMipIndex < chainMipCount; ++chainMipIndex )
     {
-        SetInvalid( m_renderResourceLoadIds[ mipIndex ] );
+        SetInvalid( rLoadIds[ chainMipIndex ] );
+
+        const uint32_t mipIndex = firstMipIndex + chainMipIndex;
 
         size_t pitch;
-        void* pMipData = pTexture2d->Map( mipIndex, pitch );
+        void* pMipData = pTexture2d->Map( chainMipIndex, pitch );
         HELIUM_ASSERT( pMipData );
         if ( !pMipData )
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                "Texture2d::BeginPrecacheResourceData(): Failed to lock mip level %" PRIu32 ".\n",
+                "Texture2d::BeginLoadMipChain(): Failed to lock mip level %" PRIu32 ".\n",
                 mipIndex );
 
             continue;
         }
 
-        uint32_t mipLevelHeight = pTexture2d->GetHeight( mipIndex );
+        uint32_t mipLevelHeight = pTexture2d->GetHeight( chainMipIndex );
         size_t rowCount = RendererUtil::PixelToBlockRowCount( mipLevelHeight, format );
         size_t mipLevelSize = pitch * rowCount;
 
@@ -119,31 +304,38 @@ bool Texture2d::BeginPrecacheResourceData()
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                "Texture2d::BeginPrecacheResourceData(): Failed to begin loading of cached data for mip level %" PRIu32 ".\n",
+                "Texture2d::BeginLoadMipChain(): Failed to begin loading of cached data for mip level %" PRIu32 ".\n",
                 mipIndex );
 
-            pTexture2d->Unmap( mipIndex );
+            pTexture2d->Unmap( chainMipIndex );
 
             continue;
         }
 
-        m_renderResourceLoadIds[ mipIndex ] = loadId;
+        rLoadIds[ chainMipIndex ] = loadId;
     }
 
-    return true;
+    return pTexture2d;
 }
 
-/// @copydoc Asset::TryFinishPrecacheResourceData()
-bool Texture2d::TryFinishPrecacheResourceData()
+/// Check for completion of mip level loads started with BeginLoadMipChain(), unmapping each mip level as its load
+/// completes.
+///
+/// @param[in]     pTexture2d  Render resource being loaded.
+/// @param[in,out] rLoadIds    Async load IDs for each mip level in the render resource.  Completed loads are
+///                            invalidated.
+///
+/// @return  True if all mip levels have finished loading, false if not.
+///
+/// @see BeginLoadMipChain(), SyncLoadMipChain()
+bool Texture2d::TryFinishLoadMipChain( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds )
 {
-    // Check all pending load requests.
-    size_t loadRequestCount = m_renderResourceLoadIds.GetSize();
+    size_t loadRequestCount = rLoadIds.GetSize();
     if( loadRequestCount == 0 )
     {
         return true;
     }
 
-    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
     HELIUM_ASSERT( pTexture2d );
     HELIUM_ASSERT( loadRequestCount == pTexture2d->GetMipCount() );
 
@@ -151,7 +343,7 @@ bool Texture2d::TryFinishPrecacheResourceData()
 
     for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestCount; ++loadRequestIndex )
     {
-        size_t loadId = m_renderResourceLoadIds[ loadRequestIndex ];
+        size_t loadId = rLoadIds[ loadRequestIndex ];
         if( IsInvalid( loadId ) )
         {
             continue;
@@ -164,37 +356,84 @@ bool Texture2d::TryFinishPrecacheResourceData()
             continue;
         }
 
-        SetInvalid( m_renderResourceLoadIds[ loadRequestIndex ] );
+        SetInvalid( rLoadIds[ loadRequestIndex ] );
         pTexture2d->Unmap( static_cast< uint32_t >( loadRequestIndex ) );
     }
 
-    if( bHaveUnfinishedLoad )
+    return !bHaveUnfinishedLoad;
+}
+
+/// Block until all mip level loads started with BeginLoadMipChain() have completed.
+///
+/// @param[in]     pTexture2d  Render resource being loaded.
+/// @param[in,out] rLoadIds    Async load IDs for each mip level in the render resource.  This will be cleared once
+///                            all loads have completed.
+///
+/// @see BeginLoadMipChain(), TryFinishLoadMipChain()
+void Texture2d::SyncLoadMipChain( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds )
+{
+    while( !TryFinishLoadMipChain( pTexture2d, rLoadIds ) )
     {
-        return false;
+        Thread::Yield();
     }
 
-    m_renderResourceLoadIds.Clear();
-
-    return true;
+    rLoadIds.Clear();
 }
 
-bool Texture2d::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+/// Begin streaming in a new set of resident mip levels.
+///
+/// A new render resource is created for the requested mip chain and swapped in for the current render resource once
+/// all of its mip levels have loaded (see TryFinishStreamMips()).  This is used both for streaming in more detailed
+/// mip levels and for evicting mip levels that are no longer needed.
+///
+/// @param[in] firstMipIndex  Index of the most detailed mip level to keep resident.
+///
+/// @return  True if streaming was started successfully, false if not.
+///
+/// @see TryFinishStreamMips()
+bool Texture2d::BeginStreamMips( uint32_t firstMipIndex )
 {
-    m_spTexture.Release();
+    HELIUM_ASSERT( !m_spStreamingTexture );
+    HELIUM_ASSERT( m_streamingLoadIds.IsEmpty() );
+    HELIUM_ASSERT( firstMipIndex <= m_streamingMipIndexMax );
 
-    HELIUM_ASSERT(_object.ReferencesObject());
-    if (!_object.ReferencesObject())
+    RTexture2d* pTexture2d = BeginLoadMipChain( firstMipIndex, m_streamingLoadIds );
+    if( !pTexture2d )
     {
         return false;
     }
 
-    _object->CopyTo(&m_persistentResourceData);
+    m_spStreamingTexture = pTexture2d;
+    m_streamingMipIndex = firstMipIndex;
 
     return true;
 }
 
-/// @copydoc Texture::GetRenderResource2d()
-RTexture2d* Texture2d::GetRenderResource2d() const
+/// Check for completion of mip streaming started with BeginStreamMips(), swapping in the new render resource once
+/// all of its mip levels have loaded.
+///
+/// @return  True if streaming has completed (or no streaming was in progress), false if not.
+///
+/// @see BeginStreamMips()
+bool Texture2d::TryFinishStreamMips()
 {
-    return static_cast< RTexture2d* >( m_spTexture.Get() );
+    if( !m_spStreamingTexture )
+    {
+        return true;
+    }
+
+    if( !TryFinishLoadMipChain( m_spStreamingTexture, m_streamingLoadIds ) )
+    {
+        return false;
+    }
+
+    m_streamingLoadIds.Clear();
+
+    // Render resources are looked up from the texture each time they are bound, so the old render resource can
+    // simply be replaced (any references still held for rendering will keep it alive until no longer needed).
+    m_spTexture = m_spStreamingTexture.Get();
+    m_spStreamingTexture.Release();
+    m_residentMipIndex = m_streamingMipIndex;
+
+    return true;
 }
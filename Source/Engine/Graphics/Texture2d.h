@@ -4,6 +4,8 @@
 
 namespace Helium
 {
+	HELIUM_DECLARE_RPTR( RTexture2d );
+
 	class Texture2d;
 	typedef Helium::StrongPtr< Texture2d > Texture2dPtr;
 	typedef Helium::StrongPtr< const Texture2d > ConstTexture2dPtr;
@@ -20,6 +22,11 @@ namespace Helium
 		virtual ~Texture2d();
 		//@}
 
+		/// @name Asset Interface
+		//@{
+		virtual void RefCountPreDestroy() override;
+		//@}
+
 		struct HELIUM_GRAPHICS_API PersistentResourceData : public Object
 		{
 			HELIUM_DECLARE_CLASS(Texture2d::PersistentResourceData, Reflect::Object);
@@ -56,9 +63,54 @@ namespace Helium
 		virtual RTexture2d* GetRenderResource2d() const override;
 		//@}
 
+		/// @name Mip Streaming
+		//@{
+		inline uint32_t GetMipCount() const;
+		inline uint32_t GetResidentMipIndex() const;
+		inline uint32_t GetStreamingMipIndexMax() const;
+		inline bool IsStreamingMips() const;
+
+		size_t GetMipChainSize( uint32_t firstMipIndex ) const;
+		//@}
+
 	private:
+		friend class TextureStreamingManager;
+
 		/// Async load IDs for cached texture data.
 		DynamicArray< size_t > m_renderResourceLoadIds;
+
+		/// Size of the mip chain starting at each mip level, in bytes (one entry per mip level).
+		DynamicArray< size_t > m_mipChainSizes;
+
+		/// Index of the most detailed mip level loaded in the current render resource.
+		uint32_t m_residentMipIndex;
+		/// Index of the least detailed mip level at which the texture will be kept resident at all times (textures
+		/// are never evicted below this level).
+		uint32_t m_streamingMipIndexMax;
+
+		/// Render resource currently being streamed in to replace the current render resource.
+		RTexture2dPtr m_spStreamingTexture;
+		/// Index of the most detailed mip level in the render resource being streamed in.
+		uint32_t m_streamingMipIndex;
+		/// Async load IDs for mip levels being streamed in.
+		DynamicArray< size_t > m_streamingLoadIds;
+
+		/// Most detailed mip level requested for rendering during the last frame in which this texture was used.
+		uint32_t m_requestedMipIndex;
+		/// Texture streaming manager frame index during which this texture was last requested for rendering.
+		uint32_t m_lastRequestFrame;
+		/// Index of this texture in the texture streaming manager's registry (invalid if not registered).
+		size_t m_streamingManagerIndex;
+
+		/// @name Private Utility Functions
+		//@{
+		RTexture2d* BeginLoadMipChain( uint32_t firstMipIndex, DynamicArray< size_t >& rLoadIds );
+		bool TryFinishLoadMipChain( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds );
+		void SyncLoadMipChain( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds );
+
+		bool BeginStreamMips( uint32_t firstMipIndex );
+		bool TryFinishStreamMips();
+		//@}
 	};
 }
 
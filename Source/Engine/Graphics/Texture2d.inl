@@ -10,4 +10,43 @@ namespace Helium
 	{
 		return m_persistentResourceData.m_baseLevelHeight;
 	}
+
+	/// Get the total number of mip levels available for this texture, regardless of how many are currently resident.
+	///
+	/// @return  Mip level count.
+	uint32_t Texture2d::GetMipCount() const
+	{
+		return m_persistentResourceData.m_mipCount;
+	}
+
+	/// Get the index of the most detailed mip level currently resident in the texture render resource.
+	///
+	/// @return  Most detailed resident mip level index.
+	///
+	/// @see GetStreamingMipIndexMax(), IsStreamingMips()
+	uint32_t Texture2d::GetResidentMipIndex() const
+	{
+		return m_residentMipIndex;
+	}
+
+	/// Get the index of the least detailed mip level to which this texture can be evicted by the texture streaming
+	/// manager.
+	///
+	/// @return  Least detailed mip level index at which this texture is always kept resident.
+	///
+	/// @see GetResidentMipIndex()
+	uint32_t Texture2d::GetStreamingMipIndexMax() const
+	{
+		return m_streamingMipIndexMax;
+	}
+
+	/// Get whether a new set of mip levels is currently being streamed in for this texture.
+	///
+	/// @return  True if mip levels are being streamed in, false if not.
+	///
+	/// @see GetResidentMipIndex()
+	bool Texture2d::IsStreamingMips() const
+	{
+		return m_spStreamingTexture.Get() != NULL;
+	}
 }
@@ -0,0 +1,445 @@
+#include "Precompile.h"
+#include "Graphics/TextureStreamingManager.h"
+
+#include "Platform/Thread.h"
+#include "Engine/Config.h"
+#include "EngineJobs/EngineJobsInterface.h"
+#include "Graphics/GraphicsConfig.h"
+#include "Graphics/Texture2d.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+TextureStreamingManager* TextureStreamingManager::sm_pInstance = NULL;
+
+/// Constructor.
+TextureStreamingManager::TextureStreamingManager()
+	: m_budget( 0 )
+	, m_residentSize( 0 )
+	, m_frameIndex( 0 )
+	, m_streamingTextureCount( 0 )
+{
+}
+
+/// Destructor.
+TextureStreamingManager::~TextureStreamingManager()
+{
+	Cleanup();
+}
+
+/// Initialize the texture streaming manager.
+///
+/// @return  True if initialization was successful, false if not (including if texture streaming is disabled in the
+///          graphics configuration).
+///
+/// @see Cleanup()
+bool TextureStreamingManager::Initialize()
+{
+	Cleanup();
+
+	Config* pConfig = Config::GetInstance();
+	if ( !HELIUM_VERIFY( pConfig ) )
+	{
+		return false;
+	}
+
+	StrongPtr< GraphicsConfig > spGraphicsConfig( pConfig->GetConfigObject< GraphicsConfig >( Name( "GraphicsConfig" ) ) );
+	if ( !spGraphicsConfig )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "TextureStreamingManager::Initialize(): Initialization failed; missing GraphicsConfig.\n" );
+		return false;
+	}
+
+	uint32_t budgetMegabytes = spGraphicsConfig->GetTextureStreamingBudget();
+	if ( budgetMegabytes == 0 )
+	{
+		HELIUM_TRACE( TraceLevels::Info, "TextureStreamingManager::Initialize(): Texture streaming disabled.\n" );
+		return false;
+	}
+
+	m_budget = static_cast< size_t >( budgetMegabytes ) * 1024 * 1024;
+
+	return true;
+}
+
+/// Unregister all textures and shut down the texture streaming manager.
+///
+/// Any mip streaming in progress is completed before returning.
+///
+/// @see Initialize()
+void TextureStreamingManager::Cleanup()
+{
+	size_t textureCount = m_textures.GetSize();
+	for ( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+	{
+		Texture2d* pTexture = m_textures[textureIndex];
+		HELIUM_ASSERT( pTexture );
+
+		while ( !pTexture->TryFinishStreamMips() )
+		{
+			Thread::Yield();
+		}
+
+		SetInvalid( pTexture->m_streamingManagerIndex );
+	}
+
+	m_textures.Clear();
+	m_targetMipIndices.Clear();
+	m_priorityIndices.Clear();
+
+	m_budget = 0;
+	m_residentSize = 0;
+	m_streamingTextureCount = 0;
+}
+
+/// Register a texture for mip streaming.
+///
+/// @param[in] pTexture  Texture to register.  Its least detailed mip levels must already be resident.
+///
+/// @see UnregisterTexture()
+void TextureStreamingManager::RegisterTexture( Texture2d* pTexture )
+{
+	HELIUM_ASSERT( pTexture );
+	HELIUM_ASSERT( IsInvalid( pTexture->m_streamingManagerIndex ) );
+	HELIUM_ASSERT( !pTexture->IsStreamingMips() );
+
+	// Treat the texture as not having been requested recently so that it is not streamed in until it is rendered.
+	pTexture->m_requestedMipIndex = pTexture->m_streamingMipIndexMax;
+	pTexture->m_lastRequestFrame = m_frameIndex - REQUEST_FRAME_COUNT;
+	pTexture->m_streamingManagerIndex = m_textures.GetSize();
+
+	m_textures.Push( pTexture );
+	m_residentSize += pTexture->GetMipChainSize( pTexture->m_residentMipIndex );
+}
+
+/// Unregister a texture from mip streaming.
+///
+/// Any mip streaming in progress for the texture will no longer be tracked by this manager, so the texture is
+/// responsible for completing it.
+///
+/// @param[in] pTexture  Texture to unregister.
+///
+/// @see RegisterTexture()
+void TextureStreamingManager::UnregisterTexture( Texture2d* pTexture )
+{
+	HELIUM_ASSERT( pTexture );
+
+	size_t textureIndex = pTexture->m_streamingManagerIndex;
+	HELIUM_ASSERT( textureIndex < m_textures.GetSize() );
+	HELIUM_ASSERT( m_textures[textureIndex] == pTexture );
+
+	if ( pTexture->IsStreamingMips() )
+	{
+		HELIUM_ASSERT( m_streamingTextureCount != 0 );
+		--m_streamingTextureCount;
+	}
+
+	size_t residentSize = pTexture->GetMipChainSize( pTexture->m_residentMipIndex );
+	m_residentSize -= Min( residentSize, m_residentSize );
+
+	m_textures.RemoveSwap( textureIndex );
+	if ( textureIndex < m_textures.GetSize() )
+	{
+		m_textures[textureIndex]->m_streamingManagerIndex = textureIndex;
+	}
+
+	SetInvalid( pTexture->m_streamingManagerIndex );
+}
+
+/// Request that a texture have a given level of detail resident for rendering.
+///
+/// Requests are accumulated for the current frame, keeping the most detailed mip level requested.
+///
+/// @param[in] pTexture  Texture being rendered.
+/// @param[in] mipIndex  Index of the most detailed mip level needed.
+void TextureStreamingManager::RequestMipLevel( Texture2d* pTexture, uint32_t mipIndex )
+{
+	HELIUM_ASSERT( pTexture );
+
+	if ( IsInvalid( pTexture->m_streamingManagerIndex ) )
+	{
+		return;
+	}
+
+	if ( pTexture->m_lastRequestFrame != m_frameIndex )
+	{
+		pTexture->m_lastRequestFrame = m_frameIndex;
+		pTexture->m_requestedMipIndex = mipIndex;
+	}
+	else
+	{
+		pTexture->m_requestedMipIndex = Min( pTexture->m_requestedMipIndex, mipIndex );
+	}
+}
+
+/// Update texture streaming for the current frame.
+///
+/// This completes any pending mip streaming, determines the set of mip levels that should be resident for each
+/// texture within the streaming budget, and begins streaming mip levels in and out as necessary.  This should be
+/// called once per frame after all scenes have been rendered.
+void TextureStreamingManager::Update()
+{
+	size_t textureCount = m_textures.GetSize();
+
+	// Finish any streaming in progress and tally up the current resident memory.
+	size_t residentSize = 0;
+	for ( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+	{
+		Texture2d* pTexture = m_textures[textureIndex];
+		HELIUM_ASSERT( pTexture );
+
+		if ( pTexture->IsStreamingMips() && pTexture->TryFinishStreamMips() )
+		{
+			HELIUM_ASSERT( m_streamingTextureCount != 0 );
+			--m_streamingTextureCount;
+		}
+
+		residentSize += pTexture->GetMipChainSize( pTexture->m_residentMipIndex );
+	}
+
+	m_residentSize = residentSize;
+
+	// Determine the target mip level for each texture.  Textures that have not been requested recently keep their
+	// current mip levels until needed for other textures.
+	m_targetMipIndices.Reserve( textureCount );
+	m_targetMipIndices.Resize( textureCount );
+
+	size_t targetSize = 0;
+	for ( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+	{
+		Texture2d* pTexture = m_textures[textureIndex];
+
+		uint32_t targetMipIndex = ( pTexture->IsStreamingMips()
+			? pTexture->m_streamingMipIndex
+			: pTexture->m_residentMipIndex );
+		if ( m_frameIndex - pTexture->m_lastRequestFrame < REQUEST_FRAME_COUNT )
+		{
+			targetMipIndex = pTexture->m_requestedMipIndex;
+		}
+
+		targetMipIndex = Min( targetMipIndex, pTexture->m_streamingMipIndexMax );
+
+		m_targetMipIndices[textureIndex] = targetMipIndex;
+		targetSize += pTexture->GetMipChainSize( targetMipIndex );
+	}
+
+	// Sort textures by priority, least important first.
+	m_priorityIndices.Reserve( textureCount );
+	m_priorityIndices.Resize( textureCount );
+	for ( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+	{
+		m_priorityIndices[textureIndex] = textureIndex;
+	}
+
+	{
+		SortJob< size_t, PriorityCompare > job;
+		SortJob< size_t, PriorityCompare >::Parameters& rParameters = job.GetParameters();
+		rParameters.pBase = m_priorityIndices.GetData();
+		rParameters.count = textureCount;
+		rParameters.compare = PriorityCompare( m_textures.GetData(), m_frameIndex );
+		rParameters.singleJobCount = 100;
+		job.Run();
+	}
+
+	// Drop mip levels from the least important textures until we are within budget.
+	for ( size_t orderIndex = 0; orderIndex < textureCount && targetSize > m_budget; ++orderIndex )
+	{
+		size_t textureIndex = m_priorityIndices[orderIndex];
+		Texture2d* pTexture = m_textures[textureIndex];
+
+		uint32_t& rTargetMipIndex = m_targetMipIndices[textureIndex];
+		while ( rTargetMipIndex < pTexture->m_streamingMipIndexMax && targetSize > m_budget )
+		{
+			targetSize -= pTexture->GetMipChainSize( rTargetMipIndex );
+			++rTargetMipIndex;
+			targetSize += pTexture->GetMipChainSize( rTargetMipIndex );
+		}
+	}
+
+	// Start evicting mip levels first so that memory is released as soon as possible, then start streaming in mip
+	// levels for the most important textures.
+	for ( size_t orderIndex = 0;
+		orderIndex < textureCount && m_streamingTextureCount < STREAMING_TEXTURE_COUNT_MAX;
+		++orderIndex )
+	{
+		size_t textureIndex = m_priorityIndices[orderIndex];
+		Texture2d* pTexture = m_textures[textureIndex];
+
+		uint32_t targetMipIndex = m_targetMipIndices[textureIndex];
+		if ( !pTexture->IsStreamingMips() && targetMipIndex > pTexture->m_residentMipIndex )
+		{
+			if ( pTexture->BeginStreamMips( targetMipIndex ) )
+			{
+				++m_streamingTextureCount;
+			}
+		}
+	}
+
+	for ( size_t orderIndex = textureCount;
+		orderIndex-- != 0 && m_streamingTextureCount < STREAMING_TEXTURE_COUNT_MAX; )
+	{
+		size_t textureIndex = m_priorityIndices[orderIndex];
+		Texture2d* pTexture = m_textures[textureIndex];
+
+		uint32_t targetMipIndex = m_targetMipIndices[textureIndex];
+		if ( !pTexture->IsStreamingMips() && targetMipIndex < pTexture->m_residentMipIndex )
+		{
+			if ( pTexture->BeginStreamMips( targetMipIndex ) )
+			{
+				++m_streamingTextureCount;
+			}
+		}
+	}
+
+	++m_frameIndex;
+}
+
+/// Set the memory budget for streamed texture mip levels.
+///
+/// @param[in] budget  Texture streaming budget, in bytes.
+///
+/// @see GetBudget(), GetResidentSize()
+void TextureStreamingManager::SetBudget( size_t budget )
+{
+	m_budget = budget;
+}
+
+/// Get the singleton TextureStreamingManager instance.
+///
+/// @return  Pointer to the TextureStreamingManager instance, or null if texture streaming is not active.
+///
+/// @see Startup(), Shutdown()
+TextureStreamingManager* TextureStreamingManager::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton TextureStreamingManager instance.
+///
+/// @see Shutdown(), GetInstance()
+void TextureStreamingManager::Startup()
+{
+	if ( ++g_InitCount == 1 )
+	{
+		Config::Startup();
+
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new TextureStreamingManager;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !sm_pInstance->Initialize() )
+		{
+			delete sm_pInstance;
+			sm_pInstance = NULL;
+		}
+	}
+}
+
+/// Destroy the singleton TextureStreamingManager instance.
+///
+/// @see Startup(), GetInstance()
+void TextureStreamingManager::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		if ( sm_pInstance )
+		{
+			sm_pInstance->Cleanup();
+			delete sm_pInstance;
+			sm_pInstance = NULL;
+		}
+
+		Config::Shutdown();
+	}
+}
+
+/// Get the least detailed mip level that is always resident for a texture.
+///
+/// @param[in] baseLevelWidth   Width of the most detailed mip level.
+/// @param[in] baseLevelHeight  Height of the most detailed mip level.
+/// @param[in] mipCount         Number of mip levels in the texture.
+///
+/// @return  Index of the most detailed mip level no larger than RESIDENT_MIP_SIZE_MAX in either dimension (or the
+///          least detailed mip level if none are that small).
+uint32_t TextureStreamingManager::GetResidentMipIndexMin(
+	uint32_t baseLevelWidth,
+	uint32_t baseLevelHeight,
+	uint32_t mipCount )
+{
+	uint32_t mipIndex = 0;
+	while ( mipIndex + 1 < mipCount &&
+		( ( baseLevelWidth >> mipIndex ) > RESIDENT_MIP_SIZE_MAX ||
+		( baseLevelHeight >> mipIndex ) > RESIDENT_MIP_SIZE_MAX ) )
+	{
+		++mipIndex;
+	}
+
+	return mipIndex;
+}
+
+/// Compute the mip level needed to render a texture at a given size on screen.
+///
+/// @param[in] textureSize  Size of the most detailed mip level, in texels (typically the larger of the width and
+///                         height).
+/// @param[in] mipCount     Number of mip levels in the texture.
+/// @param[in] screenSize   Size covered by the texture on screen, in pixels.
+///
+/// @return  Index of the least detailed mip level that still provides at least one texel per pixel.
+uint32_t TextureStreamingManager::ComputeMipIndex( uint32_t textureSize, uint32_t mipCount, float32_t screenSize )
+{
+	if ( screenSize < 1.0f )
+	{
+		screenSize = 1.0f;
+	}
+
+	float32_t texelsPerPixel = static_cast< float32_t >( textureSize ) / screenSize;
+
+	uint32_t mipIndex = 0;
+	while ( texelsPerPixel >= 2.0f && mipIndex + 1 < mipCount )
+	{
+		texelsPerPixel *= 0.5f;
+		++mipIndex;
+	}
+
+	return mipIndex;
+}
+
+/// Constructor.
+TextureStreamingManager::PriorityCompare::PriorityCompare()
+	: m_ppTextures( NULL )
+	, m_frameIndex( 0 )
+{
+}
+
+/// Constructor.
+///
+/// @param[in] ppTextures  Registered textures.
+/// @param[in] frameIndex  Current frame index.
+TextureStreamingManager::PriorityCompare::PriorityCompare( Texture2d* const* ppTextures, uint32_t frameIndex )
+	: m_ppTextures( ppTextures )
+	, m_frameIndex( frameIndex )
+{
+}
+
+/// Compare two textures for sorting.
+///
+/// Textures that have gone longer without being rendered are less important.  Among textures last rendered during
+/// the same frame, those requiring less detail are less important.
+///
+/// @param[in] textureIndex0  Index of the first texture to compare.
+/// @param[in] textureIndex1  Index of the second texture to compare.
+///
+/// @return  True if the first texture is less important than the second, false if not.
+bool TextureStreamingManager::PriorityCompare::operator()( size_t textureIndex0, size_t textureIndex1 ) const
+{
+	const Texture2d* pTexture0 = m_ppTextures[textureIndex0];
+	const Texture2d* pTexture1 = m_ppTextures[textureIndex1];
+
+	uint32_t age0 = m_frameIndex - pTexture0->m_lastRequestFrame;
+	uint32_t age1 = m_frameIndex - pTexture1->m_lastRequestFrame;
+	if ( age0 != age1 )
+	{
+		return ( age0 > age1 );
+	}
+
+	return ( pTexture0->m_requestedMipIndex > pTexture1->m_requestedMipIndex );
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	class Texture2d;
+
+	/// Manager for streaming texture mip levels in and out of memory.
+	///
+	/// Textures only load their least detailed mip levels when first loaded and register themselves with this manager.
+	/// During rendering, the graphics scene reports the most detailed mip level needed for each visible texture based
+	/// on its projected screen size (see RequestMipLevel()).  Each frame, Update() streams in the requested mip levels
+	/// while keeping the total memory used by streamed textures within the configured budget, evicting detail from the
+	/// least recently used textures first when over budget.
+	class HELIUM_GRAPHICS_API TextureStreamingManager : NonCopyable
+	{
+	public:
+		/// Mip levels this size or smaller (in both dimensions) are always kept resident.
+		static const uint32_t RESIDENT_MIP_SIZE_MAX = 64;
+		/// Maximum number of textures that can be streaming mip levels at once.
+		static const uint32_t STREAMING_TEXTURE_COUNT_MAX = 8;
+		/// Number of frames a mip level request remains in effect after a texture was last rendered.
+		static const uint32_t REQUEST_FRAME_COUNT = 30;
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Texture Registration
+		//@{
+		void RegisterTexture( Texture2d* pTexture );
+		void UnregisterTexture( Texture2d* pTexture );
+		//@}
+
+		/// @name Streaming
+		//@{
+		void RequestMipLevel( Texture2d* pTexture, uint32_t mipIndex );
+		void Update();
+
+		inline uint32_t GetFrameIndex() const;
+		inline size_t GetTextureCount() const;
+		inline size_t GetStreamingTextureCount() const;
+		//@}
+
+		/// @name Budget
+		//@{
+		void SetBudget( size_t budget );
+		inline size_t GetBudget() const;
+		inline size_t GetResidentSize() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static TextureStreamingManager* GetInstance();
+		static void Startup();
+		static void Shutdown();
+		//@}
+
+		/// @name Static Utility Functions
+		//@{
+		static uint32_t GetResidentMipIndexMin( uint32_t baseLevelWidth, uint32_t baseLevelHeight, uint32_t mipCount );
+		static uint32_t ComputeMipIndex( uint32_t textureSize, uint32_t mipCount, float32_t screenSize );
+		//@}
+
+	private:
+		/// Texture streaming priority comparison (sorts textures least important first).
+		class PriorityCompare
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			PriorityCompare();
+			PriorityCompare( Texture2d* const* ppTextures, uint32_t frameIndex );
+			//@}
+
+			/// @name Overloaded Operators
+			//@{
+			bool operator()( size_t textureIndex0, size_t textureIndex1 ) const;
+			//@}
+
+		private:
+			/// Registered textures.
+			Texture2d* const* m_ppTextures;
+			/// Current frame index.
+			uint32_t m_frameIndex;
+		};
+
+		/// Textures registered for streaming.
+		DynamicArray< Texture2d* > m_textures;
+		/// Target mip level for each registered texture (scratch buffer for Update()).
+		DynamicArray< uint32_t > m_targetMipIndices;
+		/// Texture indices sorted by streaming priority (scratch buffer for Update()).
+		DynamicArray< size_t > m_priorityIndices;
+
+		/// Maximum amount of memory to use for streamed texture mip levels, in bytes.
+		size_t m_budget;
+		/// Amount of memory used by currently resident mip levels, in bytes.
+		size_t m_residentSize;
+
+		/// Current frame index.
+		uint32_t m_frameIndex;
+		/// Number of textures currently streaming mip levels.
+		size_t m_streamingTextureCount;
+
+		/// Singleton instance.
+		static TextureStreamingManager* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		TextureStreamingManager();
+		~TextureStreamingManager();
+		//@}
+	};
+}
+
+#include "Graphics/TextureStreamingManager.inl"
@@ -0,0 +1,46 @@
+namespace Helium
+{
+	/// Get the index of the current streaming frame.  Mip level requests are tracked per frame.
+	///
+	/// @return  Current frame index.
+	uint32_t TextureStreamingManager::GetFrameIndex() const
+	{
+		return m_frameIndex;
+	}
+
+	/// Get the number of textures registered for mip streaming.
+	///
+	/// @return  Registered texture count.
+	size_t TextureStreamingManager::GetTextureCount() const
+	{
+		return m_textures.GetSize();
+	}
+
+	/// Get the number of textures currently streaming mip levels.
+	///
+	/// @return  Number of textures with mip streaming in progress.
+	size_t TextureStreamingManager::GetStreamingTextureCount() const
+	{
+		return m_streamingTextureCount;
+	}
+
+	/// Get the memory budget for streamed texture mip levels.
+	///
+	/// @return  Texture streaming budget, in bytes.
+	///
+	/// @see SetBudget(), GetResidentSize()
+	size_t TextureStreamingManager::GetBudget() const
+	{
+		return m_budget;
+	}
+
+	/// Get the amount of memory used by the resident mip levels of all registered textures, as of the last update.
+	///
+	/// @return  Resident texture memory, in bytes.
+	///
+	/// @see GetBudget()
+	size_t TextureStreamingManager::GetResidentSize() const
+	{
+		return m_residentSize;
+	}
+}
@@ -3,6 +3,7 @@
 #include "GraphicsJobs/GraphicsJobs.h"
 #include "Platform/Assert.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
+#include "GraphicsTypes/AnimationInstance.h"
 
 namespace Helium
 {
@@ -56,7 +57,7 @@ private:
     Parameters m_parameters;
 };
 
-/// Spawn jobs to update the constant buffer data for all graphics scene objects.
+/// Update the constant buffer data for all graphics scene objects in parallel.
 class HELIUM_GRAPHICS_JOBS_API UpdateGraphicsSceneObjectBuffersJobSpawner : Helium::NonCopyable
 {
 public:
@@ -99,7 +100,7 @@ private:
     Parameters m_parameters;
 };
 
-/// Spawn jobs to update the constant buffer data for all graphics scene object sub-meshes.
+/// Update the constant buffer data for all graphics scene object sub-meshes in parallel.
 class HELIUM_GRAPHICS_JOBS_API UpdateGraphicsSceneSubMeshBuffersJobSpawner : Helium::NonCopyable
 {
 public:
@@ -232,6 +233,88 @@ private:
     Parameters m_parameters;
 };
 
+/// Sample animation clips and update the bone palettes of all animation instances in parallel.
+class HELIUM_GRAPHICS_JOBS_API UpdateAnimationPosesJobSpawner : Helium::NonCopyable
+{
+public:
+    class Parameters
+    {
+    public:
+        /// [in] Number of elements in the animation instance array.
+        uint32_t instanceCount;
+        /// [in] Array of animation instances to update.
+        AnimationInstance* const* ppInstances;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline UpdateAnimationPosesJobSpawner();
+    inline ~UpdateAnimationPosesJobSpawner();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run();
+    inline static void RunCallback( void* pJob );
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
+/// Sample animation clips and update the bone palettes of a set of animation instances.
+class HELIUM_GRAPHICS_JOBS_API UpdateAnimationPosesJob : Helium::NonCopyable
+{
+public:
+    class Parameters
+    {
+    public:
+        /// [in] Number of elements in the animation instance array.
+        uint32_t instanceCount;
+        /// [in] Array of animation instances to update.
+        AnimationInstance* const* ppInstances;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline UpdateAnimationPosesJob();
+    inline ~UpdateAnimationPosesJob();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run();
+    inline static void RunCallback( void* pJob );
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
 }  // namespace Helium
 
 #include "GraphicsJobs/GraphicsJobsInterface.inl"
@@ -276,5 +276,113 @@ namespace Helium
 	{
 	}
 
+	/// Constructor.
+	UpdateAnimationPosesJobSpawner::UpdateAnimationPosesJobSpawner()
+	{
+	}
+
+	/// Destructor.
+	UpdateAnimationPosesJobSpawner::~UpdateAnimationPosesJobSpawner()
+	{
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	UpdateAnimationPosesJobSpawner::Parameters& UpdateAnimationPosesJobSpawner::GetParameters()
+	{
+		return m_parameters;
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Constant reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	const UpdateAnimationPosesJobSpawner::Parameters& UpdateAnimationPosesJobSpawner::GetParameters() const
+	{
+		return m_parameters;
+	}
+
+	/// Set the job parameters.
+	///
+	/// @param[in] rParameters  MetaStruct containing the job parameters.
+	///
+	/// @see GetParameters()
+	void UpdateAnimationPosesJobSpawner::SetParameters( const Parameters& rParameters )
+	{
+		m_parameters = rParameters;
+	}
+
+	/// Callback executed to run the job.
+	///
+	/// @param[in] pJob  Job to run.
+	void UpdateAnimationPosesJobSpawner::RunCallback( void* pJob )
+	{
+		HELIUM_ASSERT( pJob );
+		static_cast< UpdateAnimationPosesJobSpawner* >( pJob )->Run();
+	}
+
+	/// Constructor.
+	UpdateAnimationPosesJobSpawner::Parameters::Parameters()
+	{
+	}
+
+	/// Constructor.
+	UpdateAnimationPosesJob::UpdateAnimationPosesJob()
+	{
+	}
+
+	/// Destructor.
+	UpdateAnimationPosesJob::~UpdateAnimationPosesJob()
+	{
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	UpdateAnimationPosesJob::Parameters& UpdateAnimationPosesJob::GetParameters()
+	{
+		return m_parameters;
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Constant reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	const UpdateAnimationPosesJob::Parameters& UpdateAnimationPosesJob::GetParameters() const
+	{
+		return m_parameters;
+	}
+
+	/// Set the job parameters.
+	///
+	/// @param[in] rParameters  MetaStruct containing the job parameters.
+	///
+	/// @see GetParameters()
+	void UpdateAnimationPosesJob::SetParameters( const Parameters& rParameters )
+	{
+		m_parameters = rParameters;
+	}
+
+	/// Callback executed to run the job.
+	///
+	/// @param[in] pJob  Job to run.
+	void UpdateAnimationPosesJob::RunCallback( void* pJob )
+	{
+		HELIUM_ASSERT( pJob );
+		static_cast< UpdateAnimationPosesJob* >( pJob )->Run();
+	}
+
+	/// Constructor.
+	UpdateAnimationPosesJob::Parameters::Parameters()
+	{
+	}
+
 }  // namespace Helium
 
@@ -0,0 +1,20 @@
+#include "Precompile.h"
+#include "GraphicsJobs/GraphicsJobsInterface.h"
+
+namespace Helium
+{
+    /// Sample, blend, and compute the bone palettes for a set of animation instances.
+    void UpdateAnimationPosesJob::Run()
+    {
+        AnimationInstance* const* ppInstances = m_parameters.ppInstances;
+        HELIUM_ASSERT( ppInstances || m_parameters.instanceCount == 0 );
+
+        uint_fast32_t instanceCount = m_parameters.instanceCount;
+        for( uint_fast32_t instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex )
+        {
+            AnimationInstance* pInstance = ppInstances[ instanceIndex ];
+            HELIUM_ASSERT( pInstance );
+            pInstance->Update();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include "Precompile.h"
+#include "GraphicsJobs/GraphicsJobsInterface.h"
+
+#include "EngineJobs/JobManager.h"
+
+/// Minimum number of animation instances worth updating in a separate job.
+static const uint_fast32_t ANIMATION_JOB_INSTANCE_COUNT_MIN = 4;
+/// Number of jobs to split the update into for each thread that can run them (skeletons vary in size, so splitting the
+/// work more finely than the thread count helps balance the load).
+static const size_t ANIMATION_JOBS_PER_THREAD = 4;
+/// Maximum number of jobs to split the update across.
+static const size_t ANIMATION_JOB_COUNT_MAX =
+    ( Helium::JobManager::WORKER_COUNT_MAX + 1 ) * ANIMATION_JOBS_PER_THREAD;
+
+using namespace Helium;
+
+/// Update all animation instances, splitting the instances into ranges updated in parallel by the job manager worker
+/// threads.
+///
+/// The bone hierarchy of a single skeleton has to be walked in order, so work is distributed across instances rather
+/// than across the bones of each instance.
+void UpdateAnimationPosesJobSpawner::Run()
+{
+    uint_fast32_t instanceCount = m_parameters.instanceCount;
+    if( instanceCount == 0 )
+    {
+        return;
+    }
+
+    AnimationInstance* const* ppInstances = m_parameters.ppInstances;
+    HELIUM_ASSERT( ppInstances );
+
+    size_t jobCount = ( instanceCount + ANIMATION_JOB_INSTANCE_COUNT_MIN - 1 ) / ANIMATION_JOB_INSTANCE_COUNT_MIN;
+    jobCount = Min( jobCount, static_cast< size_t >( JobManager::GetConcurrency() ) * ANIMATION_JOBS_PER_THREAD );
+    jobCount = Clamp< size_t >( jobCount, 1, ANIMATION_JOB_COUNT_MAX );
+
+    uint_fast32_t jobInstanceCount = static_cast< uint_fast32_t >( ( instanceCount + jobCount - 1 ) / jobCount );
+    jobCount = ( instanceCount + jobInstanceCount - 1 ) / jobInstanceCount;
+
+    UpdateAnimationPosesJob jobs[ ANIMATION_JOB_COUNT_MAX ];
+    for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+    {
+        uint_fast32_t startIndex = static_cast< uint_fast32_t >( jobIndex * jobInstanceCount );
+
+        UpdateAnimationPosesJob::Parameters& rParameters = jobs[ jobIndex ].GetParameters();
+        rParameters.instanceCount = static_cast< uint32_t >( Min( jobInstanceCount, instanceCount - startIndex ) );
+        rParameters.ppInstances = ppInstances + startIndex;
+    }
+
+    JobManager::Run( jobs, jobCount );
+}
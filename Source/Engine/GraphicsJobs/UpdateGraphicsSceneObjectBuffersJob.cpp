@@ -32,6 +32,14 @@ namespace Helium
             const Simd::Matrix44& rTransform = rSceneObject.GetTransform();
 
             // Transpose the matrix when loading into the constant buffer for proper interpretation by the shader.
+#if HELIUM_SIMD_SIZE == 16
+            Simd::Matrix44 transposedTransform;
+            rTransform.GetTranspose( transposedTransform );
+
+            Simd::StoreUnaligned( pConstantBuffer, transposedTransform.GetSimdVector( 0 ) );
+            Simd::StoreUnaligned( pConstantBuffer + 4, transposedTransform.GetSimdVector( 1 ) );
+            Simd::StoreUnaligned( pConstantBuffer + 8, transposedTransform.GetSimdVector( 2 ) );
+#else
             *( pConstantBuffer++ ) = rTransform.GetElement( 0 );
             *( pConstantBuffer++ ) = rTransform.GetElement( 4 );
             *( pConstantBuffer++ ) = rTransform.GetElement( 8 );
@@ -44,6 +52,7 @@ namespace Helium
             *( pConstantBuffer++ ) = rTransform.GetElement( 6 );
             *( pConstantBuffer++ ) = rTransform.GetElement( 10 );
             *pConstantBuffer       = rTransform.GetElement( 14 );
+#endif
         }
     }
 }
@@ -1,58 +1,51 @@
 #include "Precompile.h"
 #include "GraphicsJobs/GraphicsJobsInterface.h"
 
-/// Maximum number of child jobs to spawn at once.
-static const uint_fast32_t SCENE_OBJECT_CHILD_JOB_MAX = 128;
-/// Maximum number of graphics scene objects to update in each child job.
-static const uint_fast32_t SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX = 100;
+#include "EngineJobs/JobManager.h"
 
+/// Minimum number of graphics scene objects worth updating in a separate job.
+static const uint_fast32_t SCENE_OBJECT_JOB_OBJECT_COUNT_MIN = 128;
+/// Number of jobs to split the update into for each thread that can run them (splitting the work more finely than
+/// the thread count helps balance the load, as objects not drawn in the current frame are skipped).
+static const size_t SCENE_OBJECT_JOBS_PER_THREAD = 4;
+/// Maximum number of jobs to split the update across.
+static const size_t SCENE_OBJECT_JOB_COUNT_MAX =
+    ( Helium::JobManager::WORKER_COUNT_MAX + 1 ) * SCENE_OBJECT_JOBS_PER_THREAD;
 
 using namespace Helium;
 
-/// Spawn jobs to update the constant buffer data for all graphics scene objects.
+/// Update the constant buffer data for all graphics scene objects, splitting the scene objects into ranges updated in
+/// parallel by the job manager worker threads.
 void UpdateGraphicsSceneObjectBuffersJobSpawner::Run()
 {
+    uint_fast32_t sceneObjectCount = m_parameters.sceneObjectCount;
+    if( sceneObjectCount == 0 )
+    {
+        return;
+    }
 
     const GraphicsSceneObject* pSceneObjects = m_parameters.pSceneObjects;
     float32_t* const* ppConstantBufferData = m_parameters.ppConstantBufferData;
+    HELIUM_ASSERT( pSceneObjects );
+    HELIUM_ASSERT( ppConstantBufferData );
 
-    uint_fast32_t sceneObjectCount = m_parameters.sceneObjectCount;
+    size_t jobCount = ( sceneObjectCount + SCENE_OBJECT_JOB_OBJECT_COUNT_MIN - 1 ) / SCENE_OBJECT_JOB_OBJECT_COUNT_MIN;
+    jobCount = Min( jobCount, static_cast< size_t >( JobManager::GetConcurrency() ) * SCENE_OBJECT_JOBS_PER_THREAD );
+    jobCount = Clamp< size_t >( jobCount, 1, SCENE_OBJECT_JOB_COUNT_MAX );
 
-    uint_fast32_t jobCount = ( sceneObjectCount + SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX - 1 ) /
-        SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX;
-    if( jobCount > SCENE_OBJECT_CHILD_JOB_MAX )
-    {
-        jobCount = SCENE_OBJECT_CHILD_JOB_MAX;
-    }
+    uint_fast32_t jobObjectCount = static_cast< uint_fast32_t >( ( sceneObjectCount + jobCount - 1 ) / jobCount );
+    jobCount = ( sceneObjectCount + jobObjectCount - 1 ) / jobObjectCount;
 
+    UpdateGraphicsSceneObjectBuffersJob jobs[ SCENE_OBJECT_JOB_COUNT_MAX ];
+    for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
     {
-        for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
-        {
-            uint_fast32_t jobObjectCount = Min( sceneObjectCount, SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX );
-            HELIUM_ASSERT( jobObjectCount != 0 );
-            sceneObjectCount -= jobObjectCount;
-
-			// NOTE: These were run in parallel but now synchronous since TBB has been removed
-			UpdateGraphicsSceneObjectBuffersJob job;
-            UpdateGraphicsSceneObjectBuffersJob::Parameters& rParameters = job.GetParameters();
-            rParameters.sceneObjectCount = static_cast< uint32_t >( jobObjectCount );
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-
-            pSceneObjects += jobObjectCount;
-            ppConstantBufferData += jobObjectCount;
-        }
-
-		// This was a continuation task but now just exectues inline here since TBB was removed
-        if( sceneObjectCount != 0 )
-        {
-			UpdateGraphicsSceneObjectBuffersJobSpawner job;
-            UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters& rParameters = job.GetParameters();
-            rParameters.sceneObjectCount = sceneObjectCount;
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-        }
+        uint_fast32_t startIndex = static_cast< uint_fast32_t >( jobIndex * jobObjectCount );
+
+        UpdateGraphicsSceneObjectBuffersJob::Parameters& rParameters = jobs[ jobIndex ].GetParameters();
+        rParameters.sceneObjectCount = static_cast< uint32_t >( Min( jobObjectCount, sceneObjectCount - startIndex ) );
+        rParameters.pSceneObjects = pSceneObjects + startIndex;
+        rParameters.ppConstantBufferData = ppConstantBufferData + startIndex;
     }
+
+    JobManager::Run( jobs, jobCount );
 }
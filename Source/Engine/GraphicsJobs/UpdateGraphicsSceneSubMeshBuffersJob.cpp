@@ -2,6 +2,7 @@
 #include "GraphicsJobs/GraphicsJobsInterface.h"
 
 #include "GraphicsTypes/VertexTypes.h"
+#include "MathSimd/Matrix44Soa.h"
 
 #if HELIUM_USE_GRANNY_ANIMATION
 #include "GrannySceneObjectInterface.h"
@@ -9,6 +10,63 @@
 
 using namespace Helium;
 
+#if HELIUM_SIMD_SSE
+/// Number of bones for which skinning matrices are computed at once (one per SIMD lane).
+static const size_t SKINNING_BONE_BATCH_SIZE = 4;
+
+/// Compute and store the skinning matrices for a batch of bones.
+///
+/// @param[in] ppInverseReferencePoses  Inverse reference pose transform of each bone.
+/// @param[in] ppBoneTransforms         Current transform of each bone.
+/// @param[in] ppSkinningMatrices       Constant buffer address at which to store the transposed 4x3 skinning matrix
+///                                     for each bone.
+/// @param[in] boneCount                Number of bones in the batch (no more than SKINNING_BONE_BATCH_SIZE).
+static void ComputeSkinningMatrices(
+    const Simd::Matrix44* const* ppInverseReferencePoses,
+    const Simd::Matrix44* const* ppBoneTransforms,
+    float32_t* const* ppSkinningMatrices,
+    size_t boneCount )
+{
+    HELIUM_ASSERT( boneCount != 0 );
+    HELIUM_ASSERT( boneCount <= SKINNING_BONE_BATCH_SIZE );
+
+    // Fill any unused lanes by repeating the first bone, discarding the results.
+    float32_t unusedSkinningMatrix[ 12 ];
+
+    const Simd::Matrix44* pInverseReferencePoses[ SKINNING_BONE_BATCH_SIZE ];
+    const Simd::Matrix44* pBoneTransforms[ SKINNING_BONE_BATCH_SIZE ];
+    float32_t* pSkinningMatrices[ SKINNING_BONE_BATCH_SIZE ];
+    for( size_t laneIndex = 0; laneIndex < SKINNING_BONE_BATCH_SIZE; ++laneIndex )
+    {
+        bool bUsed = ( laneIndex < boneCount );
+        size_t boneIndex = ( bUsed ? laneIndex : 0 );
+        pInverseReferencePoses[ laneIndex ] = ppInverseReferencePoses[ boneIndex ];
+        pBoneTransforms[ laneIndex ] = ppBoneTransforms[ boneIndex ];
+        pSkinningMatrices[ laneIndex ] = ( bUsed ? ppSkinningMatrices[ laneIndex ] : unusedSkinningMatrix );
+    }
+
+    Simd::Matrix44Soa inverseReferencePoses;
+    inverseReferencePoses.Gather(
+        *pInverseReferencePoses[ 0 ],
+        *pInverseReferencePoses[ 1 ],
+        *pInverseReferencePoses[ 2 ],
+        *pInverseReferencePoses[ 3 ] );
+
+    Simd::Matrix44Soa boneTransforms;
+    boneTransforms.Gather( *pBoneTransforms[ 0 ], *pBoneTransforms[ 1 ], *pBoneTransforms[ 2 ], *pBoneTransforms[ 3 ] );
+
+    Simd::Matrix44Soa skinningMatrices;
+    skinningMatrices.MultiplySet( inverseReferencePoses, boneTransforms );
+
+    // Transpose the matrices when storing into the constant buffer for proper interpretation by the shader.
+    skinningMatrices.ScatterTransposed43(
+        pSkinningMatrices[ 0 ],
+        pSkinningMatrices[ 1 ],
+        pSkinningMatrices[ 2 ],
+        pSkinningMatrices[ 3 ] );
+}
+#endif  // HELIUM_SIMD_SSE
+
 /// Update the instance buffer data for a set of graphics scene object sub-meshes.
 ///
 /// @param[in] pContext  Context in which this job is running.
@@ -44,8 +102,6 @@ void UpdateGraphicsSceneSubMeshBuffersJob::Run()
 #if HELIUM_USE_GRANNY_ANIMATION
         const void* pBoneData = rSceneObject.GetBoneData();
         HELIUM_ASSERT( pBoneData );
-
-        Simd::Matrix44 inverseBoneReferencePose;
 #else
         const Simd::Matrix44* pInverseReferencePose = rSceneObject.GetInverseReferencePose();
         HELIUM_ASSERT( pInverseReferencePose );
@@ -54,6 +110,59 @@ void UpdateGraphicsSceneSubMeshBuffersJob::Run()
         const uint8_t* pSkinningPaletteMap = rSubMesh.GetSkinningPaletteMap();
         HELIUM_ASSERT( pSkinningPaletteMap );
 
+#if HELIUM_SIMD_SSE
+        // Gather bones into batches so that their skinning matrices can be computed in parallel.
+#if HELIUM_USE_GRANNY_ANIMATION
+        Simd::Matrix44 inverseBoneReferencePoses[ SKINNING_BONE_BATCH_SIZE ];
+#endif
+        const Simd::Matrix44* batchInverseReferencePoses[ SKINNING_BONE_BATCH_SIZE ];
+        const Simd::Matrix44* batchBoneTransforms[ SKINNING_BONE_BATCH_SIZE ];
+        float32_t* batchSkinningMatrices[ SKINNING_BONE_BATCH_SIZE ];
+        size_t batchBoneCount = 0;
+
+        uint_fast8_t boneCount = rSceneObject.GetBoneCount();
+        for( uint_fast8_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+        {
+            size_t skinningPaletteIndex = pSkinningPaletteMap[ boneIndex ];
+            if( skinningPaletteIndex >= BONE_COUNT_MAX )
+            {
+                continue;
+            }
+
+#if HELIUM_USE_GRANNY_ANIMATION
+            Granny::GetInverseBoneReferencePose( inverseBoneReferencePoses[ batchBoneCount ], pBoneData, boneIndex );
+            batchInverseReferencePoses[ batchBoneCount ] = &inverseBoneReferencePoses[ batchBoneCount ];
+#else
+            batchInverseReferencePoses[ batchBoneCount ] = &pInverseReferencePose[ boneIndex ];
+#endif
+            batchBoneTransforms[ batchBoneCount ] = &pBonePalette[ boneIndex ];
+            batchSkinningMatrices[ batchBoneCount ] = pConstantBuffer + skinningPaletteIndex * 12;
+
+            ++batchBoneCount;
+            if( batchBoneCount == SKINNING_BONE_BATCH_SIZE )
+            {
+                ComputeSkinningMatrices(
+                    batchInverseReferencePoses,
+                    batchBoneTransforms,
+                    batchSkinningMatrices,
+                    batchBoneCount );
+                batchBoneCount = 0;
+            }
+        }
+
+        if( batchBoneCount != 0 )
+        {
+            ComputeSkinningMatrices(
+                batchInverseReferencePoses,
+                batchBoneTransforms,
+                batchSkinningMatrices,
+                batchBoneCount );
+        }
+#else  // HELIUM_SIMD_SSE
+#if HELIUM_USE_GRANNY_ANIMATION
+        Simd::Matrix44 inverseBoneReferencePose;
+#endif
+
         Simd::Matrix44 skinningMatrix;
 
         uint_fast8_t boneCount = rSceneObject.GetBoneCount();
@@ -89,5 +198,6 @@ void UpdateGraphicsSceneSubMeshBuffersJob::Run()
             *( pSkinningMatrix43++ ) = skinningMatrix.GetElement( 10 );
             *pSkinningMatrix43       = skinningMatrix.GetElement( 14 );
         }
+#endif  // HELIUM_SIMD_SSE
     }
 }
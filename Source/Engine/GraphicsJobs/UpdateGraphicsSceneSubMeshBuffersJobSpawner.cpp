@@ -1,63 +1,53 @@
 #include "Precompile.h"
 #include "GraphicsJobs/GraphicsJobsInterface.h"
 
-/// Maximum number of child jobs to spawn at once.
-static const uint_fast32_t SUB_MESH_CHILD_JOB_MAX = 128;
-/// Maximum number of sub-meshes to update in each child job.
-static const uint_fast32_t SUB_MESH_CHILD_JOB_OBJECT_COUNT_MAX = 100;
+#include "EngineJobs/JobManager.h"
+
+/// Minimum number of sub-meshes worth updating in a separate job.
+static const uint_fast32_t SUB_MESH_JOB_SUB_MESH_COUNT_MIN = 32;
+/// Number of jobs to split the update into for each thread that can run them (splitting the work more finely than
+/// the thread count helps balance the load, as only skinned sub-meshes have data to update).
+static const size_t SUB_MESH_JOBS_PER_THREAD = 4;
+/// Maximum number of jobs to split the update across.
+static const size_t SUB_MESH_JOB_COUNT_MAX = ( Helium::JobManager::WORKER_COUNT_MAX + 1 ) * SUB_MESH_JOBS_PER_THREAD;
 
 using namespace Helium;
 
-/// Spawn jobs to update the constant buffer data for all graphics scene object sub-meshes.
-///
-/// @param[in] pContext  Context in which this job is running.
+/// Update the constant buffer data for all graphics scene object sub-meshes, splitting the sub-meshes into ranges
+/// updated in parallel by the job manager worker threads.
 void UpdateGraphicsSceneSubMeshBuffersJobSpawner::Run()
 {
+    uint_fast32_t subMeshCount = m_parameters.subMeshCount;
+    if( subMeshCount == 0 )
+    {
+        return;
+    }
+
     const GraphicsSceneObject::SubMeshData* pSubMeshes = m_parameters.pSubMeshes;
+    const GraphicsSceneObject* pSceneObjects = m_parameters.pSceneObjects;
     float32_t* const* ppConstantBufferData = m_parameters.ppConstantBufferData;
+    HELIUM_ASSERT( pSubMeshes );
+    HELIUM_ASSERT( pSceneObjects );
+    HELIUM_ASSERT( ppConstantBufferData );
 
-    const GraphicsSceneObject* pSceneObjects = m_parameters.pSceneObjects;
+    size_t jobCount = ( subMeshCount + SUB_MESH_JOB_SUB_MESH_COUNT_MIN - 1 ) / SUB_MESH_JOB_SUB_MESH_COUNT_MIN;
+    jobCount = Min( jobCount, static_cast< size_t >( JobManager::GetConcurrency() ) * SUB_MESH_JOBS_PER_THREAD );
+    jobCount = Clamp< size_t >( jobCount, 1, SUB_MESH_JOB_COUNT_MAX );
 
-    uint_fast32_t subMeshCount = m_parameters.subMeshCount;
+    uint_fast32_t jobSubMeshCount = static_cast< uint_fast32_t >( ( subMeshCount + jobCount - 1 ) / jobCount );
+    jobCount = ( subMeshCount + jobSubMeshCount - 1 ) / jobSubMeshCount;
 
-    uint_fast32_t jobCount = ( subMeshCount + SUB_MESH_CHILD_JOB_OBJECT_COUNT_MAX - 1 ) /
-        SUB_MESH_CHILD_JOB_OBJECT_COUNT_MAX;
-    if( jobCount > SUB_MESH_CHILD_JOB_MAX )
+    UpdateGraphicsSceneSubMeshBuffersJob jobs[ SUB_MESH_JOB_COUNT_MAX ];
+    for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
     {
-        jobCount = SUB_MESH_CHILD_JOB_MAX;
-    }
+        uint_fast32_t startIndex = static_cast< uint_fast32_t >( jobIndex * jobSubMeshCount );
 
-    {
-        for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
-        {
-			// These were all in parallel but TBB was removed
-            uint_fast32_t jobObjectCount = Min( subMeshCount, SUB_MESH_CHILD_JOB_OBJECT_COUNT_MAX );
-            HELIUM_ASSERT( jobObjectCount != 0 );
-            subMeshCount -= jobObjectCount;
-
-			UpdateGraphicsSceneSubMeshBuffersJob job;
-            UpdateGraphicsSceneSubMeshBuffersJob::Parameters& rParameters = job.GetParameters();
-            rParameters.subMeshCount = static_cast< uint32_t >( jobObjectCount );
-            rParameters.pSubMeshes = pSubMeshes;
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-
-            pSubMeshes += jobObjectCount;
-            ppConstantBufferData += jobObjectCount;
-        }
-
-        if( subMeshCount != 0 )
-        {
-			// NOTE: This was a continuation job from above but is now inline since TBB was removed
-			UpdateGraphicsSceneSubMeshBuffersJobSpawner job;
-            UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters& rParameters =
-                job.GetParameters();
-            rParameters.subMeshCount = subMeshCount;
-            rParameters.pSubMeshes = pSubMeshes;
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-        }
+        UpdateGraphicsSceneSubMeshBuffersJob::Parameters& rParameters = jobs[ jobIndex ].GetParameters();
+        rParameters.subMeshCount = static_cast< uint32_t >( Min( jobSubMeshCount, subMeshCount - startIndex ) );
+        rParameters.pSubMeshes = pSubMeshes + startIndex;
+        rParameters.pSceneObjects = pSceneObjects;
+        rParameters.ppConstantBufferData = ppConstantBufferData + startIndex;
     }
+
+    JobManager::Run( jobs, jobCount );
 }
@@ -0,0 +1,340 @@
+#include "Precompile.h"
+#include "GraphicsTypes/AnimationClipData.h"
+
+#include "GraphicsTypes/AnimationPose.h"
+
+using namespace Helium;
+
+/// Largest magnitude of any of the three smallest components of a unit quaternion (1 / sqrt( 2 )).
+static const float32_t ROTATION_COMPONENT_MAX = 0.70710678f;
+/// Maximum quantized rotation component value.
+static const uint16_t ROTATION_QUANTIZED_MAX = 0x7fff;
+/// Maximum quantized vector component value.
+static const uint16_t VECTOR_QUANTIZED_MAX = 0xffff;
+
+/// Find the keys of a track bracketing a given sample position.
+///
+/// @param[in]  pKeySamples     Source sample index of each key in the track.
+/// @param[in]  keyCount        Number of keys in the track.
+/// @param[in]  samplePosition  Sample position (fractional sample index).
+/// @param[out] rKeyIndex0      Index of the last key at or before the sample position.
+/// @param[out] rKeyIndex1      Index of the first key after the sample position (or the last key if the position is at
+///                             or past the end of the track).
+/// @param[out] rWeight         Interpolation weight between the two keys.
+static void FindBracketingKeys(
+    const uint16_t* pKeySamples,
+    uint32_t keyCount,
+    float32_t samplePosition,
+    uint32_t& rKeyIndex0,
+    uint32_t& rKeyIndex1,
+    float32_t& rWeight )
+{
+    HELIUM_ASSERT( pKeySamples );
+    HELIUM_ASSERT( keyCount != 0 );
+
+    uint32_t lowIndex = 0;
+    uint32_t highIndex = keyCount - 1;
+    if( samplePosition >= static_cast< float32_t >( pKeySamples[ highIndex ] ) )
+    {
+        rKeyIndex0 = highIndex;
+        rKeyIndex1 = highIndex;
+        rWeight = 0.0f;
+
+        return;
+    }
+
+    // Find the last key whose sample index is not past the sample position.
+    while( highIndex - lowIndex > 1 )
+    {
+        uint32_t middleIndex = ( lowIndex + highIndex ) / 2;
+        if( static_cast< float32_t >( pKeySamples[ middleIndex ] ) <= samplePosition )
+        {
+            lowIndex = middleIndex;
+        }
+        else
+        {
+            highIndex = middleIndex;
+        }
+    }
+
+    float32_t sample0 = static_cast< float32_t >( pKeySamples[ lowIndex ] );
+    float32_t sample1 = static_cast< float32_t >( pKeySamples[ highIndex ] );
+
+    rKeyIndex0 = lowIndex;
+    rKeyIndex1 = highIndex;
+    rWeight = Clamp( ( samplePosition - sample0 ) / ( sample1 - sample0 ), 0.0f, 1.0f );
+}
+
+/// Constructor.
+AnimationClipData::AnimationClipData()
+: sampleRate( 0.0f )
+, sampleCount( 0 )
+, trackCount( 0 )
+, pKeyOffsets( NULL )
+, pKeySamples( NULL )
+, pRotationKeys( NULL )
+, pTranslationKeys( NULL )
+, pScaleKeys( NULL )
+, pTranslationRanges( NULL )
+, pScaleRanges( NULL )
+{
+}
+
+/// Sample this clip into a local-space pose.
+///
+/// Keys for each animated bone are decoded a block of bones at a time and interpolated using
+/// AnimationPose::InterpolateBlock().  Bones that are not animated by this clip keep their reference pose transform.
+///
+/// @param[in]  time               Sample time, in seconds.
+/// @param[in]  bLoop              True to wrap the sample time around the clip duration, false to clamp it.
+/// @param[in]  pBoneTrackIndices  Index of the track animating each bone in the pose (invalid for bones not animated
+///                                by this clip).
+/// @param[in]  rReferencePose     Reference pose from which to take the transforms of bones that are not animated.
+/// @param[out] rPose              Sampled pose.
+void AnimationClipData::Sample(
+    float32_t time,
+    bool bLoop,
+    const uint16_t* pBoneTrackIndices,
+    const AnimationPose& rReferencePose,
+    AnimationPose& rPose ) const
+{
+    HELIUM_ASSERT( pBoneTrackIndices || rReferencePose.GetBoneCount() == 0 );
+
+    rPose.CopyFrom( rReferencePose );
+    if( trackCount == 0 || sampleCount == 0 )
+    {
+        return;
+    }
+
+    float32_t duration = GetDuration();
+    if( bLoop && duration > 0.0f )
+    {
+        time -= Floor( time / duration ) * duration;
+    }
+
+    float32_t samplePosition = Clamp( time * sampleRate, 0.0f, static_cast< float32_t >( sampleCount - 1 ) );
+
+    AnimationPose::Block keyBlock0;
+    AnimationPose::Block keyBlock1;
+    HELIUM_SIMD_ALIGN_PRE float32_t weights[ AnimationPose::BLOCK_BONE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+
+    Simd::Quat rotation;
+    Simd::Vector3 translation;
+    Simd::Vector3 scale;
+
+    size_t boneCount = rPose.GetBoneCount();
+    size_t blockCount = rPose.GetBlockCount();
+    AnimationPose::Block* pBlocks = rPose.GetBlocks();
+    for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        AnimationPose::Block& rBlock = pBlocks[ blockIndex ];
+        keyBlock0 = rBlock;
+        keyBlock1 = rBlock;
+
+        bool bAnyAnimated = false;
+
+        size_t boneBase = blockIndex * AnimationPose::BLOCK_BONE_COUNT;
+        for( size_t laneIndex = 0; laneIndex < AnimationPose::BLOCK_BONE_COUNT; ++laneIndex )
+        {
+            weights[ laneIndex ] = 0.0f;
+
+            size_t boneIndex = boneBase + laneIndex;
+            if( boneIndex >= boneCount )
+            {
+                continue;
+            }
+
+            uint16_t trackIndex = pBoneTrackIndices[ boneIndex ];
+            if( IsInvalid( trackIndex ) )
+            {
+                continue;
+            }
+
+            HELIUM_ASSERT( trackIndex < trackCount );
+
+            uint32_t keyOffset = pKeyOffsets[ trackIndex ];
+            uint32_t keyCount = pKeyOffsets[ trackIndex + 1 ] - keyOffset;
+            if( keyCount == 0 )
+            {
+                continue;
+            }
+
+            uint32_t keyIndex0, keyIndex1;
+            FindBracketingKeys( pKeySamples + keyOffset, keyCount, samplePosition, keyIndex0, keyIndex1, weights[ laneIndex ] );
+            keyIndex0 += keyOffset;
+            keyIndex1 += keyOffset;
+
+            const float32_t* pTranslationRange = pTranslationRanges + trackIndex * RANGE_FLOAT_COUNT;
+            const float32_t* pScaleRange = pScaleRanges + trackIndex * RANGE_FLOAT_COUNT;
+
+            UnpackRotation( pRotationKeys + keyIndex0 * KEY_CHANNEL_WORD_COUNT, rotation );
+            DequantizeVector( pTranslationKeys + keyIndex0 * KEY_CHANNEL_WORD_COUNT, pTranslationRange, translation );
+            DequantizeVector( pScaleKeys + keyIndex0 * KEY_CHANNEL_WORD_COUNT, pScaleRange, scale );
+
+            keyBlock0.rotationX[ laneIndex ] = rotation.GetElement( 0 );
+            keyBlock0.rotationY[ laneIndex ] = rotation.GetElement( 1 );
+            keyBlock0.rotationZ[ laneIndex ] = rotation.GetElement( 2 );
+            keyBlock0.rotationW[ laneIndex ] = rotation.GetElement( 3 );
+            keyBlock0.translationX[ laneIndex ] = translation.GetElement( 0 );
+            keyBlock0.translationY[ laneIndex ] = translation.GetElement( 1 );
+            keyBlock0.translationZ[ laneIndex ] = translation.GetElement( 2 );
+            keyBlock0.scaleX[ laneIndex ] = scale.GetElement( 0 );
+            keyBlock0.scaleY[ laneIndex ] = scale.GetElement( 1 );
+            keyBlock0.scaleZ[ laneIndex ] = scale.GetElement( 2 );
+
+            if( keyIndex1 != keyIndex0 )
+            {
+                UnpackRotation( pRotationKeys + keyIndex1 * KEY_CHANNEL_WORD_COUNT, rotation );
+                DequantizeVector( pTranslationKeys + keyIndex1 * KEY_CHANNEL_WORD_COUNT, pTranslationRange, translation );
+                DequantizeVector( pScaleKeys + keyIndex1 * KEY_CHANNEL_WORD_COUNT, pScaleRange, scale );
+            }
+
+            keyBlock1.rotationX[ laneIndex ] = rotation.GetElement( 0 );
+            keyBlock1.rotationY[ laneIndex ] = rotation.GetElement( 1 );
+            keyBlock1.rotationZ[ laneIndex ] = rotation.GetElement( 2 );
+            keyBlock1.rotationW[ laneIndex ] = rotation.GetElement( 3 );
+            keyBlock1.translationX[ laneIndex ] = translation.GetElement( 0 );
+            keyBlock1.translationY[ laneIndex ] = translation.GetElement( 1 );
+            keyBlock1.translationZ[ laneIndex ] = translation.GetElement( 2 );
+            keyBlock1.scaleX[ laneIndex ] = scale.GetElement( 0 );
+            keyBlock1.scaleY[ laneIndex ] = scale.GetElement( 1 );
+            keyBlock1.scaleZ[ laneIndex ] = scale.GetElement( 2 );
+
+            bAnyAnimated = true;
+        }
+
+        if( bAnyAnimated )
+        {
+            AnimationPose::InterpolateBlock( keyBlock0, keyBlock1, weights, rBlock );
+        }
+    }
+}
+
+/// Pack a unit quaternion into 48 bits.
+///
+/// @param[in]  rRotation  Rotation to pack (must be normalized).
+/// @param[out] pPacked    Packed rotation (KEY_CHANNEL_WORD_COUNT words).
+///
+/// @see UnpackRotation()
+void AnimationClipData::PackRotation( const Simd::Quat& rRotation, uint16_t* pPacked )
+{
+    HELIUM_ASSERT( pPacked );
+
+    size_t largestIndex = 0;
+    float32_t largestMagnitude = Abs( rRotation.GetElement( 0 ) );
+    for( size_t componentIndex = 1; componentIndex < 4; ++componentIndex )
+    {
+        float32_t magnitude = Abs( rRotation.GetElement( componentIndex ) );
+        if( magnitude > largestMagnitude )
+        {
+            largestIndex = componentIndex;
+            largestMagnitude = magnitude;
+        }
+    }
+
+    // q and -q represent the same rotation, so flip the quaternion to make the dropped component positive.
+    float32_t sign = ( rRotation.GetElement( largestIndex ) < 0.0f ? -1.0f : 1.0f );
+
+    uint16_t quantized[ 3 ];
+    size_t quantizedIndex = 0;
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        if( componentIndex == largestIndex )
+        {
+            continue;
+        }
+
+        float32_t component = Clamp(
+            rRotation.GetElement( componentIndex ) * sign, -ROTATION_COMPONENT_MAX, ROTATION_COMPONENT_MAX );
+        float32_t normalized = component * ( 0.5f / ROTATION_COMPONENT_MAX ) + 0.5f;
+        quantized[ quantizedIndex ] = static_cast< uint16_t >(
+            normalized * static_cast< float32_t >( ROTATION_QUANTIZED_MAX ) + 0.5f );
+        ++quantizedIndex;
+    }
+
+    pPacked[ 0 ] = static_cast< uint16_t >( quantized[ 0 ] | ( ( largestIndex >> 1 ) << 15 ) );
+    pPacked[ 1 ] = static_cast< uint16_t >( quantized[ 1 ] | ( ( largestIndex & 1 ) << 15 ) );
+    pPacked[ 2 ] = quantized[ 2 ];
+}
+
+/// Unpack a rotation packed using PackRotation().
+///
+/// @param[in]  pPacked    Packed rotation (KEY_CHANNEL_WORD_COUNT words).
+/// @param[out] rRotation  Unpacked rotation.
+///
+/// @see PackRotation()
+void AnimationClipData::UnpackRotation( const uint16_t* pPacked, Simd::Quat& rRotation )
+{
+    HELIUM_ASSERT( pPacked );
+
+    size_t largestIndex = ( ( pPacked[ 0 ] >> 15 ) << 1 ) | ( pPacked[ 1 ] >> 15 );
+
+    const float32_t scale = ( 2.0f * ROTATION_COMPONENT_MAX ) / static_cast< float32_t >( ROTATION_QUANTIZED_MAX );
+
+    float32_t components[ 3 ];
+    float32_t magnitudeSquared = 0.0f;
+    for( size_t quantizedIndex = 0; quantizedIndex < 3; ++quantizedIndex )
+    {
+        float32_t component =
+            static_cast< float32_t >( pPacked[ quantizedIndex ] & ROTATION_QUANTIZED_MAX ) * scale - ROTATION_COMPONENT_MAX;
+        components[ quantizedIndex ] = component;
+        magnitudeSquared += component * component;
+    }
+
+    size_t quantizedIndex = 0;
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        if( componentIndex == largestIndex )
+        {
+            rRotation.SetElement( componentIndex, Sqrt( Max( 1.0f - magnitudeSquared, 0.0f ) ) );
+        }
+        else
+        {
+            rRotation.SetElement( componentIndex, components[ quantizedIndex ] );
+            ++quantizedIndex;
+        }
+    }
+}
+
+/// Quantize a vector to 16 bits per component.
+///
+/// @param[in]  rVector     Vector to quantize.
+/// @param[in]  pRange      Quantization range (minimum x, y, z followed by extent x, y, z).
+/// @param[out] pQuantized  Quantized vector (KEY_CHANNEL_WORD_COUNT words).
+///
+/// @see DequantizeVector()
+void AnimationClipData::QuantizeVector( const Simd::Vector3& rVector, const float32_t* pRange, uint16_t* pQuantized )
+{
+    HELIUM_ASSERT( pRange );
+    HELIUM_ASSERT( pQuantized );
+
+    for( size_t componentIndex = 0; componentIndex < 3; ++componentIndex )
+    {
+        float32_t extent = pRange[ 3 + componentIndex ];
+        float32_t normalized = ( extent > 0.0f
+                                 ? ( rVector.GetElement( componentIndex ) - pRange[ componentIndex ] ) / extent
+                                 : 0.0f );
+        pQuantized[ componentIndex ] = static_cast< uint16_t >(
+            Clamp( normalized, 0.0f, 1.0f ) * static_cast< float32_t >( VECTOR_QUANTIZED_MAX ) + 0.5f );
+    }
+}
+
+/// Dequantize a vector quantized using QuantizeVector().
+///
+/// @param[in]  pQuantized  Quantized vector (KEY_CHANNEL_WORD_COUNT words).
+/// @param[in]  pRange      Quantization range (minimum x, y, z followed by extent x, y, z).
+/// @param[out] rVector     Dequantized vector.
+///
+/// @see QuantizeVector()
+void AnimationClipData::DequantizeVector( const uint16_t* pQuantized, const float32_t* pRange, Simd::Vector3& rVector )
+{
+    HELIUM_ASSERT( pQuantized );
+    HELIUM_ASSERT( pRange );
+
+    const float32_t scale = 1.0f / static_cast< float32_t >( VECTOR_QUANTIZED_MAX );
+
+    rVector = Simd::Vector3(
+        pRange[ 0 ] + static_cast< float32_t >( pQuantized[ 0 ] ) * scale * pRange[ 3 ],
+        pRange[ 1 ] + static_cast< float32_t >( pQuantized[ 1 ] ) * scale * pRange[ 4 ],
+        pRange[ 2 ] + static_cast< float32_t >( pQuantized[ 2 ] ) * scale * pRange[ 5 ] );
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "GraphicsTypes/GraphicsTypes.h"
+
+#include "MathSimd/Quat.h"
+#include "MathSimd/Vector3.h"
+
+namespace Helium
+{
+    class AnimationPose;
+
+    /// Compressed animation clip data.
+    ///
+    /// This is a non-owning view of the keyframe arrays for a single animation clip (typically the persistent resource
+    /// data of an Animation resource).  Each track stores a reduced set of keys taken from a uniformly sampled clip; the
+    /// first and last samples are always kept, and intermediate samples that can be reconstructed by linear
+    /// interpolation of their neighbors within tolerance are dropped.  All channels of a track share the same key
+    /// times so that a single interpolation weight can be used per bone.
+    ///
+    /// Rotations are stored in 48 bits using the "smallest three" encoding: the largest quaternion component is
+    /// dropped (after negating the quaternion so that it is positive), and the remaining three components are quantized
+    /// to 15 bits each.  The index of the dropped component is stored in the high bits of the first two words.
+    /// Translations and scales are quantized to 16 bits per component relative to the range covered by each track.
+    struct HELIUM_GRAPHICS_TYPES_API AnimationClipData
+    {
+        /// Number of 16-bit words per quantized key channel.
+        static const size_t KEY_CHANNEL_WORD_COUNT = 3;
+        /// Number of floats per track channel range (minimum and extent for each axis).
+        static const size_t RANGE_FLOAT_COUNT = 6;
+
+        /// Number of samples per second in the source clip.
+        float32_t sampleRate;
+        /// Number of samples in the source clip.
+        uint32_t sampleCount;
+        /// Number of tracks.
+        uint32_t trackCount;
+
+        /// Index of the first key of each track (trackCount + 1 entries, with the last entry holding the total key
+        /// count).
+        const uint32_t* pKeyOffsets;
+        /// Source sample index of each key.
+        const uint16_t* pKeySamples;
+        /// Packed rotation of each key.
+        const uint16_t* pRotationKeys;
+        /// Quantized translation of each key.
+        const uint16_t* pTranslationKeys;
+        /// Quantized scale of each key.
+        const uint16_t* pScaleKeys;
+        /// Translation quantization range of each track.
+        const float32_t* pTranslationRanges;
+        /// Scale quantization range of each track.
+        const float32_t* pScaleRanges;
+
+        /// @name Construction/Destruction
+        //@{
+        AnimationClipData();
+        //@}
+
+        /// @name Sampling
+        //@{
+        inline float32_t GetDuration() const;
+
+        void Sample(
+            float32_t time, bool bLoop, const uint16_t* pBoneTrackIndices, const AnimationPose& rReferencePose,
+            AnimationPose& rPose ) const;
+        //@}
+
+        /// @name Static Key Encoding Functions
+        //@{
+        static void PackRotation( const Simd::Quat& rRotation, uint16_t* pPacked );
+        static void UnpackRotation( const uint16_t* pPacked, Simd::Quat& rRotation );
+
+        static void QuantizeVector( const Simd::Vector3& rVector, const float32_t* pRange, uint16_t* pQuantized );
+        static void DequantizeVector( const uint16_t* pQuantized, const float32_t* pRange, Simd::Vector3& rVector );
+        //@}
+    };
+}
+
+#include "GraphicsTypes/AnimationClipData.inl"
@@ -0,0 +1,12 @@
+namespace Helium
+{
+    /// Get the length of this clip.
+    ///
+    /// @return  Clip duration, in seconds.
+    float32_t AnimationClipData::GetDuration() const
+    {
+        return ( sampleCount > 1 && sampleRate > 0.0f
+                 ? static_cast< float32_t >( sampleCount - 1 ) / sampleRate
+                 : 0.0f );
+    }
+}
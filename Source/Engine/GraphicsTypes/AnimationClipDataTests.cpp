@@ -0,0 +1,239 @@
+#include "GraphicsTypes/AnimationClipData.h"
+#include "GraphicsTypes/AnimationPose.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+/// Largest expected error of each dequantized rotation component.
+static const float32_t ROTATION_ERROR_MAX = 1.0e-3f;
+
+/// Check that two quaternions represent the same rotation within tolerance.
+static void ExpectRotationNear( const Simd::Quat& rExpected, const Simd::Quat& rActual, float32_t tolerance )
+{
+    // q and -q represent the same rotation.
+    float32_t dot = 0.0f;
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        dot += rExpected.GetElement( componentIndex ) * rActual.GetElement( componentIndex );
+    }
+
+    float32_t sign = ( dot < 0.0f ? -1.0f : 1.0f );
+    for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+    {
+        EXPECT_NEAR(
+            rExpected.GetElement( componentIndex ), sign * rActual.GetElement( componentIndex ), tolerance )
+            << "Component " << componentIndex;
+    }
+}
+
+TEST( AnimationClipData, PackRotationRoundTrip )
+{
+    static const float32_t axes[][ 3 ] =
+    {
+        { 1.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f },
+        { 0.577350f, 0.577350f, 0.577350f },
+        { -0.267261f, 0.534522f, -0.801784f },
+    };
+
+    uint16_t packed[ AnimationClipData::KEY_CHANNEL_WORD_COUNT ];
+    Simd::Quat unpacked;
+
+    for( size_t axisIndex = 0; axisIndex < HELIUM_ARRAY_COUNT( axes ); ++axisIndex )
+    {
+        Simd::Vector3 axis( axes[ axisIndex ][ 0 ], axes[ axisIndex ][ 1 ], axes[ axisIndex ][ 2 ] );
+
+        // Sweep the angle over more than a full turn so that every component gets to be the largest one, including
+        // negative values that require the quaternion to be flipped.
+        for( float32_t angle = -7.0f; angle <= 7.0f; angle += 0.37f )
+        {
+            Simd::Quat rotation( axis, angle );
+            rotation.Normalize();
+
+            AnimationClipData::PackRotation( rotation, packed );
+            AnimationClipData::UnpackRotation( packed, unpacked );
+
+            ExpectRotationNear( rotation, unpacked, ROTATION_ERROR_MAX );
+        }
+    }
+
+    // Identity rotations stay within a tight tolerance so that static tracks do not drift.
+    AnimationClipData::PackRotation( Simd::Quat( 0.0f, 0.0f, 0.0f, 1.0f ), packed );
+    AnimationClipData::UnpackRotation( packed, unpacked );
+    ExpectRotationNear( Simd::Quat( 0.0f, 0.0f, 0.0f, 1.0f ), unpacked, 1.0e-4f );
+}
+
+TEST( AnimationClipData, QuantizeVectorErrorBound )
+{
+    // Minimum x, y, z followed by extent x, y, z.  The zero extent on the z-axis must not produce invalid values.
+    static const float32_t range[ AnimationClipData::RANGE_FLOAT_COUNT ] = { -10.0f, 2.0f, 5.0f, 20.0f, 0.5f, 0.0f };
+
+    // Quantization to 16 bits rounds to the nearest step, so the error is at most half a step.
+    float32_t errorMax[ 3 ];
+    for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+    {
+        errorMax[ axisIndex ] = range[ 3 + axisIndex ] / 65535.0f * 0.5f + 1.0e-5f;
+    }
+
+    uint16_t quantized[ AnimationClipData::KEY_CHANNEL_WORD_COUNT ];
+    Simd::Vector3 dequantized;
+
+    for( size_t stepIndex = 0; stepIndex <= 100; ++stepIndex )
+    {
+        float32_t t = static_cast< float32_t >( stepIndex ) / 100.0f;
+        Simd::Vector3 vector( -10.0f + 20.0f * t, 2.0f + 0.5f * t * t, 5.0f );
+
+        AnimationClipData::QuantizeVector( vector, range, quantized );
+        AnimationClipData::DequantizeVector( quantized, range, dequantized );
+
+        for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+        {
+            EXPECT_NEAR( vector.GetElement( axisIndex ), dequantized.GetElement( axisIndex ), errorMax[ axisIndex ] )
+                << "Step " << stepIndex << ", axis " << axisIndex;
+        }
+    }
+
+    // Values outside of the range are clamped to it.
+    AnimationClipData::QuantizeVector( Simd::Vector3( -100.0f, 100.0f, 5.0f ), range, quantized );
+    AnimationClipData::DequantizeVector( quantized, range, dequantized );
+    EXPECT_NEAR( -10.0f, dequantized.GetElement( 0 ), errorMax[ 0 ] );
+    EXPECT_NEAR( 2.5f, dequantized.GetElement( 1 ), errorMax[ 1 ] );
+}
+
+/// Two-key clip animating a single track.
+class AnimationClipDataSampleTest : public testing::Test
+{
+protected:
+    /// Source sample index of each key.
+    uint16_t m_keySamples[ 2 ];
+    /// Index of the first key of each track.
+    uint32_t m_keyOffsets[ 2 ];
+    /// Packed rotation keys.
+    uint16_t m_rotationKeys[ 2 * AnimationClipData::KEY_CHANNEL_WORD_COUNT ];
+    /// Quantized translation keys.
+    uint16_t m_translationKeys[ 2 * AnimationClipData::KEY_CHANNEL_WORD_COUNT ];
+    /// Quantized scale keys.
+    uint16_t m_scaleKeys[ 2 * AnimationClipData::KEY_CHANNEL_WORD_COUNT ];
+    /// Translation quantization range.
+    float32_t m_translationRange[ AnimationClipData::RANGE_FLOAT_COUNT ];
+    /// Scale quantization range.
+    float32_t m_scaleRange[ AnimationClipData::RANGE_FLOAT_COUNT ];
+
+    /// Clip data view.
+    AnimationClipData m_clip;
+    /// Reference pose.
+    AnimationPose m_referencePose;
+
+    virtual void SetUp() override
+    {
+        // One second at ten samples per second, translating from the origin to ( 10, 0, 0 ) with an identity rotation
+        // and unit scale.
+        m_keySamples[ 0 ] = 0;
+        m_keySamples[ 1 ] = 10;
+        m_keyOffsets[ 0 ] = 0;
+        m_keyOffsets[ 1 ] = 2;
+
+        const float32_t translationRange[ AnimationClipData::RANGE_FLOAT_COUNT ] = { 0.0f, 0.0f, 0.0f, 10.0f, 0.0f, 0.0f };
+        const float32_t scaleRange[ AnimationClipData::RANGE_FLOAT_COUNT ] = { 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+        for( size_t valueIndex = 0; valueIndex < AnimationClipData::RANGE_FLOAT_COUNT; ++valueIndex )
+        {
+            m_translationRange[ valueIndex ] = translationRange[ valueIndex ];
+            m_scaleRange[ valueIndex ] = scaleRange[ valueIndex ];
+        }
+
+        Simd::Quat identity( 0.0f, 0.0f, 0.0f, 1.0f );
+        AnimationClipData::PackRotation( identity, m_rotationKeys );
+        AnimationClipData::PackRotation( identity, m_rotationKeys + AnimationClipData::KEY_CHANNEL_WORD_COUNT );
+
+        AnimationClipData::QuantizeVector( Simd::Vector3( 0.0f, 0.0f, 0.0f ), m_translationRange, m_translationKeys );
+        AnimationClipData::QuantizeVector(
+            Simd::Vector3( 10.0f, 0.0f, 0.0f ), m_translationRange,
+            m_translationKeys + AnimationClipData::KEY_CHANNEL_WORD_COUNT );
+
+        AnimationClipData::QuantizeVector( Simd::Vector3( 1.0f, 1.0f, 1.0f ), m_scaleRange, m_scaleKeys );
+        AnimationClipData::QuantizeVector(
+            Simd::Vector3( 1.0f, 1.0f, 1.0f ), m_scaleRange, m_scaleKeys + AnimationClipData::KEY_CHANNEL_WORD_COUNT );
+
+        m_clip.sampleRate = 10.0f;
+        m_clip.sampleCount = 11;
+        m_clip.trackCount = 1;
+        m_clip.pKeyOffsets = m_keyOffsets;
+        m_clip.pKeySamples = m_keySamples;
+        m_clip.pRotationKeys = m_rotationKeys;
+        m_clip.pTranslationKeys = m_translationKeys;
+        m_clip.pScaleKeys = m_scaleKeys;
+        m_clip.pTranslationRanges = m_translationRange;
+        m_clip.pScaleRanges = m_scaleRange;
+
+        // Bone 0 is animated, bone 1 keeps its reference transform.
+        m_referencePose.SetBoneCount( 2 );
+        m_referencePose.SetBoneTransform(
+            1, Simd::Quat( 0.0f, 0.0f, 0.0f, 1.0f ), Simd::Vector3( 0.0f, 3.0f, 0.0f ), Simd::Vector3( 2.0f, 2.0f, 2.0f ) );
+    }
+
+    /// Sample the clip and return the translation of each bone.
+    void SampleTranslations( float32_t time, bool bLoop, Simd::Vector3& rBone0, Simd::Vector3& rBone1 )
+    {
+        uint16_t boneTrackIndices[ 2 ];
+        boneTrackIndices[ 0 ] = 0;
+        SetInvalid( boneTrackIndices[ 1 ] );
+
+        AnimationPose pose;
+        m_clip.Sample( time, bLoop, boneTrackIndices, m_referencePose, pose );
+        ASSERT_EQ( 2, pose.GetBoneCount() );
+
+        Simd::Quat rotation;
+        Simd::Vector3 scale;
+        pose.GetBoneTransform( 0, rotation, rBone0, scale );
+        ExpectRotationNear( Simd::Quat( 0.0f, 0.0f, 0.0f, 1.0f ), rotation, 1.0e-4f );
+        EXPECT_NEAR( 1.0f, scale.GetElement( 0 ), 1.0e-5f );
+
+        pose.GetBoneTransform( 1, rotation, rBone1, scale );
+        EXPECT_NEAR( 2.0f, scale.GetElement( 0 ), 1.0e-5f );
+    }
+};
+
+TEST_F( AnimationClipDataSampleTest, Duration )
+{
+    EXPECT_NEAR( 1.0f, m_clip.GetDuration(), 1.0e-6f );
+}
+
+TEST_F( AnimationClipDataSampleTest, InterpolatesBetweenKeys )
+{
+    Simd::Vector3 bone0, bone1;
+
+    SampleTranslations( 0.0f, false, bone0, bone1 );
+    EXPECT_NEAR( 0.0f, bone0.GetElement( 0 ), 1.0e-3f );
+
+    SampleTranslations( 0.25f, false, bone0, bone1 );
+    EXPECT_NEAR( 2.5f, bone0.GetElement( 0 ), 1.0e-3f );
+    EXPECT_NEAR( 0.0f, bone0.GetElement( 1 ), 1.0e-3f );
+
+    SampleTranslations( 1.0f, false, bone0, bone1 );
+    EXPECT_NEAR( 10.0f, bone0.GetElement( 0 ), 1.0e-3f );
+
+    // Bones without a track keep their reference pose.
+    EXPECT_NEAR( 0.0f, bone1.GetElement( 0 ), 1.0e-5f );
+    EXPECT_NEAR( 3.0f, bone1.GetElement( 1 ), 1.0e-5f );
+}
+
+TEST_F( AnimationClipDataSampleTest, LoopsOrClamps )
+{
+    Simd::Vector3 bone0, bone1;
+
+    // Looping wraps the time around the clip duration.
+    SampleTranslations( 1.5f, true, bone0, bone1 );
+    EXPECT_NEAR( 5.0f, bone0.GetElement( 0 ), 1.0e-3f );
+
+    SampleTranslations( -0.25f, true, bone0, bone1 );
+    EXPECT_NEAR( 7.5f, bone0.GetElement( 0 ), 1.0e-3f );
+
+    // Otherwise, the time is clamped to the clip.
+    SampleTranslations( 1.5f, false, bone0, bone1 );
+    EXPECT_NEAR( 10.0f, bone0.GetElement( 0 ), 1.0e-3f );
+
+    SampleTranslations( -0.25f, false, bone0, bone1 );
+    EXPECT_NEAR( 0.0f, bone0.GetElement( 0 ), 1.0e-3f );
+}
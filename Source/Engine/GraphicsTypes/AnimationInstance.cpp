@@ -0,0 +1,78 @@
+#include "Precompile.h"
+#include "GraphicsTypes/AnimationInstance.h"
+
+using namespace Helium;
+
+/// Constructor.
+AnimationInstance::AnimationInstance()
+: blendWeight( 0.0f )
+, bLoop( true )
+, pReferencePose( NULL )
+, pParentBoneIndices( NULL )
+, pBonePalette( NULL )
+{
+    for( size_t clipIndex = 0; clipIndex < CLIP_COUNT_MAX; ++clipIndex )
+    {
+        pClips[ clipIndex ] = NULL;
+        pBoneTrackIndices[ clipIndex ] = NULL;
+        times[ clipIndex ] = 0.0f;
+    }
+}
+
+/// Advance the playback time of each clip.
+///
+/// @param[in] deltaSeconds  Time elapsed since the last update, in seconds.
+void AnimationInstance::Advance( float32_t deltaSeconds )
+{
+    for( size_t clipIndex = 0; clipIndex < CLIP_COUNT_MAX; ++clipIndex )
+    {
+        const AnimationClipData* pClip = pClips[ clipIndex ];
+        if( !pClip )
+        {
+            continue;
+        }
+
+        float32_t duration = pClip->GetDuration();
+        float32_t time = times[ clipIndex ] + deltaSeconds;
+        if( bLoop && duration > 0.0f )
+        {
+            time -= Floor( time / duration ) * duration;
+        }
+        else
+        {
+            time = Clamp( time, 0.0f, duration );
+        }
+
+        times[ clipIndex ] = time;
+    }
+}
+
+/// Sample and blend the current clips and update the bone palette.
+///
+/// If no clips are assigned, the bone palette is set to the reference pose.
+void AnimationInstance::Update()
+{
+    HELIUM_ASSERT( pReferencePose );
+    HELIUM_ASSERT( pParentBoneIndices || pReferencePose->GetBoneCount() == 0 );
+    HELIUM_ASSERT( pBonePalette || pReferencePose->GetBoneCount() == 0 );
+
+    const AnimationClipData* pClip0 = pClips[ 0 ];
+    const AnimationClipData* pClip1 = pClips[ 1 ];
+
+    if( pClip0 )
+    {
+        pClip0->Sample( times[ 0 ], bLoop, pBoneTrackIndices[ 0 ], *pReferencePose, m_pose );
+    }
+    else
+    {
+        m_pose.CopyFrom( *pReferencePose );
+    }
+
+    if( pClip1 && blendWeight > 0.0f )
+    {
+        pClip1->Sample( times[ 1 ], bLoop, pBoneTrackIndices[ 1 ], *pReferencePose, m_blendPose );
+        m_pose.Blend( m_pose, m_blendPose, blendWeight );
+    }
+
+    m_pose.ComputeModelTransforms( pParentBoneIndices, pBonePalette );
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "GraphicsTypes/GraphicsTypes.h"
+
+#include "GraphicsTypes/AnimationClipData.h"
+#include "GraphicsTypes/AnimationPose.h"
+
+namespace Helium
+{
+    /// Animation playback state for a single skeleton instance.
+    ///
+    /// Each instance samples up to two clips, blends between them, and writes the resulting model-space bone transforms
+    /// to a bone palette suitable for GraphicsSceneObject::SetBonePalette().  Instances are independent of each other,
+    /// so large numbers of them can be updated in parallel using UpdateAnimationPosesJobSpawner.
+    class HELIUM_GRAPHICS_TYPES_API AnimationInstance
+    {
+    public:
+        /// Maximum number of clips that can be blended.
+        static const size_t CLIP_COUNT_MAX = 2;
+
+        /// Clips to sample (the second clip is optional).
+        const AnimationClipData* pClips[ CLIP_COUNT_MAX ];
+        /// Bone track index maps for each clip.
+        const uint16_t* pBoneTrackIndices[ CLIP_COUNT_MAX ];
+        /// Current sample time of each clip, in seconds.
+        float32_t times[ CLIP_COUNT_MAX ];
+        /// Weight of the second clip when blending.
+        float32_t blendWeight;
+        /// True to loop clip playback.
+        bool bLoop;
+
+        /// Local-space reference pose of the skeleton.
+        const AnimationPose* pReferencePose;
+        /// Parent index of each bone in the skeleton.
+        const uint8_t* pParentBoneIndices;
+
+        /// Model-space bone transform output (one entry per skeleton bone).
+        Simd::Matrix44* pBonePalette;
+
+        /// @name Construction/Destruction
+        //@{
+        AnimationInstance();
+        //@}
+
+        /// @name Updating
+        //@{
+        void Advance( float32_t deltaSeconds );
+        void Update();
+        //@}
+
+    private:
+        /// Sampled pose scratch space.
+        AnimationPose m_pose;
+        /// Blend pose scratch space.
+        AnimationPose m_blendPose;
+    };
+}
@@ -0,0 +1,412 @@
+#include "Precompile.h"
+#include "GraphicsTypes/AnimationPose.h"
+
+#include "MathSimd/Matrix44Soa.h"
+#include "MathSimd/QuatSoa.h"
+#include "MathSimd/Vector3Soa.h"
+
+using namespace Helium;
+
+/// Extract the rotation of a matrix with orthonormal basis rows.
+///
+/// This is the inverse of Simd::Matrix44::SetRotationOnly().
+///
+/// @param[in]  rMatrix    Rotation matrix.
+/// @param[out] rRotation  Rotation quaternion.
+static void ExtractRotation( const Simd::Matrix44& rMatrix, Simd::Quat& rRotation )
+{
+    float32_t m00 = rMatrix.GetElement( 0 );
+    float32_t m01 = rMatrix.GetElement( 1 );
+    float32_t m02 = rMatrix.GetElement( 2 );
+    float32_t m10 = rMatrix.GetElement( 4 );
+    float32_t m11 = rMatrix.GetElement( 5 );
+    float32_t m12 = rMatrix.GetElement( 6 );
+    float32_t m20 = rMatrix.GetElement( 8 );
+    float32_t m21 = rMatrix.GetElement( 9 );
+    float32_t m22 = rMatrix.GetElement( 10 );
+
+    float32_t x, y, z, w;
+
+    float32_t trace = m00 + m11 + m22;
+    if( trace > 0.0f )
+    {
+        float32_t s = 0.5f / Sqrt( trace + 1.0f );
+        w = 0.25f / s;
+        x = ( m12 - m21 ) * s;
+        y = ( m20 - m02 ) * s;
+        z = ( m01 - m10 ) * s;
+    }
+    else if( m00 > m11 && m00 > m22 )
+    {
+        float32_t s = 2.0f * Sqrt( 1.0f + m00 - m11 - m22 );
+        float32_t invS = 1.0f / s;
+        w = ( m12 - m21 ) * invS;
+        x = 0.25f * s;
+        y = ( m01 + m10 ) * invS;
+        z = ( m02 + m20 ) * invS;
+    }
+    else if( m11 > m22 )
+    {
+        float32_t s = 2.0f * Sqrt( 1.0f + m11 - m00 - m22 );
+        float32_t invS = 1.0f / s;
+        w = ( m20 - m02 ) * invS;
+        x = ( m01 + m10 ) * invS;
+        y = 0.25f * s;
+        z = ( m12 + m21 ) * invS;
+    }
+    else
+    {
+        float32_t s = 2.0f * Sqrt( 1.0f + m22 - m00 - m11 );
+        float32_t invS = 1.0f / s;
+        w = ( m01 - m10 ) * invS;
+        x = ( m02 + m20 ) * invS;
+        y = ( m12 + m21 ) * invS;
+        z = 0.25f * s;
+    }
+
+    rRotation = Simd::Quat( x, y, z, w );
+    rRotation.Normalize();
+}
+
+/// Constructor.
+AnimationPose::AnimationPose()
+: m_boneCount( 0 )
+{
+}
+
+/// Set the number of bones in this pose.
+///
+/// All bone transforms are reset to the identity transform.
+///
+/// @param[in] boneCount  Number of bones.
+///
+/// @see GetBoneCount(), SetIdentity()
+void AnimationPose::SetBoneCount( uint8_t boneCount )
+{
+    m_boneCount = boneCount;
+    m_blocks.Resize( ( static_cast< size_t >( boneCount ) + BLOCK_BONE_COUNT - 1 ) / BLOCK_BONE_COUNT );
+
+    SetIdentity();
+}
+
+/// Reset all bone transforms, including unused lanes, to the identity transform.
+///
+/// @see SetBoneCount()
+void AnimationPose::SetIdentity()
+{
+    size_t blockCount = m_blocks.GetSize();
+    for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        Block& rBlock = m_blocks[ blockIndex ];
+        for( size_t laneIndex = 0; laneIndex < BLOCK_BONE_COUNT; ++laneIndex )
+        {
+            rBlock.rotationX[ laneIndex ] = 0.0f;
+            rBlock.rotationY[ laneIndex ] = 0.0f;
+            rBlock.rotationZ[ laneIndex ] = 0.0f;
+            rBlock.rotationW[ laneIndex ] = 1.0f;
+            rBlock.translationX[ laneIndex ] = 0.0f;
+            rBlock.translationY[ laneIndex ] = 0.0f;
+            rBlock.translationZ[ laneIndex ] = 0.0f;
+            rBlock.scaleX[ laneIndex ] = 1.0f;
+            rBlock.scaleY[ laneIndex ] = 1.0f;
+            rBlock.scaleZ[ laneIndex ] = 1.0f;
+        }
+    }
+}
+
+/// Initialize this pose from a set of parent-relative reference pose matrices.
+///
+/// Each matrix is decomposed into its rotation, translation, and (non-uniform) scale.  Shearing is not supported.
+///
+/// @param[in] pReferencePose  Parent-relative bone transforms.
+/// @param[in] boneCount       Number of bones.
+void AnimationPose::SetReferencePose( const Simd::Matrix44* pReferencePose, uint8_t boneCount )
+{
+    HELIUM_ASSERT( pReferencePose || boneCount == 0 );
+
+    SetBoneCount( boneCount );
+
+    for( uint8_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+    {
+        Simd::Matrix44 transform = pReferencePose[ boneIndex ];
+
+        Simd::Vector3 translation( transform.GetElement( 12 ), transform.GetElement( 13 ), transform.GetElement( 14 ) );
+
+        // Each basis row carries the scaling along its axis.
+        float32_t scales[ 3 ];
+        for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+        {
+            Simd::Vector3 axis(
+                transform.GetElement( axisIndex * 4 ),
+                transform.GetElement( axisIndex * 4 + 1 ),
+                transform.GetElement( axisIndex * 4 + 2 ) );
+            float32_t scale = axis.GetMagnitude();
+            scales[ axisIndex ] = scale;
+
+            float32_t inverseScale = ( scale > HELIUM_EPSILON ? 1.0f / scale : 0.0f );
+            transform.SetElement( axisIndex * 4, axis.GetElement( 0 ) * inverseScale );
+            transform.SetElement( axisIndex * 4 + 1, axis.GetElement( 1 ) * inverseScale );
+            transform.SetElement( axisIndex * 4 + 2, axis.GetElement( 2 ) * inverseScale );
+        }
+
+        Simd::Quat rotation;
+        ExtractRotation( transform, rotation );
+
+        SetBoneTransform( boneIndex, rotation, translation, Simd::Vector3( scales[ 0 ], scales[ 1 ], scales[ 2 ] ) );
+    }
+}
+
+/// Copy the contents of another pose into this pose.
+///
+/// @param[in] rSource  Pose to copy.
+void AnimationPose::CopyFrom( const AnimationPose& rSource )
+{
+    m_boneCount = rSource.m_boneCount;
+    m_blocks.Resize( rSource.m_blocks.GetSize() );
+    MemoryCopy( m_blocks.GetData(), rSource.m_blocks.GetData(), rSource.m_blocks.GetSize() * sizeof( Block ) );
+}
+
+/// Set the parent-relative transform of a single bone.
+///
+/// @param[in] boneIndex     Bone index.
+/// @param[in] rRotation     Bone rotation.
+/// @param[in] rTranslation  Bone translation.
+/// @param[in] rScale        Bone scale.
+///
+/// @see GetBoneTransform()
+void AnimationPose::SetBoneTransform(
+    uint8_t boneIndex, const Simd::Quat& rRotation, const Simd::Vector3& rTranslation, const Simd::Vector3& rScale )
+{
+    HELIUM_ASSERT( boneIndex < m_boneCount );
+
+    Block& rBlock = m_blocks[ boneIndex / BLOCK_BONE_COUNT ];
+    size_t laneIndex = boneIndex % BLOCK_BONE_COUNT;
+
+    rBlock.rotationX[ laneIndex ] = rRotation.GetElement( 0 );
+    rBlock.rotationY[ laneIndex ] = rRotation.GetElement( 1 );
+    rBlock.rotationZ[ laneIndex ] = rRotation.GetElement( 2 );
+    rBlock.rotationW[ laneIndex ] = rRotation.GetElement( 3 );
+    rBlock.translationX[ laneIndex ] = rTranslation.GetElement( 0 );
+    rBlock.translationY[ laneIndex ] = rTranslation.GetElement( 1 );
+    rBlock.translationZ[ laneIndex ] = rTranslation.GetElement( 2 );
+    rBlock.scaleX[ laneIndex ] = rScale.GetElement( 0 );
+    rBlock.scaleY[ laneIndex ] = rScale.GetElement( 1 );
+    rBlock.scaleZ[ laneIndex ] = rScale.GetElement( 2 );
+}
+
+/// Get the parent-relative transform of a single bone.
+///
+/// @param[in]  boneIndex     Bone index.
+/// @param[out] rRotation     Bone rotation.
+/// @param[out] rTranslation  Bone translation.
+/// @param[out] rScale        Bone scale.
+///
+/// @see SetBoneTransform()
+void AnimationPose::GetBoneTransform(
+    uint8_t boneIndex, Simd::Quat& rRotation, Simd::Vector3& rTranslation, Simd::Vector3& rScale ) const
+{
+    HELIUM_ASSERT( boneIndex < m_boneCount );
+
+    const Block& rBlock = m_blocks[ boneIndex / BLOCK_BONE_COUNT ];
+    size_t laneIndex = boneIndex % BLOCK_BONE_COUNT;
+
+    rRotation = Simd::Quat(
+        rBlock.rotationX[ laneIndex ],
+        rBlock.rotationY[ laneIndex ],
+        rBlock.rotationZ[ laneIndex ],
+        rBlock.rotationW[ laneIndex ] );
+    rTranslation = Simd::Vector3(
+        rBlock.translationX[ laneIndex ], rBlock.translationY[ laneIndex ], rBlock.translationZ[ laneIndex ] );
+    rScale = Simd::Vector3( rBlock.scaleX[ laneIndex ], rBlock.scaleY[ laneIndex ], rBlock.scaleZ[ laneIndex ] );
+}
+
+/// Blend between two poses.
+///
+/// Both poses must have the same number of bones.  This pose may be the same as either of the source poses.
+///
+/// @param[in] rPose0  First pose.
+/// @param[in] rPose1  Second pose.
+/// @param[in] weight  Blend weight (0 for the first pose, 1 for the second pose).
+void AnimationPose::Blend( const AnimationPose& rPose0, const AnimationPose& rPose1, float32_t weight )
+{
+    HELIUM_ASSERT( rPose0.m_boneCount == rPose1.m_boneCount );
+
+    if( this != &rPose0 && this != &rPose1 )
+    {
+        m_boneCount = rPose0.m_boneCount;
+        m_blocks.Resize( rPose0.m_blocks.GetSize() );
+    }
+
+    HELIUM_SIMD_ALIGN_PRE float32_t weights[ BLOCK_BONE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+    for( size_t laneIndex = 0; laneIndex < BLOCK_BONE_COUNT; ++laneIndex )
+    {
+        weights[ laneIndex ] = weight;
+    }
+
+    size_t blockCount = m_blocks.GetSize();
+    for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        InterpolateBlock( rPose0.m_blocks[ blockIndex ], rPose1.m_blocks[ blockIndex ], weights, m_blocks[ blockIndex ] );
+    }
+}
+
+/// Compute the model-space transform of each bone in this pose.
+///
+/// Local transforms are built a block at a time, after which each bone is concatenated with its parent.  Parent bones
+/// must precede their children.
+///
+/// @param[in]  pParentBoneIndices  Parent index of each bone (invalid for root bones).
+/// @param[out] pModelTransforms    Model-space bone transforms.
+void AnimationPose::ComputeModelTransforms( const uint8_t* pParentBoneIndices, Simd::Matrix44* pModelTransforms ) const
+{
+    HELIUM_ASSERT( pParentBoneIndices || m_boneCount == 0 );
+    HELIUM_ASSERT( pModelTransforms || m_boneCount == 0 );
+
+#if HELIUM_SIMD_SSE
+    Simd::QuatSoa rotations;
+    Simd::Vector3Soa translations;
+    Simd::Vector3Soa scales;
+    Simd::Matrix44Soa transforms;
+    Simd::Matrix44 laneTransforms[ BLOCK_BONE_COUNT ];
+
+    size_t blockCount = m_blocks.GetSize();
+    for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+    {
+        const Block& rBlock = m_blocks[ blockIndex ];
+
+        rotations.Load( rBlock.rotationX, rBlock.rotationY, rBlock.rotationZ, rBlock.rotationW );
+        translations.Load( rBlock.translationX, rBlock.translationY, rBlock.translationZ );
+        scales.Load( rBlock.scaleX, rBlock.scaleY, rBlock.scaleZ );
+
+        transforms.SetRotationTranslationScaling( rotations, translations, scales );
+        transforms.Scatter( laneTransforms[ 0 ], laneTransforms[ 1 ], laneTransforms[ 2 ], laneTransforms[ 3 ] );
+
+        size_t boneBase = blockIndex * BLOCK_BONE_COUNT;
+        size_t laneCount = Min( static_cast< size_t >( m_boneCount ) - boneBase, BLOCK_BONE_COUNT );
+        for( size_t laneIndex = 0; laneIndex < laneCount; ++laneIndex )
+        {
+            pModelTransforms[ boneBase + laneIndex ] = laneTransforms[ laneIndex ];
+        }
+    }
+#else
+    Simd::Quat rotation;
+    Simd::Vector3 translation;
+    Simd::Vector3 scale;
+
+    for( uint8_t boneIndex = 0; boneIndex < m_boneCount; ++boneIndex )
+    {
+        GetBoneTransform( boneIndex, rotation, translation, scale );
+        pModelTransforms[ boneIndex ].SetRotationTranslationScaling( rotation, translation, scale );
+    }
+#endif
+
+    for( uint8_t boneIndex = 0; boneIndex < m_boneCount; ++boneIndex )
+    {
+        uint8_t parentBoneIndex = pParentBoneIndices[ boneIndex ];
+        if( IsValid( parentBoneIndex ) )
+        {
+            HELIUM_ASSERT( parentBoneIndex < boneIndex );
+            pModelTransforms[ boneIndex ].MultiplySet(
+                pModelTransforms[ boneIndex ], pModelTransforms[ parentBoneIndex ] );
+        }
+    }
+}
+
+/// Interpolate between two blocks of bone transforms.
+///
+/// Rotations are normalized-linearly interpolated along the shortest path, while translations and scales are
+/// linearly interpolated.  The result block may be the same as either source block.
+///
+/// @param[in]  rBlock0   First block.
+/// @param[in]  rBlock1   Second block.
+/// @param[in]  pWeights  Interpolation weight for each lane (SIMD-aligned).
+/// @param[out] rResult   Interpolated block.
+void AnimationPose::InterpolateBlock( const Block& rBlock0, const Block& rBlock1, const float32_t* pWeights, Block& rResult )
+{
+    HELIUM_ASSERT( pWeights );
+
+#if HELIUM_SIMD_SSE
+    Simd::Register weight1 = Simd::LoadAligned( pWeights );
+    Simd::Register weight0 = Simd::SubtractF32( Simd::SetSplatF32( 1.0f ), weight1 );
+
+    Simd::QuatSoa rotation0, rotation1;
+    rotation0.Load( rBlock0.rotationX, rBlock0.rotationY, rBlock0.rotationZ, rBlock0.rotationW );
+    rotation1.Load( rBlock1.rotationX, rBlock1.rotationY, rBlock1.rotationZ, rBlock1.rotationW );
+
+    // Negate the second rotation weight where the rotations lie in opposite hemispheres so that interpolation takes
+    // the shortest path.
+    Simd::Register dot = Simd::MultiplyF32( rotation0.m_x, rotation1.m_x );
+    dot = Simd::MultiplyAddF32( rotation0.m_y, rotation1.m_y, dot );
+    dot = Simd::MultiplyAddF32( rotation0.m_z, rotation1.m_z, dot );
+    dot = Simd::MultiplyAddF32( rotation0.m_w, rotation1.m_w, dot );
+    Simd::Register signMask = Simd::And(
+        Simd::LessF32( dot, Simd::LoadZeros() ), Simd::SetSplatU32( 0x80000000 ) );
+    Simd::Register rotationWeight1 = Simd::Xor( weight1, signMask );
+
+    Simd::QuatSoa rotation;
+    rotation.m_x = Simd::MultiplyAddF32(
+        rotation1.m_x, rotationWeight1, Simd::MultiplyF32( rotation0.m_x, weight0 ) );
+    rotation.m_y = Simd::MultiplyAddF32(
+        rotation1.m_y, rotationWeight1, Simd::MultiplyF32( rotation0.m_y, weight0 ) );
+    rotation.m_z = Simd::MultiplyAddF32(
+        rotation1.m_z, rotationWeight1, Simd::MultiplyF32( rotation0.m_z, weight0 ) );
+    rotation.m_w = Simd::MultiplyAddF32(
+        rotation1.m_w, rotationWeight1, Simd::MultiplyF32( rotation0.m_w, weight0 ) );
+    rotation.Normalize();
+    rotation.Store( rResult.rotationX, rResult.rotationY, rResult.rotationZ, rResult.rotationW );
+
+    Simd::Vector3Soa vector0, vector1;
+    vector0.Load( rBlock0.translationX, rBlock0.translationY, rBlock0.translationZ );
+    vector1.Load( rBlock1.translationX, rBlock1.translationY, rBlock1.translationZ );
+    Simd::StoreAligned( rResult.translationX, Simd::MultiplyAddF32(
+        Simd::SubtractF32( vector1.m_x, vector0.m_x ), weight1, vector0.m_x ) );
+    Simd::StoreAligned( rResult.translationY, Simd::MultiplyAddF32(
+        Simd::SubtractF32( vector1.m_y, vector0.m_y ), weight1, vector0.m_y ) );
+    Simd::StoreAligned( rResult.translationZ, Simd::MultiplyAddF32(
+        Simd::SubtractF32( vector1.m_z, vector0.m_z ), weight1, vector0.m_z ) );
+
+    vector0.Load( rBlock0.scaleX, rBlock0.scaleY, rBlock0.scaleZ );
+    vector1.Load( rBlock1.scaleX, rBlock1.scaleY, rBlock1.scaleZ );
+    Simd::StoreAligned( rResult.scaleX, Simd::MultiplyAddF32(
+        Simd::SubtractF32( vector1.m_x, vector0.m_x ), weight1, vector0.m_x ) );
+    Simd::StoreAligned( rResult.scaleY, Simd::MultiplyAddF32(
+        Simd::SubtractF32( vector1.m_y, vector0.m_y ), weight1, vector0.m_y ) );
+    Simd::StoreAligned( rResult.scaleZ, Simd::MultiplyAddF32(
+        Simd::SubtractF32( vector1.m_z, vector0.m_z ), weight1, vector0.m_z ) );
+#else
+    for( size_t laneIndex = 0; laneIndex < BLOCK_BONE_COUNT; ++laneIndex )
+    {
+        float32_t weight1 = pWeights[ laneIndex ];
+        float32_t weight0 = 1.0f - weight1;
+
+        float32_t x0 = rBlock0.rotationX[ laneIndex ];
+        float32_t y0 = rBlock0.rotationY[ laneIndex ];
+        float32_t z0 = rBlock0.rotationZ[ laneIndex ];
+        float32_t w0 = rBlock0.rotationW[ laneIndex ];
+        float32_t x1 = rBlock1.rotationX[ laneIndex ];
+        float32_t y1 = rBlock1.rotationY[ laneIndex ];
+        float32_t z1 = rBlock1.rotationZ[ laneIndex ];
+        float32_t w1 = rBlock1.rotationW[ laneIndex ];
+
+        float32_t rotationWeight1 = ( x0 * x1 + y0 * y1 + z0 * z1 + w0 * w1 < 0.0f ? -weight1 : weight1 );
+        Simd::Quat rotation(
+            x0 * weight0 + x1 * rotationWeight1,
+            y0 * weight0 + y1 * rotationWeight1,
+            z0 * weight0 + z1 * rotationWeight1,
+            w0 * weight0 + w1 * rotationWeight1 );
+        rotation.Normalize();
+
+        rResult.rotationX[ laneIndex ] = rotation.GetElement( 0 );
+        rResult.rotationY[ laneIndex ] = rotation.GetElement( 1 );
+        rResult.rotationZ[ laneIndex ] = rotation.GetElement( 2 );
+        rResult.rotationW[ laneIndex ] = rotation.GetElement( 3 );
+
+        rResult.translationX[ laneIndex ] = rBlock0.translationX[ laneIndex ] * weight0 + rBlock1.translationX[ laneIndex ] * weight1;
+        rResult.translationY[ laneIndex ] = rBlock0.translationY[ laneIndex ] * weight0 + rBlock1.translationY[ laneIndex ] * weight1;
+        rResult.translationZ[ laneIndex ] = rBlock0.translationZ[ laneIndex ] * weight0 + rBlock1.translationZ[ laneIndex ] * weight1;
+        rResult.scaleX[ laneIndex ] = rBlock0.scaleX[ laneIndex ] * weight0 + rBlock1.scaleX[ laneIndex ] * weight1;
+        rResult.scaleY[ laneIndex ] = rBlock0.scaleY[ laneIndex ] * weight0 + rBlock1.scaleY[ laneIndex ] * weight1;
+        rResult.scaleZ[ laneIndex ] = rBlock0.scaleZ[ laneIndex ] * weight0 + rBlock1.scaleZ[ laneIndex ] * weight1;
+    }
+#endif
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "GraphicsTypes/GraphicsTypes.h"
+
+#include "MathSimd/Matrix44.h"
+#include "MathSimd/Quat.h"
+#include "MathSimd/Vector3.h"
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    /// Local-space skeleton pose.
+    ///
+    /// Bone rotations, translations, and scales are stored in structure-of-arrays blocks of BLOCK_BONE_COUNT bones so
+    /// that sampling, blending, and transform generation can process several bones at once using QuatSoa,
+    /// Vector3Soa, and Matrix44Soa.  Unused lanes in the last block are kept at the identity transform.
+    class HELIUM_GRAPHICS_TYPES_API AnimationPose
+    {
+    public:
+        /// Number of bones stored in each pose block.
+        static const size_t BLOCK_BONE_COUNT = 4;
+
+        /// Structure-of-arrays block of bone transforms.
+        HELIUM_SIMD_ALIGN_PRE struct Block
+        {
+            /// Rotation x-components.
+            float32_t rotationX[ BLOCK_BONE_COUNT ];
+            /// Rotation y-components.
+            float32_t rotationY[ BLOCK_BONE_COUNT ];
+            /// Rotation z-components.
+            float32_t rotationZ[ BLOCK_BONE_COUNT ];
+            /// Rotation w-components.
+            float32_t rotationW[ BLOCK_BONE_COUNT ];
+            /// Translation x-components.
+            float32_t translationX[ BLOCK_BONE_COUNT ];
+            /// Translation y-components.
+            float32_t translationY[ BLOCK_BONE_COUNT ];
+            /// Translation z-components.
+            float32_t translationZ[ BLOCK_BONE_COUNT ];
+            /// Scale x-components.
+            float32_t scaleX[ BLOCK_BONE_COUNT ];
+            /// Scale y-components.
+            float32_t scaleY[ BLOCK_BONE_COUNT ];
+            /// Scale z-components.
+            float32_t scaleZ[ BLOCK_BONE_COUNT ];
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// @name Construction/Destruction
+        //@{
+        AnimationPose();
+        //@}
+
+        /// @name Pose Initialization
+        //@{
+        void SetBoneCount( uint8_t boneCount );
+        void SetIdentity();
+        void SetReferencePose( const Simd::Matrix44* pReferencePose, uint8_t boneCount );
+        void CopyFrom( const AnimationPose& rSource );
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline uint8_t GetBoneCount() const;
+        inline size_t GetBlockCount() const;
+        inline Block* GetBlocks();
+        inline const Block* GetBlocks() const;
+
+        void SetBoneTransform(
+            uint8_t boneIndex, const Simd::Quat& rRotation, const Simd::Vector3& rTranslation,
+            const Simd::Vector3& rScale );
+        void GetBoneTransform(
+            uint8_t boneIndex, Simd::Quat& rRotation, Simd::Vector3& rTranslation, Simd::Vector3& rScale ) const;
+        //@}
+
+        /// @name Pose Operations
+        //@{
+        void Blend( const AnimationPose& rPose0, const AnimationPose& rPose1, float32_t weight );
+        void ComputeModelTransforms( const uint8_t* pParentBoneIndices, Simd::Matrix44* pModelTransforms ) const;
+        //@}
+
+        /// @name Static Utility Functions
+        //@{
+        static void InterpolateBlock( const Block& rBlock0, const Block& rBlock1, const float32_t* pWeights, Block& rResult );
+        //@}
+
+    private:
+        /// Transform blocks.
+        DynamicArray< Block > m_blocks;
+        /// Number of bones in the pose.
+        uint8_t m_boneCount;
+    };
+}
+
+#include "GraphicsTypes/AnimationPose.inl"
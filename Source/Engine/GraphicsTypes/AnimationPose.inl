@@ -0,0 +1,42 @@
+namespace Helium
+{
+    /// Get the number of bones in this pose.
+    ///
+    /// @return  Bone count.
+    ///
+    /// @see GetBlockCount(), SetBoneCount()
+    uint8_t AnimationPose::GetBoneCount() const
+    {
+        return m_boneCount;
+    }
+
+    /// Get the number of transform blocks used to store this pose.
+    ///
+    /// @return  Block count.
+    ///
+    /// @see GetBlocks(), GetBoneCount()
+    size_t AnimationPose::GetBlockCount() const
+    {
+        return m_blocks.GetSize();
+    }
+
+    /// Get the transform blocks for this pose.
+    ///
+    /// @return  Transform blocks.
+    ///
+    /// @see GetBlockCount()
+    AnimationPose::Block* AnimationPose::GetBlocks()
+    {
+        return m_blocks.GetData();
+    }
+
+    /// Get the transform blocks for this pose.
+    ///
+    /// @return  Transform blocks.
+    ///
+    /// @see GetBlockCount()
+    const AnimationPose::Block* AnimationPose::GetBlocks() const
+    {
+        return m_blocks.GetData();
+    }
+}
@@ -43,6 +43,18 @@ void GraphicsSceneObject::SetWorldBounds( const Simd::AaBox& rBox )
     m_worldSphere.Set( rBox );
 }
 
+/// Set the world-space axis-aligned bounding box for this instance along with a precomputed bounding sphere.
+///
+/// @param[in] rBox     World-space axis-aligned bounding box to set.
+/// @param[in] rSphere  World-space bounding sphere encompassing the given box.
+///
+/// @see GetWorldBox(), GetWorldSphere()
+void GraphicsSceneObject::SetWorldBounds( const Simd::AaBox& rBox, const Simd::Sphere& rSphere )
+{
+    m_worldBox = rBox;
+    m_worldSphere = rSphere;
+}
+
 /// Set the instance vertex information.
 ///
 /// @param[in] pVertexBuffer       Vertex buffer to set.
@@ -130,6 +142,21 @@ void GraphicsSceneObject::SetNeedsUpdate( EUpdate updateMode )
     }
 }
 
+/// Default constructor.
+///
+/// The parent scene object ID is left invalid.  This is only used for the sub-mesh copies stored in render snapshots,
+/// which have their scene object ID assigned by the graphics scene.
+GraphicsSceneObject::SubMeshData::SubMeshData()
+: m_pSkinningPaletteMap( NULL )
+, m_primitiveType( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST )
+, m_primitiveCount( 0 )
+, m_startVertex( 0 )
+, m_vertexRange( 0 )
+, m_startIndex( 0 )
+{
+    SetInvalid( m_sceneObjectId );
+}
+
 /// Constructor.
 ///
 /// @param[in] sceneObjectId  ID of the parent graphics scene object used to control the placement of this object as
@@ -45,9 +45,13 @@ namespace Helium
         /// Data specific to sub-meshes.
         class HELIUM_GRAPHICS_TYPES_API SubMeshData
         {
+            /// Graphics scene copies sub-mesh data into render snapshots with a remapped scene object ID.
+            friend class GraphicsScene;
+
         public:
             /// @name Construction/Destruction
             //@{
+            SubMeshData();
             explicit SubMeshData( size_t sceneObjectId );
             //@}
 
@@ -101,6 +105,7 @@ namespace Helium
         //@{
         void SetTransform( const Simd::Matrix44& rTransform );
         void SetWorldBounds( const Simd::AaBox& rBox );
+        void SetWorldBounds( const Simd::AaBox& rBox, const Simd::Sphere& rSphere );
         void SetVertexData( RVertexBuffer* pVertexBuffer, RVertexDescription* pVertexDescription, uint32_t vertexStride );
         void SetIndexBuffer( RIndexBuffer* pIndexBuffer );
 
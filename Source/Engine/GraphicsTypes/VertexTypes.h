@@ -13,6 +13,10 @@ namespace Helium
     /// Data/Shaders/Common.inl).
     static const size_t BONE_COUNT_MAX = 75;
 
+    /// Texture coordinate semantic index of the first per-instance transform row in InstanceVertex data (must match
+    /// the instance input semantics used by shaders supporting the INSTANCING system toggle).
+    static const size_t INSTANCE_TRANSFORM_TEXCOORD_INDEX = 4;
+
     /// Simple vertex type (position and color only).
     struct HELIUM_GRAPHICS_TYPES_API SimpleVertex
     {
@@ -116,6 +120,26 @@ namespace Helium
         Float16 texCoords[ TexCoordSetCount ][ 2 ];
     };
 
+    /// Static mesh vertex type with quantized positions.
+    ///
+    /// Positions are stored as normalized 16-bit integers relative to the mesh bounds (see
+    /// Mesh::GetPositionQuantization()).  The fourth position component is always set to the maximum value so that
+    /// it is read as 1.0 by the GPU.  All other data is stored the same as in StaticMeshVertex.
+    template< size_t TexCoordSetCount >
+    struct QuantizedStaticMeshVertex
+    {
+        /// Quantized position.
+        int16_t position[ 4 ];
+        /// Normal.
+        uint8_t normal[ 4 ];
+        /// Tangent.
+        uint8_t tangent[ 4 ];
+        /// Color.
+        uint8_t color[ 4 ];
+        /// Texture coordinates.
+        Float16 texCoords[ TexCoordSetCount ][ 2 ];
+    };
+
     /// Skinned mesh vertex type.
     ///
     /// Note that no vertex coloring and only one texture coordinate set are supported.  This is done in order to
@@ -135,6 +159,14 @@ namespace Helium
         /// Texture coordinates.
         Float16 texCoords[ 2 ];
     };
+
+    /// Per-instance vertex data for hardware instanced mesh rendering.
+    struct InstanceVertex
+    {
+        /// World transform, stored as the rows of a transposed 3x4 matrix (the same layout used for per-instance
+        /// vertex constant buffer data).
+        float32_t transform[ 3 ][ 4 ];
+    };
 }
 
 #include "GraphicsTypes/VertexTypes.inl"
@@ -10,6 +10,7 @@ namespace Helium
         class Plane;
         struct AaBox;
         class Sphere;
+        class Vector3Soa;
 
         /// View frustum.
         HELIUM_SIMD_ALIGN_PRE class HELIUM_MATH_SIMD_API Frustum
@@ -57,8 +58,10 @@ namespace Helium
             /// @name Testing
             //@{
             bool Contains( const Vector3& rPoint ) const;
+            bool Contains( const AaBox& rBox ) const;
             bool Intersects( const AaBox& rBox ) const;
             bool Intersects( const Sphere& rSphere ) const;
+            uint32_t IntersectsSpheres( const Vector3Soa& rCenters, const Register& rRadii ) const;
             //@}
 
             /// @name Math
@@ -42,6 +42,51 @@ bool Helium::Simd::Frustum::Contains( const Vector3& rPoint ) const
     return true;
 }
 
+/// Test whether this frustum fully contains a given axis-aligned bounding box in world space.
+///
+/// @param[in] rBox  Box to test.
+///
+/// @return  True if the box is entirely within this frustum, false if not.
+bool Helium::Simd::Frustum::Contains( const AaBox& rBox ) const
+{
+    Helium::Simd::Register boxMinVec = rBox.GetMinimum().GetSimdVector();
+    Helium::Simd::Register boxMaxVec = rBox.GetMaximum().GetSimdVector();
+
+    Helium::Simd::Register boxX0 = _mm_shuffle_ps( boxMinVec, boxMinVec, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+    Helium::Simd::Register boxX1 = _mm_shuffle_ps( boxMaxVec, boxMaxVec, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+    Helium::Simd::Register boxY = _mm_shuffle_ps( boxMinVec, boxMaxVec, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+    Helium::Simd::Register boxZ = _mm_unpackhi_ps( boxMinVec, boxMaxVec );
+    boxZ = _mm_movelh_ps( boxZ, boxZ );
+
+    PlaneSoa plane;
+    Vector3Soa points( boxX0, boxY, boxZ );
+    Helium::Simd::Register zeroVec = Helium::Simd::LoadZeros();
+
+    size_t planeCount = ( m_bInfiniteFarClip ? PLANE_FAR : PLANE_MAX );
+    for( size_t planeIndex = 0; planeIndex < planeCount; ++planeIndex )
+    {
+        plane.Load1Splat(
+            m_planeA + planeIndex,
+            m_planeB + planeIndex,
+            m_planeC + planeIndex,
+            m_planeD + planeIndex );
+
+        points.m_x = boxX0;
+        Helium::Simd::Mask containsPoints0 = Helium::Simd::GreaterEqualsF32( plane.GetDistance( points ), zeroVec );
+
+        points.m_x = boxX1;
+        Helium::Simd::Mask containsPoints1 = Helium::Simd::GreaterEqualsF32( plane.GetDistance( points ), zeroVec );
+
+        int resultMask = _mm_movemask_ps( Helium::Simd::MaskAnd( containsPoints0, containsPoints1 ) );
+        if( resultMask != 0xf )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /// Test whether this frustum intersects a given axis-aligned bounding box in world space.
 ///
 /// @param[in] rBox  Box to test.
@@ -124,6 +169,43 @@ bool Helium::Simd::Frustum::Intersects( const Sphere& rSphere ) const
     return true;
 }
 
+/// Test whether this frustum intersects each of a set of spheres in world space.
+///
+/// Spheres are tested in batches of four, with the sphere centers and radii stored in struct-of-arrays format.
+///
+/// @param[in] rCenters  Sphere centers.
+/// @param[in] rRadii    Sphere radii.
+///
+/// @return  Bit mask in which each of the lowest four bits are set if the sphere in the corresponding SIMD lane
+///          intersects this frustum.
+uint32_t Helium::Simd::Frustum::IntersectsSpheres( const Vector3Soa& rCenters, const Register& rRadii ) const
+{
+    Helium::Simd::Register zeroVec = Helium::Simd::LoadZeros();
+    PlaneSoa plane;
+
+    plane.Load1Splat( m_planeA, m_planeB, m_planeC, m_planeD );
+    Helium::Simd::Mask intersects = Helium::Simd::GreaterEqualsF32(
+        Helium::Simd::AddF32( plane.GetDistance( rCenters ), rRadii ),
+        zeroVec );
+
+    size_t planeCount = ( m_bInfiniteFarClip ? PLANE_FAR : PLANE_MAX );
+    for( size_t planeIndex = 1; planeIndex < planeCount; ++planeIndex )
+    {
+        plane.Load1Splat(
+            m_planeA + planeIndex,
+            m_planeB + planeIndex,
+            m_planeC + planeIndex,
+            m_planeD + planeIndex );
+
+        Helium::Simd::Mask insidePlane = Helium::Simd::GreaterEqualsF32(
+            Helium::Simd::AddF32( plane.GetDistance( rCenters ), rRadii ),
+            zeroVec );
+        intersects = Helium::Simd::MaskAnd( intersects, insidePlane );
+    }
+
+    return static_cast< uint32_t >( _mm_movemask_ps( intersects ) );
+}
+
 /// Compute the corners of this view frustum.
 ///
 /// A view frustum can have either four or eight corners depending on whether a far clip plane exists (eight
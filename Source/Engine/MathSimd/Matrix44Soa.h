@@ -129,6 +129,14 @@ namespace Helium
                 float32_t* pTranslateX, float32_t* pTranslateY, float32_t* pTranslateZ, float32_t* pTranslateW ) const;
 
             inline void Splat( const Matrix44& rMatrix );
+
+            inline void Gather(
+                const Matrix44& rMatrix0, const Matrix44& rMatrix1, const Matrix44& rMatrix2,
+                const Matrix44& rMatrix3 );
+            inline void Scatter(
+                Matrix44& rMatrix0, Matrix44& rMatrix1, Matrix44& rMatrix2, Matrix44& rMatrix3 ) const;
+            inline void ScatterTransposed43(
+                float32_t* pDest0, float32_t* pDest1, float32_t* pDest2, float32_t* pDest3 ) const;
             //@}
 
             /// @name Data Access
@@ -22,4 +22,116 @@ void Helium::Simd::Matrix44Soa::Splat( const Matrix44& rMatrix )
 #undef SPLAT_ROW
 }
 
+/// Load the components of four matrices, one into each SIMD vector lane.
+///
+/// @param[in] rMatrix0  Matrix to load into the first lane.
+/// @param[in] rMatrix1  Matrix to load into the second lane.
+/// @param[in] rMatrix2  Matrix to load into the third lane.
+/// @param[in] rMatrix3  Matrix to load into the fourth lane.
+///
+/// @see Scatter(), ScatterTransposed43()
+void Helium::Simd::Matrix44Soa::Gather(
+    const Matrix44& rMatrix0,
+    const Matrix44& rMatrix1,
+    const Matrix44& rMatrix2,
+    const Matrix44& rMatrix3 )
+{
+    Register row0, row1, row2, row3;
+
+#define GATHER_ROW( N ) \
+    row0 = rMatrix0.GetSimdVector( N ); \
+    row1 = rMatrix1.GetSimdVector( N ); \
+    row2 = rMatrix2.GetSimdVector( N ); \
+    row3 = rMatrix3.GetSimdVector( N ); \
+    _MM_TRANSPOSE4_PS( row0, row1, row2, row3 ); \
+    m_matrix[ N ][ 0 ] = row0; \
+    m_matrix[ N ][ 1 ] = row1; \
+    m_matrix[ N ][ 2 ] = row2; \
+    m_matrix[ N ][ 3 ] = row3;
+
+    GATHER_ROW( 0 );
+    GATHER_ROW( 1 );
+    GATHER_ROW( 2 );
+    GATHER_ROW( 3 );
+
+#undef GATHER_ROW
+}
+
+/// Store the matrix in each SIMD vector lane into a separate matrix.
+///
+/// @param[out] rMatrix0  Matrix in which to store the first lane.
+/// @param[out] rMatrix1  Matrix in which to store the second lane.
+/// @param[out] rMatrix2  Matrix in which to store the third lane.
+/// @param[out] rMatrix3  Matrix in which to store the fourth lane.
+///
+/// @see Gather(), ScatterTransposed43()
+void Helium::Simd::Matrix44Soa::Scatter(
+    Matrix44& rMatrix0,
+    Matrix44& rMatrix1,
+    Matrix44& rMatrix2,
+    Matrix44& rMatrix3 ) const
+{
+    Register row0, row1, row2, row3;
+
+#define SCATTER_ROW( N ) \
+    row0 = m_matrix[ N ][ 0 ]; \
+    row1 = m_matrix[ N ][ 1 ]; \
+    row2 = m_matrix[ N ][ 2 ]; \
+    row3 = m_matrix[ N ][ 3 ]; \
+    _MM_TRANSPOSE4_PS( row0, row1, row2, row3 ); \
+    rMatrix0.SetSimdVector( N, row0 ); \
+    rMatrix1.SetSimdVector( N, row1 ); \
+    rMatrix2.SetSimdVector( N, row2 ); \
+    rMatrix3.SetSimdVector( N, row3 );
+
+    SCATTER_ROW( 0 );
+    SCATTER_ROW( 1 );
+    SCATTER_ROW( 2 );
+    SCATTER_ROW( 3 );
+
+#undef SCATTER_ROW
+}
+
+/// Store the matrix in each SIMD vector lane as a transposed 4x3 matrix (three rows of four values containing the
+/// first three columns of the matrix), the layout commonly used for shader constants.
+///
+/// Destination addresses do not need to be aligned.
+///
+/// @param[out] pDest0  Address at which to store the 12 values for the matrix in the first lane.
+/// @param[out] pDest1  Address at which to store the 12 values for the matrix in the second lane.
+/// @param[out] pDest2  Address at which to store the 12 values for the matrix in the third lane.
+/// @param[out] pDest3  Address at which to store the 12 values for the matrix in the fourth lane.
+///
+/// @see Gather(), Scatter()
+void Helium::Simd::Matrix44Soa::ScatterTransposed43(
+    float32_t* pDest0,
+    float32_t* pDest1,
+    float32_t* pDest2,
+    float32_t* pDest3 ) const
+{
+    HELIUM_ASSERT( pDest0 );
+    HELIUM_ASSERT( pDest1 );
+    HELIUM_ASSERT( pDest2 );
+    HELIUM_ASSERT( pDest3 );
+
+    Register column0, column1, column2, column3;
+
+#define SCATTER_COLUMN( N ) \
+    column0 = m_matrix[ 0 ][ N ]; \
+    column1 = m_matrix[ 1 ][ N ]; \
+    column2 = m_matrix[ 2 ][ N ]; \
+    column3 = m_matrix[ 3 ][ N ]; \
+    _MM_TRANSPOSE4_PS( column0, column1, column2, column3 ); \
+    Simd::StoreUnaligned( pDest0 + N * 4, column0 ); \
+    Simd::StoreUnaligned( pDest1 + N * 4, column1 ); \
+    Simd::StoreUnaligned( pDest2 + N * 4, column2 ); \
+    Simd::StoreUnaligned( pDest3 + N * 4, column3 );
+
+    SCATTER_COLUMN( 0 );
+    SCATTER_COLUMN( 1 );
+    SCATTER_COLUMN( 2 );
+
+#undef SCATTER_COLUMN
+}
+
 #endif  // HELIUM_SIMD_SSE
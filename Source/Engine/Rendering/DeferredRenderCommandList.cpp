@@ -0,0 +1,331 @@
+#include "Precompile.h"
+#include "Rendering/DeferredRenderCommandList.h"
+
+#include "Rendering/RRenderCommandProxy.h"
+
+using namespace Helium;
+
+/// Size of each command header in the command buffer (padded to keep payloads aligned).
+static const size_t COMMAND_HEADER_SIZE = DeferredRenderCommandList::AlignCommandSize(
+	sizeof( DeferredRenderCommandList::CommandHeader ) );
+
+/// Constructor.
+DeferredRenderCommandList::DeferredRenderCommandList()
+	: m_commandCount( 0 )
+{
+}
+
+/// Destructor.
+DeferredRenderCommandList::~DeferredRenderCommandList()
+{
+}
+
+/// Record a command that has no payload.
+///
+/// @param[in] command  Command type.
+void DeferredRenderCommandList::NewCommand( ECommand command )
+{
+	HELIUM_VERIFY( AllocateCommand( command, 0 ) );
+}
+
+/// Hold a reference to a resource used by a recorded command until this list is reset or destroyed.
+///
+/// @param[in] pResource  Resource to reference (can be null, in which case nothing is done).
+void DeferredRenderCommandList::AddResourceReference( RRenderResource* pResource )
+{
+	if( pResource )
+	{
+		m_resourceReferences.New( pResource );
+	}
+}
+
+/// Reserve space in the command buffer.
+///
+/// Reserving space ahead of recording avoids reallocating the command buffer as it grows.  Since lists are
+/// typically recorded with a similar set of commands each frame, the size of the previous frame's list is usually a
+/// good estimate.
+///
+/// @param[in] bufferSize  Command buffer size to reserve, in bytes.
+void DeferredRenderCommandList::Reserve( size_t bufferSize )
+{
+	m_buffer.Reserve( bufferSize );
+}
+
+/// Remove all recorded commands and release all resource references, keeping the command buffer memory for reuse.
+void DeferredRenderCommandList::Reset()
+{
+	m_buffer.Resize( 0 );
+	m_resourceReferences.Resize( 0 );
+	m_commandCount = 0;
+}
+
+/// Replay the recorded commands, in order, on another command proxy.
+///
+/// @param[in] pCommandProxy  Command proxy on which to issue the commands (typically the renderer's immediate command
+///                           proxy).
+void DeferredRenderCommandList::Execute( RRenderCommandProxy* pCommandProxy ) const
+{
+	HELIUM_ASSERT( pCommandProxy );
+
+	const uint8_t* pCommand = m_buffer.GetData();
+	const uint8_t* pBufferEnd = pCommand + m_buffer.GetSize();
+	while( pCommand < pBufferEnd )
+	{
+		const CommandHeader* pHeader = reinterpret_cast< const CommandHeader* >( pCommand );
+		HELIUM_ASSERT( pHeader->size >= COMMAND_HEADER_SIZE );
+		HELIUM_ASSERT( pCommand + pHeader->size <= pBufferEnd );
+
+		const void* pPayload = pCommand + COMMAND_HEADER_SIZE;
+
+		switch( pHeader->type )
+		{
+		case COMMAND_SET_RASTERIZER_STATE:
+		{
+			const SetRasterizerStateCommand* pData = static_cast< const SetRasterizerStateCommand* >( pPayload );
+			pCommandProxy->SetRasterizerState( pData->pState );
+
+			break;
+		}
+
+		case COMMAND_SET_BLEND_STATE:
+		{
+			const SetBlendStateCommand* pData = static_cast< const SetBlendStateCommand* >( pPayload );
+			pCommandProxy->SetBlendState( pData->pState );
+
+			break;
+		}
+
+		case COMMAND_SET_DEPTH_STENCIL_STATE:
+		{
+			const SetDepthStencilStateCommand* pData = static_cast< const SetDepthStencilStateCommand* >( pPayload );
+			pCommandProxy->SetDepthStencilState( pData->pState, pData->stencilReferenceValue );
+
+			break;
+		}
+
+		case COMMAND_SET_SAMPLER_STATES:
+		{
+			const SetSamplerStatesCommand* pData = static_cast< const SetSamplerStatesCommand* >( pPayload );
+			RSamplerState* const* ppStates = reinterpret_cast< RSamplerState* const* >( pData + 1 );
+			pCommandProxy->SetSamplerStates( pData->startIndex, pData->samplerCount, ppStates );
+
+			break;
+		}
+
+		case COMMAND_SET_RENDER_SURFACES:
+		{
+			const SetRenderSurfacesCommand* pData = static_cast< const SetRenderSurfacesCommand* >( pPayload );
+			pCommandProxy->SetRenderSurfaces( pData->pRenderTargetSurface, pData->pDepthStencilSurface );
+
+			break;
+		}
+
+		case COMMAND_SET_VIEWPORT:
+		{
+			const SetViewportCommand* pData = static_cast< const SetViewportCommand* >( pPayload );
+			pCommandProxy->SetViewport( pData->x, pData->y, pData->width, pData->height );
+
+			break;
+		}
+
+		case COMMAND_BEGIN_SCENE:
+		{
+			pCommandProxy->BeginScene();
+
+			break;
+		}
+
+		case COMMAND_END_SCENE:
+		{
+			pCommandProxy->EndScene();
+
+			break;
+		}
+
+		case COMMAND_CLEAR:
+		{
+			const ClearCommand* pData = static_cast< const ClearCommand* >( pPayload );
+			pCommandProxy->Clear( pData->clearFlags, pData->color, pData->depth, pData->stencil );
+
+			break;
+		}
+
+		case COMMAND_SET_INDEX_BUFFER:
+		{
+			const SetIndexBufferCommand* pData = static_cast< const SetIndexBufferCommand* >( pPayload );
+			pCommandProxy->SetIndexBuffer( pData->pBuffer );
+
+			break;
+		}
+
+		case COMMAND_SET_VERTEX_BUFFERS:
+		{
+			const SetVertexBuffersCommand* pData = static_cast< const SetVertexBuffersCommand* >( pPayload );
+			size_t bufferCount = pData->bufferCount;
+			RVertexBuffer* const* ppBuffers = reinterpret_cast< RVertexBuffer* const* >( pData + 1 );
+			uint32_t* pStrides = const_cast< uint32_t* >(
+				reinterpret_cast< const uint32_t* >( ppBuffers + bufferCount ) );
+			uint32_t* pOffsets = pStrides + bufferCount;
+			pCommandProxy->SetVertexBuffers( pData->startIndex, bufferCount, ppBuffers, pStrides, pOffsets );
+
+			break;
+		}
+
+		case COMMAND_SET_VERTEX_INPUT_LAYOUT:
+		{
+			const SetVertexInputLayoutCommand* pData = static_cast< const SetVertexInputLayoutCommand* >( pPayload );
+			pCommandProxy->SetVertexInputLayout( pData->pLayout );
+
+			break;
+		}
+
+		case COMMAND_SET_VERTEX_SHADER:
+		{
+			const SetVertexShaderCommand* pData = static_cast< const SetVertexShaderCommand* >( pPayload );
+			pCommandProxy->SetVertexShader( pData->pShader );
+
+			break;
+		}
+
+		case COMMAND_SET_PIXEL_SHADER:
+		{
+			const SetPixelShaderCommand* pData = static_cast< const SetPixelShaderCommand* >( pPayload );
+			pCommandProxy->SetPixelShader( pData->pShader );
+
+			break;
+		}
+
+		case COMMAND_SET_VERTEX_CONSTANT_BUFFERS:
+		case COMMAND_SET_PIXEL_CONSTANT_BUFFERS:
+		{
+			const SetConstantBuffersCommand* pData = static_cast< const SetConstantBuffersCommand* >( pPayload );
+			size_t bufferCount = pData->bufferCount;
+			RConstantBuffer* const* ppBuffers = reinterpret_cast< RConstantBuffer* const* >( pData + 1 );
+			const size_t* pLimitSizes = reinterpret_cast< const size_t* >( ppBuffers + bufferCount );
+			const uint32_t* pOffsets = reinterpret_cast< const uint32_t* >( pLimitSizes + bufferCount );
+			const uint32_t* pSizes = pOffsets + bufferCount;
+
+			if( pHeader->type == COMMAND_SET_VERTEX_CONSTANT_BUFFERS )
+			{
+				pCommandProxy->SetVertexConstantBuffers(
+					pData->startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes );
+			}
+			else
+			{
+				pCommandProxy->SetPixelConstantBuffers(
+					pData->startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes );
+			}
+
+			break;
+		}
+
+		case COMMAND_SET_TEXTURE:
+		{
+			const SetTextureCommand* pData = static_cast< const SetTextureCommand* >( pPayload );
+			pCommandProxy->SetTexture( pData->samplerIndex, pData->pTexture );
+
+			break;
+		}
+
+		case COMMAND_DRAW_INDEXED:
+		{
+			const DrawIndexedCommand* pData = static_cast< const DrawIndexedCommand* >( pPayload );
+			pCommandProxy->DrawIndexed(
+				static_cast< ERendererPrimitiveType >( pData->primitiveType ),
+				pData->baseVertexIndex,
+				pData->minIndex,
+				pData->usedVertexCount,
+				pData->startIndex,
+				pData->primitiveCount );
+
+			break;
+		}
+
+		case COMMAND_DRAW_INDEXED_INSTANCED:
+		{
+			const DrawIndexedInstancedCommand* pData = static_cast< const DrawIndexedInstancedCommand* >( pPayload );
+			pCommandProxy->DrawIndexedInstanced(
+				static_cast< ERendererPrimitiveType >( pData->primitiveType ),
+				pData->baseVertexIndex,
+				pData->minIndex,
+				pData->usedVertexCount,
+				pData->startIndex,
+				pData->primitiveCount,
+				pData->instanceCount );
+
+			break;
+		}
+
+		case COMMAND_DRAW_UNINDEXED:
+		{
+			const DrawUnindexedCommand* pData = static_cast< const DrawUnindexedCommand* >( pPayload );
+			pCommandProxy->DrawUnindexed(
+				static_cast< ERendererPrimitiveType >( pData->primitiveType ),
+				pData->baseVertexIndex,
+				pData->primitiveCount );
+
+			break;
+		}
+
+		case COMMAND_SET_FENCE:
+		{
+			const SetFenceCommand* pData = static_cast< const SetFenceCommand* >( pPayload );
+			pCommandProxy->SetFence( pData->pFence );
+
+			break;
+		}
+
+		case COMMAND_UNBIND_RESOURCES:
+		{
+			pCommandProxy->UnbindResources();
+
+			break;
+		}
+
+		case COMMAND_EXECUTE_COMMAND_LIST:
+		{
+			const ExecuteCommandListCommand* pData = static_cast< const ExecuteCommandListCommand* >( pPayload );
+			pCommandProxy->ExecuteCommandList( pData->pCommandList );
+
+			break;
+		}
+
+		default:
+		{
+			HELIUM_BREAK_MSG( "DeferredRenderCommandList: Invalid command type encountered during playback" );
+
+			return;
+		}
+		}
+
+		pCommand += pHeader->size;
+	}
+}
+
+/// Allocate space for a new command record at the end of the command buffer and write its header.
+///
+/// @param[in] command      Command type.
+/// @param[in] payloadSize  Size of the command payload, in bytes.
+///
+/// @return  Pointer to the command payload.
+void* DeferredRenderCommandList::AllocateCommand( ECommand command, size_t payloadSize )
+{
+	HELIUM_ASSERT( static_cast< size_t >( command ) < static_cast< size_t >( COMMAND_MAX ) );
+
+	size_t recordSize = COMMAND_HEADER_SIZE + AlignCommandSize( payloadSize );
+	HELIUM_ASSERT( recordSize <= UINT16_MAX );
+
+	size_t recordOffset = m_buffer.GetSize();
+	m_buffer.Resize( recordOffset + recordSize );
+
+	uint8_t* pRecord = m_buffer.GetData() + recordOffset;
+	HELIUM_ASSERT( ( reinterpret_cast< uintptr_t >( pRecord ) & ( COMMAND_ALIGNMENT - 1 ) ) == 0 );
+
+	CommandHeader* pHeader = reinterpret_cast< CommandHeader* >( pRecord );
+	pHeader->type = static_cast< uint16_t >( command );
+	pHeader->size = static_cast< uint16_t >( recordSize );
+
+	++m_commandCount;
+
+	return pRecord + COMMAND_HEADER_SIZE;
+}
@@ -0,0 +1,358 @@
+#pragma once
+
+#include "Rendering/RRenderCommandList.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Math/Color.h"
+#include "Rendering/RendererTypes.h"
+
+namespace Helium
+{
+    class RRasterizerState;
+    class RBlendState;
+    class RDepthStencilState;
+    class RSamplerState;
+
+    class RSurface;
+    class RIndexBuffer;
+    class RVertexBuffer;
+    class RVertexInputLayout;
+
+    class RVertexShader;
+    class RPixelShader;
+
+    class RConstantBuffer;
+    class RTexture;
+
+    class RFence;
+
+    class RRenderCommandProxy;
+
+    HELIUM_DECLARE_RPTR( DeferredRenderCommandList );
+
+    /// Backend-independent render command list.
+    ///
+    /// Commands are encoded as plain data records in a single linear buffer, each made up of a small header followed
+    /// by a command-specific payload (and any variable-length arrays the command needs).  Resources referenced by the
+    /// commands are held by the list until it is reset or destroyed, so a list can safely be executed after the code
+    /// that recorded it has released its own references.
+    ///
+    /// Lists are filled through a DeferredRenderCommandProxy, and replayed in recording order by passing them to
+    /// RRenderCommandProxy::ExecuteCommandList() on the immediate command proxy of any renderer.  A single list must
+    /// only be written by one thread at a time, but separate lists can be recorded concurrently (for example, one per
+    /// render pass or per range of sorted draw calls) and then executed one after another on the render thread.
+    class HELIUM_RENDERING_API DeferredRenderCommandList : public RRenderCommandList
+    {
+    public:
+        /// Command types.
+        enum ECommand
+        {
+            /// Set rasterizer state.
+            COMMAND_SET_RASTERIZER_STATE,
+            /// Set blend state.
+            COMMAND_SET_BLEND_STATE,
+            /// Set depth-stencil state.
+            COMMAND_SET_DEPTH_STENCIL_STATE,
+            /// Set sampler states.
+            COMMAND_SET_SAMPLER_STATES,
+            /// Set render surfaces.
+            COMMAND_SET_RENDER_SURFACES,
+            /// Set viewport.
+            COMMAND_SET_VIEWPORT,
+            /// Begin scene.
+            COMMAND_BEGIN_SCENE,
+            /// End scene.
+            COMMAND_END_SCENE,
+            /// Clear.
+            COMMAND_CLEAR,
+            /// Set index buffer.
+            COMMAND_SET_INDEX_BUFFER,
+            /// Set vertex buffers.
+            COMMAND_SET_VERTEX_BUFFERS,
+            /// Set vertex input layout.
+            COMMAND_SET_VERTEX_INPUT_LAYOUT,
+            /// Set vertex shader.
+            COMMAND_SET_VERTEX_SHADER,
+            /// Set pixel shader.
+            COMMAND_SET_PIXEL_SHADER,
+            /// Set vertex constant buffers.
+            COMMAND_SET_VERTEX_CONSTANT_BUFFERS,
+            /// Set pixel constant buffers.
+            COMMAND_SET_PIXEL_CONSTANT_BUFFERS,
+            /// Set texture.
+            COMMAND_SET_TEXTURE,
+            /// Draw indexed primitives.
+            COMMAND_DRAW_INDEXED,
+            /// Draw indexed, instanced primitives.
+            COMMAND_DRAW_INDEXED_INSTANCED,
+            /// Draw unindexed primitives.
+            COMMAND_DRAW_UNINDEXED,
+            /// Set fence.
+            COMMAND_SET_FENCE,
+            /// Unbind resources.
+            COMMAND_UNBIND_RESOURCES,
+            /// Execute a nested command list.
+            COMMAND_EXECUTE_COMMAND_LIST,
+
+            COMMAND_MAX
+        };
+
+        /// Alignment of each command record within the command buffer, in bytes.
+        static const size_t COMMAND_ALIGNMENT = 8;
+
+        /// Header preceding each command payload.
+        struct CommandHeader
+        {
+            /// Command type (ECommand value).
+            uint16_t type;
+            /// Total size of the command record, including this header and any padding, in bytes.
+            uint16_t size;
+        };
+
+        /// @name Command Payloads
+        //@{
+
+        /// Set rasterizer state command.
+        struct SetRasterizerStateCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_RASTERIZER_STATE;
+
+            RRasterizerState* pState;
+        };
+
+        /// Set blend state command.
+        struct SetBlendStateCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_BLEND_STATE;
+
+            RBlendState* pState;
+        };
+
+        /// Set depth-stencil state command.
+        struct SetDepthStencilStateCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_DEPTH_STENCIL_STATE;
+
+            RDepthStencilState* pState;
+            uint8_t stencilReferenceValue;
+        };
+
+        /// Set sampler states command (followed by an array of samplerCount sampler state pointers).
+        struct SetSamplerStatesCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_SAMPLER_STATES;
+
+            uint32_t startIndex;
+            uint32_t samplerCount;
+        };
+
+        /// Set render surfaces command.
+        struct SetRenderSurfacesCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_RENDER_SURFACES;
+
+            RSurface* pRenderTargetSurface;
+            RSurface* pDepthStencilSurface;
+        };
+
+        /// Set viewport command.
+        struct SetViewportCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_VIEWPORT;
+
+            uint32_t x;
+            uint32_t y;
+            uint32_t width;
+            uint32_t height;
+        };
+
+        /// Clear command.
+        struct ClearCommand
+        {
+            static const ECommand TYPE = COMMAND_CLEAR;
+
+            Color color;
+            float32_t depth;
+            uint32_t clearFlags;
+            uint8_t stencil;
+        };
+
+        /// Set index buffer command.
+        struct SetIndexBufferCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_INDEX_BUFFER;
+
+            RIndexBuffer* pBuffer;
+        };
+
+        /// Set vertex buffers command (followed by arrays of bufferCount vertex buffer pointers, strides, and offsets).
+        struct SetVertexBuffersCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_VERTEX_BUFFERS;
+
+            uint32_t startIndex;
+            uint32_t bufferCount;
+        };
+
+        /// Set vertex input layout command.
+        struct SetVertexInputLayoutCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_VERTEX_INPUT_LAYOUT;
+
+            RVertexInputLayout* pLayout;
+        };
+
+        /// Set vertex shader command.
+        struct SetVertexShaderCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_VERTEX_SHADER;
+
+            RVertexShader* pShader;
+        };
+
+        /// Set pixel shader command.
+        struct SetPixelShaderCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_PIXEL_SHADER;
+
+            RPixelShader* pShader;
+        };
+
+        /// Set constant buffers command (followed by arrays of bufferCount constant buffer pointers, limit sizes,
+        /// offsets, and sizes).
+        struct SetConstantBuffersCommand
+        {
+            uint32_t startIndex;
+            uint32_t bufferCount;
+        };
+
+        /// Set vertex constant buffers command.
+        struct SetVertexConstantBuffersCommand : SetConstantBuffersCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_VERTEX_CONSTANT_BUFFERS;
+        };
+
+        /// Set pixel constant buffers command.
+        struct SetPixelConstantBuffersCommand : SetConstantBuffersCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_PIXEL_CONSTANT_BUFFERS;
+        };
+
+        /// Set texture command.
+        struct SetTextureCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_TEXTURE;
+
+            RTexture* pTexture;
+            uint32_t samplerIndex;
+        };
+
+        /// Draw indexed command.
+        struct DrawIndexedCommand
+        {
+            static const ECommand TYPE = COMMAND_DRAW_INDEXED;
+
+            uint32_t primitiveType;
+            uint32_t baseVertexIndex;
+            uint32_t minIndex;
+            uint32_t usedVertexCount;
+            uint32_t startIndex;
+            uint32_t primitiveCount;
+        };
+
+        /// Draw indexed instanced command.
+        struct DrawIndexedInstancedCommand
+        {
+            static const ECommand TYPE = COMMAND_DRAW_INDEXED_INSTANCED;
+
+            uint32_t primitiveType;
+            uint32_t baseVertexIndex;
+            uint32_t minIndex;
+            uint32_t usedVertexCount;
+            uint32_t startIndex;
+            uint32_t primitiveCount;
+            uint32_t instanceCount;
+        };
+
+        /// Draw unindexed command.
+        struct DrawUnindexedCommand
+        {
+            static const ECommand TYPE = COMMAND_DRAW_UNINDEXED;
+
+            uint32_t primitiveType;
+            uint32_t baseVertexIndex;
+            uint32_t primitiveCount;
+        };
+
+        /// Set fence command.
+        struct SetFenceCommand
+        {
+            static const ECommand TYPE = COMMAND_SET_FENCE;
+
+            RFence* pFence;
+        };
+
+        /// Execute (nested) command list command.
+        struct ExecuteCommandListCommand
+        {
+            static const ECommand TYPE = COMMAND_EXECUTE_COMMAND_LIST;
+
+            RRenderCommandList* pCommandList;
+        };
+
+        //@}
+
+        /// @name Construction/Destruction
+        //@{
+        DeferredRenderCommandList();
+        //@}
+
+        /// @name Command Recording
+        //@{
+        template< typename T > T* NewCommand( size_t extraSize = 0 );
+        void NewCommand( ECommand command );
+
+        void AddResourceReference( RRenderResource* pResource );
+
+        void Reserve( size_t bufferSize );
+        void Reset();
+        //@}
+
+        /// @name Command Execution
+        //@{
+        void Execute( RRenderCommandProxy* pCommandProxy ) const;
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline size_t GetCommandCount() const;
+        inline size_t GetBufferSize() const;
+        inline bool IsEmpty() const;
+        //@}
+
+        /// @name Static Utility Functions
+        //@{
+        static inline size_t AlignCommandSize( size_t size );
+        //@}
+
+    private:
+        /// Encoded command buffer.
+        DynamicArray< uint8_t > m_buffer;
+        /// References to the resources used by the recorded commands.
+        DynamicArray< SmartPtr< RRenderResource > > m_resourceReferences;
+        /// Number of commands recorded.
+        size_t m_commandCount;
+
+        /// @name Construction/Destruction
+        //@{
+        ~DeferredRenderCommandList();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        void* AllocateCommand( ECommand command, size_t payloadSize );
+        //@}
+    };
+}
+
+#include "Rendering/DeferredRenderCommandList.inl"
@@ -0,0 +1,62 @@
+namespace Helium
+{
+    /// Allocate and record a new command.
+    ///
+    /// The returned payload is default-constructed, and must be filled out by the caller before the next command is
+    /// recorded (allocating another command may move the command buffer).
+    ///
+    /// @param[in] extraSize  Number of additional bytes to reserve immediately after the payload for variable-length
+    ///                       command data.
+    ///
+    /// @return  Pointer to the command payload.
+    ///
+    /// @see AddResourceReference()
+    template< typename T >
+    T* DeferredRenderCommandList::NewCommand( size_t extraSize )
+    {
+        void* pPayload = AllocateCommand( T::TYPE, sizeof( T ) + extraSize );
+        HELIUM_ASSERT( pPayload );
+
+        return new( pPayload ) T;
+    }
+
+    /// Get the number of commands recorded in this list.
+    ///
+    /// @return  Command count.
+    ///
+    /// @see GetBufferSize(), IsEmpty()
+    size_t DeferredRenderCommandList::GetCommandCount() const
+    {
+        return m_commandCount;
+    }
+
+    /// Get the size of the encoded command buffer.
+    ///
+    /// @return  Command buffer size, in bytes.
+    ///
+    /// @see GetCommandCount()
+    size_t DeferredRenderCommandList::GetBufferSize() const
+    {
+        return m_buffer.GetSize();
+    }
+
+    /// Get whether this list contains any commands.
+    ///
+    /// @return  True if no commands have been recorded, false if not.
+    ///
+    /// @see GetCommandCount()
+    bool DeferredRenderCommandList::IsEmpty() const
+    {
+        return ( m_commandCount == 0 );
+    }
+
+    /// Round a command record size up to the command buffer alignment.
+    ///
+    /// @param[in] size  Size to align, in bytes.
+    ///
+    /// @return  Aligned size.
+    size_t DeferredRenderCommandList::AlignCommandSize( size_t size )
+    {
+        return ( size + COMMAND_ALIGNMENT - 1 ) & ~( COMMAND_ALIGNMENT - 1 );
+    }
+}
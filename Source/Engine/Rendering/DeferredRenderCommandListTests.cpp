@@ -0,0 +1,388 @@
+#include "Rendering/DeferredRenderCommandList.h"
+#include "Rendering/DeferredRenderCommandProxy.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+namespace
+{
+	/// Command proxy that logs each call made to it, for checking the commands replayed from a command list.
+	class RecordingCommandProxy : public RRenderCommandProxy
+	{
+	public:
+		/// Logged command types.
+		enum ECall
+		{
+			CALL_SET_RASTERIZER_STATE,
+			CALL_SET_BLEND_STATE,
+			CALL_SET_DEPTH_STENCIL_STATE,
+			CALL_SET_SAMPLER_STATES,
+			CALL_SET_RENDER_SURFACES,
+			CALL_SET_VIEWPORT,
+			CALL_BEGIN_SCENE,
+			CALL_END_SCENE,
+			CALL_CLEAR,
+			CALL_SET_INDEX_BUFFER,
+			CALL_SET_VERTEX_BUFFERS,
+			CALL_SET_VERTEX_INPUT_LAYOUT,
+			CALL_SET_VERTEX_SHADER,
+			CALL_SET_PIXEL_SHADER,
+			CALL_SET_VERTEX_CONSTANT_BUFFERS,
+			CALL_SET_PIXEL_CONSTANT_BUFFERS,
+			CALL_SET_TEXTURE,
+			CALL_DRAW_INDEXED,
+			CALL_DRAW_INDEXED_INSTANCED,
+			CALL_DRAW_UNINDEXED,
+			CALL_SET_FENCE,
+			CALL_UNBIND_RESOURCES,
+			CALL_EXECUTE_COMMAND_LIST,
+		};
+
+		/// Logged command.
+		struct Call
+		{
+			/// Command type.
+			ECall type;
+			/// Command arguments, in declaration order.
+			uint32_t arguments[ 8 ];
+			/// Resource argument (if any).
+			const void* pResource;
+		};
+
+		/// Logged commands.
+		DynamicArray< Call > m_calls;
+
+		virtual void SetRasterizerState( RRasterizerState* pState ) override
+		{
+			Log( CALL_SET_RASTERIZER_STATE, pState );
+		}
+
+		virtual void SetBlendState( RBlendState* pState ) override
+		{
+			Log( CALL_SET_BLEND_STATE, pState );
+		}
+
+		virtual void SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue ) override
+		{
+			Log( CALL_SET_DEPTH_STENCIL_STATE, pState, stencilReferenceValue );
+		}
+
+		virtual void SetSamplerStates( size_t startIndex, size_t samplerCount, RSamplerState* const* /*ppStates*/ ) override
+		{
+			Log( CALL_SET_SAMPLER_STATES, NULL, startIndex, samplerCount );
+		}
+
+		virtual void SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* /*pDepthStencilSurface*/ ) override
+		{
+			Log( CALL_SET_RENDER_SURFACES, pRenderTargetSurface );
+		}
+
+		virtual void SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height ) override
+		{
+			Log( CALL_SET_VIEWPORT, NULL, x, y, width, height );
+		}
+
+		virtual void BeginScene() override
+		{
+			Log( CALL_BEGIN_SCENE );
+		}
+
+		virtual void EndScene() override
+		{
+			Log( CALL_END_SCENE );
+		}
+
+		virtual void Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil ) override
+		{
+			Log( CALL_CLEAR, NULL, clearFlags, rColor.GetArgb(), static_cast< uint32_t >( depth * 1000.0f ), stencil );
+		}
+
+		virtual void SetIndexBuffer( RIndexBuffer* pBuffer ) override
+		{
+			Log( CALL_SET_INDEX_BUFFER, pBuffer );
+		}
+
+		virtual void SetVertexBuffers(
+			size_t startIndex, size_t bufferCount, RVertexBuffer* const* /*ppBuffers*/, uint32_t* pStrides,
+			uint32_t* pOffsets ) override
+		{
+			Log(
+				CALL_SET_VERTEX_BUFFERS, NULL, startIndex, bufferCount, bufferCount ? pStrides[ 0 ] : 0,
+				bufferCount ? pOffsets[ 0 ] : 0 );
+		}
+
+		virtual void SetVertexInputLayout( RVertexInputLayout* pLayout ) override
+		{
+			Log( CALL_SET_VERTEX_INPUT_LAYOUT, pLayout );
+		}
+
+		virtual void SetVertexShader( RVertexShader* pShader ) override
+		{
+			Log( CALL_SET_VERTEX_SHADER, pShader );
+		}
+
+		virtual void SetPixelShader( RPixelShader* pShader ) override
+		{
+			Log( CALL_SET_PIXEL_SHADER, pShader );
+		}
+
+		virtual void SetVertexConstantBuffers(
+			size_t startIndex, size_t bufferCount, RConstantBuffer* const* /*ppBuffers*/, const size_t* pLimitSizes,
+			const uint32_t* pOffsets, const uint32_t* pSizes ) override
+		{
+			LogConstantBuffers( CALL_SET_VERTEX_CONSTANT_BUFFERS, startIndex, bufferCount, pLimitSizes, pOffsets, pSizes );
+		}
+
+		virtual void SetPixelConstantBuffers(
+			size_t startIndex, size_t bufferCount, RConstantBuffer* const* /*ppBuffers*/, const size_t* pLimitSizes,
+			const uint32_t* pOffsets, const uint32_t* pSizes ) override
+		{
+			LogConstantBuffers( CALL_SET_PIXEL_CONSTANT_BUFFERS, startIndex, bufferCount, pLimitSizes, pOffsets, pSizes );
+		}
+
+		virtual void SetTexture( size_t samplerIndex, RTexture* pTexture ) override
+		{
+			Log( CALL_SET_TEXTURE, pTexture, samplerIndex );
+		}
+
+		virtual void DrawIndexed(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount ) override
+		{
+			Log(
+				CALL_DRAW_INDEXED, NULL, primitiveType, baseVertexIndex, minIndex, usedVertexCount, startIndex,
+				primitiveCount );
+		}
+
+		virtual void DrawIndexedInstanced(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount ) override
+		{
+			Log(
+				CALL_DRAW_INDEXED_INSTANCED, NULL, primitiveType, baseVertexIndex, minIndex, usedVertexCount, startIndex,
+				primitiveCount, instanceCount );
+		}
+
+		virtual void DrawUnindexed(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount ) override
+		{
+			Log( CALL_DRAW_UNINDEXED, NULL, primitiveType, baseVertexIndex, primitiveCount );
+		}
+
+		virtual void SetFence( RFence* pFence ) override
+		{
+			Log( CALL_SET_FENCE, pFence );
+		}
+
+		virtual void UnbindResources() override
+		{
+			Log( CALL_UNBIND_RESOURCES );
+		}
+
+		virtual void ExecuteCommandList( RRenderCommandList* pCommandList ) override
+		{
+			Log( CALL_EXECUTE_COMMAND_LIST, pCommandList );
+		}
+
+		virtual void FinishCommandList( RRenderCommandListPtr& rspCommandList ) override
+		{
+			rspCommandList.Release();
+		}
+
+	private:
+		~RecordingCommandProxy()
+		{
+		}
+
+		void Log(
+			ECall type, const void* pResource = NULL, size_t argument0 = 0, size_t argument1 = 0, size_t argument2 = 0,
+			size_t argument3 = 0, size_t argument4 = 0, size_t argument5 = 0, size_t argument6 = 0 )
+		{
+			Call& rCall = *m_calls.New();
+			rCall.type = type;
+			rCall.pResource = pResource;
+			rCall.arguments[ 0 ] = static_cast< uint32_t >( argument0 );
+			rCall.arguments[ 1 ] = static_cast< uint32_t >( argument1 );
+			rCall.arguments[ 2 ] = static_cast< uint32_t >( argument2 );
+			rCall.arguments[ 3 ] = static_cast< uint32_t >( argument3 );
+			rCall.arguments[ 4 ] = static_cast< uint32_t >( argument4 );
+			rCall.arguments[ 5 ] = static_cast< uint32_t >( argument5 );
+			rCall.arguments[ 6 ] = static_cast< uint32_t >( argument6 );
+			rCall.arguments[ 7 ] = 0;
+		}
+
+		void LogConstantBuffers(
+			ECall type, size_t startIndex, size_t bufferCount, const size_t* pLimitSizes, const uint32_t* pOffsets,
+			const uint32_t* pSizes )
+		{
+			Log(
+				type, NULL, startIndex, bufferCount, pLimitSizes && bufferCount ? pLimitSizes[ 0 ] : 0,
+				pOffsets && bufferCount ? pOffsets[ 0 ] : 0, pSizes && bufferCount ? pSizes[ 0 ] : 0 );
+		}
+	};
+
+	typedef SmartPtr< RecordingCommandProxy > RecordingCommandProxyPtr;
+}
+
+TEST( DeferredRenderCommandList, EmptyList )
+{
+	DeferredRenderCommandProxyPtr spDeferredProxy = new DeferredRenderCommandProxy;
+
+	RRenderCommandListPtr spCommandList;
+	spDeferredProxy->FinishCommandList( spCommandList );
+	ASSERT_TRUE( spCommandList );
+
+	DeferredRenderCommandList* pDeferredList = static_cast< DeferredRenderCommandList* >( spCommandList.Get() );
+	EXPECT_TRUE( pDeferredList->IsEmpty() );
+	EXPECT_EQ( 0u, pDeferredList->GetCommandCount() );
+
+	RecordingCommandProxyPtr spRecorder = new RecordingCommandProxy;
+	pDeferredList->Execute( spRecorder );
+	EXPECT_EQ( 0u, spRecorder->m_calls.GetSize() );
+}
+
+TEST( DeferredRenderCommandList, RecordReplayRoundTrip )
+{
+	DeferredRenderCommandProxyPtr spDeferredProxy = new DeferredRenderCommandProxy;
+
+	RVertexBuffer* vertexBuffers[ 2 ] = { NULL, NULL };
+	uint32_t strides[ 2 ] = { 24, 32 };
+	uint32_t offsets[ 2 ] = { 0, 64 };
+
+	RConstantBuffer* constantBuffers[ 1 ] = { NULL };
+	size_t limitSizes[ 1 ] = { 48 };
+	uint32_t constantOffsets[ 1 ] = { 256 };
+	uint32_t constantSizes[ 1 ] = { 128 };
+
+	spDeferredProxy->BeginScene();
+	spDeferredProxy->SetViewport( 1, 2, 640, 480 );
+	spDeferredProxy->Clear( RENDERER_CLEAR_FLAG_ALL, Color( 0xff336699 ), 0.5f, 3 );
+	spDeferredProxy->SetDepthStencilState( NULL, 7 );
+	spDeferredProxy->SetVertexBuffers( 0, 2, vertexBuffers, strides, offsets );
+	spDeferredProxy->SetVertexConstantBuffers( 1, 1, constantBuffers, limitSizes, constantOffsets, constantSizes );
+	spDeferredProxy->SetPixelConstantBuffers( 2, 1, constantBuffers );
+	spDeferredProxy->SetTexture( 4, NULL );
+	spDeferredProxy->DrawIndexed( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST, 10, 0, 100, 30, 20 );
+	spDeferredProxy->DrawIndexedInstanced( RENDERER_PRIMITIVE_TYPE_TRIANGLE_STRIP, 5, 1, 50, 6, 12, 9 );
+	spDeferredProxy->DrawUnindexed( RENDERER_PRIMITIVE_TYPE_LINE_LIST, 8, 4 );
+	spDeferredProxy->UnbindResources();
+	spDeferredProxy->EndScene();
+
+	RRenderCommandListPtr spCommandList;
+	spDeferredProxy->FinishCommandList( spCommandList );
+	ASSERT_TRUE( spCommandList );
+
+	DeferredRenderCommandList* pDeferredList = static_cast< DeferredRenderCommandList* >( spCommandList.Get() );
+	EXPECT_EQ( 13u, pDeferredList->GetCommandCount() );
+
+	RecordingCommandProxyPtr spRecorder = new RecordingCommandProxy;
+	pDeferredList->Execute( spRecorder );
+
+	const DynamicArray< RecordingCommandProxy::Call >& rCalls = spRecorder->m_calls;
+	ASSERT_EQ( 13u, rCalls.GetSize() );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_BEGIN_SCENE, rCalls[ 0 ].type );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_SET_VIEWPORT, rCalls[ 1 ].type );
+	EXPECT_EQ( 1u, rCalls[ 1 ].arguments[ 0 ] );
+	EXPECT_EQ( 2u, rCalls[ 1 ].arguments[ 1 ] );
+	EXPECT_EQ( 640u, rCalls[ 1 ].arguments[ 2 ] );
+	EXPECT_EQ( 480u, rCalls[ 1 ].arguments[ 3 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_CLEAR, rCalls[ 2 ].type );
+	EXPECT_EQ( static_cast< uint32_t >( RENDERER_CLEAR_FLAG_ALL ), rCalls[ 2 ].arguments[ 0 ] );
+	EXPECT_EQ( 0xff336699u, rCalls[ 2 ].arguments[ 1 ] );
+	EXPECT_EQ( 500u, rCalls[ 2 ].arguments[ 2 ] );
+	EXPECT_EQ( 3u, rCalls[ 2 ].arguments[ 3 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_SET_DEPTH_STENCIL_STATE, rCalls[ 3 ].type );
+	EXPECT_EQ( 7u, rCalls[ 3 ].arguments[ 0 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_SET_VERTEX_BUFFERS, rCalls[ 4 ].type );
+	EXPECT_EQ( 0u, rCalls[ 4 ].arguments[ 0 ] );
+	EXPECT_EQ( 2u, rCalls[ 4 ].arguments[ 1 ] );
+	EXPECT_EQ( 24u, rCalls[ 4 ].arguments[ 2 ] );
+	EXPECT_EQ( 0u, rCalls[ 4 ].arguments[ 3 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_SET_VERTEX_CONSTANT_BUFFERS, rCalls[ 5 ].type );
+	EXPECT_EQ( 1u, rCalls[ 5 ].arguments[ 0 ] );
+	EXPECT_EQ( 1u, rCalls[ 5 ].arguments[ 1 ] );
+	EXPECT_EQ( 48u, rCalls[ 5 ].arguments[ 2 ] );
+	EXPECT_EQ( 256u, rCalls[ 5 ].arguments[ 3 ] );
+	EXPECT_EQ( 128u, rCalls[ 5 ].arguments[ 4 ] );
+
+	// Missing constant buffer parameter arrays are replayed as their defaults.
+	EXPECT_EQ( RecordingCommandProxy::CALL_SET_PIXEL_CONSTANT_BUFFERS, rCalls[ 6 ].type );
+	EXPECT_EQ( 2u, rCalls[ 6 ].arguments[ 0 ] );
+	EXPECT_EQ( 0u, rCalls[ 6 ].arguments[ 3 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_SET_TEXTURE, rCalls[ 7 ].type );
+	EXPECT_EQ( 4u, rCalls[ 7 ].arguments[ 0 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_DRAW_INDEXED, rCalls[ 8 ].type );
+	EXPECT_EQ( static_cast< uint32_t >( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST ), rCalls[ 8 ].arguments[ 0 ] );
+	EXPECT_EQ( 10u, rCalls[ 8 ].arguments[ 1 ] );
+	EXPECT_EQ( 0u, rCalls[ 8 ].arguments[ 2 ] );
+	EXPECT_EQ( 100u, rCalls[ 8 ].arguments[ 3 ] );
+	EXPECT_EQ( 30u, rCalls[ 8 ].arguments[ 4 ] );
+	EXPECT_EQ( 20u, rCalls[ 8 ].arguments[ 5 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_DRAW_INDEXED_INSTANCED, rCalls[ 9 ].type );
+	EXPECT_EQ( static_cast< uint32_t >( RENDERER_PRIMITIVE_TYPE_TRIANGLE_STRIP ), rCalls[ 9 ].arguments[ 0 ] );
+	EXPECT_EQ( 5u, rCalls[ 9 ].arguments[ 1 ] );
+	EXPECT_EQ( 12u, rCalls[ 9 ].arguments[ 5 ] );
+	EXPECT_EQ( 9u, rCalls[ 9 ].arguments[ 6 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_DRAW_UNINDEXED, rCalls[ 10 ].type );
+	EXPECT_EQ( static_cast< uint32_t >( RENDERER_PRIMITIVE_TYPE_LINE_LIST ), rCalls[ 10 ].arguments[ 0 ] );
+	EXPECT_EQ( 8u, rCalls[ 10 ].arguments[ 1 ] );
+	EXPECT_EQ( 4u, rCalls[ 10 ].arguments[ 2 ] );
+
+	EXPECT_EQ( RecordingCommandProxy::CALL_UNBIND_RESOURCES, rCalls[ 11 ].type );
+	EXPECT_EQ( RecordingCommandProxy::CALL_END_SCENE, rCalls[ 12 ].type );
+
+	// Command lists can be replayed any number of times.
+	RecordingCommandProxyPtr spSecondRecorder = new RecordingCommandProxy;
+	pDeferredList->Execute( spSecondRecorder );
+	EXPECT_EQ( rCalls.GetSize(), spSecondRecorder->m_calls.GetSize() );
+}
+
+TEST( DeferredRenderCommandList, NestedCommandLists )
+{
+	DeferredRenderCommandProxyPtr spInnerProxy = new DeferredRenderCommandProxy;
+	spInnerProxy->DrawUnindexed( RENDERER_PRIMITIVE_TYPE_POINT_LIST, 0, 1 );
+
+	RRenderCommandListPtr spInnerList;
+	spInnerProxy->FinishCommandList( spInnerList );
+
+	DeferredRenderCommandProxyPtr spOuterProxy = new DeferredRenderCommandProxy;
+	spOuterProxy->BeginScene();
+	spOuterProxy->ExecuteCommandList( spInnerList );
+	spOuterProxy->EndScene();
+
+	RRenderCommandListPtr spOuterList;
+	spOuterProxy->FinishCommandList( spOuterList );
+
+	// The outer list keeps the inner list alive.
+	RRenderCommandList* pInnerList = spInnerList;
+	spInnerList.Release();
+
+	RecordingCommandProxyPtr spRecorder = new RecordingCommandProxy;
+	static_cast< DeferredRenderCommandList* >( spOuterList.Get() )->Execute( spRecorder );
+
+	const DynamicArray< RecordingCommandProxy::Call >& rCalls = spRecorder->m_calls;
+	ASSERT_EQ( 3u, rCalls.GetSize() );
+	EXPECT_EQ( RecordingCommandProxy::CALL_BEGIN_SCENE, rCalls[ 0 ].type );
+	EXPECT_EQ( RecordingCommandProxy::CALL_EXECUTE_COMMAND_LIST, rCalls[ 1 ].type );
+	EXPECT_EQ( pInnerList, rCalls[ 1 ].pResource );
+	EXPECT_EQ( RecordingCommandProxy::CALL_END_SCENE, rCalls[ 2 ].type );
+
+	// Recording a new list after finishing starts from an empty list.
+	spOuterProxy->EndScene();
+
+	RRenderCommandListPtr spNextList;
+	spOuterProxy->FinishCommandList( spNextList );
+	EXPECT_NE( spOuterList.Get(), spNextList.Get() );
+	EXPECT_EQ( 1u, static_cast< DeferredRenderCommandList* >( spNextList.Get() )->GetCommandCount() );
+}
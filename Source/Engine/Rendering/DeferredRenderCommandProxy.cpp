@@ -0,0 +1,404 @@
+#include "Precompile.h"
+#include "Rendering/DeferredRenderCommandProxy.h"
+
+#include "Rendering/RBlendState.h"
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RFence.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RPixelShader.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RSamplerState.h"
+#include "Rendering/RSurface.h"
+#include "Rendering/RTexture.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexShader.h"
+
+using namespace Helium;
+
+/// Constructor.
+DeferredRenderCommandProxy::DeferredRenderCommandProxy()
+	: m_lastBufferSize( 0 )
+{
+}
+
+/// Destructor.
+DeferredRenderCommandProxy::~DeferredRenderCommandProxy()
+{
+}
+
+/// @copydoc RRenderCommandProxy::SetRasterizerState()
+void DeferredRenderCommandProxy::SetRasterizerState( RRasterizerState* pState )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	pCommandList->NewCommand< DeferredRenderCommandList::SetRasterizerStateCommand >()->pState = pState;
+	pCommandList->AddResourceReference( pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetBlendState()
+void DeferredRenderCommandProxy::SetBlendState( RBlendState* pState )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	pCommandList->NewCommand< DeferredRenderCommandList::SetBlendStateCommand >()->pState = pState;
+	pCommandList->AddResourceReference( pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetDepthStencilState()
+void DeferredRenderCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	DeferredRenderCommandList::SetDepthStencilStateCommand* pCommand =
+		pCommandList->NewCommand< DeferredRenderCommandList::SetDepthStencilStateCommand >();
+	pCommand->pState = pState;
+	pCommand->stencilReferenceValue = stencilReferenceValue;
+	pCommandList->AddResourceReference( pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetSamplerStates()
+void DeferredRenderCommandProxy::SetSamplerStates(
+	size_t startIndex,
+	size_t samplerCount,
+	RSamplerState* const* ppStates )
+{
+	HELIUM_ASSERT( ppStates || samplerCount == 0 );
+
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	DeferredRenderCommandList::SetSamplerStatesCommand* pCommand =
+		pCommandList->NewCommand< DeferredRenderCommandList::SetSamplerStatesCommand >(
+			samplerCount * sizeof( RSamplerState* ) );
+	pCommand->startIndex = static_cast< uint32_t >( startIndex );
+	pCommand->samplerCount = static_cast< uint32_t >( samplerCount );
+
+	RSamplerState** ppCommandStates = reinterpret_cast< RSamplerState** >( pCommand + 1 );
+	for( size_t samplerIndex = 0; samplerIndex < samplerCount; ++samplerIndex )
+	{
+		RSamplerState* pState = ppStates[ samplerIndex ];
+		ppCommandStates[ samplerIndex ] = pState;
+		pCommandList->AddResourceReference( pState );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetRenderSurfaces()
+void DeferredRenderCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	DeferredRenderCommandList::SetRenderSurfacesCommand* pCommand =
+		pCommandList->NewCommand< DeferredRenderCommandList::SetRenderSurfacesCommand >();
+	pCommand->pRenderTargetSurface = pRenderTargetSurface;
+	pCommand->pDepthStencilSurface = pDepthStencilSurface;
+	pCommandList->AddResourceReference( pRenderTargetSurface );
+	pCommandList->AddResourceReference( pDepthStencilSurface );
+}
+
+/// @copydoc RRenderCommandProxy::SetViewport()
+void DeferredRenderCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+{
+	DeferredRenderCommandList::SetViewportCommand* pCommand =
+		GetCommandList()->NewCommand< DeferredRenderCommandList::SetViewportCommand >();
+	pCommand->x = x;
+	pCommand->y = y;
+	pCommand->width = width;
+	pCommand->height = height;
+}
+
+/// @copydoc RRenderCommandProxy::BeginScene()
+void DeferredRenderCommandProxy::BeginScene()
+{
+	GetCommandList()->NewCommand( DeferredRenderCommandList::COMMAND_BEGIN_SCENE );
+}
+
+/// @copydoc RRenderCommandProxy::EndScene()
+void DeferredRenderCommandProxy::EndScene()
+{
+	GetCommandList()->NewCommand( DeferredRenderCommandList::COMMAND_END_SCENE );
+}
+
+/// @copydoc RRenderCommandProxy::Clear()
+void DeferredRenderCommandProxy::Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil )
+{
+	DeferredRenderCommandList::ClearCommand* pCommand =
+		GetCommandList()->NewCommand< DeferredRenderCommandList::ClearCommand >();
+	pCommand->color = rColor;
+	pCommand->depth = depth;
+	pCommand->clearFlags = clearFlags;
+	pCommand->stencil = stencil;
+}
+
+/// @copydoc RRenderCommandProxy::SetIndexBuffer()
+void DeferredRenderCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	pCommandList->NewCommand< DeferredRenderCommandList::SetIndexBufferCommand >()->pBuffer = pBuffer;
+	pCommandList->AddResourceReference( pBuffer );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexBuffers()
+void DeferredRenderCommandProxy::SetVertexBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RVertexBuffer* const* ppBuffers,
+	uint32_t* pStrides,
+	uint32_t* pOffsets )
+{
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+	HELIUM_ASSERT( pStrides || bufferCount == 0 );
+	HELIUM_ASSERT( pOffsets || bufferCount == 0 );
+
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	DeferredRenderCommandList::SetVertexBuffersCommand* pCommand =
+		pCommandList->NewCommand< DeferredRenderCommandList::SetVertexBuffersCommand >(
+			bufferCount * ( sizeof( RVertexBuffer* ) + sizeof( uint32_t ) * 2 ) );
+	pCommand->startIndex = static_cast< uint32_t >( startIndex );
+	pCommand->bufferCount = static_cast< uint32_t >( bufferCount );
+
+	RVertexBuffer** ppCommandBuffers = reinterpret_cast< RVertexBuffer** >( pCommand + 1 );
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		RVertexBuffer* pBuffer = ppBuffers[ bufferIndex ];
+		ppCommandBuffers[ bufferIndex ] = pBuffer;
+		pCommandList->AddResourceReference( pBuffer );
+	}
+
+	uint32_t* pCommandStrides = reinterpret_cast< uint32_t* >( ppCommandBuffers + bufferCount );
+	uint32_t* pCommandOffsets = pCommandStrides + bufferCount;
+	MemoryCopy( pCommandStrides, pStrides, sizeof( uint32_t ) * bufferCount );
+	MemoryCopy( pCommandOffsets, pOffsets, sizeof( uint32_t ) * bufferCount );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexInputLayout()
+void DeferredRenderCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	pCommandList->NewCommand< DeferredRenderCommandList::SetVertexInputLayoutCommand >()->pLayout = pLayout;
+	pCommandList->AddResourceReference( pLayout );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexShader()
+void DeferredRenderCommandProxy::SetVertexShader( RVertexShader* pShader )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	pCommandList->NewCommand< DeferredRenderCommandList::SetVertexShaderCommand >()->pShader = pShader;
+	pCommandList->AddResourceReference( pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelShader()
+void DeferredRenderCommandProxy::SetPixelShader( RPixelShader* pShader )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	pCommandList->NewCommand< DeferredRenderCommandList::SetPixelShaderCommand >()->pShader = pShader;
+	pCommandList->AddResourceReference( pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexConstantBuffers()
+void DeferredRenderCommandProxy::SetVertexConstantBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RConstantBuffer* const* ppBuffers,
+	const size_t* pLimitSizes,
+	const uint32_t* pOffsets,
+	const uint32_t* pSizes )
+{
+	DeferredRenderCommandList::SetVertexConstantBuffersCommand* pCommand =
+		GetCommandList()->NewCommand< DeferredRenderCommandList::SetVertexConstantBuffersCommand >(
+			bufferCount * ( sizeof( RConstantBuffer* ) + sizeof( size_t ) + sizeof( uint32_t ) * 2 ) );
+	RecordConstantBuffers( pCommand, startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelConstantBuffers()
+void DeferredRenderCommandProxy::SetPixelConstantBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RConstantBuffer* const* ppBuffers,
+	const size_t* pLimitSizes,
+	const uint32_t* pOffsets,
+	const uint32_t* pSizes )
+{
+	DeferredRenderCommandList::SetPixelConstantBuffersCommand* pCommand =
+		GetCommandList()->NewCommand< DeferredRenderCommandList::SetPixelConstantBuffersCommand >(
+			bufferCount * ( sizeof( RConstantBuffer* ) + sizeof( size_t ) + sizeof( uint32_t ) * 2 ) );
+	RecordConstantBuffers( pCommand, startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetTexture()
+void DeferredRenderCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	DeferredRenderCommandList::SetTextureCommand* pCommand =
+		pCommandList->NewCommand< DeferredRenderCommandList::SetTextureCommand >();
+	pCommand->pTexture = pTexture;
+	pCommand->samplerIndex = static_cast< uint32_t >( samplerIndex );
+	pCommandList->AddResourceReference( pTexture );
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexed()
+void DeferredRenderCommandProxy::DrawIndexed(
+	ERendererPrimitiveType primitiveType,
+	uint32_t baseVertexIndex,
+	uint32_t minIndex,
+	uint32_t usedVertexCount,
+	uint32_t startIndex,
+	uint32_t primitiveCount )
+{
+	DeferredRenderCommandList::DrawIndexedCommand* pCommand =
+		GetCommandList()->NewCommand< DeferredRenderCommandList::DrawIndexedCommand >();
+	pCommand->primitiveType = static_cast< uint32_t >( primitiveType );
+	pCommand->baseVertexIndex = baseVertexIndex;
+	pCommand->minIndex = minIndex;
+	pCommand->usedVertexCount = usedVertexCount;
+	pCommand->startIndex = startIndex;
+	pCommand->primitiveCount = primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void DeferredRenderCommandProxy::DrawIndexedInstanced(
+	ERendererPrimitiveType primitiveType,
+	uint32_t baseVertexIndex,
+	uint32_t minIndex,
+	uint32_t usedVertexCount,
+	uint32_t startIndex,
+	uint32_t primitiveCount,
+	uint32_t instanceCount )
+{
+	DeferredRenderCommandList::DrawIndexedInstancedCommand* pCommand =
+		GetCommandList()->NewCommand< DeferredRenderCommandList::DrawIndexedInstancedCommand >();
+	pCommand->primitiveType = static_cast< uint32_t >( primitiveType );
+	pCommand->baseVertexIndex = baseVertexIndex;
+	pCommand->minIndex = minIndex;
+	pCommand->usedVertexCount = usedVertexCount;
+	pCommand->startIndex = startIndex;
+	pCommand->primitiveCount = primitiveCount;
+	pCommand->instanceCount = instanceCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawUnindexed()
+void DeferredRenderCommandProxy::DrawUnindexed(
+	ERendererPrimitiveType primitiveType,
+	uint32_t baseVertexIndex,
+	uint32_t primitiveCount )
+{
+	DeferredRenderCommandList::DrawUnindexedCommand* pCommand =
+		GetCommandList()->NewCommand< DeferredRenderCommandList::DrawUnindexedCommand >();
+	pCommand->primitiveType = static_cast< uint32_t >( primitiveType );
+	pCommand->baseVertexIndex = baseVertexIndex;
+	pCommand->primitiveCount = primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetFence()
+void DeferredRenderCommandProxy::SetFence( RFence* pFence )
+{
+	DeferredRenderCommandList* pCommandList = GetCommandList();
+	pCommandList->NewCommand< DeferredRenderCommandList::SetFenceCommand >()->pFence = pFence;
+	pCommandList->AddResourceReference( pFence );
+}
+
+/// @copydoc RRenderCommandProxy::UnbindResources()
+void DeferredRenderCommandProxy::UnbindResources()
+{
+	GetCommandList()->NewCommand( DeferredRenderCommandList::COMMAND_UNBIND_RESOURCES );
+}
+
+/// @copydoc RRenderCommandProxy::ExecuteCommandList()
+void DeferredRenderCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
+{
+	HELIUM_ASSERT( pCommandList );
+	HELIUM_ASSERT( pCommandList != m_spCommandList );
+
+	DeferredRenderCommandList* pRecordingList = GetCommandList();
+	pRecordingList->NewCommand< DeferredRenderCommandList::ExecuteCommandListCommand >()->pCommandList = pCommandList;
+	pRecordingList->AddResourceReference( pCommandList );
+}
+
+/// @copydoc RRenderCommandProxy::FinishCommandList()
+void DeferredRenderCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
+{
+	// Always hand back a valid list, even if nothing was recorded.
+	rspCommandList = GetCommandList();
+	m_lastBufferSize = m_spCommandList->GetBufferSize();
+
+	m_spCommandList.Release();
+}
+
+/// Get the command list currently being recorded, allocating a new list if necessary.
+///
+/// @return  Current command list.
+DeferredRenderCommandList* DeferredRenderCommandProxy::GetCommandList()
+{
+	if( !m_spCommandList )
+	{
+		m_spCommandList = new DeferredRenderCommandList;
+		HELIUM_ASSERT( m_spCommandList );
+
+		m_spCommandList->Reserve( m_lastBufferSize );
+	}
+
+	return m_spCommandList;
+}
+
+/// Fill out the parameters of a constant buffer binding command.
+///
+/// Missing limit size and size arrays are recorded as invalid values (no limit), and missing offset arrays as zero
+/// offsets, matching the defaults applied by the immediate command proxies.
+///
+/// @param[in] pCommand     Command payload, allocated with space for the buffer parameter arrays.
+/// @param[in] startIndex   Index of the first constant buffer slot to set.
+/// @param[in] bufferCount  Number of constant buffers to set.
+/// @param[in] ppBuffers    Constant buffers to set.
+/// @param[in] pLimitSizes  Maximum number of bytes to use from each buffer (can be null).
+/// @param[in] pOffsets     Byte offset of the data to bind within each buffer (can be null).
+/// @param[in] pSizes       Number of bytes to bind from each buffer (can be null).
+void DeferredRenderCommandProxy::RecordConstantBuffers(
+	DeferredRenderCommandList::SetConstantBuffersCommand* pCommand,
+	size_t startIndex,
+	size_t bufferCount,
+	RConstantBuffer* const* ppBuffers,
+	const size_t* pLimitSizes,
+	const uint32_t* pOffsets,
+	const uint32_t* pSizes )
+{
+	HELIUM_ASSERT( pCommand );
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+	HELIUM_ASSERT( m_spCommandList );
+
+	pCommand->startIndex = static_cast< uint32_t >( startIndex );
+	pCommand->bufferCount = static_cast< uint32_t >( bufferCount );
+
+	RConstantBuffer** ppCommandBuffers = reinterpret_cast< RConstantBuffer** >( pCommand + 1 );
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		RConstantBuffer* pBuffer = ppBuffers[ bufferIndex ];
+		ppCommandBuffers[ bufferIndex ] = pBuffer;
+		m_spCommandList->AddResourceReference( pBuffer );
+	}
+
+	size_t* pCommandLimitSizes = reinterpret_cast< size_t* >( ppCommandBuffers + bufferCount );
+	uint32_t* pCommandOffsets = reinterpret_cast< uint32_t* >( pCommandLimitSizes + bufferCount );
+	uint32_t* pCommandSizes = pCommandOffsets + bufferCount;
+
+	if( pLimitSizes )
+	{
+		MemoryCopy( pCommandLimitSizes, pLimitSizes, bufferCount * sizeof( size_t ) );
+	}
+	else
+	{
+		MemorySet( pCommandLimitSizes, 0xff, bufferCount * sizeof( size_t ) );
+	}
+
+	if( pOffsets )
+	{
+		MemoryCopy( pCommandOffsets, pOffsets, bufferCount * sizeof( uint32_t ) );
+	}
+	else
+	{
+		MemoryZero( pCommandOffsets, bufferCount * sizeof( uint32_t ) );
+	}
+
+	if( pSizes )
+	{
+		MemoryCopy( pCommandSizes, pSizes, bufferCount * sizeof( uint32_t ) );
+	}
+	else
+	{
+		MemorySet( pCommandSizes, 0xff, bufferCount * sizeof( uint32_t ) );
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Rendering/RRenderCommandProxy.h"
+
+#include "Rendering/DeferredRenderCommandList.h"
+
+namespace Helium
+{
+    HELIUM_DECLARE_RPTR( DeferredRenderCommandProxy );
+
+    /// Backend-independent render command proxy for recording command lists.
+    ///
+    /// Commands issued through this proxy are encoded into a DeferredRenderCommandList instead of being sent to the
+    /// graphics API, which allows draw submission to be spread across job threads even with APIs (such as OpenGL)
+    /// whose context can only be used from a single thread.  Each thread recording commands should use its own proxy.
+    /// FinishCommandList() hands over the recorded list, which can then be executed in order on the immediate command
+    /// proxy.
+    ///
+    /// @see Renderer::CreateDeferredCommandProxy()
+    class HELIUM_RENDERING_API DeferredRenderCommandProxy : public RRenderCommandProxy
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        DeferredRenderCommandProxy();
+        //@}
+
+        /// @name State Management
+        //@{
+        virtual void SetRasterizerState( RRasterizerState* pState ) override;
+        virtual void SetBlendState( RBlendState* pState ) override;
+        virtual void SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue ) override;
+        virtual void SetSamplerStates( size_t startIndex, size_t samplerCount, RSamplerState* const* ppStates ) override;
+        //@}
+
+        /// @name Render Target Management
+        //@{
+        virtual void SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface ) override;
+        virtual void SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height ) override;
+        //@}
+
+        /// @name Command Generation
+        //@{
+        virtual void BeginScene() override;
+        virtual void EndScene() override;
+
+        virtual void Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil ) override;
+
+        virtual void SetIndexBuffer( RIndexBuffer* pBuffer ) override;
+        virtual void SetVertexBuffers(
+            size_t startIndex, size_t bufferCount, RVertexBuffer* const* ppBuffers, uint32_t* pStrides,
+            uint32_t* pOffsets ) override;
+        virtual void SetVertexInputLayout( RVertexInputLayout* pLayout ) override;
+
+        virtual void SetVertexShader( RVertexShader* pShader ) override;
+        virtual void SetPixelShader( RPixelShader* pShader ) override;
+
+        virtual void SetVertexConstantBuffers(
+            size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL ) override;
+        virtual void SetPixelConstantBuffers(
+            size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL ) override;
+
+        virtual void SetTexture( size_t samplerIndex, RTexture* pTexture ) override;
+
+        virtual void DrawIndexed(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount ) override;
+        virtual void DrawIndexedInstanced(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount ) override;
+        virtual void DrawUnindexed(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount ) override;
+        //@}
+
+        /// @name Fence Commands
+        //@{
+        virtual void SetFence( RFence* pFence ) override;
+        //@}
+
+        /// @name Miscellaneous Resource Management
+        //@{
+        virtual void UnbindResources() override;
+        //@}
+
+        /// @name Command List Support
+        //@{
+        virtual void ExecuteCommandList( RRenderCommandList* pCommandList ) override;
+
+        virtual void FinishCommandList( RRenderCommandListPtr& rspCommandList ) override;
+        //@}
+
+    private:
+        /// Command list currently being recorded (allocated on demand).
+        DeferredRenderCommandListPtr m_spCommandList;
+        /// Size of the last finished command list, used to pre-size the next one.
+        size_t m_lastBufferSize;
+
+        /// @name Construction/Destruction
+        //@{
+        ~DeferredRenderCommandProxy();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        DeferredRenderCommandList* GetCommandList();
+        void RecordConstantBuffers(
+            DeferredRenderCommandList::SetConstantBuffersCommand* pCommand, size_t startIndex, size_t bufferCount,
+            RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes, const uint32_t* pOffsets,
+            const uint32_t* pSizes );
+        //@}
+    };
+}
@@ -8,6 +8,14 @@ RRenderCommandProxy::~RRenderCommandProxy()
 {
 }
 
+/// Get the filter used by this proxy to skip redundant state changes, for access to its state change statistics.
+///
+/// @return  Render state filter, or null if this proxy does not filter state changes.
+const RenderStateFilter* RRenderCommandProxy::GetStateFilter() const
+{
+    return NULL;
+}
+
 /// @fn void RRenderCommandProxy::SetRasterizerState( RRasterizerState* pState )
 /// Set the rasterizer state.
 ///
@@ -121,7 +129,7 @@ RRenderCommandProxy::~RRenderCommandProxy()
 ///
 /// @see SetVertexShader()
 
-/// @fn void RRenderCommandProxy::SetVertexConstantBuffers( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes )
+/// @fn void RRenderCommandProxy::SetVertexConstantBuffers( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes, const uint32_t* pOffsets, const uint32_t* pSizes )
 /// Set a range of vertex shader constant buffers to use for rendering.
 ///
 /// @param[in] startIndex   Starting vertex shader constant buffer index to set.
@@ -133,10 +141,17 @@ RRenderCommandProxy::~RRenderCommandProxy()
 ///                         should be updated.  On platforms that don't support storage of constant buffers on the
 ///                         GPU (i.e. Direct3D 9 and such, where shader constants must be passed in the command
 ///                         buffer when changing), this can provide a significant performance improvement.
+/// @param[in] pOffsets     Optional array of byte offsets within each constant buffer at which the range of data bound
+///                         to the shader begins (null to bind from the start of each buffer).  Offsets must be
+///                         multiples of CONSTANT_BUFFER_RANGE_ALIGNMENT.  This allows a single large buffer to be
+///                         suballocated for the constants of many draw calls.
+/// @param[in] pSizes       Optional array of sizes (in bytes) of the range of each constant buffer bound to the shader
+///                         (null to bind up to the end of each buffer).  Sizes must be multiples of
+///                         CONSTANT_BUFFER_RANGE_ALIGNMENT.
 ///
 /// @see SetPixelConstantBuffers()
 
-/// @fn void RRenderCommandProxy::SetPixelConstantBuffers( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes )
+/// @fn void RRenderCommandProxy::SetPixelConstantBuffers( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes, const uint32_t* pOffsets, const uint32_t* pSizes )
 /// Set a range of pixel shader constant buffers to use for rendering.
 ///
 /// @param[in] startIndex   Starting pixel shader constant buffer index to set.
@@ -148,6 +163,13 @@ RRenderCommandProxy::~RRenderCommandProxy()
 ///                         should be updated.  On platforms that don't support storage of constant buffers on the
 ///                         GPU (i.e. Direct3D 9 and such, where shader constants must be passed in the command
 ///                         buffer when changing), this can provide a significant performance improvement.
+/// @param[in] pOffsets     Optional array of byte offsets within each constant buffer at which the range of data bound
+///                         to the shader begins (null to bind from the start of each buffer).  Offsets must be
+///                         multiples of CONSTANT_BUFFER_RANGE_ALIGNMENT.  This allows a single large buffer to be
+///                         suballocated for the constants of many draw calls.
+/// @param[in] pSizes       Optional array of sizes (in bytes) of the range of each constant buffer bound to the shader
+///                         (null to bind up to the end of each buffer).  Sizes must be multiples of
+///                         CONSTANT_BUFFER_RANGE_ALIGNMENT.
 ///
 /// @see SetVertexConstantBuffers()
 
@@ -168,7 +190,25 @@ RRenderCommandProxy::~RRenderCommandProxy()
 /// @param[in] startIndex       Offset of the first index within the index buffer to use for rendering.
 /// @param[in] primitiveCount   Number of primitives to render.
 ///
-/// @see DrawUnindexed()
+/// @see DrawIndexedInstanced(), DrawUnindexed()
+
+/// @fn void RRenderCommandProxy::DrawIndexedInstanced( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount, uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount )
+/// Draw multiple instances of primitives based on a list of indexed vertices.
+///
+/// Vertex buffers bound to streams below INSTANCE_DATA_VERTEX_STREAM_INDEX provide per-vertex data, while the vertex
+/// buffer bound to stream INSTANCE_DATA_VERTEX_STREAM_INDEX provides one element per instance.  This is only supported
+/// if the renderer reports RENDERER_FEATURE_FLAG_INSTANCING.
+///
+/// @param[in] primitiveType    Type of primitive to render.
+/// @param[in] baseVertexIndex  Vertex offset of the first vertex to use from the start of each per-vertex stream.
+/// @param[in] minIndex         Minimum vertex index value.
+/// @param[in] usedVertexCount  Range of vertices used during this call, starting from the vertex addressed by the
+///                             minimum vertex index value.
+/// @param[in] startIndex       Offset of the first index within the index buffer to use for rendering.
+/// @param[in] primitiveCount   Number of primitives to render for each instance.
+/// @param[in] instanceCount    Number of instances to render.
+///
+/// @see DrawIndexed(), DrawUnindexed()
 
 /// @fn void RRenderCommandProxy::DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount )
 /// Draw primitives based on an unindexed list of vertices.
@@ -177,7 +217,7 @@ RRenderCommandProxy::~RRenderCommandProxy()
 /// @param[in] baseVertexIndex  Vertex offset of the first vertex to use from the start of each vertex stream.
 /// @param[in] primitiveCount   Number of primitives to render.
 ///
-/// @see DrawIndexed()
+/// @see DrawIndexed(), DrawIndexedInstanced()
 
 /// @fn void RRenderCommandProxy::SetFence( RFence* pFence )
 /// Signal a fence once all previously issued commands have been processed by the GPU.
@@ -22,6 +22,8 @@ namespace Helium
 
     class RFence;
 
+    class RenderStateFilter;
+
     HELIUM_DECLARE_RPTR( RSamplerState );
     HELIUM_DECLARE_RPTR( RVertexBuffer );
     HELIUM_DECLARE_RPTR( RConstantBuffer );
@@ -69,22 +71,25 @@ namespace Helium
 
         virtual void SetVertexConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-            const size_t* pLimitSizes = NULL ) = 0;
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL ) = 0;
         inline void SetVertexConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBufferPtr const* pspBuffers,
-            const size_t* pLimitSizes = NULL );
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
         virtual void SetPixelConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-            const size_t* pLimitSizes = NULL ) = 0;
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL ) = 0;
         inline void SetPixelConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBufferPtr const* pspBuffers,
-            const size_t* pLimitSizes = NULL );
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
 
         virtual void SetTexture( size_t samplerIndex, RTexture* pTexture ) = 0;
 
         virtual void DrawIndexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
             uint32_t startIndex, uint32_t primitiveCount ) = 0;
+        virtual void DrawIndexedInstanced(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount ) = 0;
         virtual void DrawUnindexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount ) = 0;
         //@}
@@ -106,6 +111,11 @@ namespace Helium
         virtual void FinishCommandList( RRenderCommandListPtr& rspCommandList ) = 0;
         //@}
 
+        /// @name Statistics
+        //@{
+        virtual const RenderStateFilter* GetStateFilter() const;
+        //@}
+
     protected:
         /// @name Construction/Destruction
         //@{
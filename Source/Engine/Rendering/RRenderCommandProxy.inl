@@ -53,19 +53,30 @@ namespace Helium
     ///                         should be updated.  On platforms that don't support storage of constant buffers on the
     ///                         GPU (i.e. Direct3D 9 and such, where shader constants must be passed in the command
     ///                         buffer when changing), this can provide a significant performance improvement.
+    /// @param[in] pOffsets     Optional array of byte offsets within each constant buffer at which the range of data bound
+    ///                         to the shader begins (null to bind from the start of each buffer).  Offsets must be
+    ///                         multiples of CONSTANT_BUFFER_RANGE_ALIGNMENT.  This allows a single large buffer to be
+    ///                         suballocated for the constants of many draw calls.
+    /// @param[in] pSizes       Optional array of sizes (in bytes) of the range of each constant buffer bound to the shader
+    ///                         (null to bind up to the end of each buffer).  Sizes must be multiples of
+    ///                         CONSTANT_BUFFER_RANGE_ALIGNMENT.
     ///
     /// @see SetPixelConstantBuffers()
     void RRenderCommandProxy::SetVertexConstantBuffers(
         size_t startIndex,
         size_t bufferCount,
         RConstantBufferPtr const* pspBuffers,
-        const size_t* pLimitSizes )
+        const size_t* pLimitSizes,
+        const uint32_t* pOffsets,
+        const uint32_t* pSizes )
     {
         SetVertexConstantBuffers(
             startIndex,
             bufferCount,
             &static_cast< RConstantBuffer* const& >( pspBuffers[ 0 ] ),
-            pLimitSizes );
+            pLimitSizes,
+            pOffsets,
+            pSizes );
     }
 
     /// Set a range of pixel shader constant buffers to use for rendering.
@@ -79,18 +90,29 @@ namespace Helium
     ///                         should be updated.  On platforms that don't support storage of constant buffers on the
     ///                         GPU (i.e. Direct3D 9 and such, where shader constants must be passed in the command
     ///                         buffer when changing), this can provide a significant performance improvement.
+    /// @param[in] pOffsets     Optional array of byte offsets within each constant buffer at which the range of data bound
+    ///                         to the shader begins (null to bind from the start of each buffer).  Offsets must be
+    ///                         multiples of CONSTANT_BUFFER_RANGE_ALIGNMENT.  This allows a single large buffer to be
+    ///                         suballocated for the constants of many draw calls.
+    /// @param[in] pSizes       Optional array of sizes (in bytes) of the range of each constant buffer bound to the shader
+    ///                         (null to bind up to the end of each buffer).  Sizes must be multiples of
+    ///                         CONSTANT_BUFFER_RANGE_ALIGNMENT.
     ///
     /// @see SetVertexConstantBuffers()
     void RRenderCommandProxy::SetPixelConstantBuffers(
         size_t startIndex,
         size_t bufferCount,
         RConstantBufferPtr const* pspBuffers,
-        const size_t* pLimitSizes )
+        const size_t* pLimitSizes,
+        const uint32_t* pOffsets,
+        const uint32_t* pSizes )
     {
         SetPixelConstantBuffers(
             startIndex,
             bufferCount,
             &static_cast< RConstantBuffer* const& >( pspBuffers[ 0 ] ),
-            pLimitSizes );
+            pLimitSizes,
+            pOffsets,
+            pSizes );
     }
 }
@@ -3,7 +3,43 @@
 
 using namespace Helium;
 
+/// Constructor.
+RRenderResource::RRenderResource()
+    : m_memorySize( 0 )
+    , m_memoryTag( MEMORY_TAG_RENDERER )
+{
+}
+
 /// Destructor.
 RRenderResource::~RRenderResource()
 {
+    if( m_memorySize != 0 )
+    {
+        HELIUM_TRACK_FREE( m_memoryTag, m_memorySize );
+    }
+}
+
+/// Record the amount of memory used by this resource with the memory tracker.
+///
+/// The memory is attributed to the innermost memory tracker scope active on the calling thread (see
+/// HELIUM_MEMORY_SCOPE()), or to MEMORY_TAG_RENDERER if no scope is active.  This is normally called by the renderer
+/// implementation when the resource is created, and the memory is released from the tracker when the resource is
+/// destroyed.
+///
+/// @param[in] size  Memory used by this resource, in bytes.
+void RRenderResource::SetMemoryUsage( size_t size )
+{
+    if( m_memorySize != 0 )
+    {
+        HELIUM_TRACK_FREE( m_memoryTag, m_memorySize );
+        m_memorySize = 0;
+    }
+
+    MemoryTracker* pTracker = MemoryTracker::GetInstance();
+    if( pTracker )
+    {
+        m_memoryTag = pTracker->GetScopeTag( MEMORY_TAG_RENDERER );
+        m_memorySize = size;
+        HELIUM_TRACK_ALLOCATION( m_memoryTag, m_memorySize );
+    }
 }
@@ -2,6 +2,7 @@
 
 #include "Rendering/Rendering.h"
 #include "Foundation/SmartPtr.h"
+#include "Engine/MemoryTracker.h"
 
 /// Forward declare a render resource smart pointer type.
 ///
@@ -15,10 +16,23 @@ namespace Helium
     {
         friend class AtomicRefCountBase< RRenderResource >;
 
+    public:
+        /// @name Memory Tracking
+        //@{
+        void SetMemoryUsage( size_t size );
+        //@}
+
     protected:
         /// @name Construction/Destruction
         //@{
+        RRenderResource();
         virtual ~RRenderResource() = 0;
         //@}
+
+    private:
+        /// Memory used by this resource, as recorded with the memory tracker.
+        size_t m_memorySize;
+        /// Memory tracker tag to which this resource is attributed.
+        EMemoryTag m_memoryTag;
     };
 }
@@ -0,0 +1,589 @@
+#include "Precompile.h"
+#include "Rendering/RenderStateFilter.h"
+
+#include "Rendering/RBlendState.h"
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RPixelShader.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RSamplerState.h"
+#include "Rendering/RSurface.h"
+#include "Rendering/RTexture.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexShader.h"
+
+using namespace Helium;
+
+/// Constructor.
+RenderStateFilter::RenderStateFilter()
+	: m_issuedCount( 0 )
+	, m_filteredCount( 0 )
+{
+	Reset();
+}
+
+/// Destructor.
+RenderStateFilter::~RenderStateFilter()
+{
+}
+
+/// Filter a rasterizer state change.
+///
+/// @param[in] pState  Rasterizer state being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterRasterizerState( RRasterizerState* pState )
+{
+	if( m_spRasterizerState == pState )
+	{
+		return CountChange( false );
+	}
+
+	m_spRasterizerState = pState;
+
+	return CountChange( true );
+}
+
+/// Filter a blend state change.
+///
+/// @param[in] pState  Blend state being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterBlendState( RBlendState* pState )
+{
+	if( m_spBlendState == pState )
+	{
+		return CountChange( false );
+	}
+
+	m_spBlendState = pState;
+
+	return CountChange( true );
+}
+
+/// Filter a depth-stencil state change.
+///
+/// @param[in] pState                 Depth-stencil state being set.
+/// @param[in] stencilReferenceValue  Stencil reference value being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
+{
+	if( m_spDepthStencilState == pState && m_stencilReferenceValue == stencilReferenceValue )
+	{
+		return CountChange( false );
+	}
+
+	m_spDepthStencilState = pState;
+	m_stencilReferenceValue = stencilReferenceValue;
+
+	return CountChange( true );
+}
+
+/// Filter a change to a range of sampler states.
+///
+/// @param[in,out] rStartIndex    Index of the first sampler being set.  This is updated to the first sampler that
+///                               actually changed.
+/// @param[in,out] rSamplerCount  Number of samplers being set.  This is updated to the number of samplers from the
+///                               updated start index up to and including the last sampler that actually changed.
+/// @param[in,out] rppStates      Array of sampler states being set.  This is updated to point to the state for the
+///                               updated start index.
+///
+/// @return  True if any sampler state changed, false if the entire range is redundant.
+bool RenderStateFilter::FilterSamplerStates(
+	size_t& rStartIndex,
+	size_t& rSamplerCount,
+	RSamplerState* const*& rppStates )
+{
+	HELIUM_ASSERT( rppStates || rSamplerCount == 0 );
+
+	size_t firstChanged = Invalid< size_t >();
+	size_t lastChanged = Invalid< size_t >();
+	for( size_t rangeIndex = 0; rangeIndex < rSamplerCount; ++rangeIndex )
+	{
+		size_t slotIndex = rStartIndex + rangeIndex;
+		RSamplerState* pState = rppStates[ rangeIndex ];
+		if( slotIndex < SAMPLER_SLOT_COUNT )
+		{
+			if( m_samplerStates[ slotIndex ] == pState )
+			{
+				continue;
+			}
+
+			m_samplerStates[ slotIndex ] = pState;
+		}
+
+		if( IsInvalid( firstChanged ) )
+		{
+			firstChanged = rangeIndex;
+		}
+
+		lastChanged = rangeIndex;
+	}
+
+	if( !CountSlotRange( rSamplerCount, firstChanged, lastChanged ) )
+	{
+		return false;
+	}
+
+	rStartIndex += firstChanged;
+	rSamplerCount = lastChanged - firstChanged + 1;
+	rppStates += firstChanged;
+
+	return true;
+}
+
+/// Filter a change to the render target and depth-stencil surfaces.
+///
+/// Changing render surfaces may reset the viewport on some platforms, so the next viewport change is always issued
+/// after a render surface change.
+///
+/// @param[in] pRenderTargetSurface  Render target surface being set.
+/// @param[in] pDepthStencilSurface  Depth-stencil surface being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
+{
+	if( m_spRenderTargetSurface == pRenderTargetSurface && m_spDepthStencilSurface == pDepthStencilSurface )
+	{
+		return CountChange( false );
+	}
+
+	m_spRenderTargetSurface = pRenderTargetSurface;
+	m_spDepthStencilSurface = pDepthStencilSurface;
+	m_bViewportValid = false;
+
+	return CountChange( true );
+}
+
+/// Filter a viewport change.
+///
+/// @param[in] x       Horizontal pixel coordinate of the top-left corner of the viewport.
+/// @param[in] y       Vertical pixel coordinate of the top-left corner of the viewport.
+/// @param[in] width   Viewport width, in pixels.
+/// @param[in] height  Viewport height, in pixels.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+{
+	if( m_bViewportValid &&
+		m_viewport[ 0 ] == x &&
+		m_viewport[ 1 ] == y &&
+		m_viewport[ 2 ] == width &&
+		m_viewport[ 3 ] == height )
+	{
+		return CountChange( false );
+	}
+
+	m_viewport[ 0 ] = x;
+	m_viewport[ 1 ] = y;
+	m_viewport[ 2 ] = width;
+	m_viewport[ 3 ] = height;
+	m_bViewportValid = true;
+
+	return CountChange( true );
+}
+
+/// Filter an index buffer change.
+///
+/// @param[in] pBuffer  Index buffer being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterIndexBuffer( RIndexBuffer* pBuffer )
+{
+	if( m_spIndexBuffer == pBuffer )
+	{
+		return CountChange( false );
+	}
+
+	m_spIndexBuffer = pBuffer;
+
+	return CountChange( true );
+}
+
+/// Filter a change to a range of vertex buffers.
+///
+/// @param[in,out] rStartIndex   Index of the first vertex buffer being set.  This is updated to the first buffer that
+///                              actually changed.
+/// @param[in,out] rBufferCount  Number of vertex buffers being set.  This is updated to the number of buffers from the
+///                              updated start index up to and including the last buffer that actually changed.
+/// @param[in,out] rppBuffers    Array of vertex buffers being set.  This is updated to match the new start index.
+/// @param[in,out] rpStrides     Array of vertex strides being set.  This is updated to match the new start index.
+/// @param[in,out] rpOffsets     Array of vertex buffer offsets being set.  This is updated to match the new start
+///                              index.
+///
+/// @return  True if any vertex buffer binding changed, false if the entire range is redundant.
+bool RenderStateFilter::FilterVertexBuffers(
+	size_t& rStartIndex,
+	size_t& rBufferCount,
+	RVertexBuffer* const*& rppBuffers,
+	uint32_t*& rpStrides,
+	uint32_t*& rpOffsets )
+{
+	HELIUM_ASSERT( rppBuffers || rBufferCount == 0 );
+	HELIUM_ASSERT( rpStrides || rBufferCount == 0 );
+	HELIUM_ASSERT( rpOffsets || rBufferCount == 0 );
+
+	size_t firstChanged = Invalid< size_t >();
+	size_t lastChanged = Invalid< size_t >();
+	for( size_t rangeIndex = 0; rangeIndex < rBufferCount; ++rangeIndex )
+	{
+		size_t slotIndex = rStartIndex + rangeIndex;
+		RVertexBuffer* pBuffer = rppBuffers[ rangeIndex ];
+		uint32_t stride = rpStrides[ rangeIndex ];
+		uint32_t offset = rpOffsets[ rangeIndex ];
+		if( slotIndex < VERTEX_BUFFER_SLOT_COUNT )
+		{
+			if( m_vertexBuffers[ slotIndex ] == pBuffer &&
+				m_vertexStrides[ slotIndex ] == stride &&
+				m_vertexOffsets[ slotIndex ] == offset )
+			{
+				continue;
+			}
+
+			m_vertexBuffers[ slotIndex ] = pBuffer;
+			m_vertexStrides[ slotIndex ] = stride;
+			m_vertexOffsets[ slotIndex ] = offset;
+		}
+
+		if( IsInvalid( firstChanged ) )
+		{
+			firstChanged = rangeIndex;
+		}
+
+		lastChanged = rangeIndex;
+	}
+
+	if( !CountSlotRange( rBufferCount, firstChanged, lastChanged ) )
+	{
+		return false;
+	}
+
+	rStartIndex += firstChanged;
+	rBufferCount = lastChanged - firstChanged + 1;
+	rppBuffers += firstChanged;
+	rpStrides += firstChanged;
+	rpOffsets += firstChanged;
+
+	return true;
+}
+
+/// Filter a vertex input layout change.
+///
+/// @param[in] pLayout  Vertex input layout being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterVertexInputLayout( RVertexInputLayout* pLayout )
+{
+	if( m_spVertexInputLayout == pLayout )
+	{
+		return CountChange( false );
+	}
+
+	m_spVertexInputLayout = pLayout;
+
+	return CountChange( true );
+}
+
+/// Filter a vertex shader change.
+///
+/// @param[in] pShader  Vertex shader being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterVertexShader( RVertexShader* pShader )
+{
+	if( m_spVertexShader == pShader )
+	{
+		return CountChange( false );
+	}
+
+	m_spVertexShader = pShader;
+
+	return CountChange( true );
+}
+
+/// Filter a pixel shader change.
+///
+/// @param[in] pShader  Pixel shader being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterPixelShader( RPixelShader* pShader )
+{
+	if( m_spPixelShader == pShader )
+	{
+		return CountChange( false );
+	}
+
+	m_spPixelShader = pShader;
+
+	return CountChange( true );
+}
+
+/// Filter a change to a range of vertex shader constant buffers.
+///
+/// Note that only the buffer bindings are compared.  Command proxy implementations that copy constant buffer contents
+/// when a buffer is bound must track changes to buffer contents themselves.
+///
+/// @param[in,out] rStartIndex   Index of the first constant buffer being set.  This is updated to the first buffer
+///                              that actually changed.
+/// @param[in,out] rBufferCount  Number of constant buffers being set.  This is updated to the number of buffers from
+///                              the updated start index up to and including the last buffer that actually changed.
+/// @param[in,out] rppBuffers    Array of constant buffers being set.  This is updated to match the new start index.
+/// @param[in,out] rpLimitSizes  Optional array of update size limits (can be null).  If not null, this is updated to
+///                              match the new start index.
+/// @param[in,out] rpOffsets     Optional array of bound range offsets (can be null).  If not null, this is updated to
+///                              match the new start index.
+/// @param[in,out] rpSizes       Optional array of bound range sizes (can be null).  If not null, this is updated to
+///                              match the new start index.
+///
+/// @return  True if any constant buffer binding changed, false if the entire range is redundant.
+///
+/// @see FilterPixelConstantBuffers()
+bool RenderStateFilter::FilterVertexConstantBuffers(
+	size_t& rStartIndex,
+	size_t& rBufferCount,
+	RConstantBuffer* const*& rppBuffers,
+	const size_t*& rpLimitSizes,
+	const uint32_t*& rpOffsets,
+	const uint32_t*& rpSizes )
+{
+	return FilterConstantBuffers(
+		m_vertexConstantBuffers,
+		rStartIndex,
+		rBufferCount,
+		rppBuffers,
+		rpLimitSizes,
+		rpOffsets,
+		rpSizes );
+}
+
+/// Filter a change to a range of pixel shader constant buffers.
+///
+/// @copydetails FilterVertexConstantBuffers()
+///
+/// @see FilterVertexConstantBuffers()
+bool RenderStateFilter::FilterPixelConstantBuffers(
+	size_t& rStartIndex,
+	size_t& rBufferCount,
+	RConstantBuffer* const*& rppBuffers,
+	const size_t*& rpLimitSizes,
+	const uint32_t*& rpOffsets,
+	const uint32_t*& rpSizes )
+{
+	return FilterConstantBuffers(
+		m_pixelConstantBuffers,
+		rStartIndex,
+		rBufferCount,
+		rppBuffers,
+		rpLimitSizes,
+		rpOffsets,
+		rpSizes );
+}
+
+/// Filter a texture change.
+///
+/// @param[in] samplerIndex  Index of the sampler for which the texture is being set.
+/// @param[in] pTexture      Texture being set.
+///
+/// @return  True if the state change should be issued, false if it is redundant.
+bool RenderStateFilter::FilterTexture( size_t samplerIndex, RTexture* pTexture )
+{
+	if( samplerIndex >= SAMPLER_SLOT_COUNT )
+	{
+		return CountChange( true );
+	}
+
+	if( m_textures[ samplerIndex ] == pTexture )
+	{
+		return CountChange( false );
+	}
+
+	m_textures[ samplerIndex ] = pTexture;
+
+	return CountChange( true );
+}
+
+/// Reset all shadow state, releasing any references held to render resources.
+///
+/// After a reset, all slots are considered to be bound to null, and the viewport is considered unknown.
+void RenderStateFilter::Reset()
+{
+	m_spRasterizerState.Release();
+	m_spBlendState.Release();
+	m_spDepthStencilState.Release();
+	m_stencilReferenceValue = 0;
+
+	m_spRenderTargetSurface.Release();
+	m_spDepthStencilSurface.Release();
+	MemoryZero( m_viewport, sizeof( m_viewport ) );
+	m_bViewportValid = false;
+
+	m_spIndexBuffer.Release();
+	m_spVertexInputLayout.Release();
+
+	m_spVertexShader.Release();
+	m_spPixelShader.Release();
+
+	for( size_t slotIndex = 0; slotIndex < SAMPLER_SLOT_COUNT; ++slotIndex )
+	{
+		m_samplerStates[ slotIndex ].Release();
+		m_textures[ slotIndex ].Release();
+	}
+
+	for( size_t slotIndex = 0; slotIndex < VERTEX_BUFFER_SLOT_COUNT; ++slotIndex )
+	{
+		m_vertexBuffers[ slotIndex ].Release();
+		m_vertexStrides[ slotIndex ] = 0;
+		m_vertexOffsets[ slotIndex ] = 0;
+	}
+
+	for( size_t slotIndex = 0; slotIndex < CONSTANT_BUFFER_SLOT_COUNT; ++slotIndex )
+	{
+		m_vertexConstantBuffers.buffers[ slotIndex ].Release();
+		SetInvalid( m_vertexConstantBuffers.limitSizes[ slotIndex ] );
+		m_vertexConstantBuffers.offsets[ slotIndex ] = 0;
+		SetInvalid( m_vertexConstantBuffers.sizes[ slotIndex ] );
+
+		m_pixelConstantBuffers.buffers[ slotIndex ].Release();
+		SetInvalid( m_pixelConstantBuffers.limitSizes[ slotIndex ] );
+		m_pixelConstantBuffers.offsets[ slotIndex ] = 0;
+		SetInvalid( m_pixelConstantBuffers.sizes[ slotIndex ] );
+	}
+}
+
+/// Reset the issued and filtered state change counters to zero.
+///
+/// @see GetIssuedCount(), GetFilteredCount()
+void RenderStateFilter::ResetCounters()
+{
+	m_issuedCount = 0;
+	m_filteredCount = 0;
+}
+
+/// Filter a change to a range of constant buffers for a given shader type.
+///
+/// @param[in]     rSlots        Shadow state for the constant buffer slots of the shader type being updated.
+/// @param[in,out] rStartIndex   Index of the first constant buffer being set.
+/// @param[in,out] rBufferCount  Number of constant buffers being set.
+/// @param[in,out] rppBuffers    Array of constant buffers being set.
+/// @param[in,out] rpLimitSizes  Optional array of update size limits (can be null).
+/// @param[in,out] rpOffsets     Optional array of bound range offsets (can be null).
+/// @param[in,out] rpSizes       Optional array of bound range sizes (can be null).
+///
+/// @return  True if any constant buffer binding changed, false if the entire range is redundant.
+///
+/// @see FilterVertexConstantBuffers(), FilterPixelConstantBuffers()
+bool RenderStateFilter::FilterConstantBuffers(
+	ConstantBufferSlots& rSlots,
+	size_t& rStartIndex,
+	size_t& rBufferCount,
+	RConstantBuffer* const*& rppBuffers,
+	const size_t*& rpLimitSizes,
+	const uint32_t*& rpOffsets,
+	const uint32_t*& rpSizes )
+{
+	HELIUM_ASSERT( rppBuffers || rBufferCount == 0 );
+
+	size_t firstChanged = Invalid< size_t >();
+	size_t lastChanged = Invalid< size_t >();
+	for( size_t rangeIndex = 0; rangeIndex < rBufferCount; ++rangeIndex )
+	{
+		size_t slotIndex = rStartIndex + rangeIndex;
+		RConstantBuffer* pBuffer = rppBuffers[ rangeIndex ];
+		size_t limitSize = ( rpLimitSizes ? rpLimitSizes[ rangeIndex ] : Invalid< size_t >() );
+		uint32_t offset = ( rpOffsets ? rpOffsets[ rangeIndex ] : 0 );
+		uint32_t size = ( rpSizes ? rpSizes[ rangeIndex ] : Invalid< uint32_t >() );
+		if( slotIndex < CONSTANT_BUFFER_SLOT_COUNT )
+		{
+			if( rSlots.buffers[ slotIndex ] == pBuffer &&
+				rSlots.limitSizes[ slotIndex ] == limitSize &&
+				rSlots.offsets[ slotIndex ] == offset &&
+				rSlots.sizes[ slotIndex ] == size )
+			{
+				continue;
+			}
+
+			rSlots.buffers[ slotIndex ] = pBuffer;
+			rSlots.limitSizes[ slotIndex ] = limitSize;
+			rSlots.offsets[ slotIndex ] = offset;
+			rSlots.sizes[ slotIndex ] = size;
+		}
+
+		if( IsInvalid( firstChanged ) )
+		{
+			firstChanged = rangeIndex;
+		}
+
+		lastChanged = rangeIndex;
+	}
+
+	if( !CountSlotRange( rBufferCount, firstChanged, lastChanged ) )
+	{
+		return false;
+	}
+
+	rStartIndex += firstChanged;
+	rBufferCount = lastChanged - firstChanged + 1;
+	rppBuffers += firstChanged;
+	if( rpLimitSizes )
+	{
+		rpLimitSizes += firstChanged;
+	}
+
+	if( rpOffsets )
+	{
+		rpOffsets += firstChanged;
+	}
+
+	if( rpSizes )
+	{
+		rpSizes += firstChanged;
+	}
+
+	return true;
+}
+
+/// Update the state change counters for a range of slots.
+///
+/// @param[in] slotCount     Number of slots originally requested.
+/// @param[in] firstChanged  Offset of the first changed slot within the requested range, or an invalid index if no
+///                          slots changed.
+/// @param[in] lastChanged   Offset of the last changed slot within the requested range.
+///
+/// @return  True if any slots changed, false if not.
+bool RenderStateFilter::CountSlotRange( size_t slotCount, size_t firstChanged, size_t lastChanged )
+{
+	if( IsInvalid( firstChanged ) )
+	{
+		m_filteredCount += static_cast< uint32_t >( slotCount );
+
+		return false;
+	}
+
+	size_t issuedCount = lastChanged - firstChanged + 1;
+	m_issuedCount += static_cast< uint32_t >( issuedCount );
+	m_filteredCount += static_cast< uint32_t >( slotCount - issuedCount );
+
+	return true;
+}
+
+/// Update the state change counters for a single state change.
+///
+/// @param[in] bChanged  True if the state changed, false if the change was redundant.
+///
+/// @return  The value of bChanged.
+bool RenderStateFilter::CountChange( bool bChanged )
+{
+	if( bChanged )
+	{
+		++m_issuedCount;
+	}
+	else
+	{
+		++m_filteredCount;
+	}
+
+	return bChanged;
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Rendering/RRenderResource.h"
+
+namespace Helium
+{
+    HELIUM_DECLARE_RPTR( RRasterizerState );
+    HELIUM_DECLARE_RPTR( RBlendState );
+    HELIUM_DECLARE_RPTR( RDepthStencilState );
+    HELIUM_DECLARE_RPTR( RSamplerState );
+
+    HELIUM_DECLARE_RPTR( RSurface );
+
+    HELIUM_DECLARE_RPTR( RIndexBuffer );
+    HELIUM_DECLARE_RPTR( RVertexBuffer );
+    HELIUM_DECLARE_RPTR( RVertexInputLayout );
+
+    HELIUM_DECLARE_RPTR( RVertexShader );
+    HELIUM_DECLARE_RPTR( RPixelShader );
+
+    HELIUM_DECLARE_RPTR( RConstantBuffer );
+
+    HELIUM_DECLARE_RPTR( RTexture );
+
+    /// Shadow copy of the state bound through a render command proxy, used to skip redundant state changes.
+    ///
+    /// Command proxy implementations call the matching Filter*() function at the start of each state change, and only
+    /// forward the change to the underlying graphics API if it returns true.  Functions that set a range of slots
+    /// narrow the range in place to the span of slots that actually changed.  Slots beyond the range tracked by the
+    /// filter are always treated as changed.
+    ///
+    /// The filter holds references to the resources it tracks, so Reset() should be called when the proxy unbinds its
+    /// resources (or whenever the underlying API state is modified outside of the proxy).  After a reset, every slot is
+    /// considered to be bound to null.
+    class HELIUM_RENDERING_API RenderStateFilter : NonCopyable
+    {
+    public:
+        /// Number of sampler and texture slots tracked.
+        static const size_t SAMPLER_SLOT_COUNT = 16;
+        /// Number of vertex buffer slots tracked.
+        static const size_t VERTEX_BUFFER_SLOT_COUNT = 16;
+        /// Number of constant buffer slots tracked for each shader type.
+        static const size_t CONSTANT_BUFFER_SLOT_COUNT = 16;
+
+        /// @name Construction/Destruction
+        //@{
+        RenderStateFilter();
+        ~RenderStateFilter();
+        //@}
+
+        /// @name State Filtering
+        //@{
+        bool FilterRasterizerState( RRasterizerState* pState );
+        bool FilterBlendState( RBlendState* pState );
+        bool FilterDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue );
+        bool FilterSamplerStates( size_t& rStartIndex, size_t& rSamplerCount, RSamplerState* const*& rppStates );
+
+        bool FilterRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface );
+        bool FilterViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+
+        bool FilterIndexBuffer( RIndexBuffer* pBuffer );
+        bool FilterVertexBuffers(
+            size_t& rStartIndex, size_t& rBufferCount, RVertexBuffer* const*& rppBuffers, uint32_t*& rpStrides,
+            uint32_t*& rpOffsets );
+        bool FilterVertexInputLayout( RVertexInputLayout* pLayout );
+
+        bool FilterVertexShader( RVertexShader* pShader );
+        bool FilterPixelShader( RPixelShader* pShader );
+
+        bool FilterVertexConstantBuffers(
+            size_t& rStartIndex, size_t& rBufferCount, RConstantBuffer* const*& rppBuffers,
+            const size_t*& rpLimitSizes, const uint32_t*& rpOffsets, const uint32_t*& rpSizes );
+        bool FilterPixelConstantBuffers(
+            size_t& rStartIndex, size_t& rBufferCount, RConstantBuffer* const*& rppBuffers,
+            const size_t*& rpLimitSizes, const uint32_t*& rpOffsets, const uint32_t*& rpSizes );
+
+        bool FilterTexture( size_t samplerIndex, RTexture* pTexture );
+
+        void Reset();
+        //@}
+
+        /// @name State Access
+        //@{
+        inline RSamplerState* GetSamplerState( size_t samplerIndex ) const;
+        //@}
+
+        /// @name Statistics
+        //@{
+        inline uint32_t GetIssuedCount() const;
+        inline uint32_t GetFilteredCount() const;
+        void ResetCounters();
+        //@}
+
+    private:
+        /// Shadow state for a set of constant buffer slots.
+        struct ConstantBufferSlots
+        {
+            /// Bound constant buffers.
+            RConstantBufferPtr buffers[ CONSTANT_BUFFER_SLOT_COUNT ];
+            /// Update size limits for each bound constant buffer.
+            size_t limitSizes[ CONSTANT_BUFFER_SLOT_COUNT ];
+            /// Byte offsets of the bound range within each constant buffer.
+            uint32_t offsets[ CONSTANT_BUFFER_SLOT_COUNT ];
+            /// Byte sizes of the bound range within each constant buffer.
+            uint32_t sizes[ CONSTANT_BUFFER_SLOT_COUNT ];
+        };
+
+        /// Current rasterizer state.
+        RRasterizerStatePtr m_spRasterizerState;
+        /// Current blend state.
+        RBlendStatePtr m_spBlendState;
+        /// Current depth-stencil state.
+        RDepthStencilStatePtr m_spDepthStencilState;
+        /// Current sampler states.
+        RSamplerStatePtr m_samplerStates[ SAMPLER_SLOT_COUNT ];
+
+        /// Current render target surface.
+        RSurfacePtr m_spRenderTargetSurface;
+        /// Current depth-stencil surface.
+        RSurfacePtr m_spDepthStencilSurface;
+        /// Current viewport (x, y, width, height).
+        uint32_t m_viewport[ 4 ];
+
+        /// Current index buffer.
+        RIndexBufferPtr m_spIndexBuffer;
+        /// Current vertex buffers.
+        RVertexBufferPtr m_vertexBuffers[ VERTEX_BUFFER_SLOT_COUNT ];
+        /// Current vertex buffer strides.
+        uint32_t m_vertexStrides[ VERTEX_BUFFER_SLOT_COUNT ];
+        /// Current vertex buffer offsets.
+        uint32_t m_vertexOffsets[ VERTEX_BUFFER_SLOT_COUNT ];
+        /// Current vertex input layout.
+        RVertexInputLayoutPtr m_spVertexInputLayout;
+
+        /// Current vertex shader.
+        RVertexShaderPtr m_spVertexShader;
+        /// Current pixel shader.
+        RPixelShaderPtr m_spPixelShader;
+
+        /// Current vertex shader constant buffers.
+        ConstantBufferSlots m_vertexConstantBuffers;
+        /// Current pixel shader constant buffers.
+        ConstantBufferSlots m_pixelConstantBuffers;
+
+        /// Current textures.
+        RTexturePtr m_textures[ SAMPLER_SLOT_COUNT ];
+
+        /// Number of state changes passed through to the command proxy.
+        uint32_t m_issuedCount;
+        /// Number of redundant state changes skipped.
+        uint32_t m_filteredCount;
+
+        /// Current stencil reference value.
+        uint8_t m_stencilReferenceValue;
+        /// True if the current viewport is known.
+        bool m_bViewportValid;
+
+        /// @name Private Utility Functions
+        //@{
+        bool FilterConstantBuffers(
+            ConstantBufferSlots& rSlots, size_t& rStartIndex, size_t& rBufferCount,
+            RConstantBuffer* const*& rppBuffers, const size_t*& rpLimitSizes, const uint32_t*& rpOffsets,
+            const uint32_t*& rpSizes );
+        bool CountSlotRange( size_t slotCount, size_t firstChanged, size_t lastChanged );
+        bool CountChange( bool bChanged );
+        //@}
+    };
+}
+
+#include "Rendering/RenderStateFilter.inl"
@@ -0,0 +1,35 @@
+namespace Helium
+{
+    /// Get the number of state changes that were not filtered since the counters were last reset.
+    ///
+    /// For functions that set a range of slots, each slot within the narrowed range is counted separately.
+    ///
+    /// @return  Number of issued state changes.
+    ///
+    /// @see GetFilteredCount(), ResetCounters()
+    uint32_t RenderStateFilter::GetIssuedCount() const
+    {
+        return m_issuedCount;
+    }
+
+    /// Get the number of redundant state changes skipped since the counters were last reset.
+    ///
+    /// @return  Number of filtered state changes.
+    ///
+    /// @see GetIssuedCount(), ResetCounters()
+    uint32_t RenderStateFilter::GetFilteredCount() const
+    {
+        return m_filteredCount;
+    }
+
+    /// Get the sampler state last set for a sampler slot.
+    ///
+    /// @param[in] samplerIndex  Sampler slot index.
+    ///
+    /// @return  Current sampler state, or null if no sampler state is set or the slot is beyond the range tracked by
+    ///          the filter.
+    RSamplerState* RenderStateFilter::GetSamplerState( size_t samplerIndex ) const
+    {
+        return ( samplerIndex < SAMPLER_SLOT_COUNT ? m_samplerStates[ samplerIndex ].Get() : NULL );
+    }
+}
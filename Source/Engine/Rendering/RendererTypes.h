@@ -6,12 +6,23 @@ namespace Helium
 {
     /// Maximum simultaneous render targets supported by the engine (note that the render device may support less).
     static const size_t SIMULTANEOUS_RENDER_TARGET_COUNT_MAX = 16;
+    /// Vertex buffer stream index from which per-instance data is read during instanced draw calls (streams below this
+    /// index provide per-vertex data).
+    static const size_t INSTANCE_DATA_VERTEX_STREAM_INDEX = 1;
+    /// Required alignment, in bytes, of constant buffer range offsets and sizes (one four-component floating-point
+    /// vector register).
+    static const size_t CONSTANT_BUFFER_RANGE_ALIGNMENT = 16;
 
     /// Renderer feature support flags.
     enum ERendererFeatureFlag
     {
         /// Depth texture support (for shadow mapping and depth-based post effects).
-        RENDERER_FEATURE_FLAG_DEPTH_TEXTURE = ( 1 << 0 )
+        RENDERER_FEATURE_FLAG_DEPTH_TEXTURE = ( 1 << 0 ),
+        /// Hardware instancing support (RRenderCommandProxy::DrawIndexedInstanced()).
+        RENDERER_FEATURE_FLAG_INSTANCING    = ( 1 << 1 ),
+        /// The device can be used from threads other than the one that created it (required for pipelined
+        /// rendering on a dedicated render thread).
+        RENDERER_FEATURE_FLAG_MULTITHREADED = ( 1 << 2 )
     };
 
     /// Triangle fill modes.
@@ -321,6 +332,8 @@ namespace Helium
         RENDERER_VERTEX_DATA_TYPE_FLOAT16_2,
         /// 4-component, half-precision float.
         RENDERER_VERTEX_DATA_TYPE_FLOAT16_4,
+        /// 4-component, signed 16-bit integer, normalized by dividing by 32767.
+        RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM,
 
         RENDERER_VERTEX_DATA_TYPE_MAX,
         RENDERER_VERTEX_DATA_TYPE_LAST = RENDERER_VERTEX_DATA_TYPE_MAX - 1
@@ -362,6 +375,11 @@ namespace Helium
         RENDERER_PIXEL_FORMAT_BC3,
         /// BC3 (DXT5) compressed in sRGB color space.
         RENDERER_PIXEL_FORMAT_BC3_SRGB,
+        /// BC5 (3Dc/ATI2) compressed.
+        /// - Two separately compressed 8-bit channels (red and green).
+        /// - 4x4 texel compressed blocks.
+        /// - 128 bits per compressed block (8 bits per texel within each block).
+        RENDERER_PIXEL_FORMAT_BC5,
 
         /// Uncompressed, 64-bit floating-point RGB pixel with alpha (16-bit floating-point value per channel).
         RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT,
@@ -5,7 +5,7 @@ using namespace Helium;
 
 /// Get whether a given pixel format is a compressed pixel format.
 ///
-/// @return  True if the format is compressed using BC1, BC2, or BC3, false otherwise.
+/// @return  True if the format is compressed using BC1, BC2, BC3, or BC5, false otherwise.
 bool RendererUtil::IsCompressedFormat( ERendererPixelFormat format )
 {
 	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
@@ -21,6 +21,7 @@ bool RendererUtil::IsCompressedFormat( ERendererPixelFormat format )
 		true,   // RENDERER_PIXEL_FORMAT_BC2_SRGB
 		true,   // RENDERER_PIXEL_FORMAT_BC3
 		true,   // RENDERER_PIXEL_FORMAT_BC3_SRGB
+		true,   // RENDERER_PIXEL_FORMAT_BC5
 		false,  // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
 		false   // RENDERER_PIXEL_FORMAT_DEPTH
 	};
@@ -64,6 +65,7 @@ uint32_t RendererUtil::PixelToBlockRowCount( uint32_t pixelRowCount, ERendererPi
         4,  // RENDERER_PIXEL_FORMAT_BC2_SRGB
         4,  // RENDERER_PIXEL_FORMAT_BC3
         4,  // RENDERER_PIXEL_FORMAT_BC3_SRGB
+        4,  // RENDERER_PIXEL_FORMAT_BC5
         1,  // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
         1   // RENDERER_PIXEL_FORMAT_DEPTH
     };
@@ -77,6 +79,54 @@ uint32_t RendererUtil::PixelToBlockRowCount( uint32_t pixelRowCount, ERendererPi
     return blockRowCount;
 }
 
+/// Compute the amount of memory needed to store a two-dimensional texture.
+///
+/// @param[in] width     Width of the base mip level, in pixels.
+/// @param[in] height    Height of the base mip level, in pixels.
+/// @param[in] mipCount  Number of mip levels.
+/// @param[in] format    Pixel format.
+///
+/// @return  Total size of all mip levels, in bytes (not including any padding added by the graphics driver).
+size_t RendererUtil::GetTexture2dSize(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipCount,
+    ERendererPixelFormat format )
+{
+    HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+
+    static const uint32_t BYTES_PER_BLOCK[] =
+    {
+        4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8
+        4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8_SRGB
+        1,   // RENDERER_PIXEL_FORMAT_R8
+        8,   // RENDERER_PIXEL_FORMAT_BC1
+        8,   // RENDERER_PIXEL_FORMAT_BC1_SRGB
+        16,  // RENDERER_PIXEL_FORMAT_BC2
+        16,  // RENDERER_PIXEL_FORMAT_BC2_SRGB
+        16,  // RENDERER_PIXEL_FORMAT_BC3
+        16,  // RENDERER_PIXEL_FORMAT_BC3_SRGB
+        16,  // RENDERER_PIXEL_FORMAT_BC5
+        8,   // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
+        4    // RENDERER_PIXEL_FORMAT_DEPTH
+    };
+
+    HELIUM_COMPILE_ASSERT( HELIUM_ARRAY_COUNT( BYTES_PER_BLOCK ) == RENDERER_PIXEL_FORMAT_MAX );
+
+    // Blocks are square, so the block column count can be computed the same way as the block row count.
+    size_t size = 0;
+    for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    {
+        size += static_cast< size_t >( PixelToBlockRowCount( width, format ) ) *
+            PixelToBlockRowCount( height, format ) * BYTES_PER_BLOCK[ format ];
+
+        width = ( width + 1 ) / 2;
+        height = ( height + 1 ) / 2;
+    }
+
+    return size;
+}
+
 /// Computer the pixel pack alignment for a given pixel pitch.
 ///
 /// @param[in] pixelPitch    Number of bytes for a row of pixel/block data.
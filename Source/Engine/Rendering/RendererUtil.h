@@ -13,6 +13,8 @@ namespace Helium
         static bool IsCompressedFormat( ERendererPixelFormat format );
         static bool IsSrgbPixelFormat( ERendererPixelFormat format );
         static uint32_t PixelToBlockRowCount( uint32_t pixelRowCount, ERendererPixelFormat format );
+        static size_t GetTexture2dSize(
+            uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format );
         //@}
 
         /// @name Pixel Alignment Math
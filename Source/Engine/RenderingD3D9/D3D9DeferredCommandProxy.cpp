@@ -395,7 +395,9 @@ public:
         size_t startIndex,
         size_t bufferCount,
         RConstantBuffer* const* ppBuffers,
-        const size_t* pLimitSizes )
+        const size_t* pLimitSizes,
+        const uint32_t* pOffsets,
+        const uint32_t* pSizes )
         : m_startIndex( startIndex )
         , m_bufferCount( bufferCount )
     {
@@ -420,6 +422,24 @@ public:
         {
             MemorySet( m_limitSizes, 0xff, bufferCount * sizeof( size_t ) );
         }
+
+        if( pOffsets )
+        {
+            MemoryCopy( m_offsets, pOffsets, bufferCount * sizeof( uint32_t ) );
+        }
+        else
+        {
+            MemoryZero( m_offsets, bufferCount * sizeof( uint32_t ) );
+        }
+
+        if( pSizes )
+        {
+            MemoryCopy( m_sizes, pSizes, bufferCount * sizeof( uint32_t ) );
+        }
+        else
+        {
+            MemorySet( m_sizes, 0xff, bufferCount * sizeof( uint32_t ) );
+        }
     }
 
     ~D3D9SetConstantBuffersCommand()
@@ -431,6 +451,8 @@ protected:
     size_t m_bufferCount;
     RConstantBufferPtr m_buffers[ D3D9ImmediateCommandProxy::CONSTANT_BUFFER_SLOT_COUNT ];
     size_t m_limitSizes[ D3D9ImmediateCommandProxy::CONSTANT_BUFFER_SLOT_COUNT ];
+    uint32_t m_offsets[ D3D9ImmediateCommandProxy::CONSTANT_BUFFER_SLOT_COUNT ];
+    uint32_t m_sizes[ D3D9ImmediateCommandProxy::CONSTANT_BUFFER_SLOT_COUNT ];
 };
 
 class D3D9SetVertexConstantBuffersCommand : public D3D9SetConstantBuffersCommand
@@ -440,8 +462,10 @@ public:
         size_t startIndex,
         size_t bufferCount,
         RConstantBuffer* const* ppBuffers,
-        const size_t* pLimitSizes )
-        : D3D9SetConstantBuffersCommand( startIndex, bufferCount, ppBuffers, pLimitSizes )
+        const size_t* pLimitSizes,
+        const uint32_t* pOffsets,
+        const uint32_t* pSizes )
+        : D3D9SetConstantBuffersCommand( startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes )
     {
     }
 
@@ -451,7 +475,9 @@ public:
             m_startIndex,
             m_bufferCount,
             &static_cast< RConstantBuffer* const& >( m_buffers[ 0 ] ),
-            m_limitSizes );
+            m_limitSizes,
+            m_offsets,
+            m_sizes );
     }
 };
 
@@ -462,8 +488,10 @@ public:
         size_t startIndex,
         size_t bufferCount,
         RConstantBuffer* const* ppBuffers,
-        const size_t* pLimitSizes )
-        : D3D9SetConstantBuffersCommand( startIndex, bufferCount, ppBuffers, pLimitSizes )
+        const size_t* pLimitSizes,
+        const uint32_t* pOffsets,
+        const uint32_t* pSizes )
+        : D3D9SetConstantBuffersCommand( startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes )
     {
     }
 
@@ -473,7 +501,9 @@ public:
             m_startIndex,
             m_bufferCount,
             &static_cast< RConstantBuffer* const& >( m_buffers[ 0 ] ),
-            m_limitSizes );
+            m_limitSizes,
+            m_offsets,
+            m_sizes );
     }
 };
 
@@ -543,6 +573,53 @@ private:
     uint32_t m_primitiveCount;
 };
 
+class D3D9DrawIndexedInstancedCommand : public D3D9RenderCommand
+{
+public:
+    D3D9DrawIndexedInstancedCommand(
+        ERendererPrimitiveType primitiveType,
+        uint32_t baseVertexIndex,
+        uint32_t minIndex,
+        uint32_t usedVertexCount,
+        uint32_t startIndex,
+        uint32_t primitiveCount,
+        uint32_t instanceCount )
+        : m_primitiveType( primitiveType )
+        , m_baseVertexIndex( baseVertexIndex )
+        , m_minIndex( minIndex )
+        , m_usedVertexCount( usedVertexCount )
+        , m_startIndex( startIndex )
+        , m_primitiveCount( primitiveCount )
+        , m_instanceCount( instanceCount )
+    {
+    }
+
+    ~D3D9DrawIndexedInstancedCommand()
+    {
+    }
+
+    void Execute( D3D9ImmediateCommandProxy* pCommandProxy )
+    {
+        pCommandProxy->DrawIndexedInstanced(
+            m_primitiveType,
+            m_baseVertexIndex,
+            m_minIndex,
+            m_usedVertexCount,
+            m_startIndex,
+            m_primitiveCount,
+            m_instanceCount );
+    }
+
+private:
+    ERendererPrimitiveType m_primitiveType;
+    uint32_t m_baseVertexIndex;
+    uint32_t m_minIndex;
+    uint32_t m_usedVertexCount;
+    uint32_t m_startIndex;
+    uint32_t m_primitiveCount;
+    uint32_t m_instanceCount;
+};
+
 class D3D9DrawUnindexedCommand : public D3D9RenderCommand
 {
 public:
@@ -721,13 +798,15 @@ HELIUM_DEFERRED_COMMAND_PROXY_METHOD(
 
 HELIUM_DEFERRED_COMMAND_PROXY_METHOD(
     SetVertexConstantBuffers,
-    ( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes ),
-    ( startIndex, bufferCount, ppBuffers, pLimitSizes ) )
+    ( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes,
+      const uint32_t* pOffsets, const uint32_t* pSizes ),
+    ( startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes ) )
 
 HELIUM_DEFERRED_COMMAND_PROXY_METHOD(
     SetPixelConstantBuffers,
-    ( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes ),
-    ( startIndex, bufferCount, ppBuffers, pLimitSizes ) )
+    ( size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes,
+      const uint32_t* pOffsets, const uint32_t* pSizes ),
+    ( startIndex, bufferCount, ppBuffers, pLimitSizes, pOffsets, pSizes ) )
 
 HELIUM_DEFERRED_COMMAND_PROXY_METHOD(
     SetTexture,
@@ -740,6 +819,12 @@ HELIUM_DEFERRED_COMMAND_PROXY_METHOD(
       uint32_t startIndex, uint32_t primitiveCount ),
     ( primitiveType, baseVertexIndex, minIndex, usedVertexCount, startIndex, primitiveCount ) )
 
+HELIUM_DEFERRED_COMMAND_PROXY_METHOD(
+    DrawIndexedInstanced,
+    ( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+      uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount ),
+    ( primitiveType, baseVertexIndex, minIndex, usedVertexCount, startIndex, primitiveCount, instanceCount ) )
+
 HELIUM_DEFERRED_COMMAND_PROXY_METHOD(
     DrawUnindexed,
     ( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount ),
@@ -49,16 +49,19 @@ namespace Helium
 
         void SetVertexConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-            const size_t* pLimitSizes = NULL );
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
         void SetPixelConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-            const size_t* pLimitSizes = NULL );
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
 
         void SetTexture( size_t samplerIndex, RTexture* pTexture );
 
         void DrawIndexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
             uint32_t startIndex, uint32_t primitiveCount );
+        void DrawIndexedInstanced(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
         void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
         //@}
 
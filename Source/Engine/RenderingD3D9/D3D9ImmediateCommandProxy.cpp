@@ -39,6 +39,11 @@ D3D9ImmediateCommandProxy::~D3D9ImmediateCommandProxy()
 /// @copydoc RRenderCommandProxy::SetRasterizerState()
 void D3D9ImmediateCommandProxy::SetRasterizerState( RRasterizerState* pState )
 {
+    if( !m_stateFilter.FilterRasterizerState( pState ) )
+    {
+        return;
+    }
+
     D3D9RasterizerState* pD3D9State = static_cast< D3D9RasterizerState* >( pState );
     D3D9RasterizerState* pCurrentState = m_spRasterizerState;
     if( pCurrentState == pD3D9State )
@@ -95,6 +100,11 @@ void D3D9ImmediateCommandProxy::SetRasterizerState( RRasterizerState* pState )
 /// @copydoc RRenderCommandProxy::SetBlendState()
 void D3D9ImmediateCommandProxy::SetBlendState( RBlendState* pState )
 {
+    if( !m_stateFilter.FilterBlendState( pState ) )
+    {
+        return;
+    }
+
     D3D9BlendState* pD3D9State = static_cast< D3D9BlendState* >( pState );
     D3D9BlendState* pCurrentState = m_spBlendState;
     if( pCurrentState == pD3D9State )
@@ -149,6 +159,11 @@ void D3D9ImmediateCommandProxy::SetBlendState( RBlendState* pState )
 /// @copydoc RRenderCommandProxy::SetDepthStencilState()
 void D3D9ImmediateCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
 {
+    if( !m_stateFilter.FilterDepthStencilState( pState, stencilReferenceValue ) )
+    {
+        return;
+    }
+
     HELIUM_D3D9_VERIFY( m_pDevice->SetRenderState( D3DRS_STENCILREF, stencilReferenceValue ) );
 
     D3D9DepthStencilState* pD3D9State = static_cast< D3D9DepthStencilState* >( pState );
@@ -238,6 +253,11 @@ void D3D9ImmediateCommandProxy::SetSamplerStates(
     size_t samplerCount,
     RSamplerState* const* ppStates )
 {
+    if( !m_stateFilter.FilterSamplerStates( startIndex, samplerCount, ppStates ) )
+    {
+        return;
+    }
+
     HELIUM_ASSERT( ppStates || samplerCount == 0 );
 
     if( startIndex >= HELIUM_ARRAY_COUNT( m_samplerStates ) )
@@ -374,6 +394,11 @@ void D3D9ImmediateCommandProxy::SetSamplerStates(
 /// @copydoc RRenderCommandProxy::SetRenderSurfaces()
 void D3D9ImmediateCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
 {
+    if( !m_stateFilter.FilterRenderSurfaces( pRenderTargetSurface, pDepthStencilSurface ) )
+    {
+        return;
+    }
+
     HELIUM_ASSERT( pRenderTargetSurface );
     // pDepthStencilSurface can be null.
 
@@ -396,6 +421,11 @@ void D3D9ImmediateCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurfac
 /// @copydoc RRenderCommandProxy::SetViewport()
 void D3D9ImmediateCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
 {
+    if( !m_stateFilter.FilterViewport( x, y, width, height ) )
+    {
+        return;
+    }
+
     D3DVIEWPORT9 viewport;
     viewport.X = x;
     viewport.Y = y;
@@ -444,6 +474,11 @@ void D3D9ImmediateCommandProxy::Clear( uint32_t clearFlags, const Color& rColor,
 /// @copydoc RRenderCommandProxy::SetIndexBuffer()
 void D3D9ImmediateCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
 {
+    if( !m_stateFilter.FilterIndexBuffer( pBuffer ) )
+    {
+        return;
+    }
+
     IDirect3DIndexBuffer9* pD3DBuffer = NULL;
     if( pBuffer )
     {
@@ -461,6 +496,11 @@ void D3D9ImmediateCommandProxy::SetVertexBuffers(
     uint32_t* pStrides,
     uint32_t* pOffsets )
 {
+    if( !m_stateFilter.FilterVertexBuffers( startIndex, bufferCount, ppBuffers, pStrides, pOffsets ) )
+    {
+        return;
+    }
+
     HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
     HELIUM_ASSERT( pStrides || bufferCount == 0 );
     HELIUM_ASSERT( pOffsets || bufferCount == 0 );
@@ -519,6 +559,11 @@ void D3D9ImmediateCommandProxy::SetVertexBuffers(
 /// @copydoc RRenderCommandProxy::SetVertexInputLayout()
 void D3D9ImmediateCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
 {
+    if( !m_stateFilter.FilterVertexInputLayout( pLayout ) )
+    {
+        return;
+    }
+
     IDirect3DVertexDeclaration9* pD3DDeclaration = NULL;
     if( pLayout )
     {
@@ -532,6 +577,11 @@ void D3D9ImmediateCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayou
 /// @copydoc RRenderCommandProxy::SetVertexShader()
 void D3D9ImmediateCommandProxy::SetVertexShader( RVertexShader* pShader )
 {
+    if( !m_stateFilter.FilterVertexShader( pShader ) )
+    {
+        return;
+    }
+
     IDirect3DVertexShader9* pD3DShader = NULL;
     if( pShader )
     {
@@ -545,6 +595,11 @@ void D3D9ImmediateCommandProxy::SetVertexShader( RVertexShader* pShader )
 /// @copydoc RRenderCommandProxy::SetPixelShader()
 void D3D9ImmediateCommandProxy::SetPixelShader( RPixelShader* pShader )
 {
+    if( !m_stateFilter.FilterPixelShader( pShader ) )
+    {
+        return;
+    }
+
     IDirect3DPixelShader9* pD3DShader = NULL;
     if( pShader )
     {
@@ -560,8 +615,21 @@ void D3D9ImmediateCommandProxy::SetVertexConstantBuffers(
     size_t startIndex,
     size_t bufferCount,
     RConstantBuffer* const* ppBuffers,
-    const size_t* pLimitSizes )
+    const size_t* pLimitSizes,
+    const uint32_t* pOffsets,
+    const uint32_t* pSizes )
 {
+    if( !m_stateFilter.FilterVertexConstantBuffers(
+        startIndex,
+        bufferCount,
+        ppBuffers,
+        pLimitSizes,
+        pOffsets,
+        pSizes ) )
+    {
+        return;
+    }
+
     HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
 
     if( startIndex >= CONSTANT_BUFFER_SLOT_COUNT )
@@ -588,25 +656,14 @@ void D3D9ImmediateCommandProxy::SetVertexConstantBuffers(
         bufferCount = availableSlots;
     }
 
-    if( pLimitSizes )
-    {
-        for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
-        {
-            m_vertexConstantManager.SetBuffer(
-                startIndex + bufferIndex,
-                static_cast< D3D9ConstantBuffer* >( ppBuffers[ bufferIndex ] ),
-                pLimitSizes[ bufferIndex ] );
-        }
-    }
-    else
+    for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
     {
-        for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
-        {
-            m_vertexConstantManager.SetBuffer(
-                startIndex + bufferIndex,
-                static_cast< D3D9ConstantBuffer* >( ppBuffers[ bufferIndex ] ),
-                Invalid< size_t >() );
-        }
+        m_vertexConstantManager.SetBuffer(
+            startIndex + bufferIndex,
+            static_cast< D3D9ConstantBuffer* >( ppBuffers[ bufferIndex ] ),
+            ( pLimitSizes ? pLimitSizes[ bufferIndex ] : Invalid< size_t >() ),
+            ( pOffsets ? pOffsets[ bufferIndex ] : 0 ),
+            ( pSizes ? pSizes[ bufferIndex ] : Invalid< uint32_t >() ) );
     }
 }
 
@@ -615,8 +672,21 @@ void D3D9ImmediateCommandProxy::SetPixelConstantBuffers(
     size_t startIndex,
     size_t bufferCount,
     RConstantBuffer* const* ppBuffers,
-    const size_t* pLimitSizes )
+    const size_t* pLimitSizes,
+    const uint32_t* pOffsets,
+    const uint32_t* pSizes )
 {
+    if( !m_stateFilter.FilterPixelConstantBuffers(
+        startIndex,
+        bufferCount,
+        ppBuffers,
+        pLimitSizes,
+        pOffsets,
+        pSizes ) )
+    {
+        return;
+    }
+
     HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
 
     if( startIndex >= CONSTANT_BUFFER_SLOT_COUNT )
@@ -643,31 +713,25 @@ void D3D9ImmediateCommandProxy::SetPixelConstantBuffers(
         bufferCount = availableSlots;
     }
 
-    if( pLimitSizes )
+    for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
     {
-        for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
-        {
-            m_pixelConstantManager.SetBuffer(
-                startIndex + bufferIndex,
-                static_cast< D3D9ConstantBuffer* >( ppBuffers[ bufferIndex ] ),
-                pLimitSizes[ bufferIndex ] );
-        }
-    }
-    else
-    {
-        for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
-        {
-            m_pixelConstantManager.SetBuffer(
-                startIndex + bufferIndex,
-                static_cast< D3D9ConstantBuffer* >( ppBuffers[ bufferIndex ] ),
-                Invalid< size_t >() );
-        }
+        m_pixelConstantManager.SetBuffer(
+            startIndex + bufferIndex,
+            static_cast< D3D9ConstantBuffer* >( ppBuffers[ bufferIndex ] ),
+            ( pLimitSizes ? pLimitSizes[ bufferIndex ] : Invalid< size_t >() ),
+            ( pOffsets ? pOffsets[ bufferIndex ] : 0 ),
+            ( pSizes ? pSizes[ bufferIndex ] : Invalid< uint32_t >() ) );
     }
 }
 
 /// @copydoc RRenderCommandProxy::SetTexture()
 void D3D9ImmediateCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
 {
+    if( !m_stateFilter.FilterTexture( samplerIndex, pTexture ) )
+    {
+        return;
+    }
+
     HELIUM_ASSERT( samplerIndex < HELIUM_ARRAY_COUNT( m_textures ) );
     if( samplerIndex >= HELIUM_ARRAY_COUNT( m_textures ) )
     {
@@ -777,6 +841,39 @@ void D3D9ImmediateCommandProxy::DrawIndexed(
         primitiveCount ) );
 }
 
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void D3D9ImmediateCommandProxy::DrawIndexedInstanced(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t minIndex,
+    uint32_t usedVertexCount,
+    uint32_t startIndex,
+    uint32_t primitiveCount,
+    uint32_t instanceCount )
+{
+    HELIUM_ASSERT( instanceCount != 0 );
+
+    // Repeat the per-vertex streams for each instance, and advance the instance data stream once per instance.
+    for( size_t streamIndex = 0; streamIndex < INSTANCE_DATA_VERTEX_STREAM_INDEX; ++streamIndex )
+    {
+        HELIUM_D3D9_VERIFY( m_pDevice->SetStreamSourceFreq(
+            static_cast< UINT >( streamIndex ),
+            D3DSTREAMSOURCE_INDEXEDDATA | instanceCount ) );
+    }
+
+    HELIUM_D3D9_VERIFY( m_pDevice->SetStreamSourceFreq(
+        static_cast< UINT >( INSTANCE_DATA_VERTEX_STREAM_INDEX ),
+        D3DSTREAMSOURCE_INSTANCEDATA | 1u ) );
+
+    DrawIndexed( primitiveType, baseVertexIndex, minIndex, usedVertexCount, startIndex, primitiveCount );
+
+    // Restore the default stream frequencies so that subsequent draw calls are not instanced.
+    for( size_t streamIndex = 0; streamIndex <= INSTANCE_DATA_VERTEX_STREAM_INDEX; ++streamIndex )
+    {
+        HELIUM_D3D9_VERIFY( m_pDevice->SetStreamSourceFreq( static_cast< UINT >( streamIndex ), 1 ) );
+    }
+}
+
 /// @copydoc RRenderCommandProxy::DrawUnindexed()
 void D3D9ImmediateCommandProxy::DrawUnindexed(
     ERendererPrimitiveType primitiveType,
@@ -823,6 +920,8 @@ void D3D9ImmediateCommandProxy::SetFence( RFence* pFence )
 /// @copydoc RRenderCommandProxy::UnbindResources()
 void D3D9ImmediateCommandProxy::UnbindResources()
 {
+    m_stateFilter.Reset();
+
     m_spRasterizerState.Release();
     m_spBlendState.Release();
     m_spDepthStencilState.Release();
@@ -848,8 +947,8 @@ void D3D9ImmediateCommandProxy::UnbindResources()
 
     for( size_t constantBufferIndex = 0; constantBufferIndex < CONSTANT_BUFFER_SLOT_COUNT; ++constantBufferIndex )
     {
-        m_vertexConstantManager.SetBuffer( constantBufferIndex, NULL, Invalid< size_t >() );
-        m_pixelConstantManager.SetBuffer( constantBufferIndex, NULL, Invalid< size_t >() );
+        m_vertexConstantManager.SetBuffer( constantBufferIndex, NULL, Invalid< size_t >(), 0, Invalid< uint32_t >() );
+        m_pixelConstantManager.SetBuffer( constantBufferIndex, NULL, Invalid< size_t >(), 0, Invalid< uint32_t >() );
     }
 }
 
@@ -881,10 +980,18 @@ void D3D9ImmediateCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCom
     rspCommandList.Release();
 }
 
+/// @copydoc RRenderCommandProxy::GetStateFilter()
+const RenderStateFilter* D3D9ImmediateCommandProxy::GetStateFilter() const
+{
+    return &m_stateFilter;
+}
+
 /// Constructor.
 template< typename Pusher, size_t RegisterCount >
 D3D9ImmediateCommandProxy::ConstantManager< Pusher, RegisterCount >::ConstantManager()
 {
+    MemoryZero( m_bufferRegisterOffsets, sizeof( m_bufferRegisterOffsets ) );
+    MemoryZero( m_bufferRegisterCounts, sizeof( m_bufferRegisterCounts ) );
 }
 
 /// Destructor.
@@ -897,15 +1004,19 @@ D3D9ImmediateCommandProxy::ConstantManager< Pusher, RegisterCount >::~ConstantMa
 ///
 /// @param[in] index      Constant buffer slot index.
 /// @param[in] pBuffer    Constant buffer to set.
-/// @param[in] limitSize  Number of bytes, starting from the beginning of the buffer, in which to limit updates to
-///                       shader constant registers.
+/// @param[in] limitSize  Number of bytes, starting from the beginning of the bound range, in which to limit updates
+///                       to shader constant registers.
+/// @param[in] offset     Byte offset of the bound range within the buffer.
+/// @param[in] size       Byte size of the bound range, or an invalid value to bind up to the end of the buffer.
 ///
 /// @see GetBuffer()
 template< typename Pusher, size_t RegisterCount >
 void D3D9ImmediateCommandProxy::ConstantManager< Pusher, RegisterCount >::SetBuffer(
     size_t index,
     D3D9ConstantBuffer* pBuffer,
-    size_t limitSize )
+    size_t limitSize,
+    uint32_t offset,
+    uint32_t size )
 {
     HELIUM_ASSERT( index < HELIUM_ARRAY_COUNT( m_buffers ) );
 
@@ -921,32 +1032,39 @@ void D3D9ImmediateCommandProxy::ConstantManager< Pusher, RegisterCount >::SetBuf
         SetInvalid( m_bufferLimitSizes[ index ] );
     }
 
-    D3D9ConstantBuffer* pOldBuffer = m_buffers[ index ];
-    if( pOldBuffer != pBuffer )
-    {
-        uint_fast16_t oldRegisterCount = 0;
-        if( pOldBuffer )
-        {
-            oldRegisterCount = pOldBuffer->GetRegisterCount();
-        }
+    // Convert the bound range from bytes to registers.
+    HELIUM_ASSERT( offset % ( sizeof( float32_t ) * 4 ) == 0 );
+    HELIUM_ASSERT( IsInvalid( size ) || size % ( sizeof( float32_t ) * 4 ) == 0 );
 
-        uint_fast16_t newRegisterCount = 0;
-        if( pBuffer )
+    uint_fast16_t newRegisterOffset = 0;
+    uint_fast16_t newRegisterCount = 0;
+    if( pBuffer )
+    {
+        uint_fast16_t bufferRegisterCount = pBuffer->GetRegisterCount();
+        newRegisterOffset = static_cast< uint_fast16_t >( Min< size_t >(
+            offset / ( sizeof( float32_t ) * 4 ),
+            bufferRegisterCount ) );
+        newRegisterCount = bufferRegisterCount - newRegisterOffset;
+        if( IsValid( size ) )
         {
-            newRegisterCount = pBuffer->GetRegisterCount();
+            newRegisterCount = static_cast< uint_fast16_t >( Min< size_t >(
+                size / ( sizeof( float32_t ) * 4 ),
+                newRegisterCount ) );
         }
+    }
 
+    D3D9ConstantBuffer* pOldBuffer = m_buffers[ index ];
+    if( pOldBuffer != pBuffer || m_bufferRegisterOffsets[ index ] != newRegisterOffset ||
+        m_bufferRegisterCounts[ index ] != newRegisterCount )
+    {
+        uint_fast16_t oldRegisterCount = m_bufferRegisterCounts[ index ];
         if( oldRegisterCount != newRegisterCount )
         {
             // Register count changed, so invalidate all registers in buffers that follow the one being assigned.
             uint_fast16_t invalidRegisterStart = newRegisterCount;
             for( size_t previousIndex = 0; previousIndex < index; ++previousIndex )
             {
-                D3D9ConstantBuffer* pPreviousBuffer = m_buffers[ previousIndex ];
-                if( pPreviousBuffer )
-                {
-                    invalidRegisterStart += pPreviousBuffer->GetRegisterCount();
-                }
+                invalidRegisterStart += m_bufferRegisterCounts[ previousIndex ];
             }
 
             uint_fast16_t invalidRegisterElementIndex = invalidRegisterStart / ( sizeof( uint32_t ) * 8 );
@@ -969,10 +1087,12 @@ void D3D9ImmediateCommandProxy::ConstantManager< Pusher, RegisterCount >::SetBuf
         }
 
         m_buffers[ index ] = pBuffer;
+        m_bufferRegisterOffsets[ index ] = static_cast< uint16_t >( newRegisterOffset );
+        m_bufferRegisterCounts[ index ] = static_cast< uint16_t >( newRegisterCount );
         if( pBuffer )
         {
-            // Set the buffer tag as one minus its actual tag to force its contents to be updated during the next
-            // Push() call.
+            // Set the buffer tag as one minus its actual tag to force the contents of the bound range to be updated
+            // during the next Push() call.
             m_bufferTags[ index ] = pBuffer->GetTag() - 1;
         }
     }
@@ -1027,10 +1147,11 @@ void D3D9ImmediateCommandProxy::ConstantManager< Pusher, RegisterCount >::Push(
             m_bufferTags[ bufferIndex ] = bufferTag;
         }
 
-        // Push dirty registers.
+        // Push dirty registers from the bound range of the buffer.
         const float32_t* pData = static_cast< const float32_t* >( pBuffer->GetData() );
-        uint_fast16_t bufferRegisterCount = pBuffer->GetRegisterCount();
-        HELIUM_ASSERT( pData || bufferRegisterCount == 0 );
+        HELIUM_ASSERT( pData || pBuffer->GetRegisterCount() == 0 );
+        pData += static_cast< size_t >( m_bufferRegisterOffsets[ bufferIndex ] ) * 4;
+        uint_fast16_t bufferRegisterCount = m_bufferRegisterCounts[ bufferIndex ];
 
         uint_fast16_t bufferRegisterLimit = Min< uint_fast16_t >(
             m_bufferLimitSizes[ bufferIndex ],
@@ -2,6 +2,7 @@
 
 #include "RenderingD3D9/RenderingD3D9.h"
 #include "Rendering/RRenderCommandProxy.h"
+#include "Rendering/RenderStateFilter.h"
 
 namespace Helium
 {
@@ -71,16 +72,19 @@ namespace Helium
 
         void SetVertexConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-            const size_t* pLimitSizes = NULL );
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
         void SetPixelConstantBuffers(
             size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-            const size_t* pLimitSizes = NULL );
+            const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
 
         void SetTexture( size_t samplerIndex, RTexture* pTexture );
 
         void DrawIndexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
             uint32_t startIndex, uint32_t primitiveCount );
+        void DrawIndexedInstanced(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
         void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
         //@}
 
@@ -101,6 +105,11 @@ namespace Helium
         void FinishCommandList( RRenderCommandListPtr& rspCommandList );
         //@}
 
+        /// @name Statistics
+        //@{
+        const RenderStateFilter* GetStateFilter() const;
+        //@}
+
     private:
         /// Shader constant management.
         template< typename Pusher, size_t RegisterCount >
@@ -115,7 +124,7 @@ namespace Helium
 
             /// @name Constant Buffer Access
             //@{
-            void SetBuffer( size_t index, D3D9ConstantBuffer* pBuffer, size_t limitSize );
+            void SetBuffer( size_t index, D3D9ConstantBuffer* pBuffer, size_t limitSize, uint32_t offset, uint32_t size );
             D3D9ConstantBuffer* GetBuffer( size_t index ) const;
             //@}
 
@@ -133,6 +142,10 @@ namespace Helium
             uint32_t m_dirtyRegisters[ ( RegisterCount + sizeof( uint32_t ) * 8 - 1 ) / ( sizeof( uint32_t ) * 8 ) ];
             /// Constant buffer update range limits.
             uint16_t m_bufferLimitSizes[ CONSTANT_BUFFER_SLOT_COUNT ];
+            /// Register offsets of the bound range within each constant buffer.
+            uint16_t m_bufferRegisterOffsets[ CONSTANT_BUFFER_SLOT_COUNT ];
+            /// Number of registers in the bound range of each constant buffer (zero for empty slots).
+            uint16_t m_bufferRegisterCounts[ CONSTANT_BUFFER_SLOT_COUNT ];
             /// Constant value pusher.
             Pusher m_pusher;
         };
@@ -167,6 +180,9 @@ namespace Helium
         /// Direct3D 9 device instance.
         IDirect3DDevice9* m_pDevice;
 
+        /// Shadow state used to skip redundant state changes.
+        RenderStateFilter m_stateFilter;
+
         /// Currently bound rasterizer state.
         D3D9RasterizerStatePtr m_spRasterizerState;
         /// Currently bound blend state.
@@ -188,6 +188,23 @@ bool D3D9Renderer::Initialize()
 		m_featureFlags |= RENDERER_FEATURE_FLAG_DEPTH_TEXTURE;
 	}
 
+	// Hardware instancing (stream source frequency support) is only guaranteed with vertex shader model 3.0.
+	D3DCAPS9 deviceCaps;
+	if( SUCCEEDED( m_pD3D->GetDeviceCaps( D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, &deviceCaps ) ) &&
+		deviceCaps.VertexShaderVersion >= D3DVS_VERSION( 3, 0 ) )
+	{
+		m_featureFlags |= RENDERER_FEATURE_FLAG_INSTANCING;
+	}
+	else
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"Vertex shader model 3.0 is not supported.  Hardware instancing will be disabled.\n" );
+	}
+
+	// The device is always created with D3DCREATE_MULTITHREADED, so it can be driven from a dedicated render thread.
+	m_featureFlags |= RENDERER_FEATURE_FLAG_MULTITHREADED;
+
 	HELIUM_TRACE( TraceLevels::Info, "Direct3D9 initialized successfully.\n" );
 
 	return true;
@@ -278,7 +295,7 @@ bool D3D9Renderer::CreateMainContext( const ContextInitParameters& rInitParamete
 			D3DADAPTER_DEFAULT,
 			D3DDEVTYPE_HAL,
 			static_cast< HWND >( rInitParameters.pWindow ),
-			D3DCREATE_HARDWARE_VERTEXPROCESSING,
+			D3DCREATE_HARDWARE_VERTEXPROCESSING | D3DCREATE_MULTITHREADED,
 			&m_presentParameters,
 			( rInitParameters.bFullscreen ? &m_fullscreenDisplayMode : NULL ),
 			&pD3DDeviceEx );
@@ -291,7 +308,7 @@ bool D3D9Renderer::CreateMainContext( const ContextInitParameters& rInitParamete
 			D3DADAPTER_DEFAULT,
 			D3DDEVTYPE_HAL,
 			static_cast< HWND >( rInitParameters.pWindow ),
-			D3DCREATE_HARDWARE_VERTEXPROCESSING,
+			D3DCREATE_HARDWARE_VERTEXPROCESSING | D3DCREATE_MULTITHREADED,
 			&m_presentParameters,
 			&m_pD3DDevice );
 	}
@@ -657,6 +674,7 @@ RVertexShader* D3D9Renderer::CreateVertexShader( size_t size, const void* pData
 
 		D3D9VertexShader* pShader = new D3D9VertexShader( pD3DShader, false );
 		HELIUM_ASSERT( pShader );
+		pShader->SetMemoryUsage( size );
 
 		pD3DShader->Release();
 
@@ -677,6 +695,7 @@ RVertexShader* D3D9Renderer::CreateVertexShader( size_t size, const void* pData
 
 	D3D9VertexShader* pShader = new D3D9VertexShader( pStaging, true );
 	HELIUM_ASSERT( pShader );
+	pShader->SetMemoryUsage( size );
 
 	return pShader;
 }
@@ -704,6 +723,7 @@ RPixelShader* D3D9Renderer::CreatePixelShader( size_t size, const void* pData )
 
 		D3D9PixelShader* pShader = new D3D9PixelShader( pD3DShader, false );
 		HELIUM_ASSERT( pShader );
+		pShader->SetMemoryUsage( size );
 
 		pD3DShader->Release();
 
@@ -724,6 +744,7 @@ RPixelShader* D3D9Renderer::CreatePixelShader( size_t size, const void* pData )
 
 	D3D9PixelShader* pShader = new D3D9PixelShader( pStaging, true );
 	HELIUM_ASSERT( pShader );
+	pShader->SetMemoryUsage( size );
 
 	return pShader;
 }
@@ -793,6 +814,7 @@ RVertexBuffer* D3D9Renderer::CreateVertexBuffer( size_t size, ERendererBufferUsa
 	}
 
 	HELIUM_ASSERT( pBuffer );
+	pBuffer->SetMemoryUsage( size );
 
 	pD3DBuffer->Release();
 
@@ -873,6 +895,7 @@ RIndexBuffer* D3D9Renderer::CreateIndexBuffer(
 	}
 
 	HELIUM_ASSERT( pBuffer );
+	pBuffer->SetMemoryUsage( size );
 
 	pD3DBuffer->Release();
 
@@ -926,6 +949,7 @@ RConstantBuffer* D3D9Renderer::CreateConstantBuffer(
 	// Create the buffer interface.
 	D3D9ConstantBuffer* pBuffer = new D3D9ConstantBuffer( pBufferMemory, static_cast< uint16_t >( registerCount ) );
 	HELIUM_ASSERT( pBuffer );
+	pBuffer->SetMemoryUsage( actualSize );
 
 	return pBuffer;
 }
@@ -958,6 +982,7 @@ RVertexDescription* D3D9Renderer::CreateVertexDescription(
 		D3DDECLTYPE_UBYTE4,     // RENDERER_VERTEX_DATA_TYPE_UINT8_4
 		D3DDECLTYPE_FLOAT16_2,  // RENDERER_VERTEX_DATA_TYPE_FLOAT16_2
 		D3DDECLTYPE_FLOAT16_4,  // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		D3DDECLTYPE_SHORT4N,    // RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM
 	};
 
 	static const WORD d3dDataTypeSizes[ RENDERER_VERTEX_DATA_TYPE_MAX ] =
@@ -969,6 +994,7 @@ RVertexDescription* D3D9Renderer::CreateVertexDescription(
 		4,   // RENDERER_VERTEX_DATA_TYPE_UINT8_4
 		4,   // RENDERER_VERTEX_DATA_TYPE_FLOAT16_2
 		8,   // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		8,   // RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM
 	};
 
 	static const BYTE d3dUsages[ RENDERER_VERTEX_SEMANTIC_MAX ] =
@@ -1162,6 +1188,7 @@ RTexture2d* D3D9Renderer::CreateTexture2d(
 	}
 
 	HELIUM_ASSERT( pTexture );
+	pTexture->SetMemoryUsage( RendererUtil::GetTexture2dSize( width, height, mipCount, format ) );
 
 	pD3DTexture->Release();
 
@@ -1506,6 +1533,7 @@ D3DFORMAT D3D9Renderer::PixelFormatToD3DFormat( ERendererPixelFormat format ) co
 		D3DFMT_DXT3,           // RENDERER_PIXEL_FORMAT_BC2_SRGB
 		D3DFMT_DXT5,           // RENDERER_PIXEL_FORMAT_BC3
 		D3DFMT_DXT5,           // RENDERER_PIXEL_FORMAT_BC3_SRGB
+		static_cast< D3DFORMAT >( MAKEFOURCC( 'A', 'T', 'I', '2' ) ),  // RENDERER_PIXEL_FORMAT_BC5
 		D3DFMT_A16B16G16R16F,  // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
 		D3DFMT_UNKNOWN         // RENDERER_PIXEL_FORMAT_DEPTH (dummy entry; depth formats handled manually)
 	};
@@ -1762,6 +1790,11 @@ ERendererPixelFormat D3D9Renderer::D3DFormatToPixelFormat( D3DFORMAT d3dFormat,
 			return ( bSrgb ? RENDERER_PIXEL_FORMAT_BC3_SRGB : RENDERER_PIXEL_FORMAT_BC3 );
 		}
 
+	case MAKEFOURCC( 'A', 'T', 'I', '2' ):
+		{
+			return RENDERER_PIXEL_FORMAT_BC5;
+		}
+
 	case D3DFMT_A16B16G16R16F:
 		{
 			return RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT;
@@ -1,16 +1,82 @@
 #include "Precompile.h"
 #include "RenderingGL/GLImmediateCommandProxy.h"
 
+#include "RenderingGL/GLIndexBuffer.h"
 #include "RenderingGL/GLSurface.h"
+#include "RenderingGL/GLTexture2d.h"
+
+#include "Rendering/DeferredRenderCommandList.h"
 
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 
 using namespace Helium;
 
+/// Apply the parameters of a sampler state to the texture bound to the active texture unit.
+///
+/// OpenGL stores sampling parameters with each texture object rather than with the texture unit, so these need to be
+/// applied again whenever a different texture is bound.
+///
+/// @param[in] pGLState  Sampler state to apply.
+static void ApplySamplerState( const GLSamplerState* pGLState )
+{
+	HELIUM_ASSERT( pGLState );
+
+	glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_MIN_FILTER, pGLState->m_minFilter );
+	glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_MAG_FILTER, pGLState->m_magFilter );
+
+	glTexParameterf( pGLState->m_texParameterTarget, GL_TEXTURE_LOD_BIAS, pGLState->m_mipLodBias );
+
+	glTexParameterf( pGLState->m_texParameterTarget, GL_TEXTURE_MAX_ANISOTROPY_EXT, pGLState->m_maxAnisotropy );
+
+	glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_WRAP_S, pGLState->m_addressModeU );
+	glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_WRAP_T, pGLState->m_addressModeV );
+	glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_WRAP_R, pGLState->m_addressModeW );
+}
+
+/// Get the OpenGL primitive mode and vertex count for drawing a number of primitives of a given type.
+///
+/// @param[in]  primitiveType   Primitive type.
+/// @param[in]  primitiveCount  Number of primitives to draw.
+/// @param[out] rVertexCount    Number of vertices (or indices) consumed by the primitives.
+///
+/// @return  OpenGL primitive mode.
+static GLenum GetGLPrimitiveMode( ERendererPrimitiveType primitiveType, uint32_t primitiveCount, GLsizei& rVertexCount )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+
+	switch( primitiveType )
+	{
+	case RENDERER_PRIMITIVE_TYPE_POINT_LIST:
+		rVertexCount = static_cast< GLsizei >( primitiveCount );
+		return GL_POINTS;
+
+	case RENDERER_PRIMITIVE_TYPE_LINE_LIST:
+		rVertexCount = static_cast< GLsizei >( primitiveCount * 2 );
+		return GL_LINES;
+
+	case RENDERER_PRIMITIVE_TYPE_LINE_STRIP:
+		rVertexCount = static_cast< GLsizei >( primitiveCount + 1 );
+		return GL_LINE_STRIP;
+
+	case RENDERER_PRIMITIVE_TYPE_TRIANGLE_STRIP:
+		rVertexCount = static_cast< GLsizei >( primitiveCount + 2 );
+		return GL_TRIANGLE_STRIP;
+
+	case RENDERER_PRIMITIVE_TYPE_TRIANGLE_FAN:
+		rVertexCount = static_cast< GLsizei >( primitiveCount + 2 );
+		return GL_TRIANGLE_FAN;
+
+	default:
+		rVertexCount = static_cast< GLsizei >( primitiveCount * 3 );
+		return GL_TRIANGLES;
+	}
+}
+
 /// Constructor.
 GLImmediateCommandProxy::GLImmediateCommandProxy( GLFWwindow* pGlfwWindow )
 : m_pGlfwWindow( pGlfwWindow )
+, m_indexElementType( GL_UNSIGNED_SHORT )
 {
     HELIUM_ASSERT( pGlfwWindow );
 }
@@ -24,11 +90,14 @@ GLImmediateCommandProxy::~GLImmediateCommandProxy()
 /// @copydoc RRenderCommandProxy::SetRasterizerState()
 void GLImmediateCommandProxy::SetRasterizerState( RRasterizerState* pState )
 {
+	if( !m_stateFilter.FilterRasterizerState( pState ) )
+	{
+		return;
+	}
+
 	GLRasterizerState *pGLState = static_cast< GLRasterizerState* >( pState );
 	HELIUM_ASSERT( pGLState != NULL );
 
-	// TODO: don't make redundant state changes.
-
 	glPolygonMode( GL_FRONT_AND_BACK, pGLState->m_fillMode );
 
 	if( pGLState->m_cullEnable )
@@ -56,11 +125,14 @@ void GLImmediateCommandProxy::SetRasterizerState( RRasterizerState* pState )
 /// @copydoc RRenderCommandProxy::SetBlendState()
 void GLImmediateCommandProxy::SetBlendState( RBlendState* pState )
 {
+	if( !m_stateFilter.FilterBlendState( pState ) )
+	{
+		return;
+	}
+
 	GLBlendState *pGLState = static_cast< GLBlendState* >( pState );
 	HELIUM_ASSERT( pGLState != NULL );
 
-	// TODO: don't make redundant state changes.
-
 	glColorMask(
 		pGLState->m_redWriteMaskEnable,
 		pGLState->m_greenWriteMaskEnable,
@@ -84,11 +156,14 @@ void GLImmediateCommandProxy::SetBlendState( RBlendState* pState )
 /// @copydoc RRenderCommandProxy::SetDepthStencilState()
 void GLImmediateCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
 {
+	if( !m_stateFilter.FilterDepthStencilState( pState, stencilReferenceValue ) )
+	{
+		return;
+	}
+
 	GLDepthStencilState *pGLState = static_cast< GLDepthStencilState* >( pState );
 	HELIUM_ASSERT( pGLState != NULL );
 
-	// TODO: don't make redundant state changes.
-
 	if( pGLState->m_depthTestEnable )
 	{
 		glEnable( GL_DEPTH_TEST );
@@ -133,6 +208,11 @@ void GLImmediateCommandProxy::SetSamplerStates(
 	size_t samplerCount,
 	RSamplerState* const* ppStates )
 {
+	if( !m_stateFilter.FilterSamplerStates( startIndex, samplerCount, ppStates ) )
+	{
+		return;
+	}
+
 	GLint maxActiveTextures = 0;
 	glGetIntegerv( GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxActiveTextures );
 
@@ -157,27 +237,22 @@ void GLImmediateCommandProxy::SetSamplerStates(
 		GLSamplerState *pGLState = static_cast< GLSamplerState* >( ppStates[ i ] );
 		HELIUM_ASSERT( pGLState != NULL );
 
-		// TODO: don't make redundant state changes.
-		
-		const GLenum activeTexture = GL_TEXTURE0 + static_cast< GLenum >( i );
+		const GLenum activeTexture = GL_TEXTURE0 + static_cast< GLenum >( startIndex + i );
 		glActiveTexture( activeTexture );
 
-		glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_MIN_FILTER, pGLState->m_minFilter );
-		glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_MAG_FILTER, pGLState->m_magFilter );
-		
-		glTexParameterf( pGLState->m_texParameterTarget, GL_TEXTURE_LOD_BIAS, pGLState->m_mipLodBias );
-
-		glTexParameterf( pGLState->m_texParameterTarget, GL_TEXTURE_MAX_ANISOTROPY_EXT, pGLState->m_maxAnisotropy );
-
-		glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_WRAP_S, pGLState->m_addressModeU );
-		glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_WRAP_T, pGLState->m_addressModeV );
-		glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_WRAP_R, pGLState->m_addressModeW );
+		// Textures bound later pick up the sampler state in SetTexture().
+		ApplySamplerState( pGLState );
 	}
 }
 
 /// @copydoc RRenderCommandProxy::SetRenderSurfaces()
 void GLImmediateCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
 {
+	if( !m_stateFilter.FilterRenderSurfaces( pRenderTargetSurface, pDepthStencilSurface ) )
+	{
+		return;
+	}
+
 	GLSurface *pGLRenderTargetSurface = static_cast< GLSurface* >( pRenderTargetSurface );
 	HELIUM_ASSERT( pGLRenderTargetSurface );
 
@@ -218,6 +293,11 @@ void GLImmediateCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface,
 /// @copydoc RRenderCommandProxy::SetViewport()
 void GLImmediateCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
 {
+	if( !m_stateFilter.FilterViewport( x, y, width, height ) )
+	{
+		return;
+	}
+
 	glViewport( x, y, width, height );
 }
 
@@ -263,7 +343,18 @@ void GLImmediateCommandProxy::Clear( uint32_t clearFlags, const Color& rColor, f
 /// @copydoc RRenderCommandProxy::SetIndexBuffer()
 void GLImmediateCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
 {
-	HELIUM_BREAK();
+	if( !m_stateFilter.FilterIndexBuffer( pBuffer ) )
+	{
+		return;
+	}
+
+	GLIndexBuffer* pGLBuffer = static_cast< GLIndexBuffer* >( pBuffer );
+	if( pGLBuffer )
+	{
+		m_indexElementType = pGLBuffer->GetGLElementType();
+	}
+
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ( pGLBuffer ? pGLBuffer->GetGLBuffer() : 0 ) );
 }
 
 /// @copydoc RRenderCommandProxy::SetVertexBuffers()
@@ -300,7 +391,9 @@ void GLImmediateCommandProxy::SetVertexConstantBuffers(
 	size_t startIndex,
 	size_t bufferCount,
 	RConstantBuffer* const* ppBuffers,
-	const size_t* pLimitSizes )
+	const size_t* pLimitSizes,
+	const uint32_t* pOffsets,
+	const uint32_t* pSizes )
 {
 	// TODO: Implement later. HELIUM_BREAK();
 }
@@ -310,7 +403,9 @@ void GLImmediateCommandProxy::SetPixelConstantBuffers(
 	size_t startIndex,
 	size_t bufferCount,
 	RConstantBuffer* const* ppBuffers,
-	const size_t* pLimitSizes )
+	const size_t* pLimitSizes,
+	const uint32_t* pOffsets,
+	const uint32_t* pSizes )
 {
 	// TODO: Implement later. HELIUM_BREAK();
 }
@@ -318,7 +413,25 @@ void GLImmediateCommandProxy::SetPixelConstantBuffers(
 /// @copydoc RRenderCommandProxy::SetTexture()
 void GLImmediateCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
 {
-	HELIUM_BREAK();
+	if( !m_stateFilter.FilterTexture( samplerIndex, pTexture ) )
+	{
+		return;
+	}
+
+	HELIUM_ASSERT( !pTexture || pTexture->GetType() == RTexture::TYPE_2D );
+	GLTexture2d* pGLTexture = static_cast< GLTexture2d* >( pTexture );
+
+	const GLenum activeTexture = GL_TEXTURE0 + static_cast< GLenum >( samplerIndex );
+	glActiveTexture( activeTexture );
+	glBindTexture( GL_TEXTURE_2D, ( pGLTexture ? pGLTexture->GetGLTexture() : 0 ) );
+
+	// Sampling parameters belong to the texture object in OpenGL, so the state set for this sampler slot needs to be
+	// applied to the newly bound texture (the state filter may skip setting it again if it has not changed).
+	const GLSamplerState* pGLState = static_cast< const GLSamplerState* >( m_stateFilter.GetSamplerState( samplerIndex ) );
+	if( pGLTexture && pGLState )
+	{
+		ApplySamplerState( pGLState );
+	}
 }
 
 /// @copydoc RRenderCommandProxy::DrawIndexed()
@@ -330,7 +443,47 @@ void GLImmediateCommandProxy::DrawIndexed(
 	uint32_t startIndex,
 	uint32_t primitiveCount )
 {
-	HELIUM_BREAK();
+	GLsizei indexCount;
+	GLenum mode = GetGLPrimitiveMode( primitiveType, primitiveCount, indexCount );
+
+	size_t indexSize = ( m_indexElementType == GL_UNSIGNED_INT ? sizeof( uint32_t ) : sizeof( uint16_t ) );
+
+	glDrawRangeElementsBaseVertex(
+		mode,
+		minIndex,
+		minIndex + usedVertexCount - 1,
+		indexCount,
+		m_indexElementType,
+		reinterpret_cast< const GLvoid* >( static_cast< size_t >( startIndex ) * indexSize ),
+		static_cast< GLint >( baseVertexIndex ) );
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void GLImmediateCommandProxy::DrawIndexedInstanced(
+	ERendererPrimitiveType primitiveType,
+	uint32_t baseVertexIndex,
+	uint32_t minIndex,
+	uint32_t usedVertexCount,
+	uint32_t startIndex,
+	uint32_t primitiveCount,
+	uint32_t instanceCount )
+{
+	HELIUM_ASSERT( instanceCount != 0 );
+
+	GLsizei indexCount;
+	GLenum mode = GetGLPrimitiveMode( primitiveType, primitiveCount, indexCount );
+
+	size_t indexSize = ( m_indexElementType == GL_UNSIGNED_INT ? sizeof( uint32_t ) : sizeof( uint16_t ) );
+
+	// The instance data stream is advanced once per instance through the vertex attribute divisors of the bound
+	// vertex input layout.
+	glDrawElementsInstancedBaseVertex(
+		mode,
+		indexCount,
+		m_indexElementType,
+		reinterpret_cast< const GLvoid* >( static_cast< size_t >( startIndex ) * indexSize ),
+		static_cast< GLsizei >( instanceCount ),
+		static_cast< GLint >( baseVertexIndex ) );
 }
 
 /// @copydoc RRenderCommandProxy::DrawUnindexed()
@@ -339,7 +492,11 @@ void GLImmediateCommandProxy::DrawUnindexed(
 	uint32_t baseVertexIndex,
 	uint32_t primitiveCount )
 {
-	HELIUM_BREAK();}
+	GLsizei vertexCount;
+	GLenum mode = GetGLPrimitiveMode( primitiveType, primitiveCount, vertexCount );
+
+	glDrawArrays( mode, static_cast< GLint >( baseVertexIndex ), vertexCount );
+}
 
 /// @copydoc RRenderCommandProxy::SetFence()
 void GLImmediateCommandProxy::SetFence( RFence* pFence )
@@ -350,17 +507,33 @@ void GLImmediateCommandProxy::SetFence( RFence* pFence )
 /// @copydoc RRenderCommandProxy::UnbindResources()
 void GLImmediateCommandProxy::UnbindResources()
 {
+	m_stateFilter.Reset();
+
 	// TODO: Implement later.  HELIUM_BREAK();
 }
 
 /// @copydoc RRenderCommandProxy::ExecuteCommandList()
 void GLImmediateCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
 {
-	HELIUM_BREAK();
+	HELIUM_ASSERT( pCommandList );
+
+	static_cast< DeferredRenderCommandList* >( pCommandList )->Execute( this );
 }
 
 /// @copydoc RRenderCommandProxy::FinishCommandList()
 void GLImmediateCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
 {
-	HELIUM_BREAK();
+	HELIUM_TRACE(
+		TraceLevels::Error,
+		"GLImmediateCommandProxy: FinishCommandList() called on an immediate command proxy.\n" );
+
+	HELIUM_BREAK_MSG( "GLImmediateCommandProxy: FinishCommandList() called on an immediate command proxy" );
+
+	rspCommandList.Release();
+}
+
+/// @copydoc RRenderCommandProxy::GetStateFilter()
+const RenderStateFilter* GLImmediateCommandProxy::GetStateFilter() const
+{
+	return &m_stateFilter;
 }
@@ -6,6 +6,7 @@
 #include "RenderingGL/GLDepthStencilState.h"
 #include "RenderingGL/GLSamplerState.h"
 #include "Rendering/RRenderCommandProxy.h"
+#include "Rendering/RenderStateFilter.h"
 
 struct GLFWwindow;
 
@@ -57,16 +58,19 @@ namespace Helium
 
 		void SetVertexConstantBuffers(
 			size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-			const size_t* pLimitSizes = NULL );
+			const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
 		void SetPixelConstantBuffers(
 			size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
-			const size_t* pLimitSizes = NULL );
+			const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
 
 		void SetTexture( size_t samplerIndex, RTexture* pTexture );
 
 		void DrawIndexed(
 			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
 			uint32_t startIndex, uint32_t primitiveCount );
+		void DrawIndexedInstanced(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
 		void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
 		//@}
 
@@ -86,9 +90,18 @@ namespace Helium
 		void FinishCommandList( RRenderCommandListPtr& rspCommandList );
 		//@}
 
+		/// @name Statistics
+		//@{
+		const RenderStateFilter* GetStateFilter() const;
+		//@}
+
 	private:
 		/// GLFW window / OpenGL context
 		GLFWwindow *m_pGlfwWindow;
+		/// Element type of the currently bound index buffer.
+		GLenum m_indexElementType;
+		/// Shadow state used to skip redundant state changes.
+		RenderStateFilter m_stateFilter;
 
 		/// @name Construction/Destruction
 		//@{
@@ -14,6 +14,7 @@
 #include "RenderingGL/GLTexture2d.h"
 #include "RenderingGL/GLSurface.h"
 
+#include "Rendering/DeferredRenderCommandProxy.h"
 #include "Rendering/RendererUtil.h"
 
 #include "GL/glew.h"
@@ -45,6 +46,7 @@ void GLRenderer::PixelFormatToGLFormat(
 		{ GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, GL_RGBA, GL_UNSIGNED_BYTE }, // RENDERER_PIXEL_FORMAT_BC2_SRGB
 		{ GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,       GL_RGBA, GL_UNSIGNED_BYTE }, // RENDERER_PIXEL_FORMAT_BC3
 		{ GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, GL_RGBA, GL_UNSIGNED_BYTE }, // RENDERER_PIXEL_FORMAT_BC3_SRGB
+		{ GL_COMPRESSED_RG_RGTC2,                 GL_RG,   GL_UNSIGNED_BYTE }, // RENDERER_PIXEL_FORMAT_BC5
 		{ GL_RGBA16F,                             GL_RGBA, GL_HALF_FLOAT    }, // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
 		{ GL_NONE,                                GL_NONE, GL_NONE          }  // RENDERER_PIXEL_FORMAT_DEPTH (dummy entry; depth formats handled manually)
 	};
@@ -117,6 +119,9 @@ bool GLRenderer::Initialize()
 	m_depthTextureFormat = GL_DEPTH_COMPONENT24;
 	m_featureFlags |= RENDERER_FEATURE_FLAG_DEPTH_TEXTURE;
 
+	// The GL context is only current on the thread that created it, so RENDERER_FEATURE_FLAG_MULTITHREADED is not
+	// reported.
+
 	HELIUM_TRACE( TraceLevels::Info, "OpenGL initialized successfully.\n" );
 
 	return true;
@@ -388,6 +393,8 @@ RVertexBuffer* GLRenderer::CreateVertexBuffer( size_t size, ERendererBufferUsage
 		return NULL;
 	}
 
+	vertexBuffer->SetMemoryUsage( size );
+
 	return vertexBuffer;
 }
 
@@ -435,6 +442,8 @@ RIndexBuffer* GLRenderer::CreateIndexBuffer(
 		return NULL;
 	}
 
+	indexBuffer->SetMemoryUsage( size );
+
 	return indexBuffer;
 }
 
@@ -484,6 +493,8 @@ RConstantBuffer* GLRenderer::CreateConstantBuffer(
 	GLConstantBuffer* pBuffer = new GLConstantBuffer( pBufferMemory, static_cast< uint16_t >( registerCount ) );
 	
 	HELIUM_ASSERT( pBuffer );
+	pBuffer->SetMemoryUsage( actualSize );
+
 	return pBuffer;
 }
 
@@ -611,6 +622,7 @@ RTexture2d* GLRenderer::CreateTexture2d(
 
 	GLTexture2d *pTexture = new GLTexture2d( buffer, mipCount, format );
 	HELIUM_ASSERT( pTexture );
+	pTexture->SetMemoryUsage( RendererUtil::GetTexture2dSize( width, height, mipCount, format ) );
 
 	glBindTexture( GL_TEXTURE_2D, curTexture2D );
 
@@ -648,9 +660,10 @@ RRenderCommandProxy* GLRenderer::GetImmediateCommandProxy()
 /// @copydoc Renderer::CreateDeferredCommandProxy()
 RRenderCommandProxy* GLRenderer::CreateDeferredCommandProxy()
 {
-	HELIUM_BREAK();
-
-	return NULL;
+	// OpenGL contexts can only be used from the render thread, so commands are recorded into backend-independent
+	// command lists and replayed through the immediate command proxy.  Note that the GL immediate proxy does not yet
+	// bind vertex buffers, input layouts, or shaders, so replayed draws are only complete once those are implemented.
+	return new DeferredRenderCommandProxy;
 }
 
 /// @copydoc Renderer::Flush()
@@ -72,7 +72,8 @@ bool GLVertexDescription::Initialize( const RVertexDescription::Element* pElemen
 		{ 4, sizeof( GLubyte ) },     // RENDERER_VERTEX_DATA_TYPE_UINT8_4_NORM
 		{ 4, sizeof( GLubyte ) },     // RENDERER_VERTEX_DATA_TYPE_UINT8_4
 		{ 2, sizeof( GLfloat ) / 2 }, // RENDERER_VERTEX_DATA_TYPE_FLOAT16_2
-		{ 4, sizeof( GLfloat ) / 2 }  // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		{ 4, sizeof( GLfloat ) / 2 }, // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		{ 4, sizeof( GLshort ) }      // RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM
 	};
 	static const GLenum vertexAttribTypes[ RENDERER_VERTEX_DATA_TYPE_MAX ] =
 	{
@@ -82,7 +83,8 @@ bool GLVertexDescription::Initialize( const RVertexDescription::Element* pElemen
 		GL_UNSIGNED_BYTE, // RENDERER_VERTEX_DATA_TYPE_UINT8_4_NORM
 		GL_UNSIGNED_BYTE, // RENDERER_VERTEX_DATA_TYPE_UINT8_4
 		GL_HALF_FLOAT,    // RENDERER_VERTEX_DATA_TYPE_FLOAT16_2
-		GL_HALF_FLOAT     // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		GL_HALF_FLOAT,    // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		GL_SHORT          // RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM
 	};
 	static const GLboolean vertexAttribNormalized[ RENDERER_VERTEX_DATA_TYPE_MAX ] =
 	{
@@ -92,7 +94,8 @@ bool GLVertexDescription::Initialize( const RVertexDescription::Element* pElemen
 		GL_TRUE,  // RENDERER_VERTEX_DATA_TYPE_UINT8_4_NORM
 		GL_FALSE, // RENDERER_VERTEX_DATA_TYPE_UINT8_4
 		GL_FALSE, // RENDERER_VERTEX_DATA_TYPE_FLOAT16_2
-		GL_FALSE  // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		GL_FALSE, // RENDERER_VERTEX_DATA_TYPE_FLOAT16_4
+		GL_TRUE   // RENDERER_VERTEX_DATA_TYPE_INT16_4_NORM
 	};
 
 	GLsizei stride = 0;
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RConstantBuffer.h"
+
+namespace Helium
+{
+	/// Null renderer buffer implementation.
+	///
+	/// Buffer contents are stored in system memory.  The same template is used for each buffer interface
+	/// (RVertexBuffer, RIndexBuffer, and RConstantBuffer).
+	template< typename BaseType >
+	class NullBuffer : public BaseType
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullBuffer( size_t size, const void* pData );
+		//@}
+
+		/// @name Data Access
+		//@{
+		void* Map( ERendererBufferMapHint hint );
+		void Unmap();
+
+		inline size_t GetSize() const;
+		inline bool IsMapped() const;
+		//@}
+
+	private:
+		/// Buffer data.
+		void* m_pData;
+		/// Buffer size, in bytes.
+		size_t m_size;
+		/// True if the buffer is currently mapped.
+		bool m_bMapped;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullBuffer();
+		//@}
+	};
+
+	/// Null renderer vertex buffer.
+	typedef NullBuffer< RVertexBuffer > NullVertexBuffer;
+	/// Null renderer index buffer.
+	typedef NullBuffer< RIndexBuffer > NullIndexBuffer;
+	/// Null renderer constant buffer.
+	typedef NullBuffer< RConstantBuffer > NullConstantBuffer;
+}
+
+#include "RenderingNull/NullBuffer.inl"
@@ -0,0 +1,73 @@
+namespace Helium
+{
+	/// Constructor.
+	///
+	/// @param[in] size   Buffer size, in bytes.
+	/// @param[in] pData  Initial buffer contents, or null to leave the contents uninitialized.
+	template< typename BaseType >
+	NullBuffer< BaseType >::NullBuffer( size_t size, const void* pData )
+		: m_pData( NULL )
+		, m_size( size )
+		, m_bMapped( false )
+	{
+		if( size != 0 )
+		{
+			m_pData = DefaultAllocator().Allocate( size );
+			HELIUM_ASSERT( m_pData );
+
+			if( pData )
+			{
+				MemoryCopy( m_pData, pData, size );
+			}
+		}
+	}
+
+	/// Destructor.
+	template< typename BaseType >
+	NullBuffer< BaseType >::~NullBuffer()
+	{
+		HELIUM_ASSERT( !m_bMapped );
+
+		if( m_pData )
+		{
+			DefaultAllocator().Free( m_pData );
+			m_pData = NULL;
+		}
+	}
+
+	/// @copydoc RVertexBuffer::Map()
+	template< typename BaseType >
+	void* NullBuffer< BaseType >::Map( ERendererBufferMapHint /*hint*/ )
+	{
+		HELIUM_ASSERT( !m_bMapped );
+		m_bMapped = true;
+
+		return m_pData;
+	}
+
+	/// @copydoc RVertexBuffer::Unmap()
+	template< typename BaseType >
+	void NullBuffer< BaseType >::Unmap()
+	{
+		HELIUM_ASSERT( m_bMapped );
+		m_bMapped = false;
+	}
+
+	/// Get the size of this buffer.
+	///
+	/// @return  Buffer size, in bytes.
+	template< typename BaseType >
+	size_t NullBuffer< BaseType >::GetSize() const
+	{
+		return m_size;
+	}
+
+	/// Get whether this buffer is currently mapped.
+	///
+	/// @return  True if the buffer is mapped, false if not.
+	template< typename BaseType >
+	bool NullBuffer< BaseType >::IsMapped() const
+	{
+		return m_bMapped;
+	}
+}
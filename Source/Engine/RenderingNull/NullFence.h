@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RFence.h"
+
+namespace Helium
+{
+	/// Null renderer fence.  Since no commands are ever queued, fences are always considered signaled.
+	class NullFence : public RFence
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullFence();
+		//@}
+
+	private:
+		/// @name Construction/Destruction
+		//@{
+		~NullFence();
+		//@}
+	};
+}
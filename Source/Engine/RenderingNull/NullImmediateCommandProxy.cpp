@@ -0,0 +1,442 @@
+#include "Precompile.h"
+#include "RenderingNull/NullImmediateCommandProxy.h"
+
+#include "Rendering/DeferredRenderCommandList.h"
+
+using namespace Helium;
+
+/// Constructor.
+NullImmediateCommandProxy::NullImmediateCommandProxy()
+	: m_bCommandLogging( false )
+{
+	ResetStatistics();
+}
+
+/// Destructor.
+NullImmediateCommandProxy::~NullImmediateCommandProxy()
+{
+}
+
+/// @copydoc RRenderCommandProxy::SetRasterizerState()
+void NullImmediateCommandProxy::SetRasterizerState( RRasterizerState* pState )
+{
+	if( !m_stateFilter.FilterRasterizerState( pState ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_RASTERIZER_STATE, pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetBlendState()
+void NullImmediateCommandProxy::SetBlendState( RBlendState* pState )
+{
+	if( !m_stateFilter.FilterBlendState( pState ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_BLEND_STATE, pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetDepthStencilState()
+void NullImmediateCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
+{
+	if( !m_stateFilter.FilterDepthStencilState( pState, stencilReferenceValue ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_DEPTH_STENCIL_STATE, pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetSamplerStates()
+void NullImmediateCommandProxy::SetSamplerStates(
+	size_t startIndex,
+	size_t samplerCount,
+	RSamplerState* const* ppStates )
+{
+	HELIUM_ASSERT( ppStates || samplerCount == 0 );
+
+	if( !m_stateFilter.FilterSamplerStates( startIndex, samplerCount, ppStates ) )
+	{
+		return;
+	}
+
+	for( size_t samplerIndex = 0; samplerIndex < samplerCount; ++samplerIndex )
+	{
+		RecordStateChange( COMMAND_SET_SAMPLER_STATES, ppStates[ samplerIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetRenderSurfaces()
+void NullImmediateCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
+{
+	if( !m_stateFilter.FilterRenderSurfaces( pRenderTargetSurface, pDepthStencilSurface ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_RENDER_SURFACES, pRenderTargetSurface );
+}
+
+/// @copydoc RRenderCommandProxy::SetViewport()
+void NullImmediateCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+{
+	if( !m_stateFilter.FilterViewport( x, y, width, height ) )
+	{
+		return;
+	}
+
+	RecordCommand( COMMAND_SET_VIEWPORT, ( static_cast< uintptr_t >( width ) << 16 ) | height );
+	++m_statistics.stateChangeCount;
+}
+
+/// @copydoc RRenderCommandProxy::BeginScene()
+void NullImmediateCommandProxy::BeginScene()
+{
+	RecordCommand( COMMAND_BEGIN_SCENE );
+}
+
+/// @copydoc RRenderCommandProxy::EndScene()
+void NullImmediateCommandProxy::EndScene()
+{
+	RecordCommand( COMMAND_END_SCENE );
+	++m_statistics.sceneCount;
+}
+
+/// @copydoc RRenderCommandProxy::Clear()
+void NullImmediateCommandProxy::Clear(
+	uint32_t clearFlags,
+	const Color& /*rColor*/,
+	float32_t /*depth*/,
+	uint8_t /*stencil*/ )
+{
+	RecordCommand( COMMAND_CLEAR, clearFlags );
+}
+
+/// @copydoc RRenderCommandProxy::SetIndexBuffer()
+void NullImmediateCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
+{
+	if( !m_stateFilter.FilterIndexBuffer( pBuffer ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_INDEX_BUFFER, pBuffer );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexBuffers()
+void NullImmediateCommandProxy::SetVertexBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RVertexBuffer* const* ppBuffers,
+	uint32_t* pStrides,
+	uint32_t* pOffsets )
+{
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+	if( !m_stateFilter.FilterVertexBuffers( startIndex, bufferCount, ppBuffers, pStrides, pOffsets ) )
+	{
+		return;
+	}
+
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		RecordStateChange( COMMAND_SET_VERTEX_BUFFERS, ppBuffers[ bufferIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexInputLayout()
+void NullImmediateCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
+{
+	if( !m_stateFilter.FilterVertexInputLayout( pLayout ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_VERTEX_INPUT_LAYOUT, pLayout );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexShader()
+void NullImmediateCommandProxy::SetVertexShader( RVertexShader* pShader )
+{
+	if( !m_stateFilter.FilterVertexShader( pShader ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_VERTEX_SHADER, pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelShader()
+void NullImmediateCommandProxy::SetPixelShader( RPixelShader* pShader )
+{
+	if( !m_stateFilter.FilterPixelShader( pShader ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_PIXEL_SHADER, pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexConstantBuffers()
+void NullImmediateCommandProxy::SetVertexConstantBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RConstantBuffer* const* ppBuffers,
+	const size_t* pLimitSizes,
+	const uint32_t* pOffsets,
+	const uint32_t* pSizes )
+{
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+	if( !m_stateFilter.FilterVertexConstantBuffers(
+		startIndex,
+		bufferCount,
+		ppBuffers,
+		pLimitSizes,
+		pOffsets,
+		pSizes ) )
+	{
+		return;
+	}
+
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		RecordStateChange( COMMAND_SET_VERTEX_CONSTANT_BUFFERS, ppBuffers[ bufferIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelConstantBuffers()
+void NullImmediateCommandProxy::SetPixelConstantBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RConstantBuffer* const* ppBuffers,
+	const size_t* pLimitSizes,
+	const uint32_t* pOffsets,
+	const uint32_t* pSizes )
+{
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+	if( !m_stateFilter.FilterPixelConstantBuffers(
+		startIndex,
+		bufferCount,
+		ppBuffers,
+		pLimitSizes,
+		pOffsets,
+		pSizes ) )
+	{
+		return;
+	}
+
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		RecordStateChange( COMMAND_SET_PIXEL_CONSTANT_BUFFERS, ppBuffers[ bufferIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetTexture()
+void NullImmediateCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
+{
+	if( !m_stateFilter.FilterTexture( samplerIndex, pTexture ) )
+	{
+		return;
+	}
+
+	RecordStateChange( COMMAND_SET_TEXTURE, pTexture );
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexed()
+void NullImmediateCommandProxy::DrawIndexed(
+	ERendererPrimitiveType primitiveType,
+	uint32_t /*baseVertexIndex*/,
+	uint32_t /*minIndex*/,
+	uint32_t /*usedVertexCount*/,
+	uint32_t /*startIndex*/,
+	uint32_t primitiveCount )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+	HELIUM_UNREF( primitiveType );
+
+	RecordCommand( COMMAND_DRAW_INDEXED, primitiveCount );
+	++m_statistics.drawCallCount;
+	m_statistics.primitiveCount += primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void NullImmediateCommandProxy::DrawIndexedInstanced(
+	ERendererPrimitiveType primitiveType,
+	uint32_t /*baseVertexIndex*/,
+	uint32_t /*minIndex*/,
+	uint32_t /*usedVertexCount*/,
+	uint32_t /*startIndex*/,
+	uint32_t primitiveCount,
+	uint32_t instanceCount )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+	HELIUM_UNREF( primitiveType );
+	HELIUM_ASSERT( instanceCount != 0 );
+
+	RecordCommand( COMMAND_DRAW_INDEXED_INSTANCED, instanceCount );
+	++m_statistics.drawCallCount;
+	m_statistics.primitiveCount += static_cast< uint64_t >( primitiveCount ) * instanceCount;
+	m_statistics.instanceCount += instanceCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawUnindexed()
+void NullImmediateCommandProxy::DrawUnindexed(
+	ERendererPrimitiveType primitiveType,
+	uint32_t /*baseVertexIndex*/,
+	uint32_t primitiveCount )
+{
+	HELIUM_ASSERT( static_cast< size_t >( primitiveType ) < static_cast< size_t >( RENDERER_PRIMITIVE_TYPE_MAX ) );
+	HELIUM_UNREF( primitiveType );
+
+	RecordCommand( COMMAND_DRAW_UNINDEXED, primitiveCount );
+	++m_statistics.drawCallCount;
+	m_statistics.primitiveCount += primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetFence()
+void NullImmediateCommandProxy::SetFence( RFence* pFence )
+{
+	RecordCommand( COMMAND_SET_FENCE, reinterpret_cast< uintptr_t >( pFence ) );
+}
+
+/// @copydoc RRenderCommandProxy::UnbindResources()
+void NullImmediateCommandProxy::UnbindResources()
+{
+	m_stateFilter.Reset();
+
+	RecordCommand( COMMAND_UNBIND_RESOURCES );
+}
+
+/// @copydoc RRenderCommandProxy::ExecuteCommandList()
+void NullImmediateCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
+{
+	HELIUM_ASSERT( pCommandList );
+
+	// Recorded commands are replayed through this proxy, so they are filtered and counted like immediate commands.
+	static_cast< DeferredRenderCommandList* >( pCommandList )->Execute( this );
+}
+
+/// @copydoc RRenderCommandProxy::FinishCommandList()
+void NullImmediateCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
+{
+	HELIUM_TRACE(
+		TraceLevels::Warning,
+		"NullImmediateCommandProxy: Command lists cannot be created using the immediate command proxy.\n" );
+
+	rspCommandList.Release();
+}
+
+/// @copydoc RRenderCommandProxy::GetStateFilter()
+const RenderStateFilter* NullImmediateCommandProxy::GetStateFilter() const
+{
+	return &m_stateFilter;
+}
+
+/// Reset all command statistics to zero, including the state filter counters.
+///
+/// @see GetStatistics()
+void NullImmediateCommandProxy::ResetStatistics()
+{
+	MemoryZero( &m_statistics, sizeof( m_statistics ) );
+	m_stateFilter.ResetCounters();
+}
+
+/// Remove all commands from the command log.
+///
+/// @see GetCommandLog(), SetCommandLogging()
+void NullImmediateCommandProxy::ClearCommandLog()
+{
+	m_commandLog.Resize( 0 );
+}
+
+/// Write the contents of the command log to the debug trace output.
+///
+/// @see GetCommandLog()
+void NullImmediateCommandProxy::TraceCommandLog() const
+{
+	size_t commandCount = m_commandLog.GetSize();
+	HELIUM_TRACE( TraceLevels::Debug, "NullImmediateCommandProxy: %" PRIuSZ " commands recorded.\n", commandCount );
+
+	for( size_t commandIndex = 0; commandIndex < commandCount; ++commandIndex )
+	{
+		const CommandRecord& rRecord = m_commandLog[ commandIndex ];
+		HELIUM_TRACE(
+			TraceLevels::Debug,
+			"%6" PRIuSZ ": %s (%" PRIuSZ ")\n",
+			commandIndex,
+			GetCommandName( rRecord.command ),
+			static_cast< size_t >( rRecord.argument ) );
+	}
+}
+
+/// Get the name of a command type, for debugging purposes.
+///
+/// @param[in] command  Command type.
+///
+/// @return  Command name.
+const char* NullImmediateCommandProxy::GetCommandName( ECommand command )
+{
+	static const char* commandNames[ COMMAND_MAX ] =
+	{
+		"SetRasterizerState",        // COMMAND_SET_RASTERIZER_STATE
+		"SetBlendState",             // COMMAND_SET_BLEND_STATE
+		"SetDepthStencilState",      // COMMAND_SET_DEPTH_STENCIL_STATE
+		"SetSamplerStates",          // COMMAND_SET_SAMPLER_STATES
+		"SetRenderSurfaces",         // COMMAND_SET_RENDER_SURFACES
+		"SetViewport",               // COMMAND_SET_VIEWPORT
+		"BeginScene",                // COMMAND_BEGIN_SCENE
+		"EndScene",                  // COMMAND_END_SCENE
+		"Clear",                     // COMMAND_CLEAR
+		"SetIndexBuffer",            // COMMAND_SET_INDEX_BUFFER
+		"SetVertexBuffers",          // COMMAND_SET_VERTEX_BUFFERS
+		"SetVertexInputLayout",      // COMMAND_SET_VERTEX_INPUT_LAYOUT
+		"SetVertexShader",           // COMMAND_SET_VERTEX_SHADER
+		"SetPixelShader",            // COMMAND_SET_PIXEL_SHADER
+		"SetVertexConstantBuffers",  // COMMAND_SET_VERTEX_CONSTANT_BUFFERS
+		"SetPixelConstantBuffers",   // COMMAND_SET_PIXEL_CONSTANT_BUFFERS
+		"SetTexture",                // COMMAND_SET_TEXTURE
+		"DrawIndexed",               // COMMAND_DRAW_INDEXED
+		"DrawIndexedInstanced",      // COMMAND_DRAW_INDEXED_INSTANCED
+		"DrawUnindexed",             // COMMAND_DRAW_UNINDEXED
+		"SetFence",                  // COMMAND_SET_FENCE
+		"UnbindResources"            // COMMAND_UNBIND_RESOURCES
+	};
+
+	HELIUM_ASSERT( static_cast< size_t >( command ) < static_cast< size_t >( COMMAND_MAX ) );
+
+	return commandNames[ command ];
+}
+
+/// Update the statistics for a command and append it to the command log if logging is enabled.
+///
+/// @param[in] command   Command type.
+/// @param[in] argument  Primary command argument.
+void NullImmediateCommandProxy::RecordCommand( ECommand command, uintptr_t argument )
+{
+	HELIUM_ASSERT( static_cast< size_t >( command ) < static_cast< size_t >( COMMAND_MAX ) );
+
+	++m_statistics.commandCounts[ command ];
+
+	if( m_bCommandLogging )
+	{
+		CommandRecord* pRecord = m_commandLog.New();
+		HELIUM_ASSERT( pRecord );
+		pRecord->command = command;
+		pRecord->argument = argument;
+	}
+}
+
+/// Record a state or resource binding command.
+///
+/// @param[in] command    Command type.
+/// @param[in] pResource  Resource or state object being bound.
+void NullImmediateCommandProxy::RecordStateChange( ECommand command, const void* pResource )
+{
+	RecordCommand( command, reinterpret_cast< uintptr_t >( pResource ) );
+	++m_statistics.stateChangeCount;
+}
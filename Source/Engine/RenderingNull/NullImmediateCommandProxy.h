@@ -0,0 +1,216 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RRenderCommandProxy.h"
+#include "Rendering/RenderStateFilter.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	/// Render command proxy for the null renderer.
+	///
+	/// Commands are not executed.  Instead, the proxy counts each command issued, along with the number of state
+	/// changes, draw calls, and primitives submitted, and can optionally record the full command stream for
+	/// inspection.  Redundant state changes are filtered out before being counted or recorded, the same as for other
+	/// command proxy implementations.  This allows the CPU side of the rendering pipeline to be profiled and regression-tested without a
+	/// GPU.
+	class NullImmediateCommandProxy : public RRenderCommandProxy
+	{
+	public:
+		/// Recorded command type.
+		enum ECommand
+		{
+			COMMAND_FIRST   =  0,
+			COMMAND_INVALID = -1,
+
+			/// SetRasterizerState().
+			COMMAND_SET_RASTERIZER_STATE,
+			/// SetBlendState().
+			COMMAND_SET_BLEND_STATE,
+			/// SetDepthStencilState().
+			COMMAND_SET_DEPTH_STENCIL_STATE,
+			/// SetSamplerStates().
+			COMMAND_SET_SAMPLER_STATES,
+			/// SetRenderSurfaces().
+			COMMAND_SET_RENDER_SURFACES,
+			/// SetViewport().
+			COMMAND_SET_VIEWPORT,
+			/// BeginScene().
+			COMMAND_BEGIN_SCENE,
+			/// EndScene().
+			COMMAND_END_SCENE,
+			/// Clear().
+			COMMAND_CLEAR,
+			/// SetIndexBuffer().
+			COMMAND_SET_INDEX_BUFFER,
+			/// SetVertexBuffers().
+			COMMAND_SET_VERTEX_BUFFERS,
+			/// SetVertexInputLayout().
+			COMMAND_SET_VERTEX_INPUT_LAYOUT,
+			/// SetVertexShader().
+			COMMAND_SET_VERTEX_SHADER,
+			/// SetPixelShader().
+			COMMAND_SET_PIXEL_SHADER,
+			/// SetVertexConstantBuffers().
+			COMMAND_SET_VERTEX_CONSTANT_BUFFERS,
+			/// SetPixelConstantBuffers().
+			COMMAND_SET_PIXEL_CONSTANT_BUFFERS,
+			/// SetTexture().
+			COMMAND_SET_TEXTURE,
+			/// DrawIndexed().
+			COMMAND_DRAW_INDEXED,
+			/// DrawIndexedInstanced().
+			COMMAND_DRAW_INDEXED_INSTANCED,
+			/// DrawUnindexed().
+			COMMAND_DRAW_UNINDEXED,
+			/// SetFence().
+			COMMAND_SET_FENCE,
+			/// UnbindResources().
+			COMMAND_UNBIND_RESOURCES,
+
+			COMMAND_MAX,
+			COMMAND_LAST = COMMAND_MAX - 1
+		};
+
+		/// Recorded command.
+		struct CommandRecord
+		{
+			/// Command type.
+			ECommand command;
+			/// Primary command argument (resource address for binding commands, primitive count for draw commands,
+			/// or zero if not applicable).
+			uintptr_t argument;
+		};
+
+		/// Command statistics.
+		struct Statistics
+		{
+			/// Number of times each command has been issued.
+			uint32_t commandCounts[ COMMAND_MAX ];
+			/// Number of state and resource binding commands issued (not including redundant changes skipped by the
+			/// state filter).
+			uint32_t stateChangeCount;
+			/// Number of draw calls issued.
+			uint32_t drawCallCount;
+			/// Number of primitives submitted across all draw calls (including every instance of instanced draws).
+			uint64_t primitiveCount;
+			/// Number of instances submitted across all instanced draw calls.
+			uint64_t instanceCount;
+			/// Number of scenes rendered.
+			uint32_t sceneCount;
+		};
+
+		/// @name Construction/Destruction
+		//@{
+		NullImmediateCommandProxy();
+		//@}
+
+		/// @name State Management
+		//@{
+		void SetRasterizerState( RRasterizerState* pState );
+		void SetBlendState( RBlendState* pState );
+		void SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue );
+		void SetSamplerStates( size_t startIndex, size_t samplerCount, RSamplerState* const* ppStates );
+		//@}
+
+		/// @name Render Target Management
+		//@{
+		void SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface );
+		void SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+		//@}
+
+		/// @name Command Generation
+		//@{
+		void BeginScene();
+		void EndScene();
+
+		void Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil );
+
+		void SetIndexBuffer( RIndexBuffer* pBuffer );
+		void SetVertexBuffers(
+			size_t startIndex, size_t bufferCount, RVertexBuffer* const* ppBuffers, uint32_t* pStrides,
+			uint32_t* pOffsets );
+		void SetVertexInputLayout( RVertexInputLayout* pLayout );
+
+		void SetVertexShader( RVertexShader* pShader );
+		void SetPixelShader( RPixelShader* pShader );
+
+		void SetVertexConstantBuffers(
+			size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+			const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
+		void SetPixelConstantBuffers(
+			size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+			const size_t* pLimitSizes = NULL, const uint32_t* pOffsets = NULL, const uint32_t* pSizes = NULL );
+
+		void SetTexture( size_t samplerIndex, RTexture* pTexture );
+
+		void DrawIndexed(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount );
+		void DrawIndexedInstanced(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
+		void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
+		//@}
+
+		/// @name Fence Commands
+		//@{
+		void SetFence( RFence* pFence );
+		//@}
+
+		/// @name Miscellaneous Resource Management
+		//@{
+		void UnbindResources();
+		//@}
+
+		/// @name Command List Support
+		//@{
+		void ExecuteCommandList( RRenderCommandList* pCommandList );
+		void FinishCommandList( RRenderCommandListPtr& rspCommandList );
+		//@}
+
+		/// @name Statistics
+		//@{
+		const RenderStateFilter* GetStateFilter() const;
+
+		inline const Statistics& GetStatistics() const;
+		void ResetStatistics();
+		//@}
+
+		/// @name Command Logging
+		//@{
+		inline void SetCommandLogging( bool bEnable );
+		inline bool IsCommandLogging() const;
+
+		inline const DynamicArray< CommandRecord >& GetCommandLog() const;
+		void ClearCommandLog();
+		void TraceCommandLog() const;
+
+		static const char* GetCommandName( ECommand command );
+		//@}
+
+	private:
+		/// Shadow state used to skip redundant state changes.
+		RenderStateFilter m_stateFilter;
+		/// Command statistics.
+		Statistics m_statistics;
+		/// Recorded command stream.
+		DynamicArray< CommandRecord > m_commandLog;
+		/// True if commands should be recorded to the command log.
+		bool m_bCommandLogging;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullImmediateCommandProxy();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		void RecordCommand( ECommand command, uintptr_t argument = 0 );
+		void RecordStateChange( ECommand command, const void* pResource );
+		//@}
+	};
+}
+
+#include "RenderingNull/NullImmediateCommandProxy.inl"
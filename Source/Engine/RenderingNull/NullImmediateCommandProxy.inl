@@ -0,0 +1,42 @@
+namespace Helium
+{
+	/// Get the statistics gathered since the proxy was created or the statistics were last reset.
+	///
+	/// @return  Command statistics.
+	///
+	/// @see ResetStatistics()
+	const NullImmediateCommandProxy::Statistics& NullImmediateCommandProxy::GetStatistics() const
+	{
+		return m_statistics;
+	}
+
+	/// Set whether each command issued should be recorded to the command log.
+	///
+	/// @param[in] bEnable  True to record commands, false to only update statistics.
+	///
+	/// @see IsCommandLogging(), GetCommandLog(), ClearCommandLog()
+	void NullImmediateCommandProxy::SetCommandLogging( bool bEnable )
+	{
+		m_bCommandLogging = bEnable;
+	}
+
+	/// Get whether each command issued is being recorded to the command log.
+	///
+	/// @return  True if commands are being recorded, false if not.
+	///
+	/// @see SetCommandLogging()
+	bool NullImmediateCommandProxy::IsCommandLogging() const
+	{
+		return m_bCommandLogging;
+	}
+
+	/// Get the commands recorded since command logging was enabled or the log was last cleared.
+	///
+	/// @return  Command log.
+	///
+	/// @see SetCommandLogging(), ClearCommandLog(), TraceCommandLog()
+	const DynamicArray< NullImmediateCommandProxy::CommandRecord >& NullImmediateCommandProxy::GetCommandLog() const
+	{
+		return m_commandLog;
+	}
+}
@@ -0,0 +1,34 @@
+#include "Precompile.h"
+#include "RenderingNull/NullMainContext.h"
+
+#include "RenderingNull/NullSurface.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] width   Back buffer width, in pixels.
+/// @param[in] height  Back buffer height, in pixels.
+NullMainContext::NullMainContext( uint32_t width, uint32_t height )
+	: m_spBackBufferSurface( new NullSurface( width, height ) )
+	, m_swapCount( 0 )
+{
+	HELIUM_ASSERT( m_spBackBufferSurface );
+}
+
+/// Destructor.
+NullMainContext::~NullMainContext()
+{
+}
+
+/// @copydoc RRenderContext::GetBackBufferSurface()
+RSurface* NullMainContext::GetBackBufferSurface()
+{
+	return m_spBackBufferSurface;
+}
+
+/// @copydoc RRenderContext::Swap()
+void NullMainContext::Swap()
+{
+	++m_swapCount;
+}
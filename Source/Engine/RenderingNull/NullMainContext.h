@@ -0,0 +1,43 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RRenderContext.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( NullSurface );
+
+	/// Null renderer main render context.  Presenting a frame only updates the swap count.
+	class NullMainContext : public RRenderContext
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullMainContext( uint32_t width, uint32_t height );
+		//@}
+
+		/// @name Render Control
+		//@{
+		RSurface* GetBackBufferSurface();
+		void Swap();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline uint32_t GetSwapCount() const;
+		//@}
+
+	private:
+		/// Back buffer surface.
+		NullSurfacePtr m_spBackBufferSurface;
+		/// Number of times Swap() has been called.
+		uint32_t m_swapCount;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullMainContext();
+		//@}
+	};
+}
+
+#include "RenderingNull/NullMainContext.inl"
@@ -0,0 +1,10 @@
+namespace Helium
+{
+	/// Get the number of frames presented by this context.
+	///
+	/// @return  Number of calls to Swap().
+	uint32_t NullMainContext::GetSwapCount() const
+	{
+		return m_swapCount;
+	}
+}
@@ -0,0 +1,352 @@
+#include "Precompile.h"
+#include "RenderingNull/NullRenderer.h"
+
+#include "RenderingNull/NullBuffer.h"
+#include "RenderingNull/NullFence.h"
+#include "RenderingNull/NullImmediateCommandProxy.h"
+#include "RenderingNull/NullMainContext.h"
+#include "RenderingNull/NullShader.h"
+#include "RenderingNull/NullState.h"
+#include "RenderingNull/NullSurface.h"
+#include "RenderingNull/NullTexture2d.h"
+#include "RenderingNull/NullVertexDescription.h"
+#include "RenderingNull/NullVertexInputLayout.h"
+
+#include "Rendering/DeferredRenderCommandProxy.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+
+/// Constructor.
+NullRenderer::NullRenderer()
+{
+}
+
+/// Destructor.
+NullRenderer::~NullRenderer()
+{
+}
+
+/// @copydoc Renderer::Initialize()
+bool NullRenderer::Initialize()
+{
+	HELIUM_TRACE( TraceLevels::Info, "Initializing null rendering support.\n" );
+
+	m_featureFlags =
+		RENDERER_FEATURE_FLAG_DEPTH_TEXTURE | RENDERER_FEATURE_FLAG_INSTANCING | RENDERER_FEATURE_FLAG_MULTITHREADED;
+
+	m_spImmediateCommandProxy = new NullImmediateCommandProxy;
+	HELIUM_ASSERT( m_spImmediateCommandProxy );
+
+	return true;
+}
+
+/// @copydoc Renderer::Cleanup()
+void NullRenderer::Cleanup()
+{
+	HELIUM_TRACE( TraceLevels::Info, "Shutting down null rendering support.\n" );
+
+	m_spMainContext.Release();
+	m_spImmediateCommandProxy.Release();
+
+	m_featureFlags = 0;
+}
+
+/// @copydoc Renderer::CreateMainContext()
+bool NullRenderer::CreateMainContext( const ContextInitParameters& rInitParameters )
+{
+	HELIUM_ASSERT( !m_spMainContext );
+
+	m_spMainContext = new NullMainContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+	HELIUM_ASSERT( m_spMainContext );
+
+	return true;
+}
+
+/// @copydoc Renderer::ResetMainContext()
+bool NullRenderer::ResetMainContext( const ContextInitParameters& rInitParameters )
+{
+	m_spMainContext = new NullMainContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+	HELIUM_ASSERT( m_spMainContext );
+
+	return true;
+}
+
+/// @copydoc Renderer::GetMainContext()
+RRenderContext* NullRenderer::GetMainContext()
+{
+	return m_spMainContext;
+}
+
+/// @copydoc Renderer::CreateSubContext()
+RRenderContext* NullRenderer::CreateSubContext( const ContextInitParameters& rInitParameters )
+{
+	NullMainContext* pContext = new NullMainContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+	HELIUM_ASSERT( pContext );
+
+	return pContext;
+}
+
+/// @copydoc Renderer::GetStatus()
+Renderer::EStatus NullRenderer::GetStatus()
+{
+	return STATUS_READY;
+}
+
+/// @copydoc Renderer::Reset()
+Renderer::EStatus NullRenderer::Reset()
+{
+	return STATUS_READY;
+}
+
+/// @copydoc Renderer::CreateRasterizerState()
+RRasterizerState* NullRenderer::CreateRasterizerState( const RRasterizerState::Description& rDescription )
+{
+	NullRasterizerState* pState = new NullRasterizerState( rDescription );
+	HELIUM_ASSERT( pState );
+
+	return pState;
+}
+
+/// @copydoc Renderer::CreateBlendState()
+RBlendState* NullRenderer::CreateBlendState( const RBlendState::Description& rDescription )
+{
+	NullBlendState* pState = new NullBlendState( rDescription );
+	HELIUM_ASSERT( pState );
+
+	return pState;
+}
+
+/// @copydoc Renderer::CreateDepthStencilState()
+RDepthStencilState* NullRenderer::CreateDepthStencilState( const RDepthStencilState::Description& rDescription )
+{
+	NullDepthStencilState* pState = new NullDepthStencilState( rDescription );
+	HELIUM_ASSERT( pState );
+
+	return pState;
+}
+
+/// @copydoc Renderer::CreateSamplerState()
+RSamplerState* NullRenderer::CreateSamplerState( const RSamplerState::Description& rDescription )
+{
+	NullSamplerState* pState = new NullSamplerState( rDescription );
+	HELIUM_ASSERT( pState );
+
+	return pState;
+}
+
+/// @copydoc Renderer::CreateDepthStencilSurface()
+RSurface* NullRenderer::CreateDepthStencilSurface(
+	uint32_t width,
+	uint32_t height,
+	ERendererSurfaceFormat format,
+	uint32_t /*multisampleCount*/ )
+{
+	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_SURFACE_FORMAT_MAX ) );
+	HELIUM_UNREF( format );
+
+	NullSurface* pSurface = new NullSurface( width, height );
+	HELIUM_ASSERT( pSurface );
+
+	return pSurface;
+}
+
+/// @copydoc Renderer::CreateVertexShader()
+RVertexShader* NullRenderer::CreateVertexShader( size_t size, const void* pData )
+{
+	NullVertexShader* pShader = new NullVertexShader( size, pData );
+	HELIUM_ASSERT( pShader );
+
+	return pShader;
+}
+
+/// @copydoc Renderer::CreatePixelShader()
+RPixelShader* NullRenderer::CreatePixelShader( size_t size, const void* pData )
+{
+	NullPixelShader* pShader = new NullPixelShader( size, pData );
+	HELIUM_ASSERT( pShader );
+
+	return pShader;
+}
+
+/// @copydoc Renderer::CreateVertexBuffer()
+RVertexBuffer* NullRenderer::CreateVertexBuffer( size_t size, ERendererBufferUsage /*usage*/, const void* pData )
+{
+	NullVertexBuffer* pBuffer = new NullVertexBuffer( size, pData );
+	HELIUM_ASSERT( pBuffer );
+
+	return pBuffer;
+}
+
+/// @copydoc Renderer::CreateIndexBuffer()
+RIndexBuffer* NullRenderer::CreateIndexBuffer(
+	size_t size,
+	ERendererBufferUsage /*usage*/,
+	ERendererIndexFormat /*format*/,
+	const void* pData )
+{
+	NullIndexBuffer* pBuffer = new NullIndexBuffer( size, pData );
+	HELIUM_ASSERT( pBuffer );
+
+	return pBuffer;
+}
+
+/// @copydoc Renderer::CreateConstantBuffer()
+RConstantBuffer* NullRenderer::CreateConstantBuffer(
+	size_t size,
+	ERendererBufferUsage /*usage*/,
+	const void* pData )
+{
+	HELIUM_ASSERT( size != 0 );
+
+	// Pad the buffer size to be a multiple of the size of a single float vector register, matching the other
+	// renderer implementations.
+	NullConstantBuffer* pBuffer = new NullConstantBuffer( Align( size, sizeof( float32_t ) * 4 ), NULL );
+	HELIUM_ASSERT( pBuffer );
+
+	if( pData )
+	{
+		void* pMappedData = pBuffer->Map( RENDERER_BUFFER_MAP_HINT_NONE );
+		HELIUM_ASSERT( pMappedData );
+		MemoryCopy( pMappedData, pData, size );
+		pBuffer->Unmap();
+	}
+
+	return pBuffer;
+}
+
+/// @copydoc Renderer::CreateVertexDescription()
+RVertexDescription* NullRenderer::CreateVertexDescription(
+	const RVertexDescription::Element* pElements,
+	size_t elementCount )
+{
+	HELIUM_ASSERT( pElements );
+	HELIUM_ASSERT( elementCount != 0 );
+
+	// Make sure we have vertex elements from which to create a description object.
+	if( elementCount == 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"NullRenderer::CreateVertexDescription(): Cannot create a vertex description with no elements.\n" );
+
+		return NULL;
+	}
+
+	NullVertexDescription* pDescription = new NullVertexDescription( pElements, elementCount );
+	HELIUM_ASSERT( pDescription );
+
+	return pDescription;
+}
+
+/// @copydoc Renderer::CreateVertexInputLayout()
+RVertexInputLayout* NullRenderer::CreateVertexInputLayout(
+	RVertexDescription* pDescription,
+	RVertexShader* /*pShader*/ )
+{
+	HELIUM_ASSERT( pDescription );
+
+	NullVertexInputLayout* pLayout = new NullVertexInputLayout( pDescription );
+	HELIUM_ASSERT( pLayout );
+
+	return pLayout;
+}
+
+/// @copydoc Renderer::CreateTexture2d()
+RTexture2d* NullRenderer::CreateTexture2d(
+	uint32_t width,
+	uint32_t height,
+	uint32_t mipCount,
+	ERendererPixelFormat format,
+	ERendererBufferUsage usage,
+	const RTexture2d::CreateData* pData )
+{
+	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+	HELIUM_ASSERT( static_cast< size_t >( usage ) < static_cast< size_t >( RENDERER_BUFFER_USAGE_MAX ) );
+	HELIUM_UNREF( usage );
+
+	NullTexture2d* pTexture = new NullTexture2d( width, height, mipCount, format, pData );
+	HELIUM_ASSERT( pTexture );
+
+	return pTexture;
+}
+
+/// @copydoc Renderer::CreateFence()
+RFence* NullRenderer::CreateFence()
+{
+	NullFence* pFence = new NullFence;
+	HELIUM_ASSERT( pFence );
+
+	return pFence;
+}
+
+/// @copydoc Renderer::SyncFence()
+void NullRenderer::SyncFence( RFence* /*pFence*/ )
+{
+	// No commands are ever queued, so all fences are already signaled.
+}
+
+/// @copydoc Renderer::TrySyncFence()
+bool NullRenderer::TrySyncFence( RFence* /*pFence*/ )
+{
+	return true;
+}
+
+/// @copydoc Renderer::GetImmediateCommandProxy()
+RRenderCommandProxy* NullRenderer::GetImmediateCommandProxy()
+{
+	return m_spImmediateCommandProxy;
+}
+
+/// @copydoc Renderer::CreateDeferredCommandProxy()
+RRenderCommandProxy* NullRenderer::CreateDeferredCommandProxy()
+{
+	return new DeferredRenderCommandProxy;
+}
+
+/// @copydoc Renderer::Flush()
+void NullRenderer::Flush()
+{
+}
+
+/// Get the immediate command proxy as a NullImmediateCommandProxy, for access to command statistics and logging.
+///
+/// @return  Immediate command proxy.
+///
+/// @see GetImmediateCommandProxy()
+NullImmediateCommandProxy* NullRenderer::GetNullImmediateCommandProxy() const
+{
+	return m_spImmediateCommandProxy;
+}
+
+/// Create the static renderer instance as a NullRenderer.
+///
+/// @see Shutdown()
+void NullRenderer::Startup()
+{
+	if ( ++g_InitCount == 1 )
+	{
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new NullRenderer;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !HELIUM_VERIFY( sm_pInstance->Initialize() ) )
+		{
+			Shutdown();
+		}
+	}
+}
+
+/// Destroy the global renderer instance if one exists.
+///
+/// @see Startup()
+void NullRenderer::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		HELIUM_ASSERT( sm_pInstance );
+		sm_pInstance->Cleanup();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
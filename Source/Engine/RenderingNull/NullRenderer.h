@@ -0,0 +1,101 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/Renderer.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( NullImmediateCommandProxy );
+	HELIUM_DECLARE_RPTR( NullMainContext );
+
+	/// Null renderer implementation.
+	///
+	/// All resources are created in system memory, and rendering commands are only counted and optionally recorded
+	/// (see NullImmediateCommandProxy).  This allows the full CPU side of the rendering pipeline to run on machines
+	/// without a GPU, such as for benchmarking and automated testing.
+	class NullRenderer : public Renderer
+	{
+	public:
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Display Initialization
+		//@{
+		bool CreateMainContext( const ContextInitParameters& rInitParameters );
+		bool ResetMainContext( const ContextInitParameters& rInitParameters );
+		RRenderContext* GetMainContext();
+
+		RRenderContext* CreateSubContext( const ContextInitParameters& rInitParameters );
+
+		EStatus GetStatus();
+		EStatus Reset();
+		//@}
+
+		/// @name State Object Creation
+		//@{
+		RRasterizerState* CreateRasterizerState( const RRasterizerState::Description& rDescription );
+		RBlendState* CreateBlendState( const RBlendState::Description& rDescription );
+		RDepthStencilState* CreateDepthStencilState( const RDepthStencilState::Description& rDescription );
+		RSamplerState* CreateSamplerState( const RSamplerState::Description& rDescription );
+		//@}
+
+		/// @name Resource Allocation
+		//@{
+		RSurface* CreateDepthStencilSurface(
+			uint32_t width, uint32_t height, ERendererSurfaceFormat format, uint32_t multisampleCount );
+
+		RVertexShader* CreateVertexShader( size_t size, const void* pData );
+		RPixelShader* CreatePixelShader( size_t size, const void* pData );
+
+		RVertexBuffer* CreateVertexBuffer( size_t size, ERendererBufferUsage usage, const void* pData );
+		RIndexBuffer* CreateIndexBuffer(
+			size_t size, ERendererBufferUsage usage, ERendererIndexFormat format, const void* pData );
+		RConstantBuffer* CreateConstantBuffer( size_t size, ERendererBufferUsage usage, const void* pData );
+
+		RVertexDescription* CreateVertexDescription( const RVertexDescription::Element* pElements, size_t elementCount );
+		RVertexInputLayout* CreateVertexInputLayout( RVertexDescription* pDescription, RVertexShader* pShader );
+
+		RTexture2d* CreateTexture2d(
+			uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format, ERendererBufferUsage usage,
+			const RTexture2d::CreateData* pData );
+		//@}
+
+		/// @name Deferred Query Allocation
+		//@{
+		RFence* CreateFence();
+		void SyncFence( RFence* pFence );
+		bool TrySyncFence( RFence* pFence );
+		//@}
+
+		/// @name Command Interfaces
+		//@{
+		RRenderCommandProxy* GetImmediateCommandProxy();
+		RRenderCommandProxy* CreateDeferredCommandProxy();
+
+		void Flush();
+
+		NullImmediateCommandProxy* GetNullImmediateCommandProxy() const;
+		//@}
+
+		/// @name Static Initialization
+		//@{
+		HELIUM_RENDERING_NULL_API static void Startup();
+		HELIUM_RENDERING_NULL_API static void Shutdown();
+		//@}
+
+	private:
+		/// Immediate render command proxy.
+		NullImmediateCommandProxyPtr m_spImmediateCommandProxy;
+		/// Main rendering context.
+		NullMainContextPtr m_spMainContext;
+
+		/// @name Construction/Destruction
+		//@{
+		NullRenderer();
+		virtual ~NullRenderer();
+		//@}
+	};
+}
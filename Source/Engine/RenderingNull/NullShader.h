@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RVertexShader.h"
+#include "Rendering/RPixelShader.h"
+
+namespace Helium
+{
+	/// Null renderer shader implementation.
+	///
+	/// Shader byte code is stored in system memory but never executed.  The same template is used for both shader
+	/// interfaces (RVertexShader and RPixelShader).
+	template< typename BaseType >
+	class NullShader : public BaseType
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullShader( size_t size, const void* pData );
+		//@}
+
+		/// @name Loading
+		//@{
+		void* Lock();
+		bool Unlock();
+		//@}
+
+	private:
+		/// Shader byte code.
+		void* m_pData;
+		/// Shader byte code size, in bytes.
+		size_t m_size;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullShader();
+		//@}
+	};
+
+	/// Null renderer vertex shader.
+	typedef NullShader< RVertexShader > NullVertexShader;
+	/// Null renderer pixel shader.
+	typedef NullShader< RPixelShader > NullPixelShader;
+}
+
+#include "RenderingNull/NullShader.inl"
@@ -0,0 +1,48 @@
+namespace Helium
+{
+	/// Constructor.
+	///
+	/// @param[in] size   Size of the shader byte code, in bytes.
+	/// @param[in] pData  Shader byte code, or null if the byte code will be provided using Lock() and Unlock().
+	template< typename BaseType >
+	NullShader< BaseType >::NullShader( size_t size, const void* pData )
+		: m_pData( NULL )
+		, m_size( size )
+	{
+		if( size != 0 )
+		{
+			m_pData = DefaultAllocator().Allocate( size );
+			HELIUM_ASSERT( m_pData );
+
+			if( pData )
+			{
+				MemoryCopy( m_pData, pData, size );
+			}
+		}
+	}
+
+	/// Destructor.
+	template< typename BaseType >
+	NullShader< BaseType >::~NullShader()
+	{
+		if( m_pData )
+		{
+			DefaultAllocator().Free( m_pData );
+			m_pData = NULL;
+		}
+	}
+
+	/// @copydoc RShader::Lock()
+	template< typename BaseType >
+	void* NullShader< BaseType >::Lock()
+	{
+		return m_pData;
+	}
+
+	/// @copydoc RShader::Unlock()
+	template< typename BaseType >
+	bool NullShader< BaseType >::Unlock()
+	{
+		return true;
+	}
+}
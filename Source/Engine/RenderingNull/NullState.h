@@ -0,0 +1,52 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RBlendState.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RSamplerState.h"
+
+namespace Helium
+{
+	/// Null renderer state object implementation.
+	///
+	/// State objects simply retain the description with which they were created.  The same template is used for each
+	/// state object interface (RRasterizerState, RBlendState, RDepthStencilState, and RSamplerState).
+	template< typename BaseType >
+	class NullState : public BaseType
+	{
+	public:
+		/// State description type.
+		typedef typename BaseType::Description Description;
+
+		/// @name Construction/Destruction
+		//@{
+		explicit NullState( const Description& rDescription );
+		//@}
+
+		/// @name State Information
+		//@{
+		void GetDescription( Description& rDescription ) const;
+		//@}
+
+	private:
+		/// State description.
+		Description m_description;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullState();
+		//@}
+	};
+
+	/// Null renderer rasterizer state.
+	typedef NullState< RRasterizerState > NullRasterizerState;
+	/// Null renderer blend state.
+	typedef NullState< RBlendState > NullBlendState;
+	/// Null renderer depth/stencil state.
+	typedef NullState< RDepthStencilState > NullDepthStencilState;
+	/// Null renderer sampler state.
+	typedef NullState< RSamplerState > NullSamplerState;
+}
+
+#include "RenderingNull/NullState.inl"
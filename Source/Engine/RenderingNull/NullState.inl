@@ -0,0 +1,24 @@
+namespace Helium
+{
+	/// Constructor.
+	///
+	/// @param[in] rDescription  State description.
+	template< typename BaseType >
+	NullState< BaseType >::NullState( const Description& rDescription )
+		: m_description( rDescription )
+	{
+	}
+
+	/// Destructor.
+	template< typename BaseType >
+	NullState< BaseType >::~NullState()
+	{
+	}
+
+	/// @copydoc RRasterizerState::GetDescription()
+	template< typename BaseType >
+	void NullState< BaseType >::GetDescription( Description& rDescription ) const
+	{
+		rDescription = m_description;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RSurface.h"
+
+namespace Helium
+{
+	/// Null renderer render target or depth-stencil surface.  No surface memory is allocated.
+	class NullSurface : public RSurface
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullSurface( uint32_t width, uint32_t height );
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline uint32_t GetWidth() const;
+		inline uint32_t GetHeight() const;
+		//@}
+
+	private:
+		/// Surface width, in pixels.
+		uint32_t m_width;
+		/// Surface height, in pixels.
+		uint32_t m_height;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullSurface();
+		//@}
+	};
+}
+
+#include "RenderingNull/NullSurface.inl"
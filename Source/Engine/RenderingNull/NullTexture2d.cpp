@@ -0,0 +1,167 @@
+#include "Precompile.h"
+#include "RenderingNull/NullTexture2d.h"
+
+#include "Rendering/RendererUtil.h"
+#include "RenderingNull/NullSurface.h"
+
+using namespace Helium;
+
+/// Get the number of bytes used by each pixel (or each block of pixels, for block-compressed formats) of a given
+/// pixel format.
+///
+/// @param[in] format  Pixel format.
+///
+/// @return  Pixel or block size, in bytes.
+static size_t GetPixelFormatElementSize( ERendererPixelFormat format )
+{
+	static const size_t elementSizes[ RENDERER_PIXEL_FORMAT_MAX ] =
+	{
+		4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8
+		4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8_SRGB
+		1,   // RENDERER_PIXEL_FORMAT_R8
+		8,   // RENDERER_PIXEL_FORMAT_BC1
+		8,   // RENDERER_PIXEL_FORMAT_BC1_SRGB
+		16,  // RENDERER_PIXEL_FORMAT_BC2
+		16,  // RENDERER_PIXEL_FORMAT_BC2_SRGB
+		16,  // RENDERER_PIXEL_FORMAT_BC3
+		16,  // RENDERER_PIXEL_FORMAT_BC3_SRGB
+		16,  // RENDERER_PIXEL_FORMAT_BC5
+		8,   // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
+		4    // RENDERER_PIXEL_FORMAT_DEPTH
+	};
+
+	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+
+	return elementSizes[ format ];
+}
+
+/// Constructor.
+///
+/// @param[in] width     Width of the top mip level, in pixels.
+/// @param[in] height    Height of the top mip level, in pixels.
+/// @param[in] mipCount  Number of mip levels.
+/// @param[in] format    Pixel format.
+/// @param[in] pData     Initial data for each mip level, or null to leave the texture contents uninitialized.
+NullTexture2d::NullTexture2d(
+	uint32_t width,
+	uint32_t height,
+	uint32_t mipCount,
+	ERendererPixelFormat format,
+	const RTexture2d::CreateData* pData )
+	: m_width( width )
+	, m_height( height )
+	, m_format( format )
+{
+	bool bCompressed = RendererUtil::IsCompressedFormat( format );
+	size_t elementSize = GetPixelFormatElementSize( format );
+
+	m_mipLevels.Resize( mipCount );
+	for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+	{
+		uint32_t mipWidth = GetWidth( mipIndex );
+		uint32_t mipHeight = GetHeight( mipIndex );
+		uint32_t rowCount = mipHeight;
+		uint32_t rowElementCount = mipWidth;
+		if( bCompressed )
+		{
+			rowCount = RendererUtil::PixelToBlockRowCount( mipHeight, format );
+			rowElementCount = RendererUtil::PixelToBlockRowCount( mipWidth, format );
+		}
+
+		MipLevel& rMipLevel = m_mipLevels[ mipIndex ];
+		rMipLevel.pitch = rowElementCount * elementSize;
+
+		size_t dataSize = rMipLevel.pitch * rowCount;
+		rMipLevel.pData = DefaultAllocator().Allocate( dataSize );
+		HELIUM_ASSERT( rMipLevel.pData );
+
+		if( pData )
+		{
+			const RTexture2d::CreateData& rCreateData = pData[ mipIndex ];
+			HELIUM_ASSERT( rCreateData.pData );
+
+			const uint8_t* pSourceRow = static_cast< const uint8_t* >( rCreateData.pData );
+			uint8_t* pDestinationRow = static_cast< uint8_t* >( rMipLevel.pData );
+			size_t copySize = Min( rCreateData.pitch, rMipLevel.pitch );
+			for( uint32_t rowIndex = 0; rowIndex < rowCount; ++rowIndex )
+			{
+				MemoryCopy( pDestinationRow, pSourceRow, copySize );
+				pSourceRow += rCreateData.pitch;
+				pDestinationRow += rMipLevel.pitch;
+			}
+		}
+	}
+}
+
+/// Destructor.
+NullTexture2d::~NullTexture2d()
+{
+	size_t mipCount = m_mipLevels.GetSize();
+	for( size_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+	{
+		DefaultAllocator().Free( m_mipLevels[ mipIndex ].pData );
+	}
+}
+
+/// @copydoc RTexture::GetMipCount()
+uint32_t NullTexture2d::GetMipCount() const
+{
+	return static_cast< uint32_t >( m_mipLevels.GetSize() );
+}
+
+/// @copydoc RTexture2d::Map()
+void* NullTexture2d::Map( uint32_t mipLevel, size_t& rPitch, ERendererBufferMapHint /*hint*/ )
+{
+	HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+	MipLevel& rMipLevel = m_mipLevels[ mipLevel ];
+	rPitch = rMipLevel.pitch;
+
+	return rMipLevel.pData;
+}
+
+/// @copydoc RTexture2d::Unmap()
+void NullTexture2d::Unmap( uint32_t mipLevel )
+{
+	HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+	HELIUM_UNREF( mipLevel );
+}
+
+/// @copydoc RTexture2d::CanMapWholeResource()
+bool NullTexture2d::CanMapWholeResource() const
+{
+	return true;
+}
+
+/// @copydoc RTexture2d::GetWidth()
+uint32_t NullTexture2d::GetWidth( uint32_t mipLevel ) const
+{
+	return Max< uint32_t >( m_width >> mipLevel, 1 );
+}
+
+/// @copydoc RTexture2d::GetHeight()
+uint32_t NullTexture2d::GetHeight( uint32_t mipLevel ) const
+{
+	return Max< uint32_t >( m_height >> mipLevel, 1 );
+}
+
+/// @copydoc RTexture2d::GetPixelFormat()
+ERendererPixelFormat NullTexture2d::GetPixelFormat() const
+{
+	return m_format;
+}
+
+/// @copydoc RTexture2d::GetSurface()
+RSurface* NullTexture2d::GetSurface( uint32_t mipLevel )
+{
+	HELIUM_ASSERT( mipLevel < m_mipLevels.GetSize() );
+
+	MipLevel& rMipLevel = m_mipLevels[ mipLevel ];
+	if( !rMipLevel.spSurface )
+	{
+		rMipLevel.spSurface = new NullSurface( GetWidth( mipLevel ), GetHeight( mipLevel ) );
+		HELIUM_ASSERT( rMipLevel.spSurface );
+	}
+
+	return rMipLevel.spSurface;
+}
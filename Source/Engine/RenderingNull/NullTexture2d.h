@@ -0,0 +1,67 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RTexture2d.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( NullSurface );
+
+	/// Null renderer 2D texture implementation.  Mip level data is stored in system memory.
+	class NullTexture2d : public RTexture2d
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullTexture2d(
+			uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format,
+			const RTexture2d::CreateData* pData );
+		//@}
+
+		/// @name Base Texture Information
+		//@{
+		uint32_t GetMipCount() const;
+		//@}
+
+		/// @name Data Access
+		//@{
+		void* Map( uint32_t mipLevel, size_t& rPitch, ERendererBufferMapHint hint );
+		void Unmap( uint32_t mipLevel );
+		bool CanMapWholeResource() const;
+
+		uint32_t GetWidth( uint32_t mipLevel ) const;
+		uint32_t GetHeight( uint32_t mipLevel ) const;
+		ERendererPixelFormat GetPixelFormat() const;
+
+		RSurface* GetSurface( uint32_t mipLevel );
+		//@}
+
+	private:
+		/// Mip level data.
+		struct MipLevel
+		{
+			/// Pixel data.
+			void* pData;
+			/// Number of bytes per row of pixels (or blocks, for block-compressed formats).
+			size_t pitch;
+			/// Surface for rendering to this mip level (created on demand).
+			NullSurfacePtr spSurface;
+		};
+
+		/// Mip levels.
+		DynamicArray< MipLevel > m_mipLevels;
+		/// Width of the top mip level, in pixels.
+		uint32_t m_width;
+		/// Height of the top mip level, in pixels.
+		uint32_t m_height;
+		/// Pixel format.
+		ERendererPixelFormat m_format;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullTexture2d();
+		//@}
+	};
+}
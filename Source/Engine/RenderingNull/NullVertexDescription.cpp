@@ -0,0 +1,24 @@
+#include "Precompile.h"
+#include "RenderingNull/NullVertexDescription.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pElements     Array of vertex elements.
+/// @param[in] elementCount  Number of vertex elements.
+NullVertexDescription::NullVertexDescription( const RVertexDescription::Element* pElements, size_t elementCount )
+{
+	HELIUM_ASSERT( pElements || elementCount == 0 );
+
+	m_elements.Reserve( elementCount );
+	for( size_t elementIndex = 0; elementIndex < elementCount; ++elementIndex )
+	{
+		m_elements.Push( pElements[ elementIndex ] );
+	}
+}
+
+/// Destructor.
+NullVertexDescription::~NullVertexDescription()
+{
+}
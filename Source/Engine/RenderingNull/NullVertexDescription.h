@@ -0,0 +1,36 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RVertexDescription.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	/// Null renderer vertex description.  Stores a copy of the vertex elements from which it was created.
+	class NullVertexDescription : public RVertexDescription
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullVertexDescription( const RVertexDescription::Element* pElements, size_t elementCount );
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline size_t GetElementCount() const;
+		inline const RVertexDescription::Element& GetElement( size_t index ) const;
+		//@}
+
+	private:
+		/// Vertex elements.
+		DynamicArray< RVertexDescription::Element > m_elements;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullVertexDescription();
+		//@}
+	};
+}
+
+#include "RenderingNull/NullVertexDescription.inl"
@@ -0,0 +1,26 @@
+namespace Helium
+{
+	/// Get the number of elements in this vertex description.
+	///
+	/// @return  Vertex element count.
+	///
+	/// @see GetElement()
+	size_t NullVertexDescription::GetElementCount() const
+	{
+		return m_elements.GetSize();
+	}
+
+	/// Get a vertex element.
+	///
+	/// @param[in] index  Element index.
+	///
+	/// @return  Vertex element.
+	///
+	/// @see GetElementCount()
+	const RVertexDescription::Element& NullVertexDescription::GetElement( size_t index ) const
+	{
+		HELIUM_ASSERT( index < m_elements.GetSize() );
+
+		return m_elements[ index ];
+	}
+}
@@ -0,0 +1,17 @@
+#include "Precompile.h"
+#include "RenderingNull/NullVertexInputLayout.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pDescription  Vertex description from which this layout is being created.
+NullVertexInputLayout::NullVertexInputLayout( RVertexDescription* pDescription )
+	: m_spDescription( pDescription )
+{
+}
+
+/// Destructor.
+NullVertexInputLayout::~NullVertexInputLayout()
+{
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexDescription.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( RVertexDescription );
+
+	/// Null renderer vertex input layout.
+	class NullVertexInputLayout : public RVertexInputLayout
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		explicit NullVertexInputLayout( RVertexDescription* pDescription );
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline RVertexDescription* GetDescription() const;
+		//@}
+
+	private:
+		/// Vertex description from which this layout was created.
+		RVertexDescriptionPtr m_spDescription;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullVertexInputLayout();
+		//@}
+	};
+}
+
+#include "RenderingNull/NullVertexInputLayout.inl"
@@ -0,0 +1,10 @@
+namespace Helium
+{
+	/// Get the vertex description from which this layout was created.
+	///
+	/// @return  Vertex description.
+	RVertexDescription* NullVertexInputLayout::GetDescription() const
+	{
+		return m_spDescription;
+	}
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+
+#include "Platform/Assert.h"
+#include "Platform/Trace.h"
+#include "Platform/MemoryHeap.h"
+#include "RenderingNull/NullRenderer.h"
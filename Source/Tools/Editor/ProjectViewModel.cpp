@@ -18,6 +18,7 @@
 #include "Engine/Asset.h"
 
 #include "EngineJobs/EngineJobs.h"
+#include "EngineJobs/JobManager.h"
 
 #include "GraphicsJobs/GraphicsJobs.h"
 
@@ -224,6 +225,7 @@ bool ProjectViewModel::OpenProject( const FilePath& project )
 	m_InitializerStack.Push( Name::Shutdown );
 	m_InitializerStack.Push( AssetPath::Shutdown );
 	m_InitializerStack.Push( AsyncLoader::Startup, AsyncLoader::Shutdown );
+	m_InitializerStack.Push( JobManager::Startup, JobManager::Shutdown );
 
 	// Asset cache management.
 	m_InitializerStack.Push( CacheManager::Startup, CacheManager::Shutdown );
@@ -55,6 +55,11 @@ project( prefix .. "EngineJobs" )
 		"Source/Engine/EngineJobs/*",
 	}
 
+	excludes
+	{
+		"Source/Engine/EngineJobs/*Tests.*",
+	}
+
 	configuration "SharedLib"
 		links
 		{
@@ -69,6 +74,29 @@ project( prefix .. "EngineJobs" )
 			prefix .. "Platform",
 		}
 
+	configuration {}
+
+project( prefix .. "EngineJobsTests" )
+
+	Helium.DoTestsProjectSettings()
+
+	files
+	{
+		"Source/Engine/EngineJobs/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "EngineJobs",
+		prefix .. "Engine",
+		prefix .. "MathSimd",
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 project( prefix .. "Windowing" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "Windowing", "WINDOWING" )
@@ -130,6 +158,11 @@ project( prefix .. "Rendering" )
 		"Source/Engine/Rendering/*",
 	}
 
+	excludes
+	{
+		"Source/Engine/Rendering/*Tests.*",
+	}
+
 	configuration "SharedLib"
 		links
 		{
@@ -145,6 +178,31 @@ project( prefix .. "Rendering" )
 			prefix .. "Platform",
 		}
 
+	configuration {}
+
+project( prefix .. "RenderingTests" )
+
+	Helium.DoTestsProjectSettings()
+	Helium.DoGraphicsProjectSettings()
+
+	files
+	{
+		"Source/Engine/Rendering/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "Rendering",
+		prefix .. "EngineJobs",
+		prefix .. "Engine",
+		prefix .. "MathSimd",
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 if _OPTIONS[ "gfxapi" ] == "direct3d" then
 
 project( prefix .. "RenderingD3D9" )
@@ -203,6 +261,32 @@ project( prefix .. "RenderingGL" )
 
 end
 
+project( prefix .. "RenderingNull" )
+
+	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "RenderingNull", "RENDERING_NULL" )
+	Helium.DoGraphicsProjectSettings()
+
+	files
+	{
+		"Source/Engine/RenderingNull/*",
+	}
+
+	configuration "SharedLib"
+		links
+		{
+			prefix .. "Engine",
+			prefix .. "EngineJobs",
+			prefix .. "Rendering",
+			prefix .. "MathSimd",
+
+			-- core
+			prefix .. "Math",
+			prefix .. "Persist",
+			prefix .. "Reflect",
+			prefix .. "Foundation",
+			prefix .. "Platform",
+		}
+
 project( prefix .. "GraphicsTypes" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "GraphicsTypes", "GRAPHICS_TYPES" )
@@ -213,6 +297,11 @@ project( prefix .. "GraphicsTypes" )
 		"Source/Engine/GraphicsTypes/*",
 	}
 
+	excludes
+	{
+		"Source/Engine/GraphicsTypes/*Tests.*",
+	}
+
 	configuration "SharedLib"
 		links
 		{
@@ -229,6 +318,32 @@ project( prefix .. "GraphicsTypes" )
 			prefix .. "Platform",
 		}
 
+	configuration {}
+
+project( prefix .. "GraphicsTypesTests" )
+
+	Helium.DoTestsProjectSettings()
+	Helium.DoGraphicsProjectSettings()
+
+	files
+	{
+		"Source/Engine/GraphicsTypes/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "GraphicsTypes",
+		prefix .. "Rendering",
+		prefix .. "EngineJobs",
+		prefix .. "Engine",
+		prefix .. "MathSimd",
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 project( prefix .. "GraphicsJobs" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "GraphicsJobs", "GRAPHICS_JOBS" )
@@ -266,6 +381,11 @@ project( prefix .. "Graphics" )
 		"Source/Engine/Graphics/*",
 	}
 
+	excludes
+	{
+		"Source/Engine/Graphics/*Tests.*",
+	}
+
 	configuration "SharedLib"
 		links
 		{
@@ -285,6 +405,35 @@ project( prefix .. "Graphics" )
 			prefix .. "Platform",
 		}
 
+	configuration {}
+
+project( prefix .. "GraphicsTests" )
+
+	Helium.DoTestsProjectSettings()
+	Helium.DoGraphicsProjectSettings()
+
+	files
+	{
+		"Source/Engine/Graphics/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "Graphics",
+		prefix .. "GraphicsJobs",
+		prefix .. "GraphicsTypes",
+		prefix .. "Rendering",
+		prefix .. "Framework",
+		prefix .. "EngineJobs",
+		prefix .. "Engine",
+		prefix .. "MathSimd",
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 project( prefix .. "Components" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "Components", "COMPONENTS" )
@@ -488,6 +637,7 @@ project( prefix .. "FrameworkImpl" )
 			prefix .. "Engine",
 			prefix .. "EngineJobs",
 			prefix .. "Windowing",
+			prefix .. "RenderingNull",
 			prefix .. "Rendering",
 			prefix .. "GraphicsTypes",
 			prefix .. "GraphicsJobs",
@@ -554,6 +704,7 @@ project( prefix .. "GameLibrary" )
 			prefix .. "Engine",
 			prefix .. "EngineJobs",
 			prefix .. "Windowing",
+			prefix .. "RenderingNull",
 			prefix .. "Rendering",
 			prefix .. "GraphicsTypes",
 			prefix .. "GraphicsJobs",
@@ -135,6 +135,7 @@ project( prefix .. "EditorScene" )
 			prefix .. "Engine",
 			prefix .. "EngineJobs",
 			prefix .. "Windowing",
+			prefix .. "RenderingNull",
 			prefix .. "Rendering",
 			prefix .. "GraphicsTypes",
 			prefix .. "GraphicsJobs",
@@ -241,6 +242,7 @@ project( prefix .. "Editor" )
 		prefix .. "Graphics",
 		prefix .. "GraphicsJobs",
 		prefix .. "GraphicsTypes",
+		prefix .. "RenderingNull",
 		prefix .. "Rendering",
 		prefix .. "Windowing",
 		prefix .. "EngineJobs",
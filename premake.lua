@@ -396,6 +396,7 @@ Helium.DoGameProjectSettings = function( name )
 		prefix .. "Graphics",
 		prefix .. "GraphicsJobs",
 		prefix .. "GraphicsTypes",
+		prefix .. "RenderingNull",
 		prefix .. "Rendering",
 		prefix .. "Windowing",
 		prefix .. "EngineJobs",